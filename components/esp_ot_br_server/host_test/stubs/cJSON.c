@@ -0,0 +1,203 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "cJSON.h"
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+static cJSON *item_new(int type)
+{
+    cJSON *item = calloc(1, sizeof(cJSON));
+    if (item) {
+        item->type = type;
+    }
+    return item;
+}
+
+cJSON *cJSON_CreateObject(void)
+{
+    return item_new(cJSON_Object);
+}
+
+cJSON *cJSON_CreateArray(void)
+{
+    return item_new(cJSON_Array);
+}
+
+cJSON *cJSON_CreateNumber(double num)
+{
+    cJSON *item = item_new(cJSON_Number);
+    if (item) {
+        item->valuedouble = num;
+        item->valueint = (int)num;
+    }
+    return item;
+}
+
+cJSON *cJSON_CreateString(const char *string)
+{
+    cJSON *item = item_new(cJSON_String);
+    if (item) {
+        item->valuestring = strdup(string);
+    }
+    return item;
+}
+
+cJSON *cJSON_CreateNull(void)
+{
+    return item_new(cJSON_NULL);
+}
+
+cJSON *cJSON_CreateBool(cJSON_bool boolean)
+{
+    return item_new(boolean ? cJSON_True : cJSON_False);
+}
+
+cJSON_bool cJSON_AddItemToArray(cJSON *array, cJSON *item)
+{
+    if (!array || !item) {
+        return false;
+    }
+    if (!array->child) {
+        array->child = item;
+        item->prev = item;
+    } else {
+        cJSON *last = array->child->prev;
+        last->next = item;
+        item->prev = last;
+        array->child->prev = item;
+    }
+    return true;
+}
+
+cJSON_bool cJSON_AddItemToObject(cJSON *object, const char *string, cJSON *item)
+{
+    if (!item) {
+        return false;
+    }
+    item->string = strdup(string);
+    return cJSON_AddItemToArray(object, item);
+}
+
+cJSON *cJSON_AddNumberToObject(cJSON *object, const char *name, double number)
+{
+    cJSON *item = cJSON_CreateNumber(number);
+    return cJSON_AddItemToObject(object, name, item) ? item : NULL;
+}
+
+cJSON *cJSON_AddStringToObject(cJSON *object, const char *name, const char *string)
+{
+    cJSON *item = cJSON_CreateString(string);
+    return cJSON_AddItemToObject(object, name, item) ? item : NULL;
+}
+
+cJSON *cJSON_AddBoolToObject(cJSON *object, const char *name, cJSON_bool boolean)
+{
+    cJSON *item = cJSON_CreateBool(boolean);
+    return cJSON_AddItemToObject(object, name, item) ? item : NULL;
+}
+
+cJSON *cJSON_AddNullToObject(cJSON *object, const char *name)
+{
+    cJSON *item = cJSON_CreateNull();
+    return cJSON_AddItemToObject(object, name, item) ? item : NULL;
+}
+
+cJSON *cJSON_AddObjectToObject(cJSON *object, const char *name)
+{
+    cJSON *item = cJSON_CreateObject();
+    return cJSON_AddItemToObject(object, name, item) ? item : NULL;
+}
+
+cJSON *cJSON_AddArrayToObject(cJSON *object, const char *name)
+{
+    cJSON *item = cJSON_CreateArray();
+    return cJSON_AddItemToObject(object, name, item) ? item : NULL;
+}
+
+cJSON *cJSON_GetObjectItem(const cJSON *object, const char *string)
+{
+    cJSON *item = object ? object->child : NULL;
+    while (item && (!item->string || strcasecmp(item->string, string) != 0)) {
+        item = item->next;
+    }
+    return item;
+}
+
+cJSON *cJSON_GetObjectItemCaseSensitive(const cJSON *object, const char *string)
+{
+    cJSON *item = object ? object->child : NULL;
+    while (item && (!item->string || strcmp(item->string, string) != 0)) {
+        item = item->next;
+    }
+    return item;
+}
+
+cJSON *cJSON_GetArrayItem(const cJSON *array, int index)
+{
+    cJSON *item = array ? array->child : NULL;
+    while (item && index-- > 0) {
+        item = item->next;
+    }
+    return item;
+}
+
+int cJSON_GetArraySize(const cJSON *array)
+{
+    int size = 0;
+    for (cJSON *item = array ? array->child : NULL; item; item = item->next) {
+        size++;
+    }
+    return size;
+}
+
+char *cJSON_GetStringValue(const cJSON *item)
+{
+    return cJSON_IsString(item) ? item->valuestring : NULL;
+}
+
+cJSON_bool cJSON_IsNull(const cJSON *item)
+{
+    return item && item->type == cJSON_NULL;
+}
+
+cJSON_bool cJSON_IsNumber(const cJSON *item)
+{
+    return item && item->type == cJSON_Number;
+}
+
+cJSON_bool cJSON_IsString(const cJSON *item)
+{
+    return item && item->type == cJSON_String;
+}
+
+cJSON_bool cJSON_IsArray(const cJSON *item)
+{
+    return item && item->type == cJSON_Array;
+}
+
+cJSON_bool cJSON_IsObject(const cJSON *item)
+{
+    return item && item->type == cJSON_Object;
+}
+
+cJSON_bool cJSON_IsTrue(const cJSON *item)
+{
+    return item && item->type == cJSON_True;
+}
+
+void cJSON_Delete(cJSON *item)
+{
+    while (item) {
+        cJSON *next = item->next;
+        cJSON_Delete(item->child);
+        free(item->valuestring);
+        free(item->string);
+        free(item);
+        item = next;
+    }
+}
@@ -0,0 +1,63 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+typedef void *SemaphoreHandle_t;
+
+/* The host tests run in one thread: the mutexes are always available, and a binary semaphore which was not given
+   times out at once, after the simulated ticks of its timeout. */
+typedef struct stub_binary_semaphore {
+    bool given;
+} stub_binary_semaphore_t;
+
+#define STUB_SEMAPHORE_MUTEX ((SemaphoreHandle_t)1)
+
+static inline SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+    return STUB_SEMAPHORE_MUTEX;
+}
+
+static inline SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+    return calloc(1, sizeof(stub_binary_semaphore_t));
+}
+
+static inline BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks)
+{
+    stub_binary_semaphore_t *binary = sem;
+
+    if (sem == NULL || sem == STUB_SEMAPHORE_MUTEX) {
+        return pdTRUE;
+    }
+    if (binary->given) {
+        binary->given = false;
+        return pdTRUE;
+    }
+    if (ticks != portMAX_DELAY) {
+        vTaskDelay(ticks);
+    }
+    return pdFALSE;
+}
+
+static inline BaseType_t xSemaphoreGive(SemaphoreHandle_t sem)
+{
+    stub_binary_semaphore_t *binary = sem;
+
+    if (sem == NULL || sem == STUB_SEMAPHORE_MUTEX) {
+        return pdTRUE;
+    }
+    if (binary->given) {
+        return pdFALSE;
+    }
+    binary->given = true;
+    return pdTRUE;
+}
@@ -0,0 +1,24 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+
+typedef void *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+
+extern TickType_t stub_tick_count;
+
+static inline TickType_t xTaskGetTickCount(void)
+{
+    return stub_tick_count;
+}
+
+static inline void vTaskDelay(TickType_t ticks)
+{
+    stub_tick_count += ticks;
+}
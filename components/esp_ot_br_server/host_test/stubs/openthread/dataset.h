@@ -0,0 +1,50 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+#include "openthread/ip6.h"
+
+#define OT_EXT_ADDRESS_SIZE 8
+
+typedef uint16_t otPanId;
+
+typedef struct otExtAddress {
+    uint8_t m8[OT_EXT_ADDRESS_SIZE];
+} otExtAddress;
+
+typedef struct otNetworkName {
+    char m8[17];
+} otNetworkName;
+
+typedef struct otExtendedPanId {
+    uint8_t m8[8];
+} otExtendedPanId;
+
+typedef struct otNetworkKey {
+    uint8_t m8[16];
+} otNetworkKey;
+
+typedef struct otPskc {
+    uint8_t m8[16];
+} otPskc;
+
+typedef struct otTimestamp {
+    uint64_t mSeconds;
+    uint16_t mTicks;
+    bool mAuthoritative;
+} otTimestamp;
+
+typedef struct otSecurityPolicy {
+    uint16_t mRotationTime;
+} otSecurityPolicy;
+
+typedef struct otOperationalDataset {
+    otTimestamp mActiveTimestamp;
+} otOperationalDataset;
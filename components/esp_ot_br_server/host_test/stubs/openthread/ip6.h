@@ -0,0 +1,55 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "openthread/error.h"
+#include "openthread/instance.h"
+
+#define OT_IP6_PREFIX_STRING_SIZE 45
+#define OT_IP6_ADDRESS_STRING_SIZE 40
+#define OT_IP6_ADDRESS_BITSIZE 128
+
+typedef struct otIp6Address {
+    uint8_t m8[16];
+} otIp6Address;
+
+typedef struct otIp6Prefix {
+    otIp6Address mPrefix;
+    uint8_t mLength;
+} otIp6Prefix;
+
+enum {
+    OT_ADDRESS_ORIGIN_THREAD = 0,
+    OT_ADDRESS_ORIGIN_SLAAC = 1,
+    OT_ADDRESS_ORIGIN_DHCPV6 = 2,
+    OT_ADDRESS_ORIGIN_MANUAL = 3,
+};
+
+typedef struct otNetifAddress {
+    otIp6Address mAddress;
+    uint8_t mPrefixLength;
+    uint8_t mAddressOrigin;
+    bool mPreferred : 1;
+    bool mValid : 1;
+    bool mScopeOverrideValid : 1;
+    unsigned int mScopeOverride : 4;
+    bool mRloc : 1;
+    bool mMeshLocal : 1;
+    bool mSrpRegistered : 1;
+    const struct otNetifAddress *mNext;
+} otNetifAddress;
+
+otError otIp6AddressFromString(const char *string, otIp6Address *address);
+void otIp6AddressToString(const otIp6Address *address, char *buffer, uint16_t size);
+const otNetifAddress *otIp6GetUnicastAddresses(otInstance *instance);
+bool otIp6HasUnicastAddress(otInstance *instance, const otIp6Address *address);
+otError otIp6AddUnicastAddress(otInstance *instance, const otNetifAddress *address);
+otError otIp6RemoveUnicastAddress(otInstance *instance, const otIp6Address *address);
+bool otIp6IsEnabled(otInstance *aInstance);
+otError otIp6SetEnabled(otInstance *aInstance, bool aEnabled);
@@ -0,0 +1,39 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "openthread/dataset.h"
+#include "openthread/error.h"
+#include "openthread/instance.h"
+
+#define OT_PANID_BROADCAST 0xffff
+
+typedef struct otActiveScanResult {
+    otExtAddress mExtAddress;
+    otNetworkName mNetworkName;
+    otExtendedPanId mExtendedPanId;
+    uint16_t mPanId;
+    uint8_t mChannel;
+    int8_t mRssi;
+    uint8_t mLqi;
+} otActiveScanResult;
+
+typedef struct otEnergyScanResult {
+    uint8_t mChannel;
+    int8_t mMaxRssi;
+} otEnergyScanResult;
+
+typedef void (*otHandleActiveScanResult)(otActiveScanResult *aResult, void *aContext);
+typedef void (*otHandleEnergyScanResult)(otEnergyScanResult *aResult, void *aContext);
+
+uint32_t otLinkGetSupportedChannelMask(otInstance *aInstance);
+otPanId otLinkGetPanId(otInstance *aInstance);
+otError otLinkActiveScan(otInstance *aInstance, uint32_t aScanChannels, uint16_t aScanDuration,
+                         otHandleActiveScanResult aCallback, void *aCallbackContext);
+otError otLinkEnergyScan(otInstance *aInstance, uint32_t aScanChannels, uint16_t aScanDuration,
+                         otHandleEnergyScanResult aCallback, void *aCallbackContext);
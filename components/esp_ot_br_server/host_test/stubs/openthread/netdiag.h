@@ -0,0 +1,57 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "openthread/thread.h"
+
+/* The diagnostic TLVs of the topology, with the layout of OpenThread. */
+#define OT_NETWORK_DIAGNOSTIC_TLV_EXT_ADDRESS 0
+#define OT_NETWORK_DIAGNOSTIC_TLV_SHORT_ADDRESS 1
+#define OT_NETWORK_DIAGNOSTIC_TLV_MODE 2
+#define OT_NETWORK_DIAGNOSTIC_TLV_ROUTE 5
+#define OT_NETWORK_DIAGNOSTIC_TLV_LEADER_DATA 6
+#define OT_NETWORK_DIAGNOSTIC_TLV_CHILD_TABLE 16
+
+#define OT_NETWORK_BASE_TLV_MAX_LENGTH 254
+#define OT_NETWORK_MAX_ROUTER_ID 62
+
+typedef struct otNetworkDiagRouteData {
+    uint8_t mRouterId;
+    uint8_t mLinkQualityOut : 2;
+    uint8_t mLinkQualityIn : 2;
+    uint8_t mRouteCost : 4;
+} otNetworkDiagRouteData;
+
+typedef struct otNetworkDiagRoute {
+    uint8_t mIdSequence;
+    uint8_t mRouteCount;
+    otNetworkDiagRouteData mRouteData[OT_NETWORK_MAX_ROUTER_ID + 1];
+} otNetworkDiagRoute;
+
+typedef struct otNetworkDiagChildEntry {
+    uint16_t mTimeout : 5;
+    uint8_t mLinkQuality : 2;
+    uint16_t mChildId : 9;
+    otLinkModeConfig mMode;
+} otNetworkDiagChildEntry;
+
+typedef struct otNetworkDiagChildTable {
+    uint8_t mCount;
+    otNetworkDiagChildEntry mTable[OT_NETWORK_BASE_TLV_MAX_LENGTH / 3];
+} otNetworkDiagChildTable;
+
+typedef struct otNetworkDiagTlv {
+    uint8_t mType;
+    union {
+        otExtAddress mExtAddress;
+        uint16_t mAddr16;
+        otLinkModeConfig mMode;
+        otLeaderData mLeaderData;
+        otNetworkDiagRoute mRoute;
+        otNetworkDiagChildTable mChildTable;
+    } mData;
+} otNetworkDiagTlv;
@@ -0,0 +1,33 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "openthread/dataset.h"
+
+typedef enum otDeviceRole {
+    OT_DEVICE_ROLE_DISABLED = 0,
+    OT_DEVICE_ROLE_DETACHED = 1,
+    OT_DEVICE_ROLE_CHILD = 2,
+    OT_DEVICE_ROLE_ROUTER = 3,
+    OT_DEVICE_ROLE_LEADER = 4,
+} otDeviceRole;
+
+typedef struct otLinkModeConfig {
+    bool mRxOnWhenIdle : 1;
+    bool mDeviceType : 1;
+    bool mNetworkData : 1;
+} otLinkModeConfig;
+
+typedef struct otLeaderData {
+    uint32_t mPartitionId;
+    uint8_t mWeighting;
+    uint8_t mDataVersion;
+    uint8_t mStableDataVersion;
+    uint8_t mLeaderRouterId;
+} otLeaderData;
+
+otDeviceRole otThreadGetDeviceRole(otInstance *aInstance);
@@ -0,0 +1,23 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include "esp_br_web_base.h"
+#include "freertos/task.h"
+
+TickType_t stub_tick_count = 1;
+
+/* esp_br_web_base.c needs the OpenThread stack, the topology only uses its hex_to_string(). */
+esp_err_t hex_to_string(const uint8_t hex[], char str[], size_t size)
+{
+    if (hex == NULL) {
+        return ESP_FAIL;
+    }
+    for (size_t i = 0; i < size; i++) {
+        snprintf(&str[i * 2], 3, "%02x", hex[i]);
+    }
+    return ESP_OK;
+}
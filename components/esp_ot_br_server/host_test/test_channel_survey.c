@@ -0,0 +1,349 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "esp_br_web_channel_survey.h"
+#include "esp_openthread.h"
+#include "esp_openthread_lock.h"
+#include "esp_timer.h"
+#include "freertos/task.h"
+#include "host_test.h"
+#include "openthread/ip6.h"
+#include "openthread/link.h"
+#include "openthread/platform/radio.h"
+#include "openthread/thread.h"
+
+/*
+ * Runs the channel survey against scripted scans: the active scan reports its beacons and the energy scans report the
+ * samples of their pass, all before they return, and each energy pass takes its scan time on the simulated clock. A
+ * scan which does not complete never reports its end, its callback and context are kept to report late.
+ */
+#define TEST_OWN_PANID 0x1234
+
+typedef struct energy_sample {
+    uint8_t pass;
+    uint8_t channel;
+    int8_t rssi;
+} energy_sample_t;
+
+static uint32_t s_supported_mask;
+static otDeviceRole s_role = OT_DEVICE_ROLE_LEADER;
+static bool s_ip6_enabled = true;
+static int s_ip6_enable_calls;
+static uint32_t s_scanned_mask;
+static int64_t s_now_us;
+
+static const otActiveScanResult *s_beacons;
+static int s_beacon_count;
+static bool s_active_completes = true;
+static int s_active_calls;
+
+static const energy_sample_t *s_samples;
+static int s_sample_count;
+static int s_energy_pass;
+
+static otHandleActiveScanResult s_late_active;
+static void *s_late_context;
+
+otInstance *esp_openthread_get_instance(void)
+{
+    return NULL;
+}
+
+bool esp_openthread_lock_acquire(TickType_t block_ticks)
+{
+    return true;
+}
+
+void esp_openthread_lock_release(void)
+{
+}
+
+int64_t esp_timer_get_time(void)
+{
+    return s_now_us;
+}
+
+const char *otThreadErrorToString(otError error)
+{
+    return error == OT_ERROR_NONE ? "OK" : "Error";
+}
+
+otDeviceRole otThreadGetDeviceRole(otInstance *aInstance)
+{
+    return s_role;
+}
+
+otPanId otLinkGetPanId(otInstance *aInstance)
+{
+    return TEST_OWN_PANID;
+}
+
+uint32_t otLinkGetSupportedChannelMask(otInstance *aInstance)
+{
+    return s_supported_mask;
+}
+
+bool otIp6IsEnabled(otInstance *aInstance)
+{
+    return s_ip6_enabled;
+}
+
+otError otIp6SetEnabled(otInstance *aInstance, bool aEnabled)
+{
+    s_ip6_enable_calls++;
+    s_ip6_enabled = aEnabled;
+    return OT_ERROR_NONE;
+}
+
+otError otLinkActiveScan(otInstance *aInstance, uint32_t aScanChannels, uint16_t aScanDuration,
+                         otHandleActiveScanResult aCallback, void *aCallbackContext)
+{
+    s_active_calls++;
+    s_scanned_mask = aScanChannels;
+    /* The beacons and the end of the scan of a previous survey which gave up on it. */
+    if (s_late_active) {
+        otActiveScanResult late = {.mPanId = 0x7777, .mChannel = 11, .mRssi = -30};
+        s_late_active(&late, s_late_context);
+        s_late_active(NULL, s_late_context);
+        s_late_active = NULL;
+    }
+    for (int i = 0; i < s_beacon_count; i++) {
+        otActiveScanResult beacon = s_beacons[i];
+        aCallback(&beacon, aCallbackContext);
+    }
+    if (s_active_completes) {
+        aCallback(NULL, aCallbackContext);
+    } else {
+        s_late_active = aCallback;
+        s_late_context = aCallbackContext;
+    }
+    return OT_ERROR_NONE;
+}
+
+otError otLinkEnergyScan(otInstance *aInstance, uint32_t aScanChannels, uint16_t aScanDuration,
+                         otHandleEnergyScanResult aCallback, void *aCallbackContext)
+{
+    int channels = 0;
+
+    TEST_ASSERT_EQUAL(s_scanned_mask, aScanChannels);
+    for (int i = 0; i < s_sample_count; i++) {
+        if (s_samples[i].pass == s_energy_pass) {
+            otEnergyScanResult result = {.mChannel = s_samples[i].channel, .mMaxRssi = s_samples[i].rssi};
+            aCallback(&result, aCallbackContext);
+        }
+    }
+    for (uint32_t bits = aScanChannels; bits; bits &= bits - 1) {
+        channels++;
+    }
+    s_now_us += (int64_t)channels * aScanDuration * 1000;
+    s_energy_pass++;
+    aCallback(NULL, aCallbackContext);
+    return OT_ERROR_NONE;
+}
+
+static void script(uint32_t supported_mask, const otActiveScanResult *beacons, int beacon_count,
+                   const energy_sample_t *samples, int sample_count)
+{
+    s_supported_mask = supported_mask;
+    s_beacons = beacons;
+    s_beacon_count = beacon_count;
+    s_samples = samples;
+    s_sample_count = sample_count;
+    s_energy_pass = 0;
+    s_active_completes = true;
+}
+
+static const cJSON *find_channel(const cJSON *survey, int channel)
+{
+    const cJSON *channels = cJSON_GetObjectItem(survey, "Channels");
+
+    for (int i = 0; i < cJSON_GetArraySize(channels); i++) {
+        const cJSON *item = cJSON_GetArrayItem(channels, i);
+        if (cJSON_GetObjectItem(item, "Channel")->valuedouble == channel) {
+            return item;
+        }
+    }
+    return NULL;
+}
+
+static int channel_number(const cJSON *survey, int channel, const char *key)
+{
+    const cJSON *item = find_channel(survey, channel);
+
+    TEST_ASSERT_NOT_NULL(item);
+    TEST_ASSERT_NOT_NULL(cJSON_GetObjectItem(item, key));
+    return (int)cJSON_GetObjectItem(item, key)->valuedouble;
+}
+
+static void test_no_survey(void)
+{
+    TEST_ASSERT_EQUAL(0, channel_survey_recommended());
+    TEST_ASSERT_NULL(channel_survey_convert2_json());
+}
+
+static void test_invalid_arguments(void)
+{
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, channel_survey_run(CHANNEL_SURVEY_MAX_DURATION_MS + 1, 100));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, channel_survey_run(0, CHANNEL_SURVEY_MIN_SCAN_MS - 1));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, channel_survey_run(0, CHANNEL_SURVEY_MAX_SCAN_MS + 1));
+    TEST_ASSERT_EQUAL(0, s_active_calls);
+}
+
+/*
+ * One pass. The scores are the average RSSI over the floor, a quarter of the max RSSI over the floor and 8 for each
+ * other PAN: channel 26 scores 8 + 2 = 10, channel 11 10 + 2 = 12, channel 15 5 + 1 + 8 = 14, channel 20 0 + 0 + 24
+ * and channel 25 40 + 10 = 50.
+ */
+static void test_single_pass_ranking(void)
+{
+    static const otActiveScanResult beacons[] = {
+        {.mPanId = TEST_OWN_PANID, .mChannel = 15, .mRssi = -40}, /* this node's PAN is not counted */
+        {.mPanId = 0xabcd, .mChannel = 15, .mRssi = -70},
+        {.mPanId = 0xabcd, .mChannel = 15, .mRssi = -60}, /* the same PAN again, a stronger beacon */
+        {.mPanId = 1, .mChannel = 20, .mRssi = -80},
+        {.mPanId = 2, .mChannel = 20, .mRssi = -85},
+        {.mPanId = 3, .mChannel = 20, .mRssi = -90},
+        {.mPanId = 4, .mChannel = 10, .mRssi = -50}, /* not a 2.4 GHz channel of page 0 */
+    };
+    static const energy_sample_t samples[] = {
+        {0, 11, -90}, {0, 15, -95}, {0, 20, -100}, {0, 25, -60}, {0, 26, -92},
+        {0, 12, OT_RADIO_RSSI_INVALID}, /* an invalid sample of a supported channel */
+        {0, 10, -20},                   /* out of range */
+    };
+    /* Channels 11, 12, 15, 20, 25, 26, and channel 10, which the survey must not scan. */
+    uint32_t mask = (1u << 10) | (1u << 11) | (1u << 12) | (1u << 15) | (1u << 20) | (1u << 25) | (1u << 26);
+
+    script(mask, beacons, sizeof(beacons) / sizeof(beacons[0]), samples, sizeof(samples) / sizeof(samples[0]));
+    s_now_us = 10 * 1000000LL;
+    TEST_ASSERT_EQUAL(ESP_OK, channel_survey_run(0, 100));
+    TEST_ASSERT_EQUAL(mask & ~(1u << 10), s_scanned_mask);
+    TEST_ASSERT_EQUAL(1, s_energy_pass);
+    TEST_ASSERT_EQUAL(26, channel_survey_recommended());
+
+    cJSON *survey = channel_survey_convert2_json();
+    TEST_ASSERT_NOT_NULL(survey);
+    TEST_ASSERT_EQUAL(1, cJSON_GetObjectItem(survey, "Passes")->valuedouble);
+    TEST_ASSERT_EQUAL(26, cJSON_GetObjectItem(survey, "Recommended")->valuedouble);
+    TEST_ASSERT_EQUAL(100, cJSON_GetObjectItem(survey, "ScanDuration")->valuedouble);
+    TEST_ASSERT_EQUAL(600, cJSON_GetObjectItem(survey, "Duration")->valuedouble);
+    TEST_ASSERT_EQUAL(10, cJSON_GetObjectItem(survey, "Time")->valuedouble);
+    /* Channel 12 has no valid sample and is left out. */
+    TEST_ASSERT_EQUAL(5, cJSON_GetArraySize(cJSON_GetObjectItem(survey, "Channels")));
+    TEST_ASSERT_NULL(find_channel(survey, 12));
+
+    static const int expected[][3] = {{26, 1, 10}, {11, 2, 12}, {15, 3, 14}, {20, 4, 24}, {25, 5, 50}};
+    for (size_t i = 0; i < sizeof(expected) / sizeof(expected[0]); i++) {
+        TEST_ASSERT_EQUAL(expected[i][1], channel_number(survey, expected[i][0], "Rank"));
+        TEST_ASSERT_EQUAL(expected[i][2], channel_number(survey, expected[i][0], "Score"));
+        TEST_ASSERT_EQUAL(1, channel_number(survey, expected[i][0], "Samples"));
+    }
+    TEST_ASSERT_EQUAL(1, channel_number(survey, 15, "Pans"));
+    TEST_ASSERT_EQUAL(-60, channel_number(survey, 15, "MaxBeaconRssi"));
+    TEST_ASSERT_EQUAL(3, channel_number(survey, 20, "Pans"));
+    TEST_ASSERT_EQUAL(-80, channel_number(survey, 20, "MaxBeaconRssi"));
+    TEST_ASSERT_EQUAL(-60, channel_number(survey, 25, "AvgRssi"));
+    TEST_ASSERT_EQUAL(0, channel_number(survey, 11, "Pans"));
+    TEST_ASSERT(cJSON_IsNull(cJSON_GetObjectItem(find_channel(survey, 11), "MaxBeaconRssi")));
+    cJSON_Delete(survey);
+}
+
+/*
+ * Two channels of 100 ms are 200 ms a pass, a survey of 300 ms runs two passes. Both channels average -90 dBm and
+ * score 10 + 2 = 12, channel 12 is ranked first for its lower max RSSI.
+ */
+static void test_passes_and_ties(void)
+{
+    static const energy_sample_t samples[] = {
+        {0, 12, -90}, {0, 13, -91}, {1, 12, -90}, {1, 13, -89}, {2, 12, -20}, /* never reached */
+    };
+
+    script((1u << 12) | (1u << 13), NULL, 0, samples, sizeof(samples) / sizeof(samples[0]));
+    s_now_us = 0;
+    TEST_ASSERT_EQUAL(ESP_OK, channel_survey_run(300, 100));
+    TEST_ASSERT_EQUAL(2, s_energy_pass);
+    TEST_ASSERT_EQUAL(12, channel_survey_recommended());
+
+    cJSON *survey = channel_survey_convert2_json();
+    TEST_ASSERT_EQUAL(2, cJSON_GetObjectItem(survey, "Passes")->valuedouble);
+    TEST_ASSERT_EQUAL(400, cJSON_GetObjectItem(survey, "Duration")->valuedouble);
+    TEST_ASSERT_EQUAL(12, channel_number(survey, 12, "Score"));
+    TEST_ASSERT_EQUAL(12, channel_number(survey, 13, "Score"));
+    TEST_ASSERT_EQUAL(1, channel_number(survey, 12, "Rank"));
+    TEST_ASSERT_EQUAL(2, channel_number(survey, 13, "Rank"));
+    TEST_ASSERT_EQUAL(-89, channel_number(survey, 13, "MaxRssi"));
+    TEST_ASSERT_EQUAL(2, channel_number(survey, 13, "Samples"));
+    cJSON_Delete(survey);
+}
+
+/* Without a network every PAN is another one, and IPv6 is brought up for the scans. */
+static void test_disabled_node(void)
+{
+    static const otActiveScanResult beacons[] = {
+        {.mPanId = TEST_OWN_PANID, .mChannel = 14, .mRssi = -40},
+    };
+    static const energy_sample_t samples[] = {{0, 14, -100}};
+
+    s_role = OT_DEVICE_ROLE_DISABLED;
+    s_ip6_enabled = false;
+    script(1u << 14, beacons, 1, samples, 1);
+    TEST_ASSERT_EQUAL(ESP_OK, channel_survey_run(0, 10));
+    TEST_ASSERT_EQUAL(1, s_ip6_enable_calls);
+    TEST_ASSERT(s_ip6_enabled);
+
+    cJSON *survey = channel_survey_convert2_json();
+    TEST_ASSERT_EQUAL(1, channel_number(survey, 14, "Pans"));
+    TEST_ASSERT_EQUAL(8, channel_number(survey, 14, "Score"));
+    cJSON_Delete(survey);
+    s_role = OT_DEVICE_ROLE_LEADER;
+}
+
+/*
+ * An active scan which does not report its end fails the survey and keeps the previous result. When it reports
+ * during the next survey, neither its beacon nor its end are taken for the new scan's.
+ */
+static void test_timeout_and_late_scan(void)
+{
+    static const otActiveScanResult beacons[] = {{.mPanId = 0x4321, .mChannel = 16, .mRssi = -75}};
+    static const energy_sample_t samples[] = {{0, 11, -100}, {0, 16, -100}};
+
+    script((1u << 11) | (1u << 16), beacons, 1, samples, 2);
+    s_active_completes = false;
+    stub_tick_count = 1;
+    TEST_ASSERT_EQUAL(ESP_ERR_TIMEOUT, channel_survey_run(0, 100));
+    /* The wait is the active scan time of each channel and a margin. */
+    TEST_ASSERT_EQUAL(1 + 2 * 300 + 2000, stub_tick_count);
+    TEST_ASSERT_EQUAL(0, s_energy_pass);
+    TEST_ASSERT_EQUAL(14, channel_survey_recommended());
+    TEST_ASSERT_NOT_NULL(s_late_active);
+
+    /* The next active scan completes, the late one reports first: a PAN on channel 11 and its end. */
+    s_active_completes = true;
+    TEST_ASSERT_EQUAL(ESP_OK, channel_survey_run(0, 100));
+    TEST_ASSERT_EQUAL(1, s_energy_pass);
+    TEST_ASSERT_EQUAL(11, channel_survey_recommended());
+
+    cJSON *survey = channel_survey_convert2_json();
+    TEST_ASSERT_EQUAL(0, channel_number(survey, 11, "Pans"));
+    TEST_ASSERT_EQUAL(1, channel_number(survey, 16, "Pans"));
+    TEST_ASSERT_EQUAL(1, channel_number(survey, 11, "Rank"));
+    cJSON_Delete(survey);
+}
+
+int main(void)
+{
+    channel_survey_init();
+    RUN_TEST(test_no_survey);
+    RUN_TEST(test_invalid_arguments);
+    RUN_TEST(test_single_pass_ranking);
+    RUN_TEST(test_passes_and_ties);
+    RUN_TEST(test_disabled_node);
+    RUN_TEST(test_timeout_and_late_scan);
+    return 0;
+}
@@ -0,0 +1,181 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <math.h>
+#include "esp_br_web_diag_scheduler.h"
+#include "host_test.h"
+#include "freertos/task.h"
+
+#define TEST_LONG_DEADLINE pdMS_TO_TICKS(3600 * 1000)
+
+static double scheduler_metric(const char *name)
+{
+    cJSON *metrics = diag_scheduler_metrics_convert2_json();
+    cJSON *item = cJSON_GetObjectItemCaseSensitive(metrics, name);
+    TEST_ASSERT_NOT_NULL(item);
+    double value = item->valuedouble;
+    cJSON_Delete(metrics);
+    return value;
+}
+
+static uint32_t scheduler_rate_milli(void)
+{
+    return (uint32_t)lround(scheduler_metric("CurrentRate") * 1000);
+}
+
+static void scheduler_reset(uint16_t rate, uint16_t burst)
+{
+    diag_scheduler_init();
+    TEST_ASSERT_EQUAL(ESP_OK, diag_scheduler_configure(rate, burst));
+}
+
+static void test_multicast_is_charged_in_full(void)
+{
+    scheduler_reset(10, 4);
+
+    /* A full bucket lets the 64 routers multicast go, the bucket owes 60 tokens afterwards. */
+    TickType_t start = xTaskGetTickCount();
+    TEST_ASSERT_EQUAL(ESP_OK, diag_scheduler_acquire(64, start + TEST_LONG_DEADLINE));
+    TEST_ASSERT_EQUAL(start, xTaskGetTickCount());
+    TEST_ASSERT_EQUAL(-60, scheduler_metric("Tokens"));
+
+    /* The next query waits for the debt and its own token, 61 tokens at 10 per second. */
+    TEST_ASSERT_EQUAL(ESP_ERR_TIMEOUT, diag_scheduler_acquire(1, start + pdMS_TO_TICKS(6000)));
+    TEST_ASSERT_EQUAL(1, scheduler_metric("Deferred"));
+    TEST_ASSERT_EQUAL(ESP_OK, diag_scheduler_acquire(1, start + TEST_LONG_DEADLINE));
+    TEST_ASSERT_EQUAL(pdMS_TO_TICKS(6100), xTaskGetTickCount() - start);
+    TEST_ASSERT_EQUAL(65, scheduler_metric("Issued"));
+}
+
+static void test_multicast_rate_holds(void)
+{
+    scheduler_reset(10, 4);
+
+    /* 20 multicasts of 64 routers cost 1280 tokens, the bucket holds 4 at the start. */
+    TickType_t start = xTaskGetTickCount();
+    for (int i = 0; i < 20; i++) {
+        TEST_ASSERT_EQUAL(ESP_OK, diag_scheduler_acquire(64, start + TEST_LONG_DEADLINE));
+    }
+    TEST_ASSERT_EQUAL(pdMS_TO_TICKS((20 * 64 - 64) * 100), xTaskGetTickCount() - start);
+}
+
+static void test_expire_only_owner(void)
+{
+    scheduler_reset(10, 4);
+
+    diag_scheduler_sent(DIAG_SCHEDULER_OWNER_SWEEP, 0x0800);
+    diag_scheduler_sent(DIAG_SCHEDULER_OWNER_SWEEP, 0x0c00);
+    diag_scheduler_sent(DIAG_SCHEDULER_OWNER_WEB, 0x0c00);
+    diag_scheduler_sent(DIAG_SCHEDULER_OWNER_WEB, DIAG_SCHEDULER_MULTICAST);
+
+    /* The sweep ends first, its lost query halves the rate but the web queries keep waiting. */
+    vTaskDelay(pdMS_TO_TICKS(100));
+    diag_scheduler_responded(DIAG_SCHEDULER_OWNER_SWEEP, 0x0800);
+    TEST_ASSERT_EQUAL(100, scheduler_metric("LatencyAvgMs"));
+    diag_scheduler_expire(DIAG_SCHEDULER_OWNER_SWEEP);
+    TEST_ASSERT_EQUAL(1, scheduler_metric("Lost"));
+    TEST_ASSERT_EQUAL(5000, scheduler_rate_milli());
+
+    /* The responses to the web collection are still measured, from their own send time. */
+    vTaskDelay(pdMS_TO_TICKS(100));
+    diag_scheduler_responded(DIAG_SCHEDULER_OWNER_WEB, 0x0c00);
+    TEST_ASSERT_EQUAL(200, scheduler_metric("LatencyMaxMs"));
+    diag_scheduler_responded(DIAG_SCHEDULER_OWNER_WEB, 0x1000);
+    TEST_ASSERT_EQUAL(3, scheduler_metric("Responses"));
+    TEST_ASSERT_EQUAL(5200, scheduler_rate_milli());
+
+    /* Every web query was answered, nothing is lost when the web collection ends. */
+    diag_scheduler_expire(DIAG_SCHEDULER_OWNER_WEB);
+    TEST_ASSERT_EQUAL(1, scheduler_metric("Lost"));
+    TEST_ASSERT_EQUAL(5200, scheduler_rate_milli());
+
+    /* A response after the end of its collection carries no latency sample. */
+    diag_scheduler_responded(DIAG_SCHEDULER_OWNER_WEB, 0x1400);
+    TEST_ASSERT_EQUAL(5200, scheduler_rate_milli());
+}
+
+typedef enum {
+    REPLAY_SENT,
+    REPLAY_RESPONDED,
+    REPLAY_EXPIRE,
+} replay_action_t;
+
+typedef struct replay_event {
+    uint32_t delay_ms;
+    replay_action_t action;
+    diag_scheduler_owner_t owner;
+    uint16_t rloc16;
+    uint32_t rate_milli; /* the current rate expected after the event */
+} replay_event_t;
+
+/* A sweep and a web collection overlapping on a mesh where 0x1800 is slow and 0x2000 does not respond. */
+static const replay_event_t s_replay[] = {
+    {0, REPLAY_SENT, DIAG_SCHEDULER_OWNER_SWEEP, 0x0800, 10000},
+    {0, REPLAY_SENT, DIAG_SCHEDULER_OWNER_SWEEP, 0x1800, 10000},
+    {0, REPLAY_SENT, DIAG_SCHEDULER_OWNER_SWEEP, 0x2000, 10000},
+    {120, REPLAY_RESPONDED, DIAG_SCHEDULER_OWNER_SWEEP, 0x0800, 10000}, /* in time at the configured rate */
+    {300, REPLAY_SENT, DIAG_SCHEDULER_OWNER_WEB, 0x0800, 10000},
+    {200, REPLAY_RESPONDED, DIAG_SCHEDULER_OWNER_WEB, 0x0800, 10000},
+    {1500, REPLAY_RESPONDED, DIAG_SCHEDULER_OWNER_SWEEP, 0x1800, 8750}, /* 2120 ms, decreased by 1/8 */
+    {0, REPLAY_EXPIRE, DIAG_SCHEDULER_OWNER_WEB, 0, 8750},              /* the web has nothing pending */
+    {2880, REPLAY_EXPIRE, DIAG_SCHEDULER_OWNER_SWEEP, 0, 4375},         /* 0x2000 lost, halved */
+    {0, REPLAY_SENT, DIAG_SCHEDULER_OWNER_WEB, DIAG_SCHEDULER_MULTICAST, 4375},
+    {400, REPLAY_RESPONDED, DIAG_SCHEDULER_OWNER_WEB, 0x0800, 4475},
+    {100, REPLAY_RESPONDED, DIAG_SCHEDULER_OWNER_WEB, 0x0c00, 4575},
+    {1200, REPLAY_RESPONDED, DIAG_SCHEDULER_OWNER_WEB, 0x1800, 4003}, /* 1700 ms after the multicast */
+    {0, REPLAY_EXPIRE, DIAG_SCHEDULER_OWNER_WEB, 0, 4003},
+    {0, REPLAY_SENT, DIAG_SCHEDULER_OWNER_SWEEP, 0x2000, 4003},
+    {5000, REPLAY_EXPIRE, DIAG_SCHEDULER_OWNER_SWEEP, 0, 2001},
+    {0, REPLAY_SENT, DIAG_SCHEDULER_OWNER_SWEEP, 0x2000, 2001},
+    {5000, REPLAY_EXPIRE, DIAG_SCHEDULER_OWNER_SWEEP, 0, 1000},
+    {0, REPLAY_SENT, DIAG_SCHEDULER_OWNER_SWEEP, 0x2000, 1000},
+    {5000, REPLAY_EXPIRE, DIAG_SCHEDULER_OWNER_SWEEP, 0, 500},
+    {0, REPLAY_SENT, DIAG_SCHEDULER_OWNER_SWEEP, 0x2000, 500},
+    {5000, REPLAY_EXPIRE, DIAG_SCHEDULER_OWNER_SWEEP, 0, 500}, /* never below 0.5 query per second */
+};
+
+static void test_aimd_replay(void)
+{
+    scheduler_reset(10, 4);
+
+    for (size_t i = 0; i < sizeof(s_replay) / sizeof(s_replay[0]); i++) {
+        const replay_event_t *event = &s_replay[i];
+        vTaskDelay(pdMS_TO_TICKS(event->delay_ms));
+        switch (event->action) {
+        case REPLAY_SENT:
+            diag_scheduler_sent(event->owner, event->rloc16);
+            break;
+        case REPLAY_RESPONDED:
+            diag_scheduler_responded(event->owner, event->rloc16);
+            break;
+        case REPLAY_EXPIRE:
+            diag_scheduler_expire(event->owner);
+            break;
+        }
+        if (scheduler_rate_milli() != event->rate_milli) {
+            fprintf(stderr, "replay event %zu: ", i);
+        }
+        TEST_ASSERT_EQUAL(event->rate_milli, scheduler_rate_milli());
+    }
+    TEST_ASSERT_EQUAL(5, scheduler_metric("Lost"));
+
+    /* The timely responses raise the rate back by 0.1 query per second each, up to the configured rate. */
+    for (int i = 0; i < 200; i++) {
+        diag_scheduler_sent(DIAG_SCHEDULER_OWNER_WEB, 0x0800);
+        vTaskDelay(pdMS_TO_TICKS(50));
+        diag_scheduler_responded(DIAG_SCHEDULER_OWNER_WEB, 0x0800);
+        TEST_ASSERT_EQUAL(i < 95 ? 600 + i * 100 : 10000, scheduler_rate_milli());
+    }
+}
+
+int main(void)
+{
+    RUN_TEST(test_multicast_is_charged_in_full);
+    RUN_TEST(test_multicast_rate_holds);
+    RUN_TEST(test_expire_only_owner);
+    RUN_TEST(test_aimd_replay);
+    return 0;
+}
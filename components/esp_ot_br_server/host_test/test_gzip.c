@@ -0,0 +1,249 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <zlib.h>
+
+#include "esp_br_web_gzip.h"
+#include "host_test.h"
+
+/*
+ * Compresses the /diagnostics response of 4, 16 and 64 routers networks with each window size of the stream, checks
+ * that zlib inflates it back and reports the trade-off: the bytes saved, the CPU time of the compression and the RAM
+ * of the stream. The responses are written as diagnosticTlv_list_convert2_json() prints them, with all the TLVs of
+ * the default query: each router has 3 children and routes to all the other routers. The link rate below which the
+ * compression shortens the response is the saved bits over the CPU time; the host CPU is much faster than an ESP32,
+ * whose compression time is given by GET /diagnostics?benchmark=true in a build with
+ * CONFIG_OPENTHREAD_BR_WEB_DIAG_BENCHMARK.
+ */
+#define TEST_OUTPUT_SIZE 1024 /* the output buffer of the benchmark of the API */
+#define TEST_CHILDREN 3
+#define TEST_PAYLOAD_MAX (512 * 1024)
+#define TEST_MIN_ROUNDS 20
+#define TEST_MIN_TIME_NS 200000000LL
+
+typedef struct payload {
+    char *text;
+    size_t len;
+} payload_t;
+
+typedef struct output {
+    uint8_t *data;
+    size_t len;
+} output_t;
+
+static uint32_t s_random = 0x2545f491;
+
+static uint32_t next_random(void)
+{
+    s_random ^= s_random << 13;
+    s_random ^= s_random >> 17;
+    s_random ^= s_random << 5;
+    return s_random;
+}
+
+static void append(payload_t *payload, const char *format, ...)
+{
+    va_list args;
+
+    va_start(args, format);
+    int len = vsnprintf(payload->text + payload->len, TEST_PAYLOAD_MAX - payload->len, format, args);
+    va_end(args);
+    TEST_ASSERT(len >= 0 && payload->len + len < TEST_PAYLOAD_MAX);
+    payload->len += len;
+}
+
+static void append_mode(payload_t *payload, bool router)
+{
+    append(payload, "{\"RxOnWhenIdle\":%d,\"DeviceType\":%d,\"NetworkData\":%d}", router, router, router);
+}
+
+static void append_router(payload_t *payload, int router, int routers)
+{
+    uint8_t ext[8];
+
+    for (int i = 0; i < 8; i++) {
+        ext[i] = (uint8_t)next_random();
+    }
+    append(payload, "{\"ExtAddress\":\"%02x%02x%02x%02x%02x%02x%02x%02x\",\"Rloc16\":%d,\"Mode\":", ext[0], ext[1],
+           ext[2], ext[3], ext[4], ext[5], ext[6], ext[7], router << 10);
+    append_mode(payload, true);
+    append(payload, ",\"Connectivity\":{\"ParentPriority\":0,\"LinkQuality3\":%d,\"LinkQuality2\":%d,"
+                    "\"LinkQuality1\":%d,\"LeaderCost\":%d,\"IdSequence\":183,\"ActiveRouters\":%d,"
+                    "\"SedBufferSize\":1280,\"SedDatagramCount\":1}",
+           (int)(next_random() % 4), (int)(next_random() % 3), (int)(next_random() % 2), router ? 1 + router % 3 : 0,
+           routers);
+    append(payload, ",\"Route\":{\"IdSequence\":183,\"RouteData\":[");
+    for (int i = 0; i < routers; i++) {
+        append(payload, "%s{\"RouteId\":%d,\"LinkQualityOut\":%d,\"LinkQualityIn\":%d,\"RouteCost\":%d}", i ? "," : "",
+               i, (int)(next_random() % 4), (int)(next_random() % 4), i == router ? 0 : 1 + (int)(next_random() % 4));
+    }
+    append(payload, "]},\"LeaderData\":{\"PartitionId\":1351345614,\"Weighting\":64,\"DataVersion\":42,"
+                    "\"StableDataVersion\":17,\"LeaderRouterId\":0}");
+    append(payload, ",\"NetworkData\":\"08040b02174d0b0e80010103031400fffe0a1002fd7a2f3c10000000000000030000\"");
+    append(payload, ",\"IP6AddressList\":[\"fdde:ad00:beef:0:0:ff:fe00:%x\",\"fdde:ad00:beef:0:%x:%x:%x:%x\","
+                    "\"fe80:0:0:0:%02x%02x:%02x%02x:%02x%02x:%02x%02x\"]",
+           router << 10, next_random() & 0xffff, next_random() & 0xffff, next_random() & 0xffff,
+           next_random() & 0xffff, ext[0] ^ 2, ext[1], ext[2], ext[3], ext[4], ext[5], ext[6], ext[7]);
+    append(payload, ",\"MACCounters\":{\"IfInUnknownProtos\":0,\"IfInErrors\":%u,\"IfOutErrors\":%u,"
+                    "\"IfInUcastPkts\":%u,\"IfInBroadcastPkts\":%u,\"IfInDiscards\":%u,\"IfOutUcastPkts\":%u,"
+                    "\"IfOutBroadcastPkts\":%u,\"IfOutDiscards\":%u}",
+           next_random() % 20, next_random() % 20, next_random() % 50000, next_random() % 5000, next_random() % 10,
+           next_random() % 50000, next_random() % 5000, next_random() % 10);
+    append(payload, ",\"ChildTable\":[");
+    for (int i = 0; i < TEST_CHILDREN; i++) {
+        append(payload, "%s{\"ChildId\":%d,\"Timeout\":%d,\"Mode\":", i ? "," : "", i + 1, i ? 240 : 10);
+        append_mode(payload, false);
+        append(payload, "}");
+    }
+    append(payload, "],\"ChannelPages\":\"00\",\"MaxChildTimeout\":240}");
+}
+
+static payload_t diagnostics_payload(int routers)
+{
+    payload_t payload = {.text = malloc(TEST_PAYLOAD_MAX), .len = 0};
+
+    TEST_ASSERT_NOT_NULL(payload.text);
+    append(&payload, "[");
+    for (int router = 0; router < routers; router++) {
+        append(&payload, router ? "," : "");
+        append_router(&payload, router, routers);
+    }
+    append(&payload, "]");
+    return payload;
+}
+
+static esp_err_t collect_output(void *context, const uint8_t *data, size_t len)
+{
+    output_t *output = context;
+
+    memcpy(output->data + output->len, data, len);
+    output->len += len;
+    return ESP_OK;
+}
+
+static int64_t now_ns(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+static size_t compress_payload(const payload_t *payload, uint8_t window_bits, output_t *output)
+{
+    size_t in_len = 0;
+
+    output->len = 0;
+    gzip_stream_t *stream = gzip_stream_create(window_bits, TEST_OUTPUT_SIZE, collect_output, output);
+    TEST_ASSERT_NOT_NULL(stream);
+    TEST_ASSERT_EQUAL(ESP_OK, gzip_stream_write(stream, payload->text, payload->len));
+    TEST_ASSERT_EQUAL(ESP_OK, gzip_stream_finish(stream));
+    gzip_stream_get_size(stream, &in_len, &output->len);
+    gzip_stream_destroy(stream);
+    TEST_ASSERT_EQUAL(payload->len, in_len);
+    return output->len;
+}
+
+static void check_inflate(const payload_t *payload, const output_t *output)
+{
+    uint8_t *inflated = malloc(payload->len + 1);
+    z_stream stream = {0};
+
+    TEST_ASSERT_NOT_NULL(inflated);
+    TEST_ASSERT_EQUAL(Z_OK, inflateInit2(&stream, 16 + MAX_WBITS));
+    stream.next_in = output->data;
+    stream.avail_in = output->len;
+    stream.next_out = inflated;
+    stream.avail_out = payload->len + 1;
+    TEST_ASSERT_EQUAL(Z_STREAM_END, inflate(&stream, Z_FINISH));
+    TEST_ASSERT_EQUAL(payload->len, stream.total_out);
+    TEST_ASSERT_EQUAL(0, memcmp(inflated, payload->text, payload->len));
+    inflateEnd(&stream);
+    free(inflated);
+}
+
+/* The size of the gzip of zlib at its default level, for reference. */
+static size_t zlib_gzip_size(const payload_t *payload)
+{
+    uLong bound = compressBound(payload->len) + 32;
+    uint8_t *data = malloc(bound);
+    z_stream stream = {0};
+
+    TEST_ASSERT_NOT_NULL(data);
+    TEST_ASSERT_EQUAL(Z_OK, deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 16 + MAX_WBITS, 8,
+                                         Z_DEFAULT_STRATEGY));
+    stream.next_in = (Bytef *)payload->text;
+    stream.avail_in = payload->len;
+    stream.next_out = data;
+    stream.avail_out = bound;
+    TEST_ASSERT_EQUAL(Z_STREAM_END, deflate(&stream, Z_FINISH));
+    size_t len = stream.total_out;
+    deflateEnd(&stream);
+    free(data);
+    return len;
+}
+
+static void run_payload(int routers)
+{
+    payload_t payload = diagnostics_payload(routers);
+    output_t output = {.data = malloc(TEST_PAYLOAD_MAX + 1024), .len = 0};
+    size_t previous_len = SIZE_MAX;
+
+    TEST_ASSERT_NOT_NULL(output.data);
+    printf("%d routers: %u bytes of JSON, zlib -6 %u bytes\n", routers, (unsigned)payload.len,
+           (unsigned)zlib_gzip_size(&payload));
+    for (uint8_t window_bits = 9; window_bits <= 13; window_bits += 2) {
+        size_t len = compress_payload(&payload, window_bits, &output);
+        check_inflate(&payload, &output);
+
+        int rounds = 0;
+        int64_t start = now_ns();
+        for (; rounds < TEST_MIN_ROUNDS || now_ns() - start < TEST_MIN_TIME_NS; rounds++) {
+            compress_payload(&payload, window_bits, &output);
+        }
+        double ns = (double)(now_ns() - start) / rounds;
+        double saved_bits = 8.0 * ((double)payload.len - (double)len);
+        printf("  window 2^%u: %6u bytes (%4.1f%%), %8.1f us, %5.1f ns per byte, break-even %6.0f Mbit/s, "
+               "%u bytes of RAM\n",
+               window_bits, (unsigned)len, 100.0 * len / payload.len, ns / 1000, ns / payload.len,
+               saved_bits / ns * 1000, (unsigned)((4u << window_bits) + 2048 + TEST_OUTPUT_SIZE));
+        /* The keys repeat in each node, a window which holds a whole node finds them in the previous one. */
+        TEST_ASSERT(len < payload.len);
+        TEST_ASSERT(len <= previous_len);
+        previous_len = len;
+    }
+    free(output.data);
+    free(payload.text);
+}
+
+static void test_small_network(void)
+{
+    run_payload(4);
+}
+
+static void test_medium_network(void)
+{
+    run_payload(16);
+}
+
+static void test_large_network(void)
+{
+    run_payload(64);
+}
+
+int main(void)
+{
+    RUN_TEST(test_small_network);
+    RUN_TEST(test_medium_network);
+    RUN_TEST(test_large_network);
+    return 0;
+}
@@ -0,0 +1,318 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <arpa/inet.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "esp_br_web_ipaddr.h"
+#include "esp_openthread.h"
+#include "esp_openthread_lock.h"
+#include "esp_random.h"
+#include "esp_timer.h"
+#include "host_test.h"
+#include "openthread/ip6.h"
+
+/*
+ * Runs the ipaddr benchmark against a model of the unicast addresses of the Thread interface: the addresses of the
+ * stack, which are not removable, and OpenThread's pool of 4 external addresses, one of them added by the user. The
+ * benchmark must leave the interface as it found it, whatever fails, and is then run many times for the ops/s of the
+ * per-request path and of the batch path. The REST handler of the batch must not run it. The lock is a mutex, as on
+ * the target, but taken without contention.
+ */
+#define TEST_INTERNAL_ADDRS 3
+#define TEST_EXTERNAL_ADDRS 4 /* OPENTHREAD_CONFIG_IP6_MAX_EXT_UCAST_ADDRS */
+#define TEST_ADDRS (TEST_INTERNAL_ADDRS + TEST_EXTERNAL_ADDRS)
+#define TEST_BENCH_COUNT 32
+#define TEST_BENCH_ROUNDS 2000
+
+static const char *const s_internal_addrs[TEST_INTERNAL_ADDRS] = {"fd11:22::ff:fe00:fc00", "fd11:22::1234:5678",
+                                                                  "fe80::1"};
+static const char *const s_user_addr = "fd00:db8::1";
+
+static otNetifAddress s_addrs[TEST_ADDRS];
+static bool s_used[TEST_ADDRS];
+static int s_max_scratch;
+static pthread_mutex_t s_ot_lock = PTHREAD_MUTEX_INITIALIZER;
+static bool s_fixed_random;
+
+otInstance *esp_openthread_get_instance(void)
+{
+    return NULL;
+}
+
+bool esp_openthread_lock_acquire(TickType_t block_ticks)
+{
+    return pthread_mutex_lock(&s_ot_lock) == 0;
+}
+
+void esp_openthread_lock_release(void)
+{
+    pthread_mutex_unlock(&s_ot_lock);
+}
+
+int64_t esp_timer_get_time(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+uint32_t esp_random(void)
+{
+    static uint32_t s_state = 0x12345678;
+
+    s_state = s_fixed_random ? s_state : s_state * 1664525 + 1013904223;
+    return s_state;
+}
+
+const char *otThreadErrorToString(otError error)
+{
+    return error == OT_ERROR_NONE ? "OK" : "Error";
+}
+
+otError otIp6AddressFromString(const char *string, otIp6Address *address)
+{
+    return inet_pton(AF_INET6, string, address->m8) == 1 ? OT_ERROR_NONE : OT_ERROR_INVALID_ARGS;
+}
+
+void otIp6AddressToString(const otIp6Address *address, char *buffer, uint16_t size)
+{
+    inet_ntop(AF_INET6, address->m8, buffer, size);
+}
+
+static int find_address(const otIp6Address *address)
+{
+    for (int i = 0; i < TEST_ADDRS; i++) {
+        if (s_used[i] && memcmp(&s_addrs[i].mAddress, address, sizeof(*address)) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static int scratch_count(void)
+{
+    int count = 0;
+
+    for (int i = TEST_INTERNAL_ADDRS; i < TEST_ADDRS; i++) {
+        count += s_used[i] && s_addrs[i].mAddress.m8[6] == 0xff && s_addrs[i].mAddress.m8[7] == 0xff;
+    }
+    return count;
+}
+
+const otNetifAddress *otIp6GetUnicastAddresses(otInstance *instance)
+{
+    const otNetifAddress *head = NULL;
+
+    for (int i = TEST_ADDRS - 1; i >= 0; i--) {
+        if (s_used[i]) {
+            s_addrs[i].mNext = head;
+            head = &s_addrs[i];
+        }
+    }
+    return head;
+}
+
+bool otIp6HasUnicastAddress(otInstance *instance, const otIp6Address *address)
+{
+    return find_address(address) >= 0;
+}
+
+otError otIp6AddUnicastAddress(otInstance *instance, const otNetifAddress *address)
+{
+    int index = find_address(&address->mAddress);
+
+    if (index >= 0) {
+        return index < TEST_INTERNAL_ADDRS ? OT_ERROR_INVALID_ARGS : OT_ERROR_NONE;
+    }
+    for (index = TEST_INTERNAL_ADDRS; index < TEST_ADDRS && s_used[index]; index++) {
+    }
+    if (index == TEST_ADDRS) {
+        return OT_ERROR_NO_BUFS;
+    }
+    s_addrs[index] = *address;
+    s_used[index] = true;
+    s_max_scratch = scratch_count() > s_max_scratch ? scratch_count() : s_max_scratch;
+    return OT_ERROR_NONE;
+}
+
+otError otIp6RemoveUnicastAddress(otInstance *instance, const otIp6Address *address)
+{
+    int index = find_address(address);
+
+    if (index < TEST_INTERNAL_ADDRS) {
+        return index < 0 ? OT_ERROR_NOT_FOUND : OT_ERROR_INVALID_ARGS;
+    }
+    s_used[index] = false;
+    return OT_ERROR_NONE;
+}
+
+static void add_address(int index, const char *string, uint8_t origin)
+{
+    memset(&s_addrs[index], 0, sizeof(s_addrs[index]));
+    TEST_ASSERT_EQUAL(OT_ERROR_NONE, otIp6AddressFromString(string, &s_addrs[index].mAddress));
+    s_addrs[index].mPrefixLength = 64;
+    s_addrs[index].mAddressOrigin = origin;
+    s_used[index] = true;
+}
+
+static void reset_interface(void)
+{
+    memset(s_used, 0, sizeof(s_used));
+    for (int i = 0; i < TEST_INTERNAL_ADDRS; i++) {
+        add_address(i, s_internal_addrs[i], OT_ADDRESS_ORIGIN_THREAD);
+    }
+    add_address(TEST_INTERNAL_ADDRS, s_user_addr, OT_ADDRESS_ORIGIN_MANUAL);
+    s_max_scratch = 0;
+}
+
+static void assert_interface_unchanged(void)
+{
+    otIp6Address address;
+    int count = 0;
+
+    for (const otNetifAddress *addr = otIp6GetUnicastAddresses(NULL); addr; addr = addr->mNext) {
+        count++;
+    }
+    TEST_ASSERT_EQUAL(TEST_INTERNAL_ADDRS + 1, count);
+    TEST_ASSERT_EQUAL(OT_ERROR_NONE, otIp6AddressFromString(s_user_addr, &address));
+    TEST_ASSERT_EQUAL(TEST_INTERNAL_ADDRS, find_address(&address));
+    TEST_ASSERT_EQUAL(0, scratch_count());
+}
+
+static double bench_number(const cJSON *result, const char *name)
+{
+    const cJSON *item = cJSON_GetObjectItemCaseSensitive(result, name);
+
+    TEST_ASSERT_TRUE(cJSON_IsNumber(item));
+    return item->valuedouble;
+}
+
+static void test_scratch_addresses_removed(void)
+{
+    otError error = OT_ERROR_FAILED;
+
+    reset_interface();
+    cJSON *result = openthread_ipaddr_batch_benchmark(16, &error);
+    TEST_ASSERT_NOT_NULL(result);
+    TEST_ASSERT_EQUAL(OT_ERROR_NONE, error);
+    TEST_ASSERT_EQUAL(32, (int)bench_number(result, "operations"));
+    TEST_ASSERT_EQUAL(0, (int)bench_number(result, "failed"));
+    const char *prefix = cJSON_GetStringValue(cJSON_GetObjectItemCaseSensitive(result, "prefix"));
+    TEST_ASSERT(prefix && strncmp(prefix, "fd", 2) == 0 && strstr(prefix, ":ffff::"));
+    cJSON_Delete(result);
+    /* One scratch address at a time, so the pool of the external addresses is never exhausted by the benchmark. */
+    TEST_ASSERT_EQUAL(1, s_max_scratch);
+    assert_interface_unchanged();
+}
+
+static void test_full_pool_cleaned_up(void)
+{
+    otError error = OT_ERROR_NONE;
+
+    reset_interface();
+    add_address(TEST_INTERNAL_ADDRS + 1, "fd00:db8::2", OT_ADDRESS_ORIGIN_MANUAL);
+    add_address(TEST_INTERNAL_ADDRS + 2, "fd00:db8::3", OT_ADDRESS_ORIGIN_MANUAL);
+    add_address(TEST_INTERNAL_ADDRS + 3, "fd00:db8::4", OT_ADDRESS_ORIGIN_MANUAL);
+    cJSON *result = openthread_ipaddr_batch_benchmark(4, &error);
+    TEST_ASSERT_NOT_NULL(result);
+    TEST_ASSERT_EQUAL(OT_ERROR_FAILED, error);
+    /* Each add fails and so does the remove which follows it. */
+    TEST_ASSERT_EQUAL(16, (int)bench_number(result, "failed"));
+    cJSON_Delete(result);
+    for (int i = TEST_INTERNAL_ADDRS + 1; i < TEST_ADDRS; i++) {
+        TEST_ASSERT_TRUE(s_used[i]);
+        s_used[i] = false;
+    }
+    assert_interface_unchanged();
+}
+
+static void test_prefix_in_use(void)
+{
+    otError error = OT_ERROR_NONE;
+    char address[OT_IP6_ADDRESS_STRING_SIZE];
+    uint32_t random = esp_random();
+
+    reset_interface();
+    /* The random source is stuck and the address 1 of the only prefix it gives is already on the interface. */
+    s_fixed_random = true;
+    snprintf(address, sizeof(address), "fd%02x:%04x:%04x:ffff::1", (unsigned)(random & 0xff), (unsigned)(random >> 16),
+             (unsigned)(random & 0xffff));
+    add_address(TEST_INTERNAL_ADDRS + 1, address, OT_ADDRESS_ORIGIN_MANUAL);
+    TEST_ASSERT_NULL(openthread_ipaddr_batch_benchmark(2, &error));
+    TEST_ASSERT_EQUAL(OT_ERROR_ALREADY, error);
+    TEST_ASSERT_TRUE(s_used[TEST_INTERNAL_ADDRS + 1]);
+    s_fixed_random = false;
+    s_used[TEST_INTERNAL_ADDRS + 1] = false;
+    assert_interface_unchanged();
+}
+
+static void test_invalid_count(void)
+{
+    otError error = OT_ERROR_NONE;
+
+    reset_interface();
+    TEST_ASSERT_NULL(openthread_ipaddr_batch_benchmark(0, &error));
+    TEST_ASSERT_EQUAL(OT_ERROR_INVALID_ARGS, error);
+    TEST_ASSERT_NULL(openthread_ipaddr_batch_benchmark(-1, &error));
+    TEST_ASSERT_EQUAL(OT_ERROR_INVALID_ARGS, error);
+    TEST_ASSERT_NULL(openthread_ipaddr_batch_benchmark(33, &error));
+    TEST_ASSERT_EQUAL(OT_ERROR_INVALID_ARGS, error);
+    assert_interface_unchanged();
+}
+
+static void test_not_served_by_rest(void)
+{
+    otError error = OT_ERROR_NONE;
+    cJSON *request = cJSON_CreateObject();
+
+    reset_interface();
+    /* The REST handler does not run the benchmark, a request without "operations" is invalid. */
+    cJSON_AddBoolToObject(request, "benchmark", true);
+    cJSON_AddNumberToObject(request, "count", 4);
+    TEST_ASSERT_NULL(handle_openthread_batch_ipaddr_request(request, &error));
+    TEST_ASSERT_EQUAL(OT_ERROR_INVALID_ARGS, error);
+    cJSON_Delete(request);
+    TEST_ASSERT_EQUAL(0, s_max_scratch);
+    assert_interface_unchanged();
+}
+
+static void test_ops_per_second(void)
+{
+    double single_us = 0;
+    double batch_us = 0;
+    double operations = 0;
+    otError error = OT_ERROR_FAILED;
+
+    reset_interface();
+    for (int round = 0; round < TEST_BENCH_ROUNDS; round++) {
+        cJSON *result = openthread_ipaddr_batch_benchmark(TEST_BENCH_COUNT, &error);
+        TEST_ASSERT_EQUAL(OT_ERROR_NONE, error);
+        single_us += bench_number(result, "singleUs");
+        batch_us += bench_number(result, "batchUs");
+        operations += bench_number(result, "operations");
+        cJSON_Delete(result);
+    }
+    printf("per-request: %.0f ops/s, batch: %.0f ops/s, %.1fx\n", operations * 1e6 / single_us,
+           operations * 1e6 / batch_us, single_us / batch_us);
+    TEST_ASSERT(batch_us < single_us);
+    assert_interface_unchanged();
+}
+
+int main(void)
+{
+    RUN_TEST(test_scratch_addresses_removed);
+    RUN_TEST(test_full_pool_cleaned_up);
+    RUN_TEST(test_prefix_in_use);
+    RUN_TEST(test_invalid_count);
+    RUN_TEST(test_not_served_by_rest);
+    RUN_TEST(test_ops_per_second);
+    return 0;
+}
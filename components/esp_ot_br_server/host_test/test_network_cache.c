@@ -0,0 +1,233 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "esp_br_web_network_cache.h"
+#include "esp_timer.h"
+#include "host_test.h"
+
+/*
+ * Feeds discover results to the available network cache on a simulated clock in seconds. The tests share the cache
+ * and run in order, each one starts from the networks the previous ones left.
+ */
+static int64_t s_now_s = 1000;
+
+int64_t esp_timer_get_time(void)
+{
+    return s_now_s * 1000000;
+}
+
+static otActiveScanResult scan_result(uint8_t xpan, uint8_t channel, int8_t rssi, uint8_t lqi, uint8_t router)
+{
+    otActiveScanResult result;
+
+    memset(&result, 0, sizeof(result));
+    result.mExtendedPanId.m8[0] = 0xde;
+    result.mExtendedPanId.m8[7] = xpan;
+    result.mExtAddress.m8[7] = router;
+    result.mChannel = channel;
+    result.mRssi = rssi;
+    result.mLqi = lqi;
+    result.mPanId = 0x1000 + xpan;
+    snprintf(result.mNetworkName.m8, sizeof(result.mNetworkName.m8), "net-%u", xpan);
+    return result;
+}
+
+static void update(uint8_t xpan, uint8_t channel, int8_t rssi, uint8_t lqi, uint8_t router)
+{
+    otActiveScanResult result = scan_result(xpan, channel, rssi, lqi, router);
+
+    available_network_cache_update(&result);
+}
+
+static int count_after(uint32_t seq)
+{
+    thread_network_information_t network;
+    int count = 0;
+
+    while (available_network_cache_next(seq, &network, &seq)) {
+        count++;
+    }
+    return count;
+}
+
+static bool find(uint8_t xpan, uint8_t channel, thread_network_information_t *network)
+{
+    thread_network_join_param_t param;
+
+    memset(&param, 0, sizeof(param));
+    param.has_extended_panid = true;
+    param.extended_panid.m8[0] = 0xde;
+    param.extended_panid.m8[7] = xpan;
+    param.channel = channel;
+    return available_network_cache_find(&param, network);
+}
+
+static bool find_id(uint16_t id, thread_network_information_t *network)
+{
+    thread_network_join_param_t param;
+
+    memset(&param, 0, sizeof(param));
+    param.index = id;
+    return available_network_cache_find(&param, network);
+}
+
+static void test_empty(void)
+{
+    thread_network_information_t network;
+    uint32_t seq = 0;
+
+    TEST_ASSERT_EQUAL(0, available_network_cache_seq());
+    TEST_ASSERT_FALSE(available_network_cache_next(0, &network, &seq));
+    TEST_ASSERT_FALSE(find(1, 0, &network));
+    TEST_ASSERT_FALSE(find_id(1, &network));
+}
+
+/* The responses of the routers of one network are merged, the entry keeps the best RSSI and LQI and its id. */
+static void test_merge_best_signal(void)
+{
+    thread_network_information_t network;
+    uint32_t seq = 0;
+
+    update(1, 15, -70, 100, 1);
+    update(1, 15, -60, 80, 2);
+    s_now_s += 5;
+    update(1, 15, -80, 200, 3);
+    TEST_ASSERT_EQUAL(3, available_network_cache_seq());
+    TEST_ASSERT_EQUAL(1, count_after(0));
+
+    TEST_ASSERT(available_network_cache_next(0, &network, &seq));
+    TEST_ASSERT_EQUAL(3, seq);
+    TEST_ASSERT_EQUAL(1, network.id);
+    TEST_ASSERT_EQUAL(15, network.channel);
+    TEST_ASSERT_EQUAL(-60, network.rssi);
+    TEST_ASSERT_EQUAL(2, network.extended_address.m8[7]); /* the router heard best */
+    TEST_ASSERT_EQUAL(200, network.lqi);
+    TEST_ASSERT_EQUAL(0x1001, network.panid);
+    TEST_ASSERT_EQUAL(0, strcmp(network.network_name.m8, "net-1"));
+    TEST_ASSERT_EQUAL(s_now_s, network.last_seen);
+}
+
+/* The same extended PAN ID on another channel is another network. */
+static void test_channels(void)
+{
+    thread_network_information_t network;
+
+    s_now_s += 5;
+    update(2, 20, -50, 150, 1);
+    s_now_s += 5;
+    update(2, 25, -90, 30, 2);
+    TEST_ASSERT_EQUAL(3, count_after(0));
+
+    /* Without a channel, the join takes the network last seen. */
+    TEST_ASSERT(find(2, 0, &network));
+    TEST_ASSERT_EQUAL(25, network.channel);
+    TEST_ASSERT_EQUAL(3, network.id);
+    TEST_ASSERT(find(2, 20, &network));
+    TEST_ASSERT_EQUAL(2, network.id);
+    TEST_ASSERT_FALSE(find(2, 15, &network));
+    TEST_ASSERT(find_id(2, &network));
+    TEST_ASSERT_EQUAL(20, network.channel);
+    TEST_ASSERT_FALSE(find_id(4, &network));
+}
+
+/* The readers follow the updates: an updated network comes again after the ones updated before it. */
+static void test_update_order(void)
+{
+    thread_network_information_t network;
+    uint32_t seq = available_network_cache_seq();
+    uint32_t start = seq;
+
+    TEST_ASSERT_EQUAL(0, count_after(seq));
+    s_now_s += 5;
+    update(1, 15, -75, 90, 4);
+    update(3, 11, -65, 120, 1);
+
+    TEST_ASSERT_EQUAL(2, count_after(start));
+    TEST_ASSERT(available_network_cache_next(start, &network, &seq));
+    TEST_ASSERT_EQUAL(1, network.id);
+    TEST_ASSERT_EQUAL(-60, network.rssi); /* the best RSSI is kept */
+    TEST_ASSERT(available_network_cache_next(seq, &network, &seq));
+    TEST_ASSERT_EQUAL(4, network.id);
+    TEST_ASSERT_FALSE(available_network_cache_next(seq, &network, &seq));
+
+    /* From the start, the order is the one of the last updates. */
+    uint16_t expected[] = {2, 3, 1, 4};
+    seq = 0;
+    for (size_t i = 0; i < sizeof(expected) / sizeof(expected[0]); i++) {
+        TEST_ASSERT(available_network_cache_next(seq, &network, &seq));
+        TEST_ASSERT_EQUAL(expected[i], network.id);
+    }
+}
+
+/* A network not seen for AVAILABLE_NETWORK_MAX_AGE_S is neither listed nor joined. */
+static void test_expiry(void)
+{
+    thread_network_information_t network;
+
+    TEST_ASSERT(find(2, 20, &network));
+    int64_t last_seen = network.last_seen; /* the network seen first */
+
+    s_now_s = last_seen + AVAILABLE_NETWORK_MAX_AGE_S;
+    TEST_ASSERT_EQUAL(4, count_after(0));
+    s_now_s++;
+    TEST_ASSERT_EQUAL(3, count_after(0));
+    TEST_ASSERT_FALSE(find(2, 20, &network));
+    TEST_ASSERT_FALSE(find_id(2, &network));
+    TEST_ASSERT(find(2, 0, &network)); /* the other channel of the network is still fresh */
+    TEST_ASSERT_EQUAL(25, network.channel);
+    s_now_s += AVAILABLE_NETWORK_MAX_AGE_S;
+    TEST_ASSERT_EQUAL(0, count_after(0));
+    TEST_ASSERT_FALSE(find(1, 0, &network));
+}
+
+/* A full cache replaces its least recently seen entry, the expired ones first. */
+static void test_eviction(void)
+{
+    thread_network_information_t network;
+    uint32_t seq = 0;
+
+    for (int i = 0; i < AVAILABLE_NETWORK_CACHE_SIZE; i++) {
+        s_now_s++;
+        update(100 + i, 11 + i % 16, -50, 100, 1);
+    }
+    TEST_ASSERT_EQUAL(AVAILABLE_NETWORK_CACHE_SIZE, count_after(0));
+    TEST_ASSERT(find(100, 0, &network));
+    TEST_ASSERT_EQUAL(5, network.id);
+
+    s_now_s++;
+    update(100, 11, -40, 100, 2); /* refreshed, the oldest is now the second one */
+    s_now_s++;
+    update(200, 26, -70, 50, 1);
+    TEST_ASSERT_EQUAL(AVAILABLE_NETWORK_CACHE_SIZE, count_after(0));
+    TEST_ASSERT(find(100, 0, &network));
+    TEST_ASSERT_EQUAL(5, network.id);
+    TEST_ASSERT_FALSE(find(101, 0, &network));
+    TEST_ASSERT(find(200, 26, &network));
+    TEST_ASSERT_EQUAL(5 + AVAILABLE_NETWORK_CACHE_SIZE, network.id);
+    TEST_ASSERT_EQUAL(-70, network.rssi);
+
+    /* The new network is the last update. */
+    seq = available_network_cache_seq() - 1;
+    TEST_ASSERT(available_network_cache_next(seq, &network, &seq));
+    TEST_ASSERT_EQUAL(5 + AVAILABLE_NETWORK_CACHE_SIZE, network.id);
+}
+
+int main(void)
+{
+    available_network_cache_init();
+    RUN_TEST(test_empty);
+    RUN_TEST(test_merge_best_signal);
+    RUN_TEST(test_channels);
+    RUN_TEST(test_update_order);
+    RUN_TEST(test_expiry);
+    RUN_TEST(test_eviction);
+    return 0;
+}
@@ -0,0 +1,228 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "esp_br_web_topology.h"
+#include "host_test.h"
+
+#define TEST_ROUTER_TLV_NUM 6
+#define TEST_ROUTER_NUM 3
+#define TEST_EPOCH 0x5a5a0000
+
+/* The diagnostic response of a router, as the collection keeps it. */
+typedef struct test_router {
+    otNetworkDiagTlv tlvs[TEST_ROUTER_TLV_NUM];
+    thread_diagnosticTlv_list_t list[TEST_ROUTER_TLV_NUM];
+    thread_diagnosticTlv_set_t set;
+} test_router_t;
+
+/* The responses of a collection, the first set is the head of the collection. */
+typedef struct test_responses {
+    thread_diagnosticTlv_set_t head;
+    test_router_t routers[TEST_ROUTER_NUM];
+} test_responses_t;
+
+static thread_topology_history_t s_history;
+
+static otNetworkDiagTlv *router_tlv(test_router_t *router, uint8_t type)
+{
+    for (int i = 0; i < TEST_ROUTER_TLV_NUM; i++) {
+        if (router->tlvs[i].mType == type) {
+            return &router->tlvs[i];
+        }
+    }
+    TEST_ASSERT_MESSAGE(false, "no such TLV");
+    return NULL;
+}
+
+/* A 3 routers network, the leader 0x0000 and 0x0400 have a sleepy child, all the links are good. */
+static void responses_init(test_responses_t *responses)
+{
+    static const uint8_t s_types[TEST_ROUTER_TLV_NUM] = {
+        OT_NETWORK_DIAGNOSTIC_TLV_EXT_ADDRESS, OT_NETWORK_DIAGNOSTIC_TLV_SHORT_ADDRESS,
+        OT_NETWORK_DIAGNOSTIC_TLV_MODE,        OT_NETWORK_DIAGNOSTIC_TLV_LEADER_DATA,
+        OT_NETWORK_DIAGNOSTIC_TLV_ROUTE,       OT_NETWORK_DIAGNOSTIC_TLV_CHILD_TABLE,
+    };
+
+    memset(responses, 0, sizeof(test_responses_t));
+    for (uint8_t id = 0; id < TEST_ROUTER_NUM; id++) {
+        test_router_t *router = &responses->routers[id];
+        for (int i = 0; i < TEST_ROUTER_TLV_NUM; i++) {
+            router->tlvs[i].mType = s_types[i];
+            router->list[i].diagTlv = &router->tlvs[i];
+            router->list[i].next = i + 1 < TEST_ROUTER_TLV_NUM ? &router->list[i + 1] : NULL;
+        }
+        router->set.diagTlv_next = &router->list[0];
+        snprintf(router->set.rloc16, sizeof(router->set.rloc16), "0x%04x", id << 10);
+        router_tlv(router, OT_NETWORK_DIAGNOSTIC_TLV_EXT_ADDRESS)->mData.mExtAddress.m8[7] = id + 1;
+        router_tlv(router, OT_NETWORK_DIAGNOSTIC_TLV_SHORT_ADDRESS)->mData.mAddr16 = id << 10;
+        otLinkModeConfig *mode = &router_tlv(router, OT_NETWORK_DIAGNOSTIC_TLV_MODE)->mData.mMode;
+        mode->mRxOnWhenIdle = true;
+        mode->mDeviceType = true;
+        mode->mNetworkData = true;
+        router_tlv(router, OT_NETWORK_DIAGNOSTIC_TLV_LEADER_DATA)->mData.mLeaderData.mLeaderRouterId = 0;
+
+        otNetworkDiagRoute *route = &router_tlv(router, OT_NETWORK_DIAGNOSTIC_TLV_ROUTE)->mData.mRoute;
+        for (uint8_t to = 0; to < TEST_ROUTER_NUM; to++) {
+            otNetworkDiagRouteData *data = &route->mRouteData[route->mRouteCount++];
+            data->mRouterId = to;
+            data->mLinkQualityIn = to == id ? 0 : 3;
+            data->mLinkQualityOut = to == id ? 0 : 3;
+        }
+        if (id < 2) {
+            otNetworkDiagChildTable *table =
+                &router_tlv(router, OT_NETWORK_DIAGNOSTIC_TLV_CHILD_TABLE)->mData.mChildTable;
+            table->mTable[0].mChildId = 1;
+            table->mTable[0].mLinkQuality = 3;
+            table->mCount = 1;
+        }
+        router->set.next = id + 1 < TEST_ROUTER_NUM ? &responses->routers[id + 1].set : NULL;
+    }
+    responses->head.next = &responses->routers[0].set;
+}
+
+static bool record(const test_responses_t *responses)
+{
+    thread_topology_snapshot_t snapshot;
+    TEST_ASSERT_EQUAL(ESP_OK, thread_topology_snapshot_build(&responses->head, &snapshot));
+    return thread_topology_history_record(&s_history, &snapshot);
+}
+
+static uint32_t latest_version(void)
+{
+    return thread_topology_history_latest(&s_history)->version;
+}
+
+static cJSON *delta_since(uint32_t version)
+{
+    const thread_topology_snapshot_t *base = thread_topology_history_find(&s_history, version);
+    TEST_ASSERT_NOT_NULL(base);
+    return thread_topology_delta_convert2_json(base, thread_topology_history_latest(&s_history));
+}
+
+static const cJSON *delta_list(const cJSON *delta, const char *kind, const char *change)
+{
+    const cJSON *list = cJSON_GetObjectItemCaseSensitive(cJSON_GetObjectItemCaseSensitive(delta, kind), change);
+    TEST_ASSERT_NOT_NULL(list);
+    return list;
+}
+
+static const cJSON *delta_first(const cJSON *delta, const char *kind, const char *change, const char *field)
+{
+    return cJSON_GetObjectItemCaseSensitive(cJSON_GetArrayItem(delta_list(delta, kind, change), 0), field);
+}
+
+static void assert_string(const char *expected, const cJSON *item)
+{
+    TEST_ASSERT_NOT_NULL(item);
+    TEST_ASSERT_MESSAGE(strcmp(expected, cJSON_GetStringValue(item)) == 0, expected);
+}
+
+static void test_replay(void)
+{
+    test_responses_t responses;
+    cJSON *json = NULL;
+
+    thread_topology_history_init(&s_history, TEST_EPOCH);
+    responses_init(&responses);
+
+    /* The first collection: 3 routers and 2 children, 6 router links and 2 child links. */
+    TEST_ASSERT_TRUE(record(&responses));
+    uint32_t first = latest_version();
+    TEST_ASSERT_EQUAL(TEST_EPOCH + 1, first);
+    json = thread_topology_snapshot_convert2_json(thread_topology_history_latest(&s_history));
+    TEST_ASSERT_EQUAL(5, cJSON_GetArraySize(cJSON_GetObjectItemCaseSensitive(json, "Nodes")));
+    TEST_ASSERT_EQUAL(8, cJSON_GetArraySize(cJSON_GetObjectItemCaseSensitive(json, "Links")));
+    cJSON_Delete(json);
+
+    /* The same responses again keep the version. */
+    TEST_ASSERT_FALSE(record(&responses));
+    TEST_ASSERT_EQUAL(first, latest_version());
+
+    /* The child of 0x0400 moves to 0x0800 as 0x0802. */
+    otNetworkDiagChildTable *table =
+        &router_tlv(&responses.routers[1], OT_NETWORK_DIAGNOSTIC_TLV_CHILD_TABLE)->mData.mChildTable;
+    table->mCount = 0;
+    table = &router_tlv(&responses.routers[2], OT_NETWORK_DIAGNOSTIC_TLV_CHILD_TABLE)->mData.mChildTable;
+    table->mTable[0].mChildId = 2;
+    table->mTable[0].mLinkQuality = 2;
+    table->mCount = 1;
+    TEST_ASSERT_TRUE(record(&responses));
+    uint32_t moved = latest_version();
+    TEST_ASSERT_EQUAL(first + 1, moved);
+    json = delta_since(first);
+    TEST_ASSERT_EQUAL(first, cJSON_GetObjectItemCaseSensitive(json, "Since")->valuedouble);
+    TEST_ASSERT_EQUAL(1, cJSON_GetArraySize(delta_list(json, "Nodes", "Added")));
+    assert_string("0x0802", delta_first(json, "Nodes", "Added", "Rloc16"));
+    assert_string("0x0401", cJSON_GetArrayItem(delta_list(json, "Nodes", "Removed"), 0));
+    TEST_ASSERT_EQUAL(1, cJSON_GetArraySize(delta_list(json, "Nodes", "Removed")));
+    TEST_ASSERT_EQUAL(0, cJSON_GetArraySize(delta_list(json, "Nodes", "Changed")));
+    assert_string("0x0401", delta_first(json, "Links", "Removed", "To"));
+    assert_string("0x0802", delta_first(json, "Links", "Added", "To"));
+    TEST_ASSERT_EQUAL(0, cJSON_GetArraySize(delta_list(json, "Links", "Changed")));
+    cJSON_Delete(json);
+
+    /* The link from 0x0400 to 0x0800 degrades. */
+    router_tlv(&responses.routers[1], OT_NETWORK_DIAGNOSTIC_TLV_ROUTE)->mData.mRoute.mRouteData[2].mLinkQualityIn = 1;
+    TEST_ASSERT_TRUE(record(&responses));
+    json = delta_since(moved);
+    TEST_ASSERT_EQUAL(0, cJSON_GetArraySize(delta_list(json, "Nodes", "Added")));
+    TEST_ASSERT_EQUAL(0, cJSON_GetArraySize(delta_list(json, "Links", "Added")));
+    TEST_ASSERT_EQUAL(1, cJSON_GetArraySize(delta_list(json, "Links", "Changed")));
+    const cJSON *link = cJSON_GetArrayItem(delta_list(json, "Links", "Changed"), 0);
+    assert_string("0x0400", cJSON_GetObjectItemCaseSensitive(link, "From"));
+    assert_string("0x0800", cJSON_GetObjectItemCaseSensitive(link, "To"));
+    TEST_ASSERT_EQUAL(1, cJSON_GetObjectItemCaseSensitive(link, "LinkQualityIn")->valuedouble);
+    cJSON_Delete(json);
+
+    /* The delta from the first version has both changes. */
+    json = delta_since(first);
+    TEST_ASSERT_EQUAL(1, cJSON_GetArraySize(delta_list(json, "Nodes", "Added")));
+    TEST_ASSERT_EQUAL(1, cJSON_GetArraySize(delta_list(json, "Links", "Changed")));
+    cJSON_Delete(json);
+
+    /* The first version ages out after THREAD_TOPOLOGY_HISTORY_SIZE newer ones. */
+    otNetworkDiagRoute *route = &router_tlv(&responses.routers[2], OT_NETWORK_DIAGNOSTIC_TLV_ROUTE)->mData.mRoute;
+    for (uint8_t lq = 1; lq <= 2; lq++) {
+        route->mRouteData[0].mLinkQualityOut = lq;
+        TEST_ASSERT_TRUE(record(&responses));
+    }
+    TEST_ASSERT_EQUAL(first + 4, latest_version());
+    TEST_ASSERT_NULL(thread_topology_history_find(&s_history, first));
+    TEST_ASSERT_NOT_NULL(thread_topology_history_find(&s_history, moved));
+    thread_topology_history_init(&s_history, 0);
+}
+
+static void test_versions_follow_the_boot_epoch(void)
+{
+    test_responses_t responses;
+
+    responses_init(&responses);
+    thread_topology_history_init(&s_history, TEST_EPOCH);
+    TEST_ASSERT_TRUE(record(&responses));
+    uint32_t before_reboot = latest_version();
+
+    /* After a reboot the same network gets a version of the new epoch, the old version is unknown. */
+    thread_topology_history_init(&s_history, TEST_EPOCH + 0x10000);
+    TEST_ASSERT_EQUAL(0, latest_version());
+    TEST_ASSERT_TRUE(record(&responses));
+    TEST_ASSERT_TRUE(latest_version() != before_reboot);
+    TEST_ASSERT_NULL(thread_topology_history_find(&s_history, before_reboot));
+
+    /* 0 marks an empty slot, the version skips it when it wraps. */
+    thread_topology_history_init(&s_history, UINT32_MAX);
+    TEST_ASSERT_TRUE(record(&responses));
+    TEST_ASSERT_EQUAL(1, latest_version());
+    TEST_ASSERT_NULL(thread_topology_history_find(&s_history, 0));
+    thread_topology_history_init(&s_history, 0);
+}
+
+int main(void)
+{
+    RUN_TEST(test_replay);
+    RUN_TEST(test_versions_follow_the_boot_epoch);
+    return 0;
+}
@@ -12,6 +12,7 @@ extern "C" {
 
 #include "cJSON.h"
 #include "esp_br_web_base.h"
+#include "esp_br_web_cbor.h"
 #include "esp_http_server.h"
 #include "openthread/error.h"
 
@@ -25,6 +26,18 @@ void esp_br_web_api_init(void);
 ----------------------------------------------------------------------*/
 /* HTTP GET */
 #define ESP_OT_REST_API_DIAGNOSTICS_PATH "/diagnostics"
+#define ESP_OT_REST_API_DIAGNOSTICS_DELTA_PATH "/diagnostics/delta"
+#define ESP_OT_REST_API_DIAGNOSTICS_SCHEDULER_PATH "/diagnostics/scheduler"
+#define ESP_OT_REST_API_DIAGNOSTICS_MAC_COUNTERS_PATH "/diagnostics/maccounters"
+#define ESP_OT_REST_API_DIAGNOSTICS_BOOT_PATH "/diagnostics/boot"
+#define ESP_OT_REST_API_LINK_QUALITY_PATH "/linkquality"
+#define ESP_OT_REST_API_DNS_UPSTREAMS_PATH "/dns/upstreams"
+#define ESP_OT_REST_API_IP_STATS_PATH "/ip/stats"
+#define ESP_OT_REST_API_CAPTURE_PATH "/capture"
+#define ESP_OT_REST_API_COEX_PATH "/coex"
+#define ESP_OT_REST_API_COEX_MEASURE_PATH "/coex/measure"
+#define ESP_OT_REST_API_CHANNEL_SURVEY_PATH "/channelsurvey"
+#define ESP_OT_REST_API_CHANNEL_SURVEY_CHANNEL_PATH "/channelsurvey/channel"
 #define ESP_OT_REST_API_NODE_PATH "/node"
 #define ESP_OT_REST_API_NODE_RLOC_PATH "/node/rloc"
 #define ESP_OT_REST_API_NODE_RLOC16_PATH "/node/rloc16"
@@ -39,6 +52,9 @@ void esp_br_web_api_init(void);
 #define ESP_OT_REST_API_NODE_DATASET_PENDING_PATH "/node/dataset/pending"
 #define ESP_OT_REST_API_NODE_EPSKC_STATE_PATH "/node/ba-epskc/state"
 #define ESP_OT_REST_API_NODE_EPSKC_KEY_PATH "/node/ba-epskc/key"
+#define ESP_OT_REST_API_NODE_COMMISSIONER_JOB_PATH "/node/commissioner/job"
+#define ESP_OT_REST_API_NODE_NETDATA_PATH "/node/netdata"
+#define ESP_OT_REST_API_BATCH_PATH "/batch"
 #define ESP_OT_REST_API_PROPERTIES_PATH "/get_properties"
 #define ESP_OT_REST_API_AVAILABLE_NETWORK_PATH "/available_network"
 #define ESP_OT_REST_API_NODE_INFORMATION_PATH "/node_information"
@@ -52,6 +68,7 @@ void esp_br_web_api_init(void);
 #define ESP_OT_REST_API_IPADDR_PATH "/ipaddr"
 #define ESP_OT_REST_API_ADD_IPADDR_PATH "/add_ipaddr"
 #define ESP_OT_REST_API_DELETE_IPADDR_PATH "/delete_ipaddr"
+#define ESP_OT_REST_API_BATCH_IPADDR_PATH "/batch_ipaddr"
 /* To implement in the future */
 #define ESP_OT_REST_API_COMMISSION_PATH "/commission"
 #define ESP_OT_REST_API_NETWORK "/networks"
@@ -59,6 +76,11 @@ void esp_br_web_api_init(void);
 #define ESP_OT_REST_API_NETWORK_CURRENT_COMMISSION "/networks/commission"
 #define ESP_OT_REST_API_NETWORK_CURRENT_PREFIX "/networks/current/prefix"
 
+#define AVAILABLE_NETWORK_MAX_TIMEOUT_MS 30000
+
+/* Called for each network of the scan cache, returning an error stops the iteration. */
+typedef esp_err_t (*available_network_handler_t)(const thread_network_information_t *network, void *context);
+
 /*---------------------------------------------------------------------
                             Implement
 ----------------------------------------------------------------------*/
@@ -69,6 +91,13 @@ void esp_br_web_api_init(void);
  */
 cJSON *handle_ot_resource_node_information_request(void);
 
+/**
+ * @brief Provides an entry to obtain the Thread device's node information as a structure
+ *
+ * @param[out] node The Thread network node information
+ */
+void handle_ot_resource_node_information_struct_request(thread_node_information_t *node);
+
 /**
  * @brief Provides an entry to delete the Thread device's node information
  *
@@ -85,6 +114,76 @@ otError handle_ot_resource_node_delete_information_request(void);
  */
 cJSON *handle_ot_resource_network_diagnostics_request(void);
 
+/**
+ * @brief Provide a entry to collect the Thread network topology message, with pagination and filters.
+ *
+ * @note The set collected for a page with a next page is kept for a while, the requests with a cursor are served
+ *       from it without collecting again. A request whose TLVs or targets differ from those of the kept set collects
+ *       the set again, its cursor is then applied on the new set.
+ *
+ * @param[in] query         The pagination, the TLV projection and the filters, NULL for all the nodes.
+ * @param[out] next_cursor  The RLOC16 of the next page, or DIAGNOSTIC_QUERY_NO_CURSOR for the last page.
+ *
+ * @return The cJSON object of diagnostics
+ */
+cJSON *handle_ot_resource_network_diagnostics_query_request(const thread_diagnostic_query_t *query,
+                                                            int32_t *next_cursor);
+
+/**
+ * @brief Provide a entry to collect the Thread network topology and get the changes from a previous version.
+ *
+ * @note Each collection with a different topology gets a new version, the last versions are kept in a compact form.
+ *       The topology is only collected again when the latest version is more than 30 s old.
+ *
+ * @param[in] since         The version known by the client, 0 for none.
+ * @param[out] not_modified True if the topology is still the version @param since.
+ *
+ * @return The cJSON object of the added, removed and changed nodes and links, or the full topology if @param since
+ *         is no longer kept, NULL if not modified.
+ */
+cJSON *handle_ot_resource_network_diagnostics_delta_request(uint32_t since, bool *not_modified);
+
+/**
+ * @brief Provide a entry to get the metrics of the diagnostic query scheduler.
+ *
+ * @return The cJSON object of the rate, the issued and deferred queries, the responses and their latency
+ */
+cJSON *handle_ot_resource_network_diagnostics_scheduler_request(void);
+
+/**
+ * @brief Provide a entry to configure the rate and the burst of the diagnostic query scheduler.
+ *
+ * @param[in] request The cJSON object with the `Rate` and the `Burst`.
+ *
+ * @return
+ *      - OT_ERROR_NONE on success
+ *      - OT_ERROR_INVALID_ARGS if a value is missing or out of range
+ */
+otError handle_ot_resource_network_diagnostics_scheduler_put_request(const cJSON *request);
+
+/**
+ * @brief Provide a entry to collect the Thread network topology message, encoded in CBOR.
+ *
+ * @param[in] query         The pagination, the TLV projection and the filters, NULL for all the nodes.
+ * @param[out] next_cursor  The RLOC16 of the next page, or DIAGNOSTIC_QUERY_NO_CURSOR for the last page.
+ * @param[out] writer       The CBOR writer of the array of nodes.
+ *
+ * @return The error of the CBOR writer
+ */
+esp_err_t handle_ot_resource_network_diagnostics_cbor_request(const thread_diagnostic_query_t *query,
+                                                              int32_t *next_cursor, cbor_writer_t *writer);
+
+#if CONFIG_OPENTHREAD_BR_WEB_DIAG_BENCHMARK
+/**
+ * @brief Compare the size and the encode time of the JSON and the CBOR diagnostics on the collected set.
+ *
+ * @param[in] query The pagination, the TLV projection and the filters, NULL for all the nodes.
+ *
+ * @return The cJSON object of the benchmark result
+ */
+cJSON *handle_ot_resource_network_diagnostics_benchmark_request(const thread_diagnostic_query_t *query);
+#endif
+
 /**
  * @brief Provide an entry to get current Thread node rloc
  *
@@ -148,6 +247,26 @@ cJSON *handle_ot_resource_node_extpanid_request(void);
  */
 cJSON *handle_ot_resource_node_baid_request(void);
 
+/**
+ * @brief Provide an entry to get the selected fields of the node information from one snapshot
+ *
+ * @param[in]  fields   The comma separated keys of the GET /node response, e.g. "State,Rloc16".
+ * @param[out] log      A cJSON object used to record the "ErrorCode" (200/400) of the operation.
+ *
+ * @return The cJSON object with only the selected fields, or NULL if any field is unknown.
+ */
+cJSON *handle_ot_resource_node_fields_request(const char *fields, cJSON *log);
+
+/**
+ * @brief Provide an entry to get several node resources from one snapshot
+ *
+ * @param[in]  request  A cJSON object with the "resources" array of the resource paths, e.g. "/node/state".
+ * @param[out] log      A cJSON object used to record the "ErrorCode" (200/400) of the operation.
+ *
+ * @return The cJSON object keyed by the resource paths, or NULL if any resource is not supported.
+ */
+cJSON *handle_ot_resource_batch_request(const cJSON *request, cJSON *log);
+
 /**
  * @brief Handle the Thread dataset get @param request and provide @param log
  *
@@ -158,6 +277,19 @@ cJSON *handle_ot_resource_node_baid_request(void);
  */
 cJSON *handle_ot_resource_node_get_dataset_request(const cJSON *request, cJSON *log);
 
+/**
+ * @brief Get the Thread dataset as a structure
+ *
+ * @param [in] dataset_type ESP_OT_DATASET_TYPE_ACTIVE or ESP_OT_DATASET_TYPE_PENDING.
+ * @param [out] dataset    The Thread dataset.
+ *
+ * @return
+ *      -   OT_ERROR_NONE           :   On success.
+ *      -   OT_ERROR_INVALID_ARGS   :   Invalid dataset type.
+ *      -   OT_ERROR_NOT_FOUND      :   The dataset is not present.
+ */
+otError handle_ot_resource_node_dataset_struct_request(const char *dataset_type, otOperationalDataset *dataset);
+
 /**
  * @brief Handle the Thread state configuration @param request
  *
@@ -250,49 +382,54 @@ otError handle_openthread_network_commission_request(const cJSON *request);
 /**
  * @brief Provide an entry to discover Thread available network.
  *
- * @return the cJSON format of the available Thread networks.
+ * @note The networks are cached by their extended PAN ID and channel with the best RSSI and LQI seen, and dropped
+ *       10 minutes after their last response. A request during a discover waits for the running one.
+ *
+ * @param[in] channel_mask  The channels to scan, 0 for all the channels.
+ * @param[in] timeout_ms    The max time to wait for the discover, 0 for the time of a full scan of the channels.
+ * @param[in] handler       Called in the calling task for each network found or updated by the discover, or NULL.
+ * @param[out] complete     Whether the discover completed before the timeout, it continues in the background if not.
+ *
+ * @return
+ *      -   OT_ERROR_NONE           :   On success, also when the discover did not complete.
+ *      -   OT_ERROR_INVALID_ARGS   :   The channels or the timeout are invalid.
+ *      -   OT_ERROR_FAILED         :   The handler failed.
+ *      -   Other                   :   Failed to start the discover.
  */
-cJSON *handle_openthread_available_network_request(void);
+otError handle_openthread_available_network_scan(uint32_t channel_mask, uint32_t timeout_ms,
+                                                 available_network_handler_t handler, void *context, bool *complete);
 
 /**
- * @brief Provides an entry to obtain and pack the openthread properties.
+ * @brief Provide an entry to iterate the scan cache, from the least recently updated network.
  *
- * @return The cJSON Object type of Thread network properties.
  */
-cJSON *handle_openthread_network_properties_request(void);
+otError handle_openthread_available_network_cache(available_network_handler_t handler, void *context);
 
 /**
- * @brief Handle a ping request to an IPv6 address using the OpenThread ping sender.
+ * @brief Provide an entry to discover Thread available network.
  *
- * @param[in] request   A cJSON object containing "address" (IPv6 string), and optionally
- *                      "size" (payload bytes, default 32) and "count" (number of pings, default 4).
+ * @param[in] scan  Whether to discover before, or only to return the scan cache.
  *
- * @return A cJSON object with "replies" array and "statistics" summary, or NULL on failure.
+ * @return the cJSON format of all the networks in the scan cache, NULL if the discover failed.
  */
-cJSON *handle_openthread_ping_request(const cJSON *request);
+cJSON *handle_openthread_available_network_request(uint32_t channel_mask, uint32_t timeout_ms, bool scan);
 
 /**
- * @brief List all unicast IPv6 addresses on the Thread interface.
+ * @brief Provides an entry to obtain and pack the openthread properties.
  *
- * @return A cJSON array of address objects, or NULL on failure.
+ * @return The cJSON Object type of Thread network properties.
  */
-cJSON *handle_openthread_ipaddr_list_request(void);
+cJSON *handle_openthread_network_properties_request(void);
 
 /**
- * @brief Add a unicast IPv6 address to the Thread interface.
+ * @brief Handle a ping request to an IPv6 address using the OpenThread ping sender.
  *
- * @param[in] request   A cJSON object containing "address" (IPv6 string).
- * @return A cJSON object with status, or NULL on failure.
- */
-cJSON *handle_openthread_add_ipaddr_request(const cJSON *request);
-
-/**
- * @brief Remove a unicast IPv6 address from the Thread interface.
+ * @param[in] request   A cJSON object containing "address" (IPv6 string), and optionally
+ *                      "size" (payload bytes, default 32) and "count" (number of pings, default 4).
  *
- * @param[in] request   A cJSON object containing "address" (IPv6 string).
- * @return A cJSON object with status, or NULL on failure.
+ * @return A cJSON object with "replies" array and "statistics" summary, or NULL on failure.
  */
-cJSON *handle_openthread_delete_ipaddr_request(const cJSON *request);
+cJSON *handle_openthread_ping_request(const cJSON *request);
 
 /**
  * @brief Get whether the Border Agent ephemeral key (ePSKc) feature is enabled.
@@ -334,6 +471,164 @@ cJSON *handle_ot_resource_node_epskc_key_post_request(const cJSON *request, cJSO
  */
 void handle_ot_resource_node_epskc_key_delete_request(void);
 
+/**
+ * @brief Apply a batch of on-mesh prefix and external route changes to the local network data, and register it once.
+ *
+ * @note All the operations are validated before any is applied. If one fails, the applied ones are reverted and the
+ *       network data is not registered.
+ *
+ * @param[in]  request  A cJSON object with the "operations" array, each with "op" ("add"/"remove"), "type"
+ *                      ("prefix"/"route"), "prefix" and the optional flags of the entry.
+ * @param[out] log      A cJSON object used to record the "ErrorCode" (200/400/404/409/500) of the operation.
+ *
+ * @return The cJSON object with the per-operation "results", or NULL if the request is invalid.
+ */
+cJSON *handle_ot_resource_node_netdata_batch_request(const cJSON *request, cJSON *log);
+
+/**
+ * @brief Provide a entry to get the last channel survey.
+ *
+ * @return The cJSON object of the channels and the recommended channel, NULL if there is no survey.
+ */
+cJSON *handle_ot_resource_channel_survey_request(void);
+
+/**
+ * @brief Provide a entry to run a channel survey, it blocks for @param duration_ms and the scans.
+ *
+ * @return
+ *      -   OT_ERROR_NONE           :   On success.
+ *      -   OT_ERROR_INVALID_ARGS   :   A duration is out of range.
+ *      -   OT_ERROR_INVALID_STATE  :   Another survey is running.
+ *      -   OT_ERROR_FAILED         :   A scan failed.
+ */
+otError handle_ot_resource_channel_survey_post_request(uint32_t duration_ms, uint16_t scan_ms);
+
+/**
+ * @brief Provide a entry to move the network to another channel with a pending dataset.
+ *
+ * @param[in] request  A cJSON object with the optional "Channel", the recommended channel of the last survey by
+ *                     default, and the optional "Delay" of the change in milliseconds.
+ *
+ * @return
+ *      -   OT_ERROR_NONE           :   The leader accepted the pending dataset.
+ *      -   OT_ERROR_INVALID_ARGS   :   The channel or the delay is invalid, or the network is already on the channel.
+ *      -   OT_ERROR_INVALID_STATE  :   No channel is given nor surveyed, or this node is not attached.
+ */
+otError handle_ot_resource_channel_survey_put_request(const cJSON *request);
+
+#if CONFIG_OPENTHREAD_LINK_QUALITY_STORE
+/**
+ * @brief Provide a entry to get the history of the links between the routers.
+ *
+ * @param[in] from  The seconds since boot of the first point, the values not above 0 are relative to now.
+ * @param[in] to    The seconds since boot of the last point, the values not above 0 are relative to now.
+ * @param[in] node  Only the links of this RLOC16, ESP_OT_LINK_QUALITY_ANY_NODE for all the links.
+ *
+ * @return The cJSON object of the links, each in the finest resolution covering @param from.
+ */
+cJSON *handle_ot_resource_link_quality_request(int32_t from, int32_t to, uint16_t node);
+#endif
+
+#if CONFIG_OPENTHREAD_MAC_COUNTERS_STORE
+/**
+ * @brief Provide a entry to get the worst nodes and links by their MAC error rates, or the intervals of a node.
+ *
+ * @param[in] window  The seconds of the last intervals, 0 for the whole history.
+ * @param[in] count   The max number of the nodes and of the links.
+ * @param[in] node    The RLOC16 of the node, ESP_OT_MAC_COUNTERS_ANY_NODE for the worst nodes and links.
+ *
+ * @return The cJSON object of the nodes and the links, or NULL if @param node is not known.
+ */
+cJSON *handle_ot_resource_mac_counters_request(uint32_t window, uint16_t count, uint16_t node);
+#endif
+
+#if CONFIG_OPENTHREAD_DNS_POOL
+/**
+ * @brief Provide a entry to get the DNS servers of the pool, their probe history and the changes of the main server.
+ *
+ * @return The cJSON object of the servers and the changes.
+ */
+cJSON *handle_ot_resource_dns_upstreams_request(void);
+#endif
+
+#if CONFIG_OPENTHREAD_IP_STATS
+/**
+ * @brief Provide a entry to get the forwarding counters of the lwIP netifs, the forwarding latency histograms and the
+ * forwarded multicast groups.
+ *
+ * @return The cJSON object of the statistics.
+ */
+cJSON *handle_ot_resource_ip_stats_request(void);
+#endif
+
+#if CONFIG_OPENTHREAD_BOOT_TIMELINE
+/**
+ * @brief Provide a entry to get the phases of the boot, in the order they began.
+ *
+ * @return The cJSON object of the phases.
+ */
+cJSON *handle_ot_resource_boot_timeline_request(void);
+#endif
+
+#if CONFIG_OPENTHREAD_COEX
+/**
+ * @brief Provide a entry to get the Wi-Fi and 802.15.4 coexistence statistics, the priorities of the 802.15.4 radio
+ * and the results of the measurement.
+ *
+ * @return The cJSON object of the coexistence.
+ */
+cJSON *handle_ot_resource_coex_request(void);
+
+/**
+ * @brief Reset the coexistence statistics and set the priorities of the 802.15.4 radio.
+ *
+ * @param[in] request  A cJSON object with optional "Reset" (bool) and either "Profile" (string) or "Priorities"
+ *                     (object of "Idle", "TxRx" and "TxRxAt" strings).
+ *
+ * @return
+ *      - OT_ERROR_NONE on success
+ *      - OT_ERROR_INVALID_ARGS if the request is invalid
+ *      - OT_ERROR_INVALID_STATE if a measurement is running
+ *      - OT_ERROR_NOT_CAPABLE if the radio does not support the priorities
+ */
+otError handle_ot_resource_coex_put_request(const cJSON *request);
+
+/**
+ * @brief Start the coexistence measurement.
+ *
+ * @param[in] request  A cJSON object with "Address" (string) and optional "Profiles" (array of strings).
+ *
+ * @return See handle_ot_resource_coex_put_request.
+ */
+otError handle_ot_resource_coex_measure_post_request(const cJSON *request);
+#endif
+
+#if CONFIG_OPENTHREAD_COMMISSION_JOB
+/**
+ * @brief Get the progress of the bulk commissioning job.
+ *
+ * @return The cJSON object with the counters, the throughput and the state of each joiner.
+ */
+cJSON *handle_ot_resource_node_commissioner_job_get_request(void);
+
+/**
+ * @brief Add the joiners to the bulk commissioning job and start it.
+ *
+ * @param[in]  request  A cJSON object with optional "timeout" (seconds) and "retries", and the "joiners" array of
+ *                      objects with "eui64" or "discerner" and "pskd" when @param csv is NULL.
+ * @param[in]  csv      The joiners as "<eui64|discerner>,<pskd>" lines, or NULL. Modified while parsing.
+ * @param[out] log      A cJSON object used to record the "ErrorCode" (200/400/409/500) of the operation.
+ *
+ * @return The cJSON object of the job on success, otherwise NULL.
+ */
+cJSON *handle_ot_resource_node_commissioner_job_post_request(const cJSON *request, char *csv, cJSON *log);
+
+/**
+ * @brief Stop the bulk commissioning job and remove all its joiners.
+ */
+void handle_ot_resource_node_commissioner_job_delete_request(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
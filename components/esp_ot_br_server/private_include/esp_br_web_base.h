@@ -40,12 +40,15 @@ extern "C" {
 
 #define ESP_OT_REST_CONTENT_TYPE_JSON "application/json"
 #define ESP_OT_REST_CONTENT_TYPE_PLAIN "text/plain"
+#define ESP_OT_REST_CONTENT_TYPE_CSV "text/csv"
+#define ESP_OT_REST_CONTENT_TYPE_CBOR "application/cbor"
 
 #define ESP_OT_REST_DATASET_TYPE "DatasetType"
 #define ESP_OT_DATASET_TYPE_ACTIVE "active"
 #define ESP_OT_DATASET_TYPE_PENDING "pending"
 
 #define HTTPD_201 "201 Created"
+#define HTTPD_304 "304 Not Modified"
 #define HTTPD_409 "409 Conflict"
 
 /**
@@ -110,21 +113,17 @@ typedef struct openthread_status {
         Discover Thread netWork
 -----------------------------------------------*/
 typedef struct thread_network_information {
-    uint16_t id;
+    uint16_t id; /* stable while the network stays in the scan cache, 0 for a free entry */
     otNetworkName network_name;
     otExtendedPanId extended_panid;
     uint16_t panid;
-    otExtAddress extended_address;
+    otExtAddress extended_address; /* the router heard with the best RSSI */
     uint8_t channel;
-    int8_t rssi;
-    uint8_t lqi;
+    int8_t rssi; /* the best RSSI seen */
+    uint8_t lqi; /* the best LQI seen */
+    uint32_t last_seen; /* the seconds since boot of the last response */
 } thread_network_information_t;
 
-typedef struct thread_network_list {
-    thread_network_information_t *network;
-    struct thread_network_list *next;
-} thread_network_list_t;
-
 /*---------------------------------------------
         Form Thread Network
 -----------------------------------------------*/
@@ -143,7 +142,10 @@ typedef struct thread_network_form_param {
         Join Thread Network
 -----------------------------------------------*/
 typedef struct thread_network_join_param {
-    int index;
+    int index; /* the id of the network, only used without extended_panid */
+    bool has_extended_panid;
+    otExtendedPanId extended_panid;
+    uint8_t channel; /* 0 for the network last seen on any channel */
     uint8_t credentialType[16];
     otNetworkKey networkKey;
     char prefix[OT_IP6_PREFIX_STRING_SIZE + 3];
@@ -166,6 +168,29 @@ typedef struct thread_diagnosticTlv_set {
     thread_diagnosticTlv_list_t *diagTlv_next;
 } thread_diagnosticTlv_set_t;
 
+#define DIAGNOSTIC_QUERY_NO_CURSOR (-1)
+#define DIAGNOSTIC_QUERY_MAX_TARGETS 16
+
+typedef enum {
+    DIAGNOSTIC_TARGET_MULTICAST = 0, /* one multicast to all the routers. */
+    DIAGNOSTIC_TARGET_ROUTERS,       /* one unicast to each router of the router table. */
+    DIAGNOSTIC_TARGET_LIST,          /* one unicast to each RLOC16 of the targets, routers or children. */
+} thread_diagnostic_target_t;
+
+typedef struct thread_diagnostic_query {
+    uint16_t limit;       /* the max number of nodes in a page, 0 for no limit. */
+    int32_t cursor;       /* the first RLOC16 of the page, DIAGNOSTIC_QUERY_NO_CURSOR for the first page. */
+    uint64_t tlv_mask;    /* bit n selects the TLV type n, 0 for all the TLVs. Only these TLVs are requested. */
+    int8_t role;          /* OT_DEVICE_ROLE_ROUTER or OT_DEVICE_ROLE_LEADER, -1 for any role. */
+    int8_t has_children;  /* 1 for nodes with children, 0 for nodes without children, -1 for any. */
+    uint8_t lq_below;     /* nodes with a link quality below it, 0 for any. */
+    uint8_t target;       /* thread_diagnostic_target_t */
+    uint8_t target_count; /* the number of the targets of DIAGNOSTIC_TARGET_LIST, all different. */
+    uint16_t targets[DIAGNOSTIC_QUERY_MAX_TARGETS];
+    uint16_t timeout_ms;  /* the max time of the collection, 0 for the default. */
+    uint16_t quiet_ms;    /* the collection ends after no response for it, 0 for the default. */
+} thread_diagnostic_query_t;
+
 typedef struct thread_node_information {
     uint32_t role;
     uint32_t router_number;
@@ -186,11 +211,7 @@ esp_err_t string_to_hex(char str[], uint8_t hex[], size_t size);
 void otbr_properties_reset(openthread_properties_t *properties);
 cJSON *otbr_properties_struct_convert2_json(openthread_properties_t *properties);
 
-cJSON *available_network_struct_convert2_json(thread_network_information_t *network);
-
-esp_err_t initialize_available_thread_networks_list(thread_network_list_t *list);
-esp_err_t append_available_thread_networks_list(thread_network_list_t *list, thread_network_information_t network);
-void destroy_available_thread_networks_list(thread_network_list_t *list);
+cJSON *available_network_struct_convert2_json(const thread_network_information_t *network);
 
 void network_formation_param_reset(thread_network_formation_param_t *param);
 esp_err_t network_formation_param_json_convert2_struct(const cJSON *root, cJSON *log,
@@ -209,6 +230,14 @@ esp_err_t update_thread_diagnosticTlv_set(thread_diagnosticTlv_set_t *set, char
 void destroy_thread_diagnosticTlv_set(thread_diagnosticTlv_set_t *set);
 cJSON *diagnosticTlv_set_convert2_json(const thread_diagnosticTlv_set_t *set);
 
+void thread_diagnostic_query_reset(thread_diagnostic_query_t *query);
+esp_err_t diagnosticTlv_names_convert2_mask(char *names, uint64_t *mask);
+const thread_diagnosticTlv_set_t *diagnosticTlv_set_query_next(const thread_diagnosticTlv_set_t *set,
+                                                                const thread_diagnostic_query_t *query, uint32_t from,
+                                                                uint16_t *rloc16);
+cJSON *diagnosticTlv_set_query_convert2_json(const thread_diagnosticTlv_set_t *set,
+                                             const thread_diagnostic_query_t *query, int32_t *next_cursor);
+
 void thread_node_information_reset(thread_node_information_t *node);
 cJSON *thread_node_struct_convert2_json(thread_node_information_t *node);
 
@@ -0,0 +1,75 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "cJSON.h"
+#include "esp_br_web_base.h"
+#include "esp_err.h"
+#include "openthread/dataset.h"
+#include "openthread/thread.h"
+
+/*---------------------------------------------
+        CBOR (RFC 8949) Writer
+-----------------------------------------------*/
+typedef struct cbor_writer {
+    uint8_t *buf;  /* the encoded data, grown on demand */
+    size_t len;    /* the length of the encoded data */
+    size_t size;   /* the size of buf */
+    esp_err_t err; /* the first error of the writer, the following items are dropped */
+} cbor_writer_t;
+
+esp_err_t cbor_writer_init(cbor_writer_t *writer, size_t size);
+void cbor_writer_deinit(cbor_writer_t *writer);
+
+void cbor_put_uint(cbor_writer_t *writer, uint64_t value);
+void cbor_put_int(cbor_writer_t *writer, int64_t value);
+void cbor_put_bool(cbor_writer_t *writer, bool value);
+void cbor_put_null(cbor_writer_t *writer);
+void cbor_put_double(cbor_writer_t *writer, double value);
+void cbor_put_bytes(cbor_writer_t *writer, const uint8_t *data, size_t len);
+void cbor_put_text(cbor_writer_t *writer, const char *text);
+void cbor_put_array(cbor_writer_t *writer, size_t count);
+void cbor_put_map(cbor_writer_t *writer, size_t count);
+void cbor_put_array_indefinite(cbor_writer_t *writer);
+void cbor_put_map_indefinite(cbor_writer_t *writer);
+void cbor_put_break(cbor_writer_t *writer);
+
+/**
+ * @brief Encode a cJSON item, for the responses without a dedicated encoder.
+ *
+ */
+void cbor_put_json(cbor_writer_t *writer, const cJSON *item);
+
+/*---------------------------------------------
+        Thread Structures to CBOR
+-----------------------------------------------*/
+/* The maps use the keys of the JSON responses, but the addresses, keys and other binary values are byte strings. */
+void LeaderData2Cbor(cbor_writer_t *writer, const otLeaderData *aLeaderData);
+void ActiveDataset2Cbor(cbor_writer_t *writer, const otOperationalDataset *aActiveDataset);
+void PendingDataset2Cbor(cbor_writer_t *writer, const otOperationalDataset *aPendingDataset);
+void thread_node_struct_convert2_cbor(cbor_writer_t *writer, const thread_node_information_t *node);
+
+/**
+ * @brief Encode a page of the diagnostic set as an array of nodes.
+ *
+ * @note Each node is a map keyed by the Network Diagnostic TLV type. The RouteData and ChildTable entries and the
+ *       Mode are arrays in the order of the keys of the JSON response.
+ *
+ */
+void diagnosticTlv_set_query_convert2_cbor(cbor_writer_t *writer, const thread_diagnosticTlv_set_t *set,
+                                           const thread_diagnostic_query_t *query, int32_t *next_cursor);
+
+#ifdef __cplusplus
+}
+#endif
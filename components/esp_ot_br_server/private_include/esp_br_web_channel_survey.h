@@ -0,0 +1,63 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "cJSON.h"
+#include "esp_err.h"
+
+#define CHANNEL_SURVEY_DEFAULT_DURATION_MS 10000
+#define CHANNEL_SURVEY_MAX_DURATION_MS 120000
+#define CHANNEL_SURVEY_DEFAULT_SCAN_MS 100 /* the energy scan duration of each channel in a pass */
+#define CHANNEL_SURVEY_MIN_SCAN_MS 10
+#define CHANNEL_SURVEY_MAX_SCAN_MS 1000
+
+/*---------------------------------------------
+        Channel Survey
+-----------------------------------------------*/
+/* A survey runs one active scan for the PANs on each channel, then energy scans of all the channels until its
+   duration has elapsed. The channels are ranked by the average and the max RSSI of the energy scans and by the number
+   of the other PANs, the PAN of this node is not counted but its own traffic adds to the energy of its channel. */
+
+void channel_survey_init(void);
+
+/**
+ * @brief Run a survey of the channels supported by the radio, the result replaces the previous one.
+ *
+ * @param[in] duration_ms  The duration of the energy scans, at least one pass is done.
+ * @param[in] scan_ms      The energy scan duration of each channel in a pass.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if a duration is out of range
+ *      - ESP_ERR_INVALID_STATE if another survey is running
+ *      - ESP_ERR_TIMEOUT if a scan did not complete
+ *      - ESP_FAIL if a scan could not be started
+ */
+esp_err_t channel_survey_run(uint32_t duration_ms, uint16_t scan_ms);
+
+/**
+ * @brief Get the best channel of the last survey.
+ *
+ * @return The channel, 0 if there is no survey.
+ */
+uint8_t channel_survey_recommended(void);
+
+/**
+ * @brief Convert the last survey.
+ *
+ * @return The cJSON object of the channels and the recommendation, NULL if there is no survey.
+ */
+cJSON *channel_survey_convert2_json(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,86 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "cJSON.h"
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+
+#define DIAG_SCHEDULER_MULTICAST 0xffff /* the RLOC16 of the multicast queries */
+
+/* The issuers of the queries, each one waits for the responses of its own queries. */
+typedef enum {
+    DIAG_SCHEDULER_OWNER_WEB = 0, /* the collections of the web server */
+    DIAG_SCHEDULER_OWNER_SWEEP,   /* the periodic sweep of the stores */
+    DIAG_SCHEDULER_OWNERS,
+} diag_scheduler_owner_t;
+
+/*---------------------------------------------
+        Diagnostic Query Scheduler
+-----------------------------------------------*/
+/* All the diagnostic queries of the web server share one token bucket, a query takes one token and a multicast
+   query takes one token per router expected to respond. A query costing more than the bucket holds waits for a full
+   bucket and leaves it in debt, the next queries wait until the debt is paid back. The rate is lowered when
+   responses are lost or slow and raised back slowly while they arrive in time. */
+
+void diag_scheduler_init(void);
+
+/**
+ * @brief Set the configured rate and burst of the token bucket, the current rate restarts from the configured one.
+ *
+ * @param[in] rate   The queries per second.
+ * @param[in] burst  The max number of queries issued at once.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if a value is out of range
+ */
+esp_err_t diag_scheduler_configure(uint16_t rate, uint16_t burst);
+
+/**
+ * @brief Wait for the tokens of a query.
+ *
+ * @param[in] cost      The number of tokens, all of them are charged even above the burst.
+ * @param[in] deadline  The tick until which the query can wait.
+ *
+ * @return
+ *      - ESP_OK if the query can be issued
+ *      - ESP_ERR_TIMEOUT if the query is deferred beyond the deadline, it must not be issued
+ */
+esp_err_t diag_scheduler_acquire(uint16_t cost, TickType_t deadline);
+
+/**
+ * @brief Record an issued query, to measure the latency and the loss of its response.
+ *
+ * @param[in] owner  The issuer of the query.
+ * @param[in] rloc16 The RLOC16 of the unicast destination or DIAG_SCHEDULER_MULTICAST.
+ */
+void diag_scheduler_sent(diag_scheduler_owner_t owner, uint16_t rloc16);
+
+/**
+ * @brief Record a response to a query of @param owner, called from the OpenThread task.
+ *
+ */
+void diag_scheduler_responded(diag_scheduler_owner_t owner, uint16_t rloc16);
+
+/**
+ * @brief End the collection of @param owner, its unicast queries still waiting for a response are lost. The queries
+ *        of the other owners keep waiting.
+ *
+ */
+void diag_scheduler_expire(diag_scheduler_owner_t owner);
+
+cJSON *diag_scheduler_metrics_convert2_json(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,67 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+/**
+ * @brief The output of the gzip stream, called each time the output buffer is full and when the stream is finished.
+ *
+ */
+typedef esp_err_t (*gzip_stream_output_t)(void *context, const uint8_t *data, size_t len);
+
+typedef struct gzip_stream gzip_stream_t;
+
+/**
+ * @brief Create a gzip (RFC 1952) stream.
+ *
+ * @note The data is compressed in a single deflate block with the fixed Huffman codes and an LZ77 window of
+ *       (1 << window_bits) bytes, the RAM of the stream is about (4 << window_bits) + 2048 bytes plus the output
+ *       buffer.
+ *
+ * @param[in] window_bits   The log2 of the LZ77 window size, 9 to 13.
+ * @param[in] output_size   The size of the output buffer.
+ * @param[in] output        The output of the compressed data.
+ * @param[in] context       The context of the output.
+ *
+ * @return The gzip stream, or NULL if the arguments are invalid or there is no memory.
+ */
+gzip_stream_t *gzip_stream_create(uint8_t window_bits, size_t output_size, gzip_stream_output_t output,
+                                  void *context);
+
+/**
+ * @brief Compress the data into the gzip stream.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - Others: the error of the output, the stream can only be destroyed then
+ */
+esp_err_t gzip_stream_write(gzip_stream_t *stream, const void *data, size_t len);
+
+/**
+ * @brief Compress the remaining data, end the gzip stream and output all the buffered data.
+ *
+ */
+esp_err_t gzip_stream_finish(gzip_stream_t *stream);
+
+/**
+ * @brief Get the number of the input and the output bytes of the gzip stream.
+ *
+ */
+void gzip_stream_get_size(const gzip_stream_t *stream, size_t *in_len, size_t *out_len);
+
+void gzip_stream_destroy(gzip_stream_t *stream);
+
+#ifdef __cplusplus
+}
+#endif
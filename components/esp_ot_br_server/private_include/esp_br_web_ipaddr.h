@@ -0,0 +1,73 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cJSON.h"
+#include "openthread/error.h"
+
+/*---------------------------------------------
+        IPv6 Address Management
+-----------------------------------------------*/
+/**
+ * @brief List all unicast IPv6 addresses on the Thread interface.
+ *
+ * @return A cJSON array of address objects, or NULL on failure.
+ */
+cJSON *handle_openthread_ipaddr_list_request(void);
+
+/**
+ * @brief Add a unicast IPv6 address to the Thread interface.
+ *
+ * @param[in] request   A cJSON object containing "address" (IPv6 string).
+ * @return A cJSON object with status, or NULL on failure.
+ */
+cJSON *handle_openthread_add_ipaddr_request(const cJSON *request);
+
+/**
+ * @brief Remove a unicast IPv6 address from the Thread interface.
+ *
+ * @param[in] request   A cJSON object containing "address" (IPv6 string).
+ * @return A cJSON object with status, or NULL on failure.
+ */
+cJSON *handle_openthread_delete_ipaddr_request(const cJSON *request);
+
+/**
+ * @brief Add and remove a batch of unicast IPv6 addresses of the Thread interface under one lock acquisition.
+ *
+ * @note All the entries are validated before any is applied.
+ *
+ * @param[in]  request  A cJSON object with the "operations" array, each with "op" ("add"/"remove"), "address" and
+ *                      the optional "prefixLength".
+ * @param[out] error    OT_ERROR_NONE if all the entries are applied, OT_ERROR_INVALID_ARGS if any entry is invalid,
+ *                      otherwise OT_ERROR_FAILED.
+ * @return A cJSON object with the per-entry "status" array, or NULL if the request is invalid.
+ */
+cJSON *handle_openthread_batch_ipaddr_request(const cJSON *request, otError *error);
+
+/**
+ * @brief Measure the throughput of the single address handlers and of the batch path.
+ *
+ * @note Not served by the REST API, as it adds addresses to the live interface. @p count scratch addresses of a random
+ *       ULA prefix are added and removed one at a time through the single address handlers, and then through one
+ *       batch. Only one scratch address is on the interface at a time, and none is left afterwards. The HTTP and
+ *       network cost of one request per address is not included.
+ *
+ * @param[in]  count    The number of scratch addresses, 1 to 32.
+ * @param[out] error    OT_ERROR_NONE if all the operations succeed, OT_ERROR_INVALID_ARGS for an invalid count,
+ *                      OT_ERROR_ALREADY if no unused scratch prefix is found, otherwise OT_ERROR_FAILED.
+ * @return A cJSON object with the "prefix", the "operations", the time and the ops/s of each path and the number of
+ *         "failed" operations, or NULL if the benchmark did not run.
+ */
+cJSON *openthread_ipaddr_batch_benchmark(int count, otError *error);
+
+#ifdef __cplusplus
+}
+#endif
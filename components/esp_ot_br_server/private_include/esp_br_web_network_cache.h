@@ -0,0 +1,63 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_br_web_base.h"
+#include "openthread/link.h"
+
+#define AVAILABLE_NETWORK_CACHE_SIZE 32
+#define AVAILABLE_NETWORK_MAX_AGE_S 600 /* the networks not seen for longer are dropped from the cache */
+
+/*---------------------------------------------
+        Available Network Cache
+-----------------------------------------------*/
+/* The networks found by the discovers, one entry per extended PAN ID and channel. An entry keeps the best RSSI and
+   LQI heard and its id while it stays cached; when the cache is full the least recently seen entry is replaced. Each
+   update takes the next sequence number, the readers follow the updates after the sequence they last read. */
+
+void available_network_cache_init(void);
+
+/**
+ * @brief Add or update the network of a discover result, called from the OpenThread task.
+ *
+ */
+void available_network_cache_update(const otActiveScanResult *result);
+
+/**
+ * @brief Get the sequence number of the last update.
+ *
+ */
+uint32_t available_network_cache_seq(void);
+
+/**
+ * @brief Get the unexpired network updated first after @param seq, in the order of the updates.
+ *
+ * @param[in]  seq       The sequence number of the last network read, 0 for all the networks.
+ * @param[out] network   The network.
+ * @param[out] next_seq  The sequence number of the network.
+ *
+ * @return true if a network was updated after @param seq.
+ */
+bool available_network_cache_next(uint32_t seq, thread_network_information_t *network, uint32_t *next_seq);
+
+/**
+ * @brief Find the network to join, the one last seen with the extended PAN ID of @param param, or else the one with
+ *        its index as id.
+ *
+ * @return true if an unexpired network was found.
+ */
+bool available_network_cache_find(const thread_network_join_param_t *param, thread_network_information_t *network);
+
+#ifdef __cplusplus
+}
+#endif
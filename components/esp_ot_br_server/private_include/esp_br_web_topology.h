@@ -0,0 +1,113 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "cJSON.h"
+#include "esp_br_web_base.h"
+#include "esp_err.h"
+#include "openthread/thread.h"
+
+#define THREAD_TOPOLOGY_NO_PARENT 0xfffe
+
+/*---------------------------------------------
+        Compact Thread Network Topology
+-----------------------------------------------*/
+typedef struct thread_topology_node {
+    uint16_t rloc16;
+    uint16_t parent;          /* the RLOC16 of the parent of a child, THREAD_TOPOLOGY_NO_PARENT for a router. */
+    otExtAddress ext_address; /* all zero for a child, which is only known from the ChildTable of its parent. */
+    otLinkModeConfig mode;
+    bool leader;
+} thread_topology_node_t;
+
+typedef struct thread_topology_link {
+    uint16_t from;            /* the RLOC16 of the router reporting the link. */
+    uint16_t to;              /* the RLOC16 of the neighbor router or the child. */
+    uint8_t link_quality_in;  /* the link quality reported by the router. */
+    uint8_t link_quality_out; /* 0 for a child link, only the incoming link quality is reported. */
+} thread_topology_link_t;
+
+typedef struct thread_topology_snapshot {
+    uint32_t version; /* 0 for an empty slot. */
+    uint16_t node_count;
+    uint16_t link_count;
+    thread_topology_node_t *nodes; /* in the order of RLOC16. */
+    thread_topology_link_t *links; /* in the order of (from, to). */
+} thread_topology_snapshot_t;
+
+#define THREAD_TOPOLOGY_HISTORY_SIZE 4
+
+typedef struct thread_topology_history {
+    thread_topology_snapshot_t snapshots[THREAD_TOPOLOGY_HISTORY_SIZE]; /* ring of the kept versions. */
+    uint8_t latest;   /* the index of the latest version in snapshots. */
+    uint32_t version; /* the version of the latest topology, starts at the boot epoch. */
+} thread_topology_history_t;
+
+/**
+ * @brief Build the compact topology from the routers of a diagnostic set, the children come from their ChildTable.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_NO_MEM if there is no memory for the nodes or the links
+ */
+esp_err_t thread_topology_snapshot_build(const thread_diagnosticTlv_set_t *set, thread_topology_snapshot_t *snapshot);
+void thread_topology_snapshot_free(thread_topology_snapshot_t *snapshot);
+
+/**
+ * @brief Compare the nodes and the links of two snapshots, the versions are ignored.
+ *
+ */
+bool thread_topology_snapshot_equal(const thread_topology_snapshot_t *a, const thread_topology_snapshot_t *b);
+
+cJSON *thread_topology_snapshot_convert2_json(const thread_topology_snapshot_t *snapshot);
+
+/**
+ * @brief Convert the added, removed and changed nodes and links from @param base to @param snapshot.
+ *
+ */
+cJSON *thread_topology_delta_convert2_json(const thread_topology_snapshot_t *base,
+                                           const thread_topology_snapshot_t *snapshot);
+
+/**
+ * @brief Start an empty history, the versions follow @param epoch.
+ *
+ * @note A random epoch on each boot keeps a version seen by a client before a reboot from naming a different topology
+ *       after it, such a version is not kept and gets the full topology.
+ *
+ */
+void thread_topology_history_init(thread_topology_history_t *history, uint32_t epoch);
+
+/**
+ * @brief Keep @param snapshot as the next version, unless it is the same as the latest one. The oldest version is
+ *        dropped, the history owns the snapshot afterwards.
+ *
+ * @return True if the snapshot got a new version.
+ */
+bool thread_topology_history_record(thread_topology_history_t *history, thread_topology_snapshot_t *snapshot);
+
+/**
+ * @brief The latest version, with a version of 0 before the first one is recorded.
+ *
+ */
+const thread_topology_snapshot_t *thread_topology_history_latest(const thread_topology_history_t *history);
+
+/**
+ * @brief Find a kept version, NULL if @param version is 0 or is no longer kept.
+ *
+ */
+const thread_topology_snapshot_t *thread_topology_history_find(const thread_topology_history_t *history,
+                                                               uint32_t version);
+
+#ifdef __cplusplus
+}
+#endif
@@ -17,7 +17,13 @@
 #include "cJSON.h"
 #include "esp_br_web.h"
 #include "esp_br_web_api.h"
+#include "esp_br_web_channel_survey.h"
 #include "esp_br_web_base.h"
+#include "esp_br_web_cbor.h"
+#include "esp_br_web_ipaddr.h"
+#if CONFIG_OPENTHREAD_BR_WEB_GZIP
+#include "esp_br_web_gzip.h"
+#endif
 #if CONFIG_OPENTHREAD_BR_SOFTAP_SETUP
 #include "esp_br_wifi_config.h"
 #endif
@@ -29,6 +35,21 @@
 #include "esp_log.h"
 #include "esp_openthread.h"
 #include "esp_openthread_border_router.h"
+#if CONFIG_OPENTHREAD_HEAP_DIAG_SCOPE
+#include "esp_ot_heap_diag.h"
+#endif
+#if CONFIG_OPENTHREAD_LINK_QUALITY_STORE
+#include "esp_ot_link_quality.h"
+#endif
+#if CONFIG_OPENTHREAD_MAC_COUNTERS_STORE
+#include "esp_ot_mac_counters.h"
+#endif
+#if CONFIG_OPENTHREAD_CAPTURE
+#include "esp_ot_capture.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#endif
 #include "esp_spiffs.h"
 #include "esp_vfs.h"
 #include "http_parser.h"
@@ -44,6 +65,24 @@
 #define MAX_FILE_SIZE (200 * 1024) // 200 KB
 #define MAX_FILE_SIZE_STR "200KB"
 #define SCRATCH_BUFSIZE 1024 /* Scratch buffer size */
+#define COMMISSIONER_JOB_BODY_MAX_SIZE (16 * 1024)
+#define NETDATA_BATCH_BODY_MAX_SIZE (8 * 1024)
+#define IPADDR_BATCH_BODY_MAX_SIZE (8 * 1024)
+#define NODE_FIELDS_QUERY_MAX_SIZE 256
+#define DIAGNOSTICS_QUERY_MAX_SIZE 256
+#define DIAGNOSTICS_TIMEOUT_MIN_MS 500
+#define DIAGNOSTICS_TIMEOUT_MAX_MS 30000
+#define DIAGNOSTICS_QUIET_MIN_MS 100
+#define DIAGNOSTICS_QUIET_MAX_MS 10000
+#define LINK_QUALITY_DEFAULT_RANGE_S 3600
+#define MAC_COUNTERS_DEFAULT_COUNT 5
+#define CHANNEL_SURVEY_QUERY_MAX_SIZE 64
+#define CAPTURE_QUERY_MAX_SIZE 192
+#define CAPTURE_DEFAULT_DURATION_S 30
+#define CAPTURE_CHUNK_SIZE 2048
+#define CAPTURE_POLL_MS 20
+#define CAPTURE_TASK_STACK_SIZE 3072
+#define CAPTURE_TASK_PRIORITY 5
 #define VFS_PATH_MAXNUM 15
 #define SERVER_IPV4_LEN 16
 #define FILE_CHUNK_SIZE 4096
@@ -89,7 +128,11 @@ typedef struct request_url {
  Note：Http Server Thread REST API
 -----------------------------------------------------*/
 static esp_err_t esp_otbr_network_diagnostics_get_handler(httpd_req_t *req);
+static esp_err_t esp_otbr_network_diagnostics_delta_get_handler(httpd_req_t *req);
+static esp_err_t esp_otbr_network_diagnostics_scheduler_get_handler(httpd_req_t *req);
+static esp_err_t esp_otbr_network_diagnostics_scheduler_put_handler(httpd_req_t *req);
 static esp_err_t esp_otbr_network_node_get_handler(httpd_req_t *req);
+static esp_err_t esp_otbr_network_node_fields_get_handler(httpd_req_t *req, const char *fields);
 static esp_err_t esp_otbr_network_node_delete_handler(httpd_req_t *req);
 static esp_err_t esp_otbr_network_node_rloc_get_handler(httpd_req_t *req);
 static esp_err_t esp_otbr_network_node_rloc16_get_handler(httpd_req_t *req);
@@ -109,6 +152,39 @@ static esp_err_t esp_otbr_network_node_epskc_state_put_handler(httpd_req_t *req)
 static esp_err_t esp_otbr_network_node_epskc_key_get_handler(httpd_req_t *req);
 static esp_err_t esp_otbr_network_node_epskc_key_post_handler(httpd_req_t *req);
 static esp_err_t esp_otbr_network_node_epskc_key_delete_handler(httpd_req_t *req);
+static esp_err_t esp_otbr_network_node_netdata_batch_post_handler(httpd_req_t *req);
+static esp_err_t esp_otbr_batch_post_handler(httpd_req_t *req);
+#if CONFIG_OPENTHREAD_COMMISSION_JOB
+static esp_err_t esp_otbr_network_node_commissioner_job_get_handler(httpd_req_t *req);
+static esp_err_t esp_otbr_network_node_commissioner_job_post_handler(httpd_req_t *req);
+static esp_err_t esp_otbr_network_node_commissioner_job_delete_handler(httpd_req_t *req);
+#endif
+static esp_err_t esp_otbr_channel_survey_get_handler(httpd_req_t *req);
+static esp_err_t esp_otbr_channel_survey_post_handler(httpd_req_t *req);
+static esp_err_t esp_otbr_channel_survey_channel_put_handler(httpd_req_t *req);
+#if CONFIG_OPENTHREAD_LINK_QUALITY_STORE
+static esp_err_t esp_otbr_network_link_quality_get_handler(httpd_req_t *req);
+#endif
+#if CONFIG_OPENTHREAD_MAC_COUNTERS_STORE
+static esp_err_t esp_otbr_network_mac_counters_get_handler(httpd_req_t *req);
+#endif
+#if CONFIG_OPENTHREAD_DNS_POOL
+static esp_err_t esp_otbr_dns_upstreams_get_handler(httpd_req_t *req);
+#endif
+#if CONFIG_OPENTHREAD_IP_STATS
+static esp_err_t esp_otbr_ip_stats_get_handler(httpd_req_t *req);
+#endif
+#if CONFIG_OPENTHREAD_BOOT_TIMELINE
+static esp_err_t esp_otbr_boot_timeline_get_handler(httpd_req_t *req);
+#endif
+#if CONFIG_OPENTHREAD_CAPTURE
+static esp_err_t esp_otbr_capture_get_handler(httpd_req_t *req);
+#endif
+#if CONFIG_OPENTHREAD_COEX
+static esp_err_t esp_otbr_coex_get_handler(httpd_req_t *req);
+static esp_err_t esp_otbr_coex_put_handler(httpd_req_t *req);
+static esp_err_t esp_otbr_coex_measure_post_handler(httpd_req_t *req);
+#endif
 
 static httpd_uri_t s_resource_handlers[] = {
     {
@@ -117,6 +193,24 @@ static httpd_uri_t s_resource_handlers[] = {
         .handler = esp_otbr_network_diagnostics_get_handler,
         .user_ctx = NULL,
     },
+    {
+        .uri = ESP_OT_REST_API_DIAGNOSTICS_DELTA_PATH,
+        .method = HTTP_GET,
+        .handler = esp_otbr_network_diagnostics_delta_get_handler,
+        .user_ctx = NULL,
+    },
+    {
+        .uri = ESP_OT_REST_API_DIAGNOSTICS_SCHEDULER_PATH,
+        .method = HTTP_GET,
+        .handler = esp_otbr_network_diagnostics_scheduler_get_handler,
+        .user_ctx = NULL,
+    },
+    {
+        .uri = ESP_OT_REST_API_DIAGNOSTICS_SCHEDULER_PATH,
+        .method = HTTP_PUT,
+        .handler = esp_otbr_network_diagnostics_scheduler_put_handler,
+        .user_ctx = NULL,
+    },
     {
         .uri = ESP_OT_REST_API_NODE_PATH,
         .method = HTTP_GET,
@@ -243,6 +337,124 @@ static httpd_uri_t s_resource_handlers[] = {
         .handler = esp_otbr_network_node_epskc_key_delete_handler,
         .user_ctx = NULL,
     },
+    {
+        .uri = ESP_OT_REST_API_BATCH_PATH,
+        .method = HTTP_POST,
+        .handler = esp_otbr_batch_post_handler,
+        .user_ctx = &s_server.data,
+    },
+    {
+        .uri = ESP_OT_REST_API_NODE_NETDATA_PATH,
+        .method = HTTP_POST,
+        .handler = esp_otbr_network_node_netdata_batch_post_handler,
+        .user_ctx = &s_server.data,
+    },
+#if CONFIG_OPENTHREAD_COMMISSION_JOB
+    {
+        .uri = ESP_OT_REST_API_NODE_COMMISSIONER_JOB_PATH,
+        .method = HTTP_GET,
+        .handler = esp_otbr_network_node_commissioner_job_get_handler,
+        .user_ctx = NULL,
+    },
+    {
+        .uri = ESP_OT_REST_API_NODE_COMMISSIONER_JOB_PATH,
+        .method = HTTP_POST,
+        .handler = esp_otbr_network_node_commissioner_job_post_handler,
+        .user_ctx = &s_server.data,
+    },
+    {
+        .uri = ESP_OT_REST_API_NODE_COMMISSIONER_JOB_PATH,
+        .method = HTTP_DELETE,
+        .handler = esp_otbr_network_node_commissioner_job_delete_handler,
+        .user_ctx = NULL,
+    },
+#endif
+    {
+        .uri = ESP_OT_REST_API_CHANNEL_SURVEY_PATH,
+        .method = HTTP_GET,
+        .handler = esp_otbr_channel_survey_get_handler,
+        .user_ctx = NULL,
+    },
+    {
+        .uri = ESP_OT_REST_API_CHANNEL_SURVEY_PATH,
+        .method = HTTP_POST,
+        .handler = esp_otbr_channel_survey_post_handler,
+        .user_ctx = NULL,
+    },
+    {
+        .uri = ESP_OT_REST_API_CHANNEL_SURVEY_CHANNEL_PATH,
+        .method = HTTP_PUT,
+        .handler = esp_otbr_channel_survey_channel_put_handler,
+        .user_ctx = NULL,
+    },
+#if CONFIG_OPENTHREAD_LINK_QUALITY_STORE
+    {
+        .uri = ESP_OT_REST_API_LINK_QUALITY_PATH,
+        .method = HTTP_GET,
+        .handler = esp_otbr_network_link_quality_get_handler,
+        .user_ctx = NULL,
+    },
+#endif
+#if CONFIG_OPENTHREAD_MAC_COUNTERS_STORE
+    {
+        .uri = ESP_OT_REST_API_DIAGNOSTICS_MAC_COUNTERS_PATH,
+        .method = HTTP_GET,
+        .handler = esp_otbr_network_mac_counters_get_handler,
+        .user_ctx = NULL,
+    },
+#endif
+#if CONFIG_OPENTHREAD_DNS_POOL
+    {
+        .uri = ESP_OT_REST_API_DNS_UPSTREAMS_PATH,
+        .method = HTTP_GET,
+        .handler = esp_otbr_dns_upstreams_get_handler,
+        .user_ctx = NULL,
+    },
+#endif
+#if CONFIG_OPENTHREAD_IP_STATS
+    {
+        .uri = ESP_OT_REST_API_IP_STATS_PATH,
+        .method = HTTP_GET,
+        .handler = esp_otbr_ip_stats_get_handler,
+        .user_ctx = NULL,
+    },
+#endif
+#if CONFIG_OPENTHREAD_BOOT_TIMELINE
+    {
+        .uri = ESP_OT_REST_API_DIAGNOSTICS_BOOT_PATH,
+        .method = HTTP_GET,
+        .handler = esp_otbr_boot_timeline_get_handler,
+        .user_ctx = NULL,
+    },
+#endif
+#if CONFIG_OPENTHREAD_CAPTURE
+    {
+        .uri = ESP_OT_REST_API_CAPTURE_PATH,
+        .method = HTTP_GET,
+        .handler = esp_otbr_capture_get_handler,
+        .user_ctx = NULL,
+    },
+#endif
+#if CONFIG_OPENTHREAD_COEX
+    {
+        .uri = ESP_OT_REST_API_COEX_PATH,
+        .method = HTTP_GET,
+        .handler = esp_otbr_coex_get_handler,
+        .user_ctx = NULL,
+    },
+    {
+        .uri = ESP_OT_REST_API_COEX_PATH,
+        .method = HTTP_PUT,
+        .handler = esp_otbr_coex_put_handler,
+        .user_ctx = &s_server.data,
+    },
+    {
+        .uri = ESP_OT_REST_API_COEX_MEASURE_PATH,
+        .method = HTTP_POST,
+        .handler = esp_otbr_coex_measure_post_handler,
+        .user_ctx = &s_server.data,
+    },
+#endif
 };
 
 /*-----------------------------------------------------
@@ -261,6 +473,7 @@ static esp_err_t esp_otbr_ping_post_handler(httpd_req_t *req);
 static esp_err_t esp_otbr_ipaddr_get_handler(httpd_req_t *req);
 static esp_err_t esp_otbr_add_ipaddr_post_handler(httpd_req_t *req);
 static esp_err_t esp_otbr_delete_ipaddr_post_handler(httpd_req_t *req);
+static esp_err_t esp_otbr_batch_ipaddr_post_handler(httpd_req_t *req);
 
 static httpd_uri_t s_web_gui_handlers[] = {
     {
@@ -341,6 +554,12 @@ static httpd_uri_t s_web_gui_handlers[] = {
         .handler = esp_otbr_delete_ipaddr_post_handler,
         .user_ctx = &s_server.data,
     },
+    {
+        .uri = ESP_OT_REST_API_BATCH_IPADDR_PATH,
+        .method = HTTP_POST,
+        .handler = esp_otbr_batch_ipaddr_post_handler,
+        .user_ctx = &s_server.data,
+    },
 };
 
 /*-----------------------------------------------------
@@ -376,12 +595,35 @@ static cJSON *resource_status(char *error, char *msg)
     return root;
 }
 
+#if CONFIG_OPENTHREAD_HEAP_DIAG_SCOPE
+static esp_err_t httpd_heap_scoped_handler(httpd_req_t *req)
+{
+    // The user_ctx of a scoped handler is the registered httpd_uri_t, restore the original one before handling.
+    const httpd_uri_t *uri = (const httpd_uri_t *)req->user_ctx;
+    esp_ot_heap_scope_t scope;
+
+    req->user_ctx = uri->user_ctx;
+    esp_ot_heap_scope_begin(&scope, uri->uri);
+    esp_err_t ret = uri->handler(req);
+    esp_ot_heap_scope_end(&scope);
+    return ret;
+}
+#endif // CONFIG_OPENTHREAD_HEAP_DIAG_SCOPE
+
 static esp_err_t httpd_server_register_http_uri(const http_server_t *server, httpd_uri_t *uris, uint8_t size)
 {
     ESP_RETURN_ON_FALSE((server->handle && uris), ESP_ERR_INVALID_ARG, WEB_TAG, "Invalid argument");
     for (int i = 0; i < size; i++) {
+#if CONFIG_OPENTHREAD_HEAP_DIAG_SCOPE
+        httpd_uri_t scoped = uris[i];
+        scoped.handler = httpd_heap_scoped_handler;
+        scoped.user_ctx = &uris[i];
+        ESP_RETURN_ON_ERROR(httpd_register_uri_handler(server->handle, &scoped), WEB_TAG,
+                            "Failed to register %s for %d", uris[i].uri, i);
+#else
         ESP_RETURN_ON_ERROR(httpd_register_uri_handler(server->handle, &uris[i]), WEB_TAG,
                             "Failed to register %s for %d", uris[i].uri, i);
+#endif
     }
     return ESP_OK;
 }
@@ -420,17 +662,202 @@ static cJSON *httpd_request_convert2_json(httpd_req_t *req, int type)
     return cJSON_Parse(buf);
 }
 
+/* The batch requests may be much larger than the scratch buffer, so the body is received into a dedicated buffer. */
+static char *httpd_request_recv_body(httpd_req_t *req, size_t max_size)
+{
+    size_t received = 0;
+    char *body = NULL;
+
+    ESP_RETURN_ON_FALSE(req->content_len > 0 && req->content_len < max_size, NULL, WEB_TAG, "Invalid content length");
+    body = malloc(req->content_len + 1);
+    ESP_RETURN_ON_FALSE(body, NULL, WEB_TAG, "Failed to allocate the body");
+    while (received < req->content_len) {
+        int len = httpd_req_recv(req, body + received, req->content_len - received);
+        if (len == HTTPD_SOCK_ERR_TIMEOUT) {
+            continue;
+        } else if (len <= 0) {
+            free(body);
+            return NULL;
+        }
+        received += len;
+    }
+    body[received] = '\0';
+    return body;
+}
+
+static bool httpd_req_accepts_cbor(httpd_req_t *req)
+{
+    char format[128];
+    return httpd_req_get_hdr_value_str(req, ESP_OT_REST_ACCEPT_HEADER, format, sizeof(format)) == ESP_OK &&
+        strstr(format, ESP_OT_REST_CONTENT_TYPE_CBOR) != NULL;
+}
+
+/* The writer of the chunked responses. With CONFIG_OPENTHREAD_BR_WEB_GZIP, the head of the body is held until it
+   reaches CONFIG_OPENTHREAD_BR_WEB_GZIP_MIN_SIZE, then the whole body is compressed if the client accepts gzip. A
+   shorter body is sent at once without the chunked encoding. */
+typedef struct httpd_chunk_writer {
+    httpd_req_t *req;
+#if CONFIG_OPENTHREAD_BR_WEB_GZIP
+    bool accept_gzip;
+    gzip_stream_t *gzip;
+    char *held;
+    size_t held_len;
+#endif
+} httpd_chunk_writer_t;
+
+#if CONFIG_OPENTHREAD_BR_WEB_GZIP
+static bool httpd_req_accepts_gzip(httpd_req_t *req)
+{
+    char encoding[128];
+    return httpd_req_get_hdr_value_str(req, "Accept-Encoding", encoding, sizeof(encoding)) == ESP_OK &&
+        strstr(encoding, "gzip") != NULL;
+}
+
+static esp_err_t httpd_gzip_output(void *context, const uint8_t *data, size_t len)
+{
+    return httpd_resp_send_chunk((httpd_req_t *)context, (const char *)data, len);
+}
+
+static esp_err_t httpd_chunk_writer_start_gzip(httpd_chunk_writer_t *writer)
+{
+    writer->gzip = gzip_stream_create(CONFIG_OPENTHREAD_BR_WEB_GZIP_WINDOW_BITS, SCRATCH_BUFSIZE, httpd_gzip_output,
+                                      writer->req);
+    if (writer->gzip == NULL) {
+        /* Fall back to the uncompressed response rather than failing the request on a low heap. */
+        ESP_LOGW(WEB_TAG, "Failed to create gzip stream, send the response uncompressed");
+        writer->accept_gzip = false;
+        return writer->held_len ? httpd_resp_send_chunk(writer->req, writer->held, writer->held_len) : ESP_OK;
+    }
+    ESP_RETURN_ON_ERROR(httpd_resp_set_hdr(writer->req, "Content-Encoding", "gzip"), WEB_TAG,
+                        "Failed to set header");
+    return gzip_stream_write(writer->gzip, writer->held, writer->held_len);
+}
+#endif
+
+static void httpd_chunk_writer_init(httpd_chunk_writer_t *writer, httpd_req_t *req)
+{
+    memset(writer, 0, sizeof(httpd_chunk_writer_t));
+    writer->req = req;
+#if CONFIG_OPENTHREAD_BR_WEB_GZIP
+    writer->accept_gzip = httpd_req_accepts_gzip(req);
+    httpd_resp_set_hdr(req, "Vary", "Accept-Encoding");
+#endif
+}
+
+static void httpd_chunk_writer_deinit(httpd_chunk_writer_t *writer)
+{
+#if CONFIG_OPENTHREAD_BR_WEB_GZIP
+    gzip_stream_destroy(writer->gzip);
+    free(writer->held);
+    memset(writer, 0, sizeof(httpd_chunk_writer_t));
+#endif
+}
+
+static esp_err_t httpd_chunk_writer_send(httpd_chunk_writer_t *writer, const char *data, size_t len)
+{
+#if CONFIG_OPENTHREAD_BR_WEB_GZIP
+    if (writer->gzip) {
+        return gzip_stream_write(writer->gzip, data, len);
+    }
+    if (writer->accept_gzip && writer->held_len + len < CONFIG_OPENTHREAD_BR_WEB_GZIP_MIN_SIZE) {
+        if (writer->held == NULL) {
+            writer->held = (char *)malloc(CONFIG_OPENTHREAD_BR_WEB_GZIP_MIN_SIZE);
+            ESP_RETURN_ON_FALSE(writer->held, ESP_ERR_NO_MEM, WEB_TAG, "Failed to allocate response buffer");
+        }
+        memcpy(writer->held + writer->held_len, data, len);
+        writer->held_len += len;
+        return ESP_OK;
+    }
+    if (writer->accept_gzip) {
+        ESP_RETURN_ON_ERROR(httpd_chunk_writer_start_gzip(writer), WEB_TAG, "Failed to start gzip response");
+        free(writer->held);
+        writer->held = NULL;
+        writer->held_len = 0;
+        if (writer->gzip) {
+            return gzip_stream_write(writer->gzip, data, len);
+        }
+    }
+#endif
+    return httpd_resp_send_chunk(writer->req, data, len);
+}
+
+static esp_err_t httpd_chunk_writer_sendstr(httpd_chunk_writer_t *writer, const char *str)
+{
+    return httpd_chunk_writer_send(writer, str, strlen(str));
+}
+
+static esp_err_t httpd_chunk_writer_end(httpd_chunk_writer_t *writer)
+{
+    esp_err_t ret = ESP_OK;
+#if CONFIG_OPENTHREAD_BR_WEB_GZIP
+    if (writer->gzip) {
+        ESP_GOTO_ON_ERROR(gzip_stream_finish(writer->gzip), exit, WEB_TAG, "Failed to finish gzip response");
+    } else if (writer->accept_gzip) {
+        /* The body stays below the threshold and nothing has been sent yet. */
+        ret = httpd_resp_send(writer->req, writer->held, writer->held_len);
+        goto exit;
+    }
+#endif
+    ret = httpd_resp_send_chunk(writer->req, NULL, 0);
+#if CONFIG_OPENTHREAD_BR_WEB_GZIP
+exit:
+#endif
+    httpd_chunk_writer_deinit(writer);
+    return ret;
+}
+
+/* Send a complete body, which is compressed like the chunked ones when it is large enough. */
+static esp_err_t httpd_send_body(httpd_req_t *req, const char *data, size_t len)
+{
+#if CONFIG_OPENTHREAD_BR_WEB_GZIP
+    if (len >= CONFIG_OPENTHREAD_BR_WEB_GZIP_MIN_SIZE && httpd_req_accepts_gzip(req)) {
+        httpd_chunk_writer_t writer;
+        httpd_chunk_writer_init(&writer, req);
+        esp_err_t ret = httpd_chunk_writer_send(&writer, data, len);
+        if (ret != ESP_OK) {
+            httpd_chunk_writer_deinit(&writer);
+            return ret;
+        }
+        return httpd_chunk_writer_end(&writer);
+    }
+#endif
+    return httpd_resp_send(req, data, len);
+}
+
+static esp_err_t httpd_send_cbor(httpd_req_t *req, const cbor_writer_t *writer)
+{
+    ESP_RETURN_ON_ERROR(writer->err, WEB_TAG, "Invalid CBOR packet");
+    ESP_RETURN_ON_ERROR(httpd_resp_set_type(req, ESP_OT_REST_CONTENT_TYPE_CBOR), WEB_TAG, "Failed to set http type");
+    return httpd_send_body(req, (const char *)writer->buf, writer->len);
+}
+
+static esp_err_t httpd_send_packet_cbor(httpd_req_t *req, const cJSON *root)
+{
+    esp_err_t ret = ESP_OK;
+    cbor_writer_t writer;
+    ESP_RETURN_ON_ERROR(cbor_writer_init(&writer, SCRATCH_BUFSIZE), WEB_TAG, "Failed to allocate CBOR buffer");
+    cbor_put_json(&writer, root);
+    ESP_GOTO_ON_ERROR(httpd_send_cbor(req, &writer), exit, WEB_TAG, "Failed to send http respond");
+exit:
+    cbor_writer_deinit(&writer);
+    return ret;
+}
+
 static esp_err_t httpd_send_packet(httpd_req_t *req, cJSON *root)
 {
     esp_err_t ret = ESP_OK;
     ESP_RETURN_ON_FALSE(root, ESP_FAIL, WEB_TAG, "Invalid Argument");
+    /* The responses without a dedicated encoder are converted from cJSON when the client accepts CBOR. */
+    if (httpd_req_accepts_cbor(req)) {
+        return httpd_send_packet_cbor(req, root);
+    }
     char *packet = cJSON_PrintUnformatted(root);
     ESP_RETURN_ON_FALSE(packet, ESP_FAIL, WEB_TAG, "Invalid Packet");
     ESP_LOGD(WEB_TAG, "Properties: %s\r\n", packet);
     ESP_RETURN_ON_FALSE(packet, ESP_FAIL, WEB_TAG, "Invalid Pesponse");
     ESP_GOTO_ON_ERROR(httpd_resp_set_type(req, ESP_OT_REST_CONTENT_TYPE_JSON), exit, WEB_TAG,
                       "Failed to set http type");
-    ESP_GOTO_ON_ERROR(httpd_resp_sendstr(req, packet), exit, WEB_TAG, "Failed to send http respond");
+    ESP_GOTO_ON_ERROR(httpd_send_body(req, packet, strlen(packet)), exit, WEB_TAG, "Failed to send http respond");
 exit:
     cJSON_free(packet);
     return ret;
@@ -464,19 +891,193 @@ exit:
  *      -   ESP_ERR_HTTPD_INVALID_REQ   : Invalid request
  */
 
+static void url_decode_commas(char *value)
+{
+    /* The query value is not URL-decoded, restore the encoded commas. */
+    for (char *pos = strstr(value, "%2"); pos; pos = strstr(pos + 1, "%2")) {
+        if (pos[2] == 'C' || pos[2] == 'c') {
+            *pos = ',';
+            memmove(pos + 1, pos + 3, strlen(pos + 3) + 1);
+        }
+    }
+}
+
+static esp_err_t diagnostics_target_parse(char *value, thread_diagnostic_query_t *diag_query)
+{
+    char *save = NULL;
+    char *end = NULL;
+
+    if (!strcmp(value, "multicast")) {
+        diag_query->target = DIAGNOSTIC_TARGET_MULTICAST;
+        return ESP_OK;
+    }
+    if (!strcmp(value, "routers")) {
+        diag_query->target = DIAGNOSTIC_TARGET_ROUTERS;
+        return ESP_OK;
+    }
+    diag_query->target = DIAGNOSTIC_TARGET_LIST;
+    diag_query->target_count = 0;
+    for (char *rloc16 = strtok_r(value, ",", &save); rloc16; rloc16 = strtok_r(NULL, ",", &save)) {
+        long number = strtol(rloc16, &end, 16);
+        ESP_RETURN_ON_FALSE(*end == '\0' && number >= 0 && number < OT_RADIO_INVALID_SHORT_ADDR, ESP_ERR_INVALID_ARG,
+                            WEB_TAG, "Invalid RLOC16: %s", rloc16);
+        // A repeated RLOC16 is queried once, each target must be a different node to complete the collection.
+        bool repeated = false;
+        for (uint8_t i = 0; i < diag_query->target_count && !repeated; i++) {
+            repeated = diag_query->targets[i] == (uint16_t)number;
+        }
+        if (repeated) {
+            continue;
+        }
+        ESP_RETURN_ON_FALSE(diag_query->target_count < DIAGNOSTIC_QUERY_MAX_TARGETS, ESP_ERR_INVALID_SIZE, WEB_TAG,
+                            "Too many targets");
+        diag_query->targets[diag_query->target_count++] = (uint16_t)number;
+    }
+    ESP_RETURN_ON_FALSE(diag_query->target_count, ESP_ERR_INVALID_ARG, WEB_TAG, "No target");
+    return ESP_OK;
+}
+
+static esp_err_t diagnostics_query_parse(const char *query, thread_diagnostic_query_t *diag_query)
+{
+    char value[DIAGNOSTICS_QUERY_MAX_SIZE];
+    char *end = NULL;
+    long number = 0;
+
+    if (httpd_query_key_value(query, "limit", value, sizeof(value)) == ESP_OK) {
+        number = strtol(value, &end, 10);
+        ESP_RETURN_ON_FALSE(*end == '\0' && number > 0 && number <= UINT16_MAX, ESP_ERR_INVALID_ARG, WEB_TAG,
+                            "Invalid limit: %s", value);
+        diag_query->limit = (uint16_t)number;
+    }
+    if (httpd_query_key_value(query, "cursor", value, sizeof(value)) == ESP_OK) {
+        number = strtol(value, &end, 0);
+        ESP_RETURN_ON_FALSE(*end == '\0' && number >= 0 && number <= UINT16_MAX, ESP_ERR_INVALID_ARG, WEB_TAG,
+                            "Invalid cursor: %s", value);
+        diag_query->cursor = (int32_t)number;
+    }
+    if (httpd_query_key_value(query, "tlvs", value, sizeof(value)) == ESP_OK) {
+        url_decode_commas(value);
+        ESP_RETURN_ON_ERROR(diagnosticTlv_names_convert2_mask(value, &diag_query->tlv_mask), WEB_TAG,
+                            "Invalid tlvs");
+    }
+    if (httpd_query_key_value(query, "role", value, sizeof(value)) == ESP_OK) {
+        if (!strcmp(value, "leader")) {
+            diag_query->role = OT_DEVICE_ROLE_LEADER;
+        } else if (!strcmp(value, "router")) {
+            diag_query->role = OT_DEVICE_ROLE_ROUTER;
+        } else {
+            ESP_LOGE(WEB_TAG, "Invalid role: %s", value);
+            return ESP_ERR_INVALID_ARG;
+        }
+    }
+    if (httpd_query_key_value(query, "hasChildren", value, sizeof(value)) == ESP_OK) {
+        ESP_RETURN_ON_FALSE(!strcmp(value, "true") || !strcmp(value, "false"), ESP_ERR_INVALID_ARG, WEB_TAG,
+                            "Invalid hasChildren: %s", value);
+        diag_query->has_children = !strcmp(value, "true");
+    }
+    if (httpd_query_key_value(query, "lqBelow", value, sizeof(value)) == ESP_OK) {
+        number = strtol(value, &end, 10);
+        ESP_RETURN_ON_FALSE(*end == '\0' && number >= 1 && number <= 3, ESP_ERR_INVALID_ARG, WEB_TAG,
+                            "Invalid lqBelow: %s", value);
+        diag_query->lq_below = (uint8_t)number;
+    }
+    if (httpd_query_key_value(query, "target", value, sizeof(value)) == ESP_OK) {
+        url_decode_commas(value);
+        ESP_RETURN_ON_ERROR(diagnostics_target_parse(value, diag_query), WEB_TAG, "Invalid target");
+    }
+    if (httpd_query_key_value(query, "timeout", value, sizeof(value)) == ESP_OK) {
+        number = strtol(value, &end, 10);
+        ESP_RETURN_ON_FALSE(*end == '\0' && number >= DIAGNOSTICS_TIMEOUT_MIN_MS &&
+                                number <= DIAGNOSTICS_TIMEOUT_MAX_MS,
+                            ESP_ERR_INVALID_ARG, WEB_TAG, "Invalid timeout: %s", value);
+        diag_query->timeout_ms = (uint16_t)number;
+    }
+    if (httpd_query_key_value(query, "quiet", value, sizeof(value)) == ESP_OK) {
+        number = strtol(value, &end, 10);
+        ESP_RETURN_ON_FALSE(*end == '\0' && number >= DIAGNOSTICS_QUIET_MIN_MS && number <= DIAGNOSTICS_QUIET_MAX_MS,
+                            ESP_ERR_INVALID_ARG, WEB_TAG, "Invalid quiet: %s", value);
+        diag_query->quiet_ms = (uint16_t)number;
+    }
+    return ESP_OK;
+}
+
+static esp_err_t esp_otbr_network_diagnostics_cbor_get_handler(httpd_req_t *req,
+                                                              const thread_diagnostic_query_t *diag_query)
+{
+    esp_err_t ret = ESP_OK;
+    char next[RLOC_STRING_MAX_SIZE];
+    int32_t next_cursor = DIAGNOSTIC_QUERY_NO_CURSOR;
+    cbor_writer_t writer;
+
+    ESP_RETURN_ON_ERROR(cbor_writer_init(&writer, SCRATCH_BUFSIZE), WEB_TAG, "Failed to allocate CBOR buffer");
+    ESP_GOTO_ON_ERROR(handle_ot_resource_network_diagnostics_cbor_request(diag_query, &next_cursor, &writer), exit,
+                      WEB_TAG, "Failed to handle openthread diagnostics request");
+    if (next_cursor != DIAGNOSTIC_QUERY_NO_CURSOR) {
+        snprintf(next, sizeof(next), "0x%04x", (uint16_t)next_cursor);
+        ESP_GOTO_ON_ERROR(httpd_resp_set_hdr(req, "X-Next-Cursor", next), exit, WEB_TAG, "Failed to set header");
+    }
+    ESP_GOTO_ON_ERROR(httpd_send_cbor(req, &writer), exit, WEB_TAG, "Failed to response %s", req->uri);
+exit:
+    cbor_writer_deinit(&writer);
+    return ret;
+}
+
 static esp_err_t esp_otbr_network_diagnostics_get_handler(httpd_req_t *req)
 {
     ESP_RETURN_ON_FALSE(req, ESP_FAIL, WEB_TAG, "Failed to parse the diagnostics of http request");
     esp_err_t ret = ESP_OK;
-    cJSON *response = handle_ot_resource_network_diagnostics_request();
+    char query[DIAGNOSTICS_QUERY_MAX_SIZE];
+#if CONFIG_OPENTHREAD_BR_WEB_DIAG_BENCHMARK
+    char value[8];
+#endif
+    char next[RLOC_STRING_MAX_SIZE];
+    thread_diagnostic_query_t diag_query;
+    thread_diagnostic_query_t *query_ptr = NULL;
+    int32_t next_cursor = DIAGNOSTIC_QUERY_NO_CURSOR;
+    cJSON *response = NULL;
+    httpd_chunk_writer_t writer;
+
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK) {
+        thread_diagnostic_query_reset(&diag_query);
+        if (diagnostics_query_parse(query, &diag_query) != ESP_OK) {
+            httpd_resp_set_status(req, HTTPD_400);
+            return httpd_resp_send(req, NULL, 0);
+        }
+        query_ptr = &diag_query;
+#if CONFIG_OPENTHREAD_BR_WEB_DIAG_BENCHMARK
+        /* The benchmark keeps the httpd task busy for the rounds of every encoding, so it is for development only. */
+        if (httpd_query_key_value(query, "benchmark", value, sizeof(value)) == ESP_OK && !strcmp(value, "true")) {
+            response = handle_ot_resource_network_diagnostics_benchmark_request(query_ptr);
+            ESP_RETURN_ON_FALSE(response, ESP_FAIL, WEB_TAG, "Failed to benchmark openthread diagnostics");
+            ret = httpd_send_packet(req, response);
+            cJSON_Delete(response);
+            return ret;
+        }
+#endif
+    }
+    if (httpd_req_accepts_cbor(req)) {
+        return esp_otbr_network_diagnostics_cbor_get_handler(req, query_ptr);
+    }
+    if (query_ptr) {
+        response = handle_ot_resource_network_diagnostics_query_request(query_ptr, &next_cursor);
+    } else {
+        response = handle_ot_resource_network_diagnostics_request();
+    }
     ESP_RETURN_ON_FALSE(response, ESP_FAIL, WEB_TAG, "Failed to handle openthread diagnostics request");
+    httpd_chunk_writer_init(&writer, req);
+
+    /* The cursor of the next page is returned in a header, so that the body stays an array of nodes. */
+    if (next_cursor != DIAGNOSTIC_QUERY_NO_CURSOR) {
+        snprintf(next, sizeof(next), "0x%04x", (uint16_t)next_cursor);
+        ESP_GOTO_ON_ERROR(httpd_resp_set_hdr(req, "X-Next-Cursor", next), exit, WEB_TAG, "Failed to set header");
+    }
 
     /* Stream the JSON array in chunks to avoid allocating the entire
        serialized string in RAM at once (can be 30-50KB for large networks). */
     ESP_GOTO_ON_ERROR(httpd_resp_set_type(req, "application/json"), exit, WEB_TAG, "Failed to set content type");
 
     int array_size = cJSON_GetArraySize(response);
-    ESP_GOTO_ON_ERROR(httpd_resp_sendstr_chunk(req, "["), exit, WEB_TAG, "Failed to send chunk");
+    ESP_GOTO_ON_ERROR(httpd_chunk_writer_sendstr(&writer, "["), exit, WEB_TAG, "Failed to send chunk");
 
     for (int i = 0; i < array_size; i++) {
         cJSON *detached = cJSON_DetachItemFromArray(response, 0);
@@ -484,58 +1085,166 @@ static esp_err_t esp_otbr_network_diagnostics_get_handler(httpd_req_t *req)
         cJSON_Delete(detached);
         if (chunk) {
             if (i > 0) {
-                ESP_GOTO_ON_ERROR(httpd_resp_sendstr_chunk(req, ","), exit, WEB_TAG, "Failed to send chunk");
+                ESP_GOTO_ON_ERROR(httpd_chunk_writer_sendstr(&writer, ","), exit, WEB_TAG, "Failed to send chunk");
             }
-            esp_err_t send_err = httpd_resp_sendstr_chunk(req, chunk);
+            esp_err_t send_err = httpd_chunk_writer_sendstr(&writer, chunk);
             cJSON_free(chunk);
             ESP_GOTO_ON_ERROR(send_err, exit, WEB_TAG, "Failed to send chunk");
         }
     }
 
-    ESP_GOTO_ON_ERROR(httpd_resp_sendstr_chunk(req, "]"), exit, WEB_TAG, "Failed to send chunk");
+    ESP_GOTO_ON_ERROR(httpd_chunk_writer_sendstr(&writer, "]"), exit, WEB_TAG, "Failed to send chunk");
     /* Signal end of chunked response */
-    httpd_resp_sendstr_chunk(req, NULL);
+    ret = httpd_chunk_writer_end(&writer);
 
 exit:
+    httpd_chunk_writer_deinit(&writer);
     cJSON_Delete(response);
     return ret;
 }
 
-static esp_err_t esp_otbr_network_node_get_handler(httpd_req_t *req)
+static esp_err_t esp_otbr_network_diagnostics_delta_get_handler(httpd_req_t *req)
 {
-    ESP_RETURN_ON_FALSE(req, ESP_FAIL, WEB_TAG, "Failed to parse the node information of http request");
+    ESP_RETURN_ON_FALSE(req, ESP_FAIL, WEB_TAG, "Failed to parse the diagnostics delta of http request");
     esp_err_t ret = ESP_OK;
-    cJSON *response = handle_ot_resource_node_information_request();
-    ESP_RETURN_ON_FALSE(response, ESP_FAIL, WEB_TAG, "Failed to handle openthread diagnostics request");
-    ESP_GOTO_ON_ERROR(httpd_send_packet(req, response), exit, WEB_TAG, "Failed to response %s", req->uri);
-exit:
+    char query[DIAGNOSTICS_QUERY_MAX_SIZE];
+    char value[12];
+    char *end = NULL;
+    uint32_t since = 0;
+    bool not_modified = false;
+
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK &&
+        httpd_query_key_value(query, "since", value, sizeof(value)) == ESP_OK) {
+        unsigned long version = strtoul(value, &end, 10);
+        if (value[0] == '\0' || *end != '\0' || version > UINT32_MAX) {
+            httpd_resp_set_status(req, HTTPD_400);
+            return httpd_resp_send(req, NULL, 0);
+        }
+        since = (uint32_t)version;
+    }
+    cJSON *response = handle_ot_resource_network_diagnostics_delta_request(since, &not_modified);
+    if (not_modified) {
+        httpd_resp_set_status(req, HTTPD_304);
+        return httpd_resp_send(req, NULL, 0);
+    }
+    ESP_RETURN_ON_FALSE(response, ESP_FAIL, WEB_TAG, "Failed to handle openthread diagnostics delta request");
+    ret = httpd_send_packet(req, response);
     cJSON_Delete(response);
     return ret;
 }
 
-static esp_err_t esp_otbr_network_node_delete_handler(httpd_req_t *req)
+static esp_err_t esp_otbr_network_diagnostics_scheduler_get_handler(httpd_req_t *req)
 {
-    ESP_RETURN_ON_FALSE(req, ESP_FAIL, WEB_TAG, "Failed to parse the node information of http request");
+    ESP_RETURN_ON_FALSE(req, ESP_FAIL, WEB_TAG, "Failed to parse the diagnostics scheduler of http request");
     esp_err_t ret = ESP_OK;
-    otError error = handle_ot_resource_node_delete_information_request();
-    if (error == OT_ERROR_NONE) {
-        httpd_resp_set_status(req, HTTPD_200);
-    } else if (error == OT_ERROR_INVALID_STATE) {
-        httpd_resp_set_status(req, HTTPD_409);
-    } else {
-        httpd_resp_set_status(req, HTTPD_500);
-    }
-    ESP_GOTO_ON_ERROR(httpd_resp_send(req, NULL, 0), exit, WEB_TAG, "Failed to response %s", req->uri);
-exit:
+    cJSON *response = handle_ot_resource_network_diagnostics_scheduler_request();
+    ESP_RETURN_ON_FALSE(response, ESP_FAIL, WEB_TAG, "Failed to handle openthread diagnostics scheduler request");
+    ret = httpd_send_packet(req, response);
+    cJSON_Delete(response);
     return ret;
 }
 
-static esp_err_t esp_otbr_network_node_rloc_get_handler(httpd_req_t *req)
+static esp_err_t esp_otbr_network_diagnostics_scheduler_put_handler(httpd_req_t *req)
 {
     esp_err_t ret = ESP_OK;
-    cJSON *response = handle_ot_resource_node_rloc_request();
-    ESP_GOTO_ON_ERROR(httpd_send_packet(req, response), exit, WEB_TAG, "Failed to response %s", req->uri);
-exit:
+    otError err = OT_ERROR_NONE;
+    cJSON *request = httpd_request_convert2_json(req, cJSON_Object);
+    if (cJSON_IsObject(request)) {
+        err = handle_ot_resource_network_diagnostics_scheduler_put_request(request);
+    } else {
+        ESP_LOGE(WEB_TAG, "Invalid args");
+        err = OT_ERROR_INVALID_ARGS;
+    }
+
+    char http_return_status[64];
+    if (convert_ot_err_to_response_code(err, http_return_status) != ESP_OK) {
+        strcpy(http_return_status, HTTPD_500);
+    }
+    httpd_resp_set_status(req, http_return_status);
+    ESP_GOTO_ON_ERROR(httpd_resp_send(req, NULL, 0), exit, WEB_TAG, "Failed to response %s", req->uri);
+exit:
+    cJSON_Delete(request);
+    return ret;
+}
+
+static esp_err_t esp_otbr_network_node_fields_get_handler(httpd_req_t *req, const char *fields)
+{
+    esp_err_t ret = ESP_OK;
+    cJSON *log = cJSON_CreateObject();
+    uint16_t errcode = 0;
+    cJSON *response = handle_ot_resource_node_fields_request(fields, log);
+    cJSON *value = cJSON_GetObjectItemCaseSensitive(log, "ErrorCode");
+    if (cJSON_IsNumber(value)) {
+        errcode = (uint16_t)cJSON_GetNumberValue(value);
+    }
+
+    char http_return_status[64];
+    ot_br_web_response_code_get(errcode, http_return_status);
+    httpd_resp_set_status(req, http_return_status);
+    if (response) {
+        ESP_GOTO_ON_ERROR(httpd_send_packet(req, response), exit, WEB_TAG, "Failed to response %s", req->uri);
+    } else {
+        ESP_GOTO_ON_ERROR(httpd_resp_send(req, NULL, 0), exit, WEB_TAG, "Failed to response %s", req->uri);
+    }
+exit:
+    cJSON_Delete(response);
+    cJSON_Delete(log);
+    return ret;
+}
+
+static esp_err_t esp_otbr_network_node_get_handler(httpd_req_t *req)
+{
+    ESP_RETURN_ON_FALSE(req, ESP_FAIL, WEB_TAG, "Failed to parse the node information of http request");
+    esp_err_t ret = ESP_OK;
+    char query[NODE_FIELDS_QUERY_MAX_SIZE];
+    char fields[NODE_FIELDS_QUERY_MAX_SIZE];
+
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK &&
+        httpd_query_key_value(query, "fields", fields, sizeof(fields)) == ESP_OK) {
+        url_decode_commas(fields);
+        return esp_otbr_network_node_fields_get_handler(req, fields);
+    }
+    if (httpd_req_accepts_cbor(req)) {
+        thread_node_information_t node;
+        cbor_writer_t writer;
+        handle_ot_resource_node_information_struct_request(&node);
+        ESP_RETURN_ON_ERROR(cbor_writer_init(&writer, SCRATCH_BUFSIZE), WEB_TAG, "Failed to allocate CBOR buffer");
+        thread_node_struct_convert2_cbor(&writer, &node);
+        ret = httpd_send_cbor(req, &writer);
+        cbor_writer_deinit(&writer);
+        return ret;
+    }
+    cJSON *response = handle_ot_resource_node_information_request();
+    ESP_RETURN_ON_FALSE(response, ESP_FAIL, WEB_TAG, "Failed to handle openthread diagnostics request");
+    ESP_GOTO_ON_ERROR(httpd_send_packet(req, response), exit, WEB_TAG, "Failed to response %s", req->uri);
+exit:
+    cJSON_Delete(response);
+    return ret;
+}
+
+static esp_err_t esp_otbr_network_node_delete_handler(httpd_req_t *req)
+{
+    ESP_RETURN_ON_FALSE(req, ESP_FAIL, WEB_TAG, "Failed to parse the node information of http request");
+    esp_err_t ret = ESP_OK;
+    otError error = handle_ot_resource_node_delete_information_request();
+    if (error == OT_ERROR_NONE) {
+        httpd_resp_set_status(req, HTTPD_200);
+    } else if (error == OT_ERROR_INVALID_STATE) {
+        httpd_resp_set_status(req, HTTPD_409);
+    } else {
+        httpd_resp_set_status(req, HTTPD_500);
+    }
+    ESP_GOTO_ON_ERROR(httpd_resp_send(req, NULL, 0), exit, WEB_TAG, "Failed to response %s", req->uri);
+exit:
+    return ret;
+}
+
+static esp_err_t esp_otbr_network_node_rloc_get_handler(httpd_req_t *req)
+{
+    esp_err_t ret = ESP_OK;
+    cJSON *response = handle_ot_resource_node_rloc_request();
+    ESP_GOTO_ON_ERROR(httpd_send_packet(req, response), exit, WEB_TAG, "Failed to response %s", req->uri);
+exit:
     cJSON_Delete(response);
     return ret;
 }
@@ -653,6 +1362,29 @@ static esp_err_t esp_otbr_network_node_dataset_pending_handler(httpd_req_t *req)
     return esp_otbr_network_node_dataset_handler(req, ESP_OT_DATASET_TYPE_PENDING);
 }
 
+static esp_err_t esp_otbr_network_node_dataset_cbor_get_handler(httpd_req_t *req, const char *dataset_type)
+{
+    esp_err_t ret = ESP_OK;
+    otOperationalDataset dataset;
+    cbor_writer_t writer;
+
+    /* Same as the JSON response, an absent dataset is responded with 204. */
+    if (handle_ot_resource_node_dataset_struct_request(dataset_type, &dataset) != OT_ERROR_NONE) {
+        httpd_resp_set_status(req, HTTPD_204);
+        return httpd_resp_send(req, NULL, 0);
+    }
+    ESP_RETURN_ON_ERROR(cbor_writer_init(&writer, SCRATCH_BUFSIZE), WEB_TAG, "Failed to allocate CBOR buffer");
+    if (strcmp(dataset_type, ESP_OT_DATASET_TYPE_PENDING) == 0) {
+        PendingDataset2Cbor(&writer, &dataset);
+    } else {
+        ActiveDataset2Cbor(&writer, &dataset);
+    }
+    ESP_GOTO_ON_ERROR(httpd_send_cbor(req, &writer), exit, WEB_TAG, "Failed to response %s", req->uri);
+exit:
+    cbor_writer_deinit(&writer);
+    return ret;
+}
+
 static esp_err_t esp_otbr_network_node_dataset_handler(httpd_req_t *req, const char *dataset_type)
 {
     esp_err_t ret = ESP_OK;
@@ -663,7 +1395,11 @@ static esp_err_t esp_otbr_network_node_dataset_handler(httpd_req_t *req, const c
     char format[256];
     uint16_t errcode = 0;
 
-    if (req->method == HTTP_GET) {
+    if (req->method == HTTP_GET && httpd_req_accepts_cbor(req)) {
+        cJSON_Delete(request);
+        cJSON_Delete(log);
+        return esp_otbr_network_node_dataset_cbor_get_handler(req, dataset_type);
+    } else if (req->method == HTTP_GET) {
         if (httpd_req_get_hdr_value_str(req, ESP_OT_REST_ACCEPT_HEADER, format, sizeof(format)) == ESP_OK &&
             strcmp(format, ESP_OT_REST_CONTENT_TYPE_PLAIN) == 0) {
             cJSON_AddItemToObject(request, ESP_OT_REST_ACCEPT_HEADER,
@@ -817,6 +1553,466 @@ exit:
     return ret;
 }
 
+static esp_err_t esp_otbr_batch_post_handler(httpd_req_t *req)
+{
+    esp_err_t ret = ESP_OK;
+    cJSON *response = NULL;
+    cJSON *log = cJSON_CreateObject();
+    uint16_t errcode = 400;
+    cJSON *request = httpd_request_convert2_json(req, cJSON_Object);
+
+    if (cJSON_IsObject(request)) {
+        response = handle_ot_resource_batch_request(request, log);
+        cJSON *value = cJSON_GetObjectItemCaseSensitive(log, "ErrorCode");
+        if (cJSON_IsNumber(value)) {
+            errcode = (uint16_t)cJSON_GetNumberValue(value);
+        }
+    }
+
+    char http_return_status[64];
+    ot_br_web_response_code_get(errcode, http_return_status);
+    httpd_resp_set_status(req, http_return_status);
+    if (response) {
+        ESP_GOTO_ON_ERROR(httpd_send_packet(req, response), exit, WEB_TAG, "Failed to response %s", req->uri);
+    } else {
+        ESP_GOTO_ON_ERROR(httpd_resp_send(req, NULL, 0), exit, WEB_TAG, "Failed to response %s", req->uri);
+    }
+exit:
+    cJSON_Delete(request);
+    cJSON_Delete(response);
+    cJSON_Delete(log);
+    return ret;
+}
+
+static esp_err_t esp_otbr_network_node_netdata_batch_post_handler(httpd_req_t *req)
+{
+    esp_err_t ret = ESP_OK;
+    cJSON *request = NULL;
+    cJSON *response = NULL;
+    cJSON *log = cJSON_CreateObject();
+    char *body = httpd_request_recv_body(req, NETDATA_BATCH_BODY_MAX_SIZE);
+    uint16_t errcode = 0;
+
+    request = body ? cJSON_Parse(body) : NULL;
+    if (cJSON_IsObject(request)) {
+        response = handle_ot_resource_node_netdata_batch_request(request, log);
+        cJSON *value = cJSON_GetObjectItemCaseSensitive(log, "ErrorCode");
+        if (cJSON_IsNumber(value)) {
+            errcode = (uint16_t)cJSON_GetNumberValue(value);
+        }
+    } else {
+        errcode = 400;
+    }
+
+    char http_return_status[64];
+    ot_br_web_response_code_get(errcode, http_return_status);
+    httpd_resp_set_status(req, http_return_status);
+    if (response) {
+        ESP_GOTO_ON_ERROR(httpd_send_packet(req, response), exit, WEB_TAG, "Failed to response %s", req->uri);
+    } else {
+        ESP_GOTO_ON_ERROR(httpd_resp_send(req, NULL, 0), exit, WEB_TAG, "Failed to response %s", req->uri);
+    }
+exit:
+    free(body);
+    cJSON_Delete(request);
+    cJSON_Delete(response);
+    cJSON_Delete(log);
+    return ret;
+}
+
+#if CONFIG_OPENTHREAD_COMMISSION_JOB
+static esp_err_t esp_otbr_network_node_commissioner_job_get_handler(httpd_req_t *req)
+{
+    esp_err_t ret = ESP_OK;
+    cJSON *response = handle_ot_resource_node_commissioner_job_get_request();
+    ESP_GOTO_ON_ERROR(httpd_send_packet(req, response), exit, WEB_TAG, "Failed to response %s", req->uri);
+exit:
+    cJSON_Delete(response);
+    return ret;
+}
+
+static esp_err_t esp_otbr_network_node_commissioner_job_post_handler(httpd_req_t *req)
+{
+    esp_err_t ret = ESP_OK;
+    cJSON *request = NULL;
+    cJSON *response = NULL;
+    cJSON *log = cJSON_CreateObject();
+    char *body = httpd_request_recv_body(req, COMMISSIONER_JOB_BODY_MAX_SIZE);
+    char format[32];
+    char query[64];
+    char value[16];
+    uint16_t errcode = 0;
+
+    bool is_csv = httpd_req_get_hdr_value_str(req, ESP_OT_REST_CONTENT_TYPE_HEADER, format, sizeof(format)) == ESP_OK &&
+        (strncmp(format, ESP_OT_REST_CONTENT_TYPE_CSV, strlen(ESP_OT_REST_CONTENT_TYPE_CSV)) == 0 ||
+         strncmp(format, ESP_OT_REST_CONTENT_TYPE_PLAIN, strlen(ESP_OT_REST_CONTENT_TYPE_PLAIN)) == 0);
+
+    if (body == NULL) {
+        errcode = 400;
+    } else if (is_csv) {
+        /* The job parameters of a CSV body are passed in the query string. */
+        request = cJSON_CreateObject();
+        if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK) {
+            if (httpd_query_key_value(query, "timeout", value, sizeof(value)) == ESP_OK) {
+                cJSON_AddNumberToObject(request, "timeout", strtod(value, NULL));
+            }
+            if (httpd_query_key_value(query, "retries", value, sizeof(value)) == ESP_OK) {
+                cJSON_AddNumberToObject(request, "retries", strtod(value, NULL));
+            }
+        }
+        response = handle_ot_resource_node_commissioner_job_post_request(request, body, log);
+    } else {
+        request = cJSON_Parse(body);
+        if (cJSON_IsObject(request)) {
+            response = handle_ot_resource_node_commissioner_job_post_request(request, NULL, log);
+        } else {
+            errcode = 400;
+        }
+    }
+
+    cJSON *code = cJSON_GetObjectItemCaseSensitive(log, "ErrorCode");
+    if (cJSON_IsNumber(code)) {
+        errcode = (uint16_t)cJSON_GetNumberValue(code);
+    }
+
+    char http_return_status[64];
+    ot_br_web_response_code_get(errcode, http_return_status);
+    httpd_resp_set_status(req, http_return_status);
+    if (response) {
+        ESP_GOTO_ON_ERROR(httpd_send_packet(req, response), exit, WEB_TAG, "Failed to response %s", req->uri);
+    } else {
+        ESP_GOTO_ON_ERROR(httpd_resp_send(req, NULL, 0), exit, WEB_TAG, "Failed to response %s", req->uri);
+    }
+exit:
+    free(body);
+    cJSON_Delete(request);
+    cJSON_Delete(response);
+    cJSON_Delete(log);
+    return ret;
+}
+
+static esp_err_t esp_otbr_network_node_commissioner_job_delete_handler(httpd_req_t *req)
+{
+    esp_err_t ret = ESP_OK;
+    handle_ot_resource_node_commissioner_job_delete_request();
+    httpd_resp_set_status(req, HTTPD_200);
+    ESP_GOTO_ON_ERROR(httpd_resp_send(req, NULL, 0), exit, WEB_TAG, "Failed to response %s", req->uri);
+exit:
+    return ret;
+}
+#endif // CONFIG_OPENTHREAD_COMMISSION_JOB
+
+static esp_err_t query_number_parse(const char *query, const char *key, long min, long max, long *number)
+{
+    char value[12];
+    char *end = NULL;
+
+    if (httpd_query_key_value(query, key, value, sizeof(value)) != ESP_OK) {
+        return ESP_OK;
+    }
+    *number = strtol(value, &end, strcmp(key, "node") == 0 ? 16 : 10);
+    ESP_RETURN_ON_FALSE(value[0] != '\0' && *end == '\0' && *number >= min && *number <= max, ESP_ERR_INVALID_ARG,
+                        WEB_TAG, "Invalid %s: %s", key, value);
+    return ESP_OK;
+}
+
+static esp_err_t esp_otbr_channel_survey_get_handler(httpd_req_t *req)
+{
+    esp_err_t ret = ESP_OK;
+    cJSON *response = handle_ot_resource_channel_survey_request();
+    if (!response) {
+        httpd_resp_set_status(req, HTTPD_404);
+        return httpd_resp_send(req, NULL, 0);
+    }
+    ret = httpd_send_packet(req, response);
+    cJSON_Delete(response);
+    return ret;
+}
+
+static esp_err_t esp_otbr_channel_survey_post_handler(httpd_req_t *req)
+{
+    char query[CHANNEL_SURVEY_QUERY_MAX_SIZE];
+    char http_return_status[64];
+    long duration = CHANNEL_SURVEY_DEFAULT_DURATION_MS;
+    long scan = CHANNEL_SURVEY_DEFAULT_SCAN_MS;
+    otError err = OT_ERROR_NONE;
+
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK &&
+        (query_number_parse(query, "duration", 0, CHANNEL_SURVEY_MAX_DURATION_MS, &duration) != ESP_OK ||
+         query_number_parse(query, "scan", CHANNEL_SURVEY_MIN_SCAN_MS, CHANNEL_SURVEY_MAX_SCAN_MS, &scan) != ESP_OK)) {
+        err = OT_ERROR_INVALID_ARGS;
+    } else {
+        err = handle_ot_resource_channel_survey_post_request(duration, scan);
+    }
+    if (err == OT_ERROR_NONE) {
+        return esp_otbr_channel_survey_get_handler(req);
+    }
+    if (convert_ot_err_to_response_code(err, http_return_status) != ESP_OK) {
+        strcpy(http_return_status, HTTPD_500);
+    }
+    httpd_resp_set_status(req, http_return_status);
+    return httpd_resp_send(req, NULL, 0);
+}
+
+static esp_err_t esp_otbr_channel_survey_channel_put_handler(httpd_req_t *req)
+{
+    esp_err_t ret = ESP_OK;
+    otError err = OT_ERROR_NONE;
+    cJSON *request = httpd_request_convert2_json(req, cJSON_Object);
+    if (cJSON_IsObject(request)) {
+        err = handle_ot_resource_channel_survey_put_request(request);
+    } else {
+        ESP_LOGE(WEB_TAG, "Invalid args");
+        err = OT_ERROR_INVALID_ARGS;
+    }
+
+    char http_return_status[64];
+    if (convert_ot_err_to_response_code(err, http_return_status) != ESP_OK) {
+        strcpy(http_return_status, HTTPD_500);
+    }
+    httpd_resp_set_status(req, http_return_status);
+    ESP_GOTO_ON_ERROR(httpd_resp_send(req, NULL, 0), exit, WEB_TAG, "Failed to response %s", req->uri);
+exit:
+    cJSON_Delete(request);
+    return ret;
+}
+
+#if CONFIG_OPENTHREAD_LINK_QUALITY_STORE
+static esp_err_t esp_otbr_network_link_quality_get_handler(httpd_req_t *req)
+{
+    esp_err_t ret = ESP_OK;
+    char query[DIAGNOSTICS_QUERY_MAX_SIZE];
+    long from = -LINK_QUALITY_DEFAULT_RANGE_S;
+    long to = 0;
+    long node = ESP_OT_LINK_QUALITY_ANY_NODE;
+
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK &&
+        (query_number_parse(query, "from", INT32_MIN, INT32_MAX, &from) != ESP_OK ||
+         query_number_parse(query, "to", INT32_MIN, INT32_MAX, &to) != ESP_OK ||
+         query_number_parse(query, "node", 0, OT_RADIO_INVALID_SHORT_ADDR - 1, &node) != ESP_OK)) {
+        httpd_resp_set_status(req, HTTPD_400);
+        return httpd_resp_send(req, NULL, 0);
+    }
+    cJSON *response = handle_ot_resource_link_quality_request(from, to, (uint16_t)node);
+    ESP_RETURN_ON_FALSE(response, ESP_FAIL, WEB_TAG, "Failed to handle openthread link quality request");
+    ret = httpd_send_packet(req, response);
+    cJSON_Delete(response);
+    return ret;
+}
+#endif // CONFIG_OPENTHREAD_LINK_QUALITY_STORE
+
+#if CONFIG_OPENTHREAD_MAC_COUNTERS_STORE
+static esp_err_t esp_otbr_network_mac_counters_get_handler(httpd_req_t *req)
+{
+    esp_err_t ret = ESP_OK;
+    char query[DIAGNOSTICS_QUERY_MAX_SIZE];
+    long window = 0;
+    long count = MAC_COUNTERS_DEFAULT_COUNT;
+    long node = ESP_OT_MAC_COUNTERS_ANY_NODE;
+
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK &&
+        (query_number_parse(query, "window", 0, INT32_MAX, &window) != ESP_OK ||
+         query_number_parse(query, "count", 1, CONFIG_OPENTHREAD_MAC_COUNTERS_MAX_NODES, &count) != ESP_OK ||
+         query_number_parse(query, "node", 0, OT_RADIO_INVALID_SHORT_ADDR - 1, &node) != ESP_OK)) {
+        httpd_resp_set_status(req, HTTPD_400);
+        return httpd_resp_send(req, NULL, 0);
+    }
+    cJSON *response = handle_ot_resource_mac_counters_request(window, count, (uint16_t)node);
+    if (!response) {
+        httpd_resp_set_status(req, HTTPD_404);
+        return httpd_resp_send(req, NULL, 0);
+    }
+    ret = httpd_send_packet(req, response);
+    cJSON_Delete(response);
+    return ret;
+}
+#endif // CONFIG_OPENTHREAD_MAC_COUNTERS_STORE
+
+#if CONFIG_OPENTHREAD_DNS_POOL
+static esp_err_t esp_otbr_dns_upstreams_get_handler(httpd_req_t *req)
+{
+    esp_err_t ret = ESP_OK;
+    cJSON *response = handle_ot_resource_dns_upstreams_request();
+
+    ret = httpd_send_packet(req, response);
+    cJSON_Delete(response);
+    return ret;
+}
+#endif // CONFIG_OPENTHREAD_DNS_POOL
+
+#if CONFIG_OPENTHREAD_IP_STATS
+static esp_err_t esp_otbr_ip_stats_get_handler(httpd_req_t *req)
+{
+    esp_err_t ret = ESP_OK;
+    cJSON *response = handle_ot_resource_ip_stats_request();
+
+    ret = httpd_send_packet(req, response);
+    cJSON_Delete(response);
+    return ret;
+}
+#endif // CONFIG_OPENTHREAD_IP_STATS
+
+#if CONFIG_OPENTHREAD_BOOT_TIMELINE
+static esp_err_t esp_otbr_boot_timeline_get_handler(httpd_req_t *req)
+{
+    esp_err_t ret = ESP_OK;
+    cJSON *response = handle_ot_resource_boot_timeline_request();
+
+    ret = httpd_send_packet(req, response);
+    cJSON_Delete(response);
+    return ret;
+}
+#endif // CONFIG_OPENTHREAD_BOOT_TIMELINE
+
+#if CONFIG_OPENTHREAD_CAPTURE
+typedef struct capture_stream {
+    httpd_req_t *req;                /* the request detached from the web server task */
+    int64_t deadline;                /* the time when the capture is stopped */
+    uint8_t buf[CAPTURE_CHUNK_SIZE]; /* the chunk read from the ring buffer */
+} capture_stream_t;
+
+/*
+ * The capture is streamed by its own task until its duration elapses, the client closes the connection or
+ * `capture stop` is run, so the web server keeps serving the other requests. The reader polls the ring buffer,
+ * so the taps in the forwarding path never wait for it.
+ */
+static void capture_stream_worker(void *arg)
+{
+    capture_stream_t *stream = (capture_stream_t *)arg;
+    esp_err_t ret = ESP_OK;
+
+    while (ret == ESP_OK) {
+        if (esp_timer_get_time() >= stream->deadline) {
+            esp_ot_capture_stop();
+        }
+        bool running = esp_ot_capture_is_running();
+        size_t len = esp_ot_capture_read(stream->buf, CAPTURE_CHUNK_SIZE);
+        if (len > 0) {
+            ret = httpd_resp_send_chunk(stream->req, (const char *)stream->buf, len);
+        } else if (!running) {
+            break;
+        } else {
+            vTaskDelay(pdMS_TO_TICKS(CAPTURE_POLL_MS));
+        }
+    }
+    if (ret != ESP_OK) {
+        esp_ot_capture_stop();
+    }
+    size_t len = esp_ot_capture_finish(stream->buf, CAPTURE_CHUNK_SIZE);
+    if (ret == ESP_OK && len > 0) {
+        ret = httpd_resp_send_chunk(stream->req, (const char *)stream->buf, len);
+    }
+    if (ret == ESP_OK) {
+        httpd_resp_send_chunk(stream->req, NULL, 0);
+    }
+    httpd_req_async_handler_complete(stream->req);
+    free(stream);
+    vTaskDelete(NULL);
+}
+
+static esp_err_t esp_otbr_capture_get_handler(httpd_req_t *req)
+{
+    static const char *const s_filter_keys[] = {"netif", "addr", "port", "proto", "snaplen"};
+    char query[CAPTURE_QUERY_MAX_SIZE];
+    char value[IPADDR_STRLEN_MAX];
+    esp_ot_capture_filter_t filter = {
+        .port = ESP_OT_CAPTURE_ANY_PORT,
+        .proto = ESP_OT_CAPTURE_ANY_PROTO,
+        .snaplen = CONFIG_OPENTHREAD_CAPTURE_SNAPLEN,
+    };
+    long duration = CAPTURE_DEFAULT_DURATION_S < CONFIG_OPENTHREAD_CAPTURE_MAX_DURATION
+                        ? CAPTURE_DEFAULT_DURATION_S
+                        : CONFIG_OPENTHREAD_CAPTURE_MAX_DURATION;
+    esp_err_t ret = ESP_OK;
+
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK) {
+        for (size_t i = 0; i < sizeof(s_filter_keys) / sizeof(s_filter_keys[0]) && ret == ESP_OK; i++) {
+            if (httpd_query_key_value(query, s_filter_keys[i], value, sizeof(value)) == ESP_OK) {
+                ret = esp_ot_capture_parse_filter(s_filter_keys[i], value, &filter);
+            }
+        }
+        if (ret != ESP_OK ||
+            query_number_parse(query, "duration", 1, CONFIG_OPENTHREAD_CAPTURE_MAX_DURATION, &duration) != ESP_OK) {
+            httpd_resp_set_status(req, HTTPD_400);
+            return httpd_resp_send(req, NULL, 0);
+        }
+    }
+    capture_stream_t *stream = (capture_stream_t *)malloc(sizeof(capture_stream_t));
+    if (stream == NULL) {
+        httpd_resp_set_status(req, HTTPD_500);
+        return httpd_resp_send(req, NULL, 0);
+    }
+    ret = esp_ot_capture_start(&filter);
+    if (ret != ESP_OK) {
+        free(stream);
+        httpd_resp_set_status(req, ret == ESP_ERR_INVALID_STATE ? HTTPD_409 : HTTPD_500);
+        return httpd_resp_send(req, NULL, 0);
+    }
+    httpd_resp_set_type(req, "application/x-pcapng");
+    stream->deadline = esp_timer_get_time() + (int64_t)duration * 1000000;
+    ret = httpd_req_async_handler_begin(req, &stream->req);
+    if (ret == ESP_OK && xTaskCreate(capture_stream_worker, "ot_capture", CAPTURE_TASK_STACK_SIZE, stream,
+                                     CAPTURE_TASK_PRIORITY, NULL) != pdTRUE) {
+        httpd_req_async_handler_complete(stream->req);
+        ret = ESP_ERR_NO_MEM;
+    }
+    if (ret != ESP_OK) {
+        esp_ot_capture_stop();
+        esp_ot_capture_finish(stream->buf, CAPTURE_CHUNK_SIZE);
+        free(stream);
+        httpd_resp_set_status(req, HTTPD_500);
+        return httpd_resp_send(req, NULL, 0);
+    }
+    return ESP_OK;
+}
+#endif // CONFIG_OPENTHREAD_CAPTURE
+
+#if CONFIG_OPENTHREAD_COEX
+static esp_err_t esp_otbr_coex_get_handler(httpd_req_t *req)
+{
+    esp_err_t ret = ESP_OK;
+    cJSON *response = handle_ot_resource_coex_request();
+
+    ret = httpd_send_packet(req, response);
+    cJSON_Delete(response);
+    return ret;
+}
+
+static esp_err_t coex_response_send(httpd_req_t *req, otError err)
+{
+    char http_return_status[64];
+    if (convert_ot_err_to_response_code(err, http_return_status) != ESP_OK) {
+        strcpy(http_return_status, HTTPD_500);
+    }
+    httpd_resp_set_status(req, http_return_status);
+    return httpd_resp_send(req, NULL, 0);
+}
+
+static esp_err_t esp_otbr_coex_put_handler(httpd_req_t *req)
+{
+    esp_err_t ret = ESP_OK;
+    cJSON *request = httpd_request_convert2_json(req, cJSON_Object);
+    otError err = request ? handle_ot_resource_coex_put_request(request) : OT_ERROR_INVALID_ARGS;
+
+    ESP_GOTO_ON_ERROR(coex_response_send(req, err), exit, WEB_TAG, "Failed to response %s", req->uri);
+exit:
+    cJSON_Delete(request);
+    return ret;
+}
+
+static esp_err_t esp_otbr_coex_measure_post_handler(httpd_req_t *req)
+{
+    esp_err_t ret = ESP_OK;
+    cJSON *request = httpd_request_convert2_json(req, cJSON_Object);
+    otError err = request ? handle_ot_resource_coex_measure_post_request(request) : OT_ERROR_INVALID_ARGS;
+
+    ESP_GOTO_ON_ERROR(coex_response_send(req, err), exit, WEB_TAG, "Failed to response %s", req->uri);
+exit:
+    cJSON_Delete(request);
+    return ret;
+}
+#endif // CONFIG_OPENTHREAD_COEX
+
 /*-----------------------------------------------------
  Note：Openthread WEB GUI API implement
 -----------------------------------------------------*/
@@ -849,9 +2045,105 @@ exit:
     return ret;
 }
 
+/* Parse "channels" as a comma separated list, "timeout" in milliseconds and "scan" as 0 or 1. */
+static esp_err_t available_networks_query_parse(httpd_req_t *req, uint32_t *channel_mask, uint32_t *timeout_ms,
+                                                bool *scan)
+{
+    char query[96];
+    char channels[64];
+    char value[12];
+    char *end = NULL;
+
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) != ESP_OK) {
+        return ESP_OK;
+    }
+    if (httpd_query_key_value(query, "channels", channels, sizeof(channels)) == ESP_OK) {
+        for (char *channel = strtok(channels, ","); channel; channel = strtok(NULL, ",")) {
+            long number = strtol(channel, &end, 10);
+            ESP_RETURN_ON_FALSE(*end == '\0' && number >= OT_RADIO_2P4GHZ_OQPSK_CHANNEL_MIN &&
+                                    number <= OT_RADIO_2P4GHZ_OQPSK_CHANNEL_MAX,
+                                ESP_ERR_INVALID_ARG, WEB_TAG, "Invalid channel: %s", channel);
+            *channel_mask |= 1UL << number;
+        }
+    }
+    if (httpd_query_key_value(query, "timeout", value, sizeof(value)) == ESP_OK) {
+        long number = strtol(value, &end, 10);
+        ESP_RETURN_ON_FALSE(*end == '\0' && number >= 0 && number <= AVAILABLE_NETWORK_MAX_TIMEOUT_MS,
+                            ESP_ERR_INVALID_ARG, WEB_TAG, "Invalid timeout: %s", value);
+        *timeout_ms = number;
+    }
+    if (httpd_query_key_value(query, "scan", value, sizeof(value)) == ESP_OK) {
+        ESP_RETURN_ON_FALSE(strcmp(value, "0") == 0 || strcmp(value, "1") == 0, ESP_ERR_INVALID_ARG, WEB_TAG,
+                            "Invalid scan: %s", value);
+        *scan = value[0] == '1';
+    }
+    return ESP_OK;
+}
+
+typedef struct available_networks_stream {
+    httpd_req_t *req;
+    uint16_t count;
+} available_networks_stream_t;
+
+static esp_err_t available_networks_stream_event(httpd_req_t *req, const char *event, cJSON *data)
+{
+    esp_err_t ret = ESP_OK;
+    char *text = cJSON_PrintUnformatted(data);
+    ESP_RETURN_ON_FALSE(text, ESP_ERR_NO_MEM, WEB_TAG, "Failed to print event");
+    ESP_GOTO_ON_ERROR(httpd_resp_sendstr_chunk(req, "event: "), exit, WEB_TAG, "Failed to send event");
+    ESP_GOTO_ON_ERROR(httpd_resp_sendstr_chunk(req, event), exit, WEB_TAG, "Failed to send event");
+    ESP_GOTO_ON_ERROR(httpd_resp_sendstr_chunk(req, "\ndata: "), exit, WEB_TAG, "Failed to send event");
+    ESP_GOTO_ON_ERROR(httpd_resp_sendstr_chunk(req, text), exit, WEB_TAG, "Failed to send event");
+    ESP_GOTO_ON_ERROR(httpd_resp_sendstr_chunk(req, "\n\n"), exit, WEB_TAG, "Failed to send event");
+exit:
+    cJSON_free(text);
+    return ret;
+}
+
+static esp_err_t available_networks_stream_network(const thread_network_information_t *network, void *context)
+{
+    available_networks_stream_t *stream = (available_networks_stream_t *)context;
+    cJSON *data = available_network_struct_convert2_json(network);
+    esp_err_t ret = available_networks_stream_event(stream->req, "network", data);
+    cJSON_Delete(data);
+    stream->count++;
+    return ret;
+}
+
+/* Send each network as a server-sent event as soon as it is found, a network is sent again when its RSSI or LQI
+   improves. The last event is "done" with the count of the events and whether the discover completed. */
+static esp_err_t available_networks_stream(httpd_req_t *req, uint32_t channel_mask, uint32_t timeout_ms, bool scan)
+{
+    esp_err_t ret = ESP_OK;
+    available_networks_stream_t stream = {.req = req, .count = 0};
+    bool complete = true;
+    otError err = OT_ERROR_NONE;
+
+    ESP_RETURN_ON_ERROR(httpd_resp_set_type(req, "text/event-stream"), WEB_TAG, "Failed to set http type");
+    ESP_RETURN_ON_ERROR(httpd_resp_set_hdr(req, "Cache-Control", "no-cache"), WEB_TAG, "Failed to set header");
+    if (scan) {
+        err = handle_openthread_available_network_scan(channel_mask, timeout_ms, available_networks_stream_network,
+                                                       &stream, &complete);
+    } else {
+        err = handle_openthread_available_network_cache(available_networks_stream_network, &stream);
+    }
+    cJSON *done = cJSON_CreateObject();
+    cJSON_AddNumberToObject(done, "error", err);
+    cJSON_AddNumberToObject(done, "count", stream.count);
+    cJSON_AddBoolToObject(done, "complete", complete);
+    ESP_GOTO_ON_ERROR(available_networks_stream_event(req, "done", done), exit, WEB_TAG, "Failed to response %s",
+                      req->uri);
+    ret = httpd_resp_send_chunk(req, NULL, 0);
+exit:
+    cJSON_Delete(done);
+    return ret;
+}
+
 /**
  * @brief The API would discover the available thread network, packs and sends it to @param req.
  *
+ * @note With the header "Accept: text/event-stream", the networks are streamed as they are found.
+ *
  * @param[in] req The request for http_client.
  * @return
  *      -   ESP_OK                      : On success
@@ -863,15 +2155,32 @@ exit:
 static esp_err_t esp_otbr_available_networks_get_handler(httpd_req_t *req)
 {
     esp_err_t ret = ESP_OK;
-    cJSON *result = handle_openthread_available_network_request();
-    cJSON *error = result ? cJSON_CreateNumber((double)OT_ERROR_NONE) : cJSON_CreateNumber((double)OT_ERROR_FAILED);
-    cJSON *message = result ? cJSON_CreateString("Networks: Success") : cJSON_CreateString("Networks: Failure");
+    char accept[64];
+    uint32_t channel_mask = 0;
+    uint32_t timeout_ms = 0;
+    bool scan = true;
+    cJSON *result = NULL;
+    cJSON *error = NULL;
+    cJSON *message = NULL;
+
+    if (available_networks_query_parse(req, &channel_mask, &timeout_ms, &scan) != ESP_OK) {
+        error = cJSON_CreateNumber((double)OT_ERROR_INVALID_ARGS);
+        result = cJSON_CreateArray();
+        message = cJSON_CreateString("Networks: Invalid query");
+    } else if (httpd_req_get_hdr_value_str(req, ESP_OT_REST_ACCEPT_HEADER, accept, sizeof(accept)) == ESP_OK &&
+               strstr(accept, "text/event-stream")) {
+        return available_networks_stream(req, channel_mask, timeout_ms, scan);
+    } else {
+        result = handle_openthread_available_network_request(channel_mask, timeout_ms, scan);
+        error = cJSON_CreateNumber((double)(result ? OT_ERROR_NONE : OT_ERROR_FAILED));
+        message = cJSON_CreateString(result ? "Networks: Success" : "Networks: Failure");
+        if (!result) {
+            result = cJSON_CreateArray();
+        }
+    }
     cJSON *response = pack_response(error, result, message);
     ESP_GOTO_ON_ERROR(httpd_send_packet(req, response), exit, WEB_TAG, "Failed to response %s", req->uri);
-    ESP_GOTO_ON_FALSE(result, ESP_FAIL, exit, WEB_TAG, "Failed to Discover Thread available networks");
-    ESP_LOGI(WEB_TAG, "<================== Available Network =====================>");
     ESP_LOGI(WEB_TAG, "Discover Completed !");
-    ESP_LOGI(WEB_TAG, "<==========================================================>");
 exit:
     cJSON_Delete(response);
     return ret;
@@ -1114,6 +2423,29 @@ exit:
     return ret;
 }
 
+static esp_err_t esp_otbr_batch_ipaddr_post_handler(httpd_req_t *req)
+{
+    esp_err_t ret = ESP_OK;
+    otError err = OT_ERROR_INVALID_ARGS;
+    char *body = httpd_request_recv_body(req, IPADDR_BATCH_BODY_MAX_SIZE);
+    cJSON *request = body ? cJSON_Parse(body) : NULL;
+    free(body);
+    ESP_RETURN_ON_FALSE(request, ESP_FAIL, WEB_TAG, "Failed to parse ipaddr batch request");
+
+    cJSON *result = handle_openthread_batch_ipaddr_request(request, &err);
+    if (result == NULL) {
+        result = cJSON_CreateObject();
+    }
+    cJSON *error = cJSON_CreateNumber((double)err);
+    cJSON *message = cJSON_CreateString(err == OT_ERROR_NONE ? "Addresses updated" : "Failed to update addresses");
+    cJSON *response = pack_response(error, result, message);
+    ESP_GOTO_ON_ERROR(httpd_send_packet(req, response), exit, WEB_TAG, "Failed to respond %s", req->uri);
+exit:
+    cJSON_Delete(request);
+    cJSON_Delete(response);
+    return ret;
+}
+
 /**
  * @brief The API provides an entry to collect the topology of Thread node, packs and sends it to @param req.
  *
@@ -1131,12 +2463,14 @@ static esp_err_t esp_otbr_network_topology_get_handler(httpd_req_t *req)
     esp_err_t ret = ESP_OK;
     cJSON *result = handle_ot_resource_network_diagnostics_request();
     ESP_RETURN_ON_FALSE(result, ESP_FAIL, WEB_TAG, "Failed to get Thread Network Topology");
+    httpd_chunk_writer_t writer;
+    httpd_chunk_writer_init(&writer, req);
 
     /* Stream the wrapped JSON response in chunks to avoid allocating the
        entire serialized string in RAM at once (can be 30-50 KB for large networks).
        Format: {"error":0,"result":[<item>,<item>,...],"message":"Topology: Success"} */
     ESP_GOTO_ON_ERROR(httpd_resp_set_type(req, "application/json"), exit, WEB_TAG, "Failed to set content type");
-    ESP_GOTO_ON_ERROR(httpd_resp_sendstr_chunk(req, "{\"error\":0,\"result\":["), exit, WEB_TAG,
+    ESP_GOTO_ON_ERROR(httpd_chunk_writer_sendstr(&writer, "{\"error\":0,\"result\":["), exit, WEB_TAG,
                       "Failed to send chunk");
 
     int array_size = cJSON_GetArraySize(result);
@@ -1146,22 +2480,23 @@ static esp_err_t esp_otbr_network_topology_get_handler(httpd_req_t *req)
         cJSON_Delete(detached);
         if (chunk) {
             if (i > 0) {
-                ESP_GOTO_ON_ERROR(httpd_resp_sendstr_chunk(req, ","), exit, WEB_TAG, "Failed to send chunk");
+                ESP_GOTO_ON_ERROR(httpd_chunk_writer_sendstr(&writer, ","), exit, WEB_TAG, "Failed to send chunk");
             }
-            esp_err_t send_err = httpd_resp_sendstr_chunk(req, chunk);
+            esp_err_t send_err = httpd_chunk_writer_sendstr(&writer, chunk);
             cJSON_free(chunk);
             ESP_GOTO_ON_ERROR(send_err, exit, WEB_TAG, "Failed to send chunk");
         }
     }
 
-    ESP_GOTO_ON_ERROR(httpd_resp_sendstr_chunk(req, "],\"message\":\"Topology: Success\"}"), exit, WEB_TAG,
+    ESP_GOTO_ON_ERROR(httpd_chunk_writer_sendstr(&writer, "],\"message\":\"Topology: Success\"}"), exit, WEB_TAG,
                       "Failed to send chunk");
-    httpd_resp_sendstr_chunk(req, NULL); /* end chunked response */
+    ret = httpd_chunk_writer_end(&writer); /* end chunked response */
 
     ESP_LOGI(WEB_TAG, "<==================== Thread Topology =====================>");
     ESP_LOGI(WEB_TAG, "Thread diagnostic Tlv Complete.");
     ESP_LOGI(WEB_TAG, "<==========================================================>");
 exit:
+    httpd_chunk_writer_deinit(&writer);
     cJSON_Delete(result);
     return ret;
 }
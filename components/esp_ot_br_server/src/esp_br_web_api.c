@@ -10,6 +10,11 @@
 #include "esp_br_web.h"
 #include "esp_br_web_api.h"
 #include "esp_br_web_base.h"
+#include "esp_br_web_cbor.h"
+#include "esp_br_web_channel_survey.h"
+#include "esp_br_web_diag_scheduler.h"
+#include "esp_br_web_network_cache.h"
+#include "esp_br_web_topology.h"
 #include "esp_check.h"
 #include "esp_err.h"
 #include "esp_log.h"
@@ -18,13 +23,42 @@
 #include "esp_netif_net_stack.h"
 #include "esp_openthread.h"
 #include "esp_openthread_lock.h"
+#include "esp_random.h"
+#include "esp_timer.h"
+#if CONFIG_OPENTHREAD_BR_WEB_DIAG_BENCHMARK
+#include "esp_br_web_gzip.h"
+#endif
+#if CONFIG_OPENTHREAD_COEX
+#include "esp_ot_coex.h"
+#endif
+#if CONFIG_OPENTHREAD_COMMISSION_JOB
+#include "esp_ot_commission_job.h"
+#endif
+#if CONFIG_OPENTHREAD_LINK_QUALITY_STORE
+#include "esp_ot_link_quality.h"
+#endif
+#if CONFIG_OPENTHREAD_DNS_POOL
+#include "esp_ot_dns_pool.h"
+#include "lwip/ip4_addr.h"
+#endif
+#if CONFIG_OPENTHREAD_MAC_COUNTERS_STORE
+#include "esp_ot_mac_counters.h"
+#endif
+#if CONFIG_OPENTHREAD_IP_STATS
+#include "esp_ot_ip_stats.h"
+#endif
+#if CONFIG_OPENTHREAD_BOOT_TIMELINE
+#include "esp_ot_boot_timeline.h"
+#endif
 #include "malloc.h"
 #include "stdio.h"
 #include "stdlib.h"
 #include "string.h"
 #include <assert.h>
+#include <inttypes.h>
 #include <stdint.h>
 #include "freertos/FreeRTOS.h"
+#include "freertos/event_groups.h"
 #include "freertos/portmacro.h"
 #include "freertos/semphr.h"
 #include "openthread/border_agent.h"
@@ -38,6 +72,7 @@
 #include "openthread/ip6.h"
 #include "openthread/netdata.h"
 #include "openthread/ping_sender.h"
+#include "openthread/platform/radio.h"
 #include "openthread/server.h"
 #include "openthread/thread_ftd.h"
 
@@ -64,20 +99,39 @@
 
 #define API_TAG "web_api"
 
+/* The periodic queries of all the routers feeding the link quality and the MAC counters stores. */
+#define DIAG_SWEEP_ENABLE                                                                       \
+    ((CONFIG_OPENTHREAD_LINK_QUALITY_STORE && CONFIG_OPENTHREAD_LINK_QUALITY_SWEEP_INTERVAL) || \
+     CONFIG_OPENTHREAD_MAC_COUNTERS_STORE)
+
 /* Forward declarations for semaphores initialized in esp_br_web_api_init() */
-static SemaphoreHandle_t s_discover_done_semaphore;
+static EventGroupHandle_t s_available_network_events;
 static SemaphoreHandle_t s_join_done_semaphore;
 static SemaphoreHandle_t s_diagnostic_semaphore;
 static SemaphoreHandle_t s_ping_done_semaphore;
 static SemaphoreHandle_t s_ping_mutex;
+static SemaphoreHandle_t s_channel_change_semaphore;
+static thread_topology_history_t s_topology_history; /* topology versions kept for the deltas */
+#if DIAG_SWEEP_ENABLE
+static void diagnostics_sweep_start(void);
+#endif
 
 void esp_br_web_api_init(void)
 {
-    s_discover_done_semaphore = xSemaphoreCreateBinary();
+    s_available_network_events = xEventGroupCreate();
     s_join_done_semaphore = xSemaphoreCreateBinary();
     s_diagnostic_semaphore = xSemaphoreCreateMutex();
     s_ping_done_semaphore = xSemaphoreCreateBinary();
     s_ping_mutex = xSemaphoreCreateMutex();
+    s_channel_change_semaphore = xSemaphoreCreateBinary();
+    diag_scheduler_init();
+    /* The versions of this boot start at a random epoch, so the ones of the previous boots are not taken for them. */
+    thread_topology_history_init(&s_topology_history, esp_random());
+    channel_survey_init();
+    available_network_cache_init();
+#if DIAG_SWEEP_ENABLE
+    diagnostics_sweep_start();
+#endif
 }
 
 static const char s_ot_state[5][10] = {"disabled", "detached", "child", "router", "leader"};
@@ -110,34 +164,136 @@ static esp_err_t parse_ipv6_prefix_from_string(char *string, otIp6Prefix *prefix
 /*----------------------------------------------------------------------
                             Resource REST API
 ----------------------------------------------------------------------*/
-cJSON *handle_ot_resource_node_rloc_request()
+/* The getters of the node resources below must be called with the OpenThread lock held. */
+static cJSON *node_rloc_get(otInstance *ins)
 {
     char rloc[OT_IP6_ADDRESS_STRING_SIZE];
-    esp_openthread_lock_acquire(portMAX_DELAY);
-    otIp6AddressToString((const otIp6Address *)otThreadGetRloc(esp_openthread_get_instance()), rloc,
-                         OT_IP6_ADDRESS_STRING_SIZE);
-    esp_openthread_lock_release();
+    otIp6AddressToString((const otIp6Address *)otThreadGetRloc(ins), rloc, OT_IP6_ADDRESS_STRING_SIZE);
     return cJSON_CreateString(rloc);
 }
 
-cJSON *handle_ot_resource_node_rloc16_request()
+static cJSON *node_rloc16_get(otInstance *ins)
+{
+    return cJSON_CreateNumber(otThreadGetRloc16(ins));
+}
+
+static cJSON *node_state_get(otInstance *ins)
+{
+    return cJSON_CreateString(s_ot_state[otThreadGetDeviceRole(ins)]);
+}
+
+static cJSON *node_role_get(otInstance *ins)
+{
+    return cJSON_CreateNumber(otThreadGetDeviceRole(ins));
+}
+
+static cJSON *node_extaddress_get(otInstance *ins)
+{
+    char format[OT_EXT_ADDRESS_SIZE * 2 + 1];
+    const otExtAddress *address = otLinkGetExtendedAddress(ins);
+    ESP_RETURN_ON_FALSE(!hex_to_string(address->m8, format, OT_EXT_ADDRESS_SIZE), NULL, API_TAG,
+                        "Failed to convert thread extended address");
+    return cJSON_CreateString(format);
+}
+
+static cJSON *node_network_name_get(otInstance *ins)
+{
+    return cJSON_CreateString(otThreadGetNetworkName(ins));
+}
+
+static cJSON *node_leader_data_get(otInstance *ins)
+{
+    cJSON *root = NULL;
+    otLeaderData data;
+    if (otThreadGetLeaderData(ins, &data) == OT_ERROR_NONE) {
+        root = cJSON_CreateObject();
+        cJSON_AddItemToObject(root, "PartitionId", cJSON_CreateNumber(data.mPartitionId));
+        cJSON_AddItemToObject(root, "Weighting", cJSON_CreateNumber(data.mWeighting));
+        cJSON_AddItemToObject(root, "DataVersion", cJSON_CreateNumber(data.mDataVersion));
+        cJSON_AddItemToObject(root, "StableDataVersion", cJSON_CreateNumber(data.mStableDataVersion));
+        cJSON_AddItemToObject(root, "LeaderRouterId", cJSON_CreateNumber(data.mLeaderRouterId));
+    } else {
+        ESP_LOGE(API_TAG, "Failed to get thread leader data");
+    }
+    return root;
+}
+
+static cJSON *node_numofrouter_get(otInstance *ins)
+{
+    uint8_t max_router_id = otThreadGetMaxRouterId(ins);
+    otRouterInfo router_info;
+    uint8_t router_number = 0;
+    for (uint8_t i = 0; i <= max_router_id; ++i) {
+        if (otThreadGetRouterInfo(ins, i, &router_info) != OT_ERROR_NONE)
+            continue;
+        ++router_number;
+    }
+    return cJSON_CreateNumber(router_number);
+}
+
+static cJSON *node_extpanid_get(otInstance *ins)
+{
+    char format[OT_EXT_PAN_ID_SIZE * 2 + 1];
+    const otExtendedPanId *extpanid = otThreadGetExtendedPanId(ins);
+    ESP_RETURN_ON_FALSE(!hex_to_string(extpanid->m8, format, OT_EXT_PAN_ID_SIZE), NULL, API_TAG,
+                        "Failed to convert thread extended panid");
+    return cJSON_CreateString(format);
+}
+
+static cJSON *node_baid_get(otInstance *ins)
+{
+    char format[OT_BORDER_AGENT_ID_LENGTH * 2 + 1];
+    otBorderAgentId id;
+    ESP_RETURN_ON_FALSE(otBorderAgentGetId(ins, &id) == OT_ERROR_NONE, NULL, API_TAG,
+                        "Failed to get border agent id");
+    ESP_RETURN_ON_FALSE(!hex_to_string(id.mId, format, OT_BORDER_AGENT_ID_LENGTH), NULL, API_TAG,
+                        "Failed to convert border agent id");
+    return cJSON_CreateString(format);
+}
+
+typedef cJSON *(*node_resource_getter_t)(otInstance *ins);
+
+typedef struct {
+    const char *field; /* The key in the GET /node response */
+    const char *path;  /* The REST resource of the same value, NULL if there is none */
+    node_resource_getter_t field_get;
+    node_resource_getter_t resource_get;
+} node_resource_t;
+
+/* Each value is only computed when it is requested, e.g. NumOfRouter walks the whole router table. */
+static const node_resource_t s_node_resources[] = {
+    {"NetworkName", ESP_OT_REST_API_NODE_NETWORKNAME_PATH, node_network_name_get, node_network_name_get},
+    {"ExtPanId", ESP_OT_REST_API_NODE_EXTPANID_PATH, node_extpanid_get, node_extpanid_get},
+    {"ExtAddress", ESP_OT_REST_API_NODE_EXTADDRESS_PATH, node_extaddress_get, node_extaddress_get},
+    {"RlocAddress", ESP_OT_REST_API_NODE_RLOC_PATH, node_rloc_get, node_rloc_get},
+    {"LeaderData", ESP_OT_REST_API_NODE_LEADERDATA_PATH, node_leader_data_get, node_leader_data_get},
+    {"State", ESP_OT_REST_API_NODE_STATE_PATH, node_role_get, node_state_get},
+    {"Rloc16", ESP_OT_REST_API_NODE_RLOC16_PATH, node_rloc16_get, node_rloc16_get},
+    {"NumOfRouter", ESP_OT_REST_API_NODE_NUMBEROFROUTER_PATH, node_numofrouter_get, node_numofrouter_get},
+    {"BaId", ESP_OT_REST_API_NODE_BORDERAGENTID_PATH, node_baid_get, node_baid_get},
+};
+
+static cJSON *node_resource_request(node_resource_getter_t get)
 {
-    uint16_t rloc16 = 0xffff;
     esp_openthread_lock_acquire(portMAX_DELAY);
-    rloc16 = otThreadGetRloc16(esp_openthread_get_instance());
+    cJSON *root = get(esp_openthread_get_instance());
     esp_openthread_lock_release();
-    return cJSON_CreateNumber(rloc16);
+    return root;
+}
+
+cJSON *handle_ot_resource_node_rloc_request()
+{
+    return node_resource_request(node_rloc_get);
+}
+
+cJSON *handle_ot_resource_node_rloc16_request()
+{
+    return node_resource_request(node_rloc16_get);
 }
 
 cJSON *handle_ot_resource_node_state_request()
 {
-    otDeviceRole state = 0;
-    esp_openthread_lock_acquire(portMAX_DELAY);
-    state = otThreadGetDeviceRole(esp_openthread_get_instance());
-    char state_str[10];
-    strcpy(state_str, s_ot_state[state]);
-    esp_openthread_lock_release();
-    return cJSON_CreateString(state_str);
+    return node_resource_request(node_state_get);
 }
 
 otError handle_ot_resource_node_state_put_request(cJSON *request)
@@ -169,80 +325,141 @@ exit:
 
 cJSON *handle_ot_resource_node_extaddress_request()
 {
-    char format[OT_EXT_ADDRESS_SIZE * 2 + 1];
-    esp_openthread_lock_acquire(portMAX_DELAY);
-    const otExtAddress *address = otLinkGetExtendedAddress(esp_openthread_get_instance());
-    esp_openthread_lock_release();
-    ESP_RETURN_ON_FALSE(!hex_to_string(address->m8, format, OT_EXT_ADDRESS_SIZE), NULL, API_TAG,
-                        "Failed to convert thread extended address");
-    return cJSON_CreateString(format);
+    return node_resource_request(node_extaddress_get);
 }
 
 cJSON *handle_ot_resource_node_network_name_request()
 {
-    const char *ot_network_name;
-    esp_openthread_lock_acquire(portMAX_DELAY);
-    ot_network_name = otThreadGetNetworkName(esp_openthread_get_instance());
-    esp_openthread_lock_release();
-    return cJSON_CreateString(ot_network_name);
+    return node_resource_request(node_network_name_get);
 }
 
 cJSON *handle_ot_resource_node_leader_data_request()
 {
-    cJSON *root = NULL;
-    otLeaderData data;
-    esp_openthread_lock_acquire(portMAX_DELAY);
-    if (otThreadGetLeaderData(esp_openthread_get_instance(), &data) == OT_ERROR_NONE) {
-        root = cJSON_CreateObject();
-        cJSON_AddItemToObject(root, "PartitionId", cJSON_CreateNumber(data.mPartitionId));
-        cJSON_AddItemToObject(root, "Weighting", cJSON_CreateNumber(data.mWeighting));
-        cJSON_AddItemToObject(root, "DataVersion", cJSON_CreateNumber(data.mDataVersion));
-        cJSON_AddItemToObject(root, "StableDataVersion", cJSON_CreateNumber(data.mStableDataVersion));
-        cJSON_AddItemToObject(root, "LeaderRouterId", cJSON_CreateNumber(data.mLeaderRouterId));
-    } else {
-        ESP_LOGE(API_TAG, "Failed to get thread leader data");
-    }
-    esp_openthread_lock_release();
-    return root;
+    return node_resource_request(node_leader_data_get);
 }
 
 cJSON *handle_ot_resource_node_numofrouter_request()
 {
+    return node_resource_request(node_numofrouter_get);
+}
+
+cJSON *handle_ot_resource_node_extpanid_request()
+{
+    return node_resource_request(node_extpanid_get);
+}
+
+cJSON *handle_ot_resource_node_baid_request()
+{
+    return node_resource_request(node_baid_get);
+}
+
+cJSON *handle_ot_resource_node_fields_request(const char *fields, cJSON *log)
+{
+    const node_resource_t *selected[sizeof(s_node_resources) / sizeof(s_node_resources[0])];
+    size_t count = 0;
+    uint16_t errcode = 200;
+    cJSON *root = NULL;
+    const char *pos = fields;
+
+    while (pos && *pos) {
+        const char *end = strchr(pos, ',');
+        size_t len = end ? (size_t)(end - pos) : strlen(pos);
+        const node_resource_t *resource = NULL;
+        for (size_t i = 0; i < sizeof(s_node_resources) / sizeof(s_node_resources[0]); i++) {
+            if (strlen(s_node_resources[i].field) == len && strncmp(s_node_resources[i].field, pos, len) == 0) {
+                resource = &s_node_resources[i];
+                break;
+            }
+        }
+        if (resource == NULL) {
+            ESP_LOGE(API_TAG, "Unknown node field: %.*s", (int)len, pos);
+            errcode = 400;
+            goto exit;
+        }
+        bool duplicated = false;
+        for (size_t i = 0; i < count; i++) {
+            duplicated = duplicated || selected[i] == resource;
+        }
+        if (!duplicated) {
+            selected[count++] = resource;
+        }
+        pos = end ? end + 1 : NULL;
+    }
+
+    root = cJSON_CreateObject();
     esp_openthread_lock_acquire(portMAX_DELAY);
-    int8_t max_router_id = otThreadGetMaxRouterId(esp_openthread_get_instance());
-    otRouterInfo router_info;
-    uint8_t router_number = 0;
-    for (uint8_t i = 0; i <= max_router_id; ++i) {
-        if (otThreadGetRouterInfo(esp_openthread_get_instance(), i, &router_info) != OT_ERROR_NONE)
-            continue;
-        ++router_number;
+    otInstance *ins = esp_openthread_get_instance();
+    for (size_t i = 0; i < count; i++) {
+        cJSON *value = selected[i]->field_get(ins);
+        cJSON_AddItemToObject(root, selected[i]->field, value ? value : cJSON_CreateNull());
     }
     esp_openthread_lock_release();
-    return cJSON_CreateNumber(router_number);
+
+exit:
+    cJSON_AddItemToObject(log, "ErrorCode", cJSON_CreateNumber(errcode));
+    return root;
 }
 
-cJSON *handle_ot_resource_node_extpanid_request()
+cJSON *handle_ot_resource_batch_request(const cJSON *request, cJSON *log)
 {
-    char format[OT_EXT_PAN_ID_SIZE * 2 + 1];
+    const cJSON *resources = cJSON_GetObjectItemCaseSensitive(request, "resources");
+    const cJSON *item = NULL;
+    uint16_t errcode = 200;
+    cJSON *root = NULL;
+
+    if (!cJSON_IsArray(resources)) {
+        errcode = 400;
+        goto exit;
+    }
+    /* Resolve all the paths first, so that an invalid request does not take the lock. */
+    cJSON_ArrayForEach(item, resources)
+    {
+        const char *path = cJSON_GetStringValue(item);
+        bool found = false;
+        for (size_t i = 0; path && i < sizeof(s_node_resources) / sizeof(s_node_resources[0]); i++) {
+            found = found || (s_node_resources[i].path && strcmp(s_node_resources[i].path, path) == 0);
+        }
+        if (!found) {
+            ESP_LOGE(API_TAG, "Unsupported batch resource: %s", path ? path : "(invalid)");
+            errcode = 400;
+            goto exit;
+        }
+    }
+
+    root = cJSON_CreateObject();
     esp_openthread_lock_acquire(portMAX_DELAY);
-    const otExtendedPanId *extpanid = otThreadGetExtendedPanId(esp_openthread_get_instance());
+    otInstance *ins = esp_openthread_get_instance();
+    cJSON_ArrayForEach(item, resources)
+    {
+        const char *path = cJSON_GetStringValue(item);
+        for (size_t i = 0; i < sizeof(s_node_resources) / sizeof(s_node_resources[0]); i++) {
+            if (s_node_resources[i].path && strcmp(s_node_resources[i].path, path) == 0 &&
+                !cJSON_HasObjectItem(root, path)) {
+                cJSON *value = s_node_resources[i].resource_get(ins);
+                cJSON_AddItemToObject(root, path, value ? value : cJSON_CreateNull());
+                break;
+            }
+        }
+    }
     esp_openthread_lock_release();
-    ESP_RETURN_ON_FALSE(!hex_to_string(extpanid->m8, format, OT_EXT_ADDRESS_SIZE), NULL, API_TAG,
-                        "Failed to convert thread extended panid");
-    return cJSON_CreateString(format);
+
+exit:
+    cJSON_AddItemToObject(log, "ErrorCode", cJSON_CreateNumber(errcode));
+    return root;
 }
 
-cJSON *handle_ot_resource_node_baid_request()
+otError handle_ot_resource_node_dataset_struct_request(const char *dataset_type, otOperationalDataset *dataset)
 {
-    char format[OT_BORDER_AGENT_ID_LENGTH * 2 + 1];
-    otBorderAgentId id;
+    otError ret = OT_ERROR_INVALID_ARGS;
     esp_openthread_lock_acquire(portMAX_DELAY);
-    otError err = otBorderAgentGetId(esp_openthread_get_instance(), &id);
+    otInstance *ins = esp_openthread_get_instance();
+    if (strcmp(dataset_type, ESP_OT_DATASET_TYPE_ACTIVE) == 0) {
+        ret = otDatasetGetActive(ins, dataset);
+    } else if (strcmp(dataset_type, ESP_OT_DATASET_TYPE_PENDING) == 0) {
+        ret = otDatasetGetPending(ins, dataset);
+    }
     esp_openthread_lock_release();
-    ESP_RETURN_ON_FALSE(err == OT_ERROR_NONE, NULL, API_TAG, "Failed to get border agent id");
-    ESP_RETURN_ON_FALSE(!hex_to_string(id.mId, format, OT_BORDER_AGENT_ID_LENGTH), NULL, API_TAG,
-                        "Failed to convert border agent id");
-    return cJSON_CreateString(format);
+    return ret;
 }
 
 cJSON *handle_ot_resource_node_get_dataset_request(const cJSON *request, cJSON *log)
@@ -493,87 +710,130 @@ exit:
 /*----------------------------------------------------------------------
                scan thread available networks
 ----------------------------------------------------------------------*/
-static thread_network_list_t *s_networkList = NULL;
-static uint8_t s_networkList_count = 0;
-/* s_discover_done_semaphore is initialized in esp_br_web_api_init() */
-
-static void build_availableNetworks_list(otActiveScanResult *result)
-{
-    s_networkList_count++;
-    thread_network_information_t network;
+#define AVAILABLE_NETWORK_CHANNEL_MS 300 /* the active scan duration of each channel of a discover */
+#define AVAILABLE_NETWORK_MARGIN_MS 2000 /* the time for a discover to report after its last channel */
+#define AVAILABLE_NETWORK_POLL_MS 250    /* the max delay of a streamed result missed by a concurrent reader */
+#define AVAILABLE_NETWORK_SCAN_DONE_BIT BIT0
+#define AVAILABLE_NETWORK_SCAN_RESULT_BIT BIT1
 
-    network.id = s_networkList_count;
-    memcpy(&network.network_name, &result->mNetworkName, sizeof(otNetworkName));
-    memcpy(&network.extended_panid.m8, &result->mExtendedPanId.m8, sizeof(otExtendedPanId));
-    network.panid = result->mPanId;
-    memcpy(&network.extended_address.m8, &result->mExtAddress.m8, sizeof(otExtAddress));
-    network.channel = result->mChannel;
-    network.rssi = result->mRssi;
-    network.lqi = result->mLqi;
-
-    append_available_thread_networks_list(s_networkList, network);
-
-    ESP_LOGI(API_TAG, "<===================== Thread Scan ========================>");
-    ESP_LOGI(API_TAG, "Find available network");
-    ESP_LOGI(API_TAG, "ID: %d, Network Name: %s", network.id, network.network_name.m8);
-    ESP_LOGI(API_TAG, "<==========================================================>");
-    return;
-}
+static bool s_available_network_scanning = false; /* protected by the OpenThread lock */
+static uint32_t s_available_network_scan_seq = 0; /* the sequence at the start of the running scan */
+/* s_available_network_events is initialized in esp_br_web_api_init() */
 
 static void handle_active_scan_event(otActiveScanResult *aResult, void *aContext)
 {
     if ((aResult) == NULL) {
-        xSemaphoreGive(s_discover_done_semaphore);
+        s_available_network_scanning = false;
+        xEventGroupSetBits(s_available_network_events, AVAILABLE_NETWORK_SCAN_DONE_BIT);
     } else {
-        build_availableNetworks_list(aResult);
+        available_network_cache_update(aResult);
+        xEventGroupSetBits(s_available_network_events, AVAILABLE_NETWORK_SCAN_RESULT_BIT);
     }
 }
 
-static otError get_openthread_available_networks(void)
+/* Start a discover on the channels of @param channel_mask, a request during a discover follows the running one. */
+static otError get_openthread_available_networks(uint32_t channel_mask, uint32_t *start_seq)
 {
     otError ret = OT_ERROR_NONE;
-    uint32_t scanChannels = 0;
     esp_openthread_lock_acquire(portMAX_DELAY);
     otInstance *ins = esp_openthread_get_instance();
-    if (!otIp6IsEnabled(ins)) {
-        ESP_GOTO_ON_FALSE(OT_ERROR_NONE == (ret = otIp6SetEnabled(ins, true)), ret, exit, API_TAG,
-                          "Failed to enable IPv6 interface for scanning");
-    }
-    ESP_GOTO_ON_FALSE(OT_ERROR_NONE ==
-                          (ret = otThreadDiscover(ins, scanChannels, OT_PANID_BROADCAST, false, false,
-                                                  &handle_active_scan_event, NULL)),
-                      ret, exit, API_TAG, "Failed to discover network");
+    if (!s_available_network_scanning) {
+        if (!otIp6IsEnabled(ins)) {
+            ESP_GOTO_ON_FALSE(OT_ERROR_NONE == (ret = otIp6SetEnabled(ins, true)), ret, exit, API_TAG,
+                              "Failed to enable IPv6 interface for scanning");
+        }
+        xEventGroupClearBits(s_available_network_events, AVAILABLE_NETWORK_SCAN_DONE_BIT);
+        s_available_network_scan_seq = available_network_cache_seq();
+        ESP_GOTO_ON_FALSE(OT_ERROR_NONE ==
+                              (ret = otThreadDiscover(ins, channel_mask, OT_PANID_BROADCAST, false, false,
+                                                      &handle_active_scan_event, NULL)),
+                          ret, exit, API_TAG, "Failed to discover network");
+        s_available_network_scanning = true;
+    }
+    *start_seq = s_available_network_scan_seq;
 exit:
     esp_openthread_lock_release();
     return ret;
 }
 
-cJSON *handle_openthread_available_network_request(void)
+static otError available_network_cache_foreach(uint32_t *seq, available_network_handler_t handler, void *context)
 {
-    otError ret = OT_ERROR_NONE;
-    cJSON *networks = cJSON_CreateArray();
+    thread_network_information_t network;
+
+    while (available_network_cache_next(*seq, &network, seq)) {
+        ESP_RETURN_ON_FALSE(handler(&network, context) == ESP_OK, OT_ERROR_FAILED, API_TAG,
+                            "Failed to handle network %u", network.id);
+    }
+    return OT_ERROR_NONE;
+}
 
-    destroy_available_thread_networks_list(s_networkList);
+otError handle_openthread_available_network_scan(uint32_t channel_mask, uint32_t timeout_ms,
+                                                 available_network_handler_t handler, void *context, bool *complete)
+{
+    otError ret = OT_ERROR_NONE;
+    uint32_t seq = 0;
+    EventBits_t bits = 0;
 
-    s_networkList = (thread_network_list_t *)malloc(sizeof(thread_network_list_t));
-    ESP_GOTO_ON_FALSE(s_networkList, OT_ERROR_NO_BUFS, exit, API_TAG, "Failed to alloc network list");
-    s_networkList_count = 0;
+    if (timeout_ms == 0) {
+        uint32_t channels = channel_mask ? channel_mask : OT_RADIO_2P4GHZ_OQPSK_CHANNEL_MASK;
+        timeout_ms = __builtin_popcount(channels) * AVAILABLE_NETWORK_CHANNEL_MS + AVAILABLE_NETWORK_MARGIN_MS;
+    }
+    ESP_RETURN_ON_FALSE(!(channel_mask & ~OT_RADIO_2P4GHZ_OQPSK_CHANNEL_MASK) &&
+                            timeout_ms <= AVAILABLE_NETWORK_MAX_TIMEOUT_MS,
+                        OT_ERROR_INVALID_ARGS, API_TAG, "Invalid scan channels 0x%08" PRIx32 " or timeout %" PRIu32,
+                        channel_mask, timeout_ms);
+    ESP_RETURN_ON_ERROR(get_openthread_available_networks(channel_mask, &seq), API_TAG,
+                        "Failed to get thread network list");
+    int64_t deadline = esp_timer_get_time() + (int64_t)timeout_ms * 1000;
+    do {
+        int64_t wait_ms = (deadline - esp_timer_get_time()) / 1000 + 1;
+        if (wait_ms > AVAILABLE_NETWORK_POLL_MS) {
+            wait_ms = AVAILABLE_NETWORK_POLL_MS;
+        }
+        bits = xEventGroupWaitBits(s_available_network_events,
+                                   AVAILABLE_NETWORK_SCAN_DONE_BIT | AVAILABLE_NETWORK_SCAN_RESULT_BIT, pdFALSE,
+                                   pdFALSE, pdMS_TO_TICKS(wait_ms));
+        /* Results missed by a concurrent reader clearing the bit are picked up by the next poll. */
+        xEventGroupClearBits(s_available_network_events, AVAILABLE_NETWORK_SCAN_RESULT_BIT);
+        if (handler) {
+            ESP_RETURN_ON_ERROR(available_network_cache_foreach(&seq, handler, context), API_TAG,
+                                "Failed to stream the networks");
+        }
+    } while (!(bits & AVAILABLE_NETWORK_SCAN_DONE_BIT) && esp_timer_get_time() < deadline);
 
-    initialize_available_thread_networks_list(s_networkList);
+    *complete = bits & AVAILABLE_NETWORK_SCAN_DONE_BIT;
+    if (!*complete) {
+        ESP_LOGW(API_TAG, "Discover did not complete in %" PRIu32 " ms", timeout_ms);
+    }
+    return ret;
+}
 
-    ESP_GOTO_ON_FALSE(!get_openthread_available_networks(), OT_ERROR_FAILED, exit, API_TAG,
-                      "Failed to get thread network list");
-    xSemaphoreTake(s_discover_done_semaphore, portMAX_DELAY);
+otError handle_openthread_available_network_cache(available_network_handler_t handler, void *context)
+{
+    uint32_t seq = 0;
+    return available_network_cache_foreach(&seq, handler, context);
+}
 
-    ESP_GOTO_ON_FALSE(s_networkList, OT_ERROR_INVALID_ARGS, exit, API_TAG, "Invalid network list");
+static esp_err_t available_network_append(const thread_network_information_t *network, void *context)
+{
+    cJSON *node = available_network_struct_convert2_json(network);
+    ESP_RETURN_ON_FALSE(node, ESP_ERR_NO_MEM, API_TAG, "Failed to convert network");
+    cJSON_AddItemToArray((cJSON *)context, node);
+    return ESP_OK;
+}
 
-    thread_network_list_t *head = s_networkList->next; /* skip head node */
+cJSON *handle_openthread_available_network_request(uint32_t channel_mask, uint32_t timeout_ms, bool scan)
+{
+    otError ret = OT_ERROR_NONE;
+    bool complete = true;
+    cJSON *networks = cJSON_CreateArray();
 
-    while (head != NULL) {
-        cJSON *node = available_network_struct_convert2_json(head->network);
-        cJSON_AddItemToArray(networks, node);
-        head = head->next;
+    ESP_GOTO_ON_FALSE(networks, OT_ERROR_NO_BUFS, exit, API_TAG, "Failed to alloc network list");
+    if (scan) {
+        ESP_GOTO_ON_ERROR(handle_openthread_available_network_scan(channel_mask, timeout_ms, NULL, NULL, &complete),
+                          exit, API_TAG, "Failed to discover networks");
     }
+    ret = handle_openthread_available_network_cache(available_network_append, networks);
 
 exit:
     if (ret) {
@@ -583,6 +843,99 @@ exit:
     return networks;
 }
 
+/*----------------------------------------------------------------------
+                          channel survey
+----------------------------------------------------------------------*/
+#define CHANNEL_CHANGE_DEFAULT_DELAY_MS 300000
+#define CHANNEL_CHANGE_MIN_DELAY_MS 30000 /* the minimal delay timer of a pending dataset */
+#define CHANNEL_CHANGE_TIMEOUT_MS 5000    /* the time for the leader to respond to MGMT_PENDING_SET */
+static otError s_channel_change_result = OT_ERROR_NONE;
+/* s_channel_change_semaphore is initialized in esp_br_web_api_init() */
+
+cJSON *handle_ot_resource_channel_survey_request(void)
+{
+    return channel_survey_convert2_json();
+}
+
+otError handle_ot_resource_channel_survey_post_request(uint32_t duration_ms, uint16_t scan_ms)
+{
+    esp_err_t err = channel_survey_run(duration_ms, scan_ms);
+    return err == ESP_OK                    ? OT_ERROR_NONE
+           : err == ESP_ERR_INVALID_ARG   ? OT_ERROR_INVALID_ARGS
+           : err == ESP_ERR_INVALID_STATE ? OT_ERROR_INVALID_STATE
+                                          : OT_ERROR_FAILED;
+}
+
+static void channel_change_handler(otError aResult, void *aContext)
+{
+    s_channel_change_result = aResult;
+    xSemaphoreGive(s_channel_change_semaphore);
+}
+
+otError handle_ot_resource_channel_survey_put_request(const cJSON *request)
+{
+    otError ret = OT_ERROR_NONE;
+    const cJSON *channel_json = cJSON_GetObjectItemCaseSensitive(request, "Channel");
+    const cJSON *delay_json = cJSON_GetObjectItemCaseSensitive(request, "Delay");
+    uint8_t channel = channel_json ? 0 : channel_survey_recommended();
+    uint32_t delay = CHANNEL_CHANGE_DEFAULT_DELAY_MS;
+    otOperationalDataset active;
+    otOperationalDataset pending;
+    otOperationalDataset dataset;
+
+    if (channel_json) {
+        ESP_RETURN_ON_FALSE(cJSON_IsNumber(channel_json) && channel_json->valueint >= 11 &&
+                                channel_json->valueint <= 26,
+                            OT_ERROR_INVALID_ARGS, API_TAG, "Invalid channel");
+        channel = channel_json->valueint;
+    }
+    ESP_RETURN_ON_FALSE(channel, OT_ERROR_INVALID_STATE, API_TAG, "No channel survey to recommend a channel");
+    if (delay_json) {
+        ESP_RETURN_ON_FALSE(cJSON_IsNumber(delay_json) && delay_json->valuedouble >= CHANNEL_CHANGE_MIN_DELAY_MS &&
+                                delay_json->valuedouble <= UINT32_MAX,
+                            OT_ERROR_INVALID_ARGS, API_TAG, "Invalid delay");
+        delay = (uint32_t)delay_json->valuedouble;
+    }
+
+    memset(&dataset, 0, sizeof(dataset));
+    esp_openthread_lock_acquire(portMAX_DELAY);
+    otInstance *ins = esp_openthread_get_instance();
+    ESP_GOTO_ON_FALSE(otThreadGetDeviceRole(ins) >= OT_DEVICE_ROLE_CHILD, OT_ERROR_INVALID_STATE, exit, API_TAG,
+                      "Not attached to a Thread network");
+    ERROR_EXIT(otDatasetGetActive(ins, &active), exit, API_TAG, "Failed to get the active dataset");
+    ESP_GOTO_ON_FALSE(active.mChannel != channel, OT_ERROR_INVALID_ARGS, exit, API_TAG, "Already on channel %u",
+                      channel);
+    /* The new active dataset and the pending dataset carrying it must both be newer than the current ones. */
+    dataset.mActiveTimestamp = active.mActiveTimestamp;
+    dataset.mActiveTimestamp.mSeconds++;
+    dataset.mComponents.mIsActiveTimestampPresent = true;
+    dataset.mPendingTimestamp = active.mActiveTimestamp;
+    if (otDatasetGetPending(ins, &pending) == OT_ERROR_NONE && pending.mComponents.mIsPendingTimestampPresent &&
+        pending.mPendingTimestamp.mSeconds >= dataset.mPendingTimestamp.mSeconds) {
+        dataset.mPendingTimestamp = pending.mPendingTimestamp;
+    }
+    dataset.mPendingTimestamp.mSeconds++;
+    dataset.mComponents.mIsPendingTimestampPresent = true;
+    dataset.mChannel = channel;
+    dataset.mComponents.mIsChannelPresent = true;
+    dataset.mDelay = delay;
+    dataset.mComponents.mIsDelayPresent = true;
+    xSemaphoreTake(s_channel_change_semaphore, 0);
+    ERROR_EXIT(otDatasetSendMgmtPendingSet(ins, &dataset, NULL, 0, channel_change_handler, NULL), exit, API_TAG,
+               "Failed to send the pending dataset");
+    esp_openthread_lock_release();
+
+    ESP_RETURN_ON_FALSE(xSemaphoreTake(s_channel_change_semaphore, pdMS_TO_TICKS(CHANNEL_CHANGE_TIMEOUT_MS)) == pdTRUE,
+                        OT_ERROR_RESPONSE_TIMEOUT, API_TAG, "No response to the pending dataset");
+    ESP_RETURN_ON_FALSE(s_channel_change_result == OT_ERROR_NONE, s_channel_change_result, API_TAG,
+                        "Pending dataset rejected: %s", otThreadErrorToString(s_channel_change_result));
+    ESP_LOGI(API_TAG, "Channel change to %u in %lu ms", channel, (unsigned long)delay);
+    return OT_ERROR_NONE;
+exit:
+    esp_openthread_lock_release();
+    return ret;
+}
+
 /*----------------------------------------------------------------------
                        form thread network
 ----------------------------------------------------------------------*/
@@ -595,6 +948,11 @@ otError handle_openthread_form_network_request(const cJSON *request, cJSON *log)
     ESP_RETURN_ON_FALSE(!network_formation_param_json_convert2_struct(request, log, &param), OT_ERROR_INVALID_ARGS,
                         API_TAG, "Failed to parse FORM request");
 
+    if (param.channel == 0 && channel_survey_recommended() == 0) {
+        cJSON_SetValuestring(log, "Error: Run the channel survey first");
+        return OT_ERROR_INVALID_STATE;
+    }
+
     otInstance *ins = esp_openthread_get_instance();
     otOperationalDataset dataset;
     add_prefix_field(param.on_mesh_prefix);
@@ -610,7 +968,7 @@ otError handle_openthread_form_network_request(const cJSON *request, cJSON *log)
     ERROR_EXIT(otDatasetCreateNewNetwork(ins, &dataset), exit, API_TAG, "Failed to create new network");
     dataset.mNetworkName = param.network_name;
     dataset.mNetworkKey = param.network_key;
-    dataset.mChannel = param.channel;
+    dataset.mChannel = param.channel ? param.channel : channel_survey_recommended();
     dataset.mExtendedPanId = param.extended_panid;
     dataset.mPanId = param.panid;
     ESP_LOGI(API_TAG, "dataset init new");
@@ -661,6 +1019,15 @@ static void join_network_handler(otError error, void *context)
     }
 }
 
+static otError network_data_register(void)
+{
+#if OPENTHREAD_CONFIG_BORDER_ROUTER_ENABLE
+    return otBorderRouterRegister(esp_openthread_get_instance());
+#else
+    return otServerRegister(esp_openthread_get_instance());
+#endif
+}
+
 static esp_err_t network_prefix_add(otBorderRouterConfig *config)
 {
     char prefix_str[OT_IP6_ADDRESS_STRING_SIZE];
@@ -676,8 +1043,7 @@ otError handle_openthread_join_network_request(const cJSON *request, cJSON *log)
 {
     otError ret = OT_ERROR_NONE;
     thread_network_join_param_t param;
-    thread_network_list_t *list = s_networkList;
-    uint8_t count = s_networkList_count;
+    thread_network_information_t network;
     otOperationalDataset dataset;
     otBorderRouterConfig config;
     otInstance *ins = esp_openthread_get_instance();
@@ -688,19 +1054,9 @@ otError handle_openthread_join_network_request(const cJSON *request, cJSON *log)
                         "Failed to parse JOIN request");
     /* join active dataset */
     if (!memcmp(param.credentialType, CREDENTIAL_TYPE_NETWORK_KEY, sizeof(CREDENTIAL_TYPE_NETWORK_KEY))) {
-        cJSON_SetValuestring(log, "Warning: Click `scan` and Try against");
-        ESP_RETURN_ON_FALSE(list && count, OT_ERROR_INVALID_ARGS, API_TAG,
-                            "Try against after scanning the available network");
-        cJSON_SetValuestring(log, "Error: Invalid Index");
-        ESP_RETURN_ON_FALSE(param.index <= count, OT_ERROR_INVALID_ARGS, API_TAG, "Error: Invalid index[%d]",
-                            param.index);
-        while (list) {
-            if (list->network->id == param.index)
-                break;
-            list = list->next;
-        }
-        cJSON_SetValuestring(log, "Error: Can not find network");
-        ESP_RETURN_ON_FALSE(list, OT_ERROR_INVALID_STATE, API_TAG, "Cannot find network, try against");
+        cJSON_SetValuestring(log, "Error: Can not find network, scan again");
+        ESP_RETURN_ON_FALSE(available_network_cache_find(&param, &network), OT_ERROR_INVALID_STATE, API_TAG,
+                            "Cannot find network, try against");
 
         esp_openthread_lock_acquire(portMAX_DELAY);
 
@@ -708,10 +1064,12 @@ otError handle_openthread_join_network_request(const cJSON *request, cJSON *log)
         ERROR_EXIT(otIp6SetEnabled(ins, false), exit, API_TAG, "Failed to set ifconfig down");
 
         memset(&dataset, 0, sizeof(otOperationalDataset));
-        dataset.mChannel = list->network->channel;
+        dataset.mChannel = network.channel;
         dataset.mComponents.mIsChannelPresent = true;
-        dataset.mPanId = list->network->panid;
+        dataset.mPanId = network.panid;
         dataset.mComponents.mIsPanIdPresent = true;
+        dataset.mExtendedPanId = network.extended_panid;
+        dataset.mComponents.mIsExtendedPanIdPresent = true;
         dataset.mNetworkKey = param.networkKey;
         dataset.mComponents.mIsNetworkKeyPresent = true;
 
@@ -754,6 +1112,7 @@ otError handle_openthread_join_network_request(const cJSON *request, cJSON *log)
         ERROR_EXIT(parse_ipv6_prefix_from_string(param.prefix, &config.mPrefix), exit, API_TAG,
                    "Failed to parse prefix");
         ERROR_EXIT(network_prefix_add(&config), exit, API_TAG, "Failed to add thread prefix");
+        ERROR_EXIT(network_data_register(), exit, API_TAG, "Failed to register in data net");
     }
 
 exit:
@@ -797,11 +1156,7 @@ otError handle_openthread_add_network_prefix_request(const cJSON *request)
                         "Failed to parse prefix");
     esp_openthread_lock_acquire(portMAX_DELAY);
     ERROR_EXIT(network_prefix_add(&config), exit, API_TAG, "Failed to add thread prefix");
-#if OPENTHREAD_CONFIG_BORDER_ROUTER_ENABLE
-    ERROR_EXIT(otBorderRouterRegister(esp_openthread_get_instance()), exit, API_TAG, "Failed to register in data net");
-#else
-    ERROR_EXIT(otServerRegister(esp_openthread_get_instance()), exit, API_TAG, "Failed to register in data net");
-#endif
+    ERROR_EXIT(network_data_register(), exit, API_TAG, "Failed to register in data net");
 
 exit:
     esp_openthread_lock_release();
@@ -825,23 +1180,282 @@ otError handle_openthread_delete_network_prefix_request(const cJSON *request)
     esp_openthread_lock_acquire(portMAX_DELAY);
     ERROR_EXIT(otBorderRouterRemoveOnMeshPrefix(esp_openthread_get_instance(), &ip6_prefix), exit, API_TAG,
                "Failed to remove thread prefix");
-#if OPENTHREAD_CONFIG_BORDER_ROUTER_ENABLE
-    ERROR_EXIT(otBorderRouterRegister(esp_openthread_get_instance()), exit, API_TAG, "Failed to register in data net");
-#else
-    ERROR_EXIT(otServerRegister(esp_openthread_get_instance()), exit, API_TAG, "Failed to register in data net");
-#endif
+    ERROR_EXIT(network_data_register(), exit, API_TAG, "Failed to register in data net");
 
 exit:
     esp_openthread_lock_release();
     return ret;
 }
 
+/*----------------------------------------------------------------------
+                    thread network data batch
+----------------------------------------------------------------------*/
+#define NETDATA_BATCH_MAX_OPERATIONS 32
+
+typedef enum {
+    NETDATA_OP_ADD_PREFIX,
+    NETDATA_OP_REMOVE_PREFIX,
+    NETDATA_OP_ADD_ROUTE,
+    NETDATA_OP_REMOVE_ROUTE,
+} netdata_op_type_t;
+
+typedef enum {
+    NETDATA_OP_STATE_SKIPPED,
+    NETDATA_OP_STATE_APPLIED,
+    NETDATA_OP_STATE_FAILED,
+    NETDATA_OP_STATE_ROLLED_BACK,
+} netdata_op_state_t;
+
+typedef struct {
+    netdata_op_type_t type;
+    otBorderRouterConfig prefix;
+    otExternalRouteConfig route;
+    bool existed; /* The entry existed in the local network data before the operation, restored by rollback */
+    otBorderRouterConfig old_prefix;
+    otExternalRouteConfig old_route;
+    netdata_op_state_t state;
+    otError error;
+} netdata_op_t;
+
+static bool netdata_prefix_equal(const otIp6Prefix *a, const otIp6Prefix *b)
+{
+    return a->mLength == b->mLength && memcmp(&a->mPrefix, &b->mPrefix, sizeof(a->mPrefix)) == 0;
+}
+
+static int netdata_parse_preference(const cJSON *value)
+{
+    const char *str = cJSON_GetStringValue(value);
+    if (str && strcmp(str, "high") == 0) {
+        return OT_ROUTE_PREFERENCE_HIGH;
+    } else if (str && strcmp(str, "low") == 0) {
+        return OT_ROUTE_PREFERENCE_LOW;
+    }
+    return OT_ROUTE_PREFERENCE_MED;
+}
+
+static bool netdata_parse_bool(const cJSON *item, const char *name, bool default_value)
+{
+    const cJSON *value = cJSON_GetObjectItemCaseSensitive(item, name);
+    return cJSON_IsBool(value) ? cJSON_IsTrue(value) : default_value;
+}
+
+static esp_err_t netdata_parse_op(const cJSON *item, netdata_op_t *op)
+{
+    char str_prefix[OT_IP6_PREFIX_STRING_SIZE];
+    const char *action = cJSON_GetStringValue(cJSON_GetObjectItemCaseSensitive(item, "op"));
+    const char *type = cJSON_GetStringValue(cJSON_GetObjectItemCaseSensitive(item, "type"));
+    const char *prefix = cJSON_GetStringValue(cJSON_GetObjectItemCaseSensitive(item, "prefix"));
+    otIp6Prefix ip6_prefix;
+
+    memset(op, 0, sizeof(*op));
+    ESP_RETURN_ON_FALSE(action && type && prefix, ESP_ERR_INVALID_ARG, API_TAG, "Invalid network data operation");
+    ESP_RETURN_ON_FALSE(strlen(prefix) + strlen("/64") < OT_IP6_PREFIX_STRING_SIZE, ESP_ERR_INVALID_ARG, API_TAG,
+                        "Prefix too long");
+    strcpy(str_prefix, prefix);
+    ESP_RETURN_ON_ERROR(parse_ipv6_prefix_from_string(str_prefix, &ip6_prefix), API_TAG, "Failed to parse prefix");
+
+    if (strcmp(type, "prefix") == 0) {
+        op->prefix.mPrefix = ip6_prefix;
+        op->prefix.mPreference = netdata_parse_preference(cJSON_GetObjectItemCaseSensitive(item, "preference"));
+        op->prefix.mPreferred = netdata_parse_bool(item, "preferred", true);
+        op->prefix.mSlaac = netdata_parse_bool(item, "slaac", true);
+        op->prefix.mOnMesh = netdata_parse_bool(item, "onMesh", true);
+        op->prefix.mStable = netdata_parse_bool(item, "stable", true);
+        op->prefix.mDefaultRoute = netdata_parse_bool(item, "defaultRoute", false);
+        op->prefix.mDhcp = netdata_parse_bool(item, "dhcp", false);
+        op->prefix.mConfigure = netdata_parse_bool(item, "configure", false);
+        op->type = NETDATA_OP_ADD_PREFIX;
+    } else if (strcmp(type, "route") == 0) {
+        op->route.mPrefix = ip6_prefix;
+        op->route.mPreference = netdata_parse_preference(cJSON_GetObjectItemCaseSensitive(item, "preference"));
+        op->route.mStable = netdata_parse_bool(item, "stable", true);
+        op->route.mNat64 = netdata_parse_bool(item, "nat64", false);
+        op->type = NETDATA_OP_ADD_ROUTE;
+    } else {
+        ESP_LOGE(API_TAG, "Invalid network data type: %s", type);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (strcmp(action, "remove") == 0) {
+        op->type = op->type == NETDATA_OP_ADD_PREFIX ? NETDATA_OP_REMOVE_PREFIX : NETDATA_OP_REMOVE_ROUTE;
+    } else if (strcmp(action, "add") != 0) {
+        ESP_LOGE(API_TAG, "Invalid network data op: %s", action);
+        return ESP_ERR_INVALID_ARG;
+    }
+    return ESP_OK;
+}
+
+/* Save the current local entry of the prefix, so that the operation can be reverted. */
+static void netdata_snapshot(otInstance *ins, netdata_op_t *op)
+{
+    otNetworkDataIterator iterator = OT_NETWORK_DATA_ITERATOR_INIT;
+
+    if (op->type == NETDATA_OP_ADD_PREFIX || op->type == NETDATA_OP_REMOVE_PREFIX) {
+        while (otBorderRouterGetNextOnMeshPrefix(ins, &iterator, &op->old_prefix) == OT_ERROR_NONE) {
+            if (netdata_prefix_equal(&op->old_prefix.mPrefix, &op->prefix.mPrefix)) {
+                op->existed = true;
+                return;
+            }
+        }
+    } else {
+        while (otBorderRouterGetNextRoute(ins, &iterator, &op->old_route) == OT_ERROR_NONE) {
+            if (netdata_prefix_equal(&op->old_route.mPrefix, &op->route.mPrefix)) {
+                op->existed = true;
+                return;
+            }
+        }
+    }
+}
+
+static otError netdata_apply(otInstance *ins, netdata_op_t *op)
+{
+    switch (op->type) {
+    case NETDATA_OP_ADD_PREFIX:
+        return otBorderRouterAddOnMeshPrefix(ins, &op->prefix);
+    case NETDATA_OP_REMOVE_PREFIX:
+        return otBorderRouterRemoveOnMeshPrefix(ins, &op->prefix.mPrefix);
+    case NETDATA_OP_ADD_ROUTE:
+        return otBorderRouterAddRoute(ins, &op->route);
+    case NETDATA_OP_REMOVE_ROUTE:
+        return otBorderRouterRemoveRoute(ins, &op->route.mPrefix);
+    default:
+        return OT_ERROR_INVALID_ARGS;
+    }
+}
+
+static void netdata_revert(otInstance *ins, const netdata_op_t *op)
+{
+    if (op->type == NETDATA_OP_ADD_PREFIX || op->type == NETDATA_OP_REMOVE_PREFIX) {
+        if (op->existed) {
+            otBorderRouterAddOnMeshPrefix(ins, &op->old_prefix);
+        } else {
+            otBorderRouterRemoveOnMeshPrefix(ins, &op->prefix.mPrefix);
+        }
+    } else {
+        if (op->existed) {
+            otBorderRouterAddRoute(ins, &op->old_route);
+        } else {
+            otBorderRouterRemoveRoute(ins, &op->route.mPrefix);
+        }
+    }
+}
+
+static const char *netdata_op_state_to_string(netdata_op_state_t state)
+{
+    switch (state) {
+    case NETDATA_OP_STATE_APPLIED:
+        return "applied";
+    case NETDATA_OP_STATE_FAILED:
+        return "failed";
+    case NETDATA_OP_STATE_ROLLED_BACK:
+        return "rolledBack";
+    default:
+        return "skipped";
+    }
+}
+
+cJSON *handle_ot_resource_node_netdata_batch_request(const cJSON *request, cJSON *log)
+{
+    cJSON *response = NULL;
+    cJSON *results = NULL;
+    netdata_op_t *ops = NULL;
+    uint16_t errcode = 200;
+    int count = 0;
+    int applied = 0;
+    int failed_index = -1;
+    bool registered = false;
+    otError register_error = OT_ERROR_NONE;
+    otInstance *ins = esp_openthread_get_instance();
+    const cJSON *operations = cJSON_GetObjectItemCaseSensitive(request, "operations");
+
+    if (!cJSON_IsArray(operations) || (count = cJSON_GetArraySize(operations)) == 0 ||
+        count > NETDATA_BATCH_MAX_OPERATIONS) {
+        ESP_LOGE(API_TAG, "Invalid network data operations");
+        errcode = 400;
+        goto exit;
+    }
+    ops = calloc(count, sizeof(netdata_op_t));
+    if (ops == NULL) {
+        errcode = 500;
+        goto exit;
+    }
+
+    /* Validate the whole batch before touching the network data. */
+    for (int i = 0; i < count; i++) {
+        if (netdata_parse_op(cJSON_GetArrayItem(operations, i), &ops[i]) != ESP_OK) {
+            ops[i].state = NETDATA_OP_STATE_FAILED;
+            ops[i].error = OT_ERROR_INVALID_ARGS;
+            failed_index = i;
+            errcode = 400;
+            break;
+        }
+    }
+
+    if (failed_index < 0) {
+        esp_openthread_lock_acquire(portMAX_DELAY);
+        for (int i = 0; i < count; i++) {
+            netdata_snapshot(ins, &ops[i]);
+            ops[i].error = netdata_apply(ins, &ops[i]);
+            if (ops[i].error != OT_ERROR_NONE) {
+                ops[i].state = NETDATA_OP_STATE_FAILED;
+                failed_index = i;
+                break;
+            }
+            ops[i].state = NETDATA_OP_STATE_APPLIED;
+            applied++;
+        }
+        if (failed_index >= 0) {
+            /* Revert in the reverse order, so that the local network data is left untouched. */
+            for (int i = failed_index - 1; i >= 0; i--) {
+                netdata_revert(ins, &ops[i]);
+                ops[i].state = NETDATA_OP_STATE_ROLLED_BACK;
+            }
+            applied = 0;
+            errcode = ops[failed_index].error == OT_ERROR_NOT_FOUND ? 404 : 409;
+        } else {
+            register_error = network_data_register();
+            registered = register_error == OT_ERROR_NONE;
+            if (!registered) {
+                ESP_LOGE(API_TAG, "Failed to register in data net: %s", otThreadErrorToString(register_error));
+                errcode = 500;
+            }
+        }
+        esp_openthread_lock_release();
+    }
+
+    response = cJSON_CreateObject();
+    results = cJSON_AddArrayToObject(response, "results");
+    for (int i = 0; i < count; i++) {
+        cJSON *result = cJSON_CreateObject();
+        cJSON_AddStringToObject(result, "state", netdata_op_state_to_string(ops[i].state));
+        if (ops[i].state == NETDATA_OP_STATE_FAILED) {
+            cJSON_AddStringToObject(result, "error", otThreadErrorToString(ops[i].error));
+        }
+        cJSON_AddItemToArray(results, result);
+    }
+    cJSON_AddNumberToObject(response, "applied", applied);
+    cJSON_AddNumberToObject(response, "registrations", registered ? 1 : 0);
+    if (register_error != OT_ERROR_NONE) {
+        cJSON_AddStringToObject(response, "registerError", otThreadErrorToString(register_error));
+    }
+    /* The per-request handlers register the network data once per operation, each bumping the version. */
+    cJSON_AddNumberToObject(response, "versionBumpsAvoided", registered && applied > 1 ? applied - 1 : 0);
+
+exit:
+    free(ops);
+    cJSON_AddItemToObject(log, "ErrorCode", cJSON_CreateNumber(errcode));
+    return response;
+}
+
 /*----------------------------------------------------------------------
                     thread network commission
 ----------------------------------------------------------------------*/
 static void handle_commissioner_state_changed(otCommissionerState state, void *ctx)
 {
     ESP_LOGW(API_TAG, "Commissioner State: %d", state);
+#if CONFIG_OPENTHREAD_COMMISSION_JOB
+    esp_ot_commission_job_handle_state(state, ctx);
+#endif
 }
 static void handle_commissioner_join_event(otCommissionerJoinerEvent event, const otJoinerInfo *info,
                                            const otExtAddress *address, void *aContext)
@@ -859,6 +1473,9 @@ static void handle_commissioner_join_event(otCommissionerJoinerEvent event, cons
         ESP_LOGI(API_TAG, "Commissioner: Joiner address %x:%x:%x:%x:%x:%x:%x:%x", address->m8[7], address->m8[6],
                  address->m8[5], address->m8[4], address->m8[3], address->m8[2], address->m8[1], address->m8[0]);
     }
+#if CONFIG_OPENTHREAD_COMMISSION_JOB
+    esp_ot_commission_job_handle_joiner_event(event, info, address, aContext);
+#endif
 }
 
 otError handle_openthread_network_commission_request(const cJSON *request)
@@ -906,6 +1523,145 @@ exit:
     return ret;
 }
 
+#if CONFIG_OPENTHREAD_COMMISSION_JOB
+/*----------------------------------------------------------------------
+                    bulk joiner commissioning job
+----------------------------------------------------------------------*/
+/* Must be called with the OpenThread lock held. */
+static cJSON *commissioner_job_to_json(void)
+{
+    esp_ot_commission_job_status_t status;
+    const esp_ot_commission_joiner_t *joiner = NULL;
+    char id[2 * OT_EXT_ADDRESS_SIZE + 1];
+    cJSON *root = cJSON_CreateObject();
+    cJSON *joiners = cJSON_CreateArray();
+
+    esp_ot_commission_job_get_status(&status);
+    cJSON_AddStringToObject(root, "state", esp_ot_commission_job_state_to_string(status.state));
+    cJSON_AddNumberToObject(root, "total", status.total);
+    cJSON_AddNumberToObject(root, "pending", status.pending);
+    cJSON_AddNumberToObject(root, "added", status.added);
+    cJSON_AddNumberToObject(root, "joined", status.joined);
+    cJSON_AddNumberToObject(root, "failed", status.failed);
+    cJSON_AddNumberToObject(root, "retries", status.retries);
+    cJSON_AddNumberToObject(root, "elapsedMs", status.elapsed_ms);
+    cJSON_AddNumberToObject(root, "joinsPerMinute", status.joins_per_min_x10 / 10.0);
+
+    for (uint16_t i = 0; (joiner = esp_ot_commission_job_get_joiner(i)) != NULL; i++) {
+        cJSON *item = cJSON_CreateObject();
+        if (joiner->type == OT_JOINER_INFO_TYPE_DISCERNER) {
+            char discerner[32];
+            snprintf(discerner, sizeof(discerner), "0x%llx/%u", (unsigned long long)joiner->discerner.mValue,
+                     joiner->discerner.mLength);
+            cJSON_AddStringToObject(item, "discerner", discerner);
+        } else {
+            for (int j = 0; j < OT_EXT_ADDRESS_SIZE; j++) {
+                sprintf(&id[2 * j], "%02x", joiner->eui64.m8[j]);
+            }
+            cJSON_AddStringToObject(item, "eui64", id);
+        }
+        cJSON_AddStringToObject(item, "state", esp_ot_commission_joiner_state_to_string(joiner->state));
+        cJSON_AddNumberToObject(item, "sessions", joiner->sessions);
+        cJSON_AddNumberToObject(item, "retries", joiner->retries);
+        cJSON_AddNumberToObject(item, "joinedMs", joiner->joined_ms);
+        cJSON_AddItemToArray(joiners, item);
+    }
+    cJSON_AddItemToObject(root, "joiners", joiners);
+    return root;
+}
+
+static esp_err_t commissioner_job_add_json(const cJSON *joiners)
+{
+    const cJSON *joiner = NULL;
+
+    ESP_RETURN_ON_FALSE(cJSON_IsArray(joiners), ESP_ERR_INVALID_ARG, API_TAG, "Invalid joiners");
+    cJSON_ArrayForEach(joiner, joiners)
+    {
+        const char *id = cJSON_GetStringValue(cJSON_GetObjectItemCaseSensitive(joiner, "eui64"));
+        if (id == NULL) {
+            id = cJSON_GetStringValue(cJSON_GetObjectItemCaseSensitive(joiner, "discerner"));
+        }
+        const char *pskd = cJSON_GetStringValue(cJSON_GetObjectItemCaseSensitive(joiner, "pskd"));
+        ESP_RETURN_ON_FALSE(id && pskd, ESP_ERR_INVALID_ARG, API_TAG, "Invalid joiner");
+        ESP_RETURN_ON_ERROR(esp_ot_commission_job_add(id, pskd), API_TAG, "Failed to add joiner %s", id);
+    }
+    return ESP_OK;
+}
+
+cJSON *handle_ot_resource_node_commissioner_job_get_request(void)
+{
+    cJSON *root = NULL;
+
+    esp_openthread_lock_acquire(portMAX_DELAY);
+    root = commissioner_job_to_json();
+    esp_openthread_lock_release();
+    return root;
+}
+
+cJSON *handle_ot_resource_node_commissioner_job_post_request(const cJSON *request, char *csv, cJSON *log)
+{
+    cJSON *response = NULL;
+    uint16_t errcode = 200;
+    uint32_t timeout = ESP_OT_COMMISSION_JOB_DEFAULT_TIMEOUT;
+    uint8_t retries = ESP_OT_COMMISSION_JOB_DEFAULT_RETRIES;
+    esp_ot_commission_job_status_t status;
+    esp_err_t err = ESP_OK;
+
+    cJSON *value = cJSON_GetObjectItemCaseSensitive(request, "timeout");
+    if (value) {
+        if (!cJSON_IsNumber(value) || value->valuedouble < 1.0 || value->valuedouble > UINT32_MAX) {
+            errcode = 400;
+            goto exit;
+        }
+        timeout = (uint32_t)value->valuedouble;
+    }
+    value = cJSON_GetObjectItemCaseSensitive(request, "retries");
+    if (value) {
+        if (!cJSON_IsNumber(value) || value->valuedouble < 0.0 || value->valuedouble > UINT8_MAX) {
+            errcode = 400;
+            goto exit;
+        }
+        retries = (uint8_t)value->valuedouble;
+    }
+
+    esp_openthread_lock_acquire(portMAX_DELAY);
+    esp_ot_commission_job_get_status(&status);
+    if (status.state != ESP_OT_COMMISSION_JOB_IDLE) {
+        errcode = 409;
+    } else {
+        if (csv) {
+            err = esp_ot_commission_job_add_csv(csv, NULL);
+        } else {
+            err = commissioner_job_add_json(cJSON_GetObjectItemCaseSensitive(request, "joiners"));
+        }
+        if (err == ESP_OK) {
+            err = esp_ot_commission_job_start(timeout, retries);
+            errcode = err == ESP_OK ? 200 : (err == ESP_ERR_INVALID_STATE ? 400 : 500);
+        } else {
+            errcode = 400;
+        }
+        if (err != ESP_OK) {
+            /* Drop the partially added joiners so that the request can be sent again. */
+            esp_ot_commission_job_clear();
+        } else {
+            response = commissioner_job_to_json();
+        }
+    }
+    esp_openthread_lock_release();
+
+exit:
+    cJSON_AddItemToObject(log, "ErrorCode", cJSON_CreateNumber(errcode));
+    return response;
+}
+
+void handle_ot_resource_node_commissioner_job_delete_request(void)
+{
+    esp_openthread_lock_acquire(portMAX_DELAY);
+    esp_ot_commission_job_clear();
+    esp_openthread_lock_release();
+}
+#endif // CONFIG_OPENTHREAD_COMMISSION_JOB
+
 /*----------------------------------------------------------------------
                        thread network Topology
 ----------------------------------------------------------------------*/
@@ -919,10 +1675,18 @@ static const char *kMulticastAddrAllRouters = "ff03::2";
 static volatile bool s_diag_collecting = false;           /* true while actively collecting responses */
 static volatile int s_diag_response_count = 0;            /* number of responses received this collection */
 static volatile TickType_t s_diag_last_response_tick = 0; /* tick of most recent response */
+static uint64_t s_diag_request_mask = 0;                  /* TLV types of the collection, the others are dropped */
+static thread_diagnostic_query_t s_diag_request;          /* target of the collection */
+static uint16_t s_diag_target_responded = 0;              /* bit n is set when the target n has responded */
 #define DIAG_QUIET_PERIOD_MS 3000                         /* stop after no new response for 3s */
 #define DIAG_MIN_WAIT_MS 2000                             /* always wait at least 2s */
 #define DIAG_MAX_TIMEOUT_MS 30000                         /* hard cap to avoid blocking forever */
 #define DIAG_POLL_INTERVAL_MS 500                         /* polling interval */
+#define DIAG_SNAPSHOT_MAX_AGE_MS 60000                    /* max age of the set kept for the next pages */
+static bool s_diag_snapshot_valid = false;                /* true while the set is kept for the next pages */
+static TickType_t s_diag_snapshot_tick = 0;               /* tick of the end of the kept collection */
+#define DIAG_TOPOLOGY_MAX_AGE_MS 30000                    /* max age of the topology version served by the deltas */
+static TickType_t s_topology_history_tick = 0;            /* tick of the collection of the latest topology version */
 
 /**
  * @brief Update the diagnostic Tlv set with @param key and @param diag_list
@@ -936,6 +1700,25 @@ static void update_diagnosticTlv(char *key, thread_diagnosticTlv_list_t *diag_li
     update_thread_diagnosticTlv_set(s_diagnosticTlv_set, key, head);
 }
 
+#if CONFIG_OPENTHREAD_LINK_QUALITY_STORE
+/**
+ * @brief Add the links of the Route TLV of @param reporter to the link quality history.
+ *
+ */
+static void link_quality_record_route(uint16_t reporter, const otNetworkDiagRoute *route)
+{
+    uint32_t now = esp_ot_link_quality_now();
+    for (uint8_t i = 0; i < route->mRouteCount; i++) {
+        const otNetworkDiagRouteData *data = &route->mRouteData[i];
+        uint16_t neighbor = (uint16_t)data->mRouterId << 10;
+        if (neighbor != reporter) {
+            esp_ot_link_quality_add_sample(reporter, neighbor, data->mLinkQualityIn, data->mLinkQualityOut,
+                                           data->mRouteCost, now);
+        }
+    }
+}
+#endif
+
 /**
  * @brief Get the result of Thread diagnostic for Thread's topology and update the diagnostic set.
  *
@@ -963,11 +1746,37 @@ static void get_diagnosticTlv_information(otError aError, const otMessage *aMess
             sprintf(rloc, "0x%04x", diagTlv.mData.mAddr16);
             strcpy(keyRloc, rloc);
         }
-        append_thread_diagnosticTlv_list(diag_list, diagTlv);
+#if CONFIG_OPENTHREAD_LINK_QUALITY_STORE
+        if (diagTlv.mType == OT_NETWORK_DIAGNOSTIC_TLV_ROUTE) {
+            const uint8_t *src = aMessageInfo->mPeerAddr.mFields.m8;
+            link_quality_record_route(((uint16_t)src[14] << 8) | src[15], &diagTlv.mData.mRoute);
+        }
+#endif
+#if CONFIG_OPENTHREAD_MAC_COUNTERS_STORE
+        if (diagTlv.mType == OT_NETWORK_DIAGNOSTIC_TLV_MAC_COUNTERS) {
+            const uint8_t *src = aMessageInfo->mPeerAddr.mFields.m8;
+            esp_ot_mac_counters_add_diag(((uint16_t)src[14] << 8) | src[15], &diagTlv.mData.mMacCounters,
+                                         (uint32_t)(esp_timer_get_time() / 1000000));
+        }
+#endif
+        /* Only store the requested TLVs, some nodes respond with more. */
+        if (diagTlv.mType < 64 && (s_diag_request_mask & (1ULL << diagTlv.mType))) {
+            append_thread_diagnosticTlv_list(diag_list, diagTlv);
+        }
     }
     update_diagnosticTlv(keyRloc, diag_list);
 }
 
+static int diagnostics_target_index(uint16_t rloc16)
+{
+    for (uint8_t i = 0; s_diag_request.target == DIAGNOSTIC_TARGET_LIST && i < s_diag_request.target_count; i++) {
+        if (s_diag_request.targets[i] == rloc16) {
+            return i;
+        }
+    }
+    return -1;
+}
+
 /**
  * @brief A callback for `otThreadSendDiagnosticGet()` to form the diagnostic set.
  *
@@ -996,9 +1805,13 @@ static void diagnosticTlv_result_handler(otError aError, otMessage *aMessage, co
            is pinned to a single core and callback ordering is deterministic. */
         const uint8_t *src = aMessageInfo->mPeerAddr.mFields.m8;
         uint16_t rloc16 = ((uint16_t)src[14] << 8) | src[15];
-        if ((rloc16 & 0x03FF) != 0) {
+        int target = diagnostics_target_index(rloc16);
+        if (s_diag_request.target == DIAGNOSTIC_TARGET_LIST ? target < 0 : (rloc16 & 0x03FF) != 0) {
             return;
         }
+        if (rloc16 != otThreadGetRloc16(esp_openthread_get_instance())) {
+            diag_scheduler_responded(DIAG_SCHEDULER_OWNER_WEB, rloc16);
+        }
 
         if (esp_get_free_heap_size() < DIAG_MIN_FREE_HEAP) {
             ESP_LOGW(API_TAG, "Diagnostic callback: low heap (%lu), dropping result",
@@ -1010,6 +1823,9 @@ static void diagnosticTlv_result_handler(otError aError, otMessage *aMessage, co
                 get_diagnosticTlv_information(aError, aMessage, aMessageInfo);
                 s_diag_response_count++;
                 s_diag_last_response_tick = xTaskGetTickCount();
+                if (target >= 0) {
+                    s_diag_target_responded |= 1 << target;
+                }
             }
             xSemaphoreGive(s_diagnostic_semaphore);
         } else {
@@ -1018,25 +1834,139 @@ static void diagnosticTlv_result_handler(otError aError, otMessage *aMessage, co
     }
 }
 
+/**
+ * @brief Get the TLV types to request for @param query, the Address16 is always requested as the key of the node and
+ *        the TLVs used by the filters are added.
+ *
+ * @return The number of the TLV types.
+ */
+static uint8_t diagnostics_request_types(const thread_diagnostic_query_t *query, uint8_t types[64])
+{
+    uint64_t mask = 0;
+    uint8_t count = 0;
+
+    if (query == NULL || query->tlv_mask == 0) {
+        memcpy(types, kAllTlvTypes, sizeof(kAllTlvTypes));
+        return sizeof(kAllTlvTypes);
+    }
+    mask = query->tlv_mask | (1ULL << OT_NETWORK_DIAGNOSTIC_TLV_SHORT_ADDRESS);
+    if (query->role >= 0) {
+        mask |= 1ULL << OT_NETWORK_DIAGNOSTIC_TLV_LEADER_DATA;
+    }
+    if (query->has_children >= 0) {
+        mask |= 1ULL << OT_NETWORK_DIAGNOSTIC_TLV_CHILD_TABLE;
+    }
+    if (query->lq_below) {
+        mask |= 1ULL << OT_NETWORK_DIAGNOSTIC_TLV_ROUTE;
+    }
+    for (uint8_t type = 0; type < 64; type++) {
+        if (mask & (1ULL << type)) {
+            types[count++] = type;
+        }
+    }
+    return count;
+}
+
+static uint64_t diagnostics_request_mask(const thread_diagnostic_query_t *query)
+{
+    uint8_t types[64];
+    uint8_t count = diagnostics_request_types(query, types);
+    uint64_t mask = 0;
+
+    for (uint8_t i = 0; i < count; i++) {
+        mask |= 1ULL << types[i];
+    }
+    return mask;
+}
+
+static esp_err_t diagnostics_send_unicast(otInstance *ins, uint16_t rloc16, const uint8_t *types, uint8_t count,
+                                          otReceiveDiagnosticGetCallback callback, diag_scheduler_owner_t owner)
+{
+    /* The RLOC of a node only differs from the RLOC of this node in the RLOC16. */
+    otIp6Address address = *otThreadGetRloc(ins);
+    address.mFields.m8[14] = rloc16 >> 8;
+    address.mFields.m8[15] = rloc16 & 0xff;
+    ESP_RETURN_ON_FALSE(otThreadSendDiagnosticGet(ins, &address, types, count, callback, NULL) == OT_ERROR_NONE,
+                        ESP_FAIL, API_TAG, "Fail to send diagnostic to 0x%04x.", rloc16);
+    diag_scheduler_sent(owner, rloc16);
+    return ESP_OK;
+}
+
 /**
  * @brief the function will send diagnostic to get network's topology message and update the set of diagnostic.
  *
+ * @note Every request to the other nodes takes its tokens from the diagnostic scheduler with the OpenThread lock
+ *       released, the multicast takes one token per router. The requests still waiting at @param deadline are deferred
+ *       and not sent.
  */
-static esp_err_t build_thread_network_topology(void)
+static esp_err_t build_thread_network_topology(const thread_diagnostic_query_t *query, const uint8_t *types,
+                                               uint8_t count, TickType_t deadline)
 {
     esp_err_t ret = ESP_OK;
     otInstance *ins = esp_openthread_get_instance();
+    uint8_t target = query ? query->target : DIAGNOSTIC_TARGET_ROUTERS;
+    otRouterInfo router_info;
+    uint16_t routers[OT_NETWORK_MAX_ROUTER_ID + 1];
+    uint8_t router_count = 0;
+
+    if (target == DIAGNOSTIC_TARGET_LIST) {
+        for (uint8_t i = 0; i < query->target_count; i++) {
+            if (diag_scheduler_acquire(1, deadline) != ESP_OK) {
+                ESP_LOGW(API_TAG, "Diagnostic to 0x%04x deferred by the scheduler", query->targets[i]);
+                continue;
+            }
+            esp_openthread_lock_acquire(portMAX_DELAY);
+            if (diagnostics_send_unicast(ins, query->targets[i], types, count, &diagnosticTlv_result_handler,
+                                         DIAG_SCHEDULER_OWNER_WEB) != ESP_OK) {
+                ret = ESP_FAIL;
+            }
+            esp_openthread_lock_release();
+        }
+        return ret;
+    }
+
     esp_openthread_lock_acquire(portMAX_DELAY);
     otIp6Address rloc16address = *otThreadGetRloc(ins);
     otIp6Address multicastAddress;
-    ESP_GOTO_ON_FALSE(otThreadSendDiagnosticGet(ins, &rloc16address, kAllTlvTypes, sizeof(kAllTlvTypes),
-                                                &diagnosticTlv_result_handler, NULL) == OT_ERROR_NONE,
+    uint8_t maxRouterId = otThreadGetMaxRouterId(ins);
+    uint16_t self = otThreadGetRloc16(ins);
+    for (uint8_t i = 0; i <= maxRouterId; i++) {
+        if (otThreadGetRouterInfo(ins, i, &router_info) == OT_ERROR_NONE && router_info.mRloc16 != self) {
+            routers[router_count++] = router_info.mRloc16;
+        }
+    }
+    /* The request to this node does not go over the air. */
+    ESP_GOTO_ON_FALSE(otThreadSendDiagnosticGet(ins, &rloc16address, types, count, &diagnosticTlv_result_handler,
+                                                NULL) == OT_ERROR_NONE,
                       ESP_FAIL, exit, API_TAG, "Fail to send diagnostic rloc16address.");
-    ESP_GOTO_ON_FALSE(otIp6AddressFromString(kMulticastAddrAllRouters, &multicastAddress) == OT_ERROR_NONE, ESP_FAIL,
-                      exit, API_TAG, "Fail to convert ipv6 to string.");
-    ESP_GOTO_ON_FALSE(otThreadSendDiagnosticGet(ins, &multicastAddress, kAllTlvTypes, sizeof(kAllTlvTypes),
-                                                &diagnosticTlv_result_handler, NULL) == OT_ERROR_NONE,
-                      ESP_FAIL, exit, API_TAG, "Fail to send diagnostic multicastAddress.");
+    esp_openthread_lock_release();
+
+    if (target == DIAGNOSTIC_TARGET_MULTICAST) {
+        if (router_count == 0 || diag_scheduler_acquire(router_count, deadline) != ESP_OK) {
+            return ret;
+        }
+        esp_openthread_lock_acquire(portMAX_DELAY);
+        ESP_GOTO_ON_FALSE(otIp6AddressFromString(kMulticastAddrAllRouters, &multicastAddress) == OT_ERROR_NONE,
+                          ESP_FAIL, exit, API_TAG, "Fail to convert ipv6 to string.");
+        ESP_GOTO_ON_FALSE(otThreadSendDiagnosticGet(ins, &multicastAddress, types, count,
+                                                    &diagnosticTlv_result_handler, NULL) == OT_ERROR_NONE,
+                          ESP_FAIL, exit, API_TAG, "Fail to send diagnostic multicastAddress.");
+        diag_scheduler_sent(DIAG_SCHEDULER_OWNER_WEB, DIAG_SCHEDULER_MULTICAST);
+        goto exit;
+    }
+    for (uint8_t i = 0; i < router_count; i++) {
+        if (diag_scheduler_acquire(1, deadline) != ESP_OK) {
+            ESP_LOGW(API_TAG, "Diagnostic to %u routers deferred by the scheduler", router_count - i);
+            return ret;
+        }
+        esp_openthread_lock_acquire(portMAX_DELAY);
+        if (diagnostics_send_unicast(ins, routers[i], types, count, &diagnosticTlv_result_handler,
+                                     DIAG_SCHEDULER_OWNER_WEB) != ESP_OK) {
+            ret = ESP_FAIL;
+        }
+        esp_openthread_lock_release();
+    }
+    return ret;
 exit:
     esp_openthread_lock_release();
     return ret;
@@ -1067,6 +1997,13 @@ static thread_node_information_t get_openthread_node_information(otInstance *ins
     return node;
 }
 
+void handle_ot_resource_node_information_struct_request(thread_node_information_t *node)
+{
+    esp_openthread_lock_acquire(portMAX_DELAY);
+    *node = get_openthread_node_information(esp_openthread_get_instance());
+    esp_openthread_lock_release();
+}
+
 cJSON *handle_ot_resource_node_information_request()
 {
     esp_openthread_lock_acquire(portMAX_DELAY);
@@ -1088,11 +2025,39 @@ exit:
     return ret;
 }
 
-cJSON *handle_ot_resource_network_diagnostics_request()
+/**
+ * @brief Record the compact topology of the collected set as a new version, unless it is the same as the latest one.
+ *        The caller must hold s_diagnostic_semaphore.
+ *
+ */
+static void topology_history_record(void)
+{
+    thread_topology_snapshot_t snapshot;
+    if (thread_topology_snapshot_build(s_diagnosticTlv_set, &snapshot) != ESP_OK) {
+        ESP_LOGW(API_TAG, "Failed to record the topology version");
+        return;
+    }
+    thread_topology_history_record(&s_topology_history, &snapshot);
+    /* The latest version is fresh again, even if the topology has not changed. */
+    s_topology_history_tick = xTaskGetTickCount();
+}
+
+static void collect_thread_network_diagnostics(const thread_diagnostic_query_t *query)
 {
+    uint8_t types[64];
+    uint8_t count = diagnostics_request_types(query, types);
+
     /* Stop accepting any late callbacks from a previous collection */
     xSemaphoreTake(s_diagnostic_semaphore, portMAX_DELAY);
     s_diag_collecting = false;
+    s_diag_snapshot_valid = false;
+    s_diag_request_mask = diagnostics_request_mask(query);
+    if (query) {
+        s_diag_request = *query;
+    } else {
+        thread_diagnostic_query_reset(&s_diag_request);
+    }
+    s_diag_target_responded = 0;
 
     destroy_thread_diagnosticTlv_set(s_diagnosticTlv_set);
     s_diagnosticTlv_set = NULL;
@@ -1104,7 +2069,12 @@ cJSON *handle_ot_resource_network_diagnostics_request()
     s_diag_collecting = true;
     xSemaphoreGive(s_diagnostic_semaphore);
 
-    build_thread_network_topology();
+    uint8_t target = query ? query->target : DIAGNOSTIC_TARGET_ROUTERS;
+    const TickType_t max_timeout_ticks = pdMS_TO_TICKS(query && query->timeout_ms ? query->timeout_ms
+                                                                                   : DIAG_MAX_TIMEOUT_MS);
+    TickType_t start = xTaskGetTickCount();
+    /* The requests deferred past the half of the collection would have no time left for their responses. */
+    build_thread_network_topology(query, types, count, start + max_timeout_ticks / 2);
 
     /* Get the expected router count as a minimum threshold */
     esp_openthread_lock_acquire(portMAX_DELAY);
@@ -1122,14 +2092,14 @@ cJSON *handle_ot_resource_network_diagnostics_request()
      * - At least expected_routers responses received
      * - AND no new response for DIAG_QUIET_PERIOD_MS (responses done)
      * - OR hard timeout reached
+     * The unicast collections know the responders, so they end as soon as all of them have responded.
      *
      * Compare in ticks (not ms) to avoid overflow when multiplying
      * TickType_t by portTICK_PERIOD_MS on systems with large tick counts. */
-    const TickType_t max_timeout_ticks = pdMS_TO_TICKS(DIAG_MAX_TIMEOUT_MS);
+    const uint16_t target_mask = query && target == DIAGNOSTIC_TARGET_LIST ? (1 << query->target_count) - 1 : 0;
     const TickType_t min_wait_ticks = pdMS_TO_TICKS(DIAG_MIN_WAIT_MS);
-    const TickType_t quiet_ticks = pdMS_TO_TICKS(DIAG_QUIET_PERIOD_MS);
+    const TickType_t quiet_ticks = pdMS_TO_TICKS(query && query->quiet_ms ? query->quiet_ms : DIAG_QUIET_PERIOD_MS);
     const TickType_t poll_ticks = pdMS_TO_TICKS(DIAG_POLL_INTERVAL_MS);
-    TickType_t start = xTaskGetTickCount();
     while (1) {
         vTaskDelay(poll_ticks);
         TickType_t now = xTaskGetTickCount();
@@ -1140,6 +2110,11 @@ cJSON *handle_ot_resource_network_diagnostics_request()
             ESP_LOGW(API_TAG, "Diagnostic collection: max timeout reached (%d responses)", s_diag_response_count);
             break;
         }
+        if ((target == DIAGNOSTIC_TARGET_LIST && s_diag_target_responded == target_mask) ||
+            (target == DIAGNOSTIC_TARGET_ROUTERS && s_diag_response_count >= expected_routers)) {
+            ESP_LOGI(API_TAG, "Diagnostic collection complete: %d responses to unicast", s_diag_response_count);
+            break;
+        }
         if (elapsed < min_wait_ticks) {
             continue;
         }
@@ -1150,33 +2125,922 @@ cJSON *handle_ot_resource_network_diagnostics_request()
         }
     }
 
-    /* Stop accepting new responses and serialize the result.
-       Free the diagnostic set immediately after conversion so the
-       JSON string serialization in the HTTP handler has more heap. */
+    /* Stop accepting new responses */
     xSemaphoreTake(s_diagnostic_semaphore, portMAX_DELAY);
     s_diag_collecting = false;
-    cJSON *result = diagnosticTlv_set_convert2_json(s_diagnosticTlv_set);
-    destroy_thread_diagnosticTlv_set(s_diagnosticTlv_set);
-    s_diagnosticTlv_set = NULL;
+    diag_scheduler_expire(DIAG_SCHEDULER_OWNER_WEB);
+    /* The topology versions are only comparable between the collections of all the routers with all the TLVs. */
+    if (query == NULL || (query->tlv_mask == 0 && query->target != DIAGNOSTIC_TARGET_LIST)) {
+        topology_history_record();
+    }
     xSemaphoreGive(s_diagnostic_semaphore);
-
-    return result;
 }
 
-/*----------------------------------------------------------------------
-+                       Set Thread dataset
-+-----------------------------------------------------------------------*/
-otError handle_openthread_set_dataset_request(const cJSON *request)
+cJSON *handle_ot_resource_network_diagnostics_request()
 {
-    return OT_ERROR_NONE;
+    return handle_ot_resource_network_diagnostics_query_request(NULL, NULL);
 }
 
-/*----------------------------------------------------------------------
-                        Ping Sender
------------------------------------------------------------------------*/
-#define PING_MAX_COUNT 10
-#define PING_DEFAULT_COUNT 4
-#define PING_DEFAULT_SIZE 32
+/**
+ * @brief Whether the kept set was collected for the TLVs and the targets of @param query. The filters and the page
+ *        size are applied on the set, so they may change from a page to the next one.
+ *        The caller must hold s_diagnostic_semaphore.
+ *
+ */
+static bool diagnostics_snapshot_matches(const thread_diagnostic_query_t *query)
+{
+    if (diagnostics_request_mask(query) != s_diag_request_mask || query->target != s_diag_request.target) {
+        return false;
+    }
+    if (query->target != DIAGNOSTIC_TARGET_LIST) {
+        return true;
+    }
+    return query->target_count == s_diag_request.target_count &&
+        memcmp(query->targets, s_diag_request.targets, query->target_count * sizeof(query->targets[0])) == 0;
+}
+
+/**
+ * @brief Take s_diagnostic_semaphore with the diagnostic set ready for @param query. The next pages are served from
+ *        the set kept by the first page, unless it is too old or was collected for another query, in which case the
+ *        set is collected again for this one.
+ *
+ * @return true if the kept set is used.
+ */
+static bool diagnostics_snapshot_take(const thread_diagnostic_query_t *query)
+{
+    xSemaphoreTake(s_diagnostic_semaphore, portMAX_DELAY);
+    bool fresh = s_diag_snapshot_valid && query && query->cursor != DIAGNOSTIC_QUERY_NO_CURSOR &&
+        xTaskGetTickCount() - s_diag_snapshot_tick < pdMS_TO_TICKS(DIAG_SNAPSHOT_MAX_AGE_MS) &&
+        diagnostics_snapshot_matches(query);
+    xSemaphoreGive(s_diagnostic_semaphore);
+    if (!fresh) {
+        collect_thread_network_diagnostics(query);
+    }
+    xSemaphoreTake(s_diagnostic_semaphore, portMAX_DELAY);
+    return fresh;
+}
+
+/**
+ * @brief Give s_diagnostic_semaphore. Free the diagnostic set immediately after conversion so the
+ *        serialization in the HTTP handler has more heap, unless it is kept for the next pages.
+ */
+static void diagnostics_snapshot_give(const thread_diagnostic_query_t *query, int32_t next_cursor, bool fresh)
+{
+    if (query && query->limit && next_cursor != DIAGNOSTIC_QUERY_NO_CURSOR) {
+        if (!fresh) {
+            s_diag_snapshot_tick = xTaskGetTickCount();
+        }
+        s_diag_snapshot_valid = true;
+    } else {
+        s_diag_snapshot_valid = false;
+        destroy_thread_diagnosticTlv_set(s_diagnosticTlv_set);
+        s_diagnosticTlv_set = NULL;
+    }
+    xSemaphoreGive(s_diagnostic_semaphore);
+}
+
+cJSON *handle_ot_resource_network_diagnostics_query_request(const thread_diagnostic_query_t *query,
+                                                            int32_t *next_cursor)
+{
+    cJSON *result = NULL;
+    int32_t next = DIAGNOSTIC_QUERY_NO_CURSOR;
+    bool fresh = diagnostics_snapshot_take(query);
+
+    if (query) {
+        result = diagnosticTlv_set_query_convert2_json(s_diagnosticTlv_set, query, &next);
+    } else {
+        result = diagnosticTlv_set_convert2_json(s_diagnosticTlv_set);
+    }
+    diagnostics_snapshot_give(query, next, fresh);
+    if (next_cursor) {
+        *next_cursor = next;
+    }
+    return result;
+}
+
+cJSON *handle_ot_resource_network_diagnostics_delta_request(uint32_t since, bool *not_modified)
+{
+    cJSON *result = NULL;
+
+    /* The polls of the dashboards are served from the latest version, the mesh is only collected once it is old. */
+    xSemaphoreTake(s_diagnostic_semaphore, portMAX_DELAY);
+    bool fresh = thread_topology_history_latest(&s_topology_history)->version &&
+        xTaskGetTickCount() - s_topology_history_tick < pdMS_TO_TICKS(DIAG_TOPOLOGY_MAX_AGE_MS);
+    xSemaphoreGive(s_diagnostic_semaphore);
+    if (!fresh) {
+        /* Only the topology version of the collection is kept, its set is freed. */
+        diagnostics_snapshot_give(NULL, DIAGNOSTIC_QUERY_NO_CURSOR, diagnostics_snapshot_take(NULL));
+    }
+
+    xSemaphoreTake(s_diagnostic_semaphore, portMAX_DELAY);
+    const thread_topology_snapshot_t *latest = thread_topology_history_latest(&s_topology_history);
+
+    *not_modified = latest->version && since == latest->version;
+    if (!*not_modified) {
+        const thread_topology_snapshot_t *base = thread_topology_history_find(&s_topology_history, since);
+        result = base ? thread_topology_delta_convert2_json(base, latest)
+                      : thread_topology_snapshot_convert2_json(latest);
+    }
+    xSemaphoreGive(s_diagnostic_semaphore);
+    return result;
+}
+
+cJSON *handle_ot_resource_network_diagnostics_scheduler_request(void)
+{
+    return diag_scheduler_metrics_convert2_json();
+}
+
+otError handle_ot_resource_network_diagnostics_scheduler_put_request(const cJSON *request)
+{
+    const cJSON *rate = cJSON_GetObjectItemCaseSensitive(request, "Rate");
+    const cJSON *burst = cJSON_GetObjectItemCaseSensitive(request, "Burst");
+
+    ESP_RETURN_ON_FALSE(cJSON_IsNumber(rate) && cJSON_IsNumber(burst) && rate->valueint > 0 && burst->valueint > 0 &&
+                            rate->valueint <= UINT16_MAX && burst->valueint <= UINT16_MAX,
+                        OT_ERROR_INVALID_ARGS, API_TAG, "Invalid diagnostic scheduler configuration");
+    ESP_RETURN_ON_FALSE(diag_scheduler_configure(rate->valueint, burst->valueint) == ESP_OK, OT_ERROR_INVALID_ARGS,
+                        API_TAG, "Invalid diagnostic scheduler configuration");
+    return OT_ERROR_NONE;
+}
+
+#if CONFIG_OPENTHREAD_LINK_QUALITY_STORE
+static void link_quality_convert2_json(uint16_t router, uint16_t neighbor, esp_ot_link_quality_resolution_t resolution,
+                                       const esp_ot_link_quality_point_t *points, uint16_t count, void *context)
+{
+    char rloc16[7];
+    cJSON *link = cJSON_CreateObject();
+    cJSON *array = cJSON_CreateArray();
+
+    sprintf(rloc16, "0x%04x", router);
+    cJSON_AddStringToObject(link, "Router", rloc16);
+    sprintf(rloc16, "0x%04x", neighbor);
+    cJSON_AddStringToObject(link, "Neighbor", rloc16);
+    cJSON_AddStringToObject(link, "Resolution", esp_ot_link_quality_resolution_to_string(resolution));
+    for (uint16_t i = 0; i < count; i++) {
+        cJSON *point = cJSON_CreateObject();
+        cJSON_AddNumberToObject(point, "Time", points[i].time);
+        cJSON_AddNumberToObject(point, "Count", points[i].count);
+        cJSON_AddNumberToObject(point, "LinkQualityIn", points[i].link_quality_in_x100 / 100.0);
+        cJSON_AddNumberToObject(point, "LinkQualityOut", points[i].link_quality_out_x100 / 100.0);
+        cJSON_AddNumberToObject(point, "MinLinkQualityIn", points[i].min_link_quality_in);
+        cJSON_AddNumberToObject(point, "MinLinkQualityOut", points[i].min_link_quality_out);
+        cJSON_AddNumberToObject(point, "MaxRouteCost", points[i].max_route_cost);
+        cJSON_AddItemToArray(array, point);
+    }
+    cJSON_AddItemToObject(link, "Points", array);
+    cJSON_AddItemToArray((cJSON *)context, link);
+}
+
+cJSON *handle_ot_resource_link_quality_request(int32_t from, int32_t to, uint16_t node)
+{
+    uint32_t now = esp_ot_link_quality_now();
+    cJSON *root = cJSON_CreateObject();
+    cJSON *links = cJSON_CreateArray();
+
+    /* The times not above 0 are relative to now. */
+    uint32_t first = from > 0 ? (uint32_t)from : (uint32_t)-from < now ? now + from : 0;
+    uint32_t last = to > 0 ? (uint32_t)to : (uint32_t)-to < now ? now + to : 0;
+    cJSON_AddNumberToObject(root, "Now", now);
+    cJSON_AddNumberToObject(root, "From", first);
+    cJSON_AddNumberToObject(root, "To", last);
+    esp_openthread_lock_acquire(portMAX_DELAY);
+    esp_ot_link_quality_query(first, last, node, link_quality_convert2_json, links);
+    esp_openthread_lock_release();
+    cJSON_AddItemToObject(root, "Links", links);
+    return root;
+}
+#endif // CONFIG_OPENTHREAD_LINK_QUALITY_STORE
+
+#if CONFIG_OPENTHREAD_MAC_COUNTERS_STORE
+#define MAC_COUNTERS_FLAG_PERMILLE 50 /* the nodes and links with an error rate of 5% are flagged */
+#define MAC_COUNTERS_FLAG_LINK_QUALITY 1
+
+static cJSON *mac_counters_rate_convert2_json(uint16_t permille)
+{
+    return permille == ESP_OT_MAC_COUNTERS_UNKNOWN ? cJSON_CreateNull() : cJSON_CreateNumber(permille / 1000.0);
+}
+
+static cJSON *mac_counters_node_convert2_json(const esp_ot_mac_counters_node_stats_t *stats)
+{
+    char rloc16[7];
+    cJSON *node = cJSON_CreateObject();
+
+    sprintf(rloc16, "0x%04x", stats->rloc16);
+    cJSON_AddStringToObject(node, "Rloc16", rloc16);
+    cJSON_AddNumberToObject(node, "Intervals", stats->intervals);
+    cJSON_AddNumberToObject(node, "Resets", stats->resets);
+    cJSON_AddNumberToObject(node, "Duration", stats->sum.duration);
+    cJSON_AddNumberToObject(node, "TxFrames", stats->sum.tx_frames);
+    cJSON_AddNumberToObject(node, "TxErrors", stats->sum.tx_errors);
+    cJSON_AddNumberToObject(node, "RxFrames", stats->sum.rx_frames);
+    cJSON_AddNumberToObject(node, "RxErrors", stats->sum.rx_errors);
+    cJSON_AddNumberToObject(node, "RxDiscards", stats->sum.rx_discards);
+    cJSON_AddItemToObject(node, "TxErrorRate", mac_counters_rate_convert2_json(stats->tx_error_permille));
+    cJSON_AddItemToObject(node, "RxErrorRate", mac_counters_rate_convert2_json(stats->rx_error_permille));
+    cJSON_AddItemToObject(node, "RetryRate", mac_counters_rate_convert2_json(stats->retry_permille));
+    cJSON_AddItemToObject(node, "Utilization", mac_counters_rate_convert2_json(stats->utilization_permille));
+    cJSON_AddBoolToObject(node, "Flagged", stats->score_permille >= MAC_COUNTERS_FLAG_PERMILLE);
+    return node;
+}
+
+static cJSON *mac_counters_interval_convert2_json(const esp_ot_mac_counters_interval_t *interval)
+{
+    cJSON *item = cJSON_CreateObject();
+
+    cJSON_AddNumberToObject(item, "Time", interval->time);
+    cJSON_AddNumberToObject(item, "Duration", interval->duration);
+    cJSON_AddNumberToObject(item, "TxFrames", interval->tx_frames);
+    cJSON_AddNumberToObject(item, "TxErrors", interval->tx_errors);
+    cJSON_AddNumberToObject(item, "TxRetries", interval->tx_retries);
+    cJSON_AddNumberToObject(item, "RxFrames", interval->rx_frames);
+    cJSON_AddNumberToObject(item, "RxErrors", interval->rx_errors);
+    cJSON_AddNumberToObject(item, "RxDiscards", interval->rx_discards);
+    return item;
+}
+
+static cJSON *mac_counters_worst_convert2_json(uint32_t window, uint16_t count)
+{
+    cJSON *root = cJSON_CreateObject();
+    cJSON *nodes_json = cJSON_CreateArray();
+    cJSON *links_json = cJSON_CreateArray();
+    esp_ot_mac_counters_node_stats_t *nodes = calloc(count, sizeof(esp_ot_mac_counters_node_stats_t));
+    esp_ot_mac_counters_link_stats_t *links = calloc(count, sizeof(esp_ot_mac_counters_link_stats_t));
+    uint16_t node_count = 0;
+    uint16_t link_count = 0;
+    char rloc16[7];
+
+    if (nodes && links) {
+        esp_openthread_lock_acquire(portMAX_DELAY);
+        node_count = esp_ot_mac_counters_get_worst_nodes(window, nodes, count);
+        link_count = esp_ot_mac_counters_get_worst_links(window, links, count);
+        esp_openthread_lock_release();
+    } else {
+        ESP_LOGW(API_TAG, "MAC counters: out of memory for %u nodes", count);
+    }
+    for (uint16_t i = 0; i < node_count; i++) {
+        cJSON_AddItemToArray(nodes_json, mac_counters_node_convert2_json(&nodes[i]));
+    }
+    for (uint16_t i = 0; i < link_count; i++) {
+        cJSON *link = cJSON_CreateObject();
+        sprintf(rloc16, "0x%04x", links[i].router);
+        cJSON_AddStringToObject(link, "Router", rloc16);
+        sprintf(rloc16, "0x%04x", links[i].neighbor);
+        cJSON_AddStringToObject(link, "Neighbor", rloc16);
+        cJSON_AddNumberToObject(link, "LinkQuality", links[i].link_quality);
+        cJSON_AddItemToObject(link, "NodeTxErrorEstimate",
+                              mac_counters_rate_convert2_json(links[i].node_tx_error_permille));
+        cJSON_AddBoolToObject(link, "Flagged",
+                              links[i].link_quality <= MAC_COUNTERS_FLAG_LINK_QUALITY ||
+                                  (links[i].node_tx_error_permille != ESP_OT_MAC_COUNTERS_UNKNOWN &&
+                                   links[i].node_tx_error_permille >= MAC_COUNTERS_FLAG_PERMILLE));
+        cJSON_AddItemToArray(links_json, link);
+    }
+    free(nodes);
+    free(links);
+    cJSON_AddItemToObject(root, "Nodes", nodes_json);
+    cJSON_AddItemToObject(root, "Links", links_json);
+    return root;
+}
+
+cJSON *handle_ot_resource_mac_counters_request(uint32_t window, uint16_t count, uint16_t node)
+{
+    cJSON *root = NULL;
+
+    if (node == ESP_OT_MAC_COUNTERS_ANY_NODE) {
+        root = mac_counters_worst_convert2_json(window, count);
+    } else {
+        esp_ot_mac_counters_interval_t intervals[CONFIG_OPENTHREAD_MAC_COUNTERS_HISTORY];
+        esp_ot_mac_counters_node_stats_t stats;
+        esp_openthread_lock_acquire(portMAX_DELAY);
+        esp_err_t err = esp_ot_mac_counters_get_node(node, window, &stats, intervals,
+                                                     CONFIG_OPENTHREAD_MAC_COUNTERS_HISTORY);
+        esp_openthread_lock_release();
+        if (err != ESP_OK) {
+            return NULL;
+        }
+        cJSON *array = cJSON_CreateArray();
+        for (uint16_t i = 0; i < stats.intervals; i++) {
+            cJSON_AddItemToArray(array, mac_counters_interval_convert2_json(&intervals[i]));
+        }
+        root = cJSON_CreateObject();
+        cJSON_AddItemToObject(root, "Node", mac_counters_node_convert2_json(&stats));
+        cJSON_AddItemToObject(root, "Intervals", array);
+    }
+    cJSON_AddNumberToObject(root, "Now", (uint32_t)(esp_timer_get_time() / 1000000));
+    cJSON_AddNumberToObject(root, "Window", window);
+    return root;
+}
+#endif // CONFIG_OPENTHREAD_MAC_COUNTERS_STORE
+
+#if CONFIG_OPENTHREAD_DNS_POOL
+static cJSON *dns_pool_addr_convert2_json(uint32_t addr)
+{
+    char str[IP4ADDR_STRLEN_MAX];
+    ip4_addr_t ip4_addr = {.addr = addr};
+
+    if (addr == ESP_OT_DNS_POOL_NO_SERVER) {
+        return cJSON_CreateNull();
+    }
+    return cJSON_CreateString(ip4addr_ntoa_r(&ip4_addr, str, sizeof(str)));
+}
+
+static cJSON *dns_pool_server_convert2_json(const esp_ot_dns_pool_server_t *server)
+{
+    cJSON *root = cJSON_CreateObject();
+    cJSON *history = cJSON_CreateArray();
+
+    cJSON_AddItemToObject(root, "Address", dns_pool_addr_convert2_json(server->addr));
+    cJSON_AddBoolToObject(root, "Main", server->main);
+    cJSON_AddBoolToObject(root, "Healthy", server->healthy);
+    if (server->probes > server->failures) {
+        cJSON_AddNumberToObject(root, "RttMs", server->rtt_ms);
+    } else {
+        cJSON_AddNullToObject(root, "RttMs");
+    }
+    cJSON_AddNumberToObject(root, "FailureRate", server->failure_permille / 1000.0);
+    cJSON_AddNumberToObject(root, "ConsecutiveFailures", server->consecutive_failures);
+    cJSON_AddNumberToObject(root, "Probes", server->probes);
+    cJSON_AddNumberToObject(root, "Failures", server->failures);
+    cJSON_AddNumberToObject(root, "LastProbe", server->last_probe);
+    for (uint8_t i = 0; i < server->history_len; i++) {
+        cJSON_AddItemToArray(history, server->history[i] == ESP_OT_DNS_POOL_PROBE_FAILED
+                                          ? cJSON_CreateNull()
+                                          : cJSON_CreateNumber(server->history[i]));
+    }
+    cJSON_AddItemToObject(root, "History", history);
+    return root;
+}
+
+cJSON *handle_ot_resource_dns_upstreams_request(void)
+{
+    esp_ot_dns_pool_server_t servers[CONFIG_OPENTHREAD_DNS_POOL_MAX_SERVERS];
+    esp_ot_dns_pool_decision_t decisions[ESP_OT_DNS_POOL_DECISION_NUM];
+    cJSON *root = cJSON_CreateObject();
+    cJSON *servers_json = cJSON_CreateArray();
+    cJSON *decisions_json = cJSON_CreateArray();
+
+    esp_openthread_lock_acquire(portMAX_DELAY);
+    uint8_t server_count = esp_ot_dns_pool_get_servers(servers, CONFIG_OPENTHREAD_DNS_POOL_MAX_SERVERS);
+    uint8_t decision_count = esp_ot_dns_pool_get_decisions(decisions, ESP_OT_DNS_POOL_DECISION_NUM);
+    uint32_t pinned = esp_ot_dns_pool_get_pinned();
+    esp_openthread_lock_release();
+
+    /* A main server pinned by hand may not be in the pool. */
+    uint32_t main_addr = pinned;
+    for (uint8_t i = 0; i < server_count; i++) {
+        main_addr = servers[i].main ? servers[i].addr : main_addr;
+        cJSON_AddItemToArray(servers_json, dns_pool_server_convert2_json(&servers[i]));
+    }
+    for (uint8_t i = 0; i < decision_count; i++) {
+        cJSON *decision = cJSON_CreateObject();
+        cJSON_AddNumberToObject(decision, "Time", decisions[i].time);
+        cJSON_AddStringToObject(decision, "Reason", esp_ot_dns_pool_reason_name(decisions[i].reason));
+        cJSON_AddItemToObject(decision, "From", dns_pool_addr_convert2_json(decisions[i].from));
+        cJSON_AddNumberToObject(decision, "FromRttMs", decisions[i].from_rtt_ms);
+        cJSON_AddItemToObject(decision, "To", dns_pool_addr_convert2_json(decisions[i].to));
+        cJSON_AddNumberToObject(decision, "ToRttMs", decisions[i].to_rtt_ms);
+        cJSON_AddItemToArray(decisions_json, decision);
+    }
+    cJSON_AddNumberToObject(root, "Now", (double)(esp_timer_get_time() / 1000000));
+    cJSON_AddItemToObject(root, "Main", dns_pool_addr_convert2_json(main_addr));
+    cJSON_AddBoolToObject(root, "Pinned", pinned != ESP_OT_DNS_POOL_NO_SERVER);
+    cJSON_AddItemToObject(root, "Servers", servers_json);
+    cJSON_AddItemToObject(root, "Decisions", decisions_json);
+    return root;
+}
+#endif // CONFIG_OPENTHREAD_DNS_POOL
+
+#if CONFIG_OPENTHREAD_IP_STATS
+static cJSON *ip_stats_latency_convert2_json(esp_ot_ip_stats_direction_t direction)
+{
+    esp_ot_ip_stats_latency_t latency;
+    cJSON *root = cJSON_CreateObject();
+    cJSON *buckets = cJSON_CreateArray();
+
+    esp_ot_ip_stats_get_latency(direction, &latency);
+    cJSON_AddStringToObject(root, "Direction", esp_ot_ip_stats_direction_name(direction));
+    cJSON_AddNumberToObject(root, "Samples", latency.samples);
+    cJSON_AddNumberToObject(root, "P50Us", esp_ot_ip_stats_percentile(&latency, 500));
+    cJSON_AddNumberToObject(root, "P99Us", esp_ot_ip_stats_percentile(&latency, 990));
+    cJSON_AddNumberToObject(root, "MaxUs", latency.max_us);
+    for (uint8_t i = 0; i < ESP_OT_IP_STATS_LATENCY_BUCKETS; i++) {
+        cJSON *bucket = cJSON_CreateObject();
+        uint32_t bound = esp_ot_ip_stats_bound(i);
+        if (bound == ESP_OT_IP_STATS_NO_BOUND) {
+            cJSON_AddNullToObject(bucket, "UpToUs");
+        } else {
+            cJSON_AddNumberToObject(bucket, "UpToUs", bound);
+        }
+        cJSON_AddNumberToObject(bucket, "Packets", latency.buckets[i]);
+        cJSON_AddItemToArray(buckets, bucket);
+    }
+    cJSON_AddItemToObject(root, "Buckets", buckets);
+    return root;
+}
+
+cJSON *handle_ot_resource_ip_stats_request(void)
+{
+    esp_ot_ip_stats_netif_t netifs[ESP_OT_IP_STATS_MAX_NETIFS];
+    esp_ot_ip_stats_mcast_group_t groups[CONFIG_OPENTHREAD_IP_STATS_MCAST_GROUPS];
+    uint32_t other = 0;
+    char addr[IPADDR_STRLEN_MAX];
+    cJSON *root = cJSON_CreateObject();
+    cJSON *netifs_json = cJSON_CreateArray();
+    cJSON *latency_json = cJSON_CreateArray();
+    cJSON *groups_json = cJSON_CreateArray();
+
+    uint8_t count = esp_ot_ip_stats_get_netifs(netifs, ESP_OT_IP_STATS_MAX_NETIFS);
+    for (uint8_t i = 0; i < count; i++) {
+        cJSON *netif = cJSON_CreateObject();
+        cJSON_AddStringToObject(netif, "Name", netifs[i].name);
+        cJSON_AddNumberToObject(netif, "RxPackets", netifs[i].rx_packets);
+        cJSON_AddNumberToObject(netif, "RxBytes", netifs[i].rx_bytes);
+        cJSON_AddNumberToObject(netif, "RxDrops", netifs[i].rx_drops);
+        cJSON_AddNumberToObject(netif, "TxPackets", netifs[i].tx_packets);
+        cJSON_AddNumberToObject(netif, "TxBytes", netifs[i].tx_bytes);
+        cJSON_AddNumberToObject(netif, "TxDrops", netifs[i].tx_drops);
+        cJSON_AddNumberToObject(netif, "TxForwarded", netifs[i].tx_forwarded);
+        cJSON_AddItemToArray(netifs_json, netif);
+    }
+    for (uint8_t dir = 0; dir < ESP_OT_IP_STATS_DIRECTIONS; dir++) {
+        cJSON_AddItemToArray(latency_json, ip_stats_latency_convert2_json((esp_ot_ip_stats_direction_t)dir));
+    }
+    count = esp_ot_ip_stats_get_mcast_groups(groups, CONFIG_OPENTHREAD_IP_STATS_MCAST_GROUPS, &other);
+    for (uint8_t i = 0; i < count; i++) {
+        cJSON *group = cJSON_CreateObject();
+        cJSON_AddStringToObject(group, "Group", ipaddr_ntoa_r(&groups[i].group, addr, sizeof(addr)));
+        cJSON_AddNumberToObject(group, "Packets", groups[i].packets);
+        cJSON_AddNumberToObject(group, "Bytes", groups[i].bytes);
+        cJSON_AddItemToArray(groups_json, group);
+    }
+    cJSON_AddItemToObject(root, "Netifs", netifs_json);
+    cJSON_AddItemToObject(root, "Latency", latency_json);
+    cJSON_AddItemToObject(root, "MulticastGroups", groups_json);
+    cJSON_AddNumberToObject(root, "MulticastOtherPackets", other);
+    return root;
+}
+#endif // CONFIG_OPENTHREAD_IP_STATS
+
+#if CONFIG_OPENTHREAD_BOOT_TIMELINE
+cJSON *handle_ot_resource_boot_timeline_request(void)
+{
+    esp_ot_boot_phase_t *phases = malloc(CONFIG_OPENTHREAD_BOOT_TIMELINE_MAX_PHASES * sizeof(esp_ot_boot_phase_t));
+    uint32_t dropped = 0;
+    cJSON *root = cJSON_CreateObject();
+    cJSON *phases_json = cJSON_CreateArray();
+
+    uint8_t count = phases ? esp_ot_boot_timeline_get(phases, CONFIG_OPENTHREAD_BOOT_TIMELINE_MAX_PHASES, &dropped) : 0;
+    for (uint8_t i = 0; i < count; i++) {
+        cJSON *phase = cJSON_CreateObject();
+        cJSON_AddStringToObject(phase, "Name", phases[i].name);
+        cJSON_AddStringToObject(phase, "Task", phases[i].task);
+        cJSON_AddNumberToObject(phase, "BeginUs", phases[i].begin_us);
+        if (phases[i].end_us == ESP_OT_BOOT_PHASE_RUNNING) {
+            cJSON_AddNullToObject(phase, "EndUs");
+            cJSON_AddNullToObject(phase, "DurationUs");
+        } else {
+            cJSON_AddNumberToObject(phase, "EndUs", phases[i].end_us);
+            cJSON_AddNumberToObject(phase, "DurationUs", phases[i].end_us - phases[i].begin_us);
+        }
+        cJSON_AddItemToArray(phases_json, phase);
+    }
+    free(phases);
+    cJSON_AddItemToObject(root, "Phases", phases_json);
+    cJSON_AddNumberToObject(root, "Dropped", dropped);
+    return root;
+}
+#endif // CONFIG_OPENTHREAD_BOOT_TIMELINE
+
+#if CONFIG_OPENTHREAD_COEX
+/* Must be called with the OpenThread lock held. */
+static cJSON *coex_measurement_convert2_json(void)
+{
+    esp_ot_coex_result_t results[ESP_OT_COEX_MEASURE_MAX_PROFILES];
+    uint8_t count = 0;
+    cJSON *root = cJSON_CreateObject();
+    cJSON *results_json = cJSON_CreateArray();
+
+    esp_ot_coex_measure_state_t state = esp_ot_coex_measure_get(results, &count);
+    cJSON_AddStringToObject(root, "State", esp_ot_coex_measure_state_name(state));
+    for (uint8_t i = 0; i < count; i++) {
+        cJSON *result = cJSON_CreateObject();
+        cJSON_AddStringToObject(result, "Profile", esp_ot_coex_profile_name(results[i].profile));
+        cJSON_AddNumberToObject(result, "Sent", results[i].sent);
+        cJSON_AddNumberToObject(result, "Received", results[i].received);
+        cJSON_AddNumberToObject(result, "RttMinMs", results[i].rtt_min_ms);
+        cJSON_AddNumberToObject(result, "RttAvgMs", results[i].rtt_avg_ms);
+        cJSON_AddNumberToObject(result, "RttMaxMs", results[i].rtt_max_ms);
+        cJSON_AddNumberToObject(result, "ThroughputBps", results[i].throughput_bps);
+        cJSON_AddNumberToObject(result, "TxDeferred", results[i].tx_deferred);
+        cJSON_AddNumberToObject(result, "TxAborted", results[i].tx_aborted);
+        cJSON_AddNumberToObject(result, "TxDenied", results[i].tx_denied);
+        cJSON_AddItemToArray(results_json, result);
+    }
+    cJSON_AddItemToObject(root, "Results", results_json);
+    return root;
+}
+
+cJSON *handle_ot_resource_coex_request(void)
+{
+    esp_ot_coex_stats_t stats;
+    esp_ot_coex_priorities_t priorities;
+    cJSON *root = cJSON_CreateObject();
+    cJSON *tx = cJSON_CreateObject();
+
+    esp_openthread_lock_acquire(portMAX_DELAY);
+    esp_ot_coex_get_stats(&stats);
+    esp_ot_coex_profile_t profile = esp_ot_coex_get_priorities(&priorities);
+    cJSON_AddItemToObject(root, "Measurement", coex_measurement_convert2_json());
+    esp_openthread_lock_release();
+
+    cJSON_AddBoolToObject(root, "Enabled", stats.enabled);
+    if (profile < ESP_OT_COEX_PROFILES) {
+        cJSON *priorities_json = cJSON_CreateObject();
+        cJSON_AddStringToObject(root, "Profile", esp_ot_coex_profile_name(profile));
+        cJSON_AddStringToObject(priorities_json, "Idle", esp_ot_coex_priority_name(priorities.idle));
+        cJSON_AddStringToObject(priorities_json, "TxRx", esp_ot_coex_priority_name(priorities.txrx));
+        cJSON_AddStringToObject(priorities_json, "TxRxAt", esp_ot_coex_priority_name(priorities.txrx_at));
+        cJSON_AddItemToObject(root, "Priorities", priorities_json);
+    } else {
+        cJSON_AddNullToObject(root, "Profile");
+        cJSON_AddNullToObject(root, "Priorities");
+    }
+    cJSON_AddNumberToObject(root, "WindowMs", stats.window_ms);
+    cJSON_AddNumberToObject(tx, "Frames", stats.tx_frames);
+    cJSON_AddNumberToObject(tx, "Deferred", stats.tx_deferred);
+    cJSON_AddNumberToObject(tx, "Aborted", stats.tx_aborted);
+    cJSON_AddNumberToObject(tx, "Retries", stats.tx_retries);
+    cJSON_AddItemToObject(root, "Tx", tx);
+    cJSON_AddNumberToObject(root, "RxFrames", stats.rx_frames);
+    if (stats.has_grants) {
+        cJSON *arbiter = cJSON_CreateObject();
+        cJSON_AddNumberToObject(arbiter, "TxRequests", stats.tx_requests);
+        cJSON_AddNumberToObject(arbiter, "TxGranted", stats.tx_granted);
+        cJSON_AddNumberToObject(arbiter, "TxDenied", stats.tx_denied);
+        cJSON_AddNumberToObject(arbiter, "TxGrantWaitUs", stats.tx_grant_wait_us);
+        cJSON_AddNumberToObject(arbiter, "RxRequests", stats.rx_requests);
+        cJSON_AddNumberToObject(arbiter, "RxGranted", stats.rx_granted);
+        cJSON_AddNumberToObject(arbiter, "RxDenied", stats.rx_denied);
+        cJSON_AddNumberToObject(arbiter, "RxGrantWaitUs", stats.rx_grant_wait_us);
+        cJSON_AddItemToObject(root, "Arbiter", arbiter);
+    } else {
+        cJSON_AddNullToObject(root, "Arbiter");
+    }
+    if (stats.has_air_time) {
+        cJSON *air_time = cJSON_CreateObject();
+        cJSON_AddNumberToObject(air_time, "TxPermille", stats.tx_permille);
+        cJSON_AddNumberToObject(air_time, "RxPermille", stats.rx_permille);
+        cJSON_AddNumberToObject(air_time, "SleepPermille", stats.sleep_permille);
+        cJSON_AddItemToObject(root, "AirTime", air_time);
+    } else {
+        cJSON_AddNullToObject(root, "AirTime");
+    }
+    return root;
+}
+
+otError handle_ot_resource_coex_put_request(const cJSON *request)
+{
+    esp_err_t err = ESP_OK;
+    const cJSON *reset = cJSON_GetObjectItemCaseSensitive(request, "Reset");
+    const cJSON *profile = cJSON_GetObjectItemCaseSensitive(request, "Profile");
+    const cJSON *priorities = cJSON_GetObjectItemCaseSensitive(request, "Priorities");
+
+    ESP_RETURN_ON_FALSE(cJSON_IsObject(request), OT_ERROR_INVALID_ARGS, API_TAG, "Invalid coex request");
+    ESP_RETURN_ON_FALSE(!reset || cJSON_IsBool(reset), OT_ERROR_INVALID_ARGS, API_TAG, "Invalid coex reset");
+    ESP_RETURN_ON_FALSE(!(profile && priorities), OT_ERROR_INVALID_ARGS, API_TAG,
+                        "Coex profile and priorities are exclusive");
+
+    esp_openthread_lock_acquire(portMAX_DELAY);
+    if (profile) {
+        const char *name = cJSON_GetStringValue(profile);
+        err = name ? esp_ot_coex_set_profile(esp_ot_coex_profile_parse(name)) : ESP_ERR_INVALID_ARG;
+    } else if (priorities) {
+        const char *idle = cJSON_GetStringValue(cJSON_GetObjectItemCaseSensitive(priorities, "Idle"));
+        const char *txrx = cJSON_GetStringValue(cJSON_GetObjectItemCaseSensitive(priorities, "TxRx"));
+        const char *txrx_at = cJSON_GetStringValue(cJSON_GetObjectItemCaseSensitive(priorities, "TxRxAt"));
+        if (idle && txrx && txrx_at) {
+            esp_ot_coex_priorities_t value = {
+                .idle = esp_ot_coex_priority_parse(idle),
+                .txrx = esp_ot_coex_priority_parse(txrx),
+                .txrx_at = esp_ot_coex_priority_parse(txrx_at),
+            };
+            err = esp_ot_coex_set_priorities(&value);
+        } else {
+            err = ESP_ERR_INVALID_ARG;
+        }
+    }
+    if (err == ESP_OK && cJSON_IsTrue(reset)) {
+        esp_ot_coex_reset();
+    }
+    esp_openthread_lock_release();
+    return esp_ot_coex_error_to_ot_error(err);
+}
+
+otError handle_ot_resource_coex_measure_post_request(const cJSON *request)
+{
+    esp_ot_coex_profile_t profiles[ESP_OT_COEX_MEASURE_MAX_PROFILES];
+    uint8_t count = 0;
+    otIp6Address destination;
+    const cJSON *profile = NULL;
+    const char *address = cJSON_GetStringValue(cJSON_GetObjectItemCaseSensitive(request, "Address"));
+    const cJSON *profiles_json = cJSON_GetObjectItemCaseSensitive(request, "Profiles");
+
+    ESP_RETURN_ON_FALSE(address && otIp6AddressFromString(address, &destination) == OT_ERROR_NONE,
+                        OT_ERROR_INVALID_ARGS, API_TAG, "Invalid coex measurement address");
+    ESP_RETURN_ON_FALSE(!profiles_json || cJSON_IsArray(profiles_json), OT_ERROR_INVALID_ARGS, API_TAG,
+                        "Invalid coex measurement profiles");
+    cJSON_ArrayForEach(profile, profiles_json)
+    {
+        const char *name = cJSON_GetStringValue(profile);
+        ESP_RETURN_ON_FALSE(name && count < ESP_OT_COEX_MEASURE_MAX_PROFILES, OT_ERROR_INVALID_ARGS, API_TAG,
+                            "Invalid coex measurement profiles");
+        profiles[count++] = esp_ot_coex_profile_parse(name);
+    }
+
+    esp_openthread_lock_acquire(portMAX_DELAY);
+    esp_err_t err = esp_ot_coex_measure_start(&destination, profiles, count);
+    esp_openthread_lock_release();
+    return esp_ot_coex_error_to_ot_error(err);
+}
+#endif // CONFIG_OPENTHREAD_COEX
+
+#if DIAG_SWEEP_ENABLE
+#define DIAG_SWEEP_TASK_STACK_SIZE 3072
+#define DIAG_SWEEP_TASK_PRIORITY 5
+#define DIAG_SWEEP_WAIT_MS 5000 /* the responses later than it are lost */
+
+typedef struct diagnostics_sweep {
+    uint32_t interval_s;
+    uint64_t tlv_mask; /* the TLV types queried by the sweep */
+    TickType_t next;   /* the tick of the next sweep */
+} diagnostics_sweep_t;
+
+/* The sweeps due at the same time share one query per router. */
+static diagnostics_sweep_t s_diag_sweeps[] = {
+#if CONFIG_OPENTHREAD_LINK_QUALITY_STORE && CONFIG_OPENTHREAD_LINK_QUALITY_SWEEP_INTERVAL
+    {CONFIG_OPENTHREAD_LINK_QUALITY_SWEEP_INTERVAL, 1ULL << OT_NETWORK_DIAGNOSTIC_TLV_ROUTE, 0},
+#endif
+#if CONFIG_OPENTHREAD_MAC_COUNTERS_STORE
+    {CONFIG_OPENTHREAD_MAC_COUNTERS_SWEEP_INTERVAL,
+     (1ULL << OT_NETWORK_DIAGNOSTIC_TLV_MAC_COUNTERS) | (1ULL << OT_NETWORK_DIAGNOSTIC_TLV_ROUTE), 0},
+#endif
+};
+
+static void diagnostics_sweep_result_handler(otError aError, otMessage *aMessage, const otMessageInfo *aMessageInfo,
+                                             void *aContext)
+{
+    otNetworkDiagTlv diagTlv;
+    otNetworkDiagIterator iterator = OT_NETWORK_DIAGNOSTIC_ITERATOR_INIT;
+
+    if (aError != OT_ERROR_NONE) {
+        return;
+    }
+    const uint8_t *src = aMessageInfo->mPeerAddr.mFields.m8;
+    uint16_t rloc16 = ((uint16_t)src[14] << 8) | src[15];
+    diag_scheduler_responded(DIAG_SCHEDULER_OWNER_SWEEP, rloc16);
+#if CONFIG_OPENTHREAD_MAC_COUNTERS_STORE
+    otNetworkDiagRoute route;
+    bool has_route = false;
+    bool has_counters = false;
+#endif
+    while (otThreadGetNextDiagnosticTlv(aMessage, &iterator, &diagTlv) == OT_ERROR_NONE) {
+        if (diagTlv.mType == OT_NETWORK_DIAGNOSTIC_TLV_ROUTE) {
+#if CONFIG_OPENTHREAD_LINK_QUALITY_STORE
+            link_quality_record_route(rloc16, &diagTlv.mData.mRoute);
+#endif
+#if CONFIG_OPENTHREAD_MAC_COUNTERS_STORE
+            route = diagTlv.mData.mRoute;
+            has_route = true;
+#endif
+        }
+#if CONFIG_OPENTHREAD_MAC_COUNTERS_STORE
+        if (diagTlv.mType == OT_NETWORK_DIAGNOSTIC_TLV_MAC_COUNTERS) {
+            has_counters = esp_ot_mac_counters_add_diag(rloc16, &diagTlv.mData.mMacCounters,
+                                                        (uint32_t)(esp_timer_get_time() / 1000000)) == ESP_OK;
+        }
+#endif
+    }
+#if CONFIG_OPENTHREAD_MAC_COUNTERS_STORE
+    /* The links are only kept for the nodes with MAC counters, the TLVs may come in any order. */
+    if (has_route && has_counters) {
+        esp_ot_mac_counters_add_route(rloc16, &route);
+    }
+#endif
+}
+
+/**
+ * @brief Query the TLVs of the due sweeps from all the other routers through the diagnostic scheduler, the links
+ *        between them and their MAC counters are not known by this node.
+ *
+ */
+static void diagnostics_sweep_worker(void *aContext)
+{
+    uint16_t routers[OT_NETWORK_MAX_ROUTER_ID + 1];
+    uint8_t types[2];
+    otRouterInfo router_info;
+    const uint8_t sweep_count = sizeof(s_diag_sweeps) / sizeof(s_diag_sweeps[0]);
+
+    for (uint8_t i = 0; i < sweep_count; i++) {
+        s_diag_sweeps[i].next = xTaskGetTickCount() + pdMS_TO_TICKS(s_diag_sweeps[i].interval_s * 1000);
+    }
+    while (true) {
+        TickType_t now = xTaskGetTickCount();
+        TickType_t next = s_diag_sweeps[0].next;
+        for (uint8_t i = 1; i < sweep_count; i++) {
+            next = (int32_t)(s_diag_sweeps[i].next - next) < 0 ? s_diag_sweeps[i].next : next;
+        }
+        if ((int32_t)(next - now) > 0) {
+            vTaskDelay(next - now);
+        }
+        now = xTaskGetTickCount();
+        uint64_t mask = 0;
+        uint32_t interval_s = UINT32_MAX;
+        for (uint8_t i = 0; i < sweep_count; i++) {
+            if ((int32_t)(s_diag_sweeps[i].next - now) <= 0) {
+                mask |= s_diag_sweeps[i].tlv_mask;
+                interval_s = s_diag_sweeps[i].interval_s < interval_s ? s_diag_sweeps[i].interval_s : interval_s;
+                s_diag_sweeps[i].next = now + pdMS_TO_TICKS(s_diag_sweeps[i].interval_s * 1000);
+            }
+        }
+        uint8_t count = 0;
+        for (uint8_t type = 0; type < 64 && count < sizeof(types); type++) {
+            if (mask & (1ULL << type)) {
+                types[count++] = type;
+            }
+        }
+
+        uint8_t router_count = 0;
+        esp_openthread_lock_acquire(portMAX_DELAY);
+        otInstance *ins = esp_openthread_get_instance();
+        otDeviceRole role = otThreadGetDeviceRole(ins);
+        uint16_t self = otThreadGetRloc16(ins);
+        for (uint8_t i = 0; role >= OT_DEVICE_ROLE_CHILD && i <= otThreadGetMaxRouterId(ins); i++) {
+            if (otThreadGetRouterInfo(ins, i, &router_info) == OT_ERROR_NONE && router_info.mRloc16 != self) {
+                routers[router_count++] = router_info.mRloc16;
+            }
+        }
+#if CONFIG_OPENTHREAD_MAC_COUNTERS_STORE
+        if (mask & (1ULL << OT_NETWORK_DIAGNOSTIC_TLV_MAC_COUNTERS)) {
+            esp_ot_mac_counters_sample_local((uint32_t)(esp_timer_get_time() / 1000000));
+        }
+#endif
+        esp_openthread_lock_release();
+
+        TickType_t deadline = xTaskGetTickCount() + pdMS_TO_TICKS(interval_s * 500);
+        for (uint8_t i = 0; i < router_count; i++) {
+            if (diag_scheduler_acquire(1, deadline) != ESP_OK) {
+                ESP_LOGW(API_TAG, "Diagnostic sweep: %u routers deferred by the scheduler", router_count - i);
+                break;
+            }
+            esp_openthread_lock_acquire(portMAX_DELAY);
+            diagnostics_send_unicast(ins, routers[i], types, count, &diagnostics_sweep_result_handler,
+                                     DIAG_SCHEDULER_OWNER_SWEEP);
+            esp_openthread_lock_release();
+        }
+        if (router_count) {
+            vTaskDelay(pdMS_TO_TICKS(DIAG_SWEEP_WAIT_MS));
+            diag_scheduler_expire(DIAG_SCHEDULER_OWNER_SWEEP);
+        }
+    }
+}
+
+static void diagnostics_sweep_start(void)
+{
+    if (xTaskCreate(diagnostics_sweep_worker, "ot_diag_sweep", DIAG_SWEEP_TASK_STACK_SIZE, NULL,
+                    DIAG_SWEEP_TASK_PRIORITY, NULL) != pdTRUE) {
+        ESP_LOGW(API_TAG, "Failed to create diagnostic sweep task");
+    }
+}
+#endif // DIAG_SWEEP_ENABLE
+
+esp_err_t handle_ot_resource_network_diagnostics_cbor_request(const thread_diagnostic_query_t *query,
+                                                              int32_t *next_cursor, cbor_writer_t *writer)
+{
+    int32_t next = DIAGNOSTIC_QUERY_NO_CURSOR;
+    bool fresh = diagnostics_snapshot_take(query);
+
+    diagnosticTlv_set_query_convert2_cbor(writer, s_diagnosticTlv_set, query, &next);
+    diagnostics_snapshot_give(query, next, fresh);
+    if (next_cursor) {
+        *next_cursor = next;
+    }
+    return writer->err;
+}
+
+#if CONFIG_OPENTHREAD_BR_WEB_DIAG_BENCHMARK
+#define DIAG_BENCHMARK_ROUNDS 10
+#define DIAG_BENCHMARK_GZIP_MIN_BITS 9
+#define DIAG_BENCHMARK_GZIP_MAX_BITS 13
+
+static esp_err_t diagnostics_benchmark_gzip_output(void *context, const uint8_t *data, size_t len)
+{
+    /* Only the size of the compressed data is measured. */
+    return ESP_OK;
+}
+
+cJSON *handle_ot_resource_network_diagnostics_benchmark_request(const thread_diagnostic_query_t *query)
+{
+    thread_diagnostic_query_t all;
+    int32_t next = DIAGNOSTIC_QUERY_NO_CURSOR;
+    size_t json_bytes = 0;
+    size_t cbor_bytes = 0;
+    int nodes = 0;
+    int64_t json_us = 0;
+    int64_t cbor_us = 0;
+    cbor_writer_t writer;
+
+    if (query == NULL) {
+        thread_diagnostic_query_reset(&all);
+        query = &all;
+    }
+    ESP_RETURN_ON_FALSE(cbor_writer_init(&writer, 1024) == ESP_OK, NULL, API_TAG, "Failed to allocate CBOR buffer");
+    bool fresh = diagnostics_snapshot_take(query);
+
+    /* Both encodings run on the same collected set, the JSON one includes the text printing as the handler does. */
+    for (int round = 0; round < DIAG_BENCHMARK_ROUNDS; round++) {
+        int64_t start = esp_timer_get_time();
+        cJSON *json = diagnosticTlv_set_query_convert2_json(s_diagnosticTlv_set, query, &next);
+        char *text = cJSON_PrintUnformatted(json);
+        json_us += esp_timer_get_time() - start;
+        nodes = cJSON_GetArraySize(json);
+        json_bytes = text ? strlen(text) : 0;
+        cJSON_free(text);
+        cJSON_Delete(json);
+
+        writer.len = 0;
+        start = esp_timer_get_time();
+        diagnosticTlv_set_query_convert2_cbor(&writer, s_diagnosticTlv_set, query, &next);
+        cbor_us += esp_timer_get_time() - start;
+        cbor_bytes = writer.len;
+    }
+    /* The JSON text is kept to measure the gzip compression of the response. */
+    cJSON *page = diagnosticTlv_set_query_convert2_json(s_diagnosticTlv_set, query, &next);
+    char *text = cJSON_PrintUnformatted(page);
+    cJSON_Delete(page);
+    diagnostics_snapshot_give(query, next, fresh);
+
+    cJSON *root = cJSON_CreateObject();
+    cJSON *json = cJSON_AddObjectToObject(root, "json");
+    cJSON *cbor = cJSON_AddObjectToObject(root, "cbor");
+    /* The gzip results show the transfer saved by each window size against the CPU time of the compression. */
+    cJSON *gzip = cJSON_AddArrayToObject(root, "gzip");
+    for (uint8_t window_bits = DIAG_BENCHMARK_GZIP_MIN_BITS; text && window_bits <= DIAG_BENCHMARK_GZIP_MAX_BITS;
+         window_bits += 2) {
+        cJSON *result = cJSON_CreateObject();
+        size_t in_len = 0;
+        size_t out_len = 0;
+        int64_t gzip_us = 0;
+        int rounds = 0;
+        for (; rounds < DIAG_BENCHMARK_ROUNDS; rounds++) {
+            int64_t start = esp_timer_get_time();
+            gzip_stream_t *stream = gzip_stream_create(window_bits, 1024, diagnostics_benchmark_gzip_output, NULL);
+            if (stream == NULL) {
+                break;
+            }
+            gzip_stream_write(stream, text, strlen(text));
+            gzip_stream_finish(stream);
+            gzip_us += esp_timer_get_time() - start;
+            gzip_stream_get_size(stream, &in_len, &out_len);
+            gzip_stream_destroy(stream);
+        }
+        cJSON_AddNumberToObject(result, "windowBits", window_bits);
+        if (rounds) {
+            cJSON_AddNumberToObject(result, "bytes", out_len);
+            cJSON_AddNumberToObject(result, "compressUs", (double)(gzip_us / rounds));
+        } else {
+            cJSON_AddStringToObject(result, "error", esp_err_to_name(ESP_ERR_NO_MEM));
+        }
+        cJSON_AddItemToArray(gzip, result);
+    }
+    cJSON_free(text);
+    cJSON_AddNumberToObject(root, "nodes", nodes);
+    cJSON_AddNumberToObject(root, "rounds", DIAG_BENCHMARK_ROUNDS);
+    cJSON_AddNumberToObject(json, "bytes", json_bytes);
+    cJSON_AddNumberToObject(json, "encodeUs", (double)(json_us / DIAG_BENCHMARK_ROUNDS));
+    cJSON_AddNumberToObject(cbor, "bytes", cbor_bytes);
+    cJSON_AddNumberToObject(cbor, "encodeUs", (double)(cbor_us / DIAG_BENCHMARK_ROUNDS));
+    if (writer.err != ESP_OK) {
+        cJSON_AddStringToObject(cbor, "error", esp_err_to_name(writer.err));
+    }
+    cbor_writer_deinit(&writer);
+    return root;
+}
+#endif // CONFIG_OPENTHREAD_BR_WEB_DIAG_BENCHMARK
+
+/*----------------------------------------------------------------------
++                       Set Thread dataset
++-----------------------------------------------------------------------*/
+otError handle_openthread_set_dataset_request(const cJSON *request)
+{
+    return OT_ERROR_NONE;
+}
+
+/*----------------------------------------------------------------------
+                        Ping Sender
+-----------------------------------------------------------------------*/
+#define PING_MAX_COUNT 10
+#define PING_DEFAULT_COUNT 4
+#define PING_DEFAULT_SIZE 32
 #define PING_TIMEOUT_MS 8000
 
 typedef struct {
@@ -1324,131 +3188,6 @@ ping_exit:
     return root;
 }
 
-/*----------------------------------------------------------------------
-                       IPv6 Address Management
------------------------------------------------------------------------*/
-cJSON *handle_openthread_ipaddr_list_request(void)
-{
-    cJSON *arr = cJSON_CreateArray();
-    char addr_str[OT_IP6_ADDRESS_STRING_SIZE];
-
-    esp_openthread_lock_acquire(portMAX_DELAY);
-    const otNetifAddress *addr = otIp6GetUnicastAddresses(esp_openthread_get_instance());
-    while (addr) {
-        cJSON *entry = cJSON_CreateObject();
-        otIp6AddressToString(&addr->mAddress, addr_str, sizeof(addr_str));
-        cJSON_AddStringToObject(entry, "address", addr_str);
-        cJSON_AddNumberToObject(entry, "prefixLength", addr->mPrefixLength);
-        const char *origin;
-        switch (addr->mAddressOrigin) {
-        case OT_ADDRESS_ORIGIN_THREAD:
-            origin = "thread";
-            break;
-        case OT_ADDRESS_ORIGIN_SLAAC:
-            origin = "slaac";
-            break;
-        case OT_ADDRESS_ORIGIN_DHCPV6:
-            origin = "dhcpv6";
-            break;
-        case OT_ADDRESS_ORIGIN_MANUAL:
-            origin = "manual";
-            break;
-        default:
-            origin = "unknown";
-            break;
-        }
-        cJSON_AddStringToObject(entry, "origin", origin);
-        cJSON_AddBoolToObject(entry, "preferred", addr->mPreferred);
-        cJSON_AddBoolToObject(entry, "meshLocal", addr->mMeshLocal);
-        cJSON_AddBoolToObject(entry, "rloc", addr->mRloc);
-        cJSON_AddItemToArray(arr, entry);
-        addr = addr->mNext;
-    }
-    esp_openthread_lock_release();
-    return arr;
-}
-
-cJSON *handle_openthread_add_ipaddr_request(const cJSON *request)
-{
-    cJSON *result = cJSON_CreateObject();
-    if (!request) {
-        ESP_LOGE(API_TAG, "Invalid ipaddr add request");
-        cJSON_AddStringToObject(result, "status", "error");
-        cJSON_AddStringToObject(result, "message", "Invalid request");
-        return result;
-    }
-
-    const cJSON *addr_json = cJSON_GetObjectItem(request, "address");
-    if (!addr_json || !addr_json->valuestring) {
-        ESP_LOGE(API_TAG, "Missing address field");
-        cJSON_AddStringToObject(result, "status", "error");
-        cJSON_AddStringToObject(result, "message", "Missing address field");
-        return result;
-    }
-
-    otNetifAddress netif_addr;
-    memset(&netif_addr, 0, sizeof(netif_addr));
-
-    esp_openthread_lock_acquire(portMAX_DELAY);
-    otError err = otIp6AddressFromString(addr_json->valuestring, &netif_addr.mAddress);
-    if (err == OT_ERROR_NONE) {
-        netif_addr.mPrefixLength = 64;
-        netif_addr.mPreferred = true;
-        netif_addr.mValid = true;
-        netif_addr.mAddressOrigin = OT_ADDRESS_ORIGIN_MANUAL;
-        err = otIp6AddUnicastAddress(esp_openthread_get_instance(), &netif_addr);
-    }
-    esp_openthread_lock_release();
-
-    if (err == OT_ERROR_NONE) {
-        cJSON_AddStringToObject(result, "status", "ok");
-        ESP_LOGI(API_TAG, "Added IPv6 address: %s", addr_json->valuestring);
-    } else {
-        cJSON_AddStringToObject(result, "status", "error");
-        cJSON_AddStringToObject(result, "message", otThreadErrorToString(err));
-        ESP_LOGE(API_TAG, "Failed to add IPv6 address: %s (err=%d)", addr_json->valuestring, err);
-    }
-    return result;
-}
-
-cJSON *handle_openthread_delete_ipaddr_request(const cJSON *request)
-{
-    cJSON *result = cJSON_CreateObject();
-    if (!request) {
-        ESP_LOGE(API_TAG, "Invalid ipaddr delete request");
-        cJSON_AddStringToObject(result, "status", "error");
-        cJSON_AddStringToObject(result, "message", "Invalid request");
-        return result;
-    }
-
-    const cJSON *addr_json = cJSON_GetObjectItem(request, "address");
-    if (!addr_json || !addr_json->valuestring) {
-        ESP_LOGE(API_TAG, "Missing address field");
-        cJSON_AddStringToObject(result, "status", "error");
-        cJSON_AddStringToObject(result, "message", "Missing address field");
-        return result;
-    }
-
-    otIp6Address addr;
-
-    esp_openthread_lock_acquire(portMAX_DELAY);
-    otError err = otIp6AddressFromString(addr_json->valuestring, &addr);
-    if (err == OT_ERROR_NONE) {
-        err = otIp6RemoveUnicastAddress(esp_openthread_get_instance(), &addr);
-    }
-    esp_openthread_lock_release();
-
-    if (err == OT_ERROR_NONE) {
-        cJSON_AddStringToObject(result, "status", "ok");
-        ESP_LOGI(API_TAG, "Removed IPv6 address: %s", addr_json->valuestring);
-    } else {
-        cJSON_AddStringToObject(result, "status", "error");
-        cJSON_AddStringToObject(result, "message", otThreadErrorToString(err));
-        ESP_LOGE(API_TAG, "Failed to remove IPv6 address: %s (err=%d)", addr_json->valuestring, err);
-    }
-    return result;
-}
-
 /*----------------------------------------------------------------------
             Border Agent ephemeral key (ePSKc)
 ----------------------------------------------------------------------*/
@@ -175,7 +175,7 @@ cJSON *otbr_properties_struct_convert2_json(openthread_properties_t *properties)
 /*----------------------------------------------------------------------
                        Scan Thread netWork
 -----------------------------------------------------------------------*/
-cJSON *available_network_struct_convert2_json(thread_network_information_t *network)
+cJSON *available_network_struct_convert2_json(const thread_network_information_t *network)
 {
     cJSON *root = cJSON_CreateObject();
 
@@ -198,64 +198,11 @@ cJSON *available_network_struct_convert2_json(thread_network_information_t *netw
     cJSON_AddNumberToObject(root, "ch", network->channel);
     cJSON_AddNumberToObject(root, "ri", network->rssi);
     cJSON_AddNumberToObject(root, "li", network->lqi);
+    cJSON_AddNumberToObject(root, "ls", network->last_seen);
 
     return root;
 }
 
-esp_err_t initialize_available_thread_networks_list(thread_network_list_t *list)
-{
-    list->next = NULL;
-    list->network = (thread_network_information_t *)malloc(sizeof(thread_network_information_t));
-    ESP_RETURN_ON_FALSE(list->network, ESP_FAIL, BASE_TAG, "Failed to create available thread networks list");
-    return ESP_OK;
-}
-
-esp_err_t append_available_thread_networks_list(thread_network_list_t *list, thread_network_information_t network)
-{
-    ESP_RETURN_ON_FALSE(list, ESP_FAIL, BASE_TAG, "Invalid network list");
-
-    thread_network_list_t *head = list;
-    while (head != NULL && head->next != NULL) {
-        head = head->next;
-    }
-    thread_network_list_t *node = (thread_network_list_t *)malloc(sizeof(thread_network_list_t));
-    if (node != NULL) {
-        node->next = NULL;
-        node->network = (thread_network_information_t *)malloc(sizeof(thread_network_information_t));
-        if (node->network != NULL)
-            memcpy(node->network, &network, sizeof(network)); /* need to free */
-        else {
-            ESP_LOGW(BASE_TAG, "Failed to create network node");
-            free(node);
-            return ESP_FAIL;
-        }
-        head->next = node;
-    } else {
-        ESP_LOGW(BASE_TAG, "Failed to create network list");
-        return ESP_FAIL;
-    }
-
-    return ESP_OK;
-}
-
-void destroy_available_thread_networks_list(thread_network_list_t *list)
-{
-    if (list == NULL)
-        return;
-    thread_network_list_t *pre = list;
-    thread_network_list_t *next = list->next;
-    while (next) {
-        free(pre->network);
-        free(pre);
-        pre = next;
-        next = pre->next;
-    }
-    free(pre->network);
-    free(pre); // delete the end node
-    list = NULL;
-    return;
-}
-
 /*----------------------------------------------------------------------
                        Form Thread netWork
 -----------------------------------------------------------------------*/
@@ -286,8 +233,9 @@ esp_err_t network_formation_param_json_convert2_struct(const cJSON *root, cJSON
         return ESP_ERR_INVALID_ARG;
     }
 
-    param->channel = cJSON_GetNumberValue(temp);
-    if (param->channel < 11 || param->channel > 26) {
+    if (cJSON_IsString(temp) && strcmp(temp->valuestring, "auto") == 0) {
+        param->channel = 0; /* the channel recommended by the last channel survey */
+    } else if ((param->channel = cJSON_GetNumberValue(temp)) < 11 || param->channel > 26) {
         ESP_LOGW(BASE_TAG, "Error: Channel Out of Range");
         cJSON_SetValuestring(log, "Error: Channel Out of Range");
         return ESP_ERR_INVALID_ARG;
@@ -347,9 +295,26 @@ void network_join_param_reset(thread_network_join_param_t *param)
 
 esp_err_t network_join_param_json_convert2_struct(const cJSON *root, cJSON *log, thread_network_join_param_t *param)
 {
-    cJSON *temp = cJSON_GetObjectItem(root, "index");
+    cJSON *temp = cJSON_GetObjectItem(root, "extPanId");
     ESP_RETURN_ON_FALSE(log, OT_ERROR_INVALID_ARGS, BASE_TAG, "Invalid argument");
-    if ((temp) && temp->valueint >= 0) {
+    if (temp) {
+        if (temp->valuestring && strlen(temp->valuestring) == OT_EXT_PAN_ID_SIZE * 2 &&
+            !string_to_hex(temp->valuestring, param->extended_panid.m8, OT_EXT_PAN_ID_SIZE)) {
+            param->has_extended_panid = true;
+        } else {
+            ESP_LOGW(BASE_TAG, "Error: Invalid Extended Panid");
+            cJSON_SetValuestring(log, "Error: Invalid Extended Panid");
+            return ESP_ERR_INVALID_ARG;
+        }
+        temp = cJSON_GetObjectItem(root, "channel");
+        if (temp && temp->valueint >= 11 && temp->valueint <= 26) {
+            param->channel = temp->valueint;
+        } else if (temp) {
+            ESP_LOGW(BASE_TAG, "Error: Invalid Channel");
+            cJSON_SetValuestring(log, "Error: Invalid Channel");
+            return ESP_ERR_INVALID_ARG;
+        }
+    } else if ((temp = cJSON_GetObjectItem(root, "index")) && temp->valueint >= 0) {
         param->index = temp->valueint;
     } else {
         ESP_LOGW(BASE_TAG, "Error: Invalid Index");
@@ -636,100 +601,248 @@ static cJSON *ChildTableEntry2Json(const otNetworkDiagChildEntry aChildEntry)
     return childEntry;
 }
 
-cJSON *diagnosticTlv_set_convert2_json(const thread_diagnosticTlv_set_t *set)
+static cJSON *diagnosticTlv_list_convert2_json(const thread_diagnosticTlv_list_t *list, uint64_t tlv_mask)
 {
-    ESP_RETURN_ON_FALSE(set, NULL, BASE_TAG, "Invalid Diagnostic Set");
-    cJSON *root = cJSON_CreateArray();
-    cJSON *child = NULL;
+    cJSON *child = cJSON_CreateObject();
     cJSON *addr_list = NULL;
     cJSON *table_list = NULL;
     char output[512];
-    thread_diagnosticTlv_list_t *list = NULL;
-    thread_diagnosticTlv_set_t *head = set->next; /* Skip the invalid header node */
-    while (head) {
-        child = cJSON_CreateObject();
-        list = head->diagTlv_next;
-        while (list && list->diagTlv) {
-            switch (list->diagTlv->mType) {
-            case OT_NETWORK_DIAGNOSTIC_TLV_EXT_ADDRESS:
-                hex_to_string(list->diagTlv->mData.mExtAddress.m8, output, OT_EXT_ADDRESS_SIZE);
-                cJSON_AddItemToObject(child, "ExtAddress", cJSON_CreateString(output));
-                break;
-            case OT_NETWORK_DIAGNOSTIC_TLV_SHORT_ADDRESS:
-                cJSON_AddItemToObject(child, "Rloc16", cJSON_CreateNumber(list->diagTlv->mData.mAddr16));
-                break;
-            case OT_NETWORK_DIAGNOSTIC_TLV_MODE:
-                cJSON_AddItemToObject(child, "Mode", Mode2Json((list->diagTlv->mData.mMode)));
-                break;
-            case OT_NETWORK_DIAGNOSTIC_TLV_TIMEOUT:
-                cJSON_AddItemToObject(child, "Timeout", cJSON_CreateNumber(list->diagTlv->mData.mTimeout));
-                break;
-            case OT_NETWORK_DIAGNOSTIC_TLV_CONNECTIVITY:
-                cJSON_AddItemToObject(child, "Connectivity", Connectivity2Json((list->diagTlv->mData.mConnectivity)));
-                break;
-            case OT_NETWORK_DIAGNOSTIC_TLV_ROUTE:
-                cJSON_AddItemToObject(child, "Route", Route2Json((list->diagTlv->mData.mRoute)));
-                break;
-            case OT_NETWORK_DIAGNOSTIC_TLV_LEADER_DATA:
-                cJSON_AddItemToObject(child, "LeaderData", LeaderData2Json((list->diagTlv->mData.mLeaderData)));
-                break;
-            case OT_NETWORK_DIAGNOSTIC_TLV_NETWORK_DATA:
-                hex_to_string(list->diagTlv->mData.mNetworkData.m8, output, list->diagTlv->mData.mNetworkData.mCount);
-                cJSON_AddItemToObject(child, "NetworkData", cJSON_CreateString(output));
-                break;
-            case OT_NETWORK_DIAGNOSTIC_TLV_IP6_ADDR_LIST: {
-                addr_list = cJSON_CreateArray();
-                if (list->diagTlv->mData.mIp6AddrList.mCount <= 0 || list->diagTlv->mData.mIp6AddrList.mCount >= 15) {
-                    cJSON_Delete(addr_list);
-                    addr_list = NULL;
-                    break;
-                }
-                for (uint16_t i = 0; i < list->diagTlv->mData.mIp6AddrList.mCount; ++i) {
-                    cJSON_AddItemToArray(addr_list, IpAddr2Json((list->diagTlv->mData.mIp6AddrList.mList[i])));
-                }
-                cJSON_AddItemToObject(child, "IP6AddressList", addr_list);
-
-            } break;
-            case OT_NETWORK_DIAGNOSTIC_TLV_MAC_COUNTERS:
-                cJSON_AddItemToObject(child, "MACCounters", MacCounters2Json((list->diagTlv->mData.mMacCounters)));
-                break;
-            case OT_NETWORK_DIAGNOSTIC_TLV_BATTERY_LEVEL:
-                cJSON_AddItemToObject(child, "BatteryLevel", cJSON_CreateNumber(list->diagTlv->mData.mBatteryLevel));
-                break;
-            case OT_NETWORK_DIAGNOSTIC_TLV_SUPPLY_VOLTAGE:
-                cJSON_AddItemToObject(child, "SupplyVoltage", cJSON_CreateNumber(list->diagTlv->mData.mSupplyVoltage));
-                break;
-            case OT_NETWORK_DIAGNOSTIC_TLV_CHILD_TABLE: {
-                table_list = cJSON_CreateArray();
-                for (uint16_t i = 0; i < list->diagTlv->mData.mChildTable.mCount; ++i) {
-                    cJSON_AddItemToArray(table_list,
-                                         ChildTableEntry2Json((list->diagTlv->mData.mChildTable.mTable[i])));
-                }
-                cJSON_AddItemToObject(child, "ChildTable", table_list);
-
-            } break;
-            case OT_NETWORK_DIAGNOSTIC_TLV_CHANNEL_PAGES:
-                hex_to_string(list->diagTlv->mData.mChannelPages.m8, output, list->diagTlv->mData.mChannelPages.mCount);
-                cJSON_AddItemToObject(child, "ChannelPages", cJSON_CreateString(output));
-                break;
-            case OT_NETWORK_DIAGNOSTIC_TLV_MAX_CHILD_TIMEOUT:
-                cJSON_AddItemToObject(child, "MaxChildTimeout",
-                                      cJSON_CreateNumber(list->diagTlv->mData.mMaxChildTimeout));
-                break;
-            default:
+    while (list && list->diagTlv) {
+        if (tlv_mask && (list->diagTlv->mType >= 64 || !(tlv_mask & (1ULL << list->diagTlv->mType)))) {
+            list = list->next;
+            continue;
+        }
+        switch (list->diagTlv->mType) {
+        case OT_NETWORK_DIAGNOSTIC_TLV_EXT_ADDRESS:
+            hex_to_string(list->diagTlv->mData.mExtAddress.m8, output, OT_EXT_ADDRESS_SIZE);
+            cJSON_AddItemToObject(child, "ExtAddress", cJSON_CreateString(output));
+            break;
+        case OT_NETWORK_DIAGNOSTIC_TLV_SHORT_ADDRESS:
+            cJSON_AddItemToObject(child, "Rloc16", cJSON_CreateNumber(list->diagTlv->mData.mAddr16));
+            break;
+        case OT_NETWORK_DIAGNOSTIC_TLV_MODE:
+            cJSON_AddItemToObject(child, "Mode", Mode2Json((list->diagTlv->mData.mMode)));
+            break;
+        case OT_NETWORK_DIAGNOSTIC_TLV_TIMEOUT:
+            cJSON_AddItemToObject(child, "Timeout", cJSON_CreateNumber(list->diagTlv->mData.mTimeout));
+            break;
+        case OT_NETWORK_DIAGNOSTIC_TLV_CONNECTIVITY:
+            cJSON_AddItemToObject(child, "Connectivity", Connectivity2Json((list->diagTlv->mData.mConnectivity)));
+            break;
+        case OT_NETWORK_DIAGNOSTIC_TLV_ROUTE:
+            cJSON_AddItemToObject(child, "Route", Route2Json((list->diagTlv->mData.mRoute)));
+            break;
+        case OT_NETWORK_DIAGNOSTIC_TLV_LEADER_DATA:
+            cJSON_AddItemToObject(child, "LeaderData", LeaderData2Json((list->diagTlv->mData.mLeaderData)));
+            break;
+        case OT_NETWORK_DIAGNOSTIC_TLV_NETWORK_DATA:
+            hex_to_string(list->diagTlv->mData.mNetworkData.m8, output, list->diagTlv->mData.mNetworkData.mCount);
+            cJSON_AddItemToObject(child, "NetworkData", cJSON_CreateString(output));
+            break;
+        case OT_NETWORK_DIAGNOSTIC_TLV_IP6_ADDR_LIST: {
+            addr_list = cJSON_CreateArray();
+            if (list->diagTlv->mData.mIp6AddrList.mCount <= 0 || list->diagTlv->mData.mIp6AddrList.mCount >= 15) {
+                cJSON_Delete(addr_list);
+                addr_list = NULL;
                 break;
             }
-            list = list->next;
+            for (uint16_t i = 0; i < list->diagTlv->mData.mIp6AddrList.mCount; ++i) {
+                cJSON_AddItemToArray(addr_list, IpAddr2Json((list->diagTlv->mData.mIp6AddrList.mList[i])));
+            }
+            cJSON_AddItemToObject(child, "IP6AddressList", addr_list);
+
+        } break;
+        case OT_NETWORK_DIAGNOSTIC_TLV_MAC_COUNTERS:
+            cJSON_AddItemToObject(child, "MACCounters", MacCounters2Json((list->diagTlv->mData.mMacCounters)));
+            break;
+        case OT_NETWORK_DIAGNOSTIC_TLV_BATTERY_LEVEL:
+            cJSON_AddItemToObject(child, "BatteryLevel", cJSON_CreateNumber(list->diagTlv->mData.mBatteryLevel));
+            break;
+        case OT_NETWORK_DIAGNOSTIC_TLV_SUPPLY_VOLTAGE:
+            cJSON_AddItemToObject(child, "SupplyVoltage", cJSON_CreateNumber(list->diagTlv->mData.mSupplyVoltage));
+            break;
+        case OT_NETWORK_DIAGNOSTIC_TLV_CHILD_TABLE: {
+            table_list = cJSON_CreateArray();
+            for (uint16_t i = 0; i < list->diagTlv->mData.mChildTable.mCount; ++i) {
+                cJSON_AddItemToArray(table_list,
+                                     ChildTableEntry2Json((list->diagTlv->mData.mChildTable.mTable[i])));
+            }
+            cJSON_AddItemToObject(child, "ChildTable", table_list);
+
+        } break;
+        case OT_NETWORK_DIAGNOSTIC_TLV_CHANNEL_PAGES:
+            hex_to_string(list->diagTlv->mData.mChannelPages.m8, output, list->diagTlv->mData.mChannelPages.mCount);
+            cJSON_AddItemToObject(child, "ChannelPages", cJSON_CreateString(output));
+            break;
+        case OT_NETWORK_DIAGNOSTIC_TLV_MAX_CHILD_TIMEOUT:
+            cJSON_AddItemToObject(child, "MaxChildTimeout",
+                                  cJSON_CreateNumber(list->diagTlv->mData.mMaxChildTimeout));
+            break;
+        default:
+            break;
         }
+        list = list->next;
+    }
+    return child;
+}
+
+cJSON *diagnosticTlv_set_convert2_json(const thread_diagnosticTlv_set_t *set)
+{
+    ESP_RETURN_ON_FALSE(set, NULL, BASE_TAG, "Invalid Diagnostic Set");
+    cJSON *root = cJSON_CreateArray();
+    thread_diagnosticTlv_set_t *head = set->next; /* Skip the invalid header node */
+    while (head) {
         // avoid to add empty child.
-        if (head->diagTlv_next && child) {
-            cJSON_AddItemToArray(root, child);
+        if (head->diagTlv_next) {
+            cJSON_AddItemToArray(root, diagnosticTlv_list_convert2_json(head->diagTlv_next, 0));
         }
         head = head->next;
     }
     return root;
 }
 
+static const struct {
+    uint8_t type;
+    const char *name;
+} s_diagnosticTlv_names[] = {
+    {OT_NETWORK_DIAGNOSTIC_TLV_EXT_ADDRESS, "ExtAddress"},
+    {OT_NETWORK_DIAGNOSTIC_TLV_SHORT_ADDRESS, "Rloc16"},
+    {OT_NETWORK_DIAGNOSTIC_TLV_MODE, "Mode"},
+    {OT_NETWORK_DIAGNOSTIC_TLV_TIMEOUT, "Timeout"},
+    {OT_NETWORK_DIAGNOSTIC_TLV_CONNECTIVITY, "Connectivity"},
+    {OT_NETWORK_DIAGNOSTIC_TLV_ROUTE, "Route"},
+    {OT_NETWORK_DIAGNOSTIC_TLV_LEADER_DATA, "LeaderData"},
+    {OT_NETWORK_DIAGNOSTIC_TLV_NETWORK_DATA, "NetworkData"},
+    {OT_NETWORK_DIAGNOSTIC_TLV_IP6_ADDR_LIST, "IP6AddressList"},
+    {OT_NETWORK_DIAGNOSTIC_TLV_MAC_COUNTERS, "MACCounters"},
+    {OT_NETWORK_DIAGNOSTIC_TLV_BATTERY_LEVEL, "BatteryLevel"},
+    {OT_NETWORK_DIAGNOSTIC_TLV_SUPPLY_VOLTAGE, "SupplyVoltage"},
+    {OT_NETWORK_DIAGNOSTIC_TLV_CHILD_TABLE, "ChildTable"},
+    {OT_NETWORK_DIAGNOSTIC_TLV_CHANNEL_PAGES, "ChannelPages"},
+    {OT_NETWORK_DIAGNOSTIC_TLV_MAX_CHILD_TIMEOUT, "MaxChildTimeout"},
+};
+
+void thread_diagnostic_query_reset(thread_diagnostic_query_t *query)
+{
+    memset(query, 0x00, sizeof(thread_diagnostic_query_t));
+    query->cursor = DIAGNOSTIC_QUERY_NO_CURSOR;
+    query->role = -1;
+    query->has_children = -1;
+    query->target = DIAGNOSTIC_TARGET_ROUTERS;
+}
+
+esp_err_t diagnosticTlv_names_convert2_mask(char *names, uint64_t *mask)
+{
+    ESP_RETURN_ON_FALSE(names && mask, ESP_ERR_INVALID_ARG, BASE_TAG, "Invalid TLV names");
+    char *save = NULL;
+    *mask = 0;
+    for (char *name = strtok_r(names, ",", &save); name; name = strtok_r(NULL, ",", &save)) {
+        size_t i = 0;
+        while (i < sizeof(s_diagnosticTlv_names) / sizeof(s_diagnosticTlv_names[0]) &&
+               strcmp(name, s_diagnosticTlv_names[i].name)) {
+            i++;
+        }
+        ESP_RETURN_ON_FALSE(i < sizeof(s_diagnosticTlv_names) / sizeof(s_diagnosticTlv_names[0]),
+                            ESP_ERR_NOT_FOUND, BASE_TAG, "Unknown diagnostic TLV: %s", name);
+        *mask |= 1ULL << s_diagnosticTlv_names[i].type;
+    }
+    return ESP_OK;
+}
+
+static const otNetworkDiagTlv *diagnosticTlv_list_find(const thread_diagnosticTlv_list_t *list, uint8_t type)
+{
+    for (; list && list->diagTlv; list = list->next) {
+        if (list->diagTlv->mType == type) {
+            return list->diagTlv;
+        }
+    }
+    return NULL;
+}
+
+static bool diagnosticTlv_set_node_match(const thread_diagnosticTlv_set_t *node, uint16_t rloc16,
+                                         const thread_diagnostic_query_t *query)
+{
+    const otNetworkDiagTlv *tlv = NULL;
+    uint8_t router_id = rloc16 >> 10;
+
+    if (query->role >= 0) {
+        tlv = diagnosticTlv_list_find(node->diagTlv_next, OT_NETWORK_DIAGNOSTIC_TLV_LEADER_DATA);
+        bool is_leader = tlv && tlv->mData.mLeaderData.mLeaderRouterId == router_id;
+        if (is_leader != (query->role == OT_DEVICE_ROLE_LEADER)) {
+            return false;
+        }
+    }
+    if (query->has_children >= 0) {
+        tlv = diagnosticTlv_list_find(node->diagTlv_next, OT_NETWORK_DIAGNOSTIC_TLV_CHILD_TABLE);
+        bool has_children = tlv && tlv->mData.mChildTable.mCount > 0;
+        if (has_children != (query->has_children == 1)) {
+            return false;
+        }
+    }
+    if (query->lq_below) {
+        /* Only the established links count, the entry of the node itself has no link quality. */
+        bool below = false;
+        tlv = diagnosticTlv_list_find(node->diagTlv_next, OT_NETWORK_DIAGNOSTIC_TLV_ROUTE);
+        for (uint8_t i = 0; tlv && i < tlv->mData.mRoute.mRouteCount && !below; i++) {
+            const otNetworkDiagRouteData *route = &tlv->mData.mRoute.mRouteData[i];
+            if (route->mRouterId == router_id || (route->mLinkQualityIn == 0 && route->mLinkQualityOut == 0)) {
+                continue;
+            }
+            below = route->mLinkQualityIn < query->lq_below || route->mLinkQualityOut < query->lq_below;
+        }
+        if (!below) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const thread_diagnosticTlv_set_t *diagnosticTlv_set_query_next(const thread_diagnosticTlv_set_t *set,
+                                                                const thread_diagnostic_query_t *query, uint32_t from,
+                                                                uint16_t *rloc16)
+{
+    /* The set is in the order of arrival, pick the nodes one by one in the order of RLOC16, so that only the
+       nodes of a page are converted. */
+    const thread_diagnosticTlv_set_t *node = NULL;
+    for (const thread_diagnosticTlv_set_t *head = set->next; head; head = head->next) {
+        uint16_t key = (uint16_t)strtoul(head->rloc16, NULL, 16);
+        if (head->diagTlv_next == NULL || key < from || (node && key >= *rloc16) ||
+            !diagnosticTlv_set_node_match(head, key, query)) {
+            continue;
+        }
+        node = head;
+        *rloc16 = key;
+    }
+    return node;
+}
+
+cJSON *diagnosticTlv_set_query_convert2_json(const thread_diagnosticTlv_set_t *set,
+                                             const thread_diagnostic_query_t *query, int32_t *next_cursor)
+{
+    ESP_RETURN_ON_FALSE(set && query, NULL, BASE_TAG, "Invalid Diagnostic Set");
+    cJSON *root = cJSON_CreateArray();
+    uint32_t from = query->cursor == DIAGNOSTIC_QUERY_NO_CURSOR ? 0 : (uint32_t)query->cursor;
+    uint16_t count = 0;
+    uint16_t rloc16 = 0;
+    const thread_diagnosticTlv_set_t *node = NULL;
+
+    if (next_cursor) {
+        *next_cursor = DIAGNOSTIC_QUERY_NO_CURSOR;
+    }
+    while (from <= UINT16_MAX && (node = diagnosticTlv_set_query_next(set, query, from, &rloc16))) {
+        if (query->limit && count == query->limit) {
+            if (next_cursor) {
+                *next_cursor = rloc16;
+            }
+            break;
+        }
+        cJSON_AddItemToArray(root, diagnosticTlv_list_convert2_json(node->diagTlv_next, query->tlv_mask));
+        count++;
+        from = (uint32_t)rloc16 + 1;
+    }
+    return root;
+}
+
 void thread_node_information_reset(thread_node_information_t *node)
 {
     memset(node, 0x00, sizeof(thread_node_information_t));
@@ -0,0 +1,535 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_br_web_cbor.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "esp_check.h"
+#include "esp_log.h"
+
+#define CBOR_TAG "web_cbor"
+
+#define CBOR_MAJOR_UINT 0
+#define CBOR_MAJOR_NINT 1
+#define CBOR_MAJOR_BYTES 2
+#define CBOR_MAJOR_TEXT 3
+#define CBOR_MAJOR_ARRAY 4
+#define CBOR_MAJOR_MAP 5
+
+#define CBOR_FALSE 0xf4
+#define CBOR_TRUE 0xf5
+#define CBOR_NULL 0xf6
+#define CBOR_FLOAT32 0xfa
+#define CBOR_FLOAT64 0xfb
+#define CBOR_INDEFINITE 31
+#define CBOR_BREAK 0xff
+
+/*----------------------------------------------------------------------
+                       CBOR Writer
+-----------------------------------------------------------------------*/
+esp_err_t cbor_writer_init(cbor_writer_t *writer, size_t size)
+{
+    ESP_RETURN_ON_FALSE(writer && size, ESP_ERR_INVALID_ARG, CBOR_TAG, "Invalid CBOR writer");
+    writer->buf = (uint8_t *)malloc(size);
+    writer->len = 0;
+    writer->size = writer->buf ? size : 0;
+    writer->err = writer->buf ? ESP_OK : ESP_ERR_NO_MEM;
+    return writer->err;
+}
+
+void cbor_writer_deinit(cbor_writer_t *writer)
+{
+    free(writer->buf);
+    writer->buf = NULL;
+    writer->len = 0;
+    writer->size = 0;
+}
+
+static void cbor_write(cbor_writer_t *writer, const uint8_t *data, size_t len)
+{
+    if (writer->err != ESP_OK || len == 0) {
+        return;
+    }
+    if (writer->len + len > writer->size) {
+        size_t size = writer->size * 2;
+        while (size < writer->len + len) {
+            size *= 2;
+        }
+        uint8_t *buf = (uint8_t *)realloc(writer->buf, size);
+        if (buf == NULL) {
+            ESP_LOGE(CBOR_TAG, "Failed to grow the CBOR buffer to %u bytes", (unsigned)size);
+            writer->err = ESP_ERR_NO_MEM;
+            return;
+        }
+        writer->buf = buf;
+        writer->size = size;
+    }
+    memcpy(writer->buf + writer->len, data, len);
+    writer->len += len;
+}
+
+static void cbor_put_head(cbor_writer_t *writer, uint8_t major, uint64_t value)
+{
+    uint8_t head[9];
+    size_t len = 0;
+
+    if (value < 24) {
+        head[len++] = (major << 5) | (uint8_t)value;
+    } else if (value <= UINT8_MAX) {
+        head[len++] = (major << 5) | 24;
+        head[len++] = (uint8_t)value;
+    } else if (value <= UINT16_MAX) {
+        head[len++] = (major << 5) | 25;
+        head[len++] = (uint8_t)(value >> 8);
+        head[len++] = (uint8_t)value;
+    } else if (value <= UINT32_MAX) {
+        head[len++] = (major << 5) | 26;
+        for (int shift = 24; shift >= 0; shift -= 8) {
+            head[len++] = (uint8_t)(value >> shift);
+        }
+    } else {
+        head[len++] = (major << 5) | 27;
+        for (int shift = 56; shift >= 0; shift -= 8) {
+            head[len++] = (uint8_t)(value >> shift);
+        }
+    }
+    cbor_write(writer, head, len);
+}
+
+void cbor_put_uint(cbor_writer_t *writer, uint64_t value)
+{
+    cbor_put_head(writer, CBOR_MAJOR_UINT, value);
+}
+
+void cbor_put_int(cbor_writer_t *writer, int64_t value)
+{
+    if (value >= 0) {
+        cbor_put_head(writer, CBOR_MAJOR_UINT, (uint64_t)value);
+    } else {
+        cbor_put_head(writer, CBOR_MAJOR_NINT, ~(uint64_t)value);
+    }
+}
+
+void cbor_put_bool(cbor_writer_t *writer, bool value)
+{
+    uint8_t simple = value ? CBOR_TRUE : CBOR_FALSE;
+    cbor_write(writer, &simple, 1);
+}
+
+void cbor_put_null(cbor_writer_t *writer)
+{
+    uint8_t simple = CBOR_NULL;
+    cbor_write(writer, &simple, 1);
+}
+
+void cbor_put_double(cbor_writer_t *writer, double value)
+{
+    uint8_t data[9];
+    size_t len = 0;
+    float single = (float)value;
+
+    /* Use the single precision whenever it is exact, most of the values are small counters or ratios. */
+    if ((double)single == value || isnan(value)) {
+        uint32_t bits;
+        memcpy(&bits, &single, sizeof(bits));
+        data[len++] = CBOR_FLOAT32;
+        for (int shift = 24; shift >= 0; shift -= 8) {
+            data[len++] = (uint8_t)(bits >> shift);
+        }
+    } else {
+        uint64_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        data[len++] = CBOR_FLOAT64;
+        for (int shift = 56; shift >= 0; shift -= 8) {
+            data[len++] = (uint8_t)(bits >> shift);
+        }
+    }
+    cbor_write(writer, data, len);
+}
+
+void cbor_put_bytes(cbor_writer_t *writer, const uint8_t *data, size_t len)
+{
+    cbor_put_head(writer, CBOR_MAJOR_BYTES, len);
+    cbor_write(writer, data, len);
+}
+
+void cbor_put_text(cbor_writer_t *writer, const char *text)
+{
+    size_t len = text ? strlen(text) : 0;
+    cbor_put_head(writer, CBOR_MAJOR_TEXT, len);
+    cbor_write(writer, (const uint8_t *)text, len);
+}
+
+void cbor_put_array(cbor_writer_t *writer, size_t count)
+{
+    cbor_put_head(writer, CBOR_MAJOR_ARRAY, count);
+}
+
+void cbor_put_map(cbor_writer_t *writer, size_t count)
+{
+    cbor_put_head(writer, CBOR_MAJOR_MAP, count);
+}
+
+void cbor_put_array_indefinite(cbor_writer_t *writer)
+{
+    uint8_t head = (CBOR_MAJOR_ARRAY << 5) | CBOR_INDEFINITE;
+    cbor_write(writer, &head, 1);
+}
+
+void cbor_put_map_indefinite(cbor_writer_t *writer)
+{
+    uint8_t head = (CBOR_MAJOR_MAP << 5) | CBOR_INDEFINITE;
+    cbor_write(writer, &head, 1);
+}
+
+void cbor_put_break(cbor_writer_t *writer)
+{
+    uint8_t simple = CBOR_BREAK;
+    cbor_write(writer, &simple, 1);
+}
+
+void cbor_put_json(cbor_writer_t *writer, const cJSON *item)
+{
+    const cJSON *child = NULL;
+
+    if (cJSON_IsBool(item)) {
+        cbor_put_bool(writer, cJSON_IsTrue(item));
+    } else if (cJSON_IsNumber(item)) {
+        double value = cJSON_GetNumberValue(item);
+        if (value == floor(value) && fabs(value) <= 9007199254740992.0) {
+            cbor_put_int(writer, (int64_t)value);
+        } else {
+            cbor_put_double(writer, value);
+        }
+    } else if (cJSON_IsString(item) || cJSON_IsRaw(item)) {
+        cbor_put_text(writer, item->valuestring);
+    } else if (cJSON_IsArray(item)) {
+        cbor_put_array(writer, cJSON_GetArraySize(item));
+        cJSON_ArrayForEach(child, item)
+        {
+            cbor_put_json(writer, child);
+        }
+    } else if (cJSON_IsObject(item)) {
+        cbor_put_map(writer, cJSON_GetArraySize(item));
+        cJSON_ArrayForEach(child, item)
+        {
+            cbor_put_text(writer, child->string);
+            cbor_put_json(writer, child);
+        }
+    } else {
+        cbor_put_null(writer);
+    }
+}
+
+/*----------------------------------------------------------------------
+                       Thread Structures to CBOR
+-----------------------------------------------------------------------*/
+static void cbor_put_key_uint(cbor_writer_t *writer, const char *key, uint64_t value)
+{
+    cbor_put_text(writer, key);
+    cbor_put_uint(writer, value);
+}
+
+static void cbor_put_key_bool(cbor_writer_t *writer, const char *key, bool value)
+{
+    cbor_put_text(writer, key);
+    cbor_put_bool(writer, value);
+}
+
+static void cbor_put_key_bytes(cbor_writer_t *writer, const char *key, const uint8_t *data, size_t len)
+{
+    cbor_put_text(writer, key);
+    cbor_put_bytes(writer, data, len);
+}
+
+void LeaderData2Cbor(cbor_writer_t *writer, const otLeaderData *aLeaderData)
+{
+    cbor_put_map(writer, 5);
+    cbor_put_key_uint(writer, "PartitionId", aLeaderData->mPartitionId);
+    cbor_put_key_uint(writer, "Weighting", aLeaderData->mWeighting);
+    cbor_put_key_uint(writer, "DataVersion", aLeaderData->mDataVersion);
+    cbor_put_key_uint(writer, "StableDataVersion", aLeaderData->mStableDataVersion);
+    cbor_put_key_uint(writer, "LeaderRouterId", aLeaderData->mLeaderRouterId);
+}
+
+static void Timestamp2Cbor(cbor_writer_t *writer, const otTimestamp *aTimestamp)
+{
+    cbor_put_map(writer, 3);
+    cbor_put_key_uint(writer, "Seconds", aTimestamp->mSeconds);
+    cbor_put_key_uint(writer, "Ticks", aTimestamp->mTicks);
+    cbor_put_key_bool(writer, "Authoritative", aTimestamp->mAuthoritative);
+}
+
+static void SecurityPolicy2Cbor(cbor_writer_t *writer, const otSecurityPolicy *aSecurityPolicy)
+{
+    cbor_put_map(writer, 10);
+    cbor_put_key_uint(writer, "RotationTime", aSecurityPolicy->mRotationTime);
+    cbor_put_key_bool(writer, "ObtainNetworkKey", aSecurityPolicy->mObtainNetworkKeyEnabled);
+    cbor_put_key_bool(writer, "NativeCommissioning", aSecurityPolicy->mNativeCommissioningEnabled);
+    cbor_put_key_bool(writer, "Routers", aSecurityPolicy->mRoutersEnabled);
+    cbor_put_key_bool(writer, "ExternalCommissioning", aSecurityPolicy->mExternalCommissioningEnabled);
+    cbor_put_key_bool(writer, "CommercialCommissioning", aSecurityPolicy->mCommercialCommissioningEnabled);
+    cbor_put_key_bool(writer, "AutonomousEnrollment", aSecurityPolicy->mAutonomousEnrollmentEnabled);
+    cbor_put_key_bool(writer, "NetworkKeyProvisioning", aSecurityPolicy->mNetworkKeyProvisioningEnabled);
+    cbor_put_key_bool(writer, "TobleLink", aSecurityPolicy->mTobleLinkEnabled);
+    cbor_put_key_bool(writer, "NonCcmRouters", aSecurityPolicy->mNonCcmRoutersEnabled);
+}
+
+void ActiveDataset2Cbor(cbor_writer_t *writer, const otOperationalDataset *aActiveDataset)
+{
+    const otOperationalDatasetComponents *components = &aActiveDataset->mComponents;
+
+    cbor_put_map_indefinite(writer);
+    if (components->mIsActiveTimestampPresent) {
+        cbor_put_text(writer, "ActiveTimestamp");
+        Timestamp2Cbor(writer, &aActiveDataset->mActiveTimestamp);
+    }
+    if (components->mIsNetworkKeyPresent) {
+        cbor_put_key_bytes(writer, "NetworkKey", aActiveDataset->mNetworkKey.m8, OT_NETWORK_KEY_SIZE);
+    }
+    if (components->mIsNetworkNamePresent) {
+        cbor_put_text(writer, "NetworkName");
+        cbor_put_text(writer, aActiveDataset->mNetworkName.m8);
+    }
+    if (components->mIsExtendedPanIdPresent) {
+        cbor_put_key_bytes(writer, "ExtPanId", aActiveDataset->mExtendedPanId.m8, OT_EXT_PAN_ID_SIZE);
+    }
+    if (components->mIsMeshLocalPrefixPresent) {
+        cbor_put_key_bytes(writer, "MeshLocalPrefix", aActiveDataset->mMeshLocalPrefix.m8, OT_IP6_PREFIX_SIZE);
+    }
+    if (components->mIsPanIdPresent) {
+        cbor_put_key_uint(writer, "PanId", aActiveDataset->mPanId);
+    }
+    if (components->mIsChannelPresent) {
+        cbor_put_key_uint(writer, "Channel", aActiveDataset->mChannel);
+    }
+    if (components->mIsPskcPresent) {
+        cbor_put_key_bytes(writer, "PSKc", aActiveDataset->mPskc.m8, OT_PSKC_MAX_SIZE);
+    }
+    if (components->mIsSecurityPolicyPresent) {
+        cbor_put_text(writer, "SecurityPolicy");
+        SecurityPolicy2Cbor(writer, &aActiveDataset->mSecurityPolicy);
+    }
+    if (components->mIsChannelMaskPresent) {
+        cbor_put_key_uint(writer, "ChannelMask", aActiveDataset->mChannelMask);
+    }
+    cbor_put_break(writer);
+}
+
+void PendingDataset2Cbor(cbor_writer_t *writer, const otOperationalDataset *aPendingDataset)
+{
+    cbor_put_map_indefinite(writer);
+    cbor_put_text(writer, "ActiveDataset");
+    ActiveDataset2Cbor(writer, aPendingDataset);
+    if (aPendingDataset->mComponents.mIsPendingTimestampPresent) {
+        cbor_put_text(writer, "PendingTimestamp");
+        Timestamp2Cbor(writer, &aPendingDataset->mPendingTimestamp);
+    }
+    if (aPendingDataset->mComponents.mIsDelayPresent) {
+        cbor_put_key_uint(writer, "Delay", aPendingDataset->mDelay);
+    }
+    cbor_put_break(writer);
+}
+
+void thread_node_struct_convert2_cbor(cbor_writer_t *writer, const thread_node_information_t *node)
+{
+    cbor_put_map(writer, 8);
+    cbor_put_text(writer, "NetworkName");
+    cbor_put_text(writer, node->network_name.m8);
+    cbor_put_key_bytes(writer, "ExtPanId", node->extended_panid.m8, OT_EXT_PAN_ID_SIZE);
+    cbor_put_key_bytes(writer, "ExtAddress", node->extended_address.m8, OT_EXT_ADDRESS_SIZE);
+    cbor_put_key_bytes(writer, "RlocAddress", node->rloc_address.mFields.m8, OT_IP6_ADDRESS_SIZE);
+    cbor_put_text(writer, "LeaderData");
+    LeaderData2Cbor(writer, &node->leader_data);
+    cbor_put_key_uint(writer, "State", node->role);
+    cbor_put_key_uint(writer, "Rloc16", node->rloc16);
+    cbor_put_key_uint(writer, "NumOfRouter", node->router_number);
+}
+
+static void Mode2Cbor(cbor_writer_t *writer, const otLinkModeConfig *aMode)
+{
+    cbor_put_array(writer, 3);
+    cbor_put_bool(writer, aMode->mRxOnWhenIdle);
+    cbor_put_bool(writer, aMode->mDeviceType);
+    cbor_put_bool(writer, aMode->mNetworkData);
+}
+
+static void Connectivity2Cbor(cbor_writer_t *writer, const otNetworkDiagConnectivity *aConnectivity)
+{
+    cbor_put_map(writer, 9);
+    cbor_put_text(writer, "ParentPriority");
+    cbor_put_int(writer, aConnectivity->mParentPriority);
+    cbor_put_key_uint(writer, "LinkQuality3", aConnectivity->mLinkQuality3);
+    cbor_put_key_uint(writer, "LinkQuality2", aConnectivity->mLinkQuality2);
+    cbor_put_key_uint(writer, "LinkQuality1", aConnectivity->mLinkQuality1);
+    cbor_put_key_uint(writer, "LeaderCost", aConnectivity->mLeaderCost);
+    cbor_put_key_uint(writer, "IdSequence", aConnectivity->mIdSequence);
+    cbor_put_key_uint(writer, "ActiveRouters", aConnectivity->mActiveRouters);
+    cbor_put_key_uint(writer, "SedBufferSize", aConnectivity->mSedBufferSize);
+    cbor_put_key_uint(writer, "SedDatagramCount", aConnectivity->mSedDatagramCount);
+}
+
+static void Route2Cbor(cbor_writer_t *writer, const otNetworkDiagRoute *aRoute)
+{
+    cbor_put_map(writer, 2);
+    cbor_put_key_uint(writer, "IdSequence", aRoute->mIdSequence);
+    cbor_put_text(writer, "RouteData");
+    cbor_put_array(writer, aRoute->mRouteCount);
+    for (uint16_t i = 0; i < aRoute->mRouteCount; ++i) {
+        const otNetworkDiagRouteData *data = &aRoute->mRouteData[i];
+        cbor_put_array(writer, 4);
+        cbor_put_uint(writer, data->mRouterId);
+        cbor_put_uint(writer, data->mLinkQualityOut);
+        cbor_put_uint(writer, data->mLinkQualityIn);
+        cbor_put_uint(writer, data->mRouteCost);
+    }
+}
+
+static void MacCounters2Cbor(cbor_writer_t *writer, const otNetworkDiagMacCounters *aMacCounters)
+{
+    cbor_put_map(writer, 9);
+    cbor_put_key_uint(writer, "IfInUnknownProtos", aMacCounters->mIfInUnknownProtos);
+    cbor_put_key_uint(writer, "IfInErrors", aMacCounters->mIfInErrors);
+    cbor_put_key_uint(writer, "IfOutErrors", aMacCounters->mIfOutErrors);
+    cbor_put_key_uint(writer, "IfInUcastPkts", aMacCounters->mIfInUcastPkts);
+    cbor_put_key_uint(writer, "IfInBroadcastPkts", aMacCounters->mIfInBroadcastPkts);
+    cbor_put_key_uint(writer, "IfInDiscards", aMacCounters->mIfInDiscards);
+    cbor_put_key_uint(writer, "IfOutUcastPkts", aMacCounters->mIfOutUcastPkts);
+    cbor_put_key_uint(writer, "IfOutBroadcastPkts", aMacCounters->mIfOutBroadcastPkts);
+    cbor_put_key_uint(writer, "IfOutDiscards", aMacCounters->mIfOutDiscards);
+}
+
+static void ChildTable2Cbor(cbor_writer_t *writer, const otNetworkDiagChildTable *aChildTable)
+{
+    cbor_put_array(writer, aChildTable->mCount);
+    for (uint16_t i = 0; i < aChildTable->mCount; ++i) {
+        const otNetworkDiagChildEntry *entry = &aChildTable->mTable[i];
+        cbor_put_array(writer, 3);
+        cbor_put_uint(writer, entry->mChildId);
+        cbor_put_uint(writer, entry->mTimeout);
+        Mode2Cbor(writer, &entry->mMode);
+    }
+}
+
+static void diagnosticTlv_list_convert2_cbor(cbor_writer_t *writer, const thread_diagnosticTlv_list_t *list,
+                                             uint64_t tlv_mask)
+{
+    cbor_put_map_indefinite(writer);
+    for (; list && list->diagTlv; list = list->next) {
+        const otNetworkDiagTlv *tlv = list->diagTlv;
+        if (tlv_mask && (tlv->mType >= 64 || !(tlv_mask & (1ULL << tlv->mType)))) {
+            continue;
+        }
+        switch (tlv->mType) {
+        case OT_NETWORK_DIAGNOSTIC_TLV_EXT_ADDRESS:
+            cbor_put_uint(writer, tlv->mType);
+            cbor_put_bytes(writer, tlv->mData.mExtAddress.m8, OT_EXT_ADDRESS_SIZE);
+            break;
+        case OT_NETWORK_DIAGNOSTIC_TLV_SHORT_ADDRESS:
+            cbor_put_uint(writer, tlv->mType);
+            cbor_put_uint(writer, tlv->mData.mAddr16);
+            break;
+        case OT_NETWORK_DIAGNOSTIC_TLV_MODE:
+            cbor_put_uint(writer, tlv->mType);
+            Mode2Cbor(writer, &tlv->mData.mMode);
+            break;
+        case OT_NETWORK_DIAGNOSTIC_TLV_TIMEOUT:
+            cbor_put_uint(writer, tlv->mType);
+            cbor_put_uint(writer, tlv->mData.mTimeout);
+            break;
+        case OT_NETWORK_DIAGNOSTIC_TLV_CONNECTIVITY:
+            cbor_put_uint(writer, tlv->mType);
+            Connectivity2Cbor(writer, &tlv->mData.mConnectivity);
+            break;
+        case OT_NETWORK_DIAGNOSTIC_TLV_ROUTE:
+            cbor_put_uint(writer, tlv->mType);
+            Route2Cbor(writer, &tlv->mData.mRoute);
+            break;
+        case OT_NETWORK_DIAGNOSTIC_TLV_LEADER_DATA:
+            cbor_put_uint(writer, tlv->mType);
+            LeaderData2Cbor(writer, &tlv->mData.mLeaderData);
+            break;
+        case OT_NETWORK_DIAGNOSTIC_TLV_NETWORK_DATA:
+            cbor_put_uint(writer, tlv->mType);
+            cbor_put_bytes(writer, tlv->mData.mNetworkData.m8, tlv->mData.mNetworkData.mCount);
+            break;
+        case OT_NETWORK_DIAGNOSTIC_TLV_IP6_ADDR_LIST: {
+            uint8_t count = tlv->mData.mIp6AddrList.mCount;
+            size_t max_count = sizeof(tlv->mData.mIp6AddrList.mList) / sizeof(otIp6Address);
+            if (count == 0 || count > max_count) {
+                break;
+            }
+            cbor_put_uint(writer, tlv->mType);
+            cbor_put_array(writer, count);
+            for (uint8_t i = 0; i < count; ++i) {
+                cbor_put_bytes(writer, tlv->mData.mIp6AddrList.mList[i].mFields.m8, OT_IP6_ADDRESS_SIZE);
+            }
+        } break;
+        case OT_NETWORK_DIAGNOSTIC_TLV_MAC_COUNTERS:
+            cbor_put_uint(writer, tlv->mType);
+            MacCounters2Cbor(writer, &tlv->mData.mMacCounters);
+            break;
+        case OT_NETWORK_DIAGNOSTIC_TLV_BATTERY_LEVEL:
+            cbor_put_uint(writer, tlv->mType);
+            cbor_put_uint(writer, tlv->mData.mBatteryLevel);
+            break;
+        case OT_NETWORK_DIAGNOSTIC_TLV_SUPPLY_VOLTAGE:
+            cbor_put_uint(writer, tlv->mType);
+            cbor_put_uint(writer, tlv->mData.mSupplyVoltage);
+            break;
+        case OT_NETWORK_DIAGNOSTIC_TLV_CHILD_TABLE:
+            cbor_put_uint(writer, tlv->mType);
+            ChildTable2Cbor(writer, &tlv->mData.mChildTable);
+            break;
+        case OT_NETWORK_DIAGNOSTIC_TLV_CHANNEL_PAGES:
+            cbor_put_uint(writer, tlv->mType);
+            cbor_put_bytes(writer, tlv->mData.mChannelPages.m8, tlv->mData.mChannelPages.mCount);
+            break;
+        case OT_NETWORK_DIAGNOSTIC_TLV_MAX_CHILD_TIMEOUT:
+            cbor_put_uint(writer, tlv->mType);
+            cbor_put_uint(writer, tlv->mData.mMaxChildTimeout);
+            break;
+        default:
+            break;
+        }
+    }
+    cbor_put_break(writer);
+}
+
+void diagnosticTlv_set_query_convert2_cbor(cbor_writer_t *writer, const thread_diagnosticTlv_set_t *set,
+                                           const thread_diagnostic_query_t *query, int32_t *next_cursor)
+{
+    thread_diagnostic_query_t all;
+    uint32_t from = 0;
+    uint16_t count = 0;
+    uint16_t rloc16 = 0;
+    const thread_diagnosticTlv_set_t *node = NULL;
+
+    if (query == NULL) {
+        thread_diagnostic_query_reset(&all);
+        query = &all;
+    }
+    if (query->cursor != DIAGNOSTIC_QUERY_NO_CURSOR) {
+        from = (uint32_t)query->cursor;
+    }
+    if (next_cursor) {
+        *next_cursor = DIAGNOSTIC_QUERY_NO_CURSOR;
+    }
+    cbor_put_array_indefinite(writer);
+    while (set && from <= UINT16_MAX && (node = diagnosticTlv_set_query_next(set, query, from, &rloc16))) {
+        if (query->limit && count == query->limit) {
+            if (next_cursor) {
+                *next_cursor = rloc16;
+            }
+            break;
+        }
+        diagnosticTlv_list_convert2_cbor(writer, node->diagTlv_next, query->tlv_mask);
+        count++;
+        from = (uint32_t)rloc16 + 1;
+    }
+    cbor_put_break(writer);
+}
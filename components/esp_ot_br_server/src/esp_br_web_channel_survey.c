@@ -0,0 +1,295 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_br_web_channel_survey.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "esp_check.h"
+#include "esp_log.h"
+#include "esp_openthread.h"
+#include "esp_openthread_lock.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "openthread/ip6.h"
+#include "openthread/link.h"
+#include "openthread/platform/radio.h"
+#include "openthread/thread.h"
+
+#define SURVEY_TAG "web_survey"
+
+#define CHANNEL_SURVEY_MIN_CHANNEL 11
+#define CHANNEL_SURVEY_CHANNEL_NUM 16
+#define CHANNEL_SURVEY_CHANNEL_MASK 0x07fff800
+#define CHANNEL_SURVEY_MAX_PANS 8             /* the distinct PANs counted per channel */
+#define CHANNEL_SURVEY_RSSI_FLOOR -100        /* dBm, the lower RSSI add nothing to the score */
+#define CHANNEL_SURVEY_PAN_PENALTY 8          /* the score of each other PAN, as many dB of average RSSI */
+#define CHANNEL_SURVEY_ACTIVE_SCAN_MS 300     /* the default active scan duration of each channel */
+#define CHANNEL_SURVEY_SCAN_MARGIN_MS 2000    /* the time for a scan to report after its last channel */
+
+typedef struct channel_survey_channel {
+    uint16_t samples;
+    int8_t max_rssi;
+    int8_t max_beacon_rssi; /* INT8_MIN without any beacon */
+    int32_t sum_rssi;
+    uint8_t pan_count;
+    uint16_t pans[CHANNEL_SURVEY_MAX_PANS];
+    int16_t score; /* the lower the better */
+    uint8_t rank;  /* 1 for the best, 0 if the channel was not scanned */
+} channel_survey_channel_t;
+
+typedef struct channel_survey_result {
+    bool valid;
+    uint32_t time; /* the seconds since boot of the end of the survey */
+    uint32_t duration_ms;
+    uint16_t scan_ms;
+    uint16_t passes;
+    uint8_t recommended;
+    channel_survey_channel_t channels[CHANNEL_SURVEY_CHANNEL_NUM];
+} channel_survey_result_t;
+
+static SemaphoreHandle_t s_survey_running; /* held while a survey runs */
+static SemaphoreHandle_t s_survey_done;    /* given by the scan callbacks at the end of a scan */
+static SemaphoreHandle_t s_result_mutex;
+static uint32_t s_generation; /* the survey the scan callbacks report to, changed under the OpenThread lock */
+static uint16_t s_own_panid;
+static channel_survey_result_t s_work;   /* written by the scan callbacks */
+static channel_survey_result_t s_result; /* the last complete survey */
+
+void channel_survey_init(void)
+{
+    s_survey_running = xSemaphoreCreateMutex();
+    s_survey_done = xSemaphoreCreateBinary();
+    s_result_mutex = xSemaphoreCreateMutex();
+    memset(&s_result, 0, sizeof(s_result));
+}
+
+static channel_survey_channel_t *channel_survey_get(uint8_t channel)
+{
+    if (channel < CHANNEL_SURVEY_MIN_CHANNEL || channel >= CHANNEL_SURVEY_MIN_CHANNEL + CHANNEL_SURVEY_CHANNEL_NUM) {
+        return NULL;
+    }
+    return &s_work.channels[channel - CHANNEL_SURVEY_MIN_CHANNEL];
+}
+
+/* A scan which did not complete in time may still report, after its survey gave up or during the next one. */
+static bool channel_survey_is_current(void *aContext)
+{
+    return (uint32_t)(uintptr_t)aContext == s_generation;
+}
+
+static void channel_survey_energy_handler(otEnergyScanResult *aResult, void *aContext)
+{
+    if (!channel_survey_is_current(aContext)) {
+        return;
+    }
+    if (aResult == NULL) {
+        xSemaphoreGive(s_survey_done);
+        return;
+    }
+    channel_survey_channel_t *channel = channel_survey_get(aResult->mChannel);
+    if (channel && aResult->mMaxRssi != OT_RADIO_RSSI_INVALID) {
+        channel->samples++;
+        channel->sum_rssi += aResult->mMaxRssi;
+        if (aResult->mMaxRssi > channel->max_rssi) {
+            channel->max_rssi = aResult->mMaxRssi;
+        }
+    }
+}
+
+static void channel_survey_active_handler(otActiveScanResult *aResult, void *aContext)
+{
+    if (!channel_survey_is_current(aContext)) {
+        return;
+    }
+    if (aResult == NULL) {
+        xSemaphoreGive(s_survey_done);
+        return;
+    }
+    channel_survey_channel_t *channel = channel_survey_get(aResult->mChannel);
+    if (!channel || aResult->mPanId == s_own_panid) {
+        return;
+    }
+    if (aResult->mRssi > channel->max_beacon_rssi) {
+        channel->max_beacon_rssi = aResult->mRssi;
+    }
+    for (uint8_t i = 0; i < channel->pan_count; i++) {
+        if (channel->pans[i] == aResult->mPanId) {
+            return;
+        }
+    }
+    if (channel->pan_count < CHANNEL_SURVEY_MAX_PANS) {
+        channel->pans[channel->pan_count++] = aResult->mPanId;
+    }
+}
+
+static bool channel_survey_better(const channel_survey_channel_t *a, const channel_survey_channel_t *b)
+{
+    return a->score != b->score ? a->score < b->score : a->max_rssi < b->max_rssi;
+}
+
+static void channel_survey_rank(channel_survey_result_t *survey)
+{
+    uint8_t rank = 0;
+
+    for (uint8_t i = 0; i < CHANNEL_SURVEY_CHANNEL_NUM; i++) {
+        channel_survey_channel_t *channel = &survey->channels[i];
+        if (channel->samples) {
+            int32_t average = channel->sum_rssi / channel->samples;
+            channel->score = (average > CHANNEL_SURVEY_RSSI_FLOOR ? average - CHANNEL_SURVEY_RSSI_FLOOR : 0) +
+                             (channel->max_rssi > CHANNEL_SURVEY_RSSI_FLOOR
+                                  ? (channel->max_rssi - CHANNEL_SURVEY_RSSI_FLOOR) / 4
+                                  : 0) +
+                             channel->pan_count * CHANNEL_SURVEY_PAN_PENALTY;
+        }
+    }
+    /* Rank by selection, the channels with the same score are ordered by their max RSSI. */
+    while (true) {
+        channel_survey_channel_t *best = NULL;
+        uint8_t best_index = 0;
+        for (uint8_t i = 0; i < CHANNEL_SURVEY_CHANNEL_NUM; i++) {
+            channel_survey_channel_t *channel = &survey->channels[i];
+            if (channel->samples && channel->rank == 0 && (!best || channel_survey_better(channel, best))) {
+                best = channel;
+                best_index = i;
+            }
+        }
+        if (!best) {
+            break;
+        }
+        best->rank = ++rank;
+        if (rank == 1) {
+            survey->recommended = CHANNEL_SURVEY_MIN_CHANNEL + best_index;
+        }
+    }
+}
+
+static esp_err_t channel_survey_wait(uint32_t timeout_ms)
+{
+    return xSemaphoreTake(s_survey_done, pdMS_TO_TICKS(timeout_ms)) == pdTRUE ? ESP_OK : ESP_ERR_TIMEOUT;
+}
+
+esp_err_t channel_survey_run(uint32_t duration_ms, uint16_t scan_ms)
+{
+    esp_err_t ret = ESP_OK;
+    otError error = OT_ERROR_NONE;
+    otInstance *ins = esp_openthread_get_instance();
+    uint32_t mask = 0;
+    uint8_t channel_count = 0;
+    void *context = NULL;
+
+    ESP_RETURN_ON_FALSE(duration_ms <= CHANNEL_SURVEY_MAX_DURATION_MS && scan_ms >= CHANNEL_SURVEY_MIN_SCAN_MS &&
+                            scan_ms <= CHANNEL_SURVEY_MAX_SCAN_MS,
+                        ESP_ERR_INVALID_ARG, SURVEY_TAG, "Invalid survey duration %lu or scan duration %u",
+                        (unsigned long)duration_ms, scan_ms);
+    ESP_RETURN_ON_FALSE(xSemaphoreTake(s_survey_running, 0) == pdTRUE, ESP_ERR_INVALID_STATE, SURVEY_TAG,
+                        "A channel survey is running");
+    int64_t start = esp_timer_get_time();
+    memset(&s_work, 0, sizeof(s_work));
+    for (uint8_t i = 0; i < CHANNEL_SURVEY_CHANNEL_NUM; i++) {
+        s_work.channels[i].max_rssi = INT8_MIN;
+        s_work.channels[i].max_beacon_rssi = INT8_MIN;
+    }
+    xSemaphoreTake(s_survey_done, 0);
+
+    esp_openthread_lock_acquire(portMAX_DELAY);
+    context = (void *)(uintptr_t)++s_generation;
+    mask = otLinkGetSupportedChannelMask(ins) & CHANNEL_SURVEY_CHANNEL_MASK;
+    s_own_panid = otThreadGetDeviceRole(ins) != OT_DEVICE_ROLE_DISABLED ? otLinkGetPanId(ins) : OT_PANID_BROADCAST;
+    if (!otIp6IsEnabled(ins)) {
+        error = otIp6SetEnabled(ins, true);
+    }
+    if (error == OT_ERROR_NONE) {
+        error = otLinkActiveScan(ins, mask, 0, channel_survey_active_handler, context);
+    }
+    esp_openthread_lock_release();
+    ESP_GOTO_ON_FALSE(error == OT_ERROR_NONE, ESP_FAIL, exit, SURVEY_TAG, "Failed to start active scan: %s",
+                      otThreadErrorToString(error));
+    for (uint32_t bits = mask; bits; bits &= bits - 1) {
+        channel_count++;
+    }
+    ESP_GOTO_ON_ERROR(
+        channel_survey_wait(channel_count * CHANNEL_SURVEY_ACTIVE_SCAN_MS + CHANNEL_SURVEY_SCAN_MARGIN_MS), exit,
+        SURVEY_TAG, "Active scan did not complete");
+
+    do {
+        esp_openthread_lock_acquire(portMAX_DELAY);
+        error = otLinkEnergyScan(ins, mask, scan_ms, channel_survey_energy_handler, context);
+        esp_openthread_lock_release();
+        ESP_GOTO_ON_FALSE(error == OT_ERROR_NONE, ESP_FAIL, exit, SURVEY_TAG, "Failed to start energy scan: %s",
+                          otThreadErrorToString(error));
+        ESP_GOTO_ON_ERROR(channel_survey_wait(channel_count * scan_ms + CHANNEL_SURVEY_SCAN_MARGIN_MS), exit,
+                          SURVEY_TAG, "Energy scan did not complete");
+        s_work.passes++;
+    } while ((esp_timer_get_time() - start) / 1000 < duration_ms);
+
+    s_work.valid = true;
+    s_work.time = (uint32_t)(esp_timer_get_time() / 1000000);
+    s_work.duration_ms = (uint32_t)((esp_timer_get_time() - start) / 1000);
+    s_work.scan_ms = scan_ms;
+    channel_survey_rank(&s_work);
+    xSemaphoreTake(s_result_mutex, portMAX_DELAY);
+    s_result = s_work;
+    xSemaphoreGive(s_result_mutex);
+    ESP_LOGI(SURVEY_TAG, "Channel survey of %u passes, channel %u recommended", s_work.passes, s_work.recommended);
+exit:
+    /* The late callbacks of a scan which timed out must not write into the next survey. */
+    esp_openthread_lock_acquire(portMAX_DELAY);
+    s_generation++;
+    esp_openthread_lock_release();
+    xSemaphoreGive(s_survey_running);
+    return ret;
+}
+
+uint8_t channel_survey_recommended(void)
+{
+    uint8_t channel = 0;
+
+    xSemaphoreTake(s_result_mutex, portMAX_DELAY);
+    channel = s_result.valid ? s_result.recommended : 0;
+    xSemaphoreGive(s_result_mutex);
+    return channel;
+}
+
+cJSON *channel_survey_convert2_json(void)
+{
+    cJSON *root = NULL;
+
+    xSemaphoreTake(s_result_mutex, portMAX_DELAY);
+    if (s_result.valid) {
+        cJSON *channels = cJSON_CreateArray();
+        root = cJSON_CreateObject();
+        cJSON_AddNumberToObject(root, "Time", s_result.time);
+        cJSON_AddNumberToObject(root, "Duration", s_result.duration_ms);
+        cJSON_AddNumberToObject(root, "ScanDuration", s_result.scan_ms);
+        cJSON_AddNumberToObject(root, "Passes", s_result.passes);
+        cJSON_AddNumberToObject(root, "Recommended", s_result.recommended);
+        for (uint8_t i = 0; i < CHANNEL_SURVEY_CHANNEL_NUM; i++) {
+            const channel_survey_channel_t *channel = &s_result.channels[i];
+            if (channel->samples == 0) {
+                continue;
+            }
+            cJSON *item = cJSON_CreateObject();
+            cJSON_AddNumberToObject(item, "Channel", CHANNEL_SURVEY_MIN_CHANNEL + i);
+            cJSON_AddNumberToObject(item, "Rank", channel->rank);
+            cJSON_AddNumberToObject(item, "Score", channel->score);
+            cJSON_AddNumberToObject(item, "Samples", channel->samples);
+            cJSON_AddNumberToObject(item, "AvgRssi", channel->sum_rssi / channel->samples);
+            cJSON_AddNumberToObject(item, "MaxRssi", channel->max_rssi);
+            cJSON_AddNumberToObject(item, "Pans", channel->pan_count);
+            if (channel->max_beacon_rssi == INT8_MIN) {
+                cJSON_AddNullToObject(item, "MaxBeaconRssi");
+            } else {
+                cJSON_AddNumberToObject(item, "MaxBeaconRssi", channel->max_beacon_rssi);
+            }
+            cJSON_AddItemToArray(channels, item);
+        }
+        cJSON_AddItemToObject(root, "Channels", channels);
+    }
+    xSemaphoreGive(s_result_mutex);
+    return root;
+}
@@ -0,0 +1,208 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_br_web_diag_scheduler.h"
+#include <inttypes.h>
+#include <string.h>
+#include "esp_check.h"
+#include "esp_log.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+#define SCHEDULER_TAG "web_diag_sched"
+
+#define DIAG_SCHEDULER_DEFAULT_RATE 10        /* queries per second */
+#define DIAG_SCHEDULER_DEFAULT_BURST 4        /* queries issued at once */
+#define DIAG_SCHEDULER_MAX_RATE 100           /* queries per second */
+#define DIAG_SCHEDULER_MAX_BURST 64           /* queries issued at once */
+#define DIAG_SCHEDULER_MIN_RATE_MILLI 500     /* the adaptation never goes below 0.5 query per second */
+#define DIAG_SCHEDULER_RATE_STEP_MILLI 100    /* the rate is raised by 0.1 query per second per timely response */
+#define DIAG_SCHEDULER_LATENCY_TARGET_MS 1500 /* the responses slower than it lower the rate */
+#define DIAG_SCHEDULER_MAX_PENDING 64         /* the unicast queries tracked for the latency and the loss */
+
+typedef struct diag_scheduler_pending {
+    uint16_t rloc16;
+    uint8_t owner;
+    TickType_t tick;
+} diag_scheduler_pending_t;
+
+typedef struct diag_scheduler {
+    SemaphoreHandle_t mutex;
+    uint16_t rate;        /* the configured queries per second */
+    uint16_t burst;       /* the size of the bucket */
+    uint32_t rate_milli;  /* the current rate in 1/1000 query per second */
+    int32_t tokens_milli; /* the tokens in 1/1000 token, negative while a query above the burst is paid back */
+    TickType_t refill_tick;
+    TickType_t multicast_tick[DIAG_SCHEDULER_OWNERS]; /* the tick of the multicast query waiting, 0 for none */
+    diag_scheduler_pending_t pending[DIAG_SCHEDULER_MAX_PENDING];
+    uint8_t pending_count;
+    uint32_t issued;
+    uint32_t deferred;
+    uint32_t responses;
+    uint32_t lost;
+    uint32_t latency_avg_ms; /* the moving average of the latency, weighted by 1/8 */
+    uint32_t latency_max_ms;
+} diag_scheduler_t;
+
+static diag_scheduler_t s_scheduler;
+
+void diag_scheduler_init(void)
+{
+    memset(&s_scheduler, 0, sizeof(s_scheduler));
+    s_scheduler.mutex = xSemaphoreCreateMutex();
+    s_scheduler.rate = DIAG_SCHEDULER_DEFAULT_RATE;
+    s_scheduler.burst = DIAG_SCHEDULER_DEFAULT_BURST;
+    s_scheduler.rate_milli = DIAG_SCHEDULER_DEFAULT_RATE * 1000;
+    s_scheduler.tokens_milli = DIAG_SCHEDULER_DEFAULT_BURST * 1000;
+    s_scheduler.refill_tick = xTaskGetTickCount();
+}
+
+esp_err_t diag_scheduler_configure(uint16_t rate, uint16_t burst)
+{
+    ESP_RETURN_ON_FALSE(rate > 0 && rate <= DIAG_SCHEDULER_MAX_RATE && burst > 0 && burst <= DIAG_SCHEDULER_MAX_BURST,
+                        ESP_ERR_INVALID_ARG, SCHEDULER_TAG, "Invalid scheduler rate %u or burst %u", rate, burst);
+    xSemaphoreTake(s_scheduler.mutex, portMAX_DELAY);
+    s_scheduler.rate = rate;
+    s_scheduler.burst = burst;
+    s_scheduler.rate_milli = (uint32_t)rate * 1000;
+    if (s_scheduler.tokens_milli > (int32_t)burst * 1000) {
+        s_scheduler.tokens_milli = (int32_t)burst * 1000;
+    }
+    xSemaphoreGive(s_scheduler.mutex);
+    return ESP_OK;
+}
+
+static void diag_scheduler_refill(TickType_t now)
+{
+    int64_t tokens = s_scheduler.tokens_milli +
+                     (int64_t)pdTICKS_TO_MS(now - s_scheduler.refill_tick) * s_scheduler.rate_milli / 1000;
+    int32_t size = (int32_t)s_scheduler.burst * 1000;
+    s_scheduler.tokens_milli = tokens >= size ? size : (int32_t)tokens;
+    s_scheduler.refill_tick = now;
+}
+
+esp_err_t diag_scheduler_acquire(uint16_t cost, TickType_t deadline)
+{
+    while (1) {
+        xSemaphoreTake(s_scheduler.mutex, portMAX_DELAY);
+        TickType_t now = xTaskGetTickCount();
+        diag_scheduler_refill(now);
+        /* A query above the burst only waits for a full bucket, but it is charged in full. */
+        int32_t needed = (int32_t)(cost < s_scheduler.burst ? cost : s_scheduler.burst) * 1000;
+        if (s_scheduler.tokens_milli >= needed) {
+            s_scheduler.tokens_milli -= (int32_t)cost * 1000;
+            s_scheduler.issued += cost;
+            xSemaphoreGive(s_scheduler.mutex);
+            return ESP_OK;
+        }
+        /* Sleep until the missing tokens and the debt are refilled, unless the deadline comes first. */
+        TickType_t wait = pdMS_TO_TICKS((uint64_t)(needed - s_scheduler.tokens_milli) * 1000 / s_scheduler.rate_milli);
+        if ((int32_t)(deadline - now) <= 0 || (int32_t)(deadline - now) < (int32_t)wait) {
+            s_scheduler.deferred += cost;
+            xSemaphoreGive(s_scheduler.mutex);
+            return ESP_ERR_TIMEOUT;
+        }
+        xSemaphoreGive(s_scheduler.mutex);
+        vTaskDelay(wait > 0 ? wait : 1);
+    }
+}
+
+void diag_scheduler_sent(diag_scheduler_owner_t owner, uint16_t rloc16)
+{
+    xSemaphoreTake(s_scheduler.mutex, portMAX_DELAY);
+    if (rloc16 == DIAG_SCHEDULER_MULTICAST) {
+        s_scheduler.multicast_tick[owner] = xTaskGetTickCount();
+    } else if (s_scheduler.pending_count < DIAG_SCHEDULER_MAX_PENDING) {
+        s_scheduler.pending[s_scheduler.pending_count].rloc16 = rloc16;
+        s_scheduler.pending[s_scheduler.pending_count].owner = owner;
+        s_scheduler.pending[s_scheduler.pending_count].tick = xTaskGetTickCount();
+        s_scheduler.pending_count++;
+    }
+    xSemaphoreGive(s_scheduler.mutex);
+}
+
+void diag_scheduler_responded(diag_scheduler_owner_t owner, uint16_t rloc16)
+{
+    TickType_t sent = 0;
+    xSemaphoreTake(s_scheduler.mutex, portMAX_DELAY);
+    for (uint8_t i = 0; i < s_scheduler.pending_count; i++) {
+        if (s_scheduler.pending[i].rloc16 == rloc16 && s_scheduler.pending[i].owner == owner) {
+            sent = s_scheduler.pending[i].tick;
+            s_scheduler.pending[i] = s_scheduler.pending[--s_scheduler.pending_count];
+            break;
+        }
+    }
+    if (sent == 0) {
+        sent = s_scheduler.multicast_tick[owner];
+    }
+    s_scheduler.responses++;
+    if (sent) {
+        uint32_t latency = pdTICKS_TO_MS(xTaskGetTickCount() - sent);
+        s_scheduler.latency_avg_ms = s_scheduler.latency_avg_ms ? (s_scheduler.latency_avg_ms * 7 + latency) / 8
+                                                                : latency;
+        if (latency > s_scheduler.latency_max_ms) {
+            s_scheduler.latency_max_ms = latency;
+        }
+        /* Additive increase while the responses are in time, multiplicative decrease when they are slow. */
+        if (latency > DIAG_SCHEDULER_LATENCY_TARGET_MS) {
+            s_scheduler.rate_milli = s_scheduler.rate_milli * 7 / 8;
+        } else {
+            s_scheduler.rate_milli += DIAG_SCHEDULER_RATE_STEP_MILLI;
+        }
+        if (s_scheduler.rate_milli > (uint32_t)s_scheduler.rate * 1000) {
+            s_scheduler.rate_milli = (uint32_t)s_scheduler.rate * 1000;
+        }
+        if (s_scheduler.rate_milli < DIAG_SCHEDULER_MIN_RATE_MILLI) {
+            s_scheduler.rate_milli = DIAG_SCHEDULER_MIN_RATE_MILLI;
+        }
+    }
+    xSemaphoreGive(s_scheduler.mutex);
+}
+
+void diag_scheduler_expire(diag_scheduler_owner_t owner)
+{
+    uint8_t lost = 0;
+    xSemaphoreTake(s_scheduler.mutex, portMAX_DELAY);
+    for (uint8_t i = 0; i < s_scheduler.pending_count;) {
+        if (s_scheduler.pending[i].owner == owner) {
+            s_scheduler.pending[i] = s_scheduler.pending[--s_scheduler.pending_count];
+            lost++;
+        } else {
+            i++;
+        }
+    }
+    if (lost) {
+        /* A lost response is taken as congestion, the rate is halved once per collection. */
+        s_scheduler.lost += lost;
+        s_scheduler.rate_milli /= 2;
+        if (s_scheduler.rate_milli < DIAG_SCHEDULER_MIN_RATE_MILLI) {
+            s_scheduler.rate_milli = DIAG_SCHEDULER_MIN_RATE_MILLI;
+        }
+        ESP_LOGW(SCHEDULER_TAG, "%u diagnostic responses lost, rate lowered to %" PRIu32 " mq/s", lost,
+                 s_scheduler.rate_milli);
+    }
+    s_scheduler.multicast_tick[owner] = 0;
+    xSemaphoreGive(s_scheduler.mutex);
+}
+
+cJSON *diag_scheduler_metrics_convert2_json(void)
+{
+    cJSON *root = cJSON_CreateObject();
+    xSemaphoreTake(s_scheduler.mutex, portMAX_DELAY);
+    diag_scheduler_refill(xTaskGetTickCount());
+    cJSON_AddNumberToObject(root, "Rate", s_scheduler.rate);
+    cJSON_AddNumberToObject(root, "Burst", s_scheduler.burst);
+    cJSON_AddNumberToObject(root, "CurrentRate", s_scheduler.rate_milli / 1000.0);
+    cJSON_AddNumberToObject(root, "Tokens", s_scheduler.tokens_milli / 1000);
+    cJSON_AddNumberToObject(root, "Issued", s_scheduler.issued);
+    cJSON_AddNumberToObject(root, "Deferred", s_scheduler.deferred);
+    cJSON_AddNumberToObject(root, "Responses", s_scheduler.responses);
+    cJSON_AddNumberToObject(root, "Lost", s_scheduler.lost);
+    cJSON_AddNumberToObject(root, "LatencyAvgMs", s_scheduler.latency_avg_ms);
+    cJSON_AddNumberToObject(root, "LatencyMaxMs", s_scheduler.latency_max_ms);
+    xSemaphoreGive(s_scheduler.mutex);
+    return root;
+}
@@ -0,0 +1,313 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_br_web_gzip.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "esp_check.h"
+#include "esp_log.h"
+
+#define GZIP_TAG "web_gzip"
+
+#define GZIP_MIN_WINDOW_BITS 9
+#define GZIP_MAX_WINDOW_BITS 13
+#define GZIP_MIN_MATCH 3
+#define GZIP_MAX_MATCH 258
+#define GZIP_MAX_CHAIN 16 /* the max number of candidates compared for a match */
+#define GZIP_HASH_BITS 10
+#define GZIP_HASH_SIZE (1 << GZIP_HASH_BITS)
+#define GZIP_END_OF_BLOCK 256
+
+struct gzip_stream {
+    gzip_stream_output_t output;
+    void *context;
+    esp_err_t err;
+    size_t window_size;
+    uint8_t *window; /* the history and the lookahead, twice the window size */
+    uint16_t *prev;  /* the previous position + 1 with the same hash, indexed by position & (window_size - 1) */
+    uint16_t head[GZIP_HASH_SIZE]; /* the last position + 1 of each hash, 0 for none */
+    size_t fill;                   /* the bytes in the window */
+    size_t pos;                    /* the first byte of the window which is not compressed */
+    uint32_t crc;
+    size_t in_len;
+    size_t out_len;
+    uint32_t bits;
+    uint8_t bit_count;
+    uint8_t *out;
+    size_t out_size;
+    size_t out_fill;
+};
+
+static const uint16_t kLengthBase[] = {3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+                                       31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+static const uint8_t kLengthExtra[] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+                                       2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+static const uint16_t kDistanceBase[] = {1,    2,    3,    4,    5,    7,     9,     13,    17,  25,
+                                         33,   49,   65,   97,   129,  193,   257,   385,   513, 769,
+                                         1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+static const uint8_t kDistanceExtra[] = {0, 0, 0, 0, 1, 1, 2, 2,  3,  3,  4,  4,  5,  5,  6,
+                                         6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+static const uint32_t kCrc32Table[] = {0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac, 0x76dc4190, 0x6b6b51f4,
+                                       0x4db26158, 0x5005713c, 0xedb88320, 0xf00f9344, 0xd6d6a3e8, 0xcb61b38c,
+                                       0x9b64c2b0, 0x86d3d2d4, 0xa00ae278, 0xbdbdf21c};
+
+static uint32_t gzip_crc32(uint32_t crc, const uint8_t *data, size_t len)
+{
+    crc = ~crc;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ kCrc32Table[crc & 0x0f];
+        crc = (crc >> 4) ^ kCrc32Table[crc & 0x0f];
+    }
+    return ~crc;
+}
+
+static void gzip_flush_output(gzip_stream_t *stream)
+{
+    if (stream->err == ESP_OK && stream->out_fill) {
+        stream->err = stream->output(stream->context, stream->out, stream->out_fill);
+        stream->out_len += stream->out_fill;
+    }
+    stream->out_fill = 0;
+}
+
+static void gzip_put_byte(gzip_stream_t *stream, uint8_t byte)
+{
+    stream->out[stream->out_fill++] = byte;
+    if (stream->out_fill == stream->out_size) {
+        gzip_flush_output(stream);
+    }
+}
+
+static void gzip_put_bits(gzip_stream_t *stream, uint32_t value, uint8_t count)
+{
+    stream->bits |= value << stream->bit_count;
+    stream->bit_count += count;
+    while (stream->bit_count >= 8) {
+        gzip_put_byte(stream, (uint8_t)stream->bits);
+        stream->bits >>= 8;
+        stream->bit_count -= 8;
+    }
+}
+
+/* The Huffman codes are packed starting with the most significant bit. */
+static void gzip_put_code(gzip_stream_t *stream, uint16_t code, uint8_t len)
+{
+    uint16_t reversed = 0;
+    for (uint8_t i = 0; i < len; i++) {
+        reversed = (reversed << 1) | ((code >> i) & 1);
+    }
+    gzip_put_bits(stream, reversed, len);
+}
+
+static void gzip_put_symbol(gzip_stream_t *stream, uint16_t symbol)
+{
+    /* The fixed literal/length codes of RFC 1951 3.2.6 */
+    if (symbol <= 143) {
+        gzip_put_code(stream, 0x30 + symbol, 8);
+    } else if (symbol <= 255) {
+        gzip_put_code(stream, 0x190 + symbol - 144, 9);
+    } else if (symbol <= 279) {
+        gzip_put_code(stream, symbol - 256, 7);
+    } else {
+        gzip_put_code(stream, 0xc0 + symbol - 280, 8);
+    }
+}
+
+static void gzip_put_match(gzip_stream_t *stream, uint16_t len, uint16_t distance)
+{
+    uint8_t i = sizeof(kLengthBase) / sizeof(kLengthBase[0]) - 1;
+    while (kLengthBase[i] > len) {
+        i--;
+    }
+    gzip_put_symbol(stream, 257 + i);
+    gzip_put_bits(stream, len - kLengthBase[i], kLengthExtra[i]);
+
+    i = sizeof(kDistanceBase) / sizeof(kDistanceBase[0]) - 1;
+    while (kDistanceBase[i] > distance) {
+        i--;
+    }
+    gzip_put_code(stream, i, 5);
+    gzip_put_bits(stream, distance - kDistanceBase[i], kDistanceExtra[i]);
+}
+
+static uint16_t gzip_hash(const uint8_t *data)
+{
+    uint32_t value = ((uint32_t)data[0] << 16) | ((uint32_t)data[1] << 8) | data[2];
+    return (uint16_t)((value * 2654435761u) >> (32 - GZIP_HASH_BITS));
+}
+
+static uint16_t gzip_longest_match(gzip_stream_t *stream, size_t pos, size_t max_len, uint16_t *distance)
+{
+    const uint8_t *current = stream->window + pos;
+    uint16_t best = 0;
+    size_t candidate = stream->head[gzip_hash(current)];
+
+    for (int chain = 0; chain < GZIP_MAX_CHAIN && candidate; chain++) {
+        size_t match = candidate - 1;
+        if (match >= pos || pos - match >= stream->window_size) {
+            break;
+        }
+        const uint8_t *previous = stream->window + match;
+        if (previous[best] == current[best]) {
+            uint16_t len = 0;
+            while (len < max_len && previous[len] == current[len]) {
+                len++;
+            }
+            if (len > best) {
+                best = len;
+                *distance = (uint16_t)(pos - match);
+                if (len == max_len) {
+                    break;
+                }
+            }
+        }
+        candidate = stream->prev[match & (stream->window_size - 1)];
+        if (candidate > match) {
+            break;
+        }
+    }
+    return best;
+}
+
+static void gzip_insert(gzip_stream_t *stream, size_t pos)
+{
+    uint16_t hash = gzip_hash(stream->window + pos);
+    stream->prev[pos & (stream->window_size - 1)] = stream->head[hash];
+    stream->head[hash] = (uint16_t)(pos + 1);
+}
+
+static void gzip_compress(gzip_stream_t *stream, bool finish)
+{
+    /* Without finishing, keep a full lookahead so that the matches are not cut at the end of the input. */
+    while (stream->pos < stream->fill && (finish || stream->fill - stream->pos >= GZIP_MAX_MATCH)) {
+        size_t max_len = stream->fill - stream->pos;
+        uint16_t len = 0;
+        uint16_t distance = 0;
+
+        if (max_len > GZIP_MAX_MATCH) {
+            max_len = GZIP_MAX_MATCH;
+        }
+        if (max_len >= GZIP_MIN_MATCH) {
+            len = gzip_longest_match(stream, stream->pos, max_len, &distance);
+            gzip_insert(stream, stream->pos);
+        }
+        if (len >= GZIP_MIN_MATCH) {
+            gzip_put_match(stream, len, distance);
+            for (size_t i = 1; i < len && stream->pos + i + GZIP_MIN_MATCH <= stream->fill; i++) {
+                gzip_insert(stream, stream->pos + i);
+            }
+            stream->pos += len;
+        } else {
+            gzip_put_symbol(stream, stream->window[stream->pos]);
+            stream->pos++;
+        }
+    }
+}
+
+static void gzip_slide(gzip_stream_t *stream)
+{
+    size_t size = stream->window_size;
+
+    memmove(stream->window, stream->window + size, stream->fill - size);
+    stream->fill -= size;
+    stream->pos -= size;
+    for (size_t i = 0; i < GZIP_HASH_SIZE; i++) {
+        stream->head[i] = stream->head[i] > size ? stream->head[i] - size : 0;
+    }
+    for (size_t i = 0; i < size; i++) {
+        stream->prev[i] = stream->prev[i] > size ? stream->prev[i] - size : 0;
+    }
+}
+
+gzip_stream_t *gzip_stream_create(uint8_t window_bits, size_t output_size, gzip_stream_output_t output,
+                                  void *context)
+{
+    ESP_RETURN_ON_FALSE(window_bits >= GZIP_MIN_WINDOW_BITS && window_bits <= GZIP_MAX_WINDOW_BITS && output_size &&
+                            output,
+                        NULL, GZIP_TAG, "Invalid gzip stream arguments");
+    gzip_stream_t *stream = (gzip_stream_t *)calloc(1, sizeof(gzip_stream_t));
+    ESP_RETURN_ON_FALSE(stream, NULL, GZIP_TAG, "Failed to allocate gzip stream");
+
+    stream->window_size = (size_t)1 << window_bits;
+    stream->window = (uint8_t *)malloc(stream->window_size * 2);
+    stream->prev = (uint16_t *)calloc(stream->window_size, sizeof(uint16_t));
+    stream->out = (uint8_t *)malloc(output_size);
+    if (!stream->window || !stream->prev || !stream->out) {
+        ESP_LOGE(GZIP_TAG, "Failed to allocate gzip window");
+        gzip_stream_destroy(stream);
+        return NULL;
+    }
+    stream->out_size = output_size;
+    stream->output = output;
+    stream->context = context;
+
+    /* The gzip header without the file name nor the time, and the header of the single final fixed Huffman block */
+    static const uint8_t kHeader[] = {0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff};
+    for (size_t i = 0; i < sizeof(kHeader); i++) {
+        gzip_put_byte(stream, kHeader[i]);
+    }
+    gzip_put_bits(stream, 1, 1);
+    gzip_put_bits(stream, 1, 2);
+    return stream;
+}
+
+esp_err_t gzip_stream_write(gzip_stream_t *stream, const void *data, size_t len)
+{
+    const uint8_t *input = (const uint8_t *)data;
+
+    stream->crc = gzip_crc32(stream->crc, input, len);
+    stream->in_len += len;
+    while (len && stream->err == ESP_OK) {
+        size_t count = stream->window_size * 2 - stream->fill;
+        if (count > len) {
+            count = len;
+        }
+        memcpy(stream->window + stream->fill, input, count);
+        stream->fill += count;
+        input += count;
+        len -= count;
+        if (stream->fill == stream->window_size * 2) {
+            gzip_compress(stream, false);
+            gzip_slide(stream);
+        }
+    }
+    return stream->err;
+}
+
+esp_err_t gzip_stream_finish(gzip_stream_t *stream)
+{
+    gzip_compress(stream, true);
+    gzip_put_symbol(stream, GZIP_END_OF_BLOCK);
+    if (stream->bit_count) {
+        gzip_put_bits(stream, 0, 8 - stream->bit_count);
+    }
+    for (int shift = 0; shift < 32; shift += 8) {
+        gzip_put_byte(stream, (uint8_t)(stream->crc >> shift));
+    }
+    for (int shift = 0; shift < 32; shift += 8) {
+        gzip_put_byte(stream, (uint8_t)(stream->in_len >> shift));
+    }
+    gzip_flush_output(stream);
+    return stream->err;
+}
+
+void gzip_stream_get_size(const gzip_stream_t *stream, size_t *in_len, size_t *out_len)
+{
+    *in_len = stream->in_len;
+    *out_len = stream->out_len;
+}
+
+void gzip_stream_destroy(gzip_stream_t *stream)
+{
+    if (stream) {
+        free(stream->window);
+        free(stream->prev);
+        free(stream->out);
+        free(stream);
+    }
+}
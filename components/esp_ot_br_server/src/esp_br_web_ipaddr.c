@@ -0,0 +1,372 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_br_web_ipaddr.h"
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "esp_check.h"
+#include "esp_log.h"
+#include "esp_openthread.h"
+#include "esp_openthread_lock.h"
+#include "esp_random.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "openthread/ip6.h"
+
+#define IPADDR_TAG "web_ipaddr"
+
+#define IPADDR_BATCH_MAX_OPERATIONS 64
+#define IPADDR_SCRATCH_SUBNET 0xffff
+#define IPADDR_SCRATCH_ATTEMPTS 3
+#define IPADDR_SCRATCH_PREFIX_SIZE sizeof("fdxx:xxxx:xxxx:xxxx::")
+
+/*----------------------------------------------------------------------
+                       IPv6 Address Management
+-----------------------------------------------------------------------*/
+cJSON *handle_openthread_ipaddr_list_request(void)
+{
+    cJSON *arr = cJSON_CreateArray();
+    char addr_str[OT_IP6_ADDRESS_STRING_SIZE];
+
+    esp_openthread_lock_acquire(portMAX_DELAY);
+    const otNetifAddress *addr = otIp6GetUnicastAddresses(esp_openthread_get_instance());
+    while (addr) {
+        cJSON *entry = cJSON_CreateObject();
+        otIp6AddressToString(&addr->mAddress, addr_str, sizeof(addr_str));
+        cJSON_AddStringToObject(entry, "address", addr_str);
+        cJSON_AddNumberToObject(entry, "prefixLength", addr->mPrefixLength);
+        const char *origin;
+        switch (addr->mAddressOrigin) {
+        case OT_ADDRESS_ORIGIN_THREAD:
+            origin = "thread";
+            break;
+        case OT_ADDRESS_ORIGIN_SLAAC:
+            origin = "slaac";
+            break;
+        case OT_ADDRESS_ORIGIN_DHCPV6:
+            origin = "dhcpv6";
+            break;
+        case OT_ADDRESS_ORIGIN_MANUAL:
+            origin = "manual";
+            break;
+        default:
+            origin = "unknown";
+            break;
+        }
+        cJSON_AddStringToObject(entry, "origin", origin);
+        cJSON_AddBoolToObject(entry, "preferred", addr->mPreferred);
+        cJSON_AddBoolToObject(entry, "meshLocal", addr->mMeshLocal);
+        cJSON_AddBoolToObject(entry, "rloc", addr->mRloc);
+        cJSON_AddItemToArray(arr, entry);
+        addr = addr->mNext;
+    }
+    esp_openthread_lock_release();
+    return arr;
+}
+
+static cJSON *ipaddr_add(const cJSON *request, bool log)
+{
+    cJSON *result = cJSON_CreateObject();
+    if (!request) {
+        ESP_LOGE(IPADDR_TAG, "Invalid ipaddr add request");
+        cJSON_AddStringToObject(result, "status", "error");
+        cJSON_AddStringToObject(result, "message", "Invalid request");
+        return result;
+    }
+
+    const cJSON *addr_json = cJSON_GetObjectItem(request, "address");
+    if (!addr_json || !addr_json->valuestring) {
+        ESP_LOGE(IPADDR_TAG, "Missing address field");
+        cJSON_AddStringToObject(result, "status", "error");
+        cJSON_AddStringToObject(result, "message", "Missing address field");
+        return result;
+    }
+
+    otNetifAddress netif_addr;
+    memset(&netif_addr, 0, sizeof(netif_addr));
+
+    esp_openthread_lock_acquire(portMAX_DELAY);
+    otError err = otIp6AddressFromString(addr_json->valuestring, &netif_addr.mAddress);
+    if (err == OT_ERROR_NONE) {
+        netif_addr.mPrefixLength = 64;
+        netif_addr.mPreferred = true;
+        netif_addr.mValid = true;
+        netif_addr.mAddressOrigin = OT_ADDRESS_ORIGIN_MANUAL;
+        err = otIp6AddUnicastAddress(esp_openthread_get_instance(), &netif_addr);
+    }
+    esp_openthread_lock_release();
+
+    if (err == OT_ERROR_NONE) {
+        cJSON_AddStringToObject(result, "status", "ok");
+        if (log) {
+            ESP_LOGI(IPADDR_TAG, "Added IPv6 address: %s", addr_json->valuestring);
+        }
+    } else {
+        cJSON_AddStringToObject(result, "status", "error");
+        cJSON_AddStringToObject(result, "message", otThreadErrorToString(err));
+        ESP_LOGE(IPADDR_TAG, "Failed to add IPv6 address: %s (err=%d)", addr_json->valuestring, err);
+    }
+    return result;
+}
+
+static cJSON *ipaddr_delete(const cJSON *request, bool log)
+{
+    cJSON *result = cJSON_CreateObject();
+    if (!request) {
+        ESP_LOGE(IPADDR_TAG, "Invalid ipaddr delete request");
+        cJSON_AddStringToObject(result, "status", "error");
+        cJSON_AddStringToObject(result, "message", "Invalid request");
+        return result;
+    }
+
+    const cJSON *addr_json = cJSON_GetObjectItem(request, "address");
+    if (!addr_json || !addr_json->valuestring) {
+        ESP_LOGE(IPADDR_TAG, "Missing address field");
+        cJSON_AddStringToObject(result, "status", "error");
+        cJSON_AddStringToObject(result, "message", "Missing address field");
+        return result;
+    }
+
+    otIp6Address addr;
+
+    esp_openthread_lock_acquire(portMAX_DELAY);
+    otError err = otIp6AddressFromString(addr_json->valuestring, &addr);
+    if (err == OT_ERROR_NONE) {
+        err = otIp6RemoveUnicastAddress(esp_openthread_get_instance(), &addr);
+    }
+    esp_openthread_lock_release();
+
+    if (err == OT_ERROR_NONE) {
+        cJSON_AddStringToObject(result, "status", "ok");
+        if (log) {
+            ESP_LOGI(IPADDR_TAG, "Removed IPv6 address: %s", addr_json->valuestring);
+        }
+    } else {
+        cJSON_AddStringToObject(result, "status", "error");
+        cJSON_AddStringToObject(result, "message", otThreadErrorToString(err));
+        ESP_LOGE(IPADDR_TAG, "Failed to remove IPv6 address: %s (err=%d)", addr_json->valuestring, err);
+    }
+    return result;
+}
+
+cJSON *handle_openthread_add_ipaddr_request(const cJSON *request)
+{
+    return ipaddr_add(request, true);
+}
+
+cJSON *handle_openthread_delete_ipaddr_request(const cJSON *request)
+{
+    return ipaddr_delete(request, true);
+}
+
+typedef struct {
+    bool add;
+    otNetifAddress netif_addr;
+    otError error;
+} ipaddr_op_t;
+
+static otError ipaddr_init_op(ipaddr_op_t *op, bool add, const char *address, uint8_t prefix_length)
+{
+    op->add = add;
+    op->netif_addr.mPrefixLength = prefix_length;
+    op->netif_addr.mPreferred = true;
+    op->netif_addr.mValid = true;
+    op->netif_addr.mAddressOrigin = OT_ADDRESS_ORIGIN_MANUAL;
+    return otIp6AddressFromString(address, &op->netif_addr.mAddress);
+}
+
+static otError ipaddr_parse_op(const cJSON *item, ipaddr_op_t *op)
+{
+    const char *action = cJSON_GetStringValue(cJSON_GetObjectItemCaseSensitive(item, "op"));
+    const char *address = cJSON_GetStringValue(cJSON_GetObjectItemCaseSensitive(item, "address"));
+    const cJSON *prefix_length = cJSON_GetObjectItemCaseSensitive(item, "prefixLength");
+
+    memset(op, 0, sizeof(*op));
+    if (!action || !address || (strcmp(action, "add") != 0 && strcmp(action, "remove") != 0)) {
+        return OT_ERROR_INVALID_ARGS;
+    }
+    if (prefix_length && (!cJSON_IsNumber(prefix_length) || prefix_length->valuedouble < 1.0 ||
+                          prefix_length->valuedouble > OT_IP6_ADDRESS_BITSIZE)) {
+        return OT_ERROR_INVALID_ARGS;
+    }
+    return ipaddr_init_op(op, strcmp(action, "add") == 0, address,
+                          prefix_length ? (uint8_t)prefix_length->valuedouble : 64);
+}
+
+/* Must be called with the OpenThread lock held. */
+static int ipaddr_apply_ops(ipaddr_op_t *ops, int count)
+{
+    otInstance *ins = esp_openthread_get_instance();
+    int applied = 0;
+
+    for (int i = 0; i < count; i++) {
+        if (ops[i].add) {
+            ops[i].error = otIp6AddUnicastAddress(ins, &ops[i].netif_addr);
+        } else {
+            ops[i].error = otIp6RemoveUnicastAddress(ins, &ops[i].netif_addr.mAddress);
+        }
+        applied += ops[i].error == OT_ERROR_NONE ? 1 : 0;
+    }
+    return applied;
+}
+
+/* Pick a random ULA /64 none of whose first @param count addresses is on the Thread interface. */
+static bool ipaddr_scratch_prefix(char *prefix, size_t size, int count)
+{
+    otInstance *ins = esp_openthread_get_instance();
+    otIp6Address address;
+    char scratch[OT_IP6_ADDRESS_STRING_SIZE];
+
+    for (int attempt = 0; attempt < IPADDR_SCRATCH_ATTEMPTS; attempt++) {
+        uint32_t high = esp_random();
+        uint32_t low = esp_random();
+        bool in_use = false;
+
+        /* fdXX:XXXX:XXXX::/48 with a random global ID, as RFC 4193 asks, and the last subnet of it. */
+        snprintf(prefix, size, "fd%02x:%04x:%04x:%04x::", (unsigned)(high & 0xff), (unsigned)(high >> 16),
+                 (unsigned)(low & 0xffff), IPADDR_SCRATCH_SUBNET);
+        esp_openthread_lock_acquire(portMAX_DELAY);
+        for (int i = 0; i < count && !in_use; i++) {
+            snprintf(scratch, sizeof(scratch), "%s%x", prefix, i + 1);
+            in_use = otIp6AddressFromString(scratch, &address) != OT_ERROR_NONE ||
+                     otIp6HasUnicastAddress(ins, &address);
+        }
+        esp_openthread_lock_release();
+        if (!in_use) {
+            return true;
+        }
+    }
+    return false;
+}
+
+cJSON *openthread_ipaddr_batch_benchmark(int count, otError *error)
+{
+    char prefix[IPADDR_SCRATCH_PREFIX_SIZE];
+    char address[OT_IP6_ADDRESS_STRING_SIZE];
+    cJSON *bench = NULL;
+    cJSON *requests = NULL;
+    ipaddr_op_t *ops = NULL;
+    int single_failed = 0;
+    int batch_applied = 0;
+
+    *error = OT_ERROR_INVALID_ARGS;
+    ESP_RETURN_ON_FALSE(count > 0 && count <= IPADDR_BATCH_MAX_OPERATIONS / 2, NULL, IPADDR_TAG,
+                        "Invalid ipaddr benchmark count");
+    *error = OT_ERROR_NO_BUFS;
+    if (!ipaddr_scratch_prefix(prefix, sizeof(prefix), count)) {
+        ESP_LOGE(IPADDR_TAG, "No free scratch prefix for the ipaddr benchmark");
+        *error = OT_ERROR_ALREADY;
+        return NULL;
+    }
+    ops = calloc(2 * count, sizeof(ipaddr_op_t));
+    requests = cJSON_CreateArray();
+    if (!ops || !requests) {
+        ESP_LOGE(IPADDR_TAG, "Failed to allocate the ipaddr benchmark");
+        goto exit;
+    }
+    for (int i = 0; i < count; i++) {
+        cJSON *request = cJSON_CreateObject();
+        snprintf(address, sizeof(address), "%s%x", prefix, i + 1);
+        cJSON_AddStringToObject(request, "address", address);
+        cJSON_AddItemToArray(requests, request);
+        ipaddr_init_op(&ops[2 * i], true, address, 64);
+        ipaddr_init_op(&ops[2 * i + 1], false, address, 64);
+    }
+
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < count; i++) {
+        const cJSON *request = cJSON_GetArrayItem(requests, i);
+        cJSON *results[] = {ipaddr_add(request, false), ipaddr_delete(request, false)};
+        for (int j = 0; j < 2; j++) {
+            single_failed += strcmp(cJSON_GetStringValue(cJSON_GetObjectItem(results[j], "status")), "ok") != 0;
+            cJSON_Delete(results[j]);
+        }
+    }
+    int64_t single_us = esp_timer_get_time() - start;
+
+    start = esp_timer_get_time();
+    esp_openthread_lock_acquire(portMAX_DELAY);
+    batch_applied = ipaddr_apply_ops(ops, 2 * count);
+    esp_openthread_lock_release();
+    int64_t batch_us = esp_timer_get_time() - start;
+
+    bench = cJSON_CreateObject();
+    cJSON_AddStringToObject(bench, "prefix", prefix);
+    cJSON_AddNumberToObject(bench, "operations", 2 * count);
+    cJSON_AddNumberToObject(bench, "singleUs", (double)single_us);
+    cJSON_AddNumberToObject(bench, "batchUs", (double)batch_us);
+    cJSON_AddNumberToObject(bench, "singleOpsPerSec", single_us > 0 ? 2.0 * count * 1000000 / single_us : 0);
+    cJSON_AddNumberToObject(bench, "batchOpsPerSec", batch_us > 0 ? 2.0 * count * 1000000 / batch_us : 0);
+    cJSON_AddNumberToObject(bench, "failed", single_failed + 2 * count - batch_applied);
+    ESP_LOGI(IPADDR_TAG, "ipaddr benchmark of %d operations on %s/64: single %" PRId64 " us, batch %" PRId64 " us",
+             2 * count, prefix, single_us, batch_us);
+    *error = single_failed || batch_applied != 2 * count ? OT_ERROR_FAILED : OT_ERROR_NONE;
+
+exit:
+    /* Whatever failed above, no scratch address is left on the interface. */
+    if (ops) {
+        esp_openthread_lock_acquire(portMAX_DELAY);
+        for (int i = 0; i < count; i++) {
+            otIp6RemoveUnicastAddress(esp_openthread_get_instance(), &ops[2 * i].netif_addr.mAddress);
+        }
+        esp_openthread_lock_release();
+    }
+    cJSON_Delete(requests);
+    free(ops);
+    return bench;
+}
+
+cJSON *handle_openthread_batch_ipaddr_request(const cJSON *request, otError *error)
+{
+    cJSON *result = NULL;
+    cJSON *status = NULL;
+    ipaddr_op_t *ops = NULL;
+    int count = 0;
+    int applied = 0;
+    bool valid = true;
+    const cJSON *operations = cJSON_GetObjectItemCaseSensitive(request, "operations");
+
+    *error = OT_ERROR_INVALID_ARGS;
+    if (!cJSON_IsArray(operations) || (count = cJSON_GetArraySize(operations)) == 0 ||
+        count > IPADDR_BATCH_MAX_OPERATIONS) {
+        ESP_LOGE(IPADDR_TAG, "Invalid ipaddr batch request");
+        return NULL;
+    }
+    ops = calloc(count, sizeof(ipaddr_op_t));
+    if (ops == NULL) {
+        *error = OT_ERROR_NO_BUFS;
+        return NULL;
+    }
+
+    /* Validate all the entries up front, nothing is applied if any of them is invalid. */
+    for (int i = 0; i < count; i++) {
+        ops[i].error = ipaddr_parse_op(cJSON_GetArrayItem(operations, i), &ops[i]);
+        valid = valid && ops[i].error == OT_ERROR_NONE;
+    }
+
+    result = cJSON_CreateObject();
+    if (valid) {
+        esp_openthread_lock_acquire(portMAX_DELAY);
+        applied = ipaddr_apply_ops(ops, count);
+        esp_openthread_lock_release();
+    }
+
+    status = cJSON_AddArrayToObject(result, "status");
+    for (int i = 0; i < count; i++) {
+        const char *str = ops[i].error == OT_ERROR_NONE ? "ok" : otThreadErrorToString(ops[i].error);
+        cJSON_AddItemToArray(status, cJSON_CreateString(valid || ops[i].error != OT_ERROR_NONE ? str : "skipped"));
+    }
+    cJSON_AddNumberToObject(result, "applied", applied);
+    cJSON_AddNumberToObject(result, "failed", valid ? count - applied : count);
+    ESP_LOGI(IPADDR_TAG, "Batch of %d IPv6 address operations, %d applied", count, applied);
+
+    *error = !valid ? OT_ERROR_INVALID_ARGS : (applied == count ? OT_ERROR_NONE : OT_ERROR_FAILED);
+    free(ops);
+    return result;
+}
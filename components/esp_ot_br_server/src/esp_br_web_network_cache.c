@@ -0,0 +1,140 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_br_web_network_cache.h"
+#include <string.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+#define NETWORK_CACHE_TAG "web_net_cache"
+
+typedef struct available_network_entry {
+    thread_network_information_t network;
+    uint32_t seq; /* the value of s_available_network_seq at the last update */
+} available_network_entry_t;
+
+static SemaphoreHandle_t s_available_network_mutex;
+static available_network_entry_t s_available_networks[AVAILABLE_NETWORK_CACHE_SIZE];
+static uint32_t s_available_network_seq = 0;
+static uint16_t s_available_network_next_id = 0;
+
+void available_network_cache_init(void)
+{
+    s_available_network_mutex = xSemaphoreCreateMutex();
+}
+
+static uint32_t available_network_now(void)
+{
+    return (uint32_t)(esp_timer_get_time() / 1000000);
+}
+
+void available_network_cache_update(const otActiveScanResult *result)
+{
+    available_network_entry_t *entry = NULL;
+    uint32_t now = available_network_now();
+
+    xSemaphoreTake(s_available_network_mutex, portMAX_DELAY);
+    for (int i = 0; i < AVAILABLE_NETWORK_CACHE_SIZE; i++) {
+        available_network_entry_t *candidate = &s_available_networks[i];
+        if (candidate->network.id && candidate->network.channel == result->mChannel &&
+            !memcmp(&candidate->network.extended_panid, &result->mExtendedPanId, sizeof(otExtendedPanId))) {
+            entry = candidate;
+            break;
+        }
+        /* Take a free entry, or else the least recently seen one. */
+        if (!entry || (entry->network.id && (!candidate->network.id ||
+                                             candidate->network.last_seen < entry->network.last_seen))) {
+            entry = candidate;
+        }
+    }
+    if (!entry->network.id || entry->network.channel != result->mChannel ||
+        memcmp(&entry->network.extended_panid, &result->mExtendedPanId, sizeof(otExtendedPanId))) {
+        memset(entry, 0, sizeof(available_network_entry_t));
+        if (++s_available_network_next_id == 0) {
+            s_available_network_next_id = 1;
+        }
+        entry->network.id = s_available_network_next_id;
+        entry->network.extended_panid = result->mExtendedPanId;
+        entry->network.channel = result->mChannel;
+        entry->network.rssi = result->mRssi;
+        entry->network.lqi = result->mLqi;
+        entry->network.extended_address = result->mExtAddress;
+    }
+    if (result->mRssi >= entry->network.rssi) {
+        entry->network.rssi = result->mRssi;
+        entry->network.extended_address = result->mExtAddress;
+    }
+    if (result->mLqi > entry->network.lqi) {
+        entry->network.lqi = result->mLqi;
+    }
+    entry->network.network_name = result->mNetworkName;
+    entry->network.panid = result->mPanId;
+    entry->network.last_seen = now;
+    entry->seq = ++s_available_network_seq;
+    xSemaphoreGive(s_available_network_mutex);
+
+    ESP_LOGD(NETWORK_CACHE_TAG, "Found network %s, id %u, channel %u, rssi %d", result->mNetworkName.m8,
+             entry->network.id, result->mChannel, result->mRssi);
+}
+
+uint32_t available_network_cache_seq(void)
+{
+    uint32_t seq = 0;
+
+    xSemaphoreTake(s_available_network_mutex, portMAX_DELAY);
+    seq = s_available_network_seq;
+    xSemaphoreGive(s_available_network_mutex);
+    return seq;
+}
+
+bool available_network_cache_next(uint32_t seq, thread_network_information_t *network, uint32_t *next_seq)
+{
+    const available_network_entry_t *next = NULL;
+    uint32_t now = available_network_now();
+
+    xSemaphoreTake(s_available_network_mutex, portMAX_DELAY);
+    for (int i = 0; i < AVAILABLE_NETWORK_CACHE_SIZE; i++) {
+        const available_network_entry_t *entry = &s_available_networks[i];
+        if (entry->network.id && entry->seq > seq && now - entry->network.last_seen <= AVAILABLE_NETWORK_MAX_AGE_S &&
+            (!next || entry->seq < next->seq)) {
+            next = entry;
+        }
+    }
+    if (next) {
+        *network = next->network;
+        *next_seq = next->seq;
+    }
+    xSemaphoreGive(s_available_network_mutex);
+    return next != NULL;
+}
+
+bool available_network_cache_find(const thread_network_join_param_t *param, thread_network_information_t *network)
+{
+    const available_network_entry_t *found = NULL;
+    uint32_t now = available_network_now();
+
+    xSemaphoreTake(s_available_network_mutex, portMAX_DELAY);
+    for (int i = 0; i < AVAILABLE_NETWORK_CACHE_SIZE; i++) {
+        const available_network_entry_t *entry = &s_available_networks[i];
+        if (!entry->network.id || now - entry->network.last_seen > AVAILABLE_NETWORK_MAX_AGE_S) {
+            continue;
+        }
+        if (param->has_extended_panid
+                ? !memcmp(&entry->network.extended_panid, &param->extended_panid, sizeof(otExtendedPanId)) &&
+                    (!param->channel || entry->network.channel == param->channel) &&
+                    (!found || entry->network.last_seen > found->network.last_seen)
+                : entry->network.id == param->index) {
+            found = entry;
+        }
+    }
+    if (found) {
+        *network = found->network;
+    }
+    xSemaphoreGive(s_available_network_mutex);
+    return found != NULL;
+}
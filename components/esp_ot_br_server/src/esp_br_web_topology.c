@@ -0,0 +1,367 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_br_web_topology.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "esp_check.h"
+#include "esp_log.h"
+
+#define TOPOLOGY_TAG "web_topology"
+
+/*----------------------------------------------------------------------
+                       Build the Compact Topology
+-----------------------------------------------------------------------*/
+static const otNetworkDiagTlv *topology_tlv_find(const thread_diagnosticTlv_list_t *list, uint8_t type)
+{
+    for (; list && list->diagTlv; list = list->next) {
+        if (list->diagTlv->mType == type) {
+            return list->diagTlv;
+        }
+    }
+    return NULL;
+}
+
+static bool topology_router_rloc16(const thread_diagnosticTlv_set_t *router, uint16_t *rloc16)
+{
+    const otNetworkDiagTlv *tlv = topology_tlv_find(router->diagTlv_next, OT_NETWORK_DIAGNOSTIC_TLV_SHORT_ADDRESS);
+    if (tlv == NULL) {
+        return false;
+    }
+    *rloc16 = tlv->mData.mAddr16;
+    return true;
+}
+
+static bool topology_route_is_link(const otNetworkDiagRouteData *route, uint16_t rloc16)
+{
+    /* The route entry of the router itself and the ones of the routers out of range have no link quality. */
+    return route->mRouterId != (rloc16 >> 10) && (route->mLinkQualityIn || route->mLinkQualityOut);
+}
+
+static int topology_node_compare(const void *a, const void *b)
+{
+    return (int)((const thread_topology_node_t *)a)->rloc16 - (int)((const thread_topology_node_t *)b)->rloc16;
+}
+
+static int topology_link_compare(const void *a, const void *b)
+{
+    const thread_topology_link_t *x = (const thread_topology_link_t *)a;
+    const thread_topology_link_t *y = (const thread_topology_link_t *)b;
+    return x->from != y->from ? (int)x->from - (int)y->from : (int)x->to - (int)y->to;
+}
+
+esp_err_t thread_topology_snapshot_build(const thread_diagnosticTlv_set_t *set, thread_topology_snapshot_t *snapshot)
+{
+    ESP_RETURN_ON_FALSE(set && snapshot, ESP_ERR_INVALID_ARG, TOPOLOGY_TAG, "Invalid topology snapshot");
+    const otNetworkDiagTlv *tlv = NULL;
+    size_t node_count = 0;
+    size_t link_count = 0;
+    uint16_t rloc16 = 0;
+
+    memset(snapshot, 0, sizeof(thread_topology_snapshot_t));
+    /* Count first, so that the snapshot is allocated once with the exact size. */
+    for (const thread_diagnosticTlv_set_t *router = set->next; router; router = router->next) {
+        if (!topology_router_rloc16(router, &rloc16)) {
+            continue;
+        }
+        node_count++;
+        tlv = topology_tlv_find(router->diagTlv_next, OT_NETWORK_DIAGNOSTIC_TLV_CHILD_TABLE);
+        if (tlv) {
+            node_count += tlv->mData.mChildTable.mCount;
+            link_count += tlv->mData.mChildTable.mCount;
+        }
+        tlv = topology_tlv_find(router->diagTlv_next, OT_NETWORK_DIAGNOSTIC_TLV_ROUTE);
+        for (uint8_t i = 0; tlv && i < tlv->mData.mRoute.mRouteCount; i++) {
+            link_count += topology_route_is_link(&tlv->mData.mRoute.mRouteData[i], rloc16);
+        }
+    }
+    ESP_RETURN_ON_FALSE(node_count <= UINT16_MAX && link_count <= UINT16_MAX, ESP_ERR_INVALID_SIZE, TOPOLOGY_TAG,
+                        "Too many topology nodes");
+    if (node_count) {
+        snapshot->nodes = (thread_topology_node_t *)calloc(node_count, sizeof(thread_topology_node_t));
+        ESP_RETURN_ON_FALSE(snapshot->nodes, ESP_ERR_NO_MEM, TOPOLOGY_TAG, "Failed to allocate topology nodes");
+    }
+    if (link_count) {
+        snapshot->links = (thread_topology_link_t *)calloc(link_count, sizeof(thread_topology_link_t));
+        if (snapshot->links == NULL) {
+            thread_topology_snapshot_free(snapshot);
+            ESP_LOGE(TOPOLOGY_TAG, "Failed to allocate topology links");
+            return ESP_ERR_NO_MEM;
+        }
+    }
+
+    for (const thread_diagnosticTlv_set_t *router = set->next; router; router = router->next) {
+        if (!topology_router_rloc16(router, &rloc16)) {
+            continue;
+        }
+        thread_topology_node_t *node = &snapshot->nodes[snapshot->node_count++];
+        node->rloc16 = rloc16;
+        node->parent = THREAD_TOPOLOGY_NO_PARENT;
+        if ((tlv = topology_tlv_find(router->diagTlv_next, OT_NETWORK_DIAGNOSTIC_TLV_EXT_ADDRESS))) {
+            node->ext_address = tlv->mData.mExtAddress;
+        }
+        if ((tlv = topology_tlv_find(router->diagTlv_next, OT_NETWORK_DIAGNOSTIC_TLV_MODE))) {
+            node->mode = tlv->mData.mMode;
+        }
+        tlv = topology_tlv_find(router->diagTlv_next, OT_NETWORK_DIAGNOSTIC_TLV_LEADER_DATA);
+        node->leader = tlv && tlv->mData.mLeaderData.mLeaderRouterId == (rloc16 >> 10);
+
+        tlv = topology_tlv_find(router->diagTlv_next, OT_NETWORK_DIAGNOSTIC_TLV_ROUTE);
+        for (uint8_t i = 0; tlv && i < tlv->mData.mRoute.mRouteCount; i++) {
+            const otNetworkDiagRouteData *route = &tlv->mData.mRoute.mRouteData[i];
+            if (!topology_route_is_link(route, rloc16)) {
+                continue;
+            }
+            thread_topology_link_t *link = &snapshot->links[snapshot->link_count++];
+            link->from = rloc16;
+            link->to = (uint16_t)route->mRouterId << 10;
+            link->link_quality_in = route->mLinkQualityIn;
+            link->link_quality_out = route->mLinkQualityOut;
+        }
+
+        tlv = topology_tlv_find(router->diagTlv_next, OT_NETWORK_DIAGNOSTIC_TLV_CHILD_TABLE);
+        for (uint16_t i = 0; tlv && i < tlv->mData.mChildTable.mCount; i++) {
+            const otNetworkDiagChildEntry *entry = &tlv->mData.mChildTable.mTable[i];
+            thread_topology_node_t *child = &snapshot->nodes[snapshot->node_count++];
+            child->rloc16 = (rloc16 & 0xfc00) | entry->mChildId;
+            child->parent = rloc16;
+            child->mode = entry->mMode;
+            thread_topology_link_t *link = &snapshot->links[snapshot->link_count++];
+            link->from = rloc16;
+            link->to = child->rloc16;
+            link->link_quality_in = entry->mLinkQuality;
+        }
+    }
+    if (snapshot->node_count > 1) {
+        qsort(snapshot->nodes, snapshot->node_count, sizeof(thread_topology_node_t), topology_node_compare);
+    }
+    if (snapshot->link_count > 1) {
+        qsort(snapshot->links, snapshot->link_count, sizeof(thread_topology_link_t), topology_link_compare);
+    }
+    return ESP_OK;
+}
+
+void thread_topology_snapshot_free(thread_topology_snapshot_t *snapshot)
+{
+    if (snapshot) {
+        free(snapshot->nodes);
+        free(snapshot->links);
+        memset(snapshot, 0, sizeof(thread_topology_snapshot_t));
+    }
+}
+
+static bool topology_node_equal(const thread_topology_node_t *a, const thread_topology_node_t *b)
+{
+    return a->parent == b->parent && a->leader == b->leader && a->mode.mRxOnWhenIdle == b->mode.mRxOnWhenIdle &&
+        a->mode.mDeviceType == b->mode.mDeviceType && a->mode.mNetworkData == b->mode.mNetworkData &&
+        !memcmp(&a->ext_address, &b->ext_address, sizeof(otExtAddress));
+}
+
+static bool topology_link_equal(const thread_topology_link_t *a, const thread_topology_link_t *b)
+{
+    return a->link_quality_in == b->link_quality_in && a->link_quality_out == b->link_quality_out;
+}
+
+bool thread_topology_snapshot_equal(const thread_topology_snapshot_t *a, const thread_topology_snapshot_t *b)
+{
+    if (a->node_count != b->node_count || a->link_count != b->link_count) {
+        return false;
+    }
+    for (uint16_t i = 0; i < a->node_count; i++) {
+        if (a->nodes[i].rloc16 != b->nodes[i].rloc16 || !topology_node_equal(&a->nodes[i], &b->nodes[i])) {
+            return false;
+        }
+    }
+    for (uint16_t i = 0; i < a->link_count; i++) {
+        if (topology_link_compare(&a->links[i], &b->links[i]) || !topology_link_equal(&a->links[i], &b->links[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*----------------------------------------------------------------------
+                       Versions of the Topology
+-----------------------------------------------------------------------*/
+void thread_topology_history_init(thread_topology_history_t *history, uint32_t epoch)
+{
+    for (uint8_t i = 0; i < THREAD_TOPOLOGY_HISTORY_SIZE; i++) {
+        thread_topology_snapshot_free(&history->snapshots[i]);
+    }
+    history->latest = 0;
+    history->version = epoch;
+}
+
+bool thread_topology_history_record(thread_topology_history_t *history, thread_topology_snapshot_t *snapshot)
+{
+    thread_topology_snapshot_t *latest = &history->snapshots[history->latest];
+    if (latest->version && thread_topology_snapshot_equal(latest, snapshot)) {
+        thread_topology_snapshot_free(snapshot);
+        return false;
+    }
+    /* The deltas from the dropped version fall back to a full topology. */
+    history->latest = (history->latest + 1) % THREAD_TOPOLOGY_HISTORY_SIZE;
+    thread_topology_snapshot_free(&history->snapshots[history->latest]);
+    /* 0 marks an empty slot, it is skipped when the version wraps. */
+    if (++history->version == 0) {
+        history->version = 1;
+    }
+    snapshot->version = history->version;
+    history->snapshots[history->latest] = *snapshot;
+    memset(snapshot, 0, sizeof(thread_topology_snapshot_t));
+    return true;
+}
+
+const thread_topology_snapshot_t *thread_topology_history_latest(const thread_topology_history_t *history)
+{
+    return &history->snapshots[history->latest];
+}
+
+const thread_topology_snapshot_t *thread_topology_history_find(const thread_topology_history_t *history,
+                                                               uint32_t version)
+{
+    for (uint8_t i = 0; version && i < THREAD_TOPOLOGY_HISTORY_SIZE; i++) {
+        if (history->snapshots[i].version == version) {
+            return &history->snapshots[i];
+        }
+    }
+    return NULL;
+}
+
+/*----------------------------------------------------------------------
+                       Topology to JSON
+-----------------------------------------------------------------------*/
+static void topology_add_rloc16(cJSON *object, const char *name, uint16_t rloc16)
+{
+    char format[RLOC_STRING_MAX_SIZE];
+    snprintf(format, sizeof(format), "0x%04x", rloc16);
+    cJSON_AddStringToObject(object, name, format);
+}
+
+static cJSON *topology_node_convert2_json(const thread_topology_node_t *node)
+{
+    cJSON *root = cJSON_CreateObject();
+    cJSON *mode = NULL;
+    char format[OT_EXT_ADDRESS_SIZE * 2 + 1];
+
+    topology_add_rloc16(root, "Rloc16", node->rloc16);
+    if (node->parent == THREAD_TOPOLOGY_NO_PARENT) {
+        if (hex_to_string(node->ext_address.m8, format, OT_EXT_ADDRESS_SIZE) == ESP_OK) {
+            cJSON_AddStringToObject(root, "ExtAddress", format);
+        }
+        cJSON_AddBoolToObject(root, "Leader", node->leader);
+    } else {
+        topology_add_rloc16(root, "Parent", node->parent);
+    }
+    mode = cJSON_AddObjectToObject(root, "Mode");
+    cJSON_AddNumberToObject(mode, "RxOnWhenIdle", node->mode.mRxOnWhenIdle);
+    cJSON_AddNumberToObject(mode, "DeviceType", node->mode.mDeviceType);
+    cJSON_AddNumberToObject(mode, "NetworkData", node->mode.mNetworkData);
+    return root;
+}
+
+static cJSON *topology_link_key_convert2_json(const thread_topology_link_t *link)
+{
+    cJSON *root = cJSON_CreateObject();
+    topology_add_rloc16(root, "From", link->from);
+    topology_add_rloc16(root, "To", link->to);
+    return root;
+}
+
+static cJSON *topology_link_convert2_json(const thread_topology_link_t *link)
+{
+    cJSON *root = topology_link_key_convert2_json(link);
+    cJSON_AddNumberToObject(root, "LinkQualityIn", link->link_quality_in);
+    cJSON_AddNumberToObject(root, "LinkQualityOut", link->link_quality_out);
+    return root;
+}
+
+cJSON *thread_topology_snapshot_convert2_json(const thread_topology_snapshot_t *snapshot)
+{
+    ESP_RETURN_ON_FALSE(snapshot, NULL, TOPOLOGY_TAG, "Invalid topology snapshot");
+    cJSON *root = cJSON_CreateObject();
+    cJSON_AddNumberToObject(root, "Version", snapshot->version);
+    cJSON_AddBoolToObject(root, "Full", true);
+    cJSON *nodes = cJSON_AddArrayToObject(root, "Nodes");
+    cJSON *links = cJSON_AddArrayToObject(root, "Links");
+    for (uint16_t i = 0; i < snapshot->node_count; i++) {
+        cJSON_AddItemToArray(nodes, topology_node_convert2_json(&snapshot->nodes[i]));
+    }
+    for (uint16_t i = 0; i < snapshot->link_count; i++) {
+        cJSON_AddItemToArray(links, topology_link_convert2_json(&snapshot->links[i]));
+    }
+    return root;
+}
+
+static void topology_delta_create(cJSON *root, const char *name, cJSON **added, cJSON **removed, cJSON **changed)
+{
+    cJSON *delta = cJSON_AddObjectToObject(root, name);
+    *added = cJSON_AddArrayToObject(delta, "Added");
+    *removed = cJSON_AddArrayToObject(delta, "Removed");
+    *changed = cJSON_AddArrayToObject(delta, "Changed");
+}
+
+cJSON *thread_topology_delta_convert2_json(const thread_topology_snapshot_t *base,
+                                           const thread_topology_snapshot_t *snapshot)
+{
+    ESP_RETURN_ON_FALSE(base && snapshot, NULL, TOPOLOGY_TAG, "Invalid topology snapshot");
+    cJSON *root = cJSON_CreateObject();
+    cJSON *added = NULL;
+    cJSON *removed = NULL;
+    cJSON *changed = NULL;
+    char format[RLOC_STRING_MAX_SIZE];
+    uint16_t i = 0;
+    uint16_t j = 0;
+
+    cJSON_AddNumberToObject(root, "Version", snapshot->version);
+    cJSON_AddNumberToObject(root, "Since", base->version);
+    cJSON_AddBoolToObject(root, "Full", false);
+
+    /* Both snapshots are sorted, so that a single merge walk finds the differences. */
+    topology_delta_create(root, "Nodes", &added, &removed, &changed);
+    while (i < base->node_count || j < snapshot->node_count) {
+        const thread_topology_node_t *prev = i < base->node_count ? &base->nodes[i] : NULL;
+        const thread_topology_node_t *cur = j < snapshot->node_count ? &snapshot->nodes[j] : NULL;
+        if (cur == NULL || (prev && prev->rloc16 < cur->rloc16)) {
+            snprintf(format, sizeof(format), "0x%04x", prev->rloc16);
+            cJSON_AddItemToArray(removed, cJSON_CreateString(format));
+            i++;
+        } else if (prev == NULL || cur->rloc16 < prev->rloc16) {
+            cJSON_AddItemToArray(added, topology_node_convert2_json(cur));
+            j++;
+        } else {
+            if (!topology_node_equal(prev, cur)) {
+                cJSON_AddItemToArray(changed, topology_node_convert2_json(cur));
+            }
+            i++;
+            j++;
+        }
+    }
+
+    i = 0;
+    j = 0;
+    topology_delta_create(root, "Links", &added, &removed, &changed);
+    while (i < base->link_count || j < snapshot->link_count) {
+        const thread_topology_link_t *prev = i < base->link_count ? &base->links[i] : NULL;
+        const thread_topology_link_t *cur = j < snapshot->link_count ? &snapshot->links[j] : NULL;
+        int order = prev == NULL ? 1 : cur == NULL ? -1 : topology_link_compare(prev, cur);
+        if (order < 0) {
+            cJSON_AddItemToArray(removed, topology_link_key_convert2_json(prev));
+            i++;
+        } else if (order > 0) {
+            cJSON_AddItemToArray(added, topology_link_convert2_json(cur));
+            j++;
+        } else {
+            if (!topology_link_equal(prev, cur)) {
+                cJSON_AddItemToArray(changed, topology_link_convert2_json(cur));
+            }
+            i++;
+            j++;
+        }
+    }
+    return root;
+}
@@ -0,0 +1,41 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* The assertions of the host tests, named after their Unity counterparts. */
+#define TEST_ASSERT_MESSAGE(condition, message)                                                                        \
+    do {                                                                                                               \
+        if (!(condition)) {                                                                                            \
+            fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, message);                                               \
+            exit(1);                                                                                                   \
+        }                                                                                                              \
+    } while (0)
+
+#define TEST_ASSERT(condition) TEST_ASSERT_MESSAGE(condition, #condition)
+#define TEST_ASSERT_TRUE(condition) TEST_ASSERT(condition)
+#define TEST_ASSERT_FALSE(condition) TEST_ASSERT(!(condition))
+#define TEST_ASSERT_NULL(pointer) TEST_ASSERT((pointer) == NULL)
+#define TEST_ASSERT_NOT_NULL(pointer) TEST_ASSERT((pointer) != NULL)
+
+#define TEST_ASSERT_EQUAL(expected, actual)                                                                            \
+    do {                                                                                                               \
+        long long expected_ = (long long)(expected);                                                                   \
+        long long actual_ = (long long)(actual);                                                                       \
+        if (expected_ != actual_) {                                                                                    \
+            fprintf(stderr, "%s:%d: expected %lld, was %lld (%s)\n", __FILE__, __LINE__, expected_, actual_, #actual); \
+            exit(1);                                                                                                   \
+        }                                                                                                              \
+    } while (0)
+
+#define RUN_TEST(test)                                                                                                 \
+    do {                                                                                                               \
+        test();                                                                                                        \
+        printf("%s: PASS\n", #test);                                                                                   \
+    } while (0)
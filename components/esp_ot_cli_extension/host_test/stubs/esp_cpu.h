@@ -0,0 +1,17 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/* The core of the calling thread, 0 unless the thread sets it. */
+extern _Thread_local int stub_core_id;
+
+static inline int esp_cpu_get_core_id(void)
+{
+    return stub_core_id;
+}
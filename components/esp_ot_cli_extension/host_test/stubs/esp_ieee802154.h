@@ -0,0 +1,24 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+/* The coexistence priorities of the 802.15.4 driver, defined by the test standing in for the arbiter. */
+typedef enum {
+    IEEE802154_HIGH = 1,
+    IEEE802154_MIDDLE,
+    IEEE802154_LOW,
+    IEEE802154_IDLE,
+} ieee802154_coex_event_t;
+
+typedef struct {
+    ieee802154_coex_event_t idle;
+    ieee802154_coex_event_t txrx;
+    ieee802154_coex_event_t txrx_at;
+} esp_ieee802154_coex_config_t;
+
+void esp_ieee802154_set_coex_config(esp_ieee802154_coex_config_t config);
+esp_ieee802154_coex_config_t esp_ieee802154_get_coex_config(void);
@@ -0,0 +1,38 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdarg.h>
+#include <stdint.h>
+
+typedef enum {
+    ESP_LOG_NONE,
+    ESP_LOG_ERROR,
+    ESP_LOG_WARN,
+    ESP_LOG_INFO,
+    ESP_LOG_DEBUG,
+    ESP_LOG_VERBOSE,
+} esp_log_level_t;
+
+typedef int (*vprintf_like_t)(const char *, va_list);
+
+/* The lines are written through the vprintf set last, vprintf by default, in the format of esp_log. */
+vprintf_like_t esp_log_set_vprintf(vprintf_like_t func);
+
+uint32_t esp_log_timestamp(void);
+
+void esp_log_write(esp_log_level_t level, const char *tag, const char *format, ...);
+
+#define ESP_LOG_FORMAT(letter, format) #letter " (%lu) %s: " format "\n"
+
+#define ESP_LOGE(tag, format, ...)                                                                                     \
+    esp_log_write(ESP_LOG_ERROR, tag, ESP_LOG_FORMAT(E, format), (unsigned long)esp_log_timestamp(), tag, ##__VA_ARGS__)
+#define ESP_LOGW(tag, format, ...)                                                                                     \
+    esp_log_write(ESP_LOG_WARN, tag, ESP_LOG_FORMAT(W, format), (unsigned long)esp_log_timestamp(), tag, ##__VA_ARGS__)
+#define ESP_LOGI(tag, format, ...)                                                                                     \
+    esp_log_write(ESP_LOG_INFO, tag, ESP_LOG_FORMAT(I, format), (unsigned long)esp_log_timestamp(), tag, ##__VA_ARGS__)
+#define ESP_LOGD(tag, format, ...) ((void)(tag))
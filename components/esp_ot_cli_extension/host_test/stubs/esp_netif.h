@@ -0,0 +1,30 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "esp_event.h"
+#include "esp_netif_ip_addr.h"
+#include "esp_netif_types.h"
+
+int esp_netif_get_all_ip6(esp_netif_t *esp_netif, esp_ip6_addr_t if_ip6[]);
+
+int esp_netif_get_netif_impl_index(esp_netif_t *esp_netif);
+
+/* The Wi-Fi station netif for "WIFI_STA_DEF", NULL for the other keys. */
+esp_netif_t *esp_netif_get_handle_from_ifkey(const char *if_key);
+
+esp_err_t esp_netif_create_ip6_linklocal(esp_netif_t *esp_netif);
+
+/* The address event handlers of the netif, which do nothing in the host tests. */
+void esp_netif_action_add_ip6_address(void *esp_netif, esp_event_base_t base, int32_t event_id, void *data);
+void esp_netif_action_remove_ip6_address(void *esp_netif, esp_event_base_t base, int32_t event_id, void *data);
+void esp_netif_action_join_ip6_multicast_group(void *esp_netif, esp_event_base_t base, int32_t event_id, void *data);
+void esp_netif_action_leave_ip6_multicast_group(void *esp_netif, esp_event_base_t base, int32_t event_id, void *data);
@@ -0,0 +1,31 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "esp_event.h"
+#include "esp_netif_ip_addr.h"
+
+ESP_EVENT_DECLARE_BASE(IP_EVENT);
+
+typedef struct esp_netif_obj esp_netif_t;
+
+typedef enum {
+    IP_EVENT_STA_GOT_IP,
+    IP_EVENT_STA_LOST_IP,
+    IP_EVENT_AP_STAIPASSIGNED,
+    IP_EVENT_GOT_IP6,
+} ip_event_t;
+
+typedef struct {
+    esp_ip6_addr_t ip;
+} esp_netif_ip6_info_t;
+
+typedef struct {
+    esp_netif_t *esp_netif;
+    esp_netif_ip6_info_t ip6_info;
+    int ip_index;
+} ip_event_got_ip6_t;
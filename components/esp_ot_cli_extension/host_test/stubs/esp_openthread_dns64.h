@@ -0,0 +1,13 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "esp_err.h"
+#include "lwip/ip6_addr.h"
+
+/* The IPv4-mapped prefix ::ffff:0:0/96, so the upstream server of the host test is reached over IPv4. */
+esp_err_t esp_openthread_get_nat64_prefix(ip6_addr_t *nat64_prefix);
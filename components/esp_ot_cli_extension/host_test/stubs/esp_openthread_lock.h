@@ -0,0 +1,18 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+
+#include "freertos/FreeRTOS.h"
+
+bool esp_openthread_lock_acquire(TickType_t block_ticks);
+void esp_openthread_lock_release(void);
+
+/* The task switching lock of the CLI, defined by the tests running commands which release it. */
+void esp_openthread_task_switching_lock_release(void);
+bool esp_openthread_task_switching_lock_acquire(TickType_t block_ticks);
@@ -0,0 +1,14 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "esp_netif.h"
+
+/* The Thread netif, whose addresses are set by stub_netif_set_addresses. */
+esp_netif_t *esp_openthread_get_netif(void);
+
+void stub_netif_set_addresses(const esp_ip6_addr_t *addrs, int num);
@@ -0,0 +1,21 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "esp_event.h"
+
+ESP_EVENT_DECLARE_BASE(OPENTHREAD_EVENT);
+
+typedef enum {
+    OPENTHREAD_EVENT_START,
+    OPENTHREAD_EVENT_STOP,
+    OPENTHREAD_EVENT_DETACHED,
+    OPENTHREAD_EVENT_ATTACHED,
+    OPENTHREAD_EVENT_ROLE_CHANGED,
+    OPENTHREAD_EVENT_IF_UP,
+    OPENTHREAD_EVENT_IF_DOWN,
+} esp_openthread_event_t;
@@ -0,0 +1,16 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#define OT_EXT_CLI_TAG "ot_ext_cli"
+
+typedef enum {
+    WIFI_ADDRESS_EVENT_ADD_IP6,
+    WIFI_ADDRESS_EVENT_REMOVE_IP6,
+    WIFI_ADDRESS_EVENT_MULTICAST_GROUP_JOIN,
+    WIFI_ADDRESS_EVENT_MULTICAST_GROUP_LEAVE,
+} esp_wifi_address_event_t;
@@ -0,0 +1,10 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+/* Starts the Wi-Fi station of the protocol examples, defined by the test driving the Wi-Fi driver. */
+void example_wifi_start(void);
@@ -0,0 +1,25 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <netinet/in.h>
+#include <stdint.h>
+#include <string.h>
+
+typedef struct ip6_addr {
+    uint32_t addr[4];
+    uint8_t zone;
+} ip6_addr_t;
+
+#define inet6_addr_to_ip6addr(target_ip6addr, source_in6addr)                                                          \
+    do {                                                                                                               \
+        memcpy((target_ip6addr)->addr, (source_in6addr)->s6_addr, 16);                                                 \
+        (target_ip6addr)->zone = 0;                                                                                    \
+    } while (0)
+#define ip6_addr_isloopback(ip6addr)                                                                                   \
+    ((ip6addr)->addr[0] == 0 && (ip6addr)->addr[1] == 0 && (ip6addr)->addr[2] == 0 && (ip6addr)->addr[3] == htonl(1))
+#define ip6_addr_islinklocal(ip6addr) (((ip6addr)->addr[0] & htonl(0xffc00000UL)) == htonl(0xfe800000UL))
@@ -0,0 +1,33 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "lwip/ip4_addr.h"
+#include "lwip/ip6_addr.h"
+
+#define LWIP_IPV4 1
+#define IPADDR_TYPE_V4 0
+#define IPADDR_TYPE_V6 6
+#define IPADDR_STRLEN_MAX 46
+
+typedef struct ip_addr {
+    union {
+        ip6_addr_t ip6;
+        ip4_addr_t ip4;
+    } u_addr;
+    uint8_t type;
+} ip_addr_t;
+
+#define IP_SET_TYPE_VAL(ipaddr, iptype) ((ipaddr).type = (iptype))
+#define IP_IS_V6(ipaddr) ((ipaddr)->type == IPADDR_TYPE_V6)
+#define ip_2_ip4(ipaddr) (&((ipaddr)->u_addr.ip4))
+#define ip_2_ip6(ipaddr) (&((ipaddr)->u_addr.ip6))
+
+char *ipaddr_ntoa_r(const ip_addr_t *addr, char *buf, int buflen);
+int ipaddr_aton(const char *cp, ip_addr_t *addr);
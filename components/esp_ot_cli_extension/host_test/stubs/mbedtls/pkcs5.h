@@ -0,0 +1,17 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "mbedtls/md.h"
+
+/* Not PBKDF2: a key derived from the password and the salt by FNV-1a, the iterations are not run. */
+int mbedtls_pkcs5_pbkdf2_hmac_ext(mbedtls_md_type_t md_type, const unsigned char *password, size_t plen,
+                                  const unsigned char *salt, size_t slen, unsigned int iteration_count,
+                                  uint32_t key_length, unsigned char *output);
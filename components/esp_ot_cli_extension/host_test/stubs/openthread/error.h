@@ -0,0 +1,20 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+typedef enum otError {
+    OT_ERROR_NONE = 0,
+    OT_ERROR_FAILED = 1,
+    OT_ERROR_NO_BUFS = 3,
+    OT_ERROR_BUSY = 5,
+    OT_ERROR_INVALID_ARGS = 7,
+    OT_ERROR_INVALID_STATE = 13,
+    OT_ERROR_NOT_FOUND = 23,
+    OT_ERROR_NOT_CAPABLE = 27,
+} otError;
+
+const char *otThreadErrorToString(otError error);
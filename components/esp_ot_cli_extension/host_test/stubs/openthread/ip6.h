@@ -0,0 +1,21 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "openthread/error.h"
+
+typedef struct otIp6Address {
+    union {
+        uint8_t m8[16];
+        uint16_t m16[8];
+        uint32_t m32[4];
+    } mFields;
+} otIp6Address;
+
+otError otIp6AddressFromString(const char *string, otIp6Address *address);
@@ -0,0 +1,38 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "openthread/instance.h"
+
+/* The MAC counters read by the sources under test, a subset of those of OpenThread. */
+typedef struct otMacCounters {
+    uint32_t mTxTotal;
+    uint32_t mTxUnicast;
+    uint32_t mTxBroadcast;
+    uint32_t mTxRetry;
+    uint32_t mTxErrCca;
+    uint32_t mTxErrAbort;
+    uint32_t mTxErrBusyChannel;
+    uint32_t mRxTotal;
+    uint32_t mRxUnicast;
+    uint32_t mRxBroadcast;
+    uint32_t mRxAddressFiltered;
+    uint32_t mRxDestAddrFiltered;
+    uint32_t mRxDuplicated;
+    uint32_t mRxErrNoFrame;
+    uint32_t mRxErrUnknownNeighbor;
+    uint32_t mRxErrInvalidSrcAddr;
+    uint32_t mRxErrSec;
+    uint32_t mRxErrFcs;
+    uint32_t mRxErrOther;
+    uint32_t mRxOther;
+} otMacCounters;
+
+/* Defined by the tests which run the sources calling it. */
+const otMacCounters *otLinkGetCounters(otInstance *instance);
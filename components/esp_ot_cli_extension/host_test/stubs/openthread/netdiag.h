@@ -0,0 +1,39 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "openthread/thread.h"
+
+/* The diagnostic TLVs read by the sources under test, with the layout of OpenThread. */
+#define OT_NETWORK_MAX_ROUTER_ID 62
+
+typedef struct otNetworkDiagRouteData {
+    uint8_t mRouterId;
+    uint8_t mLinkQualityOut : 2;
+    uint8_t mLinkQualityIn : 2;
+    uint8_t mRouteCost : 4;
+} otNetworkDiagRouteData;
+
+typedef struct otNetworkDiagRoute {
+    uint8_t mIdSequence;
+    uint8_t mRouteCount;
+    otNetworkDiagRouteData mRouteData[OT_NETWORK_MAX_ROUTER_ID + 1];
+} otNetworkDiagRoute;
+
+typedef struct otNetworkDiagMacCounters {
+    uint32_t mIfInUnknownProtos;
+    uint32_t mIfInErrors;
+    uint32_t mIfOutErrors;
+    uint32_t mIfInUcastPkts;
+    uint32_t mIfInBroadcastPkts;
+    uint32_t mIfInDiscards;
+    uint32_t mIfOutUcastPkts;
+    uint32_t mIfOutBroadcastPkts;
+    uint32_t mIfOutDiscards;
+} otNetworkDiagMacCounters;
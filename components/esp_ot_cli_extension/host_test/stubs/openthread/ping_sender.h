@@ -0,0 +1,52 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "openthread/error.h"
+#include "openthread/instance.h"
+#include "openthread/ip6.h"
+
+typedef struct otPingSenderReply {
+    otIp6Address mSenderAddress;
+    uint16_t mRoundTripTime;
+    uint16_t mSize;
+    uint16_t mSequenceNumber;
+    uint8_t mHopLimit;
+} otPingSenderReply;
+
+typedef struct otPingSenderStatistics {
+    uint16_t mSentCount;
+    uint16_t mReceivedCount;
+    uint32_t mTotalRoundTripTime;
+    uint16_t mMinRoundTripTime;
+    uint16_t mMaxRoundTripTime;
+    bool mIsMulticast;
+} otPingSenderStatistics;
+
+typedef void (*otPingSenderReplyCallback)(const otPingSenderReply *aReply, void *aContext);
+typedef void (*otPingSenderStatisticsCallback)(const otPingSenderStatistics *aStatistics, void *aContext);
+
+typedef struct otPingSenderConfig {
+    otIp6Address mSource;
+    otIp6Address mDestination;
+    otPingSenderReplyCallback mReplyCallback;
+    otPingSenderStatisticsCallback mStatisticsCallback;
+    void *mCallbackContext;
+    uint16_t mSize;
+    uint16_t mCount;
+    uint32_t mInterval;
+    uint16_t mTimeout;
+    uint8_t mHopLimit;
+    bool mAllowZeroHopLimit;
+    bool mMulticastLoop;
+} otPingSenderConfig;
+
+otError otPingSenderPing(otInstance *instance, const otPingSenderConfig *config);
+void otPingSenderStop(otInstance *instance);
@@ -0,0 +1,38 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "openthread/error.h"
+#include "openthread/instance.h"
+
+typedef struct otRadioCoexMetrics {
+    uint32_t mNumGrantGlitch;
+    uint32_t mNumTxRequest;
+    uint32_t mNumTxGrantImmediate;
+    uint32_t mNumTxGrantWait;
+    uint32_t mNumTxGrantWaitActivated;
+    uint32_t mNumTxGrantWaitTimeout;
+    uint32_t mNumTxGrantDeactivatedDuringRequest;
+    uint32_t mNumTxDelayedGrant;
+    uint32_t mAvgTxRequestToGrantTime;
+    uint32_t mNumRxRequest;
+    uint32_t mNumRxGrantImmediate;
+    uint32_t mNumRxGrantWait;
+    uint32_t mNumRxGrantWaitActivated;
+    uint32_t mNumRxGrantWaitTimeout;
+    uint32_t mNumRxGrantDeactivatedDuringRequest;
+    uint32_t mNumRxDelayedGrant;
+    uint32_t mAvgRxRequestToGrantTime;
+    uint32_t mNumRxGrantNone;
+    bool mStopped;
+} otRadioCoexMetrics;
+
+bool otPlatRadioIsCoexEnabled(otInstance *instance);
+otError otPlatRadioGetCoexMetrics(otInstance *instance, otRadioCoexMetrics *coex_metrics);
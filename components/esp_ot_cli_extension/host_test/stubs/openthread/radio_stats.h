@@ -0,0 +1,20 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "openthread/instance.h"
+
+typedef struct otRadioTimeStats {
+    uint64_t mDisabledTime;
+    uint64_t mSleepTime;
+    uint64_t mTxTime;
+    uint64_t mRxTime;
+} otRadioTimeStats;
+
+const otRadioTimeStats *otRadioTimeStatsGet(otInstance *instance);
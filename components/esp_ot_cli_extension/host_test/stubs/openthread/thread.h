@@ -0,0 +1,34 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "openthread/error.h"
+#include "openthread/instance.h"
+
+typedef enum otDeviceRole {
+    OT_DEVICE_ROLE_DISABLED = 0,
+    OT_DEVICE_ROLE_DETACHED = 1,
+    OT_DEVICE_ROLE_CHILD = 2,
+    OT_DEVICE_ROLE_ROUTER = 3,
+    OT_DEVICE_ROLE_LEADER = 4,
+} otDeviceRole;
+
+typedef struct otRouterInfo {
+    uint16_t mRloc16;
+    uint8_t mRouterId;
+    uint8_t mPathCost;
+    uint8_t mLinkQualityIn;
+    uint8_t mLinkQualityOut;
+    bool mLinkEstablished;
+} otRouterInfo;
+
+/* Defined by the tests which run the sources calling them. */
+otDeviceRole otThreadGetDeviceRole(otInstance *instance);
+uint16_t otThreadGetRloc16(otInstance *instance);
@@ -0,0 +1,12 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "openthread/thread.h"
+
+uint8_t otThreadGetMaxRouterId(otInstance *instance);
+otError otThreadGetRouterInfo(otInstance *instance, uint16_t router_id, otRouterInfo *router_info);
@@ -0,0 +1,53 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+/* The options of the sources under test. */
+#define CONFIG_OPENTHREAD_DNS_CACHE 1
+#define CONFIG_OPENTHREAD_DNS_CACHE_ENTRIES 8
+#define CONFIG_OPENTHREAD_DNS_CACHE_MAX_MESSAGE 512
+#define CONFIG_OPENTHREAD_DNS_CACHE_MAX_TTL 3600
+#define CONFIG_OPENTHREAD_DNS_CACHE_NEGATIVE_TTL 300
+#define CONFIG_OPENTHREAD_DNS_CACHE_PREFETCH_HITS 2
+#define CONFIG_OPENTHREAD_DNS_CACHE_PORT 15353
+#define CONFIG_LWIP_IPV6_NUM_ADDRESSES 8
+#define CONFIG_OPENTHREAD_LINK_QUALITY_MAX_LINKS 192
+#define CONFIG_OPENTHREAD_LINK_QUALITY_SAMPLE_INTERVAL 30
+#define CONFIG_OPENTHREAD_BOOT_TIMELINE 1
+#define CONFIG_OPENTHREAD_BOOT_TIMELINE_MAX_PHASES 32
+#define CONFIG_OPENTHREAD_LOG_RINGBUF 1
+#define CONFIG_OPENTHREAD_LOG_RINGBUF_SIZE 8192
+#define CONFIG_OPENTHREAD_LOG_RINGBUF_LINE_MAX 192
+#define CONFIG_OPENTHREAD_LOG_RINGBUF_HISTORY_SIZE 4096
+#define CONFIG_OPENTHREAD_LOG_RINGBUF_TAG_RATE_LIMIT 10000
+#define CONFIG_OPENTHREAD_MAC_COUNTERS_STORE 1
+#define CONFIG_OPENTHREAD_MAC_COUNTERS_MAX_NODES 8
+#define CONFIG_OPENTHREAD_MAC_COUNTERS_HISTORY 4
+#define CONFIG_OPENTHREAD_MAC_COUNTERS_SWEEP_INTERVAL 300
+#define CONFIG_OPENTHREAD_DNS_POOL 1
+#define CONFIG_OPENTHREAD_DNS_POOL_MAX_SERVERS 4
+#define CONFIG_OPENTHREAD_DNS_POOL_PROBE_INTERVAL 3600 /* the probe task of the pool test never wakes up */
+#define CONFIG_OPENTHREAD_DNS_POOL_PROBE_NAME "espressif.com"
+#define CONFIG_OPENTHREAD_DNS_POOL_HYSTERESIS 20
+#define CONFIG_OPENTHREAD_DNS_POOL_HISTORY_SIZE 16
+#define CONFIG_OPENTHREAD_IP_STATS 1
+#define CONFIG_OPENTHREAD_IP_STATS_MCAST_GROUPS 4
+#define CONFIG_OPENTHREAD_CAPTURE 1
+#define CONFIG_OPENTHREAD_CAPTURE_RING_SIZE 4096 /* the smallest, for the overflow and the wraparound */
+#define CONFIG_OPENTHREAD_CLI_WIFI 1
+#define CONFIG_OPENTHREAD_WIFI_DIRECT_ATTEMPTS 2
+#define CONFIG_OPENTHREAD_WIFI_BACKOFF_MIN_MS 250
+#define CONFIG_OPENTHREAD_WIFI_BACKOFF_MAX_MS 2000 /* reached by the retries of the test */
+#define CONFIG_EXAMPLE_WIFI_CONN_MAX_RETRY 6
+#define CONFIG_EXAMPLE_WIFI_SCAN_METHOD_ALL_CHANNEL 1
+#define CONFIG_EXAMPLE_WIFI_CONNECT_AP_BY_SIGNAL 1
+#define CONFIG_EXAMPLE_WIFI_SCAN_RSSI_THRESHOLD -127
+#define CONFIG_EXAMPLE_WIFI_AUTH_OPEN 1
+#define CONFIG_EXAMPLE_CONNECT_IPV4 1
+#define CONFIG_EXAMPLE_CONNECT_IPV6 1
+#define CONFIG_OPENTHREAD_HEAP_DIAG_SCOPE 1
+#define CONFIG_OPENTHREAD_HEAP_DIAG_SCOPE_MAX_NUM 4 /* filled by the test */
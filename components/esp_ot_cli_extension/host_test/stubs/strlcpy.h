@@ -0,0 +1,12 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+/* The newlib of ESP-IDF declares strlcpy in string.h, force included where the host C library does not. */
+size_t strlcpy(char *dst, const char *src, size_t size);
@@ -0,0 +1,522 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <arpa/inet.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "esp_cpu.h"
+#include "esp_event.h"
+#include "esp_netif_types.h"
+#include "esp_openthread_dns64.h"
+#include "esp_openthread_netif_glue.h"
+#include "esp_openthread_types.h"
+#include "esp_log.h"
+#include "esp_mac.h"
+#include "esp_netif.h"
+#include "esp_timer.h"
+#include "esp_wifi.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "lwip/ip4_addr.h"
+#include "lwip/ip_addr.h"
+#include "lwip/netif.h"
+#include "lwip/pbuf.h"
+#include "lwip/tcpip.h"
+#include "mbedtls/pkcs5.h"
+#include "mbedtls/sha256.h"
+#include "nvs.h"
+#include "sdkconfig.h"
+#include "strlcpy.h"
+
+#define STUB_EVENT_HANDLERS 16
+#define STUB_NVS_ENTRIES 8
+#define STUB_NVS_KEY_MAX 16
+#define STUB_NVS_VALUE_MAX 128
+
+struct stub_semaphore {
+    sem_t sem;
+};
+
+struct esp_netif_obj {
+    esp_ip6_addr_t addrs[CONFIG_LWIP_IPV6_NUM_ADDRESSES];
+    int num;
+};
+
+static struct esp_netif_obj s_thread_netif;
+static struct esp_netif_obj s_wifi_sta_netif;
+static struct {
+    char key[STUB_NVS_KEY_MAX];
+    uint8_t value[STUB_NVS_VALUE_MAX];
+    size_t length;
+} s_nvs[STUB_NVS_ENTRIES];
+static vprintf_like_t s_log_vprintf = vprintf;
+static int64_t s_skipped_us = 0;
+static pthread_mutex_t s_lock = PTHREAD_MUTEX_INITIALIZER;
+static struct {
+    esp_event_base_t base;
+    int32_t id;
+    esp_event_handler_t handler;
+    void *arg;
+} s_event_handlers[STUB_EVENT_HANDLERS];
+
+esp_event_base_t const IP_EVENT = "IP_EVENT";
+esp_event_base_t const WIFI_EVENT = "WIFI_EVENT";
+esp_event_base_t const OPENTHREAD_EVENT = "OPENTHREAD_EVENT";
+_Thread_local int stub_core_id = 0;
+struct netif *netif_list = NULL;
+
+int64_t esp_timer_get_time(void)
+{
+    struct timespec now;
+    int64_t skipped_us;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    pthread_mutex_lock(&s_lock);
+    skipped_us = s_skipped_us;
+    pthread_mutex_unlock(&s_lock);
+    return (int64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000 + skipped_us;
+}
+
+vprintf_like_t esp_log_set_vprintf(vprintf_like_t func)
+{
+    pthread_mutex_lock(&s_lock);
+    vprintf_like_t previous = s_log_vprintf;
+    s_log_vprintf = func;
+    pthread_mutex_unlock(&s_lock);
+    return previous;
+}
+
+uint32_t esp_log_timestamp(void)
+{
+    return (uint32_t)(esp_timer_get_time() / 1000);
+}
+
+void esp_log_write(esp_log_level_t level, const char *tag, const char *format, ...)
+{
+    va_list args;
+
+    pthread_mutex_lock(&s_lock);
+    vprintf_like_t func = s_log_vprintf;
+    pthread_mutex_unlock(&s_lock);
+    va_start(args, format);
+    func(format, args);
+    va_end(args);
+}
+
+void stub_timer_advance_ms(uint32_t ms)
+{
+    pthread_mutex_lock(&s_lock);
+    s_skipped_us += (int64_t)ms * 1000;
+    pthread_mutex_unlock(&s_lock);
+}
+
+esp_netif_t *esp_openthread_get_netif(void)
+{
+    return &s_thread_netif;
+}
+
+void stub_netif_set_addresses(const esp_ip6_addr_t *addrs, int num)
+{
+    pthread_mutex_lock(&s_lock);
+    memcpy(s_thread_netif.addrs, addrs, num * sizeof(esp_ip6_addr_t));
+    s_thread_netif.num = num;
+    pthread_mutex_unlock(&s_lock);
+}
+
+int esp_netif_get_all_ip6(esp_netif_t *esp_netif, esp_ip6_addr_t if_ip6[])
+{
+    pthread_mutex_lock(&s_lock);
+    int num = esp_netif->num;
+    memcpy(if_ip6, esp_netif->addrs, num * sizeof(esp_ip6_addr_t));
+    pthread_mutex_unlock(&s_lock);
+    return num;
+}
+
+int esp_netif_get_netif_impl_index(esp_netif_t *esp_netif)
+{
+    return 2;
+}
+
+esp_err_t esp_openthread_get_nat64_prefix(ip6_addr_t *nat64_prefix)
+{
+    memset(nat64_prefix, 0, sizeof(*nat64_prefix));
+    nat64_prefix->addr[2] = htonl(0xffff);
+    return ESP_OK;
+}
+
+typedef struct stub_task {
+    TaskFunction_t function;
+    void *arg;
+    char name[16];
+} stub_task_t;
+
+static __thread char s_task_name[16];
+
+static void *task_thread(void *ctx)
+{
+    stub_task_t task = *(stub_task_t *)ctx;
+
+    free(ctx);
+    memcpy(s_task_name, task.name, sizeof(s_task_name));
+    task.function(task.arg);
+    return NULL;
+}
+
+const char *pcTaskGetName(TaskHandle_t task)
+{
+    return s_task_name[0] ? s_task_name : "main";
+}
+
+size_t strlcpy(char *dst, const char *src, size_t size)
+{
+    size_t length = strlen(src);
+
+    if (size) {
+        size_t copied = length < size - 1 ? length : size - 1;
+        memcpy(dst, src, copied);
+        dst[copied] = '\0';
+    }
+    return length;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t function, const char *name, uint32_t stack_size, void *arg,
+                       UBaseType_t priority, TaskHandle_t *handle)
+{
+    stub_task_t *task = malloc(sizeof(stub_task_t));
+    pthread_t thread;
+
+    if (!task) {
+        return pdFAIL;
+    }
+    task->function = function;
+    task->arg = arg;
+    snprintf(task->name, sizeof(task->name), "%s", name);
+    if (pthread_create(&thread, NULL, task_thread, task) != 0) {
+        free(task);
+        return pdFAIL;
+    }
+    pthread_detach(thread);
+    if (handle) {
+        *handle = (TaskHandle_t)thread;
+    }
+    return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t task)
+{
+    pthread_exit(NULL);
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    return (TickType_t)(esp_timer_get_time() / 1000);
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    struct timespec delay = {.tv_sec = ticks / 1000, .tv_nsec = (long)(ticks % 1000) * 1000000};
+    nanosleep(&delay, NULL);
+}
+
+static SemaphoreHandle_t semaphore_create(unsigned int value)
+{
+    SemaphoreHandle_t semaphore = malloc(sizeof(struct stub_semaphore));
+
+    if (semaphore && sem_init(&semaphore->sem, 0, value) != 0) {
+        free(semaphore);
+        semaphore = NULL;
+    }
+    return semaphore;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+    return semaphore_create(1);
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+    return semaphore_create(0);
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t semaphore)
+{
+    sem_destroy(&semaphore->sem);
+    free(semaphore);
+}
+
+/* A take with a timeout does not wait: the tests give the semaphores before, or never to run the timeout path. */
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks)
+{
+    if (ticks != portMAX_DELAY) {
+        return sem_trywait(&semaphore->sem) == 0 ? pdTRUE : pdFALSE;
+    }
+    while (sem_wait(&semaphore->sem) != 0) {
+    }
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore)
+{
+    return sem_post(&semaphore->sem) == 0 ? pdTRUE : pdFALSE;
+}
+
+char *ip4addr_ntoa(const ip4_addr_t *addr)
+{
+    struct in_addr in = {.s_addr = addr->addr};
+
+    return inet_ntoa(in);
+}
+
+int ip4addr_aton(const char *cp, ip4_addr_t *addr)
+{
+    struct in_addr in;
+
+    if (inet_aton(cp, &in) == 0) {
+        return 0;
+    }
+    addr->addr = in.s_addr;
+    return 1;
+}
+
+char *ipaddr_ntoa_r(const ip_addr_t *addr, char *buf, int buflen)
+{
+    if (IP_IS_V6(addr)) {
+        return (char *)inet_ntop(AF_INET6, addr->u_addr.ip6.addr, buf, buflen);
+    }
+    return (char *)inet_ntop(AF_INET, &addr->u_addr.ip4.addr, buf, buflen);
+}
+
+int ipaddr_aton(const char *cp, ip_addr_t *addr)
+{
+    memset(addr, 0, sizeof(*addr));
+    if (inet_pton(AF_INET6, cp, addr->u_addr.ip6.addr) == 1) {
+        IP_SET_TYPE_VAL(*addr, IPADDR_TYPE_V6);
+        return 1;
+    }
+    IP_SET_TYPE_VAL(*addr, IPADDR_TYPE_V4);
+    return inet_pton(AF_INET, cp, &addr->u_addr.ip4.addr) == 1;
+}
+
+uint16_t pbuf_copy_partial(const struct pbuf *p, void *dataptr, uint16_t len, uint16_t offset)
+{
+    uint16_t copied = 0;
+
+    for (; p != NULL && copied < len; p = p->next) {
+        if (offset >= p->len) {
+            offset -= p->len;
+            continue;
+        }
+        uint16_t chunk = p->len - offset < len - copied ? p->len - offset : len - copied;
+        memcpy((uint8_t *)dataptr + copied, (const uint8_t *)p->payload + offset, chunk);
+        copied += chunk;
+        offset = 0;
+    }
+    return copied;
+}
+
+err_t tcpip_callback(tcpip_callback_fn function, void *ctx)
+{
+    function(ctx);
+    return ERR_OK;
+}
+
+esp_err_t esp_event_handler_register(esp_event_base_t event_base, int32_t event_id, esp_event_handler_t event_handler,
+                                     void *event_handler_arg)
+{
+    for (int i = 0; i < STUB_EVENT_HANDLERS; i++) {
+        if (s_event_handlers[i].handler == NULL) {
+            s_event_handlers[i].base = event_base;
+            s_event_handlers[i].id = event_id;
+            s_event_handlers[i].handler = event_handler;
+            s_event_handlers[i].arg = event_handler_arg;
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_NO_MEM;
+}
+
+void stub_event_post(esp_event_base_t event_base, int32_t event_id, void *event_data)
+{
+    for (int i = 0; i < STUB_EVENT_HANDLERS; i++) {
+        if (s_event_handlers[i].handler && s_event_handlers[i].base == event_base &&
+            (s_event_handlers[i].id == ESP_EVENT_ANY_ID || s_event_handlers[i].id == event_id)) {
+            s_event_handlers[i].handler(s_event_handlers[i].arg, event_base, event_id, event_data);
+        }
+    }
+}
+
+esp_err_t esp_event_handler_unregister(esp_event_base_t event_base, int32_t event_id,
+                                       esp_event_handler_t event_handler)
+{
+    for (int i = 0; i < STUB_EVENT_HANDLERS; i++) {
+        if (s_event_handlers[i].handler == event_handler && s_event_handlers[i].base == event_base &&
+            s_event_handlers[i].id == event_id) {
+            s_event_handlers[i].handler = NULL;
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_NOT_FOUND;
+}
+
+const char *esp_err_to_name(esp_err_t code)
+{
+    static char s_name[16];
+
+    snprintf(s_name, sizeof(s_name), "0x%x", code);
+    return s_name;
+}
+
+esp_netif_t *esp_netif_get_handle_from_ifkey(const char *if_key)
+{
+    return strcmp(if_key, "WIFI_STA_DEF") == 0 ? &s_wifi_sta_netif : NULL;
+}
+
+esp_err_t esp_netif_create_ip6_linklocal(esp_netif_t *esp_netif)
+{
+    return esp_netif ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_ip6_addr_type_t esp_netif_ip6_get_addr_type(esp_ip6_addr_t *ip6_addr)
+{
+    uint8_t first = ntohl(ip6_addr->addr[0]) >> 24;
+    uint8_t second = (ntohl(ip6_addr->addr[0]) >> 16) & 0xc0;
+
+    if (first == 0xfe && second == 0x80) {
+        return ESP_IP6_ADDR_IS_LINK_LOCAL;
+    }
+    if ((first & 0xfe) == 0xfc) {
+        return ESP_IP6_ADDR_IS_UNIQUE_LOCAL;
+    }
+    return ESP_IP6_ADDR_IS_GLOBAL;
+}
+
+void esp_netif_action_add_ip6_address(void *esp_netif, esp_event_base_t base, int32_t event_id, void *data)
+{
+}
+
+void esp_netif_action_remove_ip6_address(void *esp_netif, esp_event_base_t base, int32_t event_id, void *data)
+{
+}
+
+void esp_netif_action_join_ip6_multicast_group(void *esp_netif, esp_event_base_t base, int32_t event_id, void *data)
+{
+}
+
+void esp_netif_action_leave_ip6_multicast_group(void *esp_netif, esp_event_base_t base, int32_t event_id, void *data)
+{
+}
+
+esp_err_t esp_read_mac(uint8_t *mac, esp_mac_type_t type)
+{
+    static const uint8_t s_mac[6] = {0x02, 0x00, 0x00, 0x00, 0x00, 0x00};
+
+    memcpy(mac, s_mac, sizeof(s_mac));
+    mac[5] = (uint8_t)type;
+    return ESP_OK;
+}
+
+static int stub_nvs_find(const char *key)
+{
+    for (int i = 0; i < STUB_NVS_ENTRIES; i++) {
+        if (s_nvs[i].key[0] && strcmp(s_nvs[i].key, key) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+esp_err_t nvs_open(const char *namespace_name, nvs_open_mode_t open_mode, nvs_handle_t *out_handle)
+{
+    *out_handle = 1;
+    return ESP_OK;
+}
+
+esp_err_t nvs_set_blob(nvs_handle_t handle, const char *key, const void *value, size_t length)
+{
+    int i = stub_nvs_find(key);
+
+    if (i < 0) {
+        for (i = 0; i < STUB_NVS_ENTRIES && s_nvs[i].key[0]; i++) {
+        }
+    }
+    if (i == STUB_NVS_ENTRIES || length > STUB_NVS_VALUE_MAX || strlen(key) >= STUB_NVS_KEY_MAX) {
+        return ESP_ERR_NVS_NOT_ENOUGH_SPACE;
+    }
+    strcpy(s_nvs[i].key, key);
+    memcpy(s_nvs[i].value, value, length);
+    s_nvs[i].length = length;
+    return ESP_OK;
+}
+
+esp_err_t nvs_get_blob(nvs_handle_t handle, const char *key, void *out_value, size_t *length)
+{
+    int i = stub_nvs_find(key);
+
+    if (i < 0) {
+        return ESP_ERR_NVS_NOT_FOUND;
+    }
+    if (*length < s_nvs[i].length) {
+        return ESP_ERR_NVS_INVALID_LENGTH;
+    }
+    memcpy(out_value, s_nvs[i].value, s_nvs[i].length);
+    *length = s_nvs[i].length;
+    return ESP_OK;
+}
+
+esp_err_t nvs_set_str(nvs_handle_t handle, const char *key, const char *value)
+{
+    return nvs_set_blob(handle, key, value, strlen(value) + 1);
+}
+
+esp_err_t nvs_get_str(nvs_handle_t handle, const char *key, char *out_value, size_t *length)
+{
+    return nvs_get_blob(handle, key, out_value, length);
+}
+
+esp_err_t nvs_erase_all(nvs_handle_t handle)
+{
+    memset(s_nvs, 0, sizeof(s_nvs));
+    return ESP_OK;
+}
+
+esp_err_t nvs_commit(nvs_handle_t handle)
+{
+    return ESP_OK;
+}
+
+static uint32_t stub_fnv(uint32_t hash, const unsigned char *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+int mbedtls_sha256(const unsigned char *input, size_t ilen, unsigned char output[32], int is224)
+{
+    for (uint32_t i = 0; i < 32; i++) {
+        output[i] = (unsigned char)stub_fnv(stub_fnv(2166136261u, (const unsigned char *)&i, sizeof(i)), input, ilen);
+    }
+    return 0;
+}
+
+int mbedtls_pkcs5_pbkdf2_hmac_ext(mbedtls_md_type_t md_type, const unsigned char *password, size_t plen,
+                                  const unsigned char *salt, size_t slen, unsigned int iteration_count,
+                                  uint32_t key_length, unsigned char *output)
+{
+    for (uint32_t i = 0; i < key_length; i++) {
+        uint32_t hash = stub_fnv(2166136261u, (const unsigned char *)&i, sizeof(i));
+        output[i] = (unsigned char)stub_fnv(stub_fnv(hash, password, plen), salt, slen);
+    }
+    return 0;
+}
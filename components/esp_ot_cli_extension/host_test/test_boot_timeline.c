@@ -0,0 +1,180 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "esp_ot_boot_timeline.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "host_test.h"
+#include "sdkconfig.h"
+
+/*
+ * Replays the bring-up of the border router examples with the recorder, as it ran before the storage mounts and the
+ * mDNS initialization were moved alongside the RCP reset and as it runs now, each phase being a sleep. The durations
+ * are the illustrative ones of the `boottime` example of the README scaled down 10 times, not measured ones, so the
+ * totals only check the schedule of the steps and are not the improvement on a board. The tasks are threads, so the
+ * steps overlap as they do on a dual core.
+ */
+#define TEST_SCALE 10
+#define TEST_STEPS_NUM 2
+
+typedef struct boot_step {
+    const char *name;
+    uint32_t duration_us; /* on the board */
+} boot_step_t;
+
+static const boot_step_t s_spiffs = {"spiffs", 289608};
+static const boot_step_t s_mdns = {"mdns", 17236};
+static const boot_step_t s_rcp = {"rcp", 773335};
+static const boot_step_t s_backbone = {"backbone", 2639484};
+static const boot_step_t s_br_init = {"br-init", 87155};
+static const boot_step_t s_thread_attach = {"thread-attach", 1159377};
+
+static SemaphoreHandle_t s_step_done;
+
+static void run_step(const boot_step_t *step)
+{
+    uint32_t us = step->duration_us / TEST_SCALE;
+    struct timespec delay = {.tv_sec = us / 1000000, .tv_nsec = (long)(us % 1000000) * 1000};
+
+    esp_ot_boot_phase_begin(step->name);
+    nanosleep(&delay, NULL);
+    esp_ot_boot_phase_end(step->name);
+}
+
+static void step_task(void *ctx)
+{
+    run_step(ctx);
+    xSemaphoreGive(s_step_done);
+}
+
+static void ot_br_init_task(void *ctx)
+{
+    run_step(&s_backbone);
+    run_step(&s_br_init);
+    run_step(&s_thread_attach);
+    xSemaphoreGive(s_step_done);
+}
+
+static void start_task(TaskFunction_t function, const char *name, const boot_step_t *step)
+{
+    TEST_ASSERT_EQUAL(pdPASS, xTaskCreate(function, name, 4096, (void *)step, 5, NULL));
+}
+
+/* The time from the first begin to the last end of the phases recorded since @param first. */
+static int64_t boot_span_us(uint8_t first, uint8_t *num)
+{
+    esp_ot_boot_phase_t phases[CONFIG_OPENTHREAD_BOOT_TIMELINE_MAX_PHASES];
+    int64_t last_end_us = 0;
+
+    *num = esp_ot_boot_timeline_get(phases, CONFIG_OPENTHREAD_BOOT_TIMELINE_MAX_PHASES, NULL);
+    for (uint8_t i = first; i < *num; i++) {
+        TEST_ASSERT(phases[i].end_us != ESP_OT_BOOT_PHASE_RUNNING);
+        last_end_us = phases[i].end_us > last_end_us ? phases[i].end_us : last_end_us;
+    }
+    return last_end_us - phases[first].begin_us;
+}
+
+static int64_t s_serial_us;
+static int64_t s_concurrent_us;
+
+static void test_serial_bringup(void)
+{
+    uint8_t num = 0;
+
+    run_step(&s_spiffs);
+    run_step(&s_mdns);
+    run_step(&s_rcp);
+    start_task(ot_br_init_task, "ot_br_init", NULL);
+    xSemaphoreTake(s_step_done, portMAX_DELAY);
+    s_serial_us = boot_span_us(0, &num) * TEST_SCALE;
+    TEST_ASSERT_EQUAL(6, num);
+}
+
+static void test_concurrent_bringup(void)
+{
+    uint8_t first = 0;
+    uint8_t num = 0;
+
+    boot_span_us(0, &first);
+    start_task(step_task, s_spiffs.name, &s_spiffs);
+    start_task(step_task, s_mdns.name, &s_mdns);
+    run_step(&s_rcp);
+    esp_ot_boot_phase_begin("bringup-wait");
+    for (int i = 0; i < TEST_STEPS_NUM; i++) {
+        xSemaphoreTake(s_step_done, portMAX_DELAY);
+    }
+    esp_ot_boot_phase_end("bringup-wait");
+    start_task(ot_br_init_task, "ot_br_init", NULL);
+    xSemaphoreTake(s_step_done, portMAX_DELAY);
+    s_concurrent_us = boot_span_us(first, &num) * TEST_SCALE;
+    TEST_ASSERT_EQUAL(first + 7, num);
+
+    printf("modelled bring-up: serial %lld us, concurrent %lld us, %lld us saved\n", (long long)s_serial_us,
+           (long long)s_concurrent_us, (long long)(s_serial_us - s_concurrent_us));
+    /* The mounts and the mDNS are hidden behind the RCP reset, up to the scheduling noise of the host. */
+    TEST_ASSERT(s_serial_us - s_concurrent_us > (s_spiffs.duration_us + s_mdns.duration_us) / 2);
+    TEST_ASSERT(s_concurrent_us < s_serial_us);
+}
+
+static void test_phase_names(void)
+{
+    esp_ot_boot_phase_t phases[CONFIG_OPENTHREAD_BOOT_TIMELINE_MAX_PHASES];
+    uint8_t num = esp_ot_boot_timeline_get(phases, CONFIG_OPENTHREAD_BOOT_TIMELINE_MAX_PHASES, NULL);
+
+    TEST_ASSERT_EQUAL(0, strcmp(phases[0].task, "main"));
+    TEST_ASSERT_EQUAL(0, strcmp(phases[3].task, "ot_br_init"));
+    for (uint8_t i = 6; i < num; i++) {
+        if (strcmp(phases[i].name, "spiffs") == 0 || strcmp(phases[i].name, "mdns") == 0) {
+            TEST_ASSERT_EQUAL(0, strcmp(phases[i].task, phases[i].name));
+        }
+    }
+}
+
+static void test_running_phase(void)
+{
+    esp_ot_boot_phase_t phases[CONFIG_OPENTHREAD_BOOT_TIMELINE_MAX_PHASES];
+
+    esp_ot_boot_phase_begin("attach");
+    esp_ot_boot_phase_begin("attach");
+    esp_ot_boot_phase_end("attach");
+    uint8_t num = esp_ot_boot_timeline_get(phases, CONFIG_OPENTHREAD_BOOT_TIMELINE_MAX_PHASES, NULL);
+    /* The end matches the last phase began with the name. */
+    TEST_ASSERT_EQUAL(ESP_OT_BOOT_PHASE_RUNNING, phases[num - 2].end_us);
+    TEST_ASSERT(phases[num - 1].end_us >= phases[num - 1].begin_us);
+}
+
+static void test_dropped_phases(void)
+{
+    esp_ot_boot_phase_t phases[CONFIG_OPENTHREAD_BOOT_TIMELINE_MAX_PHASES];
+    uint32_t dropped = 0;
+    uint8_t num = esp_ot_boot_timeline_get(phases, CONFIG_OPENTHREAD_BOOT_TIMELINE_MAX_PHASES, &dropped);
+
+    TEST_ASSERT_EQUAL(0, dropped);
+    for (uint8_t i = num; i < CONFIG_OPENTHREAD_BOOT_TIMELINE_MAX_PHASES + 3; i++) {
+        esp_ot_boot_phase_begin("filler");
+    }
+    num = esp_ot_boot_timeline_get(phases, CONFIG_OPENTHREAD_BOOT_TIMELINE_MAX_PHASES, &dropped);
+    TEST_ASSERT_EQUAL(CONFIG_OPENTHREAD_BOOT_TIMELINE_MAX_PHASES, num);
+    TEST_ASSERT_EQUAL(3, dropped);
+}
+
+int main(void)
+{
+    s_step_done = xSemaphoreCreateBinary();
+    TEST_ASSERT_NOT_NULL(s_step_done);
+
+    RUN_TEST(test_serial_bringup);
+    RUN_TEST(test_concurrent_bringup);
+    RUN_TEST(test_phase_names);
+    esp_ot_process_boot_timeline(NULL, 0, NULL);
+    RUN_TEST(test_running_phase);
+    RUN_TEST(test_dropped_phases);
+    return 0;
+}
@@ -0,0 +1,571 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <arpa/inet.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include "esp_ot_capture.h"
+#include "host_test.h"
+#include "lwip/pbuf.h"
+#include "lwip/prot/ip.h"
+#include "sdkconfig.h"
+
+/*
+ * Taps packets into the capture as the netif wrappers of the IP statistics do, reads the ring buffer as the web server
+ * does and parses the pcapng blocks: the section and interface headers, the packets, their direction and length, the
+ * filter, the drops of a full ring, the skip record at its end and the statistics. The concurrent test taps from four
+ * threads while a fifth one reads, and checks that each packet is read whole and once or counted as dropped.
+ */
+#define TEST_NETIFS 3
+#define TEST_BUF_SIZE (64 * 1024)
+#define TEST_WRITERS 4
+#define TEST_WRITER_PACKETS 5000
+#define TEST_L2_LEN 14
+
+#define PCAPNG_SHB_TYPE 0x0A0D0D0A
+#define PCAPNG_IDB_TYPE 0x00000001
+#define PCAPNG_ISB_TYPE 0x00000005
+#define PCAPNG_EPB_TYPE 0x00000006
+
+typedef struct epb {
+    uint32_t netif;
+    uint64_t time_us;
+    uint32_t cap_len;
+    uint32_t orig_len;
+    const uint8_t *data;
+    uint32_t flags;
+} epb_t;
+
+static const char *const s_netif_names[TEST_NETIFS] = {"ot", "st", "et"};
+static _Atomic(esp_ot_ip_stats_tap_t) s_tap = NULL;
+static uint8_t s_buf[TEST_BUF_SIZE];
+
+const char *esp_ot_ip_stats_netif_name(uint8_t netif)
+{
+    return netif < TEST_NETIFS ? s_netif_names[netif] : NULL;
+}
+
+void esp_ot_ip_stats_set_tap(esp_ot_ip_stats_tap_t tap)
+{
+    atomic_store(&s_tap, tap);
+}
+
+static uint32_t get32(const uint8_t *data)
+{
+    uint32_t value;
+
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+static uint16_t get16(const uint8_t *data)
+{
+    uint16_t value;
+
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+static uint32_t align4(uint32_t len)
+{
+    return (len + 3) & ~3U;
+}
+
+/* Builds a UDP or TCP packet of len bytes whose payload is derived from tag. */
+static uint16_t make_packet(uint8_t *ip, uint16_t len, const char *src, const char *dst, uint8_t proto,
+                            uint16_t src_port, uint16_t dst_port, uint32_t tag)
+{
+    uint16_t l4 = 0;
+
+    memset(ip, 0, len);
+    if (strchr(src, ':')) {
+        ip[0] = 0x60;
+        ip[4] = (len - 40) >> 8;
+        ip[5] = (len - 40) & 0xff;
+        ip[6] = proto;
+        ip[7] = 64;
+        TEST_ASSERT_EQUAL(1, inet_pton(AF_INET6, src, ip + 8));
+        TEST_ASSERT_EQUAL(1, inet_pton(AF_INET6, dst, ip + 24));
+        l4 = 40;
+    } else {
+        ip[0] = 0x46; /* with one word of options */
+        ip[2] = len >> 8;
+        ip[3] = len & 0xff;
+        ip[8] = 64;
+        ip[9] = proto;
+        TEST_ASSERT_EQUAL(1, inet_pton(AF_INET, src, ip + 12));
+        TEST_ASSERT_EQUAL(1, inet_pton(AF_INET, dst, ip + 16));
+        l4 = 24;
+    }
+    ip[l4] = src_port >> 8;
+    ip[l4 + 1] = src_port & 0xff;
+    ip[l4 + 2] = dst_port >> 8;
+    ip[l4 + 3] = dst_port & 0xff;
+    memcpy(ip + l4 + 4, &tag, sizeof(tag));
+    for (uint16_t i = l4 + 8; i < len; i++) {
+        ip[i] = (uint8_t)(tag * 7 + i);
+    }
+    return len;
+}
+
+/* Taps the packet behind an L2 header of l2_len bytes, in a chain of two pbufs split inside the IP header. */
+static void tap(uint8_t netif, bool egress, const uint8_t *ip, uint16_t len, uint16_t l2_len)
+{
+    uint8_t frame[TEST_L2_LEN + 1500];
+    esp_ot_ip_stats_tap_t tap = atomic_load(&s_tap);
+    uint16_t split = l2_len + 20;
+
+    if (tap == NULL) {
+        return;
+    }
+    memset(frame, 0xee, l2_len);
+    memcpy(frame + l2_len, ip, len);
+    struct pbuf second = {.payload = frame + split, .len = l2_len + len - split, .tot_len = l2_len + len - split};
+    struct pbuf first = {.next = &second, .payload = frame, .len = split, .tot_len = l2_len + len};
+    tap(netif, egress, &first, l2_len);
+}
+
+static esp_ot_capture_filter_t any_filter(uint16_t snaplen)
+{
+    esp_ot_capture_filter_t filter = {.port = ESP_OT_CAPTURE_ANY_PORT, .proto = ESP_OT_CAPTURE_ANY_PROTO,
+                                      .snaplen = snaplen};
+    return filter;
+}
+
+/* Checks the block at data and returns its length. */
+static uint32_t check_block(const uint8_t *data, size_t left)
+{
+    TEST_ASSERT(left >= 12);
+    uint32_t len = get32(data + 4);
+    TEST_ASSERT(len % 4 == 0 && len >= 12 && len <= left);
+    TEST_ASSERT_EQUAL(len, get32(data + len - 4));
+    return len;
+}
+
+static uint32_t parse_epb(const uint8_t *data, epb_t *epb)
+{
+    TEST_ASSERT_EQUAL(PCAPNG_EPB_TYPE, get32(data));
+    epb->netif = get32(data + 8);
+    epb->time_us = ((uint64_t)get32(data + 12) << 32) | get32(data + 16);
+    epb->cap_len = get32(data + 20);
+    epb->orig_len = get32(data + 24);
+    epb->data = data + 28;
+    const uint8_t *options = epb->data + align4(epb->cap_len);
+    TEST_ASSERT_EQUAL(2, get16(options)); /* epb_flags */
+    TEST_ASSERT_EQUAL(4, get16(options + 2));
+    epb->flags = get32(options + 4);
+    TEST_ASSERT_EQUAL(0, get32(options + 8));
+    TEST_ASSERT_EQUAL(32 + align4(epb->cap_len) + 12, get32(data + 4));
+    return get32(data + 4);
+}
+
+/* Checks the section header and the interface blocks, returns their length. */
+static size_t check_header(const uint8_t *data, size_t len, uint16_t snaplen)
+{
+    static const char *const names[ESP_OT_IP_STATS_MAX_NETIFS] = {"ot", "st", "et", "none"};
+    size_t offset = 0;
+
+    TEST_ASSERT_EQUAL(PCAPNG_SHB_TYPE, get32(data));
+    offset += check_block(data, len);
+    TEST_ASSERT_EQUAL(28, offset);
+    TEST_ASSERT_EQUAL(0x1A2B3C4D, get32(data + 8));
+    TEST_ASSERT_EQUAL(1, get16(data + 12));
+    TEST_ASSERT_EQUAL(0, get16(data + 14));
+    for (int i = 0; i < ESP_OT_IP_STATS_MAX_NETIFS; i++) {
+        const uint8_t *idb = data + offset;
+        TEST_ASSERT_EQUAL(PCAPNG_IDB_TYPE, get32(idb));
+        offset += check_block(idb, len - offset);
+        TEST_ASSERT_EQUAL(101, get16(idb + 8)); /* LINKTYPE_RAW */
+        TEST_ASSERT_EQUAL(snaplen, get32(idb + 12));
+        TEST_ASSERT_EQUAL(2, get16(idb + 16)); /* if_name */
+        TEST_ASSERT_EQUAL(strlen(names[i]), get16(idb + 18));
+        TEST_ASSERT_EQUAL(0, memcmp(idb + 20, names[i], strlen(names[i])));
+    }
+    return offset;
+}
+
+static void check_isb(const uint8_t *data, size_t len, const uint32_t *received, const uint32_t *dropped)
+{
+    TEST_ASSERT_EQUAL(ESP_OT_IP_STATS_MAX_NETIFS * 52, len);
+    for (uint32_t i = 0; i < ESP_OT_IP_STATS_MAX_NETIFS; i++) {
+        const uint8_t *isb = data + i * 52;
+        TEST_ASSERT_EQUAL(PCAPNG_ISB_TYPE, get32(isb));
+        TEST_ASSERT_EQUAL(52, check_block(isb, len - i * 52));
+        TEST_ASSERT_EQUAL(i, get32(isb + 8));
+        TEST_ASSERT_EQUAL(4, get16(isb + 20)); /* isb_ifrecv */
+        TEST_ASSERT_EQUAL(received[i], get32(isb + 24));
+        TEST_ASSERT_EQUAL(5, get16(isb + 32)); /* isb_ifdrop */
+        TEST_ASSERT_EQUAL(dropped[i], get32(isb + 36));
+    }
+}
+
+static void test_idle(void)
+{
+    esp_ot_capture_filter_t filter = any_filter(0);
+
+    TEST_ASSERT_EQUAL(0, esp_ot_capture_read(s_buf, sizeof(s_buf)));
+    TEST_ASSERT_EQUAL(0, esp_ot_capture_finish(s_buf, sizeof(s_buf)));
+    TEST_ASSERT_FALSE(esp_ot_capture_is_running());
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_ot_capture_start(&filter));
+    TEST_ASSERT_NULL(atomic_load(&s_tap));
+}
+
+static void test_pcapng_layout(void)
+{
+    esp_ot_capture_filter_t filter = any_filter(128);
+    uint8_t small[60];
+    uint8_t large[200];
+    struct timeval now;
+    epb_t epb;
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_capture_start(&filter));
+    TEST_ASSERT(esp_ot_capture_is_running());
+    TEST_ASSERT_NOT_NULL(atomic_load(&s_tap));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, esp_ot_capture_start(&filter));
+
+    make_packet(small, sizeof(small), "2001:db8::1", "fd00::1", IP_PROTO_UDP, 1234, 5683, 1);
+    make_packet(large, sizeof(large), "fd00::1", "2001:db8::1", IP_PROTO_TCP, 5683, 1234, 2);
+    tap(1, false, small, sizeof(small), TEST_L2_LEN);
+    tap(0, true, large, sizeof(large), 0);
+    tap(4, true, large, sizeof(large), 0); /* a netif without a name is not captured */
+
+    size_t len = esp_ot_capture_read(s_buf, sizeof(s_buf));
+    size_t offset = check_header(s_buf, len, 128);
+    gettimeofday(&now, NULL);
+    uint64_t now_us = (uint64_t)now.tv_sec * 1000000 + now.tv_usec;
+
+    offset += parse_epb(s_buf + offset, &epb);
+    TEST_ASSERT_EQUAL(1, epb.netif);
+    TEST_ASSERT_EQUAL(sizeof(small), epb.cap_len);
+    TEST_ASSERT_EQUAL(sizeof(small), epb.orig_len);
+    TEST_ASSERT_EQUAL(0, memcmp(epb.data, small, sizeof(small))); /* without the L2 header */
+    TEST_ASSERT_EQUAL(1, epb.flags);                              /* inbound */
+    TEST_ASSERT(epb.time_us <= now_us && epb.time_us + 5000000 > now_us);
+
+    offset += parse_epb(s_buf + offset, &epb);
+    TEST_ASSERT_EQUAL(0, epb.netif);
+    TEST_ASSERT_EQUAL(128, epb.cap_len);
+    TEST_ASSERT_EQUAL(sizeof(large), epb.orig_len);
+    TEST_ASSERT_EQUAL(0, memcmp(epb.data, large, 128));
+    TEST_ASSERT_EQUAL(2, epb.flags); /* outbound */
+    TEST_ASSERT_EQUAL(len, offset);
+    TEST_ASSERT_EQUAL(0, esp_ot_capture_read(s_buf, sizeof(s_buf)));
+
+    /* The stopped capture is still read, then finished with the statistics. */
+    tap(1, false, small, sizeof(small), TEST_L2_LEN);
+    esp_ot_capture_stop();
+    TEST_ASSERT_FALSE(esp_ot_capture_is_running());
+    TEST_ASSERT_NULL(atomic_load(&s_tap));
+    len = esp_ot_capture_read(s_buf, sizeof(s_buf));
+    TEST_ASSERT_EQUAL(parse_epb(s_buf, &epb), len);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, esp_ot_capture_start(&filter));
+
+    const uint32_t received[ESP_OT_IP_STATS_MAX_NETIFS] = {1, 2, 0, 0};
+    const uint32_t dropped[ESP_OT_IP_STATS_MAX_NETIFS] = {0};
+    check_isb(s_buf, esp_ot_capture_finish(s_buf, sizeof(s_buf)), received, dropped);
+    TEST_ASSERT_EQUAL(0, esp_ot_capture_read(s_buf, sizeof(s_buf)));
+    TEST_ASSERT_EQUAL(0, esp_ot_capture_finish(s_buf, sizeof(s_buf)));
+}
+
+static void test_parse_filter(void)
+{
+    esp_ot_capture_filter_t filter = any_filter(128);
+    char addr[IPADDR_STRLEN_MAX];
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_capture_parse_filter("netif", "ot", &filter));
+    TEST_ASSERT_EQUAL(0, strcmp(filter.netif, "ot"));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_ot_capture_parse_filter("netif", "ot0", &filter));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_capture_parse_filter("addr", "fd00::1", &filter));
+    TEST_ASSERT(filter.has_addr);
+    TEST_ASSERT_EQUAL(0, strcmp(ipaddr_ntoa_r(&filter.addr, addr, sizeof(addr)), "fd00::1"));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_ot_capture_parse_filter("addr", "fd00::g", &filter));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_capture_parse_filter("proto", "tcp", &filter));
+    TEST_ASSERT_EQUAL(IP_PROTO_TCP, filter.proto);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_capture_parse_filter("proto", "icmp6", &filter));
+    TEST_ASSERT_EQUAL(58, filter.proto);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_capture_parse_filter("proto", "17", &filter));
+    TEST_ASSERT_EQUAL(IP_PROTO_UDP, filter.proto);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_ot_capture_parse_filter("proto", "255", &filter));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_ot_capture_parse_filter("proto", "", &filter));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_capture_parse_filter("port", "5683", &filter));
+    TEST_ASSERT_EQUAL(5683, filter.port);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_ot_capture_parse_filter("port", "0", &filter));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_ot_capture_parse_filter("port", "65536", &filter));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_ot_capture_parse_filter("port", "56x", &filter));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_capture_parse_filter("snaplen", "1500", &filter));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_ot_capture_parse_filter("snaplen", "1501", &filter));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_ot_capture_parse_filter("duration", "10", &filter));
+    TEST_ASSERT_EQUAL(5683, filter.port); /* unchanged by the errors */
+    TEST_ASSERT_EQUAL(1500, filter.snaplen);
+}
+
+/* Only the packets matching the netif, one of the addresses, the protocol and one of the ports are captured. */
+static void test_filter(void)
+{
+    esp_ot_capture_filter_t filter = any_filter(128);
+    esp_ot_capture_netif_stats_t stats[ESP_OT_IP_STATS_MAX_NETIFS];
+    uint8_t ip[100];
+    epb_t epb;
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_capture_parse_filter("netif", "ot", &filter));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_capture_parse_filter("addr", "fd00::1", &filter));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_capture_parse_filter("proto", "udp", &filter));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_capture_parse_filter("port", "5683", &filter));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_capture_start(&filter));
+
+    make_packet(ip, sizeof(ip), "fd00::1", "fd00::2", IP_PROTO_UDP, 1000, 5683, 10);
+    tap(0, false, ip, sizeof(ip), 0);
+    tap(1, false, ip, sizeof(ip), TEST_L2_LEN); /* another netif */
+    make_packet(ip, sizeof(ip), "fd00::2", "fd00::1", IP_PROTO_UDP, 5683, 1000, 11);
+    tap(0, true, ip, sizeof(ip), 0);
+    make_packet(ip, sizeof(ip), "fd00::2", "fd00::3", IP_PROTO_UDP, 5683, 1000, 12); /* another address */
+    tap(0, true, ip, sizeof(ip), 0);
+    make_packet(ip, sizeof(ip), "fd00::1", "fd00::2", IP_PROTO_TCP, 1000, 5683, 13); /* another protocol */
+    tap(0, true, ip, sizeof(ip), 0);
+    make_packet(ip, sizeof(ip), "fd00::1", "fd00::2", IP_PROTO_UDP, 1000, 5684, 14); /* another port */
+    tap(0, true, ip, sizeof(ip), 0);
+    make_packet(ip, sizeof(ip), "192.168.1.1", "192.168.1.2", IP_PROTO_UDP, 1000, 5683, 15); /* IPv4 */
+    tap(0, true, ip, sizeof(ip), 0);
+
+    size_t len = esp_ot_capture_read(s_buf, sizeof(s_buf));
+    size_t offset = check_header(s_buf, len, 128);
+    for (uint32_t tag = 10; tag <= 11; tag++) {
+        offset += parse_epb(s_buf + offset, &epb);
+        TEST_ASSERT_EQUAL(tag, get32(epb.data + 44));
+    }
+    TEST_ASSERT_EQUAL(len, offset);
+    esp_ot_capture_get_stats(stats);
+    TEST_ASSERT_EQUAL(0, strcmp(stats[0].name, "ot"));
+    TEST_ASSERT_EQUAL(2, stats[0].matched);
+    TEST_ASSERT_EQUAL(0, stats[1].matched);
+    TEST_ASSERT_EQUAL(0, stats[3].name[0]);
+    esp_ot_capture_finish(s_buf, sizeof(s_buf));
+
+    /* An IPv4 address and port, behind the options of the header. */
+    filter = any_filter(128);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_capture_parse_filter("addr", "192.168.1.2", &filter));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_capture_parse_filter("port", "53", &filter));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_capture_start(&filter));
+    make_packet(ip, sizeof(ip), "192.168.1.1", "192.168.1.2", IP_PROTO_UDP, 1000, 53, 20);
+    tap(2, true, ip, sizeof(ip), 0);
+    make_packet(ip, sizeof(ip), "192.168.1.2", "192.168.1.1", IP_PROTO_UDP, 53, 1000, 21);
+    tap(1, false, ip, sizeof(ip), TEST_L2_LEN);
+    make_packet(ip, sizeof(ip), "192.168.1.1", "192.168.1.2", 1, 0, 53, 22); /* ICMP has no port */
+    tap(1, false, ip, sizeof(ip), TEST_L2_LEN);
+    make_packet(ip, sizeof(ip), "fd00::1", "fd00::2", IP_PROTO_UDP, 1000, 53, 23);
+    tap(1, false, ip, sizeof(ip), TEST_L2_LEN);
+
+    len = esp_ot_capture_read(s_buf, sizeof(s_buf));
+    offset = check_header(s_buf, len, 128);
+    for (uint32_t tag = 20; tag <= 21; tag++) {
+        offset += parse_epb(s_buf + offset, &epb);
+        TEST_ASSERT_EQUAL(tag, get32(epb.data + 28));
+    }
+    TEST_ASSERT_EQUAL(len, offset);
+    esp_ot_capture_finish(s_buf, sizeof(s_buf));
+}
+
+/* A full ring drops the packets and counts them, the reader frees the records and a record never wraps around. */
+static void test_overflow(void)
+{
+    esp_ot_capture_filter_t filter = any_filter(1500);
+    uint8_t ip[1000];
+    epb_t epb;
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_capture_start(&filter));
+    check_header(s_buf, esp_ot_capture_read(s_buf, sizeof(s_buf)), 1500);
+
+    /* Each record takes 4 + 12 + 1000 bytes, 4 of them fit. */
+    for (uint32_t tag = 0; tag < 5; tag++) {
+        make_packet(ip, sizeof(ip), "fd00::1", "fd00::2", IP_PROTO_UDP, 1000, 2000, tag);
+        tap(0, true, ip, sizeof(ip), 0);
+    }
+    esp_ot_capture_netif_stats_t stats[ESP_OT_IP_STATS_MAX_NETIFS];
+    esp_ot_capture_get_stats(stats);
+    TEST_ASSERT_EQUAL(5, stats[0].matched);
+    TEST_ASSERT_EQUAL(1, stats[0].dropped);
+
+    /* A read buffer holding one block reads one record. */
+    uint32_t epb_len = 32 + sizeof(ip) + 12;
+    TEST_ASSERT_EQUAL(0, esp_ot_capture_read(s_buf, epb_len - 1));
+    TEST_ASSERT_EQUAL(epb_len, esp_ot_capture_read(s_buf, epb_len));
+    TEST_ASSERT_EQUAL(epb_len, parse_epb(s_buf, &epb));
+    TEST_ASSERT_EQUAL(0, get32(epb.data + 44));
+
+    /* The packet which did not fit at the end of the ring is written at its start, behind a skip record. */
+    make_packet(ip, sizeof(ip), "fd00::1", "fd00::2", IP_PROTO_UDP, 1000, 2000, 5);
+    tap(0, true, ip, sizeof(ip), 0);
+    size_t len = esp_ot_capture_read(s_buf, sizeof(s_buf));
+    TEST_ASSERT_EQUAL(4 * epb_len, len);
+    for (uint32_t i = 0; i < 4; i++) {
+        uint32_t tag = i < 3 ? i + 1 : 5;
+        parse_epb(s_buf + i * epb_len, &epb);
+        TEST_ASSERT_EQUAL(tag, get32(epb.data + 44));
+        TEST_ASSERT_EQUAL((uint8_t)(tag * 7 + 100), epb.data[100]);
+    }
+
+    /* The next records follow it. */
+    for (uint32_t tag = 6; tag < 9; tag++) {
+        make_packet(ip, sizeof(ip), "fd00::1", "fd00::2", IP_PROTO_UDP, 1000, 2000, tag);
+        tap(0, true, ip, sizeof(ip), 0);
+    }
+    len = esp_ot_capture_read(s_buf, sizeof(s_buf));
+    TEST_ASSERT_EQUAL(3 * epb_len, len);
+    for (uint32_t i = 0; i < 3; i++) {
+        parse_epb(s_buf + i * epb_len, &epb);
+        TEST_ASSERT_EQUAL(6 + i, get32(epb.data + 44));
+        TEST_ASSERT_EQUAL((uint8_t)((6 + i) * 7 + 100), epb.data[100]);
+    }
+
+    const uint32_t received[ESP_OT_IP_STATS_MAX_NETIFS] = {9};
+    const uint32_t dropped[ESP_OT_IP_STATS_MAX_NETIFS] = {1};
+    check_isb(s_buf, esp_ot_capture_finish(s_buf, sizeof(s_buf)), received, dropped);
+
+    /* The statistics are not written without the header nor into a buffer too small for them. */
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_capture_start(&filter));
+    TEST_ASSERT_EQUAL(0, esp_ot_capture_finish(s_buf, sizeof(s_buf)));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_capture_start(&filter));
+    TEST_ASSERT(esp_ot_capture_read(s_buf, sizeof(s_buf)) > 0);
+    TEST_ASSERT_EQUAL(0, esp_ot_capture_finish(s_buf, ESP_OT_IP_STATS_MAX_NETIFS * 52 - 1));
+}
+
+typedef struct writer {
+    uint8_t id;
+    uint32_t sent;
+} writer_t;
+
+static _Atomic int s_writers_running = 0;
+
+static void *writer_task(void *arg)
+{
+    writer_t *writer = arg;
+    uint8_t ip[400];
+
+    for (uint32_t seq = 0; seq < TEST_WRITER_PACKETS; seq++) {
+        uint16_t len = 48 + (seq * 37 + writer->id * 11) % (sizeof(ip) - 48);
+        make_packet(ip, len, "fd00::1", "fd00::2", IP_PROTO_UDP, writer->id, seq & 0xffff, seq);
+        tap(writer->id % TEST_NETIFS, writer->id & 1, ip, len, writer->id & 1 ? 0 : TEST_L2_LEN);
+        writer->sent++;
+        sched_yield(); /* let the reader run as the forwarding tasks do */
+    }
+    atomic_fetch_sub(&s_writers_running, 1);
+    return NULL;
+}
+
+static void *reader_task(void *arg)
+{
+    uint32_t *read = arg;
+    int64_t next_seq[TEST_WRITERS];
+    bool header = false;
+
+    for (int i = 0; i < TEST_WRITERS; i++) {
+        next_seq[i] = 0;
+    }
+    while (true) {
+        bool running = atomic_load(&s_writers_running) > 0;
+        size_t len = esp_ot_capture_read(s_buf, sizeof(s_buf));
+        size_t offset = 0;
+        if (!header && len > 0) {
+            offset = check_header(s_buf, len, 400);
+            header = true;
+        }
+        while (offset < len) {
+            epb_t epb;
+            check_block(s_buf + offset, len - offset);
+            offset += parse_epb(s_buf + offset, &epb);
+            uint8_t id = epb.data[41];
+            uint32_t seq = get32(epb.data + 44);
+            TEST_ASSERT(id < TEST_WRITERS);
+            TEST_ASSERT_EQUAL(id % TEST_NETIFS, epb.netif);
+            TEST_ASSERT_EQUAL(epb.orig_len, epb.cap_len);
+            TEST_ASSERT_EQUAL(48 + (seq * 37 + id * 11) % (400 - 48), epb.cap_len);
+            TEST_ASSERT((int64_t)seq >= next_seq[id]); /* the packets of a writer keep their order */
+            for (uint32_t i = 48; i < epb.cap_len; i++) {
+                TEST_ASSERT_EQUAL((uint8_t)(seq * 7 + i), epb.data[i]);
+            }
+            next_seq[id] = (int64_t)seq + 1;
+            read[id]++;
+        }
+        if (!running && len == 0) {
+            break;
+        }
+    }
+    return NULL;
+}
+
+/* The writers of the ring do not wait for each other nor for the reader, a packet is read whole or dropped. */
+static void test_concurrent(void)
+{
+    esp_ot_capture_filter_t filter = any_filter(400);
+    esp_ot_capture_netif_stats_t stats[ESP_OT_IP_STATS_MAX_NETIFS];
+    writer_t writers[TEST_WRITERS];
+    pthread_t writer_threads[TEST_WRITERS];
+    pthread_t reader_thread;
+    uint32_t read[TEST_WRITERS] = {0};
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_capture_start(&filter));
+    atomic_store(&s_writers_running, TEST_WRITERS);
+    TEST_ASSERT_EQUAL(0, pthread_create(&reader_thread, NULL, reader_task, read));
+    for (uint8_t i = 0; i < TEST_WRITERS; i++) {
+        writers[i] = (writer_t) {.id = i};
+        TEST_ASSERT_EQUAL(0, pthread_create(&writer_threads[i], NULL, writer_task, &writers[i]));
+    }
+    for (uint8_t i = 0; i < TEST_WRITERS; i++) {
+        pthread_join(writer_threads[i], NULL);
+    }
+    pthread_join(reader_thread, NULL);
+
+    esp_ot_capture_get_stats(stats);
+    uint32_t matched = 0;
+    uint32_t dropped = 0;
+    uint32_t total_read = 0;
+    for (int i = 0; i < ESP_OT_IP_STATS_MAX_NETIFS; i++) {
+        matched += stats[i].matched;
+        dropped += stats[i].dropped;
+    }
+    for (int i = 0; i < TEST_WRITERS; i++) {
+        TEST_ASSERT_EQUAL(TEST_WRITER_PACKETS, writers[i].sent);
+        total_read += read[i];
+    }
+    printf("%u packets, %u read, %u dropped\n", (unsigned)matched, (unsigned)total_read, (unsigned)dropped);
+    TEST_ASSERT_EQUAL(TEST_WRITERS * TEST_WRITER_PACKETS, matched);
+    TEST_ASSERT_EQUAL(matched, total_read + dropped);
+    TEST_ASSERT(total_read > 0);
+    esp_ot_capture_finish(s_buf, sizeof(s_buf));
+}
+
+static void test_command(void)
+{
+    char *stop[] = {"stop"};
+    char *bogus[] = {"bogus"};
+    esp_ot_capture_filter_t filter = any_filter(64);
+
+    TEST_ASSERT_EQUAL(OT_ERROR_NONE, esp_ot_process_capture(NULL, 0, NULL));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_capture_parse_filter("port", "5683", &filter));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_capture_start(&filter));
+    TEST_ASSERT_EQUAL(OT_ERROR_NONE, esp_ot_process_capture(NULL, 0, NULL));
+    TEST_ASSERT_EQUAL(OT_ERROR_INVALID_ARGS, esp_ot_process_capture(NULL, 1, bogus));
+    TEST_ASSERT_EQUAL(OT_ERROR_NONE, esp_ot_process_capture(NULL, 1, stop));
+    TEST_ASSERT_FALSE(esp_ot_capture_is_running());
+    esp_ot_capture_finish(s_buf, sizeof(s_buf));
+}
+
+int main(void)
+{
+    RUN_TEST(test_idle);
+    RUN_TEST(test_pcapng_layout);
+    RUN_TEST(test_parse_filter);
+    RUN_TEST(test_filter);
+    RUN_TEST(test_overflow);
+    RUN_TEST(test_concurrent);
+    RUN_TEST(test_command);
+    return 0;
+}
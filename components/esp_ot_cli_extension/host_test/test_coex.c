@@ -0,0 +1,486 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <arpa/inet.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "esp_openthread.h"
+#include "esp_openthread_lock.h"
+#include "esp_ot_coex.h"
+#include "esp_timer.h"
+#include "host_test.h"
+#include "openthread/link.h"
+#include "openthread/ping_sender.h"
+#include "openthread/platform/radio.h"
+#if CONFIG_OPENTHREAD_RADIO_STATS_ENABLE
+#include "openthread/radio_stats.h"
+#endif
+
+/*
+ * Feeds scripted MAC counters, arbiter metrics and radio times to the coex statistics, and runs the measurement
+ * worker against a ping sender answering at once on the simulated clock. Built with and without the priorities of
+ * the native radio, the test stands in for the 802.15.4 driver in the first case.
+ */
+#define TEST_HAS_PRIORITIES (CONFIG_OPENTHREAD_RADIO_NATIVE && CONFIG_ESP_COEX_SW_COEXIST_ENABLE)
+#if TEST_HAS_PRIORITIES
+#include "esp_ieee802154.h"
+#endif
+
+#define TEST_DEFERRED_LOW 20 /* The deferred transmissions of a measurement round at a low 802.15.4 priority */
+#define TEST_DEFERRED_HIGH 2
+
+static pthread_mutex_t s_ot_lock;
+static otMacCounters s_mac;
+static otRadioCoexMetrics s_metrics;
+static bool s_has_metrics = true;
+#if CONFIG_OPENTHREAD_RADIO_STATS_ENABLE
+static otRadioTimeStats s_time;
+#endif
+
+/* The script of the ping sender */
+static otError s_ping_error = OT_ERROR_NONE;
+static uint16_t s_ping_replies = 100;
+static bool s_ping_hangs = false; /* the statistics never come */
+static int s_ping_rounds = 0;
+static int s_ping_stops = 0;
+#if TEST_HAS_PRIORITIES
+static esp_ieee802154_coex_config_t s_coex_config = {IEEE802154_IDLE, IEEE802154_LOW, IEEE802154_LOW};
+static esp_ieee802154_coex_config_t s_ping_configs[ESP_OT_COEX_MEASURE_MAX_PROFILES];
+#endif
+
+otInstance *esp_openthread_get_instance(void)
+{
+    return (otInstance *)&s_mac;
+}
+
+bool esp_openthread_lock_acquire(TickType_t block_ticks)
+{
+    pthread_mutex_lock(&s_ot_lock);
+    return true;
+}
+
+void esp_openthread_lock_release(void)
+{
+    pthread_mutex_unlock(&s_ot_lock);
+}
+
+const char *otThreadErrorToString(otError error)
+{
+    return error == OT_ERROR_NONE ? "OK" : "Error";
+}
+
+otError otIp6AddressFromString(const char *string, otIp6Address *address)
+{
+    return inet_pton(AF_INET6, string, address->mFields.m8) == 1 ? OT_ERROR_NONE : OT_ERROR_INVALID_ARGS;
+}
+
+const otMacCounters *otLinkGetCounters(otInstance *instance)
+{
+    return &s_mac;
+}
+
+bool otPlatRadioIsCoexEnabled(otInstance *instance)
+{
+    return true;
+}
+
+otError otPlatRadioGetCoexMetrics(otInstance *instance, otRadioCoexMetrics *coex_metrics)
+{
+    if (!s_has_metrics) {
+        return OT_ERROR_NOT_CAPABLE;
+    }
+    *coex_metrics = s_metrics;
+    return OT_ERROR_NONE;
+}
+
+#if CONFIG_OPENTHREAD_RADIO_STATS_ENABLE
+const otRadioTimeStats *otRadioTimeStatsGet(otInstance *instance)
+{
+    return &s_time;
+}
+#endif
+
+#if TEST_HAS_PRIORITIES
+void esp_ieee802154_set_coex_config(esp_ieee802154_coex_config_t config)
+{
+    s_coex_config = config;
+}
+
+esp_ieee802154_coex_config_t esp_ieee802154_get_coex_config(void)
+{
+    return s_coex_config;
+}
+#endif
+
+/* Sends the whole pattern at once: the replies come, the clock and the counters move, then the statistics. */
+otError otPingSenderPing(otInstance *instance, const otPingSenderConfig *config)
+{
+    uint32_t deferred = TEST_DEFERRED_LOW;
+    otPingSenderStatistics statistics;
+
+    if (s_ping_error != OT_ERROR_NONE) {
+        return s_ping_error;
+    }
+    TEST_ASSERT_EQUAL(100, config->mCount);
+    TEST_ASSERT_EQUAL(32, config->mSize);
+#if TEST_HAS_PRIORITIES
+    if (s_ping_rounds < ESP_OT_COEX_MEASURE_MAX_PROFILES) {
+        s_ping_configs[s_ping_rounds] = s_coex_config;
+    }
+    deferred = s_coex_config.txrx == IEEE802154_HIGH ? TEST_DEFERRED_HIGH : TEST_DEFERRED_LOW;
+#endif
+    s_ping_rounds++;
+    for (uint16_t i = 0; i < s_ping_replies; i++) {
+        otPingSenderReply reply = {.mRoundTripTime = 10 + i % 5, .mSize = config->mSize};
+
+        config->mReplyCallback(&reply, config->mCallbackContext);
+    }
+    stub_timer_advance_ms(config->mCount * config->mInterval + config->mTimeout);
+    s_mac.mTxTotal += config->mCount;
+    s_mac.mTxErrCca += deferred;
+    s_mac.mTxErrAbort += 1;
+    s_metrics.mNumTxGrantWaitTimeout += deferred / 2;
+    if (!s_ping_hangs) {
+        memset(&statistics, 0, sizeof(statistics));
+        statistics.mSentCount = config->mCount;
+        statistics.mReceivedCount = s_ping_replies;
+        config->mStatisticsCallback(&statistics, config->mCallbackContext);
+    }
+    return OT_ERROR_NONE;
+}
+
+void otPingSenderStop(otInstance *instance)
+{
+    s_ping_stops++;
+}
+
+static otError command(const char *line)
+{
+    char buf[128];
+    char *args[8];
+    uint8_t count = 0;
+
+    snprintf(buf, sizeof(buf), "%s", line);
+    for (char *arg = strtok(buf, " "); arg != NULL && count < 8; arg = strtok(NULL, " ")) {
+        args[count++] = arg;
+    }
+    return esp_ot_process_coex(NULL, count, args);
+}
+
+static otError measure(const char *line)
+{
+    esp_openthread_lock_acquire(portMAX_DELAY);
+    otError error = command(line);
+    esp_openthread_lock_release();
+    return error;
+}
+
+static esp_ot_coex_measure_state_t measure_wait(esp_ot_coex_result_t *results, uint8_t *count)
+{
+    esp_ot_coex_measure_state_t state = ESP_OT_COEX_MEASURE_RUNNING;
+
+    for (int i = 0; i < 100000 && state == ESP_OT_COEX_MEASURE_RUNNING; i++) {
+        sched_yield();
+        esp_openthread_lock_acquire(portMAX_DELAY);
+        state = esp_ot_coex_measure_get(results, count);
+        esp_openthread_lock_release();
+    }
+    return state;
+}
+
+/* The counters of the window since the last reset, also after the counters restarted from zero. */
+static void test_counter_deltas(void)
+{
+    esp_ot_coex_stats_t stats;
+
+    s_mac.mTxTotal = 1000;
+    s_mac.mTxErrCca = 50;
+    s_mac.mRxTotal = 3000;
+    esp_ot_coex_reset();
+    s_mac.mTxTotal += 200;
+    s_mac.mTxErrCca += 7;
+    s_mac.mTxErrAbort += 2;
+    s_mac.mTxErrBusyChannel += 3;
+    s_mac.mTxRetry += 11;
+    s_mac.mRxTotal += 400;
+    stub_timer_advance_ms(1000);
+    esp_ot_coex_get_stats(&stats);
+    TEST_ASSERT(stats.enabled);
+    TEST_ASSERT(stats.window_ms >= 1000 && stats.window_ms < 1100);
+    TEST_ASSERT_EQUAL(200, stats.tx_frames);
+    TEST_ASSERT_EQUAL(7, stats.tx_deferred);
+    TEST_ASSERT_EQUAL(5, stats.tx_aborted);
+    TEST_ASSERT_EQUAL(11, stats.tx_retries);
+    TEST_ASSERT_EQUAL(400, stats.rx_frames);
+
+    /* `counters mac reset` restarts the counters below the base of the window */
+    memset(&s_mac, 0, sizeof(s_mac));
+    s_mac.mTxTotal = 30;
+    s_mac.mTxErrCca = 4;
+    esp_ot_coex_get_stats(&stats);
+    TEST_ASSERT_EQUAL(30, stats.tx_frames);
+    TEST_ASSERT_EQUAL(4, stats.tx_deferred);
+    TEST_ASSERT_EQUAL(0, stats.rx_frames);
+}
+
+/* The grants and denials of the arbiter, and the average grant wait of the grants in the window only. */
+static void test_grants(void)
+{
+    esp_ot_coex_stats_t stats;
+
+    memset(&s_metrics, 0, sizeof(s_metrics));
+    s_metrics.mNumTxRequest = 10;
+    s_metrics.mNumTxGrantImmediate = 8;
+    s_metrics.mNumTxGrantWaitActivated = 2;
+    s_metrics.mAvgTxRequestToGrantTime = 100;
+    s_metrics.mNumRxRequest = 5;
+    s_metrics.mNumRxGrantImmediate = 5;
+    s_metrics.mAvgRxRequestToGrantTime = 40;
+    esp_ot_coex_reset();
+
+    s_metrics.mNumTxRequest = 25;
+    s_metrics.mNumTxGrantImmediate = 14;
+    s_metrics.mNumTxGrantWaitActivated = 6;
+    s_metrics.mNumTxGrantWaitTimeout = 3;
+    s_metrics.mNumTxGrantDeactivatedDuringRequest = 2;
+    s_metrics.mAvgTxRequestToGrantTime = 200; /* 4000 us over 20 grants, 3000 us over the last 10 */
+    s_metrics.mNumRxRequest = 9;
+    s_metrics.mNumRxGrantImmediate = 5;
+    s_metrics.mNumRxGrantNone = 4;
+    esp_ot_coex_get_stats(&stats);
+    TEST_ASSERT(stats.has_grants);
+    TEST_ASSERT_EQUAL(15, stats.tx_requests);
+    TEST_ASSERT_EQUAL(10, stats.tx_granted);
+    TEST_ASSERT_EQUAL(5, stats.tx_denied);
+    TEST_ASSERT_EQUAL(300, stats.tx_grant_wait_us);
+    TEST_ASSERT_EQUAL(4, stats.rx_requests);
+    TEST_ASSERT_EQUAL(0, stats.rx_granted);
+    TEST_ASSERT_EQUAL(4, stats.rx_denied);
+    TEST_ASSERT_EQUAL(0, stats.rx_grant_wait_us); /* no grant in the window */
+
+    /* Metrics restarted below the base: the average is the one since the restart */
+    s_metrics.mNumTxGrantImmediate = 3;
+    s_metrics.mNumTxGrantWaitActivated = 0;
+    s_metrics.mAvgTxRequestToGrantTime = 50;
+    esp_ot_coex_get_stats(&stats);
+    TEST_ASSERT_EQUAL(50, stats.tx_grant_wait_us);
+
+    s_has_metrics = false;
+    esp_ot_coex_get_stats(&stats);
+    TEST_ASSERT_FALSE(stats.has_grants);
+    TEST_ASSERT_EQUAL(0, stats.tx_requests);
+    s_has_metrics = true;
+}
+
+/* The share of each state of the 802.15.4 radio in the window, in permille. */
+static void test_air_time(void)
+{
+    esp_ot_coex_stats_t stats;
+
+#if CONFIG_OPENTHREAD_RADIO_STATS_ENABLE
+    s_time.mTxTime = 5000;
+    s_time.mSleepTime = 90000;
+    esp_ot_coex_reset();
+    esp_ot_coex_get_stats(&stats);
+    TEST_ASSERT_FALSE(stats.has_air_time); /* an empty window */
+
+    s_time.mTxTime += 100000;
+    s_time.mRxTime += 250000;
+    s_time.mSleepTime += 600000;
+    s_time.mDisabledTime += 50000;
+    esp_ot_coex_get_stats(&stats);
+    TEST_ASSERT(stats.has_air_time);
+    TEST_ASSERT_EQUAL(100, stats.tx_permille);
+    TEST_ASSERT_EQUAL(250, stats.rx_permille);
+    TEST_ASSERT_EQUAL(600, stats.sleep_permille);
+#else
+    esp_ot_coex_get_stats(&stats);
+    TEST_ASSERT_FALSE(stats.has_air_time);
+#endif
+}
+
+static void test_names(void)
+{
+    TEST_ASSERT_EQUAL(ESP_OT_COEX_PROFILE_WIFI, esp_ot_coex_profile_parse("wifi"));
+    TEST_ASSERT_EQUAL(ESP_OT_COEX_PROFILE_BALANCE, esp_ot_coex_profile_parse("balance"));
+    TEST_ASSERT_EQUAL(ESP_OT_COEX_PROFILE_THREAD, esp_ot_coex_profile_parse("thread"));
+    TEST_ASSERT_EQUAL(ESP_OT_COEX_PROFILES, esp_ot_coex_profile_parse("custom")); /* not a profile to set */
+    TEST_ASSERT_EQUAL(0, strcmp("custom", esp_ot_coex_profile_name(ESP_OT_COEX_PROFILE_CUSTOM)));
+    TEST_ASSERT_EQUAL(0, strcmp("unknown", esp_ot_coex_profile_name(ESP_OT_COEX_PROFILES)));
+    TEST_ASSERT_EQUAL(ESP_OT_COEX_PRIORITY_MIDDLE, esp_ot_coex_priority_parse("middle"));
+    TEST_ASSERT_EQUAL(ESP_OT_COEX_PRIORITIES, esp_ot_coex_priority_parse("top"));
+    TEST_ASSERT_EQUAL(0, strcmp("idle", esp_ot_coex_priority_name(ESP_OT_COEX_PRIORITY_IDLE)));
+    TEST_ASSERT_EQUAL(0, strcmp("done", esp_ot_coex_measure_state_name(ESP_OT_COEX_MEASURE_DONE)));
+    TEST_ASSERT_EQUAL(OT_ERROR_NOT_CAPABLE, esp_ot_coex_error_to_ot_error(ESP_ERR_NOT_SUPPORTED));
+    TEST_ASSERT_EQUAL(OT_ERROR_INVALID_STATE, esp_ot_coex_error_to_ot_error(ESP_ERR_INVALID_STATE));
+    TEST_ASSERT_EQUAL(OT_ERROR_FAILED, esp_ot_coex_error_to_ot_error(ESP_ERR_NO_MEM));
+}
+
+/* The profiles and the priorities set through the command, only with the priorities of the native radio. */
+static void test_profiles(void)
+{
+    esp_ot_coex_priorities_t priorities;
+
+    TEST_ASSERT_EQUAL(OT_ERROR_INVALID_ARGS, command("priority high low top"));
+    TEST_ASSERT_EQUAL(OT_ERROR_INVALID_ARGS, command("priority high low"));
+    TEST_ASSERT_EQUAL(OT_ERROR_INVALID_ARGS, command("profile zigbee"));
+#if TEST_HAS_PRIORITIES
+    TEST_ASSERT_EQUAL(ESP_OT_COEX_PROFILE_WIFI, esp_ot_coex_get_priorities(&priorities));
+    TEST_ASSERT_EQUAL(OT_ERROR_NONE, command("profile thread"));
+    TEST_ASSERT_EQUAL(IEEE802154_LOW, s_coex_config.idle);
+    TEST_ASSERT_EQUAL(IEEE802154_HIGH, s_coex_config.txrx);
+    TEST_ASSERT_EQUAL(IEEE802154_HIGH, s_coex_config.txrx_at);
+    TEST_ASSERT_EQUAL(ESP_OT_COEX_PROFILE_THREAD, esp_ot_coex_get_priorities(&priorities));
+    TEST_ASSERT_EQUAL(OT_ERROR_NONE, command("priority idle middle high"));
+    TEST_ASSERT_EQUAL(ESP_OT_COEX_PROFILE_CUSTOM, esp_ot_coex_get_priorities(&priorities));
+    TEST_ASSERT_EQUAL(ESP_OT_COEX_PRIORITY_MIDDLE, priorities.txrx);
+    TEST_ASSERT_EQUAL(IEEE802154_MIDDLE, s_coex_config.txrx);
+    TEST_ASSERT_EQUAL(OT_ERROR_NONE, command("profile balance"));
+    TEST_ASSERT_EQUAL(OT_ERROR_NONE, command("profile"));
+#else
+    TEST_ASSERT_EQUAL(ESP_OT_COEX_PROFILES, esp_ot_coex_get_priorities(&priorities));
+    TEST_ASSERT_EQUAL(OT_ERROR_NOT_CAPABLE, command("profile thread"));
+    TEST_ASSERT_EQUAL(OT_ERROR_NOT_CAPABLE, command("priority idle middle high"));
+    TEST_ASSERT_EQUAL(OT_ERROR_NOT_CAPABLE, command("profile"));
+#endif
+    TEST_ASSERT_EQUAL(OT_ERROR_NONE, command(""));
+}
+
+/*
+ * A measurement of two profiles runs each one under its priorities and restores the previous ones, without the
+ * priorities the ones in use are measured once.
+ */
+static void test_measure(void)
+{
+    esp_ot_coex_result_t results[ESP_OT_COEX_MEASURE_MAX_PROFILES];
+    uint8_t count = 0;
+
+    TEST_ASSERT_EQUAL(OT_ERROR_INVALID_ARGS, measure("measure ff03::1"));
+    TEST_ASSERT_EQUAL(OT_ERROR_INVALID_ARGS, measure("measure fd00::1 zigbee"));
+    TEST_ASSERT_EQUAL(OT_ERROR_INVALID_ARGS, measure("measure nowhere"));
+#if TEST_HAS_PRIORITIES
+    esp_ieee802154_coex_config_t saved = s_coex_config;
+
+    s_ping_rounds = 0;
+    TEST_ASSERT_EQUAL(OT_ERROR_NONE, measure("measure fd00::1 wifi thread"));
+    TEST_ASSERT_EQUAL(ESP_OT_COEX_MEASURE_DONE, measure_wait(results, &count));
+    TEST_ASSERT_EQUAL(2, count);
+    TEST_ASSERT_EQUAL(2, s_ping_rounds);
+    TEST_ASSERT_EQUAL(IEEE802154_LOW, s_ping_configs[0].txrx);
+    TEST_ASSERT_EQUAL(IEEE802154_HIGH, s_ping_configs[1].txrx);
+    TEST_ASSERT_EQUAL(0, memcmp(&saved, &s_coex_config, sizeof(saved)));
+    TEST_ASSERT_EQUAL(ESP_OT_COEX_PROFILE_WIFI, results[0].profile);
+    TEST_ASSERT_EQUAL(TEST_DEFERRED_LOW, results[0].tx_deferred);
+    TEST_ASSERT_EQUAL(TEST_DEFERRED_LOW / 2, results[0].tx_denied);
+    TEST_ASSERT_EQUAL(ESP_OT_COEX_PROFILE_THREAD, results[1].profile);
+    TEST_ASSERT_EQUAL(TEST_DEFERRED_HIGH, results[1].tx_deferred);
+    TEST_ASSERT_EQUAL(TEST_DEFERRED_HIGH / 2, results[1].tx_denied);
+#else
+    TEST_ASSERT_EQUAL(OT_ERROR_NOT_CAPABLE, measure("measure fd00::1 wifi"));
+    s_ping_rounds = 0;
+    TEST_ASSERT_EQUAL(OT_ERROR_NONE, measure("measure fd00::1"));
+    TEST_ASSERT_EQUAL(ESP_OT_COEX_MEASURE_DONE, measure_wait(results, &count));
+    TEST_ASSERT_EQUAL(1, count);
+    TEST_ASSERT_EQUAL(ESP_OT_COEX_PROFILES, results[0].profile);
+    TEST_ASSERT_EQUAL(TEST_DEFERRED_LOW, results[0].tx_deferred);
+#endif
+    for (uint8_t i = 0; i < count; i++) {
+        TEST_ASSERT_EQUAL(100, results[i].sent);
+        TEST_ASSERT_EQUAL(100, results[i].received);
+        TEST_ASSERT_EQUAL(10, results[i].rtt_min_ms);
+        TEST_ASSERT_EQUAL(12, results[i].rtt_avg_ms);
+        TEST_ASSERT_EQUAL(14, results[i].rtt_max_ms);
+        TEST_ASSERT_EQUAL(1, results[i].tx_aborted);
+        /* 100 echoes of 32 bytes both ways over the 6 s of the pattern and its timeout */
+        TEST_ASSERT(results[i].throughput_bps > 8400 && results[i].throughput_bps <= 8533);
+    }
+    TEST_ASSERT_EQUAL(OT_ERROR_NONE, measure("measure"));
+}
+
+/* A measurement is refused while one runs, and so are the priorities it sets. */
+static void test_measure_running(void)
+{
+    esp_ot_coex_result_t results[ESP_OT_COEX_MEASURE_MAX_PROFILES];
+    esp_ot_coex_priorities_t priorities = {0};
+    uint8_t count = 0;
+
+    esp_openthread_lock_acquire(portMAX_DELAY);
+    TEST_ASSERT_EQUAL(OT_ERROR_NONE, command("measure fd00::1"));
+    /* The worker waits for the lock held here */
+    TEST_ASSERT_EQUAL(OT_ERROR_INVALID_STATE, command("measure fd00::1"));
+#if TEST_HAS_PRIORITIES
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, esp_ot_coex_set_priorities(&priorities));
+#else
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_SUPPORTED, esp_ot_coex_set_priorities(&priorities));
+#endif
+    esp_openthread_lock_release();
+    TEST_ASSERT_EQUAL(ESP_OT_COEX_MEASURE_DONE, measure_wait(results, &count));
+    TEST_ASSERT_EQUAL(1, count);
+}
+
+/* The statistics of the ping sender never come: it is stopped, and the whole pattern counts as sent. */
+static void test_measure_timeout(void)
+{
+    esp_ot_coex_result_t results[ESP_OT_COEX_MEASURE_MAX_PROFILES];
+    uint8_t count = 0;
+
+    s_ping_hangs = true;
+    s_ping_replies = 40;
+    s_ping_stops = 0;
+    TEST_ASSERT_EQUAL(OT_ERROR_NONE, measure("measure fd00::1"));
+    TEST_ASSERT_EQUAL(ESP_OT_COEX_MEASURE_DONE, measure_wait(results, &count));
+    TEST_ASSERT_EQUAL(1, s_ping_stops);
+    TEST_ASSERT_EQUAL(1, count);
+    TEST_ASSERT_EQUAL(100, results[0].sent);
+    TEST_ASSERT_EQUAL(40, results[0].received);
+    s_ping_hangs = false;
+    s_ping_replies = 100;
+}
+
+/* The ping sender is busy: no result, and the priorities are restored. */
+static void test_measure_busy(void)
+{
+    esp_ot_coex_result_t results[ESP_OT_COEX_MEASURE_MAX_PROFILES];
+    uint8_t count = 0;
+
+    s_ping_error = OT_ERROR_BUSY;
+#if TEST_HAS_PRIORITIES
+    esp_ieee802154_coex_config_t saved = s_coex_config;
+
+    TEST_ASSERT_EQUAL(OT_ERROR_NONE, measure("measure fd00::1 thread wifi"));
+    TEST_ASSERT_EQUAL(ESP_OT_COEX_MEASURE_DONE, measure_wait(results, &count));
+    TEST_ASSERT_EQUAL(0, memcmp(&saved, &s_coex_config, sizeof(saved)));
+#else
+    TEST_ASSERT_EQUAL(OT_ERROR_NONE, measure("measure fd00::1"));
+    TEST_ASSERT_EQUAL(ESP_OT_COEX_MEASURE_DONE, measure_wait(results, &count));
+#endif
+    TEST_ASSERT_EQUAL(0, count);
+    s_ping_error = OT_ERROR_NONE;
+}
+
+int main(void)
+{
+    pthread_mutexattr_t attr;
+
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&s_ot_lock, &attr);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_coex_init());
+    RUN_TEST(test_counter_deltas);
+    RUN_TEST(test_grants);
+    RUN_TEST(test_air_time);
+    RUN_TEST(test_names);
+    RUN_TEST(test_profiles);
+    RUN_TEST(test_measure);
+    RUN_TEST(test_measure_running);
+    RUN_TEST(test_measure_timeout);
+    RUN_TEST(test_measure_busy);
+    return 0;
+}
@@ -0,0 +1,334 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "esp_openthread.h"
+#include "esp_openthread_lock.h"
+#include "esp_ot_dns_pool.h"
+#include "host_test.h"
+#include "lwip/sockets.h"
+#include "sdkconfig.h"
+
+/*
+ * Records scripted probe results and checks the RTT and failure EWMAs, the health of the servers and the promotions
+ * of the main server with their decisions. The probe task sleeps for the whole test. The tests share the pool and run
+ * in order, each one starts from the servers and the main server the previous ones left.
+ */
+#define FAILED ESP_OT_DNS_POOL_PROBE_FAILED
+#define NONE ESP_OT_DNS_POOL_NO_SERVER
+
+static uint32_t s_server_a;
+static uint32_t s_server_b;
+static uint32_t s_server_c;
+static uint32_t s_server_d;
+static uint32_t s_applied = NONE;
+static int s_apply_count;
+static uint32_t s_now = 100;
+
+otInstance *esp_openthread_get_instance(void)
+{
+    return NULL;
+}
+
+bool esp_openthread_lock_acquire(TickType_t block_ticks)
+{
+    return true;
+}
+
+void esp_openthread_lock_release(void)
+{
+}
+
+uint32_t esp_random(void)
+{
+    return 0x1234;
+}
+
+static esp_err_t apply_main(uint32_t addr)
+{
+    s_applied = addr;
+    s_apply_count++;
+    return ESP_OK;
+}
+
+static void probe(uint32_t addr, uint16_t rtt_ms)
+{
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_dns_pool_record_probe(addr, rtt_ms, ++s_now));
+}
+
+static esp_ot_dns_pool_server_t get_server(uint32_t addr)
+{
+    esp_ot_dns_pool_server_t servers[CONFIG_OPENTHREAD_DNS_POOL_MAX_SERVERS];
+    uint8_t count = esp_ot_dns_pool_get_servers(servers, CONFIG_OPENTHREAD_DNS_POOL_MAX_SERVERS);
+
+    for (uint8_t i = 0; i < count; i++) {
+        if (servers[i].addr == addr) {
+            return servers[i];
+        }
+    }
+    TEST_ASSERT_MESSAGE(false, "the server is not in the pool");
+    return servers[0];
+}
+
+static uint32_t get_main(void)
+{
+    esp_ot_dns_pool_server_t servers[CONFIG_OPENTHREAD_DNS_POOL_MAX_SERVERS];
+    uint8_t count = esp_ot_dns_pool_get_servers(servers, CONFIG_OPENTHREAD_DNS_POOL_MAX_SERVERS);
+    uint32_t main_addr = NONE;
+
+    for (uint8_t i = 0; i < count; i++) {
+        if (servers[i].main) {
+            TEST_ASSERT_EQUAL(NONE, main_addr);
+            main_addr = servers[i].addr;
+        }
+    }
+    return main_addr;
+}
+
+static uint8_t decision_count(void)
+{
+    esp_ot_dns_pool_decision_t decisions[ESP_OT_DNS_POOL_DECISION_NUM];
+
+    return esp_ot_dns_pool_get_decisions(decisions, ESP_OT_DNS_POOL_DECISION_NUM);
+}
+
+static void check_last_decision(esp_ot_dns_pool_reason_t reason, uint32_t from, uint32_t to, uint32_t to_rtt_ms)
+{
+    esp_ot_dns_pool_decision_t decision;
+
+    TEST_ASSERT_EQUAL(1, esp_ot_dns_pool_get_decisions(&decision, 1));
+    TEST_ASSERT_EQUAL(reason, decision.reason);
+    TEST_ASSERT_EQUAL(from, decision.from);
+    TEST_ASSERT_EQUAL(to, decision.to);
+    TEST_ASSERT_EQUAL(to_rtt_ms, decision.to_rtt_ms);
+    TEST_ASSERT_EQUAL(s_now, decision.time);
+}
+
+static void test_add_remove(void)
+{
+    uint32_t server_e = inet_addr("1.0.0.1");
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_dns_pool_add(s_server_a));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_dns_pool_add(s_server_b));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_dns_pool_add(s_server_c));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_dns_pool_add(s_server_d));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_dns_pool_add(s_server_a)); /* already in the pool */
+    TEST_ASSERT_EQUAL(ESP_ERR_NO_MEM, esp_ot_dns_pool_add(server_e));
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, esp_ot_dns_pool_remove(server_e, s_now));
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, esp_ot_dns_pool_record_probe(server_e, 10, s_now));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_dns_pool_remove(s_server_d, s_now));
+
+    esp_ot_dns_pool_server_t servers[CONFIG_OPENTHREAD_DNS_POOL_MAX_SERVERS];
+    TEST_ASSERT_EQUAL(3, esp_ot_dns_pool_get_servers(servers, CONFIG_OPENTHREAD_DNS_POOL_MAX_SERVERS));
+    TEST_ASSERT_EQUAL(NONE, get_main());
+    TEST_ASSERT_FALSE(get_server(s_server_a).healthy);
+    TEST_ASSERT_EQUAL(0, decision_count());
+}
+
+/* The first server answering is promoted, its first RTT is taken as is and then smoothed by 1/8. */
+static void test_first_promotion(void)
+{
+    probe(s_server_a, 50);
+    TEST_ASSERT_EQUAL(s_server_a, get_main());
+    TEST_ASSERT_EQUAL(s_server_a, s_applied);
+    TEST_ASSERT_EQUAL(1, s_apply_count);
+    check_last_decision(ESP_OT_DNS_POOL_REASON_FIRST, NONE, s_server_a, 50);
+
+    probe(s_server_a, 58); /* 50 * 8 - 50 + 58 = 408 eighths, 51 ms */
+    esp_ot_dns_pool_server_t server = get_server(s_server_a);
+    TEST_ASSERT_EQUAL(51, server.rtt_ms);
+    TEST_ASSERT(server.healthy);
+    TEST_ASSERT_EQUAL(2, server.probes);
+    TEST_ASSERT_EQUAL(0, server.failure_permille);
+    TEST_ASSERT_EQUAL(s_now, server.last_probe);
+    TEST_ASSERT_EQUAL(2, server.history_len);
+    TEST_ASSERT_EQUAL(50, server.history[0]);
+    TEST_ASSERT_EQUAL(58, server.history[1]);
+    TEST_ASSERT_EQUAL(1, decision_count());
+}
+
+/* A faster server is promoted only below 80% of the RTT of the main server, 40.8 ms for 51 ms. */
+static void test_hysteresis(void)
+{
+    probe(s_server_b, 45);
+    TEST_ASSERT_EQUAL(s_server_a, get_main());
+    TEST_ASSERT_EQUAL(1, decision_count());
+
+    probe(s_server_c, 40);
+    TEST_ASSERT_EQUAL(s_server_c, get_main());
+    TEST_ASSERT_EQUAL(s_server_c, s_applied);
+    check_last_decision(ESP_OT_DNS_POOL_REASON_FASTER, s_server_a, s_server_c, 40);
+}
+
+/* The failure EWMA of 1/4 goes 250, 437 and 577 permille, the third consecutive failure demotes the server first. */
+static void test_demotion(void)
+{
+    probe(s_server_c, FAILED);
+    probe(s_server_c, FAILED);
+    esp_ot_dns_pool_server_t server = get_server(s_server_c);
+    TEST_ASSERT(server.healthy);
+    TEST_ASSERT_EQUAL(437, server.failure_permille);
+    TEST_ASSERT_EQUAL(2, server.consecutive_failures);
+    TEST_ASSERT_EQUAL(40, server.rtt_ms); /* the failures leave the RTT */
+    TEST_ASSERT_EQUAL(s_server_c, get_main());
+
+    probe(s_server_c, FAILED);
+    server = get_server(s_server_c);
+    TEST_ASSERT_FALSE(server.healthy);
+    TEST_ASSERT_EQUAL(3, server.failures);
+    TEST_ASSERT_EQUAL(s_server_b, get_main());
+    check_last_decision(ESP_OT_DNS_POOL_REASON_UNHEALTHY, s_server_c, s_server_b, 45);
+    TEST_ASSERT_EQUAL(FAILED, server.history[3]);
+}
+
+/* A success clears the consecutive failures, the recovered server is not faster than the main one by 20%. */
+static void test_recovery(void)
+{
+    probe(s_server_c, 35); /* 40 * 8 - 40 + 35 = 315 eighths, 39 ms, and 577 - 144 permille */
+    esp_ot_dns_pool_server_t server = get_server(s_server_c);
+    TEST_ASSERT(server.healthy);
+    TEST_ASSERT_EQUAL(0, server.consecutive_failures);
+    TEST_ASSERT_EQUAL(433, server.failure_permille);
+    TEST_ASSERT_EQUAL(39, server.rtt_ms);
+    TEST_ASSERT_EQUAL(s_server_b, get_main());
+    TEST_ASSERT_EQUAL(3, decision_count());
+}
+
+static void test_remove_main(void)
+{
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_dns_pool_remove(s_server_b, ++s_now));
+    TEST_ASSERT_EQUAL(s_server_c, get_main());
+    TEST_ASSERT_EQUAL(s_server_c, s_applied);
+    check_last_decision(ESP_OT_DNS_POOL_REASON_REMOVED, s_server_b, s_server_c, 39);
+}
+
+/* A dead main server is kept while no other server answers, and is replaced by none only when removed. */
+static void test_no_healthy_server(void)
+{
+    int apply_count = s_apply_count;
+
+    probe(s_server_a, FAILED);
+    probe(s_server_a, FAILED);
+    probe(s_server_a, FAILED);
+    TEST_ASSERT_FALSE(get_server(s_server_a).healthy);
+    probe(s_server_c, FAILED); /* 433 + 141 permille, above the half */
+    TEST_ASSERT_FALSE(get_server(s_server_c).healthy);
+    TEST_ASSERT_EQUAL(574, get_server(s_server_c).failure_permille);
+    TEST_ASSERT_EQUAL(s_server_c, get_main());
+    TEST_ASSERT_EQUAL(4, decision_count());
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_dns_pool_remove(s_server_c, ++s_now));
+    TEST_ASSERT_EQUAL(NONE, get_main());
+    TEST_ASSERT_EQUAL(apply_count, s_apply_count);
+    check_last_decision(ESP_OT_DNS_POOL_REASON_REMOVED, s_server_c, NONE, 0);
+
+    probe(s_server_a, 60); /* 577 - 144 = 433 permille, below the half */
+    TEST_ASSERT(get_server(s_server_a).healthy);
+    TEST_ASSERT_EQUAL(s_server_a, get_main());
+    check_last_decision(ESP_OT_DNS_POOL_REASON_FIRST, NONE, s_server_a, 52);
+}
+
+/* A main server set by hand is kept whatever the probes, until the pool promotes again. */
+static void test_pin(void)
+{
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_dns_pool_add(s_server_b));
+    esp_ot_dns_pool_pin(s_server_d, ++s_now);
+    TEST_ASSERT_EQUAL(s_server_d, esp_ot_dns_pool_get_pinned());
+    TEST_ASSERT_EQUAL(NONE, get_main()); /* the pinned server is not in the pool */
+    check_last_decision(ESP_OT_DNS_POOL_REASON_MANUAL, s_server_a, s_server_d, 0);
+    esp_ot_dns_pool_pin(s_server_d, ++s_now); /* the same server is no new decision */
+    TEST_ASSERT_EQUAL(7, decision_count());
+
+    probe(s_server_b, 10);
+    TEST_ASSERT_EQUAL(NONE, get_main());
+
+    esp_ot_dns_pool_unpin(++s_now);
+    TEST_ASSERT_EQUAL(NONE, esp_ot_dns_pool_get_pinned());
+    TEST_ASSERT_EQUAL(s_server_b, get_main());
+    TEST_ASSERT_EQUAL(s_server_b, s_applied);
+    check_last_decision(ESP_OT_DNS_POOL_REASON_FIRST, s_server_d, s_server_b, 10);
+}
+
+/* The decisions are listed from the newest, the oldest are dropped beyond ESP_OT_DNS_POOL_DECISION_NUM. */
+static void test_decisions(void)
+{
+    static const esp_ot_dns_pool_reason_t expected[] = {
+        ESP_OT_DNS_POOL_REASON_MANUAL,    ESP_OT_DNS_POOL_REASON_FIRST,  ESP_OT_DNS_POOL_REASON_MANUAL,
+        ESP_OT_DNS_POOL_REASON_FIRST,     ESP_OT_DNS_POOL_REASON_REMOVED, ESP_OT_DNS_POOL_REASON_REMOVED,
+        ESP_OT_DNS_POOL_REASON_UNHEALTHY, ESP_OT_DNS_POOL_REASON_FASTER,
+    };
+    esp_ot_dns_pool_decision_t decisions[ESP_OT_DNS_POOL_DECISION_NUM];
+
+    TEST_ASSERT_EQUAL(ESP_OT_DNS_POOL_DECISION_NUM, decision_count());
+    esp_ot_dns_pool_pin(s_server_c, ++s_now);
+    TEST_ASSERT_EQUAL(ESP_OT_DNS_POOL_DECISION_NUM,
+                      esp_ot_dns_pool_get_decisions(decisions, ESP_OT_DNS_POOL_DECISION_NUM));
+    for (uint8_t i = 0; i < ESP_OT_DNS_POOL_DECISION_NUM; i++) {
+        TEST_ASSERT_EQUAL(expected[i], decisions[i].reason);
+    }
+    TEST_ASSERT_EQUAL(s_server_c, decisions[0].to);
+    TEST_ASSERT_EQUAL(2, esp_ot_dns_pool_get_decisions(decisions, 2));
+    esp_ot_dns_pool_unpin(++s_now);
+}
+
+/* The history keeps the last CONFIG_OPENTHREAD_DNS_POOL_HISTORY_SIZE probes from the oldest. */
+static void test_history_wraparound(void)
+{
+    for (int i = 0; i < CONFIG_OPENTHREAD_DNS_POOL_HISTORY_SIZE + 5; i++) {
+        probe(s_server_a, i % 7 == 6 ? FAILED : 100 + i);
+    }
+    esp_ot_dns_pool_server_t server = get_server(s_server_a);
+    TEST_ASSERT_EQUAL(CONFIG_OPENTHREAD_DNS_POOL_HISTORY_SIZE, server.history_len);
+    for (int i = 0; i < CONFIG_OPENTHREAD_DNS_POOL_HISTORY_SIZE; i++) {
+        int probe_index = i + 5;
+        TEST_ASSERT_EQUAL(probe_index % 7 == 6 ? FAILED : 100 + probe_index, server.history[i]);
+    }
+}
+
+static void test_command(void)
+{
+    char add[] = "add", remove[] = "remove", bogus[] = "bogus", zero[] = "0.0.0.0", name[] = "dns.example";
+    char unknown[] = "7.7.7.7";
+    char *args_zero[] = {add, zero};
+    char *args_name[] = {add, name};
+    char *args_unknown[] = {remove, unknown};
+    char *args_bogus[] = {bogus};
+
+    TEST_ASSERT_EQUAL(OT_ERROR_INVALID_ARGS, esp_ot_dns_pool_process(2, args_zero));
+    TEST_ASSERT_EQUAL(OT_ERROR_INVALID_ARGS, esp_ot_dns_pool_process(2, args_name));
+    TEST_ASSERT_EQUAL(OT_ERROR_INVALID_ARGS, esp_ot_dns_pool_process(1, args_zero));
+    TEST_ASSERT_EQUAL(OT_ERROR_NOT_FOUND, esp_ot_dns_pool_process(2, args_unknown));
+    TEST_ASSERT_EQUAL(OT_ERROR_INVALID_ARGS, esp_ot_dns_pool_process(1, args_bogus));
+
+    args_unknown[0] = add;
+    TEST_ASSERT_EQUAL(OT_ERROR_NONE, esp_ot_dns_pool_process(2, args_unknown));
+    args_unknown[0] = remove;
+    TEST_ASSERT_EQUAL(OT_ERROR_NONE, esp_ot_dns_pool_process(2, args_unknown));
+}
+
+int main(void)
+{
+    s_server_a = inet_addr("1.1.1.1");
+    s_server_b = inet_addr("8.8.8.8");
+    s_server_c = inet_addr("9.9.9.9");
+    s_server_d = inet_addr("208.67.222.222");
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, esp_ot_dns_pool_add(s_server_a));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_dns_pool_init(apply_main));
+    RUN_TEST(test_add_remove);
+    RUN_TEST(test_first_promotion);
+    RUN_TEST(test_hysteresis);
+    RUN_TEST(test_demotion);
+    RUN_TEST(test_recovery);
+    RUN_TEST(test_remove_main);
+    RUN_TEST(test_no_healthy_server);
+    RUN_TEST(test_pin);
+    RUN_TEST(test_decisions);
+    RUN_TEST(test_history_wraparound);
+    RUN_TEST(test_command);
+    return 0;
+}
@@ -0,0 +1,291 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "esp_ot_dns_cache.h"
+#include "esp_timer.h"
+#include "host_test.h"
+#include "sdkconfig.h"
+
+/*
+ * The resolver runs in its own thread on the loopback, in front of a stub upstream server answered by the test. The
+ * NAT64 prefix of the stubs is ::ffff:0:0/96, so the upstream servers 127.0.0.1 and 127.0.0.2 are reached over IPv4.
+ */
+#define TEST_MESSAGE_MAX 512
+#define TEST_RECV_TIMEOUT_MS 1000
+#define TEST_SILENCE_MS 300
+#define TEST_POLL_WAIT_MS 800 /* longer than the poll of the resolver */
+
+static int s_upstream = -1;
+static int s_other_upstream = -1;
+static struct sockaddr_in s_upstream_peer;
+static int s_client = -1;
+
+static void sleep_ms(uint32_t ms)
+{
+    struct timespec delay = {.tv_sec = ms / 1000, .tv_nsec = (long)(ms % 1000) * 1000000};
+    nanosleep(&delay, NULL);
+}
+
+static void set_timeout(int sock, uint32_t ms)
+{
+    struct timeval timeout = {.tv_sec = ms / 1000, .tv_usec = (ms % 1000) * 1000};
+    TEST_ASSERT_EQUAL(0, setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)));
+}
+
+static uint16_t make_query(uint8_t *buf, uint16_t id, const char *name, uint16_t qtype)
+{
+    uint16_t len = 12;
+
+    memset(buf, 0, len);
+    buf[0] = id >> 8;
+    buf[1] = id & 0xff;
+    buf[2] = 0x01; /* RD */
+    buf[5] = 1;
+    while (*name) {
+        const char *dot = strchr(name, '.');
+        size_t label = dot ? (size_t)(dot - name) : strlen(name);
+        buf[len++] = label;
+        memcpy(buf + len, name, label);
+        len += label;
+        name += label + (dot ? 1 : 0);
+    }
+    buf[len++] = 0;
+    buf[len++] = qtype >> 8;
+    buf[len++] = qtype & 0xff;
+    buf[len++] = 0;
+    buf[len++] = 1; /* IN */
+    return len;
+}
+
+/* Answer a query with records of its type pointing at its name, no record for a NOERROR without answers. */
+static uint16_t make_response(uint8_t *buf, const uint8_t *query, uint16_t query_len, const uint8_t *rdata,
+                              uint16_t rdlength, uint32_t ttl)
+{
+    memcpy(buf, query, query_len);
+    buf[2] = 0x81; /* QR and RD */
+    buf[3] = 0x80; /* RA */
+    buf[7] = rdata ? 1 : 0;
+    if (!rdata) {
+        return query_len;
+    }
+    uint8_t *record = buf + query_len;
+    record[0] = 0xc0;
+    record[1] = 12;
+    memcpy(record + 2, query + query_len - 4, 4); /* the type and the class */
+    record[6] = ttl >> 24;
+    record[7] = ttl >> 16;
+    record[8] = ttl >> 8;
+    record[9] = ttl;
+    record[10] = rdlength >> 8;
+    record[11] = rdlength & 0xff;
+    memcpy(record + 12, rdata, rdlength);
+    return query_len + 12 + rdlength;
+}
+
+static uint16_t message_qtype(const uint8_t *message, int len)
+{
+    return (message[len - 4] << 8) | message[len - 3];
+}
+
+static void client_send(const uint8_t *query, uint16_t len)
+{
+    struct sockaddr_in6 resolver = {
+        .sin6_family = AF_INET6,
+        .sin6_port = htons(CONFIG_OPENTHREAD_DNS_CACHE_PORT),
+        .sin6_addr = IN6ADDR_LOOPBACK_INIT,
+    };
+    TEST_ASSERT_EQUAL(len, sendto(s_client, query, len, 0, (struct sockaddr *)&resolver, sizeof(resolver)));
+}
+
+static int upstream_recv(int upstream, uint8_t *buf, uint32_t timeout_ms)
+{
+    socklen_t socklen = sizeof(s_upstream_peer);
+
+    set_timeout(upstream, timeout_ms);
+    return recvfrom(upstream, buf, TEST_MESSAGE_MAX, 0, (struct sockaddr *)&s_upstream_peer, &socklen);
+}
+
+static void upstream_send(int upstream, const uint8_t *response, uint16_t len)
+{
+    TEST_ASSERT_EQUAL(len, sendto(upstream, response, len, 0, (struct sockaddr *)&s_upstream_peer,
+                                  sizeof(s_upstream_peer)));
+}
+
+/* Resolve a name through the upstream server, which answers with a AAAA record. */
+static void resolve_aaaa(const char *name, uint32_t ttl)
+{
+    static const uint8_t s_address[16] = {0x20, 0x01, 0x0d, 0xb8, [15] = 1};
+    uint8_t query[TEST_MESSAGE_MAX];
+    uint8_t upstream[TEST_MESSAGE_MAX];
+    uint8_t response[TEST_MESSAGE_MAX];
+
+    client_send(query, make_query(query, 0x1234, name, ESP_OT_DNS_TYPE_AAAA));
+    int len = upstream_recv(s_upstream, upstream, TEST_RECV_TIMEOUT_MS);
+    TEST_ASSERT(len > 0);
+    upstream_send(s_upstream, response, make_response(response, upstream, len, s_address, sizeof(s_address), ttl));
+    len = recv(s_client, response, sizeof(response), 0);
+    TEST_ASSERT(len > 0);
+    TEST_ASSERT_EQUAL(0x1234, (response[0] << 8) | response[1]);
+    TEST_ASSERT_EQUAL(1, response[7]);
+}
+
+/* Query a cached name and check that it is answered, return the query forwarded to the upstream server if any. */
+static int query_cached(const char *name, uint8_t *forwarded)
+{
+    uint8_t query[TEST_MESSAGE_MAX];
+    uint8_t response[TEST_MESSAGE_MAX];
+
+    client_send(query, make_query(query, 0x4321, name, ESP_OT_DNS_TYPE_AAAA));
+    int len = recv(s_client, response, sizeof(response), 0);
+    TEST_ASSERT(len > 0);
+    TEST_ASSERT_EQUAL(0x4321, (response[0] << 8) | response[1]);
+    TEST_ASSERT_EQUAL(1, response[7]);
+    return upstream_recv(s_upstream, forwarded, TEST_SILENCE_MS);
+}
+
+static void test_miss_then_hit(void)
+{
+    uint8_t forwarded[TEST_MESSAGE_MAX];
+
+    resolve_aaaa("host.example", 300);
+    TEST_ASSERT(query_cached("host.example", forwarded) < 0);
+    TEST_ASSERT(query_cached("HOST.example", forwarded) < 0);
+}
+
+static void test_synthesize_aaaa(void)
+{
+    static const uint8_t s_ipv4[4] = {192, 0, 2, 1};
+    static const uint8_t s_synthesized[16] = {[10] = 0xff, [11] = 0xff, [12] = 192, [13] = 0, [14] = 2, [15] = 1};
+    uint8_t query[TEST_MESSAGE_MAX];
+    uint8_t upstream[TEST_MESSAGE_MAX];
+    uint8_t response[TEST_MESSAGE_MAX];
+
+    client_send(query, make_query(query, 0x2222, "v4only.example", ESP_OT_DNS_TYPE_AAAA));
+    int len = upstream_recv(s_upstream, upstream, TEST_RECV_TIMEOUT_MS);
+    TEST_ASSERT_EQUAL(ESP_OT_DNS_TYPE_AAAA, message_qtype(upstream, len));
+    upstream_send(s_upstream, response, make_response(response, upstream, len, NULL, 0, 0));
+    len = upstream_recv(s_upstream, upstream, TEST_RECV_TIMEOUT_MS);
+    TEST_ASSERT_EQUAL(ESP_OT_DNS_TYPE_A, message_qtype(upstream, len));
+    upstream_send(s_upstream, response, make_response(response, upstream, len, s_ipv4, sizeof(s_ipv4), 300));
+    len = recv(s_client, response, sizeof(response), 0);
+    TEST_ASSERT(len > 16);
+    TEST_ASSERT_EQUAL(0x2222, (response[0] << 8) | response[1]);
+    TEST_ASSERT_EQUAL(1, response[7]);
+    TEST_ASSERT_EQUAL(0, memcmp(response + len - 16, s_synthesized, 16));
+}
+
+/* A prefetch which times out or whose response is not cached lets the next hit prefetch the entry again. */
+static void test_prefetch_ends_without_response(void)
+{
+    uint8_t forwarded[TEST_MESSAGE_MAX];
+    uint8_t response[TEST_MESSAGE_MAX];
+    static const uint8_t s_address[16] = {0x20, 0x01, 0x0d, 0xb8, [15] = 2};
+
+    resolve_aaaa("popular.example", 100);
+    TEST_ASSERT(query_cached("popular.example", forwarded) < 0);
+    TEST_ASSERT(query_cached("popular.example", forwarded) < 0);
+    stub_timer_advance_ms(95 * 1000);
+    TEST_ASSERT(query_cached("popular.example", forwarded) > 0);
+
+    /* The upstream server does not answer the prefetch. */
+    stub_timer_advance_ms(3100);
+    sleep_ms(TEST_POLL_WAIT_MS);
+    int len = query_cached("popular.example", forwarded);
+    TEST_ASSERT(len > 0);
+
+    /* The upstream server answers the prefetch with a TTL of 0, which is not cached. */
+    upstream_send(s_upstream, response, make_response(response, forwarded, len, s_address, sizeof(s_address), 0));
+    sleep_ms(TEST_SILENCE_MS);
+    TEST_ASSERT(query_cached("popular.example", forwarded) > 0);
+}
+
+static void test_foreign_client_dropped(void)
+{
+    uint8_t query[TEST_MESSAGE_MAX];
+    uint8_t upstream[TEST_MESSAGE_MAX];
+    struct sockaddr_in resolver = {
+        .sin_family = AF_INET,
+        .sin_port = htons(CONFIG_OPENTHREAD_DNS_CACHE_PORT),
+        .sin_addr.s_addr = htonl(INADDR_LOOPBACK),
+    };
+    int sock = socket(AF_INET, SOCK_DGRAM, 0);
+
+    /* An IPv4 client, seen as ::ffff:127.0.0.1, is neither this node nor in a prefix of the Thread netif. */
+    TEST_ASSERT(sock >= 0);
+    set_timeout(sock, TEST_SILENCE_MS);
+    uint16_t len = make_query(query, 0x3333, "host.example", ESP_OT_DNS_TYPE_AAAA);
+    TEST_ASSERT_EQUAL(len, sendto(sock, query, len, 0, (struct sockaddr *)&resolver, sizeof(resolver)));
+    TEST_ASSERT(recv(sock, query, sizeof(query), 0) < 0);
+    len = make_query(query, 0x3334, "uncached.example", ESP_OT_DNS_TYPE_AAAA);
+    TEST_ASSERT_EQUAL(len, sendto(sock, query, len, 0, (struct sockaddr *)&resolver, sizeof(resolver)));
+    TEST_ASSERT(upstream_recv(s_upstream, upstream, TEST_SILENCE_MS) < 0);
+    close(sock);
+}
+
+/* A new upstream server is swapped in place, the query pending on the former one is still answered by it. */
+static void test_swap_upstream(void)
+{
+    static const uint8_t s_address[16] = {0x20, 0x01, 0x0d, 0xb8, [15] = 3};
+    uint8_t query[TEST_MESSAGE_MAX];
+    uint8_t upstream[TEST_MESSAGE_MAX];
+    uint8_t response[TEST_MESSAGE_MAX];
+
+    client_send(query, make_query(query, 0x5555, "before.example", ESP_OT_DNS_TYPE_AAAA));
+    int len = upstream_recv(s_upstream, upstream, TEST_RECV_TIMEOUT_MS);
+    TEST_ASSERT(len > 0);
+
+    int64_t start_us = esp_timer_get_time();
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_dns_resolver_start(htonl(INADDR_LOOPBACK + 1)));
+    TEST_ASSERT(esp_timer_get_time() - start_us < 50 * 1000);
+
+    upstream_send(s_upstream, response, make_response(response, upstream, len, s_address, sizeof(s_address), 300));
+    TEST_ASSERT(recv(s_client, response, sizeof(response), 0) > 0);
+    TEST_ASSERT_EQUAL(0x5555, (response[0] << 8) | response[1]);
+    TEST_ASSERT_EQUAL(1, response[7]);
+
+    client_send(query, make_query(query, 0x6666, "after.example", ESP_OT_DNS_TYPE_AAAA));
+    TEST_ASSERT(upstream_recv(s_other_upstream, upstream, TEST_RECV_TIMEOUT_MS) > 0);
+    TEST_ASSERT(upstream_recv(s_upstream, upstream, TEST_SILENCE_MS) < 0);
+}
+
+int main(void)
+{
+    struct sockaddr_in upstream_addr = {
+        .sin_family = AF_INET,
+        .sin_port = htons(DNS_RESOLVER_UPSTREAM_PORT),
+        .sin_addr.s_addr = htonl(INADDR_LOOPBACK),
+    };
+
+    s_upstream = socket(AF_INET, SOCK_DGRAM, 0);
+    TEST_ASSERT_EQUAL(0, bind(s_upstream, (struct sockaddr *)&upstream_addr, sizeof(upstream_addr)));
+    s_other_upstream = socket(AF_INET, SOCK_DGRAM, 0);
+    upstream_addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK + 1);
+    TEST_ASSERT_EQUAL(0, bind(s_other_upstream, (struct sockaddr *)&upstream_addr, sizeof(upstream_addr)));
+    s_client = socket(AF_INET6, SOCK_DGRAM, 0);
+    TEST_ASSERT(s_client >= 0);
+    set_timeout(s_client, TEST_RECV_TIMEOUT_MS);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_dns_resolver_start(htonl(INADDR_LOOPBACK)));
+
+    RUN_TEST(test_miss_then_hit);
+    RUN_TEST(test_synthesize_aaaa);
+    RUN_TEST(test_prefetch_ends_without_response);
+    RUN_TEST(test_foreign_client_dropped);
+    RUN_TEST(test_swap_upstream);
+
+    esp_ot_dns_resolver_stop();
+    close(s_client);
+    close(s_upstream);
+    close(s_other_upstream);
+    return 0;
+}
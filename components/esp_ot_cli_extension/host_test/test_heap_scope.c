@@ -0,0 +1,241 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "esp_heap_caps.h"
+#include "esp_idf_version.h"
+#include "esp_ot_heap_diag.h"
+#include "host_test.h"
+
+/*
+ * Runs the heap scopes against a stub allocator, whose free size and local minimum free size monitor follow the
+ * allocations and frees of the test, and reads the peak and the retained size of each scope from `heapdiag scope`.
+ * Built for ESP-IDF v5.3, which has the monitor, and for v5.2, whose scopes only measure the retained size.
+ */
+#define TEST_MONITOR (ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 3, 0))
+#define TEST_HEAP_SIZE 100000
+#define TEST_OUTPUT_SIZE 1024
+
+static size_t s_free = TEST_HEAP_SIZE;
+static size_t s_min_free = TEST_HEAP_SIZE;
+static size_t s_local_min_free;
+static bool s_monitor;
+static int s_monitor_starts;
+
+size_t heap_caps_get_free_size(uint32_t caps)
+{
+    return s_free;
+}
+
+size_t heap_caps_get_total_size(uint32_t caps)
+{
+    return TEST_HEAP_SIZE;
+}
+
+size_t heap_caps_get_minimum_free_size(uint32_t caps)
+{
+    return s_monitor ? s_local_min_free : s_min_free;
+}
+
+size_t heap_caps_get_largest_free_block(uint32_t caps)
+{
+    return s_free;
+}
+
+esp_err_t heap_caps_monitor_local_minimum_free_size_start(void)
+{
+    if (s_monitor) {
+        return ESP_FAIL;
+    }
+    s_monitor = true;
+    s_monitor_starts++;
+    s_local_min_free = s_free;
+    return ESP_OK;
+}
+
+esp_err_t heap_caps_monitor_local_minimum_free_size_stop(void)
+{
+    if (!s_monitor) {
+        return ESP_FAIL;
+    }
+    s_monitor = false;
+    return ESP_OK;
+}
+
+static void stub_alloc(size_t size)
+{
+    TEST_ASSERT(size <= s_free);
+    s_free -= size;
+    s_min_free = s_free < s_min_free ? s_free : s_min_free;
+    s_local_min_free = s_free < s_local_min_free ? s_free : s_local_min_free;
+}
+
+static void stub_free(size_t size)
+{
+    s_free += size;
+    TEST_ASSERT(s_free <= TEST_HEAP_SIZE);
+}
+
+static void heapdiag(const char *arg0, const char *arg1)
+{
+    char *args[] = {(char *)arg0, (char *)arg1};
+
+    TEST_ASSERT_EQUAL(OT_ERROR_NONE, esp_ot_process_heap_diag(NULL, arg1 ? 2 : 1, args));
+}
+
+/* The line of `heapdiag scope` of the scope, empty if the scope is not listed. */
+static void scope_line(const char *name, char *line, size_t size)
+{
+    // The output follows a newline, so each line of it starts with one.
+    static char s_output[TEST_OUTPUT_SIZE] = "\n";
+    FILE *console = stdout;
+    char prefix[32];
+
+    fflush(stdout);
+    memset(s_output + 1, 0, sizeof(s_output) - 1);
+    stdout = fmemopen(s_output + 1, sizeof(s_output) - 2, "w");
+    TEST_ASSERT_NOT_NULL(stdout);
+    heapdiag("scope", NULL);
+    fclose(stdout);
+    stdout = console;
+
+    snprintf(prefix, sizeof(prefix), "\n%s: ", name);
+    const char *start = strstr(s_output, prefix);
+    line[0] = '\0';
+    if (start) {
+        start++;
+        snprintf(line, size, "%.*s", (int)strcspn(start, "\n"), start);
+    }
+}
+
+/* Checks the scope line: a negative peak for a peak which is not measured. */
+static void assert_scope(const char *name, long peak, long retained, unsigned long calls)
+{
+    char line[128];
+    char expected[128];
+
+    scope_line(name, line, sizeof(line));
+    if (peak < 0) {
+        snprintf(expected, sizeof(expected), "%s: peak not measured, %+ld B retained, %lu calls", name, retained,
+                 calls);
+    } else {
+        snprintf(expected, sizeof(expected), "%s: +%ld B peak, %+ld B retained, %lu calls", name, peak, retained,
+                 calls);
+    }
+    TEST_ASSERT_MESSAGE(strcmp(expected, line) == 0, expected);
+}
+
+static void test_peak_and_retained(void)
+{
+    esp_ot_heap_scope_t scope;
+
+    heapdiag("scope", "reset");
+    esp_ot_heap_scope_begin(&scope, "/diagnostics");
+    stub_alloc(3000);
+    stub_alloc(2000);
+    stub_free(3000);
+    esp_ot_heap_scope_end(&scope);
+    assert_scope("/diagnostics", TEST_MONITOR ? 5000 : -1, 2000, 1);
+
+    // A smaller second call keeps the max peak, the retained size adds up.
+    esp_ot_heap_scope_begin(&scope, "/diagnostics");
+    stub_alloc(1000);
+    stub_free(3000);
+    esp_ot_heap_scope_end(&scope);
+    assert_scope("/diagnostics", TEST_MONITOR ? 5000 : -1, 0, 2);
+    TEST_ASSERT_FALSE(s_monitor);
+    TEST_ASSERT_EQUAL(TEST_HEAP_SIZE, s_free);
+}
+
+static void test_peak_from_scope_begin(void)
+{
+    esp_ot_heap_scope_t scope;
+
+    heapdiag("scope", "reset");
+    // A low free heap before the scope is not its peak, the monitor restarts the minimum when the scope begins.
+    stub_alloc(40000);
+    stub_free(40000);
+    stub_alloc(10000);
+    esp_ot_heap_scope_begin(&scope, "ip");
+    stub_alloc(160);
+    stub_free(160);
+    esp_ot_heap_scope_end(&scope);
+    stub_free(10000);
+    assert_scope("ip", TEST_MONITOR ? 160 : -1, 0, 1);
+    TEST_ASSERT_EQUAL(60000, s_min_free);
+}
+
+static void test_nested_scopes(void)
+{
+    esp_ot_heap_scope_t outer;
+    esp_ot_heap_scope_t inner;
+    int starts = s_monitor_starts;
+
+    heapdiag("scope", "reset");
+    esp_ot_heap_scope_begin(&outer, "/node");
+    stub_alloc(100);
+    // The monitor is owned by the outer scope, the peak of the inner one is not measured.
+    esp_ot_heap_scope_begin(&inner, "/node/state");
+    stub_alloc(400);
+    esp_ot_heap_scope_end(&inner);
+    TEST_ASSERT_EQUAL(TEST_MONITOR, s_monitor);
+    stub_free(500);
+    esp_ot_heap_scope_end(&outer);
+    assert_scope("/node/state", -1, 400, 1);
+    assert_scope("/node", TEST_MONITOR ? 500 : -1, 0, 1);
+    TEST_ASSERT_EQUAL(starts + TEST_MONITOR, s_monitor_starts);
+    TEST_ASSERT_FALSE(s_monitor);
+}
+
+static void test_monitor_taken_elsewhere(void)
+{
+    esp_ot_heap_scope_t scope;
+
+    heapdiag("scope", "reset");
+    TEST_ASSERT_EQUAL(ESP_OK, heap_caps_monitor_local_minimum_free_size_start());
+    esp_ot_heap_scope_begin(&scope, "curl");
+    stub_alloc(700);
+    esp_ot_heap_scope_end(&scope);
+    stub_free(700);
+    assert_scope("curl", -1, 700, 1);
+    // The scope which failed to start the monitor does not stop it.
+    TEST_ASSERT_TRUE(s_monitor);
+    TEST_ASSERT_EQUAL(ESP_OK, heap_caps_monitor_local_minimum_free_size_stop());
+}
+
+static void test_scopes_full(void)
+{
+    static const char *const s_names[] = {"a", "b", "c", "d", "e"};
+    esp_ot_heap_scope_t scope;
+    char line[128];
+
+    heapdiag("scope", "reset");
+    for (int i = 0; i < 5; i++) {
+        esp_ot_heap_scope_begin(&scope, s_names[i]);
+        esp_ot_heap_scope_end(&scope);
+    }
+    // CONFIG_OPENTHREAD_HEAP_DIAG_SCOPE_MAX_NUM names are kept, the next ones are not accounted.
+    assert_scope("d", TEST_MONITOR ? 0 : -1, 0, 1);
+    scope_line("e", line, sizeof(line));
+    TEST_ASSERT_EQUAL(0, strlen(line));
+    heapdiag("scope", "reset");
+    scope_line("a", line, sizeof(line));
+    TEST_ASSERT_EQUAL(0, strlen(line));
+}
+
+int main(void)
+{
+    RUN_TEST(test_peak_and_retained);
+    RUN_TEST(test_peak_from_scope_begin);
+    RUN_TEST(test_nested_scopes);
+    RUN_TEST(test_monitor_taken_elsewhere);
+    RUN_TEST(test_scopes_full);
+    return 0;
+}
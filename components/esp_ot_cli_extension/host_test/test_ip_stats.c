@@ -0,0 +1,527 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <arpa/inet.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "esp_cpu.h"
+#include "esp_netif_types.h"
+#include "esp_openthread_types.h"
+#include "esp_ot_ip_stats.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "host_test.h"
+#include "lwip/netif.h"
+#include "lwip/prot/ethernet.h"
+#include "sdkconfig.h"
+
+/*
+ * Forwards packets between a Thread netif and two Ethernet netifs through the wrappers of the IP statistics, as the
+ * glue and lwIP call them, and checks the counters, the latency histograms and the multicast groups. The threads of
+ * the concurrent tests each act as one core. The tests share the attached netifs and reset the statistics first.
+ */
+#define TEST_IP6_LEN 60
+#define TEST_IP4_LEN 40
+#define TEST_FRAME_MAX (SIZEOF_ETH_HDR + TEST_IP6_LEN)
+#define TEST_CORE_PACKETS 2000
+#define TEST_RACE_ROUNDS 2000
+
+static _Atomic err_t s_input_err = ERR_OK;
+static _Atomic err_t s_output_err = ERR_OK;
+static _Atomic uint32_t s_delivered = 0;
+static _Atomic uint32_t s_sent = 0;
+
+static err_t fake_input(struct pbuf *p, struct netif *netif)
+{
+    atomic_fetch_add(&s_delivered, 1);
+    return atomic_load(&s_input_err);
+}
+
+static err_t fake_output(struct netif *netif, struct pbuf *p, const ip4_addr_t *ipaddr)
+{
+    atomic_fetch_add(&s_sent, 1);
+    return atomic_load(&s_output_err);
+}
+
+static err_t fake_output_ip6(struct netif *netif, struct pbuf *p, const ip6_addr_t *ipaddr)
+{
+    atomic_fetch_add(&s_sent, 1);
+    return atomic_load(&s_output_err);
+}
+
+static struct netif s_lo = {.input = fake_input, .output_ip6 = fake_output_ip6, .name = {'l', 'o'}};
+static struct netif s_et = {.next = &s_lo, .input = fake_input, .output = fake_output, .output_ip6 = fake_output_ip6,
+                            .flags = NETIF_FLAG_ETHERNET, .name = {'e', 't'}};
+static struct netif s_st = {.next = &s_et, .input = fake_input, .output = fake_output, .output_ip6 = fake_output_ip6,
+                            .flags = NETIF_FLAG_ETHERNET, .name = {'s', 't'}};
+static struct netif s_ot = {.next = &s_st, .input = fake_input, .output_ip6 = fake_output_ip6, .name = {'o', 't'}};
+static struct netif s_e2 = {.input = fake_input, .output = fake_output, .output_ip6 = fake_output_ip6,
+                            .flags = NETIF_FLAG_ETHERNET, .name = {'e', '2'}};
+
+static void make_ip6(uint8_t *ip, const char *src, const char *dst)
+{
+    memset(ip, 0, TEST_IP6_LEN);
+    ip[0] = 0x60;
+    ip[5] = TEST_IP6_LEN - 40;
+    ip[6] = 17;
+    ip[7] = 64;
+    TEST_ASSERT_EQUAL(1, inet_pton(AF_INET6, src, ip + 8));
+    TEST_ASSERT_EQUAL(1, inet_pton(AF_INET6, dst, ip + 24));
+}
+
+static void make_ip4(uint8_t *ip, const char *src, const char *dst)
+{
+    memset(ip, 0, TEST_IP4_LEN);
+    ip[0] = 0x45;
+    ip[3] = TEST_IP4_LEN;
+    ip[8] = 64;
+    ip[9] = 17;
+    ip[10] = 0x12; /* the checksum, changed with the TTL */
+    TEST_ASSERT_EQUAL(1, inet_pton(AF_INET, src, ip + 12));
+    TEST_ASSERT_EQUAL(1, inet_pton(AF_INET, dst, ip + 16));
+}
+
+static uint16_t ip_len(const uint8_t *ip)
+{
+    return (ip[0] >> 4) == 6 ? TEST_IP6_LEN : TEST_IP4_LEN;
+}
+
+/* Passes the packet to lwIP from in, with the Ethernet header of an Ethernet netif. */
+static err_t receive(struct netif *in, const uint8_t *ip)
+{
+    uint8_t frame[TEST_FRAME_MAX];
+    uint16_t l2_len = (in->flags & NETIF_FLAG_ETHERNET) ? SIZEOF_ETH_HDR : 0;
+    uint16_t len = ip_len(ip);
+
+    memset(frame, 0xee, l2_len);
+    memcpy(frame + l2_len, ip, len);
+    struct pbuf p = {.payload = frame, .len = l2_len + len, .tot_len = l2_len + len};
+    return in->input(&p, in);
+}
+
+/* Sends the packet on out as lwIP forwards it, with the hop limit or the TTL decremented. */
+static err_t transmit(struct netif *out, const uint8_t *ip)
+{
+    uint8_t packet[TEST_IP6_LEN];
+    uint16_t len = ip_len(ip);
+
+    memcpy(packet, ip, len);
+    struct pbuf p = {.payload = packet, .len = len, .tot_len = len};
+    if (len == TEST_IP6_LEN) {
+        packet[7]--;
+        return out->output_ip6(out, &p, NULL);
+    }
+    packet[8]--;
+    packet[10]++;
+    return out->output(out, &p, NULL);
+}
+
+static esp_ot_ip_stats_netif_t netif_stats(const char *name)
+{
+    esp_ot_ip_stats_netif_t netifs[ESP_OT_IP_STATS_MAX_NETIFS];
+    uint8_t count = esp_ot_ip_stats_get_netifs(netifs, ESP_OT_IP_STATS_MAX_NETIFS);
+
+    for (uint8_t i = 0; i < count; i++) {
+        if (strcmp(netifs[i].name, name) == 0) {
+            return netifs[i];
+        }
+    }
+    TEST_ASSERT_MESSAGE(false, name);
+    return netifs[0];
+}
+
+static esp_ot_ip_stats_latency_t latency(esp_ot_ip_stats_direction_t direction)
+{
+    esp_ot_ip_stats_latency_t result;
+
+    esp_ot_ip_stats_get_latency(direction, &result);
+    return result;
+}
+
+static void test_attach(void)
+{
+    esp_ot_ip_stats_netif_t netifs[ESP_OT_IP_STATS_MAX_NETIFS];
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_ip_stats_init());
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_ip_stats_init());
+    TEST_ASSERT_EQUAL(3, esp_ot_ip_stats_get_netifs(netifs, ESP_OT_IP_STATS_MAX_NETIFS));
+    TEST_ASSERT_EQUAL(0, strcmp(esp_ot_ip_stats_netif_name(0), "ot"));
+    TEST_ASSERT_EQUAL(0, strcmp(esp_ot_ip_stats_netif_name(1), "st"));
+    TEST_ASSERT_EQUAL(0, strcmp(esp_ot_ip_stats_netif_name(2), "et"));
+    TEST_ASSERT_NULL(esp_ot_ip_stats_netif_name(3));
+    TEST_ASSERT_NULL(esp_ot_ip_stats_netif_name(ESP_OT_IP_STATS_MAX_NETIFS));
+
+    /* The loopback netif is left alone, the missing IPv4 output of the Thread netif is not wrapped. */
+    TEST_ASSERT(s_lo.input == fake_input);
+    TEST_ASSERT(s_ot.input != fake_input);
+    TEST_ASSERT_NULL(s_ot.output);
+    TEST_ASSERT(s_st.output != fake_output);
+
+    /* A new event does not wrap the wrappers. */
+    netif_input_fn input = s_ot.input;
+    stub_event_post(IP_EVENT, 0, NULL);
+    TEST_ASSERT(s_ot.input == input);
+    TEST_ASSERT_EQUAL(3, esp_ot_ip_stats_get_netifs(netifs, ESP_OT_IP_STATS_MAX_NETIFS));
+}
+
+static void test_thread_to_backbone(void)
+{
+    uint8_t ip[TEST_IP6_LEN];
+
+    esp_ot_ip_stats_reset();
+    make_ip6(ip, "fd00::1", "2001:db8::1");
+    TEST_ASSERT_EQUAL(ERR_OK, receive(&s_ot, ip));
+    stub_timer_advance_ms(3);
+    TEST_ASSERT_EQUAL(ERR_OK, transmit(&s_st, ip));
+
+    esp_ot_ip_stats_latency_t result = latency(ESP_OT_IP_STATS_THREAD_TO_BACKBONE);
+    TEST_ASSERT_EQUAL(1, result.samples);
+    TEST_ASSERT_EQUAL(1, result.buckets[5]); /* <= 5000 us */
+    TEST_ASSERT(result.max_us >= 3000 && result.max_us <= 5000);
+    TEST_ASSERT_EQUAL(0, latency(ESP_OT_IP_STATS_BACKBONE_TO_THREAD).samples);
+
+    esp_ot_ip_stats_netif_t ot = netif_stats("ot");
+    esp_ot_ip_stats_netif_t st = netif_stats("st");
+    TEST_ASSERT_EQUAL(1, ot.rx_packets);
+    TEST_ASSERT_EQUAL(TEST_IP6_LEN, ot.rx_bytes);
+    TEST_ASSERT_EQUAL(1, st.tx_packets);
+    TEST_ASSERT_EQUAL(TEST_IP6_LEN, st.tx_bytes);
+    TEST_ASSERT_EQUAL(1, st.tx_forwarded);
+
+    /* The stamp of a unicast packet is consumed: a second copy is sent, not forwarded. */
+    TEST_ASSERT_EQUAL(ERR_OK, transmit(&s_st, ip));
+    TEST_ASSERT_EQUAL(1, latency(ESP_OT_IP_STATS_THREAD_TO_BACKBONE).samples);
+    st = netif_stats("st");
+    TEST_ASSERT_EQUAL(2, st.tx_packets);
+    TEST_ASSERT_EQUAL(1, st.tx_forwarded);
+}
+
+static void test_backbone_to_thread(void)
+{
+    uint8_t ip6[TEST_IP6_LEN];
+    uint8_t ip4[TEST_IP4_LEN];
+
+    esp_ot_ip_stats_reset();
+    make_ip6(ip6, "2001:db8::2", "fd00::2");
+    TEST_ASSERT_EQUAL(ERR_OK, receive(&s_st, ip6));
+    TEST_ASSERT_EQUAL(ERR_OK, transmit(&s_ot, ip6));
+    TEST_ASSERT_EQUAL(1, latency(ESP_OT_IP_STATS_BACKBONE_TO_THREAD).samples);
+    TEST_ASSERT_EQUAL(0, latency(ESP_OT_IP_STATS_THREAD_TO_BACKBONE).samples);
+    /* The Ethernet header is not counted. */
+    TEST_ASSERT_EQUAL(TEST_IP6_LEN, netif_stats("st").rx_bytes);
+    TEST_ASSERT_EQUAL(1, netif_stats("ot").tx_forwarded);
+
+    /* IPv4 between two backbone netifs is forwarded without a latency sample. */
+    make_ip4(ip4, "192.168.1.2", "10.0.0.2");
+    TEST_ASSERT_EQUAL(ERR_OK, receive(&s_st, ip4));
+    TEST_ASSERT_EQUAL(ERR_OK, transmit(&s_et, ip4));
+    esp_ot_ip_stats_netif_t et = netif_stats("et");
+    TEST_ASSERT_EQUAL(1, et.tx_forwarded);
+    TEST_ASSERT_EQUAL(TEST_IP4_LEN, et.tx_bytes);
+    TEST_ASSERT_EQUAL(1, latency(ESP_OT_IP_STATS_BACKBONE_TO_THREAD).samples);
+    TEST_ASSERT_EQUAL(0, latency(ESP_OT_IP_STATS_THREAD_TO_BACKBONE).samples);
+
+    /* A packet sent back on its ingress netif is not forwarded. */
+    make_ip4(ip4, "192.168.1.3", "192.168.1.4");
+    TEST_ASSERT_EQUAL(ERR_OK, receive(&s_st, ip4));
+    TEST_ASSERT_EQUAL(ERR_OK, transmit(&s_st, ip4));
+    TEST_ASSERT_EQUAL(0, netif_stats("st").tx_forwarded);
+}
+
+static void test_stale_stamp(void)
+{
+    uint8_t ip[TEST_IP6_LEN];
+
+    esp_ot_ip_stats_reset();
+    make_ip6(ip, "fd00::3", "2001:db8::3");
+    TEST_ASSERT_EQUAL(ERR_OK, receive(&s_ot, ip));
+    stub_timer_advance_ms(1001);
+    TEST_ASSERT_EQUAL(ERR_OK, transmit(&s_st, ip));
+    TEST_ASSERT_EQUAL(0, latency(ESP_OT_IP_STATS_THREAD_TO_BACKBONE).samples);
+    TEST_ASSERT_EQUAL(0, netif_stats("st").tx_forwarded);
+    TEST_ASSERT_EQUAL(1, netif_stats("st").tx_packets);
+}
+
+static void test_drops(void)
+{
+    uint8_t ip[TEST_IP6_LEN];
+    uint8_t arp[28] = {0x00, 0x01, 0x08, 0x00};
+
+    esp_ot_ip_stats_reset();
+    make_ip6(ip, "fd00::4", "2001:db8::4");
+    atomic_store(&s_input_err, ERR_MEM);
+    TEST_ASSERT_EQUAL(ERR_MEM, receive(&s_ot, ip));
+    atomic_store(&s_input_err, ERR_OK);
+    atomic_store(&s_output_err, ERR_IF);
+    TEST_ASSERT_EQUAL(ERR_IF, transmit(&s_st, ip));
+    atomic_store(&s_output_err, ERR_OK);
+
+    esp_ot_ip_stats_netif_t ot = netif_stats("ot");
+    esp_ot_ip_stats_netif_t st = netif_stats("st");
+    TEST_ASSERT_EQUAL(0, ot.rx_packets);
+    TEST_ASSERT_EQUAL(1, ot.rx_drops);
+    TEST_ASSERT_EQUAL(0, st.tx_packets);
+    TEST_ASSERT_EQUAL(1, st.tx_drops);
+    TEST_ASSERT_EQUAL(1, st.tx_forwarded); /* the forwarding is counted before the netif refuses the packet */
+
+    /* A frame which is not IP is counted without a stamp. */
+    uint8_t frame[SIZEOF_ETH_HDR + sizeof(arp)];
+    memset(frame, 0xee, SIZEOF_ETH_HDR);
+    memcpy(frame + SIZEOF_ETH_HDR, arp, sizeof(arp));
+    struct pbuf p = {.payload = frame, .len = sizeof(frame), .tot_len = sizeof(frame)};
+    TEST_ASSERT_EQUAL(ERR_OK, s_et.input(&p, &s_et));
+    TEST_ASSERT_EQUAL(1, netif_stats("et").rx_packets);
+    TEST_ASSERT_EQUAL(sizeof(arp), netif_stats("et").rx_bytes);
+
+    /* A netif unknown to the statistics is refused. */
+    struct netif unknown = {.name = {'u', 'k'}};
+    TEST_ASSERT_EQUAL(ERR_IF, s_ot.input(&p, &unknown));
+}
+
+static void test_multicast(void)
+{
+    esp_ot_ip_stats_mcast_group_t groups[CONFIG_OPENTHREAD_IP_STATS_MCAST_GROUPS];
+    uint8_t ip6[TEST_IP6_LEN];
+    uint8_t ip4[TEST_IP4_LEN];
+    uint32_t other = 0;
+    char addr[IPADDR_STRLEN_MAX];
+
+    esp_ot_ip_stats_reset();
+    make_ip6(ip6, "fd00::5", "ff05::1:3");
+    TEST_ASSERT_EQUAL(ERR_OK, receive(&s_ot, ip6));
+    TEST_ASSERT_EQUAL(ERR_OK, transmit(&s_st, ip6));
+    TEST_ASSERT_EQUAL(ERR_OK, transmit(&s_et, ip6)); /* the stamp of a multicast packet is kept */
+    TEST_ASSERT_EQUAL(2, latency(ESP_OT_IP_STATS_THREAD_TO_BACKBONE).samples);
+    TEST_ASSERT_EQUAL(1, netif_stats("st").tx_forwarded);
+    TEST_ASSERT_EQUAL(1, netif_stats("et").tx_forwarded);
+
+    make_ip4(ip4, "192.168.1.5", "239.1.2.3");
+    TEST_ASSERT_EQUAL(ERR_OK, receive(&s_st, ip4));
+    TEST_ASSERT_EQUAL(ERR_OK, transmit(&s_et, ip4));
+
+    TEST_ASSERT_EQUAL(2, esp_ot_ip_stats_get_mcast_groups(groups, CONFIG_OPENTHREAD_IP_STATS_MCAST_GROUPS, &other));
+    TEST_ASSERT_EQUAL(0, other);
+    TEST_ASSERT(IP_IS_V6(&groups[0].group));
+    TEST_ASSERT_EQUAL(0, strcmp(ipaddr_ntoa_r(&groups[0].group, addr, sizeof(addr)), "ff05::1:3"));
+    TEST_ASSERT_EQUAL(2, groups[0].packets);
+    TEST_ASSERT_EQUAL(2 * TEST_IP6_LEN, groups[0].bytes);
+    TEST_ASSERT_FALSE(IP_IS_V6(&groups[1].group));
+    TEST_ASSERT_EQUAL(0, strcmp(ipaddr_ntoa_r(&groups[1].group, addr, sizeof(addr)), "239.1.2.3"));
+    TEST_ASSERT_EQUAL(1, groups[1].packets);
+    TEST_ASSERT_EQUAL(TEST_IP4_LEN, groups[1].bytes);
+    TEST_ASSERT_EQUAL(1, esp_ot_ip_stats_get_mcast_groups(groups, 1, &other));
+
+    /* The groups beyond the table are counted together. */
+    const char *dsts[] = {"ff05::2", "ff05::3", "ff05::4", "ff05::5"};
+    for (size_t i = 0; i < sizeof(dsts) / sizeof(dsts[0]); i++) {
+        make_ip6(ip6, "fd00::5", dsts[i]);
+        TEST_ASSERT_EQUAL(ERR_OK, receive(&s_ot, ip6));
+        TEST_ASSERT_EQUAL(ERR_OK, transmit(&s_st, ip6));
+    }
+    TEST_ASSERT_EQUAL(CONFIG_OPENTHREAD_IP_STATS_MCAST_GROUPS,
+                      esp_ot_ip_stats_get_mcast_groups(groups, CONFIG_OPENTHREAD_IP_STATS_MCAST_GROUPS, &other));
+    TEST_ASSERT_EQUAL(2, other);
+}
+
+typedef struct core_context {
+    int core;
+    pthread_barrier_t *barrier;
+    const uint8_t *ip;
+} core_context_t;
+
+static void *forward_task(void *arg)
+{
+    const core_context_t *context = arg;
+    uint8_t ip[TEST_IP6_LEN];
+    char dst[INET6_ADDRSTRLEN];
+
+    stub_core_id = context->core;
+    for (int i = 0; i < TEST_CORE_PACKETS; i++) {
+        snprintf(dst, sizeof(dst), "2001:db8::%x:%x", context->core + 1, i);
+        make_ip6(ip, "fd00::6", dst);
+        TEST_ASSERT_EQUAL(ERR_OK, receive(&s_ot, ip));
+        TEST_ASSERT_EQUAL(ERR_OK, transmit(&s_st, ip));
+    }
+    return NULL;
+}
+
+/* Each core counts in its own copy, the copies are summed when read. */
+static void test_per_core(void)
+{
+    pthread_t threads[portNUM_PROCESSORS];
+    core_context_t contexts[portNUM_PROCESSORS];
+
+    esp_ot_ip_stats_reset();
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        contexts[core] = (core_context_t) {.core = core};
+        TEST_ASSERT_EQUAL(0, pthread_create(&threads[core], NULL, forward_task, &contexts[core]));
+    }
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        pthread_join(threads[core], NULL);
+    }
+    esp_ot_ip_stats_netif_t ot = netif_stats("ot");
+    esp_ot_ip_stats_netif_t st = netif_stats("st");
+    TEST_ASSERT_EQUAL(portNUM_PROCESSORS * TEST_CORE_PACKETS, ot.rx_packets);
+    TEST_ASSERT_EQUAL(portNUM_PROCESSORS * TEST_CORE_PACKETS * TEST_IP6_LEN, ot.rx_bytes);
+    TEST_ASSERT_EQUAL(portNUM_PROCESSORS * TEST_CORE_PACKETS, st.tx_packets);
+    TEST_ASSERT_EQUAL(portNUM_PROCESSORS * TEST_CORE_PACKETS * TEST_IP6_LEN, st.tx_bytes);
+    /* A stamp overwritten by the packet of the other core before its egress only loses a sample. */
+    esp_ot_ip_stats_latency_t result = latency(ESP_OT_IP_STATS_THREAD_TO_BACKBONE);
+    TEST_ASSERT_EQUAL(st.tx_forwarded, result.samples);
+    TEST_ASSERT(result.samples > 0 && result.samples <= portNUM_PROCESSORS * TEST_CORE_PACKETS);
+}
+
+static void *mcast_task(void *arg)
+{
+    const core_context_t *context = arg;
+
+    stub_core_id = context->core;
+    pthread_barrier_wait(context->barrier);
+    TEST_ASSERT_EQUAL(ERR_OK, transmit(&s_st, context->ip));
+    return NULL;
+}
+
+/* Two cores forwarding the first packets of a group at once report a single group. */
+static void test_mcast_race(void)
+{
+    esp_ot_ip_stats_mcast_group_t groups[CONFIG_OPENTHREAD_IP_STATS_MCAST_GROUPS];
+    pthread_t threads[portNUM_PROCESSORS];
+    core_context_t contexts[portNUM_PROCESSORS];
+    pthread_barrier_t barrier;
+    uint8_t ip[TEST_IP6_LEN];
+    uint32_t other = 0;
+
+    make_ip6(ip, "fd00::7", "ff05::7");
+    TEST_ASSERT_EQUAL(0, pthread_barrier_init(&barrier, NULL, portNUM_PROCESSORS));
+    for (int round = 0; round < TEST_RACE_ROUNDS; round++) {
+        esp_ot_ip_stats_reset();
+        TEST_ASSERT_EQUAL(ERR_OK, receive(&s_ot, ip));
+        for (int core = 0; core < portNUM_PROCESSORS; core++) {
+            contexts[core] = (core_context_t) {.core = core, .barrier = &barrier, .ip = ip};
+            TEST_ASSERT_EQUAL(0, pthread_create(&threads[core], NULL, mcast_task, &contexts[core]));
+        }
+        for (int core = 0; core < portNUM_PROCESSORS; core++) {
+            pthread_join(threads[core], NULL);
+        }
+        TEST_ASSERT_EQUAL(1, esp_ot_ip_stats_get_mcast_groups(groups, CONFIG_OPENTHREAD_IP_STATS_MCAST_GROUPS, &other));
+        TEST_ASSERT_EQUAL(portNUM_PROCESSORS, groups[0].packets);
+        TEST_ASSERT_EQUAL(portNUM_PROCESSORS * TEST_IP6_LEN, groups[0].bytes);
+    }
+    pthread_barrier_destroy(&barrier);
+}
+
+static int s_tap_calls[2];
+static uint16_t s_tap_offset[2];
+static uint8_t s_tap_netif[2];
+
+static void record_tap(uint8_t netif, bool egress, const struct pbuf *p, uint16_t offset)
+{
+    s_tap_calls[egress]++;
+    s_tap_offset[egress] = offset;
+    s_tap_netif[egress] = netif;
+}
+
+static void test_tap(void)
+{
+    uint8_t ip[TEST_IP6_LEN];
+
+    make_ip6(ip, "2001:db8::8", "fd00::8");
+    esp_ot_ip_stats_set_tap(record_tap);
+    TEST_ASSERT_EQUAL(ERR_OK, receive(&s_st, ip));
+    TEST_ASSERT_EQUAL(ERR_OK, transmit(&s_ot, ip));
+    esp_ot_ip_stats_set_tap(NULL);
+    TEST_ASSERT_EQUAL(ERR_OK, transmit(&s_ot, ip));
+
+    TEST_ASSERT_EQUAL(1, s_tap_calls[false]);
+    TEST_ASSERT_EQUAL(1, s_tap_netif[false]);
+    TEST_ASSERT_EQUAL(SIZEOF_ETH_HDR, s_tap_offset[false]);
+    TEST_ASSERT_EQUAL(1, s_tap_calls[true]);
+    TEST_ASSERT_EQUAL(0, s_tap_netif[true]);
+    TEST_ASSERT_EQUAL(0, s_tap_offset[true]);
+}
+
+/* A removed netif frees its slot for the next one. */
+static void test_netif_replaced(void)
+{
+    uint8_t ip[TEST_IP6_LEN];
+
+    s_st.next = &s_e2;
+    s_e2.next = &s_lo;
+    stub_event_post(OPENTHREAD_EVENT, OPENTHREAD_EVENT_IF_UP, NULL);
+    TEST_ASSERT_EQUAL(0, strcmp(esp_ot_ip_stats_netif_name(2), "e2"));
+    TEST_ASSERT_NULL(esp_ot_ip_stats_netif_name(3));
+    TEST_ASSERT(s_e2.input != fake_input);
+    TEST_ASSERT_EQUAL(0, netif_stats("e2").tx_packets);
+
+    make_ip6(ip, "fd00::9", "2001:db8::9");
+    TEST_ASSERT_EQUAL(ERR_OK, receive(&s_ot, ip));
+    TEST_ASSERT_EQUAL(ERR_OK, transmit(&s_e2, ip));
+    TEST_ASSERT_EQUAL(1, netif_stats("e2").tx_forwarded);
+
+    /* The events of other modules do not reach the handlers of the statistics. */
+    stub_event_post(OPENTHREAD_EVENT, OPENTHREAD_EVENT_IF_DOWN, NULL);
+    TEST_ASSERT_EQUAL(0, strcmp(esp_ot_ip_stats_netif_name(2), "e2"));
+}
+
+static void test_percentile(void)
+{
+    esp_ot_ip_stats_latency_t result = {0};
+
+    TEST_ASSERT_EQUAL(100, esp_ot_ip_stats_bound(0));
+    TEST_ASSERT_EQUAL(100000, esp_ot_ip_stats_bound(ESP_OT_IP_STATS_LATENCY_BUCKETS - 2));
+    TEST_ASSERT_EQUAL(ESP_OT_IP_STATS_NO_BOUND, esp_ot_ip_stats_bound(ESP_OT_IP_STATS_LATENCY_BUCKETS - 1));
+    TEST_ASSERT_EQUAL(ESP_OT_IP_STATS_NO_BOUND, esp_ot_ip_stats_bound(ESP_OT_IP_STATS_LATENCY_BUCKETS));
+    TEST_ASSERT_EQUAL(0, esp_ot_ip_stats_percentile(&result, 500));
+
+    result.buckets[0] = 5;
+    result.buckets[3] = 4;
+    result.buckets[ESP_OT_IP_STATS_LATENCY_BUCKETS - 1] = 1;
+    result.samples = 10;
+    TEST_ASSERT_EQUAL(100, esp_ot_ip_stats_percentile(&result, 500));
+    TEST_ASSERT_EQUAL(1000, esp_ot_ip_stats_percentile(&result, 501));
+    TEST_ASSERT_EQUAL(1000, esp_ot_ip_stats_percentile(&result, 900));
+    TEST_ASSERT_EQUAL(ESP_OT_IP_STATS_NO_BOUND, esp_ot_ip_stats_percentile(&result, 990));
+    TEST_ASSERT_EQUAL(0, strcmp(esp_ot_ip_stats_direction_name(ESP_OT_IP_STATS_THREAD_TO_BACKBONE),
+                                "thread-to-backbone"));
+    TEST_ASSERT_EQUAL(0, strcmp(esp_ot_ip_stats_direction_name(ESP_OT_IP_STATS_DIRECTIONS), "unknown"));
+}
+
+static void test_command(void)
+{
+    char *reset[] = {"reset"};
+    char *bogus[] = {"bogus"};
+    uint8_t ip[TEST_IP6_LEN];
+
+    make_ip6(ip, "fd00::a", "ff05::a");
+    TEST_ASSERT_EQUAL(ERR_OK, receive(&s_ot, ip));
+    TEST_ASSERT_EQUAL(ERR_OK, transmit(&s_st, ip));
+    TEST_ASSERT_EQUAL(OT_ERROR_NONE, esp_ot_ip_stats_process(0, NULL));
+    TEST_ASSERT_EQUAL(OT_ERROR_INVALID_ARGS, esp_ot_ip_stats_process(1, bogus));
+    TEST_ASSERT_EQUAL(OT_ERROR_NONE, esp_ot_ip_stats_process(1, reset));
+    TEST_ASSERT_EQUAL(0, netif_stats("st").tx_packets);
+    TEST_ASSERT_EQUAL(0, latency(ESP_OT_IP_STATS_THREAD_TO_BACKBONE).samples);
+}
+
+int main(void)
+{
+    netif_list = &s_ot;
+    RUN_TEST(test_attach);
+    RUN_TEST(test_thread_to_backbone);
+    RUN_TEST(test_backbone_to_thread);
+    RUN_TEST(test_stale_stamp);
+    RUN_TEST(test_drops);
+    RUN_TEST(test_multicast);
+    RUN_TEST(test_per_core);
+    RUN_TEST(test_mcast_race);
+    RUN_TEST(test_tap);
+    RUN_TEST(test_netif_replaced);
+    RUN_TEST(test_percentile);
+    RUN_TEST(test_command);
+    return 0;
+}
@@ -0,0 +1,323 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "esp_openthread.h"
+#include "esp_openthread_lock.h"
+#include "esp_ot_link_quality.h"
+#include "host_test.h"
+#include "openthread/thread_ftd.h"
+#include "sdkconfig.h"
+
+/*
+ * Fills the store with a day of samples of a 64-router mesh, each router linked to the 3 next routers of a ring, so
+ * 6 router neighbors per router and 192 links, and checks the points of each resolution. Then adds known patterns of
+ * link quality in, link quality out and route cost to links out of the mesh and checks the averages, the minimums
+ * and the maximums of the 1-minute, 15-minute and 1-hour rollups, and the samples kept by the raw ring once it wraps
+ * around. The sampling task of the store does not add any sample, this node stays disabled.
+ */
+#define TEST_ROUTERS 64
+#define TEST_NEIGHBORS 3 /* per router, with the higher ring index */
+#define TEST_LINKS (TEST_ROUTERS * TEST_NEIGHBORS)
+#define TEST_DAY 86400
+#define TEST_RAW_SIZE 48 /* LINK_QUALITY_RAW_SIZE */
+
+otInstance *esp_openthread_get_instance(void)
+{
+    return NULL;
+}
+
+bool esp_openthread_lock_acquire(TickType_t block_ticks)
+{
+    return true;
+}
+
+void esp_openthread_lock_release(void)
+{
+}
+
+otDeviceRole otThreadGetDeviceRole(otInstance *instance)
+{
+    return OT_DEVICE_ROLE_DISABLED;
+}
+
+uint16_t otThreadGetRloc16(otInstance *instance)
+{
+    return 0xfffe;
+}
+
+uint8_t otThreadGetMaxRouterId(otInstance *instance)
+{
+    return 62;
+}
+
+otError otThreadGetRouterInfo(otInstance *instance, uint16_t router_id, otRouterInfo *router_info)
+{
+    return OT_ERROR_NOT_FOUND;
+}
+
+typedef struct query_result {
+    uint16_t links;
+    uint32_t points;
+    esp_ot_link_quality_resolution_t resolution;
+    uint16_t router;
+    uint16_t neighbor;
+    uint16_t count;
+    esp_ot_link_quality_point_t last[ESP_OT_LINK_QUALITY_MAX_POINTS]; /* the points of the last link */
+} query_result_t;
+
+typedef struct test_sample {
+    uint32_t time;
+    uint8_t in;
+    uint8_t out;
+    uint8_t cost;
+} test_sample_t;
+
+static uint16_t router_rloc16(uint16_t index)
+{
+    return (uint16_t)((index % TEST_ROUTERS) << 10);
+}
+
+static void collect_points(uint16_t router, uint16_t neighbor, esp_ot_link_quality_resolution_t resolution,
+                           const esp_ot_link_quality_point_t *points, uint16_t count, void *context)
+{
+    query_result_t *result = context;
+
+    result->links++;
+    result->points += count;
+    result->resolution = resolution;
+    result->router = router;
+    result->neighbor = neighbor;
+    result->count = count;
+    memcpy(result->last, points, count * sizeof(esp_ot_link_quality_point_t));
+}
+
+static query_result_t run_query(uint32_t from, uint32_t to, uint16_t node)
+{
+    query_result_t result = {0};
+
+    esp_ot_link_quality_query(from, to, node, collect_points, &result);
+    return result;
+}
+
+static void add_samples(uint16_t reporter, uint16_t neighbor, const test_sample_t *samples, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        TEST_ASSERT_EQUAL(ESP_OK, esp_ot_link_quality_add_sample(reporter, neighbor, samples[i].in, samples[i].out,
+                                                                 samples[i].cost, samples[i].time));
+    }
+}
+
+static void assert_point(const esp_ot_link_quality_point_t *point, uint32_t time, uint16_t count, uint16_t in_x100,
+                         uint16_t out_x100, uint8_t min_in, uint8_t min_out, uint8_t max_cost)
+{
+    TEST_ASSERT_EQUAL(time, point->time);
+    TEST_ASSERT_EQUAL(count, point->count);
+    TEST_ASSERT_EQUAL(in_x100, point->link_quality_in_x100);
+    TEST_ASSERT_EQUAL(out_x100, point->link_quality_out_x100);
+    TEST_ASSERT_EQUAL(min_in, point->min_link_quality_in);
+    TEST_ASSERT_EQUAL(min_out, point->min_link_quality_out);
+    TEST_ASSERT_EQUAL(max_cost, point->max_route_cost);
+}
+
+static void test_memory_budget(void)
+{
+    uint16_t links = 0;
+    uint16_t max_links = 0;
+    size_t bytes = 0;
+
+    esp_ot_link_quality_get_usage(&links, &max_links, &bytes);
+    TEST_ASSERT_EQUAL(0, links);
+    TEST_ASSERT_EQUAL(TEST_LINKS, max_links);
+    TEST_ASSERT_EQUAL(TEST_LINKS * 320, bytes);
+}
+
+static void test_insert_day(void)
+{
+    uint16_t links = 0;
+    uint16_t max_links = 0;
+    size_t bytes = 0;
+
+    for (uint32_t time = CONFIG_OPENTHREAD_LINK_QUALITY_SAMPLE_INTERVAL; time <= TEST_DAY;
+         time += CONFIG_OPENTHREAD_LINK_QUALITY_SAMPLE_INTERVAL) {
+        for (uint16_t router = 0; router < TEST_ROUTERS; router++) {
+            for (uint16_t next = 1; next <= TEST_NEIGHBORS; next++) {
+                uint16_t reporter = router_rloc16(router);
+                uint16_t neighbor = router_rloc16(router + next);
+                uint8_t quality = (time / 600 + router + next) % 3 + 1;
+                TEST_ASSERT_EQUAL(ESP_OK, esp_ot_link_quality_add_sample(reporter, neighbor, quality, 3, next, time));
+            }
+        }
+    }
+    esp_ot_link_quality_get_usage(&links, &max_links, &bytes);
+    TEST_ASSERT_EQUAL(TEST_LINKS, links);
+}
+
+static void assert_day_query(uint32_t seconds, uint16_t node, uint16_t links,
+                             esp_ot_link_quality_resolution_t resolution, uint16_t points_per_link)
+{
+    query_result_t result = run_query(TEST_DAY - seconds, TEST_DAY, node);
+
+    TEST_ASSERT_EQUAL(links, result.links);
+    TEST_ASSERT_EQUAL(resolution, result.resolution);
+    TEST_ASSERT_EQUAL(links * points_per_link, result.points);
+}
+
+static void test_query_each_resolution(void)
+{
+    // The raw ring keeps the last 24 samples, 30 s apart, the last 600 s hold 21 of them.
+    assert_day_query(600, ESP_OT_LINK_QUALITY_ANY_NODE, TEST_LINKS, ESP_OT_LINK_QUALITY_RAW, 21);
+    assert_day_query(600, router_rloc16(5), 2 * TEST_NEIGHBORS, ESP_OT_LINK_QUALITY_RAW, 21);
+    assert_day_query(800, ESP_OT_LINK_QUALITY_ANY_NODE, TEST_LINKS, ESP_OT_LINK_QUALITY_MINUTE, 15);
+    assert_day_query(3 * 3600, ESP_OT_LINK_QUALITY_ANY_NODE, TEST_LINKS, ESP_OT_LINK_QUALITY_QUARTER, 13);
+    assert_day_query(TEST_DAY - 3600, ESP_OT_LINK_QUALITY_ANY_NODE, TEST_LINKS, ESP_OT_LINK_QUALITY_HOUR, 24);
+    assert_day_query(TEST_DAY - 3600, router_rloc16(5), 2 * TEST_NEIGHBORS, ESP_OT_LINK_QUALITY_HOUR, 24);
+}
+
+static void test_minute_rollups(void)
+{
+    // The RLOC16s of children are out of the mesh of the day, each link below replaces the oldest one.
+    static const test_sample_t s_samples[] = {
+        {6000, 3, 3, 1}, {6010, 2, 3, 2}, {6020, 1, 2, 5}, {6030, 3, 1, 1}, /* minute 100 */
+        {6060, 2, 2, 3}, {6090, 2, 1, 3},                                   /* minute 101 */
+    };
+    query_result_t result;
+
+    add_samples(0x0401, 0x0801, s_samples, 6);
+    // Reported by the higher RLOC16, in and out are stored swapped.
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_link_quality_add_sample(0x0801, 0x0401, 1, 3, 16, 6100));
+
+    result = run_query(6000, 6100, 0x0801);
+    TEST_ASSERT_EQUAL(1, result.links);
+    TEST_ASSERT_EQUAL(0x0401, result.router);
+    TEST_ASSERT_EQUAL(0x0801, result.neighbor);
+    TEST_ASSERT_EQUAL(ESP_OT_LINK_QUALITY_RAW, result.resolution);
+    TEST_ASSERT_EQUAL(7, result.count);
+    assert_point(&result.last[2], 6020, 1, 100, 200, 1, 2, 5);
+    // The route cost is capped at 15.
+    assert_point(&result.last[6], 6100, 1, 300, 100, 3, 1, 15);
+
+    // A start before the oldest raw sample is served by the rollups.
+    result = run_query(5999, 6100, 0x0401);
+    TEST_ASSERT_EQUAL(ESP_OT_LINK_QUALITY_MINUTE, result.resolution);
+    TEST_ASSERT_EQUAL(2, result.count);
+    // in (3 + 2 + 1 + 3) / 4, out (3 + 3 + 2 + 1) / 4
+    assert_point(&result.last[0], 6000, 4, 225, 225, 1, 1, 5);
+    // in (2 + 2 + 3) / 3 = 2.33, out (2 + 1 + 1) / 3 = 1.33, truncated to 1/64
+    assert_point(&result.last[1], 6060, 3, 232, 132, 2, 1, 15);
+}
+
+static void test_quarter_and_hour_rollups(void)
+{
+    static const test_sample_t s_samples[] = {
+        {36000, 3, 3, 1}, {36300, 1, 3, 2}, /* hour 10, quarter 40 */
+        {36900, 2, 2, 1},                   /* hour 10, quarter 41 */
+        {39600, 1, 1, 4}, {40000, 3, 2, 1}, /* hour 11, quarter 44 */
+    };
+    query_result_t result;
+
+    add_samples(0x0402, 0x0c02, s_samples, 5);
+
+    // The 1-minute rollups only cover the last 15 minutes.
+    result = run_query(35000, 40000, 0x0402);
+    TEST_ASSERT_EQUAL(1, result.links);
+    TEST_ASSERT_EQUAL(ESP_OT_LINK_QUALITY_QUARTER, result.resolution);
+    TEST_ASSERT_EQUAL(3, result.count);
+    assert_point(&result.last[0], 36000, 2, 200, 300, 1, 3, 2);
+    assert_point(&result.last[1], 36900, 1, 200, 200, 2, 2, 1);
+    assert_point(&result.last[2], 39600, 2, 200, 150, 1, 1, 4);
+
+    // The 15-minute rollups only cover the last 4 hours.
+    result = run_query(20000, 40000, 0x0402);
+    TEST_ASSERT_EQUAL(ESP_OT_LINK_QUALITY_HOUR, result.resolution);
+    TEST_ASSERT_EQUAL(2, result.count);
+    // out (3 + 3 + 2) / 3 = 2.67, truncated to 1/64
+    assert_point(&result.last[0], 36000, 3, 200, 265, 1, 2, 2);
+    assert_point(&result.last[1], 39600, 2, 200, 150, 1, 1, 4);
+
+    // A link down for a sample shows a min of 0.
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_link_quality_add_sample(0x0402, 0x0c02, 0, 0, 15, 40100));
+    result = run_query(20000, 40100, 0x0402);
+    assert_point(&result.last[1], 39600, 3, 132, 100, 0, 0, 15);
+}
+
+/* The bytes of a sample in the raw ring, the varint of its delta and the packed byte. */
+static uint8_t encoded_size(uint32_t delta)
+{
+    uint8_t size = 1;
+
+    do {
+        size++;
+        delta >>= 7;
+    } while (delta);
+    return size;
+}
+
+static void test_raw_ring_wraparound(void)
+{
+    static const uint32_t s_deltas[] = {200, 20, 20000};
+    test_sample_t samples[30];
+    uint32_t time = 100000;
+    size_t oldest = 0;
+    uint32_t bytes = 0;
+    query_result_t result;
+
+    for (size_t i = 0; i < 30; i++) {
+        time += i ? s_deltas[i % 3] : 0;
+        samples[i] = (test_sample_t){time, i % 4, (i + 1) % 4, i % 16};
+    }
+    add_samples(0x0403, 0x1003, samples, 30);
+
+    // The ring keeps the newest samples which fit, each encoded with the delta from its first predecessor.
+    for (oldest = 30; oldest > 0; oldest--) {
+        uint32_t size = encoded_size(oldest > 1 ? samples[oldest - 1].time - samples[oldest - 2].time : 0);
+        if (bytes + size > TEST_RAW_SIZE) {
+            break;
+        }
+        bytes += size;
+    }
+    // 3 + 2 + 4 bytes per 3 samples, the ring wrapped around several times.
+    TEST_ASSERT_EQUAL(15, 30 - oldest);
+
+    result = run_query(samples[oldest].time, samples[29].time, 0x1003);
+    TEST_ASSERT_EQUAL(ESP_OT_LINK_QUALITY_RAW, result.resolution);
+    TEST_ASSERT_EQUAL(30 - oldest, result.count);
+    for (size_t i = oldest; i < 30; i++) {
+        const test_sample_t *sample = &samples[i];
+        assert_point(&result.last[i - oldest], sample->time, 1, sample->in * 100, sample->out * 100, sample->in,
+                     sample->out, sample->cost);
+    }
+
+    // The dropped samples are only in the rollups.
+    result = run_query(samples[oldest].time - 1, samples[29].time, 0x1003);
+    TEST_ASSERT_TRUE(result.resolution != ESP_OT_LINK_QUALITY_RAW);
+
+    // The short deltas fill the ring with 2-byte samples, a query returns at most 24 of them.
+    for (size_t i = 0; i < 30; i++) {
+        time += 10;
+        TEST_ASSERT_EQUAL(ESP_OK, esp_ot_link_quality_add_sample(0x0403, 0x1003, 2, 2, 1, time));
+    }
+    result = run_query(time - 23 * 10, time, 0x1003);
+    TEST_ASSERT_EQUAL(ESP_OT_LINK_QUALITY_RAW, result.resolution);
+    TEST_ASSERT_EQUAL(ESP_OT_LINK_QUALITY_MAX_POINTS, result.count);
+    TEST_ASSERT_EQUAL(time - 23 * 10, result.last[0].time);
+    TEST_ASSERT_EQUAL(time, result.last[23].time);
+}
+
+int main(void)
+{
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_link_quality_init());
+
+    RUN_TEST(test_memory_budget);
+    RUN_TEST(test_insert_day);
+    RUN_TEST(test_query_each_resolution);
+    RUN_TEST(test_minute_rollups);
+    RUN_TEST(test_quarter_and_hour_rollups);
+    RUN_TEST(test_raw_ring_wraparound);
+    return 0;
+}
@@ -0,0 +1,223 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "esp_log.h"
+#include "esp_ot_log_ringbuf.h"
+#include "host_test.h"
+#include "sdkconfig.h"
+
+/*
+ * Measures the cost of ESP_LOGI per call on a 115200-baud console, before the deferred backend is installed and
+ * after. The console is modelled as the UART of the ROM console: the line is copied into a 128-byte TX FIFO, which
+ * empties at 10 bits per byte, and the caller busy-waits for room. The lines of the test carry the producer and a
+ * sequence number, so the console checks that each line comes out once and in order. Last, concurrent producers of
+ * another tag log more lines than the per-tag rate limit within one window, and exactly the limit gets through.
+ */
+#define TEST_TAG "ring_bench"
+#define TEST_BAUD 115200
+#define TEST_FIFO_SIZE 128
+#define TEST_CALLS 100
+#define TEST_PRODUCERS 4
+#define TEST_PRODUCER_LINES 500
+#define TEST_DRAIN_TIMEOUT_MS 5000
+#define TEST_RATE_TAG "ring_rate"
+#define TEST_RATE_LINES (CONFIG_OPENTHREAD_LOG_RINGBUF_TAG_RATE_LIMIT / TEST_PRODUCERS + 500)
+
+static pthread_mutex_t s_console_lock = PTHREAD_MUTEX_INITIALIZER;
+static int64_t s_fifo_empty_ns;
+static uint32_t s_lines[TEST_PRODUCERS + 1];
+static int32_t s_last_sequence[TEST_PRODUCERS + 1];
+static uint32_t s_dropped;
+static uint32_t s_out_of_order;
+static uint32_t s_rate_lines;
+
+static int64_t now_ns(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+static void sleep_ms(uint32_t ms)
+{
+    struct timespec delay = {.tv_sec = ms / 1000, .tv_nsec = (long)(ms % 1000) * 1000000};
+    nanosleep(&delay, NULL);
+}
+
+static void console_check(const char *line)
+{
+    const char *message = strstr(line, TEST_TAG ": ");
+    unsigned long dropped = 0;
+    int producer = 0;
+    int sequence = 0;
+
+    if (sscanf(line, "W (%*u) %*s %lu log lines dropped", &dropped) == 1) {
+        s_dropped += dropped;
+    } else if (message && sscanf(message + strlen(TEST_TAG ": "), "p%d %d", &producer, &sequence) == 2 &&
+               producer >= 0 && producer <= TEST_PRODUCERS) {
+        s_out_of_order += sequence <= s_last_sequence[producer];
+        s_last_sequence[producer] = sequence;
+        s_lines[producer]++;
+    } else if (strstr(line, TEST_RATE_TAG ": ")) {
+        s_rate_lines++;
+    }
+}
+
+static int console_vprintf(const char *format, va_list args)
+{
+    char line[CONFIG_OPENTHREAD_LOG_RINGBUF_LINE_MAX + 64];
+    int len = vsnprintf(line, sizeof(line), format, args);
+    int64_t byte_ns = 10 * 1000000000LL / TEST_BAUD;
+
+    pthread_mutex_lock(&s_console_lock);
+    for (int i = 0; i < len; i++) {
+        // Wait for room in the FIFO, then queue the byte behind the ones not sent yet.
+        while (s_fifo_empty_ns - now_ns() > (TEST_FIFO_SIZE - 1) * byte_ns) {
+        }
+        int64_t now = now_ns();
+        s_fifo_empty_ns = (s_fifo_empty_ns > now ? s_fifo_empty_ns : now) + byte_ns;
+    }
+    console_check(line);
+    pthread_mutex_unlock(&s_console_lock);
+    return len;
+}
+
+static void console_reset(void)
+{
+    pthread_mutex_lock(&s_console_lock);
+    memset(s_lines, 0, sizeof(s_lines));
+    memset(s_last_sequence, 0xff, sizeof(s_last_sequence));
+    s_dropped = 0;
+    s_out_of_order = 0;
+    s_rate_lines = 0;
+    pthread_mutex_unlock(&s_console_lock);
+}
+
+static uint32_t console_total(void)
+{
+    uint32_t total = s_dropped + s_rate_lines;
+
+    pthread_mutex_lock(&s_console_lock);
+    for (int i = 0; i <= TEST_PRODUCERS; i++) {
+        total += s_lines[i];
+    }
+    pthread_mutex_unlock(&s_console_lock);
+    return total;
+}
+
+static void wait_console_total(uint32_t expected)
+{
+    for (uint32_t waited = 0; console_total() < expected && waited < TEST_DRAIN_TIMEOUT_MS; waited += 10) {
+        sleep_ms(10);
+    }
+    TEST_ASSERT_EQUAL(expected, console_total());
+    TEST_ASSERT_EQUAL(0, s_out_of_order);
+}
+
+/* The average cost of ESP_LOGI for the calling task, in ns, the console being idle first. */
+static int64_t log_cost_ns(void)
+{
+    sleep_ms(50);
+    int64_t start = now_ns();
+    for (int i = 0; i < TEST_CALLS; i++) {
+        ESP_LOGI(TEST_TAG, "p%d %d", TEST_PRODUCERS, i);
+    }
+    return (now_ns() - start) / TEST_CALLS;
+}
+
+static int64_t s_direct_ns;
+
+static void test_direct_cost(void)
+{
+    console_reset();
+    s_direct_ns = log_cost_ns();
+    printf("direct: %lld ns per call\n", (long long)s_direct_ns);
+    TEST_ASSERT_EQUAL(TEST_CALLS, s_lines[TEST_PRODUCERS]);
+}
+
+static void test_deferred_cost(void)
+{
+    console_reset();
+    int64_t deferred_ns = log_cost_ns();
+    printf("deferred: %lld ns per call, %lldx cheaper\n", (long long)deferred_ns,
+           (long long)(s_direct_ns / (deferred_ns ? deferred_ns : 1)));
+    TEST_ASSERT(deferred_ns * 10 < s_direct_ns);
+    // The ring holds all the lines of the burst, none is dropped.
+    wait_console_total(TEST_CALLS);
+    TEST_ASSERT_EQUAL(TEST_CALLS, s_lines[TEST_PRODUCERS]);
+}
+
+static void *producer_thread(void *ctx)
+{
+    int producer = (int)(intptr_t)ctx;
+
+    for (int i = 0; i < TEST_PRODUCER_LINES; i++) {
+        ESP_LOGI(TEST_TAG, "p%d %d", producer, i);
+    }
+    return NULL;
+}
+
+static void test_concurrent_producers(void)
+{
+    pthread_t threads[TEST_PRODUCERS];
+
+    console_reset();
+    for (intptr_t i = 0; i < TEST_PRODUCERS; i++) {
+        TEST_ASSERT_EQUAL(0, pthread_create(&threads[i], NULL, producer_thread, (void *)i));
+    }
+    for (int i = 0; i < TEST_PRODUCERS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    // Each line is printed once and in order, or counted as dropped when the ring is full.
+    wait_console_total(TEST_PRODUCERS * TEST_PRODUCER_LINES);
+    printf("concurrent: %u lines printed, %u dropped\n", (unsigned)(TEST_PRODUCERS * TEST_PRODUCER_LINES - s_dropped),
+           (unsigned)s_dropped);
+}
+
+static void *rate_producer_thread(void *ctx)
+{
+    for (int i = 0; i < TEST_RATE_LINES; i++) {
+        ESP_LOGI(TEST_RATE_TAG, "%d", i);
+    }
+    return NULL;
+}
+
+static void test_tag_rate_limit(void)
+{
+    pthread_t threads[TEST_PRODUCERS];
+
+    console_reset();
+    for (int i = 0; i < TEST_PRODUCERS; i++) {
+        TEST_ASSERT_EQUAL(0, pthread_create(&threads[i], NULL, rate_producer_thread, NULL));
+    }
+    for (int i = 0; i < TEST_PRODUCERS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    // The lines over the limit are dropped before the ring, the others are printed or dropped when the ring is full.
+    wait_console_total(CONFIG_OPENTHREAD_LOG_RINGBUF_TAG_RATE_LIMIT);
+    sleep_ms(100);
+    TEST_ASSERT_EQUAL(CONFIG_OPENTHREAD_LOG_RINGBUF_TAG_RATE_LIMIT, console_total());
+}
+
+int main(void)
+{
+    esp_log_set_vprintf(console_vprintf);
+
+    RUN_TEST(test_direct_cost);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_log_ringbuf_init());
+    RUN_TEST(test_deferred_cost);
+    RUN_TEST(test_concurrent_producers);
+    RUN_TEST(test_tag_rate_limit);
+    return 0;
+}
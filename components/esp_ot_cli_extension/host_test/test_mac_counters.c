@@ -0,0 +1,334 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "esp_openthread.h"
+#include "esp_ot_mac_counters.h"
+#include "esp_timer.h"
+#include "host_test.h"
+#include "openthread/link.h"
+#include "openthread/thread_ftd.h"
+#include "sdkconfig.h"
+
+/*
+ * Feeds the store with the MAC Counters and Route TLVs of a few routers and checks the deltas, the rates, the window,
+ * the ranking of the nodes and of the links, and the replacement of the least recently updated node. The tests share
+ * the store, each one uses its own RLOC16s.
+ */
+#define TEST_INTERVAL 300
+#define TEST_NODE_A 0x0400
+#define TEST_NODE_B 0x0800
+#define TEST_NODE_C 0x0c00
+#define TEST_NODE_D 0x1000
+#define TEST_NODE_E 0x1400
+#define TEST_NODE_F 0x1800
+#define TEST_NODE_G 0x1c00 /* only known by the Route TLV of E */
+#define TEST_NODE_LOCAL 0x2000
+
+static otMacCounters s_local_counters;
+
+otInstance *esp_openthread_get_instance(void)
+{
+    return NULL;
+}
+
+otDeviceRole otThreadGetDeviceRole(otInstance *instance)
+{
+    return OT_DEVICE_ROLE_CHILD;
+}
+
+uint16_t otThreadGetRloc16(otInstance *instance)
+{
+    return TEST_NODE_LOCAL;
+}
+
+uint8_t otThreadGetMaxRouterId(otInstance *instance)
+{
+    return OT_NETWORK_MAX_ROUTER_ID;
+}
+
+otError otThreadGetRouterInfo(otInstance *instance, uint16_t router_id, otRouterInfo *router_info)
+{
+    return OT_ERROR_NOT_FOUND;
+}
+
+const otMacCounters *otLinkGetCounters(otInstance *instance)
+{
+    return &s_local_counters;
+}
+
+static uint32_t now_s(void)
+{
+    return (uint32_t)(esp_timer_get_time() / 1000000);
+}
+
+static otNetworkDiagMacCounters diag_counters(uint32_t tx, uint32_t tx_errors, uint32_t rx, uint32_t rx_errors,
+                                              uint32_t discards)
+{
+    /* Split across the unicast, broadcast, error and discard counters as OpenThread reports them. */
+    otNetworkDiagMacCounters counters = {
+        .mIfOutUcastPkts = tx - tx / 4,
+        .mIfOutBroadcastPkts = tx / 4,
+        .mIfOutErrors = tx_errors - tx_errors / 2,
+        .mIfOutDiscards = tx_errors / 2,
+        .mIfInUcastPkts = rx - rx / 4,
+        .mIfInBroadcastPkts = rx / 4,
+        .mIfInErrors = rx_errors,
+        .mIfInDiscards = discards - discards / 2,
+        .mIfInUnknownProtos = discards / 2,
+    };
+    return counters;
+}
+
+static void add_counters(uint16_t rloc16, uint32_t tx, uint32_t tx_errors, uint32_t rx, uint32_t rx_errors,
+                         uint32_t discards, uint32_t time)
+{
+    otNetworkDiagMacCounters counters = diag_counters(tx, tx_errors, rx, rx_errors, discards);
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_mac_counters_add_diag(rloc16, &counters, time));
+}
+
+static void add_route(uint16_t rloc16, uint16_t neighbor, uint8_t link_quality_in, uint8_t link_quality_out)
+{
+    otNetworkDiagRoute route = {.mRouteCount = 2};
+
+    /* The route to the reporter itself is ignored. */
+    route.mRouteData[0].mRouterId = rloc16 >> 10;
+    route.mRouteData[0].mLinkQualityIn = 3;
+    route.mRouteData[0].mLinkQualityOut = 3;
+    route.mRouteData[1].mRouterId = neighbor >> 10;
+    route.mRouteData[1].mLinkQualityIn = link_quality_in;
+    route.mRouteData[1].mLinkQualityOut = link_quality_out;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_mac_counters_add_route(rloc16, &route));
+}
+
+static void test_deltas_and_resets(void)
+{
+    esp_ot_mac_counters_node_stats_t stats;
+    esp_ot_mac_counters_interval_t intervals[CONFIG_OPENTHREAD_MAC_COUNTERS_HISTORY];
+    uint32_t base = now_s() - 20 * TEST_INTERVAL;
+
+    add_counters(TEST_NODE_A, 100, 0, 100, 0, 1, base);
+    add_counters(TEST_NODE_A, 200, 10, 200, 5, 3, base + TEST_INTERVAL);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_mac_counters_get_node(TEST_NODE_A, 0, &stats, intervals, 4));
+    TEST_ASSERT_EQUAL(1, stats.intervals);
+    TEST_ASSERT_EQUAL(0, stats.resets);
+    TEST_ASSERT_EQUAL(base + TEST_INTERVAL, intervals[0].time);
+    TEST_ASSERT_EQUAL(TEST_INTERVAL, intervals[0].duration);
+    TEST_ASSERT_EQUAL(100, intervals[0].tx_frames);
+    TEST_ASSERT_EQUAL(10, intervals[0].tx_errors);
+    TEST_ASSERT_EQUAL(100, intervals[0].rx_frames);
+    TEST_ASSERT_EQUAL(5, intervals[0].rx_errors);
+    TEST_ASSERT_EQUAL(2, intervals[0].rx_discards);
+    TEST_ASSERT_EQUAL(100, stats.tx_error_permille);
+    TEST_ASSERT_EQUAL(5 * 1000 / 105, stats.rx_error_permille);
+    TEST_ASSERT_EQUAL(ESP_OT_MAC_COUNTERS_UNKNOWN, stats.retry_permille);
+    /* 207 frames of 2400 us in 300 s. */
+    TEST_ASSERT_EQUAL(207ULL * 2400 * 1000 / (TEST_INTERVAL * 1000000ULL), stats.utilization_permille);
+    TEST_ASSERT_EQUAL(100, stats.score_permille);
+
+    /* A reboot of the node restarts its counters, the interval across it is unknown. */
+    add_counters(TEST_NODE_A, 50, 1, 40, 0, 0, base + 2 * TEST_INTERVAL);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_mac_counters_get_node(TEST_NODE_A, 0, &stats, NULL, 0));
+    TEST_ASSERT_EQUAL(1, stats.intervals);
+    TEST_ASSERT_EQUAL(1, stats.resets);
+    add_counters(TEST_NODE_A, 150, 1, 140, 0, 0, base + 3 * TEST_INTERVAL);
+    /* A second response in the same second only refreshes the totals. */
+    add_counters(TEST_NODE_A, 160, 1, 150, 0, 0, base + 3 * TEST_INTERVAL);
+    add_counters(TEST_NODE_A, 260, 1, 250, 0, 0, base + 4 * TEST_INTERVAL);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_mac_counters_get_node(TEST_NODE_A, 0, &stats, intervals, 4));
+    TEST_ASSERT_EQUAL(3, stats.intervals);
+    TEST_ASSERT_EQUAL(100, intervals[1].tx_frames);
+    TEST_ASSERT_EQUAL(0, intervals[1].tx_errors);
+    TEST_ASSERT_EQUAL(100, intervals[2].tx_frames);
+    TEST_ASSERT_EQUAL(100, intervals[2].rx_frames);
+    TEST_ASSERT_EQUAL(300, stats.sum.tx_frames);
+    TEST_ASSERT_EQUAL(10, stats.sum.tx_errors);
+    TEST_ASSERT_EQUAL(3 * TEST_INTERVAL, stats.sum.duration);
+    TEST_ASSERT_EQUAL(10 * 1000 / 300, stats.tx_error_permille);
+}
+
+static void test_history_and_window(void)
+{
+    esp_ot_mac_counters_node_stats_t stats;
+    esp_ot_mac_counters_interval_t intervals[CONFIG_OPENTHREAD_MAC_COUNTERS_HISTORY];
+    uint32_t end = now_s();
+    uint32_t count = CONFIG_OPENTHREAD_MAC_COUNTERS_HISTORY + 2;
+
+    /* Interval n has n * 10 frames sent. */
+    for (uint32_t i = 0, tx = 0; i <= count; tx += (i + 1) * 10, i++) {
+        add_counters(TEST_NODE_B, tx, 0, tx, 0, 0, end - (count - i) * TEST_INTERVAL);
+    }
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_mac_counters_get_node(TEST_NODE_B, 0, &stats, intervals,
+                                                           CONFIG_OPENTHREAD_MAC_COUNTERS_HISTORY));
+    TEST_ASSERT_EQUAL(CONFIG_OPENTHREAD_MAC_COUNTERS_HISTORY, stats.intervals);
+    for (uint32_t i = 0; i < CONFIG_OPENTHREAD_MAC_COUNTERS_HISTORY; i++) {
+        uint32_t n = count - CONFIG_OPENTHREAD_MAC_COUNTERS_HISTORY + i + 1;
+        TEST_ASSERT_EQUAL(end - (count - n) * TEST_INTERVAL, intervals[i].time);
+        TEST_ASSERT_EQUAL(n * 10, intervals[i].tx_frames);
+    }
+
+    /* The window keeps the intervals which ended in it: those ending now, 300 s and 600 s ago. */
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_mac_counters_get_node(TEST_NODE_B, 2 * TEST_INTERVAL + 100, &stats, intervals,
+                                                           CONFIG_OPENTHREAD_MAC_COUNTERS_HISTORY));
+    TEST_ASSERT_EQUAL(3, stats.intervals);
+    TEST_ASSERT_EQUAL((count - 2) * 10 + (count - 1) * 10 + count * 10, stats.sum.tx_frames);
+    TEST_ASSERT_EQUAL(end, intervals[2].time);
+}
+
+static void test_local_retries(void)
+{
+    esp_ot_mac_counters_node_stats_t stats;
+    uint32_t end = now_s();
+
+    memset(&s_local_counters, 0, sizeof(s_local_counters));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_mac_counters_sample_local(end - TEST_INTERVAL));
+    s_local_counters.mTxUnicast = 80;
+    s_local_counters.mTxBroadcast = 20;
+    s_local_counters.mTxRetry = 25;
+    s_local_counters.mTxErrCca = 2;
+    s_local_counters.mRxUnicast = 100;
+    s_local_counters.mRxErrFcs = 3;
+    s_local_counters.mRxErrSec = 1;
+    s_local_counters.mRxDuplicated = 4;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_mac_counters_sample_local(end));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_mac_counters_get_node(TEST_NODE_LOCAL, 0, &stats, NULL, 0));
+    TEST_ASSERT_EQUAL(1, stats.intervals);
+    TEST_ASSERT_EQUAL(100, stats.sum.tx_frames);
+    TEST_ASSERT_EQUAL(25, stats.sum.tx_retries);
+    TEST_ASSERT_EQUAL(4, stats.sum.rx_errors);
+    TEST_ASSERT_EQUAL(4, stats.sum.rx_discards);
+    TEST_ASSERT_EQUAL(25 * 1000 / 125, stats.retry_permille);
+    /* The retries are the worst rate of the node. */
+    TEST_ASSERT_EQUAL(stats.retry_permille, stats.score_permille);
+}
+
+/* C sends with 90% errors, D 5%, E none and F has too few frames to be ranked. */
+static void add_ranked_nodes(void)
+{
+    uint32_t end = now_s();
+
+    add_counters(TEST_NODE_C, 0, 0, 0, 0, 0, end - TEST_INTERVAL);
+    add_counters(TEST_NODE_C, 100, 90, 100, 0, 0, end);
+    add_counters(TEST_NODE_D, 0, 0, 0, 0, 0, end - TEST_INTERVAL);
+    add_counters(TEST_NODE_D, 200, 10, 100, 0, 0, end);
+    add_counters(TEST_NODE_E, 0, 0, 0, 0, 0, end - TEST_INTERVAL);
+    add_counters(TEST_NODE_E, 100, 0, 100, 0, 0, end);
+    add_counters(TEST_NODE_F, 0, 0, 0, 0, 0, end - TEST_INTERVAL);
+    add_counters(TEST_NODE_F, 5, 5, 5, 0, 0, end);
+}
+
+static int node_position(const esp_ot_mac_counters_node_stats_t *nodes, uint16_t count, uint16_t rloc16)
+{
+    for (uint16_t i = 0; i < count; i++) {
+        if (nodes[i].rloc16 == rloc16) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void test_worst_nodes(void)
+{
+    esp_ot_mac_counters_node_stats_t nodes[CONFIG_OPENTHREAD_MAC_COUNTERS_MAX_NODES];
+
+    add_ranked_nodes();
+    uint16_t count = esp_ot_mac_counters_get_worst_nodes(0, nodes, CONFIG_OPENTHREAD_MAC_COUNTERS_MAX_NODES);
+    /* A, B, C, D, E and this node, F has too few frames. */
+    TEST_ASSERT_EQUAL(6, count);
+    for (uint16_t i = 1; i < count; i++) {
+        TEST_ASSERT(nodes[i - 1].score_permille >= nodes[i].score_permille);
+    }
+    TEST_ASSERT_EQUAL(TEST_NODE_C, nodes[0].rloc16);
+    TEST_ASSERT_EQUAL(900, nodes[0].score_permille);
+    TEST_ASSERT(node_position(nodes, count, TEST_NODE_D) < node_position(nodes, count, TEST_NODE_E));
+    TEST_ASSERT_EQUAL(-1, node_position(nodes, count, TEST_NODE_F));
+
+    /* A full output keeps the worst ones. */
+    TEST_ASSERT_EQUAL(2, esp_ot_mac_counters_get_worst_nodes(0, nodes, 2));
+    TEST_ASSERT_EQUAL(TEST_NODE_C, nodes[0].rloc16);
+    TEST_ASSERT_EQUAL(TEST_NODE_LOCAL, nodes[1].rloc16);
+}
+
+static const esp_ot_mac_counters_link_stats_t *find_link(const esp_ot_mac_counters_link_stats_t *links,
+                                                         uint16_t count, uint16_t router, uint16_t neighbor)
+{
+    for (uint16_t i = 0; i < count; i++) {
+        if (links[i].router == router && links[i].neighbor == neighbor) {
+            return &links[i];
+        }
+    }
+    return NULL;
+}
+
+static void test_worst_links(void)
+{
+    esp_ot_mac_counters_link_stats_t links[8];
+
+    /* C and D report their link with different qualities, it is ranked once with the lowest one. */
+    add_route(TEST_NODE_C, TEST_NODE_D, 3, 2);
+    add_route(TEST_NODE_D, TEST_NODE_C, 1, 3);
+    add_route(TEST_NODE_E, TEST_NODE_G, 2, 3);
+    add_route(TEST_NODE_F, TEST_NODE_E, 3, 3);
+
+    uint16_t count = esp_ot_mac_counters_get_worst_links(0, links, 8);
+    TEST_ASSERT_EQUAL(3, count);
+    const esp_ot_mac_counters_link_stats_t *link = find_link(links, count, TEST_NODE_C, TEST_NODE_D);
+    TEST_ASSERT_NOT_NULL(link);
+    TEST_ASSERT_EQUAL(1, link->link_quality);
+    TEST_ASSERT_EQUAL((900 + 50) / 2, link->node_tx_error_permille);
+    TEST_ASSERT(link == &links[0]);
+    /* G has no counters, the rate of E is the only one known. */
+    link = find_link(links, count, TEST_NODE_E, TEST_NODE_G);
+    TEST_ASSERT_NOT_NULL(link);
+    TEST_ASSERT_EQUAL(2, link->link_quality);
+    TEST_ASSERT_EQUAL(0, link->node_tx_error_permille);
+    /* Only F reports its link to E, F is not ranked so the rate of E is the only one known. */
+    link = find_link(links, count, TEST_NODE_E, TEST_NODE_F);
+    TEST_ASSERT_NOT_NULL(link);
+    TEST_ASSERT_EQUAL(3, link->link_quality);
+    TEST_ASSERT_EQUAL(0, link->node_tx_error_permille);
+    TEST_ASSERT(link == &links[2]);
+
+    /* Neither router of a link has enough frames, its rate is not known. */
+    add_route(TEST_NODE_F, TEST_NODE_G, 3, 3);
+    count = esp_ot_mac_counters_get_worst_links(0, links, 8);
+    link = find_link(links, count, TEST_NODE_F, TEST_NODE_G);
+    TEST_ASSERT_NOT_NULL(link);
+    TEST_ASSERT_EQUAL(ESP_OT_MAC_COUNTERS_UNKNOWN, link->node_tx_error_permille);
+}
+
+static void test_replace_oldest(void)
+{
+    esp_ot_mac_counters_node_stats_t stats;
+    uint32_t end = now_s();
+
+    /* A, B, C, D, E, F and this node, the next node fills the store and the one after replaces A. */
+    add_counters(0x2400, 0, 0, 0, 0, 0, end);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_mac_counters_get_node(TEST_NODE_A, 0, &stats, NULL, 0));
+    add_counters(0x2800, 0, 0, 0, 0, 0, end);
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, esp_ot_mac_counters_get_node(TEST_NODE_A, 0, &stats, NULL, 0));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_mac_counters_get_node(0x2800, 0, &stats, NULL, 0));
+    TEST_ASSERT_EQUAL(0, stats.intervals);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_mac_counters_get_node(TEST_NODE_B, 0, &stats, NULL, 0));
+}
+
+int main(void)
+{
+    /* The intervals of the tests end up to 2 hours in the past of the time since boot. */
+    stub_timer_advance_ms(86400 * 1000);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_mac_counters_init());
+
+    RUN_TEST(test_deltas_and_resets);
+    RUN_TEST(test_history_and_window);
+    RUN_TEST(test_local_retries);
+    RUN_TEST(test_worst_nodes);
+    RUN_TEST(test_worst_links);
+    RUN_TEST(test_replace_oldest);
+    return 0;
+}
@@ -0,0 +1,499 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <arpa/inet.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_netif.h"
+#include "esp_ot_wifi_cmd.h"
+#include "esp_timer.h"
+#include "esp_wifi.h"
+#include "host_test.h"
+#include "nvs.h"
+#include "mbedtls/pkcs5.h"
+#include "freertos/event_groups.h"
+
+/*
+ * Connects the station to a simulated access point through the Wi-Fi command. The driver of the test resolves each
+ * connection attempt against the access point, on a clock advanced by the time an attempt takes, and fires the
+ * reconnect timer when it has nothing else to do. The tests share the connection and run in order.
+ */
+#define TEST_SSID "threadAP"
+#define TEST_PASSWORD "threadpass"
+#define TEST_DIRECT_MS 30   /* A probe of one channel */
+#define TEST_SCAN_MS 1500   /* A scan of all the channels */
+#define TEST_MAX_STEPS 1000 /* Of the driver while waiting for a connection */
+
+typedef struct {
+    bool up;
+    uint8_t bssid[6];
+    uint8_t channel;
+    wifi_auth_mode_t authmode;
+} access_point_t;
+
+struct stub_timer {
+    esp_timer_cb_t callback;
+    void *arg;
+    bool armed;
+    uint64_t timeout_us;
+};
+
+struct stub_event_group {
+    EventBits_t bits;
+};
+
+static access_point_t s_ap = {
+    .up = true,
+    .bssid = {0x24, 0x0a, 0xc4, 0x00, 0x00, 0x01},
+    .channel = 6,
+    .authmode = WIFI_AUTH_WPA2_PSK,
+};
+static struct stub_timer s_timer;
+static struct stub_event_group s_group;
+static wifi_config_t s_config;   /* Of the last attempt */
+static bool s_pending;           /* An attempt waits for the driver */
+static bool s_associated;
+static int s_fail_attempts;      /* The attempts to fail before the access point comes back up */
+static int s_direct_attempts;
+static int s_scan_attempts;
+static uint32_t s_backoffs_ms[16];
+static int s_backoff_count;
+
+static void clear_counts(void)
+{
+    s_direct_attempts = 0;
+    s_scan_attempts = 0;
+    s_backoff_count = 0;
+}
+
+/* The password the driver accepts from the station: the passphrase, or its 64 hex digit key with WPA-PSK. */
+static bool password_accepted(const wifi_sta_config_t *sta)
+{
+    uint8_t pmk[32];
+    char hex[65];
+
+    if (strncmp((const char *)sta->password, TEST_PASSWORD, sizeof(sta->password)) == 0) {
+        return true;
+    }
+    if (s_ap.authmode != WIFI_AUTH_WPA2_PSK && s_ap.authmode != WIFI_AUTH_WPA_WPA2_PSK) {
+        return false;
+    }
+    mbedtls_pkcs5_pbkdf2_hmac_ext(MBEDTLS_MD_SHA1, (const unsigned char *)TEST_PASSWORD, strlen(TEST_PASSWORD),
+                                  (const unsigned char *)TEST_SSID, strlen(TEST_SSID), 4096, sizeof(pmk), pmk);
+    for (size_t i = 0; i < sizeof(pmk); i++) {
+        snprintf(hex + 2 * i, 3, "%02x", pmk[i]);
+    }
+    return memcmp(sta->password, hex, 64) == 0;
+}
+
+static bool password_is_pmk(const wifi_sta_config_t *sta)
+{
+    return strnlen((const char *)sta->password, sizeof(sta->password)) == sizeof(sta->password);
+}
+
+static void disconnected(uint8_t reason)
+{
+    wifi_event_sta_disconnected_t event;
+
+    memset(&event, 0, sizeof(event));
+    event.reason = reason;
+    s_associated = false;
+    stub_event_post(WIFI_EVENT, WIFI_EVENT_STA_DISCONNECTED, &event);
+}
+
+static void connected(void)
+{
+    wifi_event_sta_connected_t connected;
+    ip_event_got_ip6_t got_ip6;
+
+    memset(&connected, 0, sizeof(connected));
+    memcpy(connected.bssid, s_ap.bssid, sizeof(connected.bssid));
+    connected.channel = s_ap.channel;
+    connected.authmode = s_ap.authmode;
+    s_associated = true;
+    stub_event_post(WIFI_EVENT, WIFI_EVENT_STA_CONNECTED, &connected);
+
+    stub_event_post(IP_EVENT, IP_EVENT_STA_GOT_IP, NULL);
+    memset(&got_ip6, 0, sizeof(got_ip6));
+    got_ip6.esp_netif = esp_netif_get_handle_from_ifkey("WIFI_STA_DEF");
+    got_ip6.ip6_info.ip.addr[0] = htonl(0x2001db8); /* A global address first, the station waits for a link-local */
+    stub_event_post(IP_EVENT, IP_EVENT_GOT_IP6, &got_ip6);
+    got_ip6.ip6_info.ip.addr[0] = htonl(0xfe800000);
+    stub_event_post(IP_EVENT, IP_EVENT_GOT_IP6, &got_ip6);
+}
+
+/* Resolves the pending attempt or fires the reconnect timer, returns false if there is nothing to do. */
+static bool driver_step(void)
+{
+    if (s_pending) {
+        const wifi_sta_config_t *sta = &s_config.sta;
+        bool direct = sta->bssid_set;
+
+        s_pending = false;
+        stub_timer_advance_ms(direct ? TEST_DIRECT_MS : TEST_SCAN_MS);
+        if (s_fail_attempts > 0) {
+            s_fail_attempts--;
+            disconnected(WIFI_REASON_NO_AP_FOUND);
+        } else if (!s_ap.up ||
+                   (direct && (sta->channel != s_ap.channel || memcmp(sta->bssid, s_ap.bssid, 6) != 0))) {
+            disconnected(WIFI_REASON_NO_AP_FOUND);
+        } else if (!password_accepted(sta)) {
+            disconnected(WIFI_REASON_AUTH_FAIL);
+        } else {
+            connected();
+        }
+        return true;
+    }
+    if (s_timer.armed) {
+        s_timer.armed = false;
+        TEST_ASSERT(s_backoff_count < (int)(sizeof(s_backoffs_ms) / sizeof(s_backoffs_ms[0])));
+        s_backoffs_ms[s_backoff_count++] = s_timer.timeout_us / 1000;
+        stub_timer_advance_ms(s_timer.timeout_us / 1000);
+        s_timer.callback(s_timer.arg);
+        return true;
+    }
+    return false;
+}
+
+static void driver_run(void)
+{
+    for (int i = 0; i < TEST_MAX_STEPS && driver_step(); i++) {
+    }
+    TEST_ASSERT_FALSE(s_pending || s_timer.armed);
+}
+
+esp_err_t esp_wifi_set_config(wifi_interface_t interface, wifi_config_t *conf)
+{
+    TEST_ASSERT_EQUAL(WIFI_IF_STA, interface);
+    s_config = *conf;
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_connect(void)
+{
+    TEST_ASSERT_FALSE(s_pending || s_associated);
+    if (s_config.sta.bssid_set) {
+        s_direct_attempts++;
+    } else {
+        s_scan_attempts++;
+    }
+    s_pending = true;
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_disconnect(void)
+{
+    s_pending = false;
+    s_associated = false;
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_set_ps(wifi_ps_type_t type)
+{
+    return ESP_OK;
+}
+
+void example_wifi_start(void)
+{
+}
+
+esp_netif_t *get_example_netif(void)
+{
+    return esp_netif_get_handle_from_ifkey("WIFI_STA_DEF");
+}
+
+void esp_openthread_task_switching_lock_release(void)
+{
+}
+
+bool esp_openthread_task_switching_lock_acquire(TickType_t block_ticks)
+{
+    return true;
+}
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t *create_args, esp_timer_handle_t *out_handle)
+{
+    s_timer.callback = create_args->callback;
+    s_timer.arg = create_args->arg;
+    *out_handle = &s_timer;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeout_us)
+{
+    TEST_ASSERT_FALSE(timer->armed);
+    timer->armed = true;
+    timer->timeout_us = timeout_us;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer)
+{
+    if (!timer->armed) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    timer->armed = false;
+    return ESP_OK;
+}
+
+EventGroupHandle_t xEventGroupCreate(void)
+{
+    return &s_group;
+}
+
+EventBits_t xEventGroupSetBits(EventGroupHandle_t group, EventBits_t bits)
+{
+    group->bits |= bits;
+    return group->bits;
+}
+
+EventBits_t xEventGroupClearBits(EventGroupHandle_t group, EventBits_t bits)
+{
+    EventBits_t previous = group->bits;
+
+    group->bits &= ~bits;
+    return previous;
+}
+
+/* The join waits here, the driver makes one step per wait. */
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t group, EventBits_t bits, BaseType_t clear_on_exit,
+                                BaseType_t wait_for_all, TickType_t ticks)
+{
+    static int s_idle_waits = 0;
+
+    if (driver_step()) {
+        s_idle_waits = 0;
+    } else {
+        TEST_ASSERT_MESSAGE(++s_idle_waits < TEST_MAX_STEPS, "the join waits for events which never come");
+        stub_timer_advance_ms(ticks);
+    }
+    return group->bits;
+}
+
+static otError command(const char *line)
+{
+    char buf[128];
+    char *args[8];
+    uint8_t count = 0;
+
+    snprintf(buf, sizeof(buf), "%s", line);
+    for (char *arg = strtok(buf, " "); arg != NULL && count < 8; arg = strtok(NULL, " ")) {
+        args[count++] = arg;
+    }
+    return esp_ot_process_wifi_cmd(NULL, count, args);
+}
+
+static bool ap_cache_stored(void)
+{
+    uint8_t buf[128];
+    size_t length = sizeof(buf);
+    nvs_handle_t handle;
+
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_open("wifi_config", NVS_READWRITE, &handle));
+    return nvs_get_blob(handle, "apcache", buf, &length) == ESP_OK;
+}
+
+/* Without a cached access point, the first join scans with the passphrase and caches the access point. */
+static void test_first_join_by_scan(void)
+{
+    char ssid[32] = "";
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_wifi_config_init());
+    TEST_ASSERT_EQUAL(OT_ERROR_NONE, command("connect -s " TEST_SSID " -p " TEST_PASSWORD));
+    TEST_ASSERT_EQUAL(OT_WIFI_CONNECTED, esp_ot_wifi_state_get());
+    TEST_ASSERT_EQUAL(1, s_scan_attempts);
+    TEST_ASSERT_EQUAL(0, s_direct_attempts);
+    TEST_ASSERT_EQUAL(WIFI_ALL_CHANNEL_SCAN, s_config.sta.scan_method);
+    TEST_ASSERT_EQUAL(0, strcmp((const char *)s_config.sta.password, TEST_PASSWORD));
+    TEST_ASSERT(ap_cache_stored());
+    TEST_ASSERT_EQUAL(ESP_OK, esp_ot_wifi_config_get_ssid(ssid));
+    TEST_ASSERT_EQUAL(0, strcmp(ssid, TEST_SSID));
+    TEST_ASSERT_EQUAL(OT_ERROR_NONE, command("connect -s " TEST_SSID));
+    TEST_ASSERT_EQUAL(1, s_scan_attempts); /* already connected */
+}
+
+/* A blip reconnects at once, to the cached BSSID and channel with the key, and a roaming is left to the driver. */
+static void test_direct_after_blip(void)
+{
+    clear_counts();
+    disconnected(WIFI_REASON_ROAMING);
+    driver_run();
+    TEST_ASSERT_EQUAL(OT_WIFI_CONNECTED, esp_ot_wifi_state_get());
+    TEST_ASSERT_EQUAL(0, s_direct_attempts + s_scan_attempts);
+
+    s_associated = true;
+    disconnected(WIFI_REASON_BEACON_TIMEOUT);
+    TEST_ASSERT_EQUAL(OT_WIFI_RECONNECTING, esp_ot_wifi_state_get());
+    TEST_ASSERT(s_pending); /* no backoff */
+    driver_run();
+    TEST_ASSERT_EQUAL(OT_WIFI_CONNECTED, esp_ot_wifi_state_get());
+    TEST_ASSERT_EQUAL(1, s_direct_attempts);
+    TEST_ASSERT_EQUAL(0, s_scan_attempts);
+    TEST_ASSERT_EQUAL(0, s_backoff_count);
+    TEST_ASSERT_EQUAL(WIFI_FAST_SCAN, s_config.sta.scan_method);
+    TEST_ASSERT_EQUAL(6, s_config.sta.channel);
+    TEST_ASSERT_EQUAL(0, memcmp(s_config.sta.bssid, s_ap.bssid, 6));
+    TEST_ASSERT(password_is_pmk(&s_config.sta));
+}
+
+/*
+ * The backoff doubles from the second retry up to its maximum, with an equal jitter, and the retries scan once the
+ * direct attempts are used up.
+ */
+static void test_backoff_growth(void)
+{
+    static const uint32_t s_bounds_ms[] = {250, 500, 1000, 2000, 2000};
+
+    clear_counts();
+    s_fail_attempts = 5;
+    disconnected(WIFI_REASON_BEACON_TIMEOUT);
+    driver_run();
+    TEST_ASSERT_EQUAL(OT_WIFI_CONNECTED, esp_ot_wifi_state_get());
+    TEST_ASSERT_EQUAL(2, s_direct_attempts);
+    TEST_ASSERT_EQUAL(4, s_scan_attempts);
+    TEST_ASSERT_EQUAL(5, s_backoff_count);
+    for (int i = 0; i < s_backoff_count; i++) {
+        TEST_ASSERT(s_backoffs_ms[i] >= s_bounds_ms[i] / 2 && s_backoffs_ms[i] <= s_bounds_ms[i]);
+    }
+    TEST_ASSERT_EQUAL(0, strcmp((const char *)s_config.sta.password, TEST_PASSWORD));
+}
+
+/* An access point moved to another channel is found by the scan, and the next blip reconnects to it directly. */
+static void test_channel_change(void)
+{
+    clear_counts();
+    s_ap.channel = 11;
+    disconnected(WIFI_REASON_BEACON_TIMEOUT);
+    driver_run();
+    TEST_ASSERT_EQUAL(OT_WIFI_CONNECTED, esp_ot_wifi_state_get());
+    TEST_ASSERT_EQUAL(2, s_direct_attempts);
+    TEST_ASSERT_EQUAL(1, s_scan_attempts);
+
+    clear_counts();
+    disconnected(WIFI_REASON_BEACON_TIMEOUT);
+    driver_run();
+    TEST_ASSERT_EQUAL(1, s_direct_attempts);
+    TEST_ASSERT_EQUAL(0, s_scan_attempts);
+    TEST_ASSERT_EQUAL(11, s_config.sta.channel);
+}
+
+/* An access point switched to WPA3 rejects the key, the scan falls back on the passphrase which is cached then. */
+static void test_wpa3_ignores_pmk(void)
+{
+    clear_counts();
+    s_ap.authmode = WIFI_AUTH_WPA3_PSK;
+    disconnected(WIFI_REASON_BEACON_TIMEOUT);
+    driver_run();
+    TEST_ASSERT_EQUAL(OT_WIFI_CONNECTED, esp_ot_wifi_state_get());
+    TEST_ASSERT_EQUAL(2, s_direct_attempts);
+    TEST_ASSERT_EQUAL(1, s_scan_attempts);
+
+    clear_counts();
+    disconnected(WIFI_REASON_BEACON_TIMEOUT);
+    driver_run();
+    TEST_ASSERT_EQUAL(1, s_direct_attempts);
+    TEST_ASSERT_EQUAL(0, s_scan_attempts);
+    TEST_ASSERT_FALSE(password_is_pmk(&s_config.sta));
+    TEST_ASSERT_EQUAL(0, strcmp((const char *)s_config.sta.password, TEST_PASSWORD));
+    s_ap.authmode = WIFI_AUTH_WPA2_PSK;
+    disconnected(WIFI_REASON_BEACON_TIMEOUT);
+    driver_run();
+    TEST_ASSERT_EQUAL(OT_WIFI_CONNECTED, esp_ot_wifi_state_get());
+}
+
+/* The station gives up after CONFIG_EXAMPLE_WIFI_CONN_MAX_RETRY attempts, without a timer left. */
+static void test_retry_limit(void)
+{
+    clear_counts();
+    s_ap.up = false;
+    disconnected(WIFI_REASON_BEACON_TIMEOUT);
+    driver_run();
+    TEST_ASSERT_EQUAL(OT_WIFI_DISCONNECTED, esp_ot_wifi_state_get());
+    TEST_ASSERT_EQUAL(CONFIG_EXAMPLE_WIFI_CONN_MAX_RETRY, s_direct_attempts + s_scan_attempts);
+    TEST_ASSERT_EQUAL(CONFIG_EXAMPLE_WIFI_CONN_MAX_RETRY - 1, s_backoff_count);
+    TEST_ASSERT_FALSE(s_timer.armed);
+    s_ap.up = true;
+}
+
+/*
+ * A join with other credentials fails and takes the access point cache in memory, the join with the first ones
+ * connects directly again from the access point stored in NVS.
+ */
+static void test_join_from_nvs_cache(void)
+{
+    clear_counts();
+    TEST_ASSERT_EQUAL(ESP_FAIL, esp_ot_wifi_connect(TEST_SSID, "otherpass"));
+    TEST_ASSERT_EQUAL(OT_WIFI_DISCONNECTED, esp_ot_wifi_state_get());
+    TEST_ASSERT_EQUAL(0, s_direct_attempts); /* no access point is cached for these credentials */
+    TEST_ASSERT_EQUAL(CONFIG_EXAMPLE_WIFI_CONN_MAX_RETRY + 1, s_scan_attempts);
+
+    clear_counts();
+    TEST_ASSERT_EQUAL(OT_ERROR_NONE, command("connect -s " TEST_SSID " -p " TEST_PASSWORD));
+    TEST_ASSERT_EQUAL(OT_WIFI_CONNECTED, esp_ot_wifi_state_get());
+    TEST_ASSERT_EQUAL(1, s_direct_attempts);
+    TEST_ASSERT_EQUAL(0, s_scan_attempts);
+    TEST_ASSERT_EQUAL(11, s_config.sta.channel);
+    TEST_ASSERT(password_is_pmk(&s_config.sta));
+}
+
+/* A disconnect during a backoff stops the reconnect timer and the events of the driver. */
+static void test_disconnect_during_backoff(void)
+{
+    clear_counts();
+    s_ap.up = false;
+    disconnected(WIFI_REASON_BEACON_TIMEOUT);
+    TEST_ASSERT(driver_step()); /* the immediate retry fails */
+    TEST_ASSERT(s_timer.armed);
+    TEST_ASSERT_EQUAL(OT_WIFI_RECONNECTING, esp_ot_wifi_state_get());
+    TEST_ASSERT_EQUAL(OT_ERROR_NONE, command("connect -s " TEST_SSID));
+    TEST_ASSERT_EQUAL(1, s_direct_attempts); /* refused while reconnecting */
+
+    TEST_ASSERT_EQUAL(OT_ERROR_NONE, command("disconnect"));
+    TEST_ASSERT_EQUAL(OT_WIFI_DISCONNECTED, esp_ot_wifi_state_get());
+    TEST_ASSERT_FALSE(s_timer.armed);
+    disconnected(WIFI_REASON_BEACON_TIMEOUT);
+    driver_run();
+    TEST_ASSERT_EQUAL(OT_WIFI_DISCONNECTED, esp_ot_wifi_state_get());
+    TEST_ASSERT_EQUAL(1, s_direct_attempts);
+    s_ap.up = true;
+}
+
+/* A configuration cleared while connected is not cached again, the next join scans. */
+static void test_config_clear(void)
+{
+    clear_counts();
+    TEST_ASSERT_EQUAL(OT_ERROR_NONE, command("connect -s " TEST_SSID " -p " TEST_PASSWORD));
+    TEST_ASSERT_EQUAL(1, s_direct_attempts);
+    TEST_ASSERT_EQUAL(OT_ERROR_NONE, command("config clear"));
+    TEST_ASSERT_FALSE(ap_cache_stored());
+
+    clear_counts();
+    disconnected(WIFI_REASON_BEACON_TIMEOUT);
+    driver_run();
+    TEST_ASSERT_EQUAL(OT_WIFI_CONNECTED, esp_ot_wifi_state_get());
+    TEST_ASSERT_EQUAL(0, s_direct_attempts);
+    TEST_ASSERT_EQUAL(1, s_scan_attempts);
+    TEST_ASSERT_FALSE(ap_cache_stored());
+    TEST_ASSERT_EQUAL(OT_ERROR_NONE, command("state"));
+}
+
+int main(void)
+{
+    srandom(1);
+    RUN_TEST(test_first_join_by_scan);
+    RUN_TEST(test_direct_after_blip);
+    RUN_TEST(test_backoff_growth);
+    RUN_TEST(test_channel_change);
+    RUN_TEST(test_wpa3_ignores_pmk);
+    RUN_TEST(test_retry_limit);
+    RUN_TEST(test_join_from_nvs_cache);
+    RUN_TEST(test_disconnect_during_backoff);
+    RUN_TEST(test_config_clear);
+    return 0;
+}
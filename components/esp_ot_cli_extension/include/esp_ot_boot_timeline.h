@@ -0,0 +1,77 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "sdkconfig.h"
+#include <stdint.h>
+#include <esp_err.h>
+#include <openthread/error.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ESP_OT_BOOT_PHASE_RUNNING -1 /*!< The end of a phase which has not ended */
+
+/**
+ * @brief A phase of the boot.
+ *
+ */
+typedef struct esp_ot_boot_phase {
+    const char *name; /*!< The name of the phase */
+    char task[16];    /*!< The task which began the phase */
+    int64_t begin_us; /*!< The time since boot when the phase began */
+    int64_t end_us;   /*!< The time since boot when the phase ended, or ESP_OT_BOOT_PHASE_RUNNING */
+} esp_ot_boot_phase_t;
+
+#if CONFIG_OPENTHREAD_BOOT_TIMELINE
+/**
+ * @brief Record the beginning of a boot phase.
+ *
+ * @note The phases may be recorded from any task, before the OpenThread stack is started. The name must outlive the
+ *       timeline, e.g. a string literal. The phases beyond OPENTHREAD_BOOT_TIMELINE_MAX_PHASES are dropped.
+ *
+ */
+void esp_ot_boot_phase_begin(const char *name);
+
+/**
+ * @brief Record the end of the last boot phase began with the name.
+ *
+ */
+void esp_ot_boot_phase_end(const char *name);
+
+/**
+ * @brief Get the boot phases in the order they began.
+ *
+ * @param[out] phases   The phases.
+ * @param[in]  max      The maximum number of the phases.
+ * @param[out] dropped  The number of the phases dropped, or NULL.
+ *
+ * @return The number of the phases.
+ */
+uint8_t esp_ot_boot_timeline_get(esp_ot_boot_phase_t *phases, uint8_t max, uint32_t *dropped);
+
+/**
+ * @brief The "boottime" command process.
+ *
+ */
+otError esp_ot_process_boot_timeline(void *aContext, uint8_t aArgsLength, char *aArgs[]);
+#else
+static inline void esp_ot_boot_phase_begin(const char *name)
+{
+    (void)name;
+}
+
+static inline void esp_ot_boot_phase_end(const char *name)
+{
+    (void)name;
+}
+#endif // CONFIG_OPENTHREAD_BOOT_TIMELINE
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
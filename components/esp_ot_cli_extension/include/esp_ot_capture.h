@@ -0,0 +1,114 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <esp_err.h>
+#include <openthread/error.h>
+#include "esp_ot_ip_stats.h"
+#include "lwip/ip_addr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ESP_OT_CAPTURE_ANY_PORT 0     /*!< The port filter matching all the packets */
+#define ESP_OT_CAPTURE_ANY_PROTO 0xff /*!< The next header filter matching all the packets */
+
+/**
+ * @brief The packets captured, all the conditions set must match.
+ *
+ */
+typedef struct esp_ot_capture_filter {
+    char netif[3];    /*!< The lwIP name of the netif, empty for all the netifs */
+    bool has_addr;    /*!< Whether addr is set */
+    ip_addr_t addr;   /*!< The source or destination address */
+    uint16_t port;    /*!< The source or destination UDP or TCP port, ESP_OT_CAPTURE_ANY_PORT for any */
+    uint8_t proto;    /*!< The IPv6 next header or IPv4 protocol, ESP_OT_CAPTURE_ANY_PROTO for any */
+    uint16_t snaplen; /*!< The maximum bytes captured of each packet */
+} esp_ot_capture_filter_t;
+
+/**
+ * @brief The counters of a netif in the current or the last capture.
+ *
+ */
+typedef struct esp_ot_capture_netif_stats {
+    char name[3];     /*!< The lwIP name of the netif, empty if the index is not used */
+    uint32_t matched; /*!< The packets matching the filter */
+    uint32_t dropped; /*!< The packets matching the filter lost because the ring buffer was full */
+} esp_ot_capture_netif_stats_t;
+
+/**
+ * @brief Start capturing the packets of the netifs into the ring buffer.
+ *
+ * @note There is one capture at a time, read by one reader. The ring buffer is allocated by the first capture and
+ *       kept, as the forwarding path may still be writing to it when a capture stops.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if the snaplen is 0
+ *      - ESP_ERR_INVALID_STATE if a capture is not finished
+ *      - ESP_ERR_NO_MEM if there is no memory for the ring buffer
+ */
+esp_err_t esp_ot_capture_start(const esp_ot_capture_filter_t *filter);
+
+/**
+ * @brief Read the captured packets in pcapng.
+ *
+ * @note The first read returns the Section Header Block and an Interface Description Block per netif index, then
+ *       each read returns the Enhanced Packet Blocks fitting in the buffer.
+ *
+ * @return The number of the bytes written, 0 if no packet is captured.
+ */
+size_t esp_ot_capture_read(uint8_t *buf, size_t size);
+
+/**
+ * @brief Whether a capture is running.
+ *
+ */
+bool esp_ot_capture_is_running(void);
+
+/**
+ * @brief Stop capturing the packets, the packets captured can still be read.
+ *
+ */
+void esp_ot_capture_stop(void);
+
+/**
+ * @brief Finish the capture stopped, which allows the next one to start.
+ *
+ * @return The number of the bytes written, an Interface Statistics Block per netif index, 0 if they do not fit.
+ */
+size_t esp_ot_capture_finish(uint8_t *buf, size_t size);
+
+/**
+ * @brief Get the counters of the current or the last capture, ESP_OT_IP_STATS_MAX_NETIFS entries by netif index.
+ *
+ * @return The filter of the capture.
+ */
+const esp_ot_capture_filter_t *esp_ot_capture_get_stats(esp_ot_capture_netif_stats_t *stats);
+
+/**
+ * @brief Parse a condition of the filter of a capture, one of "netif", "addr", "port", "proto" and "snaplen".
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if an argument is not valid
+ */
+esp_err_t esp_ot_capture_parse_filter(const char *key, const char *value, esp_ot_capture_filter_t *filter);
+
+/**
+ * @brief The "capture" command process.
+ *
+ */
+otError esp_ot_process_capture(void *aContext, uint8_t aArgsLength, char *aArgs[]);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
@@ -0,0 +1,232 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <esp_err.h>
+#include <openthread/error.h>
+#include <openthread/ip6.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ESP_OT_COEX_MEASURE_MAX_PROFILES 3 /*!< The maximum number of the profiles of a measurement */
+
+/**
+ * @brief The priority of the 802.15.4 radio requesting the air time from the coexistence arbiter.
+ *
+ */
+typedef enum {
+    ESP_OT_COEX_PRIORITY_HIGH = 0, /*!< Preempts the Wi-Fi traffic but its beacons */
+    ESP_OT_COEX_PRIORITY_MIDDLE,   /*!< Preempts the Wi-Fi data traffic */
+    ESP_OT_COEX_PRIORITY_LOW,      /*!< Granted when the Wi-Fi radio is idle */
+    ESP_OT_COEX_PRIORITY_IDLE,     /*!< No air time is requested */
+    ESP_OT_COEX_PRIORITIES,
+} esp_ot_coex_priority_t;
+
+/**
+ * @brief The priorities of the 802.15.4 radio in each of its states.
+ *
+ */
+typedef struct esp_ot_coex_priorities {
+    esp_ot_coex_priority_t idle;    /*!< While listening for a frame */
+    esp_ot_coex_priority_t txrx;    /*!< While transmitting or receiving a frame */
+    esp_ot_coex_priority_t txrx_at; /*!< While transmitting or receiving a frame at a scheduled time, e.g. CSL */
+} esp_ot_coex_priorities_t;
+
+/**
+ * @brief The predefined priorities, which set the preference between the Wi-Fi and the 802.15.4 radios.
+ *
+ */
+typedef enum {
+    ESP_OT_COEX_PROFILE_WIFI = 0, /*!< The 802.15.4 radio gets the air time the Wi-Fi radio does not use */
+    ESP_OT_COEX_PROFILE_BALANCE,  /*!< The default of the 802.15.4 driver, scheduled frames preempt Wi-Fi data */
+    ESP_OT_COEX_PROFILE_THREAD,   /*!< All the 802.15.4 frames preempt Wi-Fi data, listening is requested too */
+    ESP_OT_COEX_PROFILE_CUSTOM,   /*!< Priorities set one by one */
+    ESP_OT_COEX_PROFILES,
+} esp_ot_coex_profile_t;
+
+/**
+ * @brief The coexistence statistics since the last reset.
+ *
+ * @note The 802.15.4 driver reports the transmissions the arbiter does not grant as channel access failures, which
+ *       the MAC retries after a backoff and drops after all the attempts fail.
+ *
+ */
+typedef struct esp_ot_coex_stats {
+    uint32_t window_ms;         /*!< The time since the last reset */
+    uint32_t tx_frames;         /*!< The 802.15.4 transmissions */
+    uint32_t tx_deferred;       /*!< The 802.15.4 transmissions failing the channel access, deferred by a backoff */
+    uint32_t tx_aborted;        /*!< The 802.15.4 frames aborted or dropped after the channel access failed */
+    uint32_t tx_retries;        /*!< The 802.15.4 retransmissions for want of an acknowledgment */
+    uint32_t rx_frames;         /*!< The 802.15.4 frames received */
+    bool enabled;               /*!< Whether the radio coexistence is enabled */
+    bool has_grants;            /*!< Whether the radio reports the requests to the arbiter */
+    uint32_t tx_requests;       /*!< The transmit requests to the arbiter */
+    uint32_t tx_granted;        /*!< The transmit requests granted, immediately or after waiting */
+    uint32_t tx_denied;         /*!< The transmit requests timed out or revoked while pending */
+    uint32_t tx_grant_wait_us;  /*!< The average time from a transmit request to its grant */
+    uint32_t rx_requests;       /*!< The receive requests to the arbiter */
+    uint32_t rx_granted;        /*!< The receive requests granted, immediately or after waiting */
+    uint32_t rx_denied;         /*!< The receive requests timed out, revoked or never granted */
+    uint32_t rx_grant_wait_us;  /*!< The average time from a receive request to its grant */
+    bool has_air_time;          /*!< Whether the radio time statistics are available */
+    uint16_t tx_permille;       /*!< The share of the window the 802.15.4 radio transmitted */
+    uint16_t rx_permille;       /*!< The share of the window the 802.15.4 radio listened or received */
+    uint16_t sleep_permille;    /*!< The share of the window the 802.15.4 radio slept */
+} esp_ot_coex_stats_t;
+
+/**
+ * @brief The state of the measurement.
+ *
+ */
+typedef enum {
+    ESP_OT_COEX_MEASURE_IDLE = 0, /*!< No measurement was started */
+    ESP_OT_COEX_MEASURE_RUNNING,  /*!< The traffic pattern is running */
+    ESP_OT_COEX_MEASURE_DONE,     /*!< The results of all the profiles are available */
+} esp_ot_coex_measure_state_t;
+
+/**
+ * @brief The traffic pattern measured under a profile.
+ *
+ */
+typedef struct esp_ot_coex_result {
+    esp_ot_coex_profile_t profile; /*!< The profile measured, ESP_OT_COEX_PROFILES if the priorities are unknown */
+    uint16_t sent;                 /*!< The echo requests sent */
+    uint16_t received;             /*!< The echo replies received */
+    uint16_t rtt_min_ms;           /*!< The shortest round trip time */
+    uint16_t rtt_avg_ms;           /*!< The average round trip time */
+    uint16_t rtt_max_ms;           /*!< The longest round trip time */
+    uint32_t throughput_bps;       /*!< The payload echoed back and forth per second, over the measured window */
+    uint32_t tx_deferred;          /*!< The 802.15.4 transmissions deferred during the pattern */
+    uint32_t tx_aborted;           /*!< The 802.15.4 frames aborted or dropped during the pattern */
+    uint32_t tx_denied;            /*!< The transmit requests denied during the pattern, if has_grants */
+} esp_ot_coex_result_t;
+
+/**
+ * @brief Initialize the coexistence statistics.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_FAIL if the OpenThread instance is not initialized
+ *      - ESP_ERR_NO_MEM if the semaphore of the measurement cannot be created
+ */
+esp_err_t esp_ot_coex_init(void);
+
+/**
+ * @brief Get the coexistence statistics since the last reset.
+ *
+ * @note All the functions of the coexistence but esp_ot_coex_init must be called with the OpenThread lock held.
+ *
+ */
+void esp_ot_coex_get_stats(esp_ot_coex_stats_t *stats);
+
+/**
+ * @brief Restart the window of the coexistence statistics.
+ *
+ */
+void esp_ot_coex_reset(void);
+
+/**
+ * @brief Get the priorities of the 802.15.4 radio in use.
+ *
+ * @return The profile of the priorities, ESP_OT_COEX_PROFILES if the radio does not support them.
+ */
+esp_ot_coex_profile_t esp_ot_coex_get_priorities(esp_ot_coex_priorities_t *priorities);
+
+/**
+ * @brief Set the priorities of the 802.15.4 radio to a profile.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if the profile is not predefined
+ *      - ESP_ERR_NOT_SUPPORTED if the radio does not support the priorities
+ *      - ESP_ERR_INVALID_STATE if a measurement is running
+ */
+esp_err_t esp_ot_coex_set_profile(esp_ot_coex_profile_t profile);
+
+/**
+ * @brief Set the priorities of the 802.15.4 radio one by one.
+ *
+ * @return See esp_ot_coex_set_profile.
+ */
+esp_err_t esp_ot_coex_set_priorities(const esp_ot_coex_priorities_t *priorities);
+
+/**
+ * @brief Start measuring a fixed pattern of echo requests to a Thread node under each profile in turn.
+ *
+ * @note The priorities in use are measured if no profile is given, they are restored after the measurement.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if there are too many profiles or one is not predefined
+ *      - ESP_ERR_NOT_SUPPORTED if profiles are given but the radio does not support the priorities
+ *      - ESP_ERR_INVALID_STATE if a measurement is running
+ *      - ESP_ERR_NO_MEM if the task of the measurement cannot be created
+ */
+esp_err_t esp_ot_coex_measure_start(const otIp6Address *destination, const esp_ot_coex_profile_t *profiles,
+                                    uint8_t count);
+
+/**
+ * @brief Get the results of the measurement running or done.
+ *
+ * @param[out] results  ESP_OT_COEX_MEASURE_MAX_PROFILES entries, those of the profiles measured are filled.
+ * @param[out] count    The number of the profiles measured.
+ *
+ * @return The state of the measurement.
+ */
+esp_ot_coex_measure_state_t esp_ot_coex_measure_get(esp_ot_coex_result_t *results, uint8_t *count);
+
+/**
+ * @brief Get the name of a profile.
+ *
+ */
+const char *esp_ot_coex_profile_name(esp_ot_coex_profile_t profile);
+
+/**
+ * @brief Get the profile by its name.
+ *
+ * @return The profile, ESP_OT_COEX_PROFILES if the name is unknown.
+ */
+esp_ot_coex_profile_t esp_ot_coex_profile_parse(const char *name);
+
+/**
+ * @brief Get the name of a state of the measurement.
+ *
+ */
+const char *esp_ot_coex_measure_state_name(esp_ot_coex_measure_state_t state);
+
+/**
+ * @brief Convert the error of a coexistence function to the error of a command.
+ *
+ */
+otError esp_ot_coex_error_to_ot_error(esp_err_t err);
+
+/**
+ * @brief Get the name of a priority.
+ *
+ */
+const char *esp_ot_coex_priority_name(esp_ot_coex_priority_t priority);
+
+/**
+ * @brief Get the priority by its name.
+ *
+ * @return The priority, ESP_OT_COEX_PRIORITIES if the name is unknown.
+ */
+esp_ot_coex_priority_t esp_ot_coex_priority_parse(const char *name);
+
+/**
+ * @brief The "coex" command process.
+ *
+ */
+otError esp_ot_process_coex(void *aContext, uint8_t aArgsLength, char *aArgs[]);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
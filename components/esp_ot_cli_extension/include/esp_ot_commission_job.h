@@ -0,0 +1,173 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <esp_err.h>
+#include <openthread/commissioner.h>
+#include <openthread/error.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ESP_OT_COMMISSION_JOB_DEFAULT_TIMEOUT 120 /*!< The default timeout in seconds of each joiner entry */
+#define ESP_OT_COMMISSION_JOB_DEFAULT_RETRIES 2   /*!< The default number of times an expired joiner is added again */
+
+/**
+ * @brief The state of the bulk commissioning job.
+ *
+ */
+typedef enum {
+    ESP_OT_COMMISSION_JOB_IDLE,    /*!< No job is started, joiners can be added */
+    ESP_OT_COMMISSION_JOB_WAITING, /*!< Waiting for the commissioner to become active */
+    ESP_OT_COMMISSION_JOB_RUNNING, /*!< Joiners are being commissioned */
+    ESP_OT_COMMISSION_JOB_DONE,    /*!< All the joiners are either joined or failed */
+} esp_ot_commission_job_state_t;
+
+/**
+ * @brief The state of a joiner in the bulk commissioning job.
+ *
+ */
+typedef enum {
+    ESP_OT_COMMISSION_JOINER_PENDING, /*!< Not added to the commissioner yet */
+    ESP_OT_COMMISSION_JOINER_ADDED,   /*!< Added to the commissioner, waiting for the joiner */
+    ESP_OT_COMMISSION_JOINER_JOINED,  /*!< The joiner is finalized */
+    ESP_OT_COMMISSION_JOINER_FAILED,  /*!< The joiner did not join within all the retries */
+} esp_ot_commission_joiner_state_t;
+
+/**
+ * @brief A joiner of the bulk commissioning job.
+ *
+ */
+typedef struct esp_ot_commission_joiner {
+    otJoinerInfoType type;                    /*!< OT_JOINER_INFO_TYPE_EUI64 or OT_JOINER_INFO_TYPE_DISCERNER */
+    otExtAddress eui64;                       /*!< The EUI-64 of the joiner */
+    otJoinerDiscerner discerner;              /*!< The discerner of the joiner */
+    char pskd[OT_JOINER_MAX_PSKD_LENGTH + 1]; /*!< The PSKd of the joiner */
+    esp_ot_commission_joiner_state_t state;   /*!< The state of the joiner */
+    uint8_t retries;                          /*!< The number of times the joiner is added again after expiring */
+    uint8_t sessions;                         /*!< The number of the joiner sessions, including failed ones */
+    uint32_t joined_ms;                       /*!< The time from the job start to the joiner finalized */
+} esp_ot_commission_joiner_t;
+
+/**
+ * @brief The status of the bulk commissioning job.
+ *
+ */
+typedef struct esp_ot_commission_job_status {
+    esp_ot_commission_job_state_t state; /*!< The state of the job */
+    uint16_t total;                      /*!< The number of the joiners */
+    uint16_t pending;                    /*!< The number of the joiners not added yet */
+    uint16_t added;                      /*!< The number of the joiners added to the commissioner */
+    uint16_t joined;                     /*!< The number of the joined joiners */
+    uint16_t failed;                     /*!< The number of the failed joiners */
+    uint32_t retries;                    /*!< The total number of retries */
+    uint32_t elapsed_ms;                 /*!< The time since the job is started */
+    uint32_t joins_per_min_x10;          /*!< The throughput in joins per minute multiplied by 10 */
+} esp_ot_commission_job_status_t;
+
+/**
+ * @brief Add a joiner to the bulk commissioning job.
+ *
+ * @note All the functions of the job must be called with the OpenThread lock held.
+ *
+ * @param[in] id        The 16 hex digits of the EUI-64, or the discerner in the format of <value>/<bit length>.
+ * @param[in] pskd      The PSKd of the joiner.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if the id or the PSKd is invalid
+ *      - ESP_ERR_INVALID_STATE if the job is already started
+ *      - ESP_ERR_NO_MEM if there are too many joiners
+ */
+esp_err_t esp_ot_commission_job_add(const char *id, const char *pskd);
+
+/**
+ * @brief Add joiners to the bulk commissioning job from the CSV text, one "<id>,<pskd>" per line.
+ *
+ * @param[in] csv       The CSV text, which is modified while parsing. Empty lines and lines starting with '#' are
+ *                      skipped.
+ * @param[out] added    The number of the added joiners.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - Others: the error of the first invalid line, the joiners before it are kept
+ */
+esp_err_t esp_ot_commission_job_add_csv(char *csv, uint16_t *added);
+
+/**
+ * @brief Start the bulk commissioning job, the commissioner is started if it is disabled.
+ *
+ * @param[in] timeout   The timeout in seconds of each joiner entry of the commissioner.
+ * @param[in] retries   The maximum number of times an expired joiner is added again.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_STATE if there is no joiner or the job is already started
+ *      - ESP_FAIL if failed to start the commissioner
+ */
+esp_err_t esp_ot_commission_job_start(uint32_t timeout, uint8_t retries);
+
+/**
+ * @brief Stop the bulk commissioning job and remove all its joiners.
+ *
+ */
+void esp_ot_commission_job_clear(void);
+
+/**
+ * @brief Get the status of the bulk commissioning job.
+ *
+ * @param[out] status   The status of the job.
+ *
+ */
+void esp_ot_commission_job_get_status(esp_ot_commission_job_status_t *status);
+
+/**
+ * @brief Get a joiner of the bulk commissioning job.
+ *
+ * @param[in] index     The index of the joiner, in the order of adding.
+ *
+ * @return The joiner, or NULL if the index is out of range.
+ */
+const esp_ot_commission_joiner_t *esp_ot_commission_job_get_joiner(uint16_t index);
+
+/**
+ * @brief Get the name of a job state, e.g. "running".
+ *
+ */
+const char *esp_ot_commission_job_state_to_string(esp_ot_commission_job_state_t state);
+
+/**
+ * @brief Get the name of a joiner state, e.g. "joined".
+ *
+ */
+const char *esp_ot_commission_joiner_state_to_string(esp_ot_commission_joiner_state_t state);
+
+/**
+ * @brief The commissioner state callback of the job, to be called by other owners of the commissioner.
+ *
+ */
+void esp_ot_commission_job_handle_state(otCommissionerState state, void *context);
+
+/**
+ * @brief The joiner event callback of the job, to be called by other owners of the commissioner.
+ *
+ */
+void esp_ot_commission_job_handle_joiner_event(otCommissionerJoinerEvent event, const otJoinerInfo *info,
+                                               const otExtAddress *joiner_id, void *context);
+
+/**
+ * @brief User command "bulkjoin" process.
+ *
+ */
+otError esp_ot_process_commission_job(void *aContext, uint8_t aArgsLength, char *aArgs[]);
+
+#ifdef __cplusplus
+}
+#endif
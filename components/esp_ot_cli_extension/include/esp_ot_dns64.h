@@ -7,6 +7,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <esp_err.h>
 #include <openthread/error.h>
 
 #ifdef __cplusplus
@@ -19,6 +20,15 @@ extern "C" {
  */
 otError esp_openthread_process_dns64_server(void *aContext, uint8_t aArgsLength, char *aArgs[]);
 
+/**
+ * @brief Set the main DNS server reached through the NAT64 prefix, the upstream server of the caching resolver
+ *        instead if it is running.
+ *
+ * @param[in] addr  The IPv4 address of the server in network order.
+ *
+ */
+esp_err_t esp_ot_dns64_set_main_server(uint32_t addr);
+
 #ifdef __cplusplus
 }
 #endif
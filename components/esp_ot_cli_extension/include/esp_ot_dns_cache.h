@@ -0,0 +1,216 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <esp_err.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ESP_OT_DNS_TYPE_A 1
+#define ESP_OT_DNS_TYPE_AAAA 28
+#define ESP_OT_DNS_RCODE_NOERROR 0
+#define ESP_OT_DNS_RCODE_NXDOMAIN 3
+
+typedef enum {
+    ESP_OT_DNS_CACHE_MISS = 0,
+    ESP_OT_DNS_CACHE_HIT,
+    ESP_OT_DNS_CACHE_HIT_PREFETCH, /*!< A hit on a popular entry about to expire, which should be queried again */
+} esp_ot_dns_cache_result_t;
+
+/**
+ * @brief The metrics of the cache and of the upstream queries.
+ *
+ */
+typedef struct esp_ot_dns_cache_stats {
+    uint16_t entries;           /*!< The entries in use */
+    uint32_t hits;              /*!< The queries answered from the cache, including the negative hits */
+    uint32_t negative_hits;     /*!< The queries answered by a cached NXDOMAIN or a response without records */
+    uint32_t misses;            /*!< The queries not in the cache or expired */
+    uint32_t inserts;           /*!< The responses cached */
+    uint32_t evictions;         /*!< The unexpired entries replaced by the least recently used rule */
+    uint32_t prefetches;        /*!< The entries queried again before they expire */
+    uint32_t synthesized;       /*!< The AAAA responses synthesized from A responses */
+    uint32_t upstream_queries;  /*!< The queries answered by the upstream server */
+    uint32_t upstream_timeouts; /*!< The queries not answered by the upstream server */
+    uint32_t latency_avg_ms;    /*!< The average latency of the upstream server */
+    uint32_t latency_max_ms;    /*!< The max latency of the upstream server */
+} esp_ot_dns_cache_stats_t;
+
+/**
+ * @brief Allocate the DNS cache.
+ *
+ * @note The cache functions are not thread safe, the resolver serializes them with its own lock.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_NO_MEM if there is no memory for the cache
+ */
+esp_err_t esp_ot_dns_cache_init(void);
+
+/**
+ * @brief Look up a query in the cache.
+ *
+ * @note The response has the ID and the RD flag of the query, and the TTLs reduced by the time spent in the cache.
+ *
+ * @param[in]  query          The DNS query message.
+ * @param[in]  query_len      The length of the query.
+ * @param[out] response       The buffer of the response.
+ * @param[in]  response_size  The size of the response buffer.
+ * @param[out] response_len   The length of the response on a hit.
+ * @param[in]  now_ms         The current time in milliseconds.
+ *
+ * @return The result of the lookup, a query which cannot be parsed is a miss.
+ */
+esp_ot_dns_cache_result_t esp_ot_dns_cache_lookup(const uint8_t *query, uint16_t query_len, uint8_t *response,
+                                                  uint16_t response_size, uint16_t *response_len, uint32_t now_ms);
+
+/**
+ * @brief Add a response to the cache, replacing the entry of the same name and type.
+ *
+ * @note A NOERROR response with answers is kept for the min TTL of its answers. A NXDOMAIN response or a response
+ *       without answers is kept for the TTL of the SOA record in its authority section, up to the negative TTL.
+ *       Truncated responses, the other response codes and the responses larger than the entries are not cached.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if the response cannot be parsed
+ *      - ESP_ERR_NOT_SUPPORTED if the response is not cacheable
+ */
+esp_err_t esp_ot_dns_cache_insert(const uint8_t *response, uint16_t len, uint32_t now_ms);
+
+/**
+ * @brief Get the key of the entry of the question of a message.
+ *
+ * @return The key, 0 if the message cannot be parsed.
+ */
+uint32_t esp_ot_dns_cache_key(const uint8_t *message, uint16_t len);
+
+/**
+ * @brief End the prefetch of an entry, so that a later hit can prefetch it again.
+ *
+ * @note A response inserted ends the prefetch of its entry. The resolver ends it when the prefetch query fails, times
+ *       out or its response is not cached.
+ *
+ * @param[in] key  The key of the entry, from esp_ot_dns_cache_key() on the query prefetched.
+ *
+ */
+void esp_ot_dns_cache_prefetch_done(uint32_t key);
+
+/**
+ * @brief Remove all the entries from the cache.
+ *
+ */
+void esp_ot_dns_cache_flush(void);
+
+/**
+ * @brief Record the latency of an upstream query, or its timeout.
+ *
+ */
+void esp_ot_dns_cache_record_upstream(uint32_t latency_ms, bool timeout);
+
+/**
+ * @brief Get the metrics of the cache.
+ *
+ */
+void esp_ot_dns_cache_get_stats(esp_ot_dns_cache_stats_t *stats);
+
+/**
+ * @brief Get the question type and the response code of a message.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if the message does not have exactly one question
+ */
+esp_err_t esp_ot_dns_message_parse(const uint8_t *message, uint16_t len, uint16_t *qtype, uint8_t *rcode);
+
+/**
+ * @brief Count the answers of a type in a response.
+ *
+ * @return The number of the answers, -1 if the response cannot be parsed.
+ */
+int esp_ot_dns_message_count_answers(const uint8_t *message, uint16_t len, uint16_t type);
+
+/**
+ * @brief Make a recursive query of the question of a message with another type.
+ *
+ * @note The query keeps the ID of the message.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if the message does not have exactly one question
+ *      - ESP_ERR_INVALID_SIZE if the buffer is too small
+ */
+esp_err_t esp_ot_dns_message_make_query(const uint8_t *message, uint16_t len, uint16_t qtype, uint8_t *query,
+                                        uint16_t query_size, uint16_t *query_len);
+
+/**
+ * @brief Synthesize a AAAA response from an A response with a NAT64 prefix, as a DNS64 server (RFC 6147).
+ *
+ * @note The A records are replaced by AAAA records of the /96 prefix followed by the IPv4 address, the other answers
+ *       are kept. The authority and the additional sections are dropped.
+ *
+ * @param[in]  response  The A response.
+ * @param[in]  len       The length of the A response.
+ * @param[in]  prefix    The first 12 bytes of the NAT64 prefix.
+ * @param[out] out       The buffer of the AAAA response.
+ * @param[in]  out_size  The size of the buffer.
+ * @param[out] out_len   The length of the AAAA response.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if the response cannot be parsed or has no A records
+ *      - ESP_ERR_INVALID_SIZE if the buffer is too small
+ */
+esp_err_t esp_ot_dns_synthesize_aaaa(const uint8_t *response, uint16_t len, const uint8_t prefix[12], uint8_t *out,
+                                     uint16_t out_size, uint16_t *out_len);
+
+/**
+ * @brief Start the caching resolver on the UDP port CONFIG_OPENTHREAD_DNS_CACHE_PORT, or change its upstream server.
+ *
+ * @note A running resolver switches to the new upstream server in place without waiting for its task, the queries
+ *       pending on the former server are still answered by it.
+ *
+ * @param[in] upstream  The IPv4 address of the upstream server, reached through the NAT64 prefix, in network order.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_NOT_FOUND if there is no NAT64 prefix
+ *      - ESP_FAIL if the sockets or the task cannot be created
+ */
+esp_err_t esp_ot_dns_resolver_start(uint32_t upstream);
+
+/**
+ * @brief Stop the caching resolver, the cache is kept.
+ *
+ */
+void esp_ot_dns_resolver_stop(void);
+
+/**
+ * @brief Whether the caching resolver is running.
+ *
+ */
+bool esp_ot_dns_resolver_is_running(void);
+
+/**
+ * @brief Print the metrics of the cache and the upstream server.
+ *
+ */
+void esp_ot_dns_resolver_print_stats(void);
+
+/**
+ * @brief Remove all the entries from the cache of the resolver.
+ *
+ */
+void esp_ot_dns_resolver_flush(void);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
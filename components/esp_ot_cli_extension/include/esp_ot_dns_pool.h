@@ -0,0 +1,174 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <esp_err.h>
+#include <openthread/error.h>
+#include "sdkconfig.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if CONFIG_OPENTHREAD_DNS_POOL
+#define ESP_OT_DNS_POOL_PROBE_FAILED 0xffff /*!< The history entry of a probe without a valid response */
+#define ESP_OT_DNS_POOL_NO_SERVER 0         /*!< The IPv4 address of no server */
+#define ESP_OT_DNS_POOL_DECISION_NUM 8      /*!< The number of the last changes of the main DNS server kept */
+
+/**
+ * @brief Why the main DNS server was changed.
+ *
+ */
+typedef enum {
+    ESP_OT_DNS_POOL_REASON_FIRST = 0, /*!< The first server found healthy */
+    ESP_OT_DNS_POOL_REASON_FASTER,    /*!< A healthy server faster than the main one by the hysteresis */
+    ESP_OT_DNS_POOL_REASON_UNHEALTHY, /*!< The main server failed its probes */
+    ESP_OT_DNS_POOL_REASON_REMOVED,   /*!< The main server was removed from the pool */
+    ESP_OT_DNS_POOL_REASON_MANUAL,    /*!< The main server was set by hand and pinned */
+} esp_ot_dns_pool_reason_t;
+
+/**
+ * @brief A server of the pool and the statistics of its probes.
+ *
+ */
+typedef struct esp_ot_dns_pool_server {
+    uint32_t addr;                                            /*!< The IPv4 address in network order */
+    bool main;                                                /*!< Whether it is the main DNS server */
+    bool healthy;                                             /*!< Whether it can be promoted to main */
+    uint32_t rtt_ms;                                          /*!< The EWMA of the probe RTTs */
+    uint16_t failure_permille;                                /*!< The EWMA of the probe failures */
+    uint16_t consecutive_failures;                            /*!< The probes failed since the last success */
+    uint32_t probes;                                          /*!< The probes sent */
+    uint32_t failures;                                        /*!< The probes without a valid response */
+    uint32_t last_probe;                                      /*!< The seconds since boot of the last probe */
+    uint8_t history_len;                                      /*!< The number of the probes in the history */
+    uint16_t history[CONFIG_OPENTHREAD_DNS_POOL_HISTORY_SIZE]; /*!< The RTTs in ms from the oldest */
+} esp_ot_dns_pool_server_t;
+
+/**
+ * @brief A change of the main DNS server.
+ *
+ */
+typedef struct esp_ot_dns_pool_decision {
+    uint32_t time;                   /*!< The seconds since boot of the change */
+    uint32_t from;                   /*!< The former main server, ESP_OT_DNS_POOL_NO_SERVER if none */
+    uint32_t to;                     /*!< The new main server, ESP_OT_DNS_POOL_NO_SERVER if none is healthy */
+    uint32_t from_rtt_ms;            /*!< The RTT EWMA of the former main server */
+    uint32_t to_rtt_ms;              /*!< The RTT EWMA of the new main server */
+    esp_ot_dns_pool_reason_t reason; /*!< Why the main server was changed */
+} esp_ot_dns_pool_decision_t;
+
+/**
+ * @brief The function installing the new main DNS server.
+ *
+ * @param[in] addr  The IPv4 address of the server in network order.
+ *
+ */
+typedef esp_err_t (*esp_ot_dns_pool_apply_t)(uint32_t addr);
+
+/**
+ * @brief Allocate the pool and start the probe task.
+ *
+ * @param[in] apply  The function installing the main DNS server selected.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_NO_MEM if there is no memory for the pool
+ *      - ESP_FAIL if the probe task cannot be created
+ */
+esp_err_t esp_ot_dns_pool_init(esp_ot_dns_pool_apply_t apply);
+
+/**
+ * @brief Add a server to the pool, it is promoted once its probes succeed.
+ *
+ * @note All the functions of the pool, except init, must be called with the OpenThread lock held.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_STATE if the pool is not initialized
+ *      - ESP_ERR_NO_MEM if the pool is full
+ */
+esp_err_t esp_ot_dns_pool_add(uint32_t addr);
+
+/**
+ * @brief Remove a server from the pool, another server is promoted if it was the main one.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_NOT_FOUND if the server is not in the pool
+ */
+esp_err_t esp_ot_dns_pool_remove(uint32_t addr, uint32_t now);
+
+/**
+ * @brief Pin the main DNS server set by hand, the pool keeps probing but stops promoting until it is unpinned.
+ *
+ * @param[in] addr  The IPv4 address of the server in network order, which may not be in the pool.
+ * @param[in] now   The seconds since boot.
+ *
+ */
+void esp_ot_dns_pool_pin(uint32_t addr, uint32_t now);
+
+/**
+ * @brief Let the pool promote the main DNS server again, the fastest healthy server is promoted at once.
+ *
+ * @param[in] now  The seconds since boot.
+ *
+ */
+void esp_ot_dns_pool_unpin(uint32_t now);
+
+/**
+ * @brief Get the main DNS server pinned.
+ *
+ * @return The IPv4 address in network order, ESP_OT_DNS_POOL_NO_SERVER if the pool promotes the main server.
+ */
+uint32_t esp_ot_dns_pool_get_pinned(void);
+
+/**
+ * @brief Record the result of a probe and promote the fastest healthy server if needed.
+ *
+ * @param[in] addr    The IPv4 address of the server in network order.
+ * @param[in] rtt_ms  The RTT of the probe, ESP_OT_DNS_POOL_PROBE_FAILED if it failed.
+ * @param[in] now     The seconds since boot.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_NOT_FOUND if the server is not in the pool
+ */
+esp_err_t esp_ot_dns_pool_record_probe(uint32_t addr, uint16_t rtt_ms, uint32_t now);
+
+/**
+ * @brief Get the servers of the pool.
+ *
+ * @return The number of the servers.
+ */
+uint8_t esp_ot_dns_pool_get_servers(esp_ot_dns_pool_server_t *servers, uint8_t max);
+
+/**
+ * @brief Get the last changes of the main DNS server from the newest.
+ *
+ * @return The number of the changes.
+ */
+uint8_t esp_ot_dns_pool_get_decisions(esp_ot_dns_pool_decision_t *decisions, uint8_t max);
+
+/**
+ * @brief Get the name of a reason of a change.
+ *
+ */
+const char *esp_ot_dns_pool_reason_name(esp_ot_dns_pool_reason_t reason);
+
+/**
+ * @brief The "dns64server pool" command process.
+ *
+ */
+otError esp_ot_dns_pool_process(uint8_t aArgsLength, char *aArgs[]);
+#endif // CONFIG_OPENTHREAD_DNS_POOL
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
@@ -6,6 +6,9 @@
 
 #pragma once
 
+#include "sdkconfig.h"
+#include "stdbool.h"
+#include "stddef.h"
 #include "stdint.h"
 #include <esp_err.h>
 #include <openthread/error.h>
@@ -26,6 +29,39 @@ otError esp_ot_process_heap_diag(void *aContext, uint8_t aArgsLength, char *aArg
  */
 esp_err_t esp_ot_heap_diag_init(void);
 
+#if CONFIG_OPENTHREAD_HEAP_DIAG_SCOPE
+/**
+ * @brief The heap accounting scope, normally placed on the stack of the caller.
+ *
+ */
+typedef struct esp_ot_heap_scope {
+    const char *name;     /*!< The name which the heap usage is accounted to, must outlive the scope */
+    size_t used_at_begin; /*!< The heap usage when the scope begins */
+    size_t free_at_begin; /*!< The free heap when the scope begins, the baseline of its peak */
+    bool monitoring;      /*!< Whether this scope owns the local minimum free size monitor */
+} esp_ot_heap_scope_t;
+
+/**
+ * @brief Begin a heap accounting scope.
+ *
+ * @param[out] scope    The scope to begin.
+ * @param[in]  name     The name which the heap usage is accounted to, e.g. the REST URI or the CLI command.
+ *
+ */
+void esp_ot_heap_scope_begin(esp_ot_heap_scope_t *scope, const char *name);
+
+/**
+ * @brief End a heap accounting scope, the peak and retained heap usage will be accumulated to its name.
+ *
+ * @note The peak is the lowest free heap within the scope below the free heap when it began. It is only measured for
+ *       the scopes which do not run alongside another one, the local minimum free size monitor is not shared.
+ *
+ * @param[in] scope     The scope begun by esp_ot_heap_scope_begin.
+ *
+ */
+void esp_ot_heap_scope_end(esp_ot_heap_scope_t *scope);
+#endif // CONFIG_OPENTHREAD_HEAP_DIAG_SCOPE
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,169 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <esp_err.h>
+#include <openthread/error.h>
+#include "lwip/ip_addr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct pbuf;
+
+#define ESP_OT_IP_STATS_MAX_NETIFS 4        /*!< The number of the netifs counted, the loopback netif excluded */
+#define ESP_OT_IP_STATS_LATENCY_BUCKETS 11  /*!< The number of the buckets of the forwarding latency histogram */
+#define ESP_OT_IP_STATS_NO_BOUND UINT32_MAX /*!< The upper bound of the last bucket */
+
+/**
+ * @brief The direction of the forwarded packets whose latency is measured.
+ *
+ */
+typedef enum {
+    ESP_OT_IP_STATS_THREAD_TO_BACKBONE = 0, /*!< Received on the Thread netif, sent on another netif */
+    ESP_OT_IP_STATS_BACKBONE_TO_THREAD,     /*!< Received on another netif, sent on the Thread netif */
+    ESP_OT_IP_STATS_DIRECTIONS,
+} esp_ot_ip_stats_direction_t;
+
+/**
+ * @brief The counters of a netif, the sums of the counters of all the cores.
+ *
+ * @note The counters wrap around at 2^32, the bytes are those of the IP packets without the link-layer header.
+ *
+ */
+typedef struct esp_ot_ip_stats_netif {
+    char name[3];          /*!< The lwIP name of the netif, e.g. "ot" */
+    uint32_t rx_packets;   /*!< The packets passed to the IP stack */
+    uint32_t rx_bytes;     /*!< The bytes of rx_packets */
+    uint32_t rx_drops;     /*!< The packets refused by the IP stack, e.g. when its queue is full */
+    uint32_t tx_packets;   /*!< The packets accepted by the netif */
+    uint32_t tx_bytes;     /*!< The bytes of tx_packets */
+    uint32_t tx_drops;     /*!< The packets refused by the netif */
+    uint32_t tx_forwarded; /*!< The packets sent which were received on another netif */
+} esp_ot_ip_stats_netif_t;
+
+/**
+ * @brief The histogram of the time from the ingress to the egress of the forwarded packets.
+ *
+ */
+typedef struct esp_ot_ip_stats_latency {
+    uint32_t samples;                                  /*!< The number of the packets measured */
+    uint32_t max_us;                                   /*!< The longest latency */
+    uint32_t buckets[ESP_OT_IP_STATS_LATENCY_BUCKETS]; /*!< The packets per bucket, see esp_ot_ip_stats_bound */
+} esp_ot_ip_stats_latency_t;
+
+/**
+ * @brief The forwarding counters of a multicast group.
+ *
+ */
+typedef struct esp_ot_ip_stats_mcast_group {
+    ip_addr_t group;  /*!< The destination group */
+    uint32_t packets; /*!< The packets of the group forwarded, once per egress netif */
+    uint32_t bytes;   /*!< The bytes of packets */
+} esp_ot_ip_stats_mcast_group_t;
+
+/**
+ * @brief The function receiving the packets of the netifs.
+ *
+ * @note It is called in the forwarding path by the tasks handing the packets to the netifs, so it must not block.
+ *
+ * @param[in] netif   The index of the netif, see esp_ot_ip_stats_netif_name.
+ * @param[in] egress  Whether the packet is sent on the netif.
+ * @param[in] p       The packet, starting with its link-layer header.
+ * @param[in] offset  The size of the link-layer header, the IP header follows.
+ *
+ */
+typedef void (*esp_ot_ip_stats_tap_t)(uint8_t netif, bool egress, const struct pbuf *p, uint16_t offset);
+
+/**
+ * @brief Start counting the packets of the netifs.
+ *
+ * @note The input and output functions of each netif are wrapped once it is added, the netifs added later are
+ *       wrapped on the next IP or OpenThread interface event. All the functions of the statistics can be called
+ *       without any lock, the counters are updated by the cores without locking.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_FAIL if the event handlers cannot be registered
+ */
+esp_err_t esp_ot_ip_stats_init(void);
+
+/**
+ * @brief Get the counters of the netifs.
+ *
+ * @return The number of the netifs.
+ */
+uint8_t esp_ot_ip_stats_get_netifs(esp_ot_ip_stats_netif_t *netifs, uint8_t max);
+
+/**
+ * @brief Get the forwarding latency histogram of a direction.
+ *
+ */
+void esp_ot_ip_stats_get_latency(esp_ot_ip_stats_direction_t direction, esp_ot_ip_stats_latency_t *latency);
+
+/**
+ * @brief Get the multicast groups forwarded.
+ *
+ * @param[out] other  The packets of the groups which did not fit in the table.
+ *
+ * @return The number of the groups.
+ */
+uint8_t esp_ot_ip_stats_get_mcast_groups(esp_ot_ip_stats_mcast_group_t *groups, uint8_t max, uint32_t *other);
+
+/**
+ * @brief Get the upper bound in microseconds of a bucket of the latency histogram.
+ *
+ * @return The bound, ESP_OT_IP_STATS_NO_BOUND for the last bucket.
+ */
+uint32_t esp_ot_ip_stats_bound(uint8_t bucket);
+
+/**
+ * @brief Get the upper bound of the bucket holding a percentile of the latency histogram.
+ *
+ * @param[in] permille  The percentile in permille, e.g. 990 for the 99th percentile.
+ *
+ * @return The bound in microseconds, 0 if there is no sample.
+ */
+uint32_t esp_ot_ip_stats_percentile(const esp_ot_ip_stats_latency_t *latency, uint16_t permille);
+
+/**
+ * @brief Get the name of a direction.
+ *
+ */
+const char *esp_ot_ip_stats_direction_name(esp_ot_ip_stats_direction_t direction);
+
+/**
+ * @brief Clear all the counters, the histograms and the multicast groups.
+ *
+ */
+void esp_ot_ip_stats_reset(void);
+
+/**
+ * @brief Set the function receiving the packets of the netifs, NULL to remove it.
+ *
+ */
+void esp_ot_ip_stats_set_tap(esp_ot_ip_stats_tap_t tap);
+
+/**
+ * @brief Get the name of a netif by its index.
+ *
+ * @return The name, NULL if no netif has the index.
+ */
+const char *esp_ot_ip_stats_netif_name(uint8_t netif);
+
+/**
+ * @brief The "ip stats" command process.
+ *
+ */
+otError esp_ot_ip_stats_process(uint8_t aArgsLength, char *aArgs[]);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
@@ -0,0 +1,135 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <esp_err.h>
+#include <openthread/error.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ESP_OT_LINK_QUALITY_ANY_NODE 0xffff
+#define ESP_OT_LINK_QUALITY_MAX_POINTS 24 /*!< The max number of points of a link in one resolution */
+
+/**
+ * @brief The resolution of the history of a link.
+ *
+ */
+typedef enum {
+    ESP_OT_LINK_QUALITY_RAW,     /*!< Each sample */
+    ESP_OT_LINK_QUALITY_MINUTE,  /*!< 1-minute rollups of the last 15 minutes */
+    ESP_OT_LINK_QUALITY_QUARTER, /*!< 15-minute rollups of the last 4 hours */
+    ESP_OT_LINK_QUALITY_HOUR,    /*!< 1-hour rollups of the last 24 hours */
+} esp_ot_link_quality_resolution_t;
+
+/**
+ * @brief A sample or a rollup of a link, seen from the router with the lower RLOC16.
+ *
+ */
+typedef struct esp_ot_link_quality_point {
+    uint32_t time;                  /*!< The seconds since boot of the sample or of the start of the rollup */
+    uint16_t count;                 /*!< The number of samples, 1 for a sample, saturates at 255 for a rollup */
+    uint16_t link_quality_in_x100;  /*!< The average link quality in multiplied by 100 */
+    uint16_t link_quality_out_x100; /*!< The average link quality out multiplied by 100 */
+    uint8_t min_link_quality_in;    /*!< The min link quality in, 0 when the link was down */
+    uint8_t min_link_quality_out;   /*!< The min link quality out, 0 when the link was down */
+    uint8_t max_route_cost;         /*!< The max route cost, capped at 15 */
+} esp_ot_link_quality_point_t;
+
+/**
+ * @brief The callback of each link matching a query.
+ *
+ * @param[in] router     The RLOC16 of the router with the lower RLOC16.
+ * @param[in] neighbor   The RLOC16 of the other router.
+ * @param[in] resolution The resolution of the points.
+ * @param[in] points     The points in the order of time.
+ * @param[in] count      The number of points.
+ * @param[in] context    The context of the query.
+ */
+typedef void (*esp_ot_link_quality_callback_t)(uint16_t router, uint16_t neighbor,
+                                               esp_ot_link_quality_resolution_t resolution,
+                                               const esp_ot_link_quality_point_t *points, uint16_t count,
+                                               void *context);
+
+/**
+ * @brief Allocate the link quality store and start sampling the router table of this node.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_NO_MEM if there is no memory for the store
+ */
+esp_err_t esp_ot_link_quality_init(void);
+
+/**
+ * @brief Get the seconds since boot, the time base of the store.
+ *
+ */
+uint32_t esp_ot_link_quality_now(void);
+
+/**
+ * @brief Add a sample of a link reported by a router.
+ *
+ * @note All the functions of the store, except init and now, must be called with the OpenThread lock held.
+ *       A link is added when it is up, a sample with both link qualities 0 is only added to a known link.
+ *       The least recently sampled link is replaced when the store is full.
+ *
+ * @param[in] reporter          The RLOC16 of the reporting router.
+ * @param[in] neighbor          The RLOC16 of the neighbor router.
+ * @param[in] link_quality_in   The link quality in seen by the reporter, 0 to 3.
+ * @param[in] link_quality_out  The link quality out seen by the reporter, 0 to 3.
+ * @param[in] route_cost        The route cost from the reporter to the neighbor.
+ * @param[in] time              The seconds since boot of the sample.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_NOT_FOUND if the link is down and not known
+ *      - ESP_ERR_INVALID_STATE if the store is not initialized
+ */
+esp_err_t esp_ot_link_quality_add_sample(uint16_t reporter, uint16_t neighbor, uint8_t link_quality_in,
+                                         uint8_t link_quality_out, uint8_t route_cost, uint32_t time);
+
+/**
+ * @brief Get the history of the links between @param from and @param to, each link in the finest resolution which
+ *        covers @param from.
+ *
+ * @param[in] from      The seconds since boot of the first point.
+ * @param[in] to        The seconds since boot of the last point.
+ * @param[in] node      Only the links of this RLOC16, ESP_OT_LINK_QUALITY_ANY_NODE for all the links.
+ * @param[in] callback  The callback of each link with points in the range.
+ * @param[in] context   The context of the callback.
+ *
+ */
+void esp_ot_link_quality_query(uint32_t from, uint32_t to, uint16_t node, esp_ot_link_quality_callback_t callback,
+                               void *context);
+
+/**
+ * @brief Get the name of a resolution, "raw", "1m", "15m" or "1h".
+ *
+ */
+const char *esp_ot_link_quality_resolution_to_string(esp_ot_link_quality_resolution_t resolution);
+
+/**
+ * @brief Get the usage of the store.
+ *
+ * @param[out] links      The number of the links.
+ * @param[out] max_links  The max number of the links.
+ * @param[out] bytes      The memory of the store.
+ */
+void esp_ot_link_quality_get_usage(uint16_t *links, uint16_t *max_links, size_t *bytes);
+
+/**
+ * @brief User command "linkquality" process.
+ *
+ */
+otError esp_ot_process_link_quality(void *aContext, uint8_t aArgsLength, char *aArgs[]);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
@@ -0,0 +1,56 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <esp_err.h>
+#include "sdkconfig.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Install the deferred log backend.
+ *
+ * @note The log lines are written into a lock-free ring buffer by the logging tasks, and printed by a low priority
+ *       task through the previous vprintf of esp_log.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_NO_MEM if failed to allocate the buffers
+ *      - ESP_FAIL on other failures
+ */
+esp_err_t esp_ot_log_ringbuf_init(void);
+
+/**
+ * @brief Print the recently drained log lines to the CLI.
+ *
+ * @param[in] lines     The number of the latest lines to print, 0 to print the whole history.
+ *
+ */
+void esp_ot_log_ringbuf_print_history(uint32_t lines);
+
+/**
+ * @brief Print the counters of the deferred log backend to the CLI.
+ *
+ */
+void esp_ot_log_ringbuf_print_stats(void);
+
+#if CONFIG_OPENTHREAD_LOG_RINGBUF_BENCH
+/**
+ * @brief Measure the cost of ESP_LOGI with the default backend and with the deferred backend.
+ *
+ * @param[in] count     The number of log calls of each measurement.
+ *
+ */
+void esp_ot_log_ringbuf_bench(uint32_t count);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
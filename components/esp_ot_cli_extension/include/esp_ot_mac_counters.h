@@ -0,0 +1,153 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <esp_err.h>
+#include <openthread/error.h>
+#include <openthread/netdiag.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ESP_OT_MAC_COUNTERS_ANY_NODE 0xffff
+#define ESP_OT_MAC_COUNTERS_UNKNOWN 0xffff /*!< The rate which is not known, the retries of the other nodes */
+
+/**
+ * @brief The counter deltas of a node over one sweep interval.
+ *
+ */
+typedef struct esp_ot_mac_counters_interval {
+    uint32_t time;        /*!< The seconds since boot of the end of the interval */
+    uint32_t duration;    /*!< The seconds of the interval */
+    uint32_t tx_frames;   /*!< The unicast and broadcast frames sent */
+    uint32_t tx_errors;   /*!< The frames failed by CCA or by a busy channel */
+    uint32_t tx_retries;  /*!< The retransmissions, only counted for this node */
+    uint32_t rx_frames;   /*!< The unicast and broadcast frames received */
+    uint32_t rx_errors;   /*!< The frames received with an error */
+    uint32_t rx_discards; /*!< The frames filtered, duplicated or of an unknown protocol */
+} esp_ot_mac_counters_interval_t;
+
+/**
+ * @brief The rates of a node derived from its intervals in a window.
+ *
+ */
+typedef struct esp_ot_mac_counters_node_stats {
+    uint16_t rloc16;
+    uint16_t intervals;                 /*!< The number of the intervals in the window */
+    uint16_t resets;                    /*!< The number of the counter resets seen, e.g. by a reboot */
+    esp_ot_mac_counters_interval_t sum; /*!< The sum of the intervals in the window */
+    uint16_t tx_error_permille;         /*!< tx_errors per tx_frames */
+    uint16_t rx_error_permille;         /*!< rx_errors per received frame including the errors */
+    uint16_t retry_permille;            /*!< tx_retries per transmission, ESP_OT_MAC_COUNTERS_UNKNOWN if not counted */
+    uint16_t utilization_permille;      /*!< The estimated air time of the frames sent and heard per duration */
+    uint16_t score_permille;            /*!< The max of the error and retry rates, the higher the worse */
+} esp_ot_mac_counters_node_stats_t;
+
+/**
+ * @brief A link between two routers ranked by its link quality and the error rates of its routers.
+ *
+ */
+typedef struct esp_ot_mac_counters_link_stats {
+    uint16_t router;                 /*!< The RLOC16 of the router with the lower RLOC16 */
+    uint16_t neighbor;               /*!< The RLOC16 of the other router */
+    uint8_t link_quality;            /*!< The min of the link quality in and out reported by both routers */
+    uint16_t node_tx_error_permille; /*!< A node-level estimate, not a rate of the link: the average of the tx error
+                                          rates of the routers with enough frames, which count the frames sent to all
+                                          their neighbors, ESP_OT_MAC_COUNTERS_UNKNOWN if neither router has enough
+                                          frames */
+} esp_ot_mac_counters_link_stats_t;
+
+/**
+ * @brief Allocate the MAC counters store.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_NO_MEM if there is no memory for the store
+ */
+esp_err_t esp_ot_mac_counters_init(void);
+
+/**
+ * @brief Add the MAC Counters TLV of a diagnostic response.
+ *
+ * @note All the functions of the store, except init, must be called with the OpenThread lock held.
+ *       The first totals of a node only start its intervals, a total lower than the previous one is taken as a
+ *       counter reset. The least recently updated node is replaced when the store is full.
+ *
+ * @param[in] rloc16    The RLOC16 of the reporting node.
+ * @param[in] counters  The MAC counters of the node.
+ * @param[in] time      The seconds since boot of the response.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_STATE if the store is not initialized
+ */
+esp_err_t esp_ot_mac_counters_add_diag(uint16_t rloc16, const otNetworkDiagMacCounters *counters, uint32_t time);
+
+/**
+ * @brief Add the links of the Route TLV of a diagnostic response, the links of the previous Route TLV are replaced.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_NOT_FOUND if the MAC counters of the node are not known
+ */
+esp_err_t esp_ot_mac_counters_add_route(uint16_t rloc16, const otNetworkDiagRoute *route);
+
+/**
+ * @brief Add the MAC counters and the router links of this node, including the retries.
+ *
+ */
+esp_err_t esp_ot_mac_counters_sample_local(uint32_t time);
+
+/**
+ * @brief Get the nodes with the highest error or retry rate in the last @param window seconds.
+ *
+ * @note The nodes with less than 20 frames sent and received in the window are skipped, their rates are noise.
+ *
+ * @param[in]  window  The seconds of the window, 0 for the whole history.
+ * @param[out] nodes   The nodes from the worst.
+ * @param[in]  max     The max number of the nodes.
+ *
+ * @return The number of the nodes.
+ */
+uint16_t esp_ot_mac_counters_get_worst_nodes(uint32_t window, esp_ot_mac_counters_node_stats_t *nodes, uint16_t max);
+
+/**
+ * @brief Get the links with the lowest link quality, the links of the same link quality with the higher error rate
+ *        first.
+ *
+ * @return The number of the links.
+ */
+uint16_t esp_ot_mac_counters_get_worst_links(uint32_t window, esp_ot_mac_counters_link_stats_t *links, uint16_t max);
+
+/**
+ * @brief Get the rates and the intervals of a node.
+ *
+ * @param[in]  rloc16     The RLOC16 of the node.
+ * @param[in]  window     The seconds of the window, 0 for the whole history.
+ * @param[out] stats      The rates of the node.
+ * @param[out] intervals  The intervals in the window from the oldest, NULL to skip.
+ * @param[in]  max        The max number of the intervals.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_NOT_FOUND if the node is not known
+ */
+esp_err_t esp_ot_mac_counters_get_node(uint16_t rloc16, uint32_t window, esp_ot_mac_counters_node_stats_t *stats,
+                                       esp_ot_mac_counters_interval_t *intervals, uint16_t max);
+
+/**
+ * @brief User command "maccounters" process.
+ *
+ */
+otError esp_ot_process_mac_counters(void *aContext, uint8_t aArgsLength, char *aArgs[]);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
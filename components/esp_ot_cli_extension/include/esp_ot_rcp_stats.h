@@ -0,0 +1,36 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <esp_err.h>
+#include <openthread/error.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Initialize the RCP statistics and the timer of their window.
+ *
+ * @note Should be called after the OpenThread instance is initialized.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_FAIL on failure
+ */
+esp_err_t esp_ot_rcp_stats_init(void);
+
+/**
+ * @brief User command "otrcp stats" process.
+ *
+ */
+otError esp_ot_process_rcp_stats(void *aContext, uint8_t aArgsLength, char *aArgs[]);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
@@ -0,0 +1,105 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_ot_boot_timeline.h"
+#include "esp_ot_cli_extension.h"
+#include "esp_timer.h"
+#include "inttypes.h"
+#include "stdlib.h"
+#include "string.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "openthread/cli.h"
+
+static esp_ot_boot_phase_t s_phases[CONFIG_OPENTHREAD_BOOT_TIMELINE_MAX_PHASES];
+static uint8_t s_phases_num = 0;
+static uint32_t s_phases_dropped = 0;
+static portMUX_TYPE s_phases_lock = portMUX_INITIALIZER_UNLOCKED;
+
+void esp_ot_boot_phase_begin(const char *name)
+{
+    int64_t now = esp_timer_get_time();
+    const char *task = pcTaskGetName(NULL);
+
+    portENTER_CRITICAL(&s_phases_lock);
+    if (s_phases_num < CONFIG_OPENTHREAD_BOOT_TIMELINE_MAX_PHASES) {
+        esp_ot_boot_phase_t *phase = &s_phases[s_phases_num++];
+        phase->name = name;
+        strlcpy(phase->task, task ? task : "", sizeof(phase->task));
+        phase->begin_us = now;
+        phase->end_us = ESP_OT_BOOT_PHASE_RUNNING;
+    } else {
+        s_phases_dropped++;
+    }
+    portEXIT_CRITICAL(&s_phases_lock);
+}
+
+void esp_ot_boot_phase_end(const char *name)
+{
+    int64_t now = esp_timer_get_time();
+
+    portENTER_CRITICAL(&s_phases_lock);
+    for (int i = s_phases_num - 1; i >= 0; i--) {
+        esp_ot_boot_phase_t *phase = &s_phases[i];
+        if (phase->end_us == ESP_OT_BOOT_PHASE_RUNNING && (phase->name == name || strcmp(phase->name, name) == 0)) {
+            phase->end_us = now;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&s_phases_lock);
+}
+
+uint8_t esp_ot_boot_timeline_get(esp_ot_boot_phase_t *phases, uint8_t max, uint32_t *dropped)
+{
+    portENTER_CRITICAL(&s_phases_lock);
+    uint8_t num = s_phases_num < max ? s_phases_num : max;
+    memcpy(phases, s_phases, num * sizeof(esp_ot_boot_phase_t));
+    if (dropped) {
+        *dropped = s_phases_dropped;
+    }
+    portEXIT_CRITICAL(&s_phases_lock);
+    return num;
+}
+
+otError esp_ot_process_boot_timeline(void *aContext, uint8_t aArgsLength, char *aArgs[])
+{
+    (void)(aContext);
+    (void)(aArgs);
+    if (aArgsLength != 0) {
+        otCliOutputFormat("---boottime command parameter---\n");
+        otCliOutputFormat("boottime            : print the phases of the boot, in the order they began\n");
+        return OT_ERROR_INVALID_ARGS;
+    }
+
+    esp_ot_boot_phase_t *phases = malloc(CONFIG_OPENTHREAD_BOOT_TIMELINE_MAX_PHASES * sizeof(esp_ot_boot_phase_t));
+    if (!phases) {
+        return OT_ERROR_NO_BUFS;
+    }
+    uint32_t dropped = 0;
+    uint8_t num = esp_ot_boot_timeline_get(phases, CONFIG_OPENTHREAD_BOOT_TIMELINE_MAX_PHASES, &dropped);
+    int64_t last_end_us = 0;
+
+    otCliOutputFormat("| Begin(us)  | End(us)    | Duration(us) | Task             | Phase\n");
+    otCliOutputFormat("+------------+------------+--------------+------------------+------------------\n");
+    for (uint8_t i = 0; i < num; i++) {
+        if (phases[i].end_us == ESP_OT_BOOT_PHASE_RUNNING) {
+            otCliOutputFormat("| %10" PRId64 " | %10s | %12s | %-16s | %s\n", phases[i].begin_us, "running", "-",
+                              phases[i].task, phases[i].name);
+        } else {
+            otCliOutputFormat("| %10" PRId64 " | %10" PRId64 " | %12" PRId64 " | %-16s | %s\n", phases[i].begin_us,
+                              phases[i].end_us, phases[i].end_us - phases[i].begin_us, phases[i].task, phases[i].name);
+            if (phases[i].end_us > last_end_us) {
+                last_end_us = phases[i].end_us;
+            }
+        }
+    }
+    otCliOutputFormat("Last phase ended at %" PRId64 " us\n", last_end_us);
+    if (dropped) {
+        otCliOutputFormat("%" PRIu32 " phases dropped, raise OPENTHREAD_BOOT_TIMELINE_MAX_PHASES\n", dropped);
+    }
+    free(phases);
+    return OT_ERROR_NONE;
+}
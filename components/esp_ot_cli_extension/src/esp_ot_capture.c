@@ -0,0 +1,498 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_ot_capture.h"
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include "esp_check.h"
+#include "esp_log.h"
+#include "esp_ot_cli_extension.h"
+#include "esp_timer.h"
+#include "lwip/pbuf.h"
+#include "lwip/prot/ip.h"
+#include "lwip/prot/ip6.h"
+#include "openthread/cli.h"
+
+#define CAPTURE_RING_SIZE CONFIG_OPENTHREAD_CAPTURE_RING_SIZE
+#define CAPTURE_MAX_SNAPLEN 1500
+#define CAPTURE_PEEK_SIZE 64 /* the bytes of the IP and transport headers read by the filter */
+
+_Static_assert((CAPTURE_RING_SIZE & (CAPTURE_RING_SIZE - 1)) == 0,
+               "The capture ring buffer size must be a power of two");
+
+/*
+ * The ring buffer is written by the netif taps of the IP statistics, in the tasks handing the packets to lwIP or to
+ * the netif glue, and read by one reader, so the records are reserved and published as those of the log ring buffer.
+ * Each record starts with a 32-bit header holding the record length and the flags below, and is padded to 4 bytes. A
+ * record never wraps around the end of the ring, the space left at the end is filled by a skip record instead. A
+ * packet which does not fit is dropped and counted, the forwarding path never waits for the reader.
+ */
+#define CAPTURE_RECORD_COMMITTED (1UL << 31)
+#define CAPTURE_RECORD_SKIP (1UL << 30)
+#define CAPTURE_RECORD_LEN_MASK 0x0000FFFFUL
+#define CAPTURE_ALIGN(len) (((len) + 3) & ~3UL)
+
+#define PCAPNG_SHB_TYPE 0x0A0D0D0A
+#define PCAPNG_IDB_TYPE 0x00000001
+#define PCAPNG_ISB_TYPE 0x00000005
+#define PCAPNG_EPB_TYPE 0x00000006
+#define PCAPNG_BYTE_ORDER_MAGIC 0x1A2B3C4D
+#define PCAPNG_LINKTYPE_RAW 101 /* IPv4 or IPv6 without a link-layer header */
+#define PCAPNG_OPT_END 0
+#define PCAPNG_OPT_IF_NAME 2
+#define PCAPNG_OPT_EPB_FLAGS 2
+#define PCAPNG_OPT_ISB_IFRECV 4
+#define PCAPNG_OPT_ISB_IFDROP 5
+#define PCAPNG_EPB_INBOUND 1
+#define PCAPNG_EPB_OUTBOUND 2
+#define PCAPNG_SHB_SIZE 28
+#define PCAPNG_IDB_SIZE(name_len) (20 + 4 + CAPTURE_ALIGN(name_len) + 4)
+#define PCAPNG_EPB_SIZE(cap_len) (32 + CAPTURE_ALIGN(cap_len) + 8 + 4)
+#define PCAPNG_ISB_SIZE 52
+
+typedef enum {
+    CAPTURE_IDLE = 0,
+    CAPTURE_RUNNING,
+    CAPTURE_STOPPED, /* the packets captured are still read */
+} capture_state_t;
+
+typedef struct capture_record {
+    uint32_t time_low; /* the esp_timer time in us */
+    uint32_t time_high;
+    uint16_t orig_len;
+    uint8_t netif;
+    uint8_t egress;
+} capture_record_t;
+
+static uint8_t *s_ring = NULL;
+static _Atomic uint32_t s_head = 0;
+static _Atomic uint32_t s_tail = 0;
+static _Atomic uint32_t s_state = CAPTURE_IDLE;
+static _Atomic uint32_t s_matched[ESP_OT_IP_STATS_MAX_NETIFS];
+static _Atomic uint32_t s_dropped[ESP_OT_IP_STATS_MAX_NETIFS];
+static esp_ot_capture_filter_t s_filter;
+static int64_t s_epoch_offset_us = 0; /* the time of day at the esp_timer time 0 */
+static bool s_header_read = false;
+
+static inline _Atomic uint32_t *capture_record_header(uint32_t pos)
+{
+    return (_Atomic uint32_t *)&s_ring[pos & (CAPTURE_RING_SIZE - 1)];
+}
+
+/* Reserve a record of the payload size, return the position of its header or UINT32_MAX if the ring is full. */
+static uint32_t capture_ring_reserve(uint32_t len)
+{
+    uint32_t need = sizeof(uint32_t) + CAPTURE_ALIGN(len);
+    uint32_t head = atomic_load_explicit(&s_head, memory_order_relaxed);
+    uint32_t pad = 0;
+
+    do {
+        uint32_t offset = head & (CAPTURE_RING_SIZE - 1);
+        pad = offset + need > CAPTURE_RING_SIZE ? CAPTURE_RING_SIZE - offset : 0;
+        if (head + pad + need - atomic_load_explicit(&s_tail, memory_order_acquire) > CAPTURE_RING_SIZE) {
+            return UINT32_MAX;
+        }
+    } while (!atomic_compare_exchange_weak_explicit(&s_head, &head, head + pad + need, memory_order_acq_rel,
+                                                    memory_order_relaxed));
+
+    if (pad) {
+        atomic_store_explicit(capture_record_header(head), CAPTURE_RECORD_COMMITTED | CAPTURE_RECORD_SKIP | pad,
+                              memory_order_release);
+        head += pad;
+    }
+    return head;
+}
+
+static bool capture_addr_match(const uint8_t *src, const uint8_t *dst, uint8_t addr_len)
+{
+    const uint8_t *addr = IP_IS_V6(&s_filter.addr) ? (const uint8_t *)ip_2_ip6(&s_filter.addr)->addr
+                                                   : (const uint8_t *)&ip_2_ip4(&s_filter.addr)->addr;
+
+    if ((addr_len == 16) != IP_IS_V6(&s_filter.addr)) {
+        return false;
+    }
+    return memcmp(src, addr, addr_len) == 0 || memcmp(dst, addr, addr_len) == 0;
+}
+
+/* The next header is the one of the fixed IPv6 header, the packets with extension headers have no port. */
+static bool capture_match(const uint8_t *hdr, uint16_t len)
+{
+    uint8_t proto = 0;
+    uint8_t addr_len = 0;
+    uint16_t l4 = 0;
+
+    if (len >= 40 && (hdr[0] >> 4) == 6) {
+        proto = hdr[6];
+        addr_len = 16;
+        l4 = 40;
+    } else if (len >= 20 && (hdr[0] >> 4) == 4) {
+        proto = hdr[9];
+        addr_len = 4;
+        l4 = (hdr[0] & 0x0f) * 4;
+    } else {
+        return false;
+    }
+    if (s_filter.proto != ESP_OT_CAPTURE_ANY_PROTO && proto != s_filter.proto) {
+        return false;
+    }
+    if (s_filter.has_addr && !capture_addr_match(hdr + (addr_len == 16 ? 8 : 12), hdr + (addr_len == 16 ? 24 : 16),
+                                                 addr_len)) {
+        return false;
+    }
+    if (s_filter.port != ESP_OT_CAPTURE_ANY_PORT) {
+        if ((proto != IP_PROTO_UDP && proto != IP_PROTO_TCP) || len < l4 + 4) {
+            return false;
+        }
+        uint16_t src_port = ((uint16_t)hdr[l4] << 8) | hdr[l4 + 1];
+        uint16_t dst_port = ((uint16_t)hdr[l4 + 2] << 8) | hdr[l4 + 3];
+        return src_port == s_filter.port || dst_port == s_filter.port;
+    }
+    return true;
+}
+
+static void capture_tap(uint8_t netif, bool egress, const struct pbuf *p, uint16_t offset)
+{
+    uint8_t hdr[CAPTURE_PEEK_SIZE];
+    const char *name = esp_ot_ip_stats_netif_name(netif);
+
+    if (atomic_load_explicit(&s_state, memory_order_acquire) != CAPTURE_RUNNING || name == NULL ||
+        p->tot_len <= offset || (s_filter.netif[0] && strcmp(name, s_filter.netif) != 0)) {
+        return;
+    }
+    uint16_t len = p->tot_len - offset;
+    if (s_filter.has_addr || s_filter.port != ESP_OT_CAPTURE_ANY_PORT || s_filter.proto != ESP_OT_CAPTURE_ANY_PROTO) {
+        if (!capture_match(hdr, pbuf_copy_partial(p, hdr, sizeof(hdr), offset))) {
+            return;
+        }
+    }
+    atomic_fetch_add_explicit(&s_matched[netif], 1, memory_order_relaxed);
+
+    uint16_t cap_len = len < s_filter.snaplen ? len : s_filter.snaplen;
+    uint32_t pos = capture_ring_reserve(sizeof(capture_record_t) + cap_len);
+    if (pos == UINT32_MAX) {
+        atomic_fetch_add_explicit(&s_dropped[netif], 1, memory_order_relaxed);
+        return;
+    }
+    uint64_t now = (uint64_t)esp_timer_get_time();
+    uint8_t *record = &s_ring[(pos & (CAPTURE_RING_SIZE - 1)) + sizeof(uint32_t)];
+    capture_record_t meta = {
+        .time_low = (uint32_t)now,
+        .time_high = (uint32_t)(now >> 32),
+        .orig_len = len,
+        .netif = netif,
+        .egress = egress,
+    };
+    memcpy(record, &meta, sizeof(meta));
+    pbuf_copy_partial(p, record + sizeof(meta), cap_len, offset);
+    atomic_store_explicit(capture_record_header(pos), CAPTURE_RECORD_COMMITTED | (sizeof(meta) + cap_len),
+                          memory_order_release);
+}
+
+static inline uint8_t *capture_put16(uint8_t *out, uint16_t value)
+{
+    memcpy(out, &value, sizeof(value));
+    return out + sizeof(value);
+}
+
+static inline uint8_t *capture_put32(uint8_t *out, uint32_t value)
+{
+    memcpy(out, &value, sizeof(value));
+    return out + sizeof(value);
+}
+
+static inline uint8_t *capture_put_time(uint8_t *out, uint64_t timer_us)
+{
+    uint64_t time = timer_us + s_epoch_offset_us;
+
+    out = capture_put32(out, (uint32_t)(time >> 32));
+    return capture_put32(out, (uint32_t)time);
+}
+
+static const char *capture_netif_name(uint8_t netif)
+{
+    const char *name = esp_ot_ip_stats_netif_name(netif);
+
+    return name ? name : "none";
+}
+
+/* The blocks are written in the byte order of the host, which the Section Header Block tells the readers. */
+static size_t capture_write_header(uint8_t *buf, size_t size)
+{
+    size_t total = PCAPNG_SHB_SIZE;
+
+    for (uint8_t i = 0; i < ESP_OT_IP_STATS_MAX_NETIFS; i++) {
+        total += PCAPNG_IDB_SIZE(strlen(capture_netif_name(i)));
+    }
+    if (total > size) {
+        return 0;
+    }
+    uint8_t *out = capture_put32(buf, PCAPNG_SHB_TYPE);
+    out = capture_put32(out, PCAPNG_SHB_SIZE);
+    out = capture_put32(out, PCAPNG_BYTE_ORDER_MAGIC);
+    out = capture_put16(out, 1); /* version 1.0 */
+    out = capture_put16(out, 0);
+    out = capture_put32(out, UINT32_MAX); /* the section length is not known */
+    out = capture_put32(out, UINT32_MAX);
+    out = capture_put32(out, PCAPNG_SHB_SIZE);
+    for (uint8_t i = 0; i < ESP_OT_IP_STATS_MAX_NETIFS; i++) {
+        const char *name = capture_netif_name(i);
+        uint16_t name_len = strlen(name);
+        uint32_t block_len = PCAPNG_IDB_SIZE(name_len);
+        out = capture_put32(out, PCAPNG_IDB_TYPE);
+        out = capture_put32(out, block_len);
+        out = capture_put16(out, PCAPNG_LINKTYPE_RAW);
+        out = capture_put16(out, 0);
+        out = capture_put32(out, s_filter.snaplen);
+        out = capture_put16(out, PCAPNG_OPT_IF_NAME);
+        out = capture_put16(out, name_len);
+        memset(out, 0, CAPTURE_ALIGN(name_len));
+        memcpy(out, name, name_len);
+        out += CAPTURE_ALIGN(name_len);
+        out = capture_put32(out, PCAPNG_OPT_END);
+        out = capture_put32(out, block_len);
+    }
+    return total;
+}
+
+static size_t capture_write_epb(uint8_t *out, const capture_record_t *meta, const uint8_t *data, uint16_t cap_len)
+{
+    uint32_t block_len = PCAPNG_EPB_SIZE(cap_len);
+    uint8_t *start = out;
+
+    out = capture_put32(out, PCAPNG_EPB_TYPE);
+    out = capture_put32(out, block_len);
+    out = capture_put32(out, meta->netif);
+    out = capture_put_time(out, ((uint64_t)meta->time_high << 32) | meta->time_low);
+    out = capture_put32(out, cap_len);
+    out = capture_put32(out, meta->orig_len);
+    memset(out, 0, CAPTURE_ALIGN(cap_len));
+    memcpy(out, data, cap_len);
+    out += CAPTURE_ALIGN(cap_len);
+    out = capture_put16(out, PCAPNG_OPT_EPB_FLAGS);
+    out = capture_put16(out, sizeof(uint32_t));
+    out = capture_put32(out, meta->egress ? PCAPNG_EPB_OUTBOUND : PCAPNG_EPB_INBOUND);
+    out = capture_put32(out, PCAPNG_OPT_END);
+    out = capture_put32(out, block_len);
+    return out - start;
+}
+
+esp_err_t esp_ot_capture_start(const esp_ot_capture_filter_t *filter)
+{
+    struct timeval now;
+
+    ESP_RETURN_ON_FALSE(filter->snaplen > 0, ESP_ERR_INVALID_ARG, OT_EXT_CLI_TAG, "Invalid snaplen");
+    ESP_RETURN_ON_FALSE(atomic_load(&s_state) == CAPTURE_IDLE, ESP_ERR_INVALID_STATE, OT_EXT_CLI_TAG,
+                        "A capture is running");
+    if (s_ring == NULL) {
+        s_ring = (uint8_t *)calloc(1, CAPTURE_RING_SIZE);
+        ESP_RETURN_ON_FALSE(s_ring, ESP_ERR_NO_MEM, OT_EXT_CLI_TAG, "Failed to allocate capture ring buffer");
+    }
+    memset(s_ring, 0, CAPTURE_RING_SIZE);
+    atomic_store(&s_head, 0);
+    atomic_store(&s_tail, 0);
+    for (uint8_t i = 0; i < ESP_OT_IP_STATS_MAX_NETIFS; i++) {
+        atomic_store(&s_matched[i], 0);
+        atomic_store(&s_dropped[i], 0);
+    }
+    s_filter = *filter;
+    s_filter.snaplen = filter->snaplen < CAPTURE_MAX_SNAPLEN ? filter->snaplen : CAPTURE_MAX_SNAPLEN;
+    gettimeofday(&now, NULL);
+    s_epoch_offset_us = (int64_t)now.tv_sec * 1000000 + now.tv_usec - esp_timer_get_time();
+    s_header_read = false;
+    atomic_store(&s_state, CAPTURE_RUNNING);
+    esp_ot_ip_stats_set_tap(capture_tap);
+    return ESP_OK;
+}
+
+size_t esp_ot_capture_read(uint8_t *buf, size_t size)
+{
+    size_t used = 0;
+
+    if (atomic_load(&s_state) == CAPTURE_IDLE) {
+        return 0;
+    }
+    if (!s_header_read) {
+        used = capture_write_header(buf, size);
+        s_header_read = used > 0;
+        if (!s_header_read) {
+            return 0;
+        }
+    }
+    while (true) {
+        uint32_t tail = atomic_load_explicit(&s_tail, memory_order_relaxed);
+        if (tail == atomic_load_explicit(&s_head, memory_order_acquire)) {
+            break;
+        }
+        uint32_t header = atomic_load_explicit(capture_record_header(tail), memory_order_acquire);
+        if (!(header & CAPTURE_RECORD_COMMITTED)) {
+            // Reserved by a tap which has not finished copying the packet yet.
+            break;
+        }
+        uint32_t len = header & CAPTURE_RECORD_LEN_MASK;
+        uint32_t offset = tail & (CAPTURE_RING_SIZE - 1);
+        uint32_t record_size = (header & CAPTURE_RECORD_SKIP) ? len : sizeof(uint32_t) + CAPTURE_ALIGN(len);
+        if (!(header & CAPTURE_RECORD_SKIP)) {
+            capture_record_t meta;
+            const uint8_t *record = &s_ring[offset + sizeof(uint32_t)];
+            uint16_t cap_len = len - sizeof(meta);
+            if (used + PCAPNG_EPB_SIZE(cap_len) > size) {
+                break;
+            }
+            memcpy(&meta, record, sizeof(meta));
+            used += capture_write_epb(buf + used, &meta, record + sizeof(meta), cap_len);
+        }
+        memset(&s_ring[offset], 0, record_size);
+        atomic_store_explicit(&s_tail, tail + record_size, memory_order_release);
+    }
+    return used;
+}
+
+bool esp_ot_capture_is_running(void)
+{
+    return atomic_load(&s_state) == CAPTURE_RUNNING;
+}
+
+void esp_ot_capture_stop(void)
+{
+    uint32_t state = CAPTURE_RUNNING;
+
+    if (atomic_compare_exchange_strong(&s_state, &state, CAPTURE_STOPPED)) {
+        esp_ot_ip_stats_set_tap(NULL);
+    }
+}
+
+size_t esp_ot_capture_finish(uint8_t *buf, size_t size)
+{
+    uint64_t now = (uint64_t)esp_timer_get_time();
+    uint8_t *out = buf;
+
+    esp_ot_capture_stop();
+    if (atomic_load(&s_state) == CAPTURE_IDLE) {
+        return 0;
+    }
+    atomic_store(&s_state, CAPTURE_IDLE);
+    if (!s_header_read || size < PCAPNG_ISB_SIZE * ESP_OT_IP_STATS_MAX_NETIFS) {
+        return 0;
+    }
+    for (uint8_t i = 0; i < ESP_OT_IP_STATS_MAX_NETIFS; i++) {
+        out = capture_put32(out, PCAPNG_ISB_TYPE);
+        out = capture_put32(out, PCAPNG_ISB_SIZE);
+        out = capture_put32(out, i);
+        out = capture_put_time(out, now);
+        out = capture_put16(out, PCAPNG_OPT_ISB_IFRECV);
+        out = capture_put16(out, sizeof(uint64_t));
+        out = capture_put32(out, atomic_load(&s_matched[i])); /* the 64-bit counters of a little-endian host */
+        out = capture_put32(out, 0);
+        out = capture_put16(out, PCAPNG_OPT_ISB_IFDROP);
+        out = capture_put16(out, sizeof(uint64_t));
+        out = capture_put32(out, atomic_load(&s_dropped[i]));
+        out = capture_put32(out, 0);
+        out = capture_put32(out, PCAPNG_OPT_END);
+        out = capture_put32(out, PCAPNG_ISB_SIZE);
+    }
+    return out - buf;
+}
+
+const esp_ot_capture_filter_t *esp_ot_capture_get_stats(esp_ot_capture_netif_stats_t *stats)
+{
+    for (uint8_t i = 0; i < ESP_OT_IP_STATS_MAX_NETIFS; i++) {
+        const char *name = esp_ot_ip_stats_netif_name(i);
+        memset(stats[i].name, 0, sizeof(stats[i].name));
+        if (name) {
+            strncpy(stats[i].name, name, sizeof(stats[i].name) - 1);
+        }
+        stats[i].matched = atomic_load(&s_matched[i]);
+        stats[i].dropped = atomic_load(&s_dropped[i]);
+    }
+    return &s_filter;
+}
+
+esp_err_t esp_ot_capture_parse_filter(const char *key, const char *value, esp_ot_capture_filter_t *filter)
+{
+    char *end = NULL;
+    long number = 0;
+
+    if (strcmp(key, "netif") == 0) {
+        ESP_RETURN_ON_FALSE(strlen(value) == 2, ESP_ERR_INVALID_ARG, OT_EXT_CLI_TAG, "Invalid netif: %s", value);
+        memcpy(filter->netif, value, sizeof(filter->netif));
+        return ESP_OK;
+    }
+    if (strcmp(key, "addr") == 0) {
+        ESP_RETURN_ON_FALSE(ipaddr_aton(value, &filter->addr), ESP_ERR_INVALID_ARG, OT_EXT_CLI_TAG,
+                            "Invalid address: %s", value);
+        filter->has_addr = true;
+        return ESP_OK;
+    }
+    if (strcmp(key, "proto") == 0) {
+        if (strcmp(value, "udp") == 0) {
+            filter->proto = IP_PROTO_UDP;
+        } else if (strcmp(value, "tcp") == 0) {
+            filter->proto = IP_PROTO_TCP;
+        } else if (strcmp(value, "icmp6") == 0) {
+            filter->proto = IP6_NEXTH_ICMP6;
+        } else {
+            number = strtol(value, &end, 10);
+            ESP_RETURN_ON_FALSE(value[0] != '\0' && *end == '\0' && number >= 0 && number < ESP_OT_CAPTURE_ANY_PROTO,
+                                ESP_ERR_INVALID_ARG, OT_EXT_CLI_TAG, "Invalid proto: %s", value);
+            filter->proto = number;
+        }
+        return ESP_OK;
+    }
+    number = strtol(value, &end, 10);
+    ESP_RETURN_ON_FALSE(value[0] != '\0' && *end == '\0', ESP_ERR_INVALID_ARG, OT_EXT_CLI_TAG, "Invalid %s: %s", key,
+                        value);
+    if (strcmp(key, "port") == 0) {
+        ESP_RETURN_ON_FALSE(number > 0 && number <= UINT16_MAX, ESP_ERR_INVALID_ARG, OT_EXT_CLI_TAG,
+                            "Invalid port: %s", value);
+        filter->port = number;
+    } else if (strcmp(key, "snaplen") == 0) {
+        ESP_RETURN_ON_FALSE(number > 0 && number <= CAPTURE_MAX_SNAPLEN, ESP_ERR_INVALID_ARG, OT_EXT_CLI_TAG,
+                            "Invalid snaplen: %s", value);
+        filter->snaplen = number;
+    } else {
+        ESP_LOGE(OT_EXT_CLI_TAG, "Unknown filter: %s", key);
+        return ESP_ERR_INVALID_ARG;
+    }
+    return ESP_OK;
+}
+
+otError esp_ot_process_capture(void *aContext, uint8_t aArgsLength, char *aArgs[])
+{
+    static const char *const s_state_names[] = {"idle", "running", "stopped"};
+    esp_ot_capture_netif_stats_t stats[ESP_OT_IP_STATS_MAX_NETIFS];
+    char addr[IPADDR_STRLEN_MAX];
+
+    if (aArgsLength == 0) {
+        const esp_ot_capture_filter_t *filter = esp_ot_capture_get_stats(stats);
+        otCliOutputFormat("state: %s, ring buffer: %u bytes\n", s_state_names[atomic_load(&s_state)],
+                          CAPTURE_RING_SIZE);
+        otCliOutputFormat("filter: netif %s, addr %s", filter->netif[0] ? filter->netif : "any",
+                          filter->has_addr ? ipaddr_ntoa_r(&filter->addr, addr, sizeof(addr)) : "any");
+        if (filter->port != ESP_OT_CAPTURE_ANY_PORT) {
+            otCliOutputFormat(", port %u", filter->port);
+        }
+        if (filter->proto != ESP_OT_CAPTURE_ANY_PROTO) {
+            otCliOutputFormat(", proto %u", filter->proto);
+        }
+        otCliOutputFormat(", snaplen %u\n", filter->snaplen);
+        for (uint8_t i = 0; i < ESP_OT_IP_STATS_MAX_NETIFS; i++) {
+            if (stats[i].name[0]) {
+                otCliOutputFormat("%s: %lu matched, %lu dropped\n", stats[i].name, (unsigned long)stats[i].matched,
+                                  (unsigned long)stats[i].dropped);
+            }
+        }
+    } else if (strcmp(aArgs[0], "stop") == 0) {
+        esp_ot_capture_stop();
+    } else {
+        return OT_ERROR_INVALID_ARGS;
+    }
+    return OT_ERROR_NONE;
+}
@@ -6,15 +6,27 @@
 
 #include "esp_ot_cli_extension.h"
 #include "esp_openthread.h"
+#include "esp_ot_boot_timeline.h"
 #include "esp_ot_br_lib_compati_check.h"
+#include "esp_ot_capture.h"
+#include "esp_ot_coex.h"
+#include "esp_ot_commission_job.h"
+#include "esp_ot_cpu_prof.h"
 #include "esp_ot_curl.h"
 #include "esp_ot_dns64.h"
+#include "esp_ot_dns_cache.h"
+#include "esp_ot_dns_pool.h"
 #include "esp_ot_heap_diag.h"
 #include "esp_ot_ip.h"
+#include "esp_ot_ip_stats.h"
+#include "esp_ot_link_quality.h"
+#include "esp_ot_log_ringbuf.h"
 #include "esp_ot_loglevel.h"
+#include "esp_ot_mac_counters.h"
 #include "esp_ot_nvs_diag.h"
 #include "esp_ot_ota_commands.h"
 #include "esp_ot_rcp_commands.h"
+#include "esp_ot_rcp_stats.h"
 #include "esp_ot_tcp_socket.h"
 #include "esp_ot_udp_socket.h"
 #include "esp_ot_wifi_cmd.h"
@@ -23,42 +35,59 @@
 #include "freertos/task.h"
 #include "openthread/cli.h"
 
+#if CONFIG_OPENTHREAD_HEAP_DIAG_SCOPE
+/* Each handler of the table is wrapped, so that its heap usage is accounted to its command. */
+#define ESP_OT_CLI_COMMAND(name, handler)                                                     \
+    static otError handler##_heap_scoped(void *aContext, uint8_t aArgsLength, char *aArgs[]) \
+    {                                                                                         \
+        esp_ot_heap_scope_t scope;                                                            \
+        esp_ot_heap_scope_begin(&scope, name);                                                \
+        otError error = handler(aContext, aArgsLength, aArgs);                                \
+        esp_ot_heap_scope_end(&scope);                                                        \
+        return error;                                                                         \
+    }
+#include "esp_ot_cli_commands.inc"
+#undef ESP_OT_CLI_COMMAND
+#define ESP_OT_CLI_COMMAND(name, handler) {name, handler##_heap_scoped},
+#else
+#define ESP_OT_CLI_COMMAND(name, handler) {name, handler},
+#endif // CONFIG_OPENTHREAD_HEAP_DIAG_SCOPE
+
 static const otCliCommand kCommands[] = {
-    {"curl", esp_openthread_process_curl},
-#if CONFIG_OPENTHREAD_DNS64_CLIENT
-    {"dns64server", esp_openthread_process_dns64_server},
-#endif // CONFIG_OPENTHREAD_DNS64_CLIENT
-    {"heapdiag", esp_ot_process_heap_diag},
-    {"ip", esp_ot_process_ip},
-    {"loglevel", esp_ot_process_logset},
-    {"mcast", esp_ot_process_mcast_group},
-#if CONFIG_OPENTHREAD_NVS_DIAG
-    {"nvsdiag", esp_ot_process_nvs_diag},
-#endif // CONFIG_OPENTHREAD_NVS_DIAG
-#if CONFIG_OPENTHREAD_CLI_OTA
-    {"ota", esp_openthread_process_ota_command},
-#endif // CONFIG_OPENTHREAD_CLI_OTA
-#if CONFIG_OPENTHREAD_RCP_COMMAND
-    {"otrcp", esp_openthread_process_rcp_command},
-#endif // CONFIG_OPENTHREAD_RCP_COMMAND
-    {"tcpsockclient", esp_ot_process_tcp_client},
-    {"tcpsockserver", esp_ot_process_tcp_server},
-    {"udpsockclient", esp_ot_process_udp_client},
-    {"udpsockserver", esp_ot_process_udp_server},
-#if CONFIG_OPENTHREAD_CLI_WIFI
-    {"wifi", esp_ot_process_wifi_cmd},
-#endif // CONFIG_OPENTHREAD_CLI_WIFI
-#if CONFIG_OPENTHREAD_BR_LIB_CHECK
-    {"brlibcheck", esp_openthread_process_br_lib_compatibility_check},
-#endif // CONFIG_OPENTHREAD_CLI_WIFI
+#include "esp_ot_cli_commands.inc"
 };
+#undef ESP_OT_CLI_COMMAND
 
 void esp_cli_custom_command_init()
 {
 #if CONFIG_OPENTHREAD_CLI_WIFI
     ESP_ERROR_CHECK(esp_ot_wifi_config_init());
+#endif
+#if CONFIG_OPENTHREAD_LOG_RINGBUF
+    esp_ot_log_ringbuf_init();
 #endif
     esp_ot_heap_diag_init();
+#if CONFIG_OPENTHREAD_RCP_STATS
+    esp_ot_rcp_stats_init();
+#endif
+#if CONFIG_OPENTHREAD_COEX
+    esp_ot_coex_init();
+#endif
+#if CONFIG_OPENTHREAD_LINK_QUALITY_STORE
+    esp_ot_link_quality_init();
+#endif
+#if CONFIG_OPENTHREAD_MAC_COUNTERS_STORE
+    esp_ot_mac_counters_init();
+#endif
+#if CONFIG_OPENTHREAD_DNS_CACHE
+    esp_ot_dns_cache_init();
+#endif
+#if CONFIG_OPENTHREAD_DNS_POOL
+    esp_ot_dns_pool_init(esp_ot_dns64_set_main_server);
+#endif
+#if CONFIG_OPENTHREAD_IP_STATS
+    esp_ot_ip_stats_init();
+#endif
     otInstance *instance = esp_openthread_get_instance();
     otCliSetUserCommands(kCommands, (sizeof(kCommands) / sizeof(kCommands[0])), instance);
 }
@@ -0,0 +1,589 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_ot_coex.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_check.h"
+#include "esp_log.h"
+#include "esp_openthread.h"
+#include "esp_openthread_lock.h"
+#include "esp_ot_cli_extension.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "openthread/cli.h"
+#include "openthread/link.h"
+#include "openthread/ping_sender.h"
+#include "openthread/platform/radio.h"
+#include "openthread/thread.h"
+#if CONFIG_OPENTHREAD_RADIO_STATS_ENABLE
+#include "openthread/radio_stats.h"
+#endif
+
+/* The priorities of the 802.15.4 radio are only configurable on the native radio with the software coexistence */
+#define COEX_HAS_PRIORITIES (CONFIG_OPENTHREAD_RADIO_NATIVE && CONFIG_ESP_COEX_SW_COEXIST_ENABLE)
+#if COEX_HAS_PRIORITIES
+#include "esp_ieee802154.h"
+#endif
+
+#define COEX_MEASURE_TASK_STACK_SIZE 3072
+#define COEX_MEASURE_TASK_PRIORITY 5
+/* The traffic pattern of each profile, echo requests fitting in a single 802.15.4 frame */
+#define COEX_MEASURE_COUNT 100
+#define COEX_MEASURE_SIZE 32
+#define COEX_MEASURE_INTERVAL_MS 50
+#define COEX_MEASURE_TIMEOUT_MS 1000
+
+typedef struct coex_window {
+    int64_t start_us;
+    otMacCounters mac;
+    bool has_metrics;
+    otRadioCoexMetrics metrics;
+#if CONFIG_OPENTHREAD_RADIO_STATS_ENABLE
+    otRadioTimeStats time;
+#endif
+} coex_window_t;
+
+typedef struct coex_ping {
+    uint16_t sent;
+    uint16_t received;
+    uint16_t rtt_min;
+    uint16_t rtt_max;
+    uint32_t rtt_sum;
+} coex_ping_t;
+
+static const char *s_profile_names[ESP_OT_COEX_PROFILES] = {"wifi", "balance", "thread", "custom"};
+static const char *s_priority_names[ESP_OT_COEX_PRIORITIES] = {"high", "middle", "low", "idle"};
+
+/* All the states but s_measure_done are accessed in the OpenThread task or with the OpenThread lock held */
+static coex_window_t s_window;
+static TaskHandle_t s_measure_task = NULL;
+static SemaphoreHandle_t s_measure_done = NULL;
+static esp_ot_coex_measure_state_t s_measure_state = ESP_OT_COEX_MEASURE_IDLE;
+static otIp6Address s_measure_destination;
+static esp_ot_coex_profile_t s_measure_profiles[ESP_OT_COEX_MEASURE_MAX_PROFILES];
+static uint8_t s_measure_profiles_num = 0;
+static esp_ot_coex_result_t s_measure_results[ESP_OT_COEX_MEASURE_MAX_PROFILES];
+static uint8_t s_measure_results_num = 0;
+static coex_ping_t s_measure_ping;
+
+#if COEX_HAS_PRIORITIES
+static const esp_ot_coex_priorities_t s_profiles[ESP_OT_COEX_PROFILE_CUSTOM] = {
+    [ESP_OT_COEX_PROFILE_WIFI] = {ESP_OT_COEX_PRIORITY_IDLE, ESP_OT_COEX_PRIORITY_LOW, ESP_OT_COEX_PRIORITY_LOW},
+    [ESP_OT_COEX_PROFILE_BALANCE] = {ESP_OT_COEX_PRIORITY_IDLE, ESP_OT_COEX_PRIORITY_LOW, ESP_OT_COEX_PRIORITY_MIDDLE},
+    [ESP_OT_COEX_PROFILE_THREAD] = {ESP_OT_COEX_PRIORITY_LOW, ESP_OT_COEX_PRIORITY_HIGH, ESP_OT_COEX_PRIORITY_HIGH},
+};
+
+static const ieee802154_coex_event_t s_events[ESP_OT_COEX_PRIORITIES] = {IEEE802154_HIGH, IEEE802154_MIDDLE,
+                                                                          IEEE802154_LOW, IEEE802154_IDLE};
+
+static esp_ot_coex_priority_t coex_priority_from_event(ieee802154_coex_event_t event)
+{
+    for (int i = 0; i < ESP_OT_COEX_PRIORITIES; i++) {
+        if (s_events[i] == event) {
+            return (esp_ot_coex_priority_t)i;
+        }
+    }
+    return ESP_OT_COEX_PRIORITY_IDLE;
+}
+
+static bool coex_priorities_read(esp_ot_coex_priorities_t *priorities)
+{
+    esp_ieee802154_coex_config_t config = esp_ieee802154_get_coex_config();
+    priorities->idle = coex_priority_from_event(config.idle);
+    priorities->txrx = coex_priority_from_event(config.txrx);
+    priorities->txrx_at = coex_priority_from_event(config.txrx_at);
+    return true;
+}
+
+static void coex_priorities_write(const esp_ot_coex_priorities_t *priorities)
+{
+    esp_ieee802154_coex_config_t config = {
+        .idle = s_events[priorities->idle],
+        .txrx = s_events[priorities->txrx],
+        .txrx_at = s_events[priorities->txrx_at],
+    };
+    esp_ieee802154_set_coex_config(config);
+}
+
+static esp_ot_coex_profile_t coex_profile_match(const esp_ot_coex_priorities_t *priorities)
+{
+    for (int i = 0; i < ESP_OT_COEX_PROFILE_CUSTOM; i++) {
+        if (memcmp(&s_profiles[i], priorities, sizeof(*priorities)) == 0) {
+            return (esp_ot_coex_profile_t)i;
+        }
+    }
+    return ESP_OT_COEX_PROFILE_CUSTOM;
+}
+#else
+static bool coex_priorities_read(esp_ot_coex_priorities_t *priorities)
+{
+    (void)priorities;
+    return false;
+}
+#endif // COEX_HAS_PRIORITIES
+
+static uint32_t coex_delta(uint32_t now, uint32_t base)
+{
+    // The counters restart from zero if they are reset elsewhere, e.g. by `counters mac reset`.
+    return now >= base ? now - base : now;
+}
+
+static uint32_t coex_avg_delta(uint32_t avg_now, uint32_t num_now, uint32_t avg_base, uint32_t num_base)
+{
+    if (num_now == num_base) {
+        return 0;
+    } else if (num_now < num_base) {
+        return avg_now;
+    }
+    uint64_t sum_now = (uint64_t)avg_now * num_now;
+    uint64_t sum_base = (uint64_t)avg_base * num_base;
+    return sum_now > sum_base ? (uint32_t)((sum_now - sum_base) / (num_now - num_base)) : 0;
+}
+
+static void coex_window_snapshot(coex_window_t *window)
+{
+    otInstance *instance = esp_openthread_get_instance();
+
+    window->start_us = esp_timer_get_time();
+    memcpy(&window->mac, otLinkGetCounters(instance), sizeof(otMacCounters));
+    window->has_metrics = otPlatRadioGetCoexMetrics(instance, &window->metrics) == OT_ERROR_NONE;
+#if CONFIG_OPENTHREAD_RADIO_STATS_ENABLE
+    memcpy(&window->time, otRadioTimeStatsGet(instance), sizeof(otRadioTimeStats));
+#endif
+}
+
+/* Fills the statistics of the window from base to now */
+static void coex_window_stats(const coex_window_t *base, const coex_window_t *now, esp_ot_coex_stats_t *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+    stats->enabled = otPlatRadioIsCoexEnabled(esp_openthread_get_instance());
+    stats->window_ms = (uint32_t)((now->start_us - base->start_us) / 1000);
+    stats->tx_frames = coex_delta(now->mac.mTxTotal, base->mac.mTxTotal);
+    stats->tx_deferred = coex_delta(now->mac.mTxErrCca, base->mac.mTxErrCca);
+    stats->tx_aborted = coex_delta(now->mac.mTxErrAbort, base->mac.mTxErrAbort) +
+        coex_delta(now->mac.mTxErrBusyChannel, base->mac.mTxErrBusyChannel);
+    stats->tx_retries = coex_delta(now->mac.mTxRetry, base->mac.mTxRetry);
+    stats->rx_frames = coex_delta(now->mac.mRxTotal, base->mac.mRxTotal);
+
+    stats->has_grants = base->has_metrics && now->has_metrics;
+    if (stats->has_grants) {
+        const otRadioCoexMetrics *from = &base->metrics;
+        const otRadioCoexMetrics *to = &now->metrics;
+        uint32_t tx_granted_from = from->mNumTxGrantImmediate + from->mNumTxGrantWaitActivated;
+        uint32_t tx_granted_to = to->mNumTxGrantImmediate + to->mNumTxGrantWaitActivated;
+        uint32_t rx_granted_from = from->mNumRxGrantImmediate + from->mNumRxGrantWaitActivated;
+        uint32_t rx_granted_to = to->mNumRxGrantImmediate + to->mNumRxGrantWaitActivated;
+
+        stats->tx_requests = coex_delta(to->mNumTxRequest, from->mNumTxRequest);
+        stats->tx_granted = coex_delta(tx_granted_to, tx_granted_from);
+        stats->tx_denied = coex_delta(to->mNumTxGrantWaitTimeout + to->mNumTxGrantDeactivatedDuringRequest,
+                                      from->mNumTxGrantWaitTimeout + from->mNumTxGrantDeactivatedDuringRequest);
+        stats->tx_grant_wait_us = coex_avg_delta(to->mAvgTxRequestToGrantTime, tx_granted_to,
+                                                 from->mAvgTxRequestToGrantTime, tx_granted_from);
+        stats->rx_requests = coex_delta(to->mNumRxRequest, from->mNumRxRequest);
+        stats->rx_granted = coex_delta(rx_granted_to, rx_granted_from);
+        stats->rx_denied = coex_delta(to->mNumRxGrantWaitTimeout + to->mNumRxGrantDeactivatedDuringRequest +
+                                          to->mNumRxGrantNone,
+                                      from->mNumRxGrantWaitTimeout + from->mNumRxGrantDeactivatedDuringRequest +
+                                          from->mNumRxGrantNone);
+        stats->rx_grant_wait_us = coex_avg_delta(to->mAvgRxRequestToGrantTime, rx_granted_to,
+                                                 from->mAvgRxRequestToGrantTime, rx_granted_from);
+    }
+
+#if CONFIG_OPENTHREAD_RADIO_STATS_ENABLE
+    uint64_t tx_us = now->time.mTxTime - base->time.mTxTime;
+    uint64_t rx_us = now->time.mRxTime - base->time.mRxTime;
+    uint64_t sleep_us = now->time.mSleepTime - base->time.mSleepTime;
+    uint64_t total_us = tx_us + rx_us + sleep_us + (now->time.mDisabledTime - base->time.mDisabledTime);
+    if (total_us) {
+        stats->has_air_time = true;
+        stats->tx_permille = (uint16_t)(tx_us * 1000 / total_us);
+        stats->rx_permille = (uint16_t)(rx_us * 1000 / total_us);
+        stats->sleep_permille = (uint16_t)(sleep_us * 1000 / total_us);
+    }
+#endif
+}
+
+void esp_ot_coex_get_stats(esp_ot_coex_stats_t *stats)
+{
+    coex_window_t now;
+    coex_window_snapshot(&now);
+    coex_window_stats(&s_window, &now, stats);
+}
+
+void esp_ot_coex_reset(void)
+{
+    coex_window_snapshot(&s_window);
+}
+
+esp_ot_coex_profile_t esp_ot_coex_get_priorities(esp_ot_coex_priorities_t *priorities)
+{
+    if (!coex_priorities_read(priorities)) {
+        return ESP_OT_COEX_PROFILES;
+    }
+#if COEX_HAS_PRIORITIES
+    return coex_profile_match(priorities);
+#else
+    return ESP_OT_COEX_PROFILES;
+#endif
+}
+
+esp_err_t esp_ot_coex_set_priorities(const esp_ot_coex_priorities_t *priorities)
+{
+    ESP_RETURN_ON_FALSE(priorities->idle < ESP_OT_COEX_PRIORITIES && priorities->txrx < ESP_OT_COEX_PRIORITIES &&
+                            priorities->txrx_at < ESP_OT_COEX_PRIORITIES,
+                        ESP_ERR_INVALID_ARG, OT_EXT_CLI_TAG, "Invalid coex priority");
+#if COEX_HAS_PRIORITIES
+    ESP_RETURN_ON_FALSE(s_measure_state != ESP_OT_COEX_MEASURE_RUNNING, ESP_ERR_INVALID_STATE, OT_EXT_CLI_TAG,
+                        "Coex measurement is running");
+    coex_priorities_write(priorities);
+    return ESP_OK;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+esp_err_t esp_ot_coex_set_profile(esp_ot_coex_profile_t profile)
+{
+    ESP_RETURN_ON_FALSE(profile < ESP_OT_COEX_PROFILE_CUSTOM, ESP_ERR_INVALID_ARG, OT_EXT_CLI_TAG,
+                        "Invalid coex profile");
+#if COEX_HAS_PRIORITIES
+    return esp_ot_coex_set_priorities(&s_profiles[profile]);
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+static void coex_measure_reply(const otPingSenderReply *aReply, void *aContext)
+{
+    (void)aContext;
+    coex_ping_t *ping = &s_measure_ping;
+    if (ping->received == 0 || aReply->mRoundTripTime < ping->rtt_min) {
+        ping->rtt_min = aReply->mRoundTripTime;
+    }
+    if (aReply->mRoundTripTime > ping->rtt_max) {
+        ping->rtt_max = aReply->mRoundTripTime;
+    }
+    ping->rtt_sum += aReply->mRoundTripTime;
+    ping->received++;
+}
+
+static void coex_measure_statistics(const otPingSenderStatistics *aStatistics, void *aContext)
+{
+    (void)aContext;
+    s_measure_ping.sent = aStatistics->mSentCount;
+    xSemaphoreGive(s_measure_done);
+}
+
+static void coex_measure_record(esp_ot_coex_profile_t profile, const coex_window_t *base)
+{
+    esp_ot_coex_result_t *result = &s_measure_results[s_measure_results_num++];
+    const coex_ping_t *ping = &s_measure_ping;
+    coex_window_t now;
+    esp_ot_coex_stats_t stats;
+
+    coex_window_snapshot(&now);
+    coex_window_stats(base, &now, &stats);
+    memset(result, 0, sizeof(*result));
+    result->profile = profile;
+    result->sent = ping->sent;
+    result->received = ping->received;
+    if (ping->received) {
+        result->rtt_min_ms = ping->rtt_min;
+        result->rtt_avg_ms = (uint16_t)(ping->rtt_sum / ping->received);
+        result->rtt_max_ms = ping->rtt_max;
+    }
+    // Each echo replied carried the payload to the destination and back, over the window from the first request to
+    // the end of the pattern, the timeout after the last request included.
+    int64_t elapsed_us = now.start_us - base->start_us;
+    if (elapsed_us > 0) {
+        result->throughput_bps =
+            (uint32_t)((uint64_t)ping->received * COEX_MEASURE_SIZE * 2 * 8 * 1000000 / (uint64_t)elapsed_us);
+    }
+    result->tx_deferred = stats.tx_deferred;
+    result->tx_aborted = stats.tx_aborted;
+    result->tx_denied = stats.tx_denied;
+}
+
+static void coex_measure_worker(void *aContext)
+{
+    otInstance *instance = esp_openthread_get_instance();
+    esp_ot_coex_priorities_t saved;
+    otPingSenderConfig config;
+    coex_window_t base;
+
+    memset(&config, 0, sizeof(config));
+    config.mDestination = s_measure_destination;
+    config.mReplyCallback = coex_measure_reply;
+    config.mStatisticsCallback = coex_measure_statistics;
+    config.mSize = COEX_MEASURE_SIZE;
+    config.mCount = COEX_MEASURE_COUNT;
+    config.mInterval = COEX_MEASURE_INTERVAL_MS;
+    config.mTimeout = COEX_MEASURE_TIMEOUT_MS;
+
+    esp_openthread_lock_acquire(portMAX_DELAY);
+    esp_ot_coex_profile_t current = esp_ot_coex_get_priorities(&saved);
+    esp_openthread_lock_release();
+
+    // Without a profile given, the priorities in use are measured once.
+    uint8_t rounds = s_measure_profiles_num ? s_measure_profiles_num : 1;
+    for (uint8_t i = 0; i < rounds; i++) {
+        esp_ot_coex_profile_t profile = s_measure_profiles_num ? s_measure_profiles[i] : current;
+
+        esp_openthread_lock_acquire(portMAX_DELAY);
+#if COEX_HAS_PRIORITIES
+        if (s_measure_profiles_num) {
+            coex_priorities_write(&s_profiles[profile]);
+        }
+#endif
+        memset(&s_measure_ping, 0, sizeof(s_measure_ping));
+        xSemaphoreTake(s_measure_done, 0);
+        coex_window_snapshot(&base);
+        otError error = otPingSenderPing(instance, &config);
+        esp_openthread_lock_release();
+        if (error != OT_ERROR_NONE) {
+            ESP_LOGE(OT_EXT_CLI_TAG, "Failed to start the coex measurement: %s", otThreadErrorToString(error));
+            break;
+        }
+
+        if (xSemaphoreTake(s_measure_done, pdMS_TO_TICKS(COEX_MEASURE_COUNT * COEX_MEASURE_INTERVAL_MS +
+                                                         COEX_MEASURE_TIMEOUT_MS + 1000)) != pdTRUE) {
+            ESP_LOGW(OT_EXT_CLI_TAG, "Coex measurement of profile %s timed out", esp_ot_coex_profile_name(profile));
+            esp_openthread_lock_acquire(portMAX_DELAY);
+            otPingSenderStop(instance);
+            // All the echo requests were sent by now.
+            s_measure_ping.sent = COEX_MEASURE_COUNT;
+            esp_openthread_lock_release();
+        }
+
+        esp_openthread_lock_acquire(portMAX_DELAY);
+        coex_measure_record(profile, &base);
+        esp_openthread_lock_release();
+    }
+
+    esp_openthread_lock_acquire(portMAX_DELAY);
+#if COEX_HAS_PRIORITIES
+    if (s_measure_profiles_num) {
+        coex_priorities_write(&saved);
+    }
+#endif
+    s_measure_state = ESP_OT_COEX_MEASURE_DONE;
+    s_measure_task = NULL;
+    esp_openthread_lock_release();
+    vTaskDelete(NULL);
+}
+
+esp_err_t esp_ot_coex_measure_start(const otIp6Address *destination, const esp_ot_coex_profile_t *profiles,
+                                    uint8_t count)
+{
+    ESP_RETURN_ON_FALSE(s_measure_state != ESP_OT_COEX_MEASURE_RUNNING, ESP_ERR_INVALID_STATE, OT_EXT_CLI_TAG,
+                        "Coex measurement is running");
+    ESP_RETURN_ON_FALSE(count <= ESP_OT_COEX_MEASURE_MAX_PROFILES, ESP_ERR_INVALID_ARG, OT_EXT_CLI_TAG,
+                        "Too many coex profiles");
+    // The replies of a multicast echo request cannot be told apart by profile.
+    ESP_RETURN_ON_FALSE(destination->mFields.m8[0] != 0xff, ESP_ERR_INVALID_ARG, OT_EXT_CLI_TAG,
+                        "Coex measurement needs a unicast destination");
+    for (uint8_t i = 0; i < count; i++) {
+        ESP_RETURN_ON_FALSE(profiles[i] < ESP_OT_COEX_PROFILE_CUSTOM, ESP_ERR_INVALID_ARG, OT_EXT_CLI_TAG,
+                            "Invalid coex profile");
+    }
+#if !COEX_HAS_PRIORITIES
+    ESP_RETURN_ON_FALSE(count == 0, ESP_ERR_NOT_SUPPORTED, OT_EXT_CLI_TAG, "Coex priorities are not supported");
+#endif
+
+    memcpy(&s_measure_destination, destination, sizeof(otIp6Address));
+    memcpy(s_measure_profiles, profiles, count * sizeof(esp_ot_coex_profile_t));
+    s_measure_profiles_num = count;
+    s_measure_results_num = 0;
+    // The worker waits for the OpenThread lock held by the caller, so it sees the state set below.
+    ESP_RETURN_ON_FALSE(xTaskCreate(coex_measure_worker, "coex_measure", COEX_MEASURE_TASK_STACK_SIZE, NULL,
+                                    COEX_MEASURE_TASK_PRIORITY, &s_measure_task) == pdTRUE,
+                        ESP_ERR_NO_MEM, OT_EXT_CLI_TAG, "Failed to create coex measurement task");
+    s_measure_state = ESP_OT_COEX_MEASURE_RUNNING;
+    return ESP_OK;
+}
+
+esp_ot_coex_measure_state_t esp_ot_coex_measure_get(esp_ot_coex_result_t *results, uint8_t *count)
+{
+    memcpy(results, s_measure_results, s_measure_results_num * sizeof(esp_ot_coex_result_t));
+    *count = s_measure_results_num;
+    return s_measure_state;
+}
+
+const char *esp_ot_coex_profile_name(esp_ot_coex_profile_t profile)
+{
+    return profile < ESP_OT_COEX_PROFILES ? s_profile_names[profile] : "unknown";
+}
+
+esp_ot_coex_profile_t esp_ot_coex_profile_parse(const char *name)
+{
+    for (int i = 0; i < ESP_OT_COEX_PROFILE_CUSTOM; i++) {
+        if (strcmp(name, s_profile_names[i]) == 0) {
+            return (esp_ot_coex_profile_t)i;
+        }
+    }
+    return ESP_OT_COEX_PROFILES;
+}
+
+const char *esp_ot_coex_measure_state_name(esp_ot_coex_measure_state_t state)
+{
+    static const char *s_state_names[] = {"idle", "running", "done"};
+    return state <= ESP_OT_COEX_MEASURE_DONE ? s_state_names[state] : "unknown";
+}
+
+const char *esp_ot_coex_priority_name(esp_ot_coex_priority_t priority)
+{
+    return priority < ESP_OT_COEX_PRIORITIES ? s_priority_names[priority] : "unknown";
+}
+
+esp_ot_coex_priority_t esp_ot_coex_priority_parse(const char *name)
+{
+    for (int i = 0; i < ESP_OT_COEX_PRIORITIES; i++) {
+        if (strcmp(name, s_priority_names[i]) == 0) {
+            return (esp_ot_coex_priority_t)i;
+        }
+    }
+    return ESP_OT_COEX_PRIORITIES;
+}
+
+otError esp_ot_coex_error_to_ot_error(esp_err_t err)
+{
+    switch (err) {
+    case ESP_OK:
+        return OT_ERROR_NONE;
+    case ESP_ERR_INVALID_ARG:
+        return OT_ERROR_INVALID_ARGS;
+    case ESP_ERR_INVALID_STATE:
+        return OT_ERROR_INVALID_STATE;
+    case ESP_ERR_NOT_SUPPORTED:
+        return OT_ERROR_NOT_CAPABLE;
+    default:
+        return OT_ERROR_FAILED;
+    }
+}
+
+static void coex_print_permille(const char *name, uint32_t permille)
+{
+    otCliOutputFormat(" %s %lu.%lu %%", name, (unsigned long)permille / 10, (unsigned long)permille % 10);
+}
+
+static void coex_print_stats(void)
+{
+    esp_ot_coex_stats_t stats;
+    esp_ot_coex_priorities_t priorities;
+    esp_ot_coex_profile_t profile = esp_ot_coex_get_priorities(&priorities);
+
+    esp_ot_coex_get_stats(&stats);
+    otCliOutputFormat("coex: %s\n", stats.enabled ? "enabled" : "disabled");
+    if (profile < ESP_OT_COEX_PROFILES) {
+        otCliOutputFormat("profile: %s (idle: %s, txrx: %s, txrx_at: %s)\n", esp_ot_coex_profile_name(profile),
+                          esp_ot_coex_priority_name(priorities.idle), esp_ot_coex_priority_name(priorities.txrx),
+                          esp_ot_coex_priority_name(priorities.txrx_at));
+    }
+    otCliOutputFormat("window: %lu ms\n", (unsigned long)stats.window_ms);
+    otCliOutputFormat("tx frames: %lu, deferred: %lu, aborted: %lu, retries: %lu\n", (unsigned long)stats.tx_frames,
+                      (unsigned long)stats.tx_deferred, (unsigned long)stats.tx_aborted,
+                      (unsigned long)stats.tx_retries);
+    otCliOutputFormat("rx frames: %lu\n", (unsigned long)stats.rx_frames);
+    if (stats.has_grants) {
+        otCliOutputFormat("tx requests: %lu, granted: %lu, denied: %lu, avg grant wait: %lu us\n",
+                          (unsigned long)stats.tx_requests, (unsigned long)stats.tx_granted,
+                          (unsigned long)stats.tx_denied, (unsigned long)stats.tx_grant_wait_us);
+        otCliOutputFormat("rx requests: %lu, granted: %lu, denied: %lu, avg grant wait: %lu us\n",
+                          (unsigned long)stats.rx_requests, (unsigned long)stats.rx_granted,
+                          (unsigned long)stats.rx_denied, (unsigned long)stats.rx_grant_wait_us);
+    }
+    if (stats.has_air_time) {
+        otCliOutputFormat("air time:");
+        coex_print_permille("tx", stats.tx_permille);
+        coex_print_permille("rx", stats.rx_permille);
+        coex_print_permille("sleep", stats.sleep_permille);
+        otCliOutputFormat("\n");
+    }
+}
+
+static void coex_print_measurement(void)
+{
+    esp_ot_coex_result_t results[ESP_OT_COEX_MEASURE_MAX_PROFILES];
+    uint8_t count = 0;
+    esp_ot_coex_measure_state_t state = esp_ot_coex_measure_get(results, &count);
+
+    otCliOutputFormat("measurement: %s\n", esp_ot_coex_measure_state_name(state));
+    for (uint8_t i = 0; i < count; i++) {
+        const esp_ot_coex_result_t *result = &results[i];
+        otCliOutputFormat("%s: %u/%u received, rtt min/avg/max %u/%u/%u ms, %lu bps, deferred %lu, aborted %lu, "
+                          "denied %lu\n",
+                          esp_ot_coex_profile_name(result->profile), result->received, result->sent, result->rtt_min_ms,
+                          result->rtt_avg_ms, result->rtt_max_ms, (unsigned long)result->throughput_bps,
+                          (unsigned long)result->tx_deferred, (unsigned long)result->tx_aborted,
+                          (unsigned long)result->tx_denied);
+    }
+}
+
+otError esp_ot_process_coex(void *aContext, uint8_t aArgsLength, char *aArgs[])
+{
+    (void)aContext;
+    if (aArgsLength == 0) {
+        coex_print_stats();
+    } else if (strcmp(aArgs[0], "reset") == 0) {
+        esp_ot_coex_reset();
+    } else if (strcmp(aArgs[0], "profile") == 0) {
+        if (aArgsLength == 1) {
+            esp_ot_coex_priorities_t priorities;
+            esp_ot_coex_profile_t profile = esp_ot_coex_get_priorities(&priorities);
+            ESP_RETURN_ON_FALSE(profile < ESP_OT_COEX_PROFILES, OT_ERROR_NOT_CAPABLE, OT_EXT_CLI_TAG,
+                                "Coex priorities are not supported");
+            otCliOutputFormat("%s\n", esp_ot_coex_profile_name(profile));
+        } else {
+            ESP_RETURN_ON_FALSE(aArgsLength == 2, OT_ERROR_INVALID_ARGS, OT_EXT_CLI_TAG, "Invalid arguments");
+            return esp_ot_coex_error_to_ot_error(esp_ot_coex_set_profile(esp_ot_coex_profile_parse(aArgs[1])));
+        }
+    } else if (strcmp(aArgs[0], "priority") == 0) {
+        ESP_RETURN_ON_FALSE(aArgsLength == 4, OT_ERROR_INVALID_ARGS, OT_EXT_CLI_TAG, "Invalid arguments");
+        esp_ot_coex_priorities_t priorities = {
+            .idle = esp_ot_coex_priority_parse(aArgs[1]),
+            .txrx = esp_ot_coex_priority_parse(aArgs[2]),
+            .txrx_at = esp_ot_coex_priority_parse(aArgs[3]),
+        };
+        return esp_ot_coex_error_to_ot_error(esp_ot_coex_set_priorities(&priorities));
+    } else if (strcmp(aArgs[0], "measure") == 0) {
+        if (aArgsLength == 1) {
+            coex_print_measurement();
+            return OT_ERROR_NONE;
+        }
+        esp_ot_coex_profile_t profiles[ESP_OT_COEX_MEASURE_MAX_PROFILES];
+        uint8_t count = aArgsLength - 2;
+        otIp6Address destination;
+        ESP_RETURN_ON_FALSE(otIp6AddressFromString(aArgs[1], &destination) == OT_ERROR_NONE, OT_ERROR_INVALID_ARGS,
+                            OT_EXT_CLI_TAG, "Invalid destination address");
+        ESP_RETURN_ON_FALSE(count <= ESP_OT_COEX_MEASURE_MAX_PROFILES, OT_ERROR_INVALID_ARGS, OT_EXT_CLI_TAG,
+                            "Too many coex profiles");
+        for (uint8_t i = 0; i < count; i++) {
+            profiles[i] = esp_ot_coex_profile_parse(aArgs[i + 2]);
+        }
+        return esp_ot_coex_error_to_ot_error(esp_ot_coex_measure_start(&destination, profiles, count));
+    } else {
+        return OT_ERROR_INVALID_ARGS;
+    }
+    return OT_ERROR_NONE;
+}
+
+esp_err_t esp_ot_coex_init(void)
+{
+    ESP_RETURN_ON_FALSE(esp_openthread_get_instance(), ESP_FAIL, OT_EXT_CLI_TAG,
+                        "OpenThread instance is not initialized");
+    s_measure_done = xSemaphoreCreateBinary();
+    ESP_RETURN_ON_FALSE(s_measure_done, ESP_ERR_NO_MEM, OT_EXT_CLI_TAG, "Failed to create coex semaphore");
+    esp_openthread_lock_acquire(portMAX_DELAY);
+    coex_window_snapshot(&s_window);
+    esp_openthread_lock_release();
+    return ESP_OK;
+}
@@ -0,0 +1,506 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_ot_commission_job.h"
+#include "esp_check.h"
+#include "esp_log.h"
+#include "esp_openthread.h"
+#include "esp_ot_cli_extension.h"
+#include "esp_timer.h"
+#include <ctype.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include "openthread/cli.h"
+#include "openthread/commissioner.h"
+
+#define JOB_JOINERS_GROW_STEP 16
+
+typedef struct {
+    esp_ot_commission_joiner_t *joiners;
+    uint16_t capacity;
+    uint16_t count;
+    esp_ot_commission_job_state_t state;
+    uint32_t timeout;
+    uint8_t max_retries;
+    bool started_commissioner;
+    int64_t start_us;
+    int64_t end_us;
+    uint32_t retries;
+} commission_job_t;
+
+static commission_job_t s_job;
+
+const char *esp_ot_commission_job_state_to_string(esp_ot_commission_job_state_t state)
+{
+    switch (state) {
+    case ESP_OT_COMMISSION_JOB_IDLE:
+        return "idle";
+    case ESP_OT_COMMISSION_JOB_WAITING:
+        return "waiting";
+    case ESP_OT_COMMISSION_JOB_RUNNING:
+        return "running";
+    case ESP_OT_COMMISSION_JOB_DONE:
+        return "done";
+    default:
+        return "unknown";
+    }
+}
+
+const char *esp_ot_commission_joiner_state_to_string(esp_ot_commission_joiner_state_t state)
+{
+    switch (state) {
+    case ESP_OT_COMMISSION_JOINER_PENDING:
+        return "pending";
+    case ESP_OT_COMMISSION_JOINER_ADDED:
+        return "added";
+    case ESP_OT_COMMISSION_JOINER_JOINED:
+        return "joined";
+    case ESP_OT_COMMISSION_JOINER_FAILED:
+        return "failed";
+    default:
+        return "unknown";
+    }
+}
+
+static bool parse_eui64(const char *str, otExtAddress *eui64)
+{
+    if (strlen(str) != 2 * OT_EXT_ADDRESS_SIZE) {
+        return false;
+    }
+    for (int i = 0; i < OT_EXT_ADDRESS_SIZE; i++) {
+        char byte[3] = {str[2 * i], str[2 * i + 1], '\0'};
+        char *end = NULL;
+        if (!isxdigit((unsigned char)byte[0]) || !isxdigit((unsigned char)byte[1])) {
+            return false;
+        }
+        eui64->m8[i] = (uint8_t)strtoul(byte, &end, 16);
+    }
+    return true;
+}
+
+static bool parse_discerner(const char *str, otJoinerDiscerner *discerner)
+{
+    char *end = NULL;
+    unsigned long long value = strtoull(str, &end, 0);
+    if (end == str || *end != '/') {
+        return false;
+    }
+    const char *length_str = end + 1;
+    unsigned long length = strtoul(length_str, &end, 10);
+    if (end == length_str || *end != '\0' || length == 0 || length > OT_JOINER_MAX_DISCERNER_LENGTH) {
+        return false;
+    }
+    if (length < 64 && (value >> length) != 0) {
+        return false;
+    }
+    discerner->mValue = value;
+    discerner->mLength = (uint8_t)length;
+    return true;
+}
+
+static bool is_valid_pskd(const char *pskd)
+{
+    size_t len = strlen(pskd);
+    if (len < OT_JOINER_MIN_PSKD_LENGTH || len > OT_JOINER_MAX_PSKD_LENGTH) {
+        return false;
+    }
+    for (size_t i = 0; i < len; i++) {
+        char c = pskd[i];
+        if (!isdigit((unsigned char)c) && !isupper((unsigned char)c)) {
+            return false;
+        }
+        if (c == 'I' || c == 'O' || c == 'Q' || c == 'Z') {
+            return false;
+        }
+    }
+    return true;
+}
+
+static uint32_t job_elapsed_ms(void)
+{
+    if (s_job.start_us == 0) {
+        return 0;
+    }
+    int64_t end_us = s_job.end_us ? s_job.end_us : esp_timer_get_time();
+    return (uint32_t)((end_us - s_job.start_us) / 1000);
+}
+
+static otError job_commissioner_add(const esp_ot_commission_joiner_t *joiner)
+{
+    otInstance *instance = esp_openthread_get_instance();
+    if (joiner->type == OT_JOINER_INFO_TYPE_DISCERNER) {
+        return otCommissionerAddJoinerWithDiscerner(instance, &joiner->discerner, joiner->pskd, s_job.timeout);
+    }
+    return otCommissionerAddJoiner(instance, &joiner->eui64, joiner->pskd, s_job.timeout);
+}
+
+static void job_commissioner_remove(const esp_ot_commission_joiner_t *joiner)
+{
+    otInstance *instance = esp_openthread_get_instance();
+    if (joiner->type == OT_JOINER_INFO_TYPE_DISCERNER) {
+        otCommissionerRemoveJoinerWithDiscerner(instance, &joiner->discerner);
+    } else {
+        otCommissionerRemoveJoiner(instance, &joiner->eui64);
+    }
+}
+
+static void job_check_done(void)
+{
+    for (uint16_t i = 0; i < s_job.count; i++) {
+        if (s_job.joiners[i].state == ESP_OT_COMMISSION_JOINER_PENDING ||
+            s_job.joiners[i].state == ESP_OT_COMMISSION_JOINER_ADDED) {
+            return;
+        }
+    }
+    s_job.state = ESP_OT_COMMISSION_JOB_DONE;
+    s_job.end_us = esp_timer_get_time();
+    ESP_LOGI(OT_EXT_CLI_TAG, "Commission job done in %" PRIu32 " ms", job_elapsed_ms());
+}
+
+/* Add the pending joiners until the joiner table of the commissioner is full, the remaining ones are added when the
+ * entries of the finished joiners are removed. */
+static void job_fill(void)
+{
+    if (s_job.state != ESP_OT_COMMISSION_JOB_RUNNING) {
+        return;
+    }
+    for (uint16_t i = 0; i < s_job.count; i++) {
+        esp_ot_commission_joiner_t *joiner = &s_job.joiners[i];
+        if (joiner->state != ESP_OT_COMMISSION_JOINER_PENDING) {
+            continue;
+        }
+        otError error = job_commissioner_add(joiner);
+        if (error == OT_ERROR_NO_BUFS) {
+            break;
+        } else if (error != OT_ERROR_NONE) {
+            ESP_LOGW(OT_EXT_CLI_TAG, "Failed to add joiner %u: %s", i, otThreadErrorToString(error));
+            joiner->state = ESP_OT_COMMISSION_JOINER_FAILED;
+        } else {
+            joiner->state = ESP_OT_COMMISSION_JOINER_ADDED;
+        }
+    }
+    job_check_done();
+}
+
+static esp_ot_commission_joiner_t *job_find_joiner(const otJoinerInfo *info)
+{
+    if (info == NULL || info->mType == OT_JOINER_INFO_TYPE_ANY) {
+        return NULL;
+    }
+    for (uint16_t i = 0; i < s_job.count; i++) {
+        esp_ot_commission_joiner_t *joiner = &s_job.joiners[i];
+        if (joiner->type != info->mType) {
+            continue;
+        }
+        if (joiner->type == OT_JOINER_INFO_TYPE_EUI64 &&
+            memcmp(&joiner->eui64, &info->mSharedId.mEui64, sizeof(joiner->eui64)) == 0) {
+            return joiner;
+        }
+        if (joiner->type == OT_JOINER_INFO_TYPE_DISCERNER &&
+            joiner->discerner.mLength == info->mSharedId.mDiscerner.mLength &&
+            joiner->discerner.mValue == info->mSharedId.mDiscerner.mValue) {
+            return joiner;
+        }
+    }
+    return NULL;
+}
+
+void esp_ot_commission_job_handle_state(otCommissionerState state, void *context)
+{
+    (void)context;
+    if (state == OT_COMMISSIONER_STATE_ACTIVE && s_job.state == ESP_OT_COMMISSION_JOB_WAITING) {
+        s_job.state = ESP_OT_COMMISSION_JOB_RUNNING;
+        job_fill();
+    } else if (state == OT_COMMISSIONER_STATE_DISABLED && s_job.state == ESP_OT_COMMISSION_JOB_RUNNING) {
+        ESP_LOGW(OT_EXT_CLI_TAG, "Commissioner is disabled, the commission job is suspended");
+        for (uint16_t i = 0; i < s_job.count; i++) {
+            if (s_job.joiners[i].state == ESP_OT_COMMISSION_JOINER_ADDED) {
+                s_job.joiners[i].state = ESP_OT_COMMISSION_JOINER_PENDING;
+            }
+        }
+        s_job.state = ESP_OT_COMMISSION_JOB_WAITING;
+        s_job.started_commissioner = false;
+    }
+}
+
+void esp_ot_commission_job_handle_joiner_event(otCommissionerJoinerEvent event, const otJoinerInfo *info,
+                                               const otExtAddress *joiner_id, void *context)
+{
+    (void)joiner_id;
+    (void)context;
+    esp_ot_commission_joiner_t *joiner = job_find_joiner(info);
+    if (joiner == NULL || s_job.state != ESP_OT_COMMISSION_JOB_RUNNING) {
+        return;
+    }
+
+    switch (event) {
+    case OT_COMMISSIONER_JOINER_START:
+        joiner->sessions++;
+        break;
+    case OT_COMMISSIONER_JOINER_FINALIZE:
+        if (joiner->state == ESP_OT_COMMISSION_JOINER_ADDED) {
+            joiner->state = ESP_OT_COMMISSION_JOINER_JOINED;
+            joiner->joined_ms = job_elapsed_ms();
+        }
+        break;
+    case OT_COMMISSIONER_JOINER_REMOVED:
+        /* The commissioner removes the entry shortly after the joiner is finalized, or when the entry expires. */
+        if (joiner->state == ESP_OT_COMMISSION_JOINER_ADDED) {
+            if (joiner->retries < s_job.max_retries) {
+                joiner->retries++;
+                s_job.retries++;
+                joiner->state = ESP_OT_COMMISSION_JOINER_PENDING;
+            } else {
+                joiner->state = ESP_OT_COMMISSION_JOINER_FAILED;
+            }
+        }
+        job_fill();
+        break;
+    default:
+        break;
+    }
+}
+
+esp_err_t esp_ot_commission_job_add(const char *id, const char *pskd)
+{
+    esp_ot_commission_joiner_t joiner;
+
+    ESP_RETURN_ON_FALSE(id && pskd, ESP_ERR_INVALID_ARG, OT_EXT_CLI_TAG, "Invalid joiner");
+    ESP_RETURN_ON_FALSE(s_job.state == ESP_OT_COMMISSION_JOB_IDLE, ESP_ERR_INVALID_STATE, OT_EXT_CLI_TAG,
+                        "The commission job is already started");
+    memset(&joiner, 0, sizeof(joiner));
+    if (strchr(id, '/')) {
+        ESP_RETURN_ON_FALSE(parse_discerner(id, &joiner.discerner), ESP_ERR_INVALID_ARG, OT_EXT_CLI_TAG,
+                            "Invalid discerner: %s", id);
+        joiner.type = OT_JOINER_INFO_TYPE_DISCERNER;
+    } else {
+        ESP_RETURN_ON_FALSE(parse_eui64(id, &joiner.eui64), ESP_ERR_INVALID_ARG, OT_EXT_CLI_TAG, "Invalid EUI-64: %s",
+                            id);
+        joiner.type = OT_JOINER_INFO_TYPE_EUI64;
+    }
+    ESP_RETURN_ON_FALSE(is_valid_pskd(pskd), ESP_ERR_INVALID_ARG, OT_EXT_CLI_TAG, "Invalid PSKd: %s", pskd);
+    strcpy(joiner.pskd, pskd);
+    joiner.state = ESP_OT_COMMISSION_JOINER_PENDING;
+
+    if (s_job.count == s_job.capacity) {
+        ESP_RETURN_ON_FALSE(s_job.capacity < CONFIG_OPENTHREAD_COMMISSION_JOB_MAX_JOINERS, ESP_ERR_NO_MEM,
+                            OT_EXT_CLI_TAG, "Too many joiners");
+        uint16_t capacity = s_job.capacity + JOB_JOINERS_GROW_STEP;
+        if (capacity > CONFIG_OPENTHREAD_COMMISSION_JOB_MAX_JOINERS) {
+            capacity = CONFIG_OPENTHREAD_COMMISSION_JOB_MAX_JOINERS;
+        }
+        esp_ot_commission_joiner_t *joiners = realloc(s_job.joiners, capacity * sizeof(*joiners));
+        ESP_RETURN_ON_FALSE(joiners, ESP_ERR_NO_MEM, OT_EXT_CLI_TAG, "Failed to allocate joiners");
+        s_job.joiners = joiners;
+        s_job.capacity = capacity;
+    }
+    s_job.joiners[s_job.count++] = joiner;
+    return ESP_OK;
+}
+
+esp_err_t esp_ot_commission_job_add_csv(char *csv, uint16_t *added)
+{
+    char *save_line = NULL;
+    uint16_t count = 0;
+    esp_err_t ret = ESP_OK;
+
+    for (char *line = strtok_r(csv, "\r\n", &save_line); line; line = strtok_r(NULL, "\r\n", &save_line)) {
+        char *save_field = NULL;
+        while (isspace((unsigned char)*line)) {
+            line++;
+        }
+        if (*line == '\0' || *line == '#') {
+            continue;
+        }
+        char *id = strtok_r(line, ", \t", &save_field);
+        char *pskd = strtok_r(NULL, ", \t", &save_field);
+        ESP_GOTO_ON_FALSE(id && pskd, ESP_ERR_INVALID_ARG, exit, OT_EXT_CLI_TAG, "Invalid line: %s", line);
+        ESP_GOTO_ON_ERROR(esp_ot_commission_job_add(id, pskd), exit, OT_EXT_CLI_TAG, "Failed to add joiner %s", id);
+        count++;
+    }
+exit:
+    if (added) {
+        *added = count;
+    }
+    return ret;
+}
+
+esp_err_t esp_ot_commission_job_start(uint32_t timeout, uint8_t retries)
+{
+    otInstance *instance = esp_openthread_get_instance();
+
+    ESP_RETURN_ON_FALSE(s_job.state == ESP_OT_COMMISSION_JOB_IDLE, ESP_ERR_INVALID_STATE, OT_EXT_CLI_TAG,
+                        "The commission job is already started");
+    ESP_RETURN_ON_FALSE(s_job.count > 0, ESP_ERR_INVALID_STATE, OT_EXT_CLI_TAG, "No joiner is added");
+
+    s_job.timeout = timeout;
+    s_job.max_retries = retries;
+    s_job.retries = 0;
+    s_job.start_us = esp_timer_get_time();
+    s_job.end_us = 0;
+    s_job.state = ESP_OT_COMMISSION_JOB_WAITING;
+
+    switch (otCommissionerGetState(instance)) {
+    case OT_COMMISSIONER_STATE_DISABLED:
+        if (otCommissionerStart(instance, esp_ot_commission_job_handle_state, esp_ot_commission_job_handle_joiner_event,
+                                NULL) != OT_ERROR_NONE) {
+            s_job.state = ESP_OT_COMMISSION_JOB_IDLE;
+            ESP_LOGE(OT_EXT_CLI_TAG, "Failed to start commissioner");
+            return ESP_FAIL;
+        }
+        s_job.started_commissioner = true;
+        break;
+    case OT_COMMISSIONER_STATE_ACTIVE:
+        esp_ot_commission_job_handle_state(OT_COMMISSIONER_STATE_ACTIVE, NULL);
+        break;
+    default:
+        break;
+    }
+    return ESP_OK;
+}
+
+void esp_ot_commission_job_clear(void)
+{
+    bool running = s_job.state == ESP_OT_COMMISSION_JOB_RUNNING;
+
+    /* Removing the joiners signals the removed events, which must not add the pending joiners again. */
+    s_job.state = ESP_OT_COMMISSION_JOB_IDLE;
+    if (running) {
+        for (uint16_t i = 0; i < s_job.count; i++) {
+            if (s_job.joiners[i].state == ESP_OT_COMMISSION_JOINER_ADDED) {
+                job_commissioner_remove(&s_job.joiners[i]);
+            }
+        }
+    }
+    if (s_job.started_commissioner) {
+        otCommissionerStop(esp_openthread_get_instance());
+    }
+    free(s_job.joiners);
+    memset(&s_job, 0, sizeof(s_job));
+}
+
+void esp_ot_commission_job_get_status(esp_ot_commission_job_status_t *status)
+{
+    memset(status, 0, sizeof(*status));
+    status->state = s_job.state;
+    status->total = s_job.count;
+    for (uint16_t i = 0; i < s_job.count; i++) {
+        switch (s_job.joiners[i].state) {
+        case ESP_OT_COMMISSION_JOINER_PENDING:
+            status->pending++;
+            break;
+        case ESP_OT_COMMISSION_JOINER_ADDED:
+            status->added++;
+            break;
+        case ESP_OT_COMMISSION_JOINER_JOINED:
+            status->joined++;
+            break;
+        case ESP_OT_COMMISSION_JOINER_FAILED:
+            status->failed++;
+            break;
+        default:
+            break;
+        }
+    }
+    status->retries = s_job.retries;
+    status->elapsed_ms = job_elapsed_ms();
+    if (status->elapsed_ms > 0) {
+        status->joins_per_min_x10 = (uint32_t)((uint64_t)status->joined * 600000 / status->elapsed_ms);
+    }
+}
+
+const esp_ot_commission_joiner_t *esp_ot_commission_job_get_joiner(uint16_t index)
+{
+    return index < s_job.count ? &s_job.joiners[index] : NULL;
+}
+
+static void print_joiner_id(const esp_ot_commission_joiner_t *joiner)
+{
+    if (joiner->type == OT_JOINER_INFO_TYPE_DISCERNER) {
+        otCliOutputFormat("0x%llx/%u", (unsigned long long)joiner->discerner.mValue, joiner->discerner.mLength);
+    } else {
+        for (int i = 0; i < OT_EXT_ADDRESS_SIZE; i++) {
+            otCliOutputFormat("%02x", joiner->eui64.m8[i]);
+        }
+    }
+}
+
+static void print_status(void)
+{
+    esp_ot_commission_job_status_t status;
+    esp_ot_commission_job_get_status(&status);
+    otCliOutputFormat("state: %s\n", esp_ot_commission_job_state_to_string(status.state));
+    otCliOutputFormat("joiners: %u, pending: %u, added: %u, joined: %u, failed: %u\n", status.total, status.pending,
+                      status.added, status.joined, status.failed);
+    otCliOutputFormat("retries: %" PRIu32 "\n", status.retries);
+    otCliOutputFormat("elapsed: %" PRIu32 " ms\n", status.elapsed_ms);
+    otCliOutputFormat("throughput: %" PRIu32 ".%" PRIu32 " joins/min\n", status.joins_per_min_x10 / 10,
+                      status.joins_per_min_x10 % 10);
+}
+
+static void print_joiners(void)
+{
+    otCliOutputFormat("| # | Joiner | State | Sessions | Retries | Joined (ms) |\n");
+    for (uint16_t i = 0; i < s_job.count; i++) {
+        const esp_ot_commission_joiner_t *joiner = &s_job.joiners[i];
+        otCliOutputFormat("| %u | ", i);
+        print_joiner_id(joiner);
+        otCliOutputFormat(" | %s | %u | %u | %" PRIu32 " |\n", esp_ot_commission_joiner_state_to_string(joiner->state),
+                          joiner->sessions, joiner->retries, joiner->joined_ms);
+    }
+}
+
+otError esp_ot_process_commission_job(void *aContext, uint8_t aArgsLength, char *aArgs[])
+{
+    (void)(aContext);
+    if (aArgsLength == 0) {
+        otCliOutputFormat("---bulkjoin parameter---\n");
+        otCliOutputFormat("add <eui64|discerner> <pskd>             :     add a joiner, the discerner is in the "
+                          "format of <value>/<bit length>\n");
+        otCliOutputFormat("start [timeout] [retries]                :     start commissioning the added joiners, "
+                          "timeout in seconds of each joiner entry, default %d %d\n",
+                          ESP_OT_COMMISSION_JOB_DEFAULT_TIMEOUT, ESP_OT_COMMISSION_JOB_DEFAULT_RETRIES);
+        otCliOutputFormat("status                                   :     print the progress and the throughput\n");
+        otCliOutputFormat("list                                     :     print the state of each joiner\n");
+        otCliOutputFormat("clear                                    :     stop the job and remove all the joiners\n");
+        otCliOutputFormat("---example---\n");
+        otCliOutputFormat("add a joiner by EUI-64                   :     bulkjoin add 18b4300000000001 J01NME\n");
+        otCliOutputFormat("add a joiner by discerner                :     bulkjoin add 0xabc/12 J01NME\n");
+        otCliOutputFormat("start with 60s timeout and 3 retries     :     bulkjoin start 60 3\n");
+    } else if (strcmp(aArgs[0], "add") == 0) {
+        ESP_RETURN_ON_FALSE(aArgsLength == 3, OT_ERROR_INVALID_ARGS, OT_EXT_CLI_TAG, "Invalid arguments");
+        esp_err_t err = esp_ot_commission_job_add(aArgs[1], aArgs[2]);
+        if (err == ESP_ERR_INVALID_STATE) {
+            return OT_ERROR_INVALID_STATE;
+        } else if (err == ESP_ERR_NO_MEM) {
+            return OT_ERROR_NO_BUFS;
+        } else if (err != ESP_OK) {
+            return OT_ERROR_INVALID_ARGS;
+        }
+    } else if (strcmp(aArgs[0], "start") == 0) {
+        uint32_t timeout = aArgsLength > 1 ? strtoul(aArgs[1], NULL, 10) : ESP_OT_COMMISSION_JOB_DEFAULT_TIMEOUT;
+        uint32_t retries = aArgsLength > 2 ? strtoul(aArgs[2], NULL, 10) : ESP_OT_COMMISSION_JOB_DEFAULT_RETRIES;
+        ESP_RETURN_ON_FALSE(timeout > 0 && retries <= UINT8_MAX, OT_ERROR_INVALID_ARGS, OT_EXT_CLI_TAG,
+                            "Invalid arguments");
+        esp_err_t err = esp_ot_commission_job_start(timeout, (uint8_t)retries);
+        if (err == ESP_ERR_INVALID_STATE) {
+            return OT_ERROR_INVALID_STATE;
+        } else if (err != ESP_OK) {
+            return OT_ERROR_FAILED;
+        }
+    } else if (strcmp(aArgs[0], "status") == 0) {
+        print_status();
+    } else if (strcmp(aArgs[0], "list") == 0) {
+        print_joiners();
+    } else if (strcmp(aArgs[0], "clear") == 0) {
+        esp_ot_commission_job_clear();
+    } else {
+        otCliOutputFormat("invalid commands\n");
+        return OT_ERROR_INVALID_COMMAND;
+    }
+    return OT_ERROR_NONE;
+}
@@ -0,0 +1,352 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_ot_cpu_prof.h"
+#include "esp_check.h"
+#include "esp_log.h"
+#include "esp_openthread_lock.h"
+#include "esp_ot_cli_extension.h"
+#include "esp_timer.h"
+#include "sdkconfig.h"
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "openthread/cli.h"
+
+#define CPUPROF_TASKS_MAX_NUM 48
+#define CPUPROF_TASK_STACK_SIZE 3072
+#define CPUPROF_TASK_PRIORITY 5
+#define CPUPROF_DEFAULT_WINDOW_MS 5000
+#define CPUPROF_PROBE_PERIOD_MS 20
+#define CPUPROF_HIST_BUCKETS_NUM 8
+
+/* Upper bounds in microseconds of the latency histogram buckets, the last bucket collects the rest */
+static const uint32_t s_hist_bounds_us[CPUPROF_HIST_BUCKETS_NUM - 1] = {50, 100, 500, 1000, 5000, 10000, 50000};
+
+typedef struct cpuprof_histogram {
+    uint32_t buckets[CPUPROF_HIST_BUCKETS_NUM];
+    uint32_t count;
+    uint64_t sum_us;
+    uint32_t max_us;
+} cpuprof_histogram_t;
+
+typedef struct cpuprof_task {
+    char name[configMAX_TASK_NAME_LEN];
+    uint32_t cpu_permille;
+    uint32_t stack_hwm;
+    UBaseType_t priority;
+    eTaskState state;
+} cpuprof_task_t;
+
+typedef struct cpuprof_mainloop {
+    cpuprof_histogram_t iteration;
+    cpuprof_histogram_t lock_wait;
+} cpuprof_mainloop_t;
+
+typedef struct cpuprof_report {
+    uint32_t window_ms;
+    uint16_t tasks_num;
+    cpuprof_task_t tasks[CPUPROF_TASKS_MAX_NUM];
+#if CONFIG_OPENTHREAD_CLI_CPU_PROF_LOCK_PROBE
+    cpuprof_histogram_t lock_wait;
+#endif
+    cpuprof_histogram_t ot_busy;
+    cpuprof_mainloop_t mainloop;
+} cpuprof_report_t;
+
+static TaskHandle_t s_cpuprof_task = NULL;
+static TaskHandle_t s_ot_task = NULL;
+static uint32_t s_cpuprof_window_ms = CPUPROF_DEFAULT_WINDOW_MS;
+static cpuprof_report_t s_cpuprof_report;
+static bool s_cpuprof_report_valid = false;
+static portMUX_TYPE s_cpuprof_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static cpuprof_mainloop_t s_mainloop;
+static bool s_mainloop_probe = false;
+static int s_mainloop_lock_depth = 0;
+static int64_t s_mainloop_iteration_start = 0;
+
+static void histogram_add(cpuprof_histogram_t *hist, uint32_t value_us)
+{
+    int bucket = 0;
+    while (bucket < CPUPROF_HIST_BUCKETS_NUM - 1 && value_us >= s_hist_bounds_us[bucket]) {
+        bucket++;
+    }
+    hist->buckets[bucket]++;
+    hist->count++;
+    hist->sum_us += value_us;
+    if (value_us > hist->max_us) {
+        hist->max_us = value_us;
+    }
+}
+
+bool __real_esp_openthread_lock_acquire(TickType_t block_ticks);
+void __real_esp_openthread_lock_release(void);
+
+/*
+ * The OpenThread lock functions are wrapped by the linker, see CMakeLists.txt. The mainloop releases the lock before
+ * it waits in select() and takes it again once woken, so for the OpenThread task the lock depth going from 0 to 1
+ * starts a mainloop iteration and going back to 0 ends it. The nested calls of the CLI commands and of the callbacks
+ * only change the depth. The time to take the lock at the start of an iteration is the wait for the other tasks
+ * holding it, measured without taking the lock from another task.
+ */
+bool __wrap_esp_openthread_lock_acquire(TickType_t block_ticks)
+{
+    if (!s_mainloop_probe || xTaskGetCurrentTaskHandle() != s_ot_task || s_mainloop_lock_depth++ > 0) {
+        return __real_esp_openthread_lock_acquire(block_ticks);
+    }
+
+    int64_t request = esp_timer_get_time();
+    bool acquired = __real_esp_openthread_lock_acquire(block_ticks);
+    if (!acquired) {
+        s_mainloop_lock_depth--;
+        return false;
+    }
+    s_mainloop_iteration_start = esp_timer_get_time();
+    portENTER_CRITICAL(&s_cpuprof_lock);
+    histogram_add(&s_mainloop.lock_wait, (uint32_t)(s_mainloop_iteration_start - request));
+    portEXIT_CRITICAL(&s_cpuprof_lock);
+    return true;
+}
+
+void __wrap_esp_openthread_lock_release(void)
+{
+    if (s_mainloop_probe && xTaskGetCurrentTaskHandle() == s_ot_task && s_mainloop_lock_depth > 0 &&
+        --s_mainloop_lock_depth == 0) {
+        uint32_t busy = (uint32_t)(esp_timer_get_time() - s_mainloop_iteration_start);
+        portENTER_CRITICAL(&s_cpuprof_lock);
+        histogram_add(&s_mainloop.iteration, busy);
+        portEXIT_CRITICAL(&s_cpuprof_lock);
+    }
+    __real_esp_openthread_lock_release();
+}
+
+static void build_task_report(cpuprof_report_t *report, const TaskStatus_t *begin, UBaseType_t begin_num,
+                              uint32_t begin_run_time, const TaskStatus_t *end, UBaseType_t end_num,
+                              uint32_t end_run_time)
+{
+    // The total run time counts the elapsed time of one core, while tasks run on all of them.
+    uint64_t elapsed = (uint64_t)(end_run_time - begin_run_time) * portNUM_PROCESSORS;
+
+    report->tasks_num = 0;
+    for (UBaseType_t i = 0; i < end_num && report->tasks_num < CPUPROF_TASKS_MAX_NUM; i++) {
+        uint32_t run_time = end[i].ulRunTimeCounter;
+        for (UBaseType_t j = 0; j < begin_num; j++) {
+            if (begin[j].xTaskNumber == end[i].xTaskNumber) {
+                run_time -= begin[j].ulRunTimeCounter;
+                break;
+            }
+        }
+        cpuprof_task_t *task = &report->tasks[report->tasks_num++];
+        strlcpy(task->name, end[i].pcTaskName, sizeof(task->name));
+        task->cpu_permille = elapsed ? (uint32_t)((uint64_t)run_time * 1000 / elapsed) : 0;
+        task->stack_hwm = end[i].usStackHighWaterMark;
+        task->priority = end[i].uxCurrentPriority;
+        task->state = end[i].eCurrentState;
+    }
+}
+
+static void cpuprof_task_worker(void *aContext)
+{
+    // Static buffers only, the worker may be deleted at any blocking point by "cpuprof stop".
+    static TaskStatus_t s_begin[CPUPROF_TASKS_MAX_NUM];
+    static TaskStatus_t s_end[CPUPROF_TASKS_MAX_NUM];
+    static cpuprof_report_t s_report;
+
+    while (true) {
+        uint32_t begin_run_time = 0;
+        uint32_t end_run_time = 0;
+        uint32_t window_ms = s_cpuprof_window_ms;
+        UBaseType_t begin_num = uxTaskGetSystemState(s_begin, CPUPROF_TASKS_MAX_NUM, &begin_run_time);
+        uint32_t ot_run_time = ulTaskGetRunTimeCounter(s_ot_task);
+        TickType_t start = xTaskGetTickCount();
+
+        memset(&s_report, 0, sizeof(s_report));
+        s_report.window_ms = window_ms;
+        portENTER_CRITICAL(&s_cpuprof_lock);
+        memset(&s_mainloop, 0, sizeof(s_mainloop));
+        portEXIT_CRITICAL(&s_cpuprof_lock);
+        while (xTaskGetTickCount() - start < pdMS_TO_TICKS(window_ms)) {
+            vTaskDelay(pdMS_TO_TICKS(CPUPROF_PROBE_PERIOD_MS));
+#if CONFIG_OPENTHREAD_CLI_CPU_PROF_LOCK_PROBE
+            // The OpenThread lock is held by the mainloop while it processes, the time to take it is the latency
+            // seen by any work handed over to the OpenThread task.
+            int64_t request = esp_timer_get_time();
+            esp_openthread_lock_acquire(portMAX_DELAY);
+            int64_t acquired = esp_timer_get_time();
+            esp_openthread_lock_release();
+            histogram_add(&s_report.lock_wait, (uint32_t)(acquired - request));
+#endif
+
+            uint32_t run_time = ulTaskGetRunTimeCounter(s_ot_task);
+            histogram_add(&s_report.ot_busy, run_time - ot_run_time);
+            ot_run_time = run_time;
+        }
+
+        UBaseType_t end_num = uxTaskGetSystemState(s_end, CPUPROF_TASKS_MAX_NUM, &end_run_time);
+        if (begin_num == 0 || end_num == 0) {
+            ESP_LOGW(OT_EXT_CLI_TAG, "More than %d tasks, skip cpuprof window", CPUPROF_TASKS_MAX_NUM);
+            continue;
+        }
+        build_task_report(&s_report, s_begin, begin_num, begin_run_time, s_end, end_num, end_run_time);
+        portENTER_CRITICAL(&s_cpuprof_lock);
+        memcpy(&s_report.mainloop, &s_mainloop, sizeof(s_mainloop));
+        memcpy(&s_cpuprof_report, &s_report, sizeof(s_report));
+        s_cpuprof_report_valid = true;
+        portEXIT_CRITICAL(&s_cpuprof_lock);
+    }
+}
+
+static const char *task_state_string(eTaskState state)
+{
+    switch (state) {
+    case eRunning:
+        return "running";
+    case eReady:
+        return "ready";
+    case eBlocked:
+        return "blocked";
+    case eSuspended:
+        return "suspended";
+    case eDeleted:
+        return "deleted";
+    default:
+        return "invalid";
+    }
+}
+
+static void print_histogram_table(const char *name, const cpuprof_histogram_t *hist)
+{
+    otCliOutputFormat("%s: count %lu, avg %lu us, max %lu us\n", name, (unsigned long)hist->count,
+                      hist->count ? (unsigned long)(hist->sum_us / hist->count) : 0UL, (unsigned long)hist->max_us);
+    for (int i = 0; i < CPUPROF_HIST_BUCKETS_NUM; i++) {
+        if (i < CPUPROF_HIST_BUCKETS_NUM - 1) {
+            otCliOutputFormat("    < %-6lu us : %lu\n", (unsigned long)s_hist_bounds_us[i],
+                              (unsigned long)hist->buckets[i]);
+        } else {
+            otCliOutputFormat("    >= %-5lu us : %lu\n", (unsigned long)s_hist_bounds_us[i - 1],
+                              (unsigned long)hist->buckets[i]);
+        }
+    }
+}
+
+static void print_histogram_json(const char *name, const cpuprof_histogram_t *hist)
+{
+    otCliOutputFormat("\"%s\":{\"count\":%lu,\"avg_us\":%lu,\"max_us\":%lu,\"buckets\":[", name,
+                      (unsigned long)hist->count, hist->count ? (unsigned long)(hist->sum_us / hist->count) : 0UL,
+                      (unsigned long)hist->max_us);
+    for (int i = 0; i < CPUPROF_HIST_BUCKETS_NUM; i++) {
+        otCliOutputFormat("%s{\"le_us\":%ld,\"count\":%lu}", i ? "," : "",
+                          i < CPUPROF_HIST_BUCKETS_NUM - 1 ? (long)s_hist_bounds_us[i] : -1L,
+                          (unsigned long)hist->buckets[i]);
+    }
+    otCliOutputFormat("]}");
+}
+
+static otError print_report(bool json)
+{
+    static cpuprof_report_t s_report;
+
+    portENTER_CRITICAL(&s_cpuprof_lock);
+    bool valid = s_cpuprof_report_valid;
+    memcpy(&s_report, &s_cpuprof_report, sizeof(s_report));
+    portEXIT_CRITICAL(&s_cpuprof_lock);
+    ESP_RETURN_ON_FALSE(valid, OT_ERROR_INVALID_STATE, OT_EXT_CLI_TAG, "No completed cpuprof window");
+    // Each mainloop iteration ends with one wait in select(), the number of times the OpenThread task blocks.
+    uint64_t wakeups_per_sec = (uint64_t)s_report.mainloop.iteration.count * 10000 / s_report.window_ms;
+
+    if (json) {
+        otCliOutputFormat("{\"window_ms\":%lu,\"tasks\":[", (unsigned long)s_report.window_ms);
+        for (uint16_t i = 0; i < s_report.tasks_num; i++) {
+            const cpuprof_task_t *task = &s_report.tasks[i];
+            otCliOutputFormat("%s{\"name\":\"%s\",\"cpu_permille\":%lu,\"stack_hwm\":%lu,\"priority\":%u,"
+                              "\"state\":\"%s\"}",
+                              i ? "," : "", task->name, (unsigned long)task->cpu_permille,
+                              (unsigned long)task->stack_hwm, (unsigned int)task->priority,
+                              task_state_string(task->state));
+        }
+        otCliOutputFormat("],");
+#if CONFIG_OPENTHREAD_CLI_CPU_PROF_LOCK_PROBE
+        print_histogram_json("ot_lock_wait", &s_report.lock_wait);
+        otCliOutputFormat(",");
+#endif
+        print_histogram_json("ot_busy", &s_report.ot_busy);
+        otCliOutputFormat(",\"ot_wakeups_per_sec\":%lu,", (unsigned long)wakeups_per_sec / 10);
+        print_histogram_json("ot_iteration", &s_report.mainloop.iteration);
+        otCliOutputFormat(",");
+        print_histogram_json("ot_mainloop_lock_wait", &s_report.mainloop.lock_wait);
+        otCliOutputFormat("}\n");
+    } else {
+        otCliOutputFormat("window: %lu ms\n", (unsigned long)s_report.window_ms);
+        otCliOutputFormat("| %-16s | %-7s | %-9s | %-4s | %-9s |\n", "Task", "CPU", "Stack HWM", "Prio", "State");
+        otCliOutputFormat("+------------------+---------+-----------+------+-----------+\n");
+        for (uint16_t i = 0; i < s_report.tasks_num; i++) {
+            const cpuprof_task_t *task = &s_report.tasks[i];
+            otCliOutputFormat("| %-16s | %3lu.%lu %% | %9lu | %4u | %-9s |\n", task->name,
+                              (unsigned long)task->cpu_permille / 10, (unsigned long)task->cpu_permille % 10,
+                              (unsigned long)task->stack_hwm, (unsigned int)task->priority,
+                              task_state_string(task->state));
+        }
+#if CONFIG_OPENTHREAD_CLI_CPU_PROF_LOCK_PROBE
+        print_histogram_table("ot lock wait", &s_report.lock_wait);
+#endif
+        print_histogram_table("ot run time per probe", &s_report.ot_busy);
+        otCliOutputFormat("ot wake-ups: %lu.%lu per second\n", (unsigned long)wakeups_per_sec / 10,
+                          (unsigned long)wakeups_per_sec % 10);
+        print_histogram_table("ot run time per mainloop iteration", &s_report.mainloop.iteration);
+        print_histogram_table("ot mainloop lock wait", &s_report.mainloop.lock_wait);
+    }
+    return OT_ERROR_NONE;
+}
+
+otError esp_ot_process_cpu_prof(void *aContext, uint8_t aArgsLength, char *aArgs[])
+{
+    (void)(aContext);
+    if (aArgsLength == 0) {
+        otCliOutputFormat("---cpuprof parameter---\n");
+        otCliOutputFormat("start [window]           :     start profiling, report every [window] ms (5000 by default)"
+                          "\n");
+        otCliOutputFormat("stop                     :     stop profiling\n");
+        otCliOutputFormat("print                    :     print the report of the last completed window\n");
+        otCliOutputFormat("json                     :     print the report of the last completed window in json\n");
+        otCliOutputFormat("---example---\n");
+        otCliOutputFormat("start with 10s window    :     cpuprof start 10000\n");
+        otCliOutputFormat("print the report         :     cpuprof print\n");
+    } else if (strcmp(aArgs[0], "start") == 0) {
+        if (aArgsLength > 1) {
+            long window = strtol(aArgs[1], NULL, 10);
+            ESP_RETURN_ON_FALSE(window >= CPUPROF_PROBE_PERIOD_MS, OT_ERROR_INVALID_ARGS, OT_EXT_CLI_TAG,
+                                "Invalid window");
+            s_cpuprof_window_ms = (uint32_t)window;
+        }
+        if (!s_cpuprof_task) {
+            // CLI commands are processed in the OpenThread task, within a mainloop iteration.
+            s_ot_task = xTaskGetCurrentTaskHandle();
+            s_mainloop_lock_depth = 1;
+            s_mainloop_iteration_start = esp_timer_get_time();
+            s_mainloop_probe = true;
+            if (xTaskCreate(cpuprof_task_worker, "cpuprof", CPUPROF_TASK_STACK_SIZE, NULL, CPUPROF_TASK_PRIORITY,
+                            &s_cpuprof_task) != pdTRUE) {
+                ESP_LOGE(OT_EXT_CLI_TAG, "Failed to create cpuprof task");
+                s_mainloop_probe = false;
+                return OT_ERROR_FAILED;
+            }
+        }
+    } else if (strcmp(aArgs[0], "stop") == 0) {
+        ESP_RETURN_ON_FALSE(s_cpuprof_task, OT_ERROR_INVALID_STATE, OT_EXT_CLI_TAG, "cpuprof is not running");
+        vTaskDelete(s_cpuprof_task);
+        s_cpuprof_task = NULL;
+        s_mainloop_probe = false;
+    } else if (strcmp(aArgs[0], "print") == 0) {
+        return print_report(false);
+    } else if (strcmp(aArgs[0], "json") == 0) {
+        return print_report(true);
+    } else {
+        return OT_ERROR_INVALID_ARGS;
+    }
+    return OT_ERROR_NONE;
+}
@@ -14,6 +14,9 @@
 #include "esp_openthread_dns64.h"
 #include "esp_openthread_netif_glue.h"
 #include "esp_ot_cli_extension.h"
+#include "esp_ot_dns_cache.h"
+#include "esp_ot_dns_pool.h"
+#include "esp_timer.h"
 #include "lwip/dns.h"
 #include "openthread/cli.h"
 #include "openthread/netdata.h"
@@ -49,6 +52,35 @@ static esp_netif_dns_type_t parse_dns_type(const char *type)
     return ESP_NETIF_DNS_MAX;
 }
 
+#if CONFIG_OPENTHREAD_DNS_CACHE
+static esp_err_t set_local_dns(const ip4_addr_t *dns_server)
+{
+    ESP_RETURN_ON_ERROR(esp_ot_dns_resolver_start(dns_server->addr), OT_EXT_CLI_TAG,
+                        "Failed to start the DNS resolver");
+#if CONFIG_OPENTHREAD_DNS_CACHE_PORT == 53
+    /* The lookups of this node go through the resolver too. */
+    ip6_addr_t loopback_addr = {};
+    ip6_addr_set_loopback(&loopback_addr);
+    ESP_RETURN_ON_ERROR(esp_openthread_set_dnsserver_addr_with_type(loopback_addr, ESP_NETIF_DNS_MAIN),
+                        OT_EXT_CLI_TAG, "Failed to set dns server address");
+    ESP_RETURN_ON_ERROR(esp_event_post(OPENTHREAD_EVENT, OPENTHREAD_EVENT_SET_DNS_SERVER, NULL, 0, 0), OT_EXT_CLI_TAG,
+                        "Failed to post OpenThread set DNS server event");
+#endif
+    return ESP_OK;
+}
+#endif // CONFIG_OPENTHREAD_DNS_CACHE
+
+esp_err_t esp_ot_dns64_set_main_server(uint32_t addr)
+{
+    ip4_addr_t server_addr = {.addr = addr};
+#if CONFIG_OPENTHREAD_DNS_CACHE
+    if (esp_ot_dns_resolver_is_running()) {
+        return esp_ot_dns_resolver_start(addr);
+    }
+#endif
+    return set_dns64(ESP_NETIF_DNS_MAIN, &server_addr);
+}
+
 otError esp_openthread_process_dns64_server(void *aContext, uint8_t aArgsLength, char *aArgs[])
 {
     (void)(aContext);
@@ -58,6 +90,36 @@ otError esp_openthread_process_dns64_server(void *aContext, uint8_t aArgsLength,
         otCliOutputFormat("<dns_server_addr> should be an IPv4 address\n");
         otCliOutputFormat(
             "[dns_type] can be 'main', 'backup', or 'fallback'.If not specified, it defaults to 'backup'\n");
+#if CONFIG_OPENTHREAD_DNS_CACHE
+        otCliOutputFormat("dns64server local <dns_server_addr>\n");
+        otCliOutputFormat("dns64server stats\n");
+        otCliOutputFormat("dns64server flush\n");
+        otCliOutputFormat("'local' serves the DNS queries on port %d from a cache, forwarding the misses to "
+                          "<dns_server_addr> and synthesizing the AAAA records from the A records\n",
+                          CONFIG_OPENTHREAD_DNS_CACHE_PORT);
+#endif
+#if CONFIG_OPENTHREAD_DNS_POOL
+        otCliOutputFormat("dns64server pool [add|remove <dns_server_addr>|decisions|auto]\n");
+        otCliOutputFormat("'pool' probes the servers added and promotes the fastest healthy one to main, a main "
+                          "server set by hand is pinned until 'auto'\n");
+    } else if (strcmp(aArgs[0], "pool") == 0) {
+        return esp_ot_dns_pool_process(aArgsLength - 1, aArgs + 1);
+#endif
+#if CONFIG_OPENTHREAD_DNS_CACHE
+    } else if (strcmp(aArgs[0], "local") == 0) {
+        ip4_addr_t server_addr;
+        ESP_RETURN_ON_FALSE(aArgsLength == 2 && ip4addr_aton(aArgs[1], &server_addr) == 1, OT_ERROR_INVALID_ARGS,
+                            OT_EXT_CLI_TAG, "Invalid DNS server");
+        ESP_RETURN_ON_FALSE(set_local_dns(&server_addr) == ESP_OK, OT_ERROR_FAILED, OT_EXT_CLI_TAG,
+                            "Failed to set local DNS server");
+#if CONFIG_OPENTHREAD_DNS_POOL
+        esp_ot_dns_pool_pin(server_addr.addr, (uint32_t)(esp_timer_get_time() / 1000000));
+#endif
+    } else if (strcmp(aArgs[0], "stats") == 0) {
+        esp_ot_dns_resolver_print_stats();
+    } else if (strcmp(aArgs[0], "flush") == 0) {
+        esp_ot_dns_resolver_flush();
+#endif
     } else {
         ESP_RETURN_ON_FALSE(aArgsLength == 2 || aArgsLength == 1, OT_ERROR_INVALID_ARGS, OT_EXT_CLI_TAG,
                             "Invalid parameters");
@@ -72,6 +134,16 @@ otError esp_openthread_process_dns64_server(void *aContext, uint8_t aArgsLength,
         }
         ESP_RETURN_ON_FALSE(set_dns64(dns_type, &server_addr) == ESP_OK, OT_ERROR_INVALID_ARGS, OT_EXT_CLI_TAG,
                             "Failed to set DNS server");
+#if CONFIG_OPENTHREAD_DNS_CACHE
+        if (dns_type == ESP_NETIF_DNS_MAIN) {
+            esp_ot_dns_resolver_stop();
+        }
+#endif
+#if CONFIG_OPENTHREAD_DNS_POOL
+        if (dns_type == ESP_NETIF_DNS_MAIN) {
+            esp_ot_dns_pool_pin(server_addr.addr, (uint32_t)(esp_timer_get_time() / 1000000));
+        }
+#endif
     }
 
     return OT_ERROR_NONE;
@@ -0,0 +1,504 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_ot_dns_cache.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sdkconfig.h"
+#include "esp_check.h"
+#include "esp_log.h"
+#include "esp_ot_cli_extension.h"
+
+/*
+ * The cache keeps whole responses keyed by the lower case question name and type, in a fixed array of
+ * CONFIG_OPENTHREAD_DNS_CACHE_ENTRIES. A free or expired entry is taken first, then the least recently used one.
+ * The entries are few, so they are searched linearly by a hash of the key.
+ */
+#define DNS_HEADER_SIZE 12
+#define DNS_NAME_MAX 255
+#define DNS_MAX_POINTERS 16
+#define DNS_TYPE_CNAME 5
+#define DNS_TYPE_SOA 6
+#define DNS_TYPE_OPT 41
+#define DNS_CLASS_IN 1
+#define DNS_FLAG_QR 0x8000
+#define DNS_FLAG_TC 0x0200
+#define DNS_FLAG_RD 0x0100
+#define DNS_SOA_MIN_RDLENGTH 22     /* two root names and five 32-bit fields */
+#define DNS_PREFETCH_TTL_DIVISOR 10 /* an entry is prefetched in the last tenth of its TTL */
+
+typedef struct dns_question {
+    uint8_t name[DNS_NAME_MAX]; /* the lower case labels */
+    uint16_t name_len;
+    uint16_t qtype;
+    uint16_t qclass;
+    uint16_t end; /* the offset after the question */
+} dns_question_t;
+
+typedef struct dns_record {
+    uint16_t fixed; /* the offset of the type, after the owner name */
+    uint16_t type;
+    uint32_t ttl;
+    uint16_t rdata;
+    uint16_t rdlength;
+} dns_record_t;
+
+typedef struct dns_cache_entry {
+    uint32_t hash;
+    uint16_t qtype;
+    uint16_t len; /* 0 for a free entry */
+    uint32_t stored_ms;
+    uint32_t ttl_s;
+    uint32_t last_used;
+    uint16_t hits;
+    bool negative;
+    bool prefetching;
+    uint8_t message[CONFIG_OPENTHREAD_DNS_CACHE_MAX_MESSAGE];
+} dns_cache_entry_t;
+
+static dns_cache_entry_t *s_entries = NULL;
+static uint32_t s_tick = 0;
+static uint64_t s_latency_sum_ms = 0;
+static esp_ot_dns_cache_stats_t s_stats;
+
+static uint16_t read16(const uint8_t *data)
+{
+    return (uint16_t)((data[0] << 8) | data[1]);
+}
+
+static uint32_t read32(const uint8_t *data)
+{
+    return ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) | ((uint32_t)data[2] << 8) | data[3];
+}
+
+static void write16(uint8_t *data, uint16_t value)
+{
+    data[0] = value >> 8;
+    data[1] = value & 0xff;
+}
+
+static void write32(uint8_t *data, uint32_t value)
+{
+    write16(data, value >> 16);
+    write16(data + 2, value & 0xffff);
+}
+
+/* Read the name at @param offset as lower case labels into @param name, or only check it if @param name is NULL. Only
+   the pointers before @param pointer_limit are accepted. Return the offset after the name, 0 if it is invalid. */
+static uint16_t dns_name_read(const uint8_t *message, uint16_t len, uint16_t offset, uint16_t pointer_limit,
+                              uint8_t *name, uint16_t *name_len)
+{
+    uint16_t end = 0;
+    uint16_t out = 0;
+    uint8_t pointers = 0;
+
+    while (true) {
+        if (offset >= len) {
+            return 0;
+        }
+        uint8_t label = message[offset];
+        if ((label & 0xc0) == 0xc0) {
+            if (offset + 1 >= len || ++pointers > DNS_MAX_POINTERS) {
+                return 0;
+            }
+            end = end ? end : offset + 2;
+            offset = ((label & 0x3f) << 8) | message[offset + 1];
+            if (offset >= pointer_limit) {
+                return 0;
+            }
+            continue;
+        }
+        if ((label & 0xc0) || offset + 1 + label > len || out + 1 + label > DNS_NAME_MAX) {
+            return 0;
+        }
+        if (name) {
+            name[out] = label;
+            for (uint8_t i = 0; i < label; i++) {
+                uint8_t c = message[offset + 1 + i];
+                name[out + 1 + i] = (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
+            }
+        }
+        out += 1 + label;
+        offset += 1 + label;
+        if (label == 0) {
+            break;
+        }
+    }
+    if (name_len) {
+        *name_len = out;
+    }
+    return end ? end : offset;
+}
+
+static esp_err_t dns_question_parse(const uint8_t *message, uint16_t len, dns_question_t *question)
+{
+    if (len < DNS_HEADER_SIZE || read16(message + 4) != 1) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    uint16_t offset = dns_name_read(message, len, DNS_HEADER_SIZE, len, question->name, &question->name_len);
+    if (offset == 0 || offset + 4 > len) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    question->qtype = read16(message + offset);
+    question->qclass = read16(message + offset + 2);
+    question->end = offset + 4;
+    return ESP_OK;
+}
+
+/* Return the offset after the record at @param offset, 0 if it is invalid. */
+static uint16_t dns_record_read(const uint8_t *message, uint16_t len, uint16_t offset, dns_record_t *record)
+{
+    offset = dns_name_read(message, len, offset, len, NULL, NULL);
+    if (offset == 0 || offset + 10 > len) {
+        return 0;
+    }
+    record->fixed = offset;
+    record->type = read16(message + offset);
+    record->ttl = read32(message + offset + 4);
+    record->rdlength = read16(message + offset + 8);
+    record->rdata = offset + 10;
+    if (record->rdata + record->rdlength > len) {
+        return 0;
+    }
+    return record->rdata + record->rdlength;
+}
+
+static uint32_t dns_question_hash(const dns_question_t *question)
+{
+    uint32_t hash = 2166136261u; /* FNV-1a */
+    for (uint16_t i = 0; i < question->name_len; i++) {
+        hash = (hash ^ question->name[i]) * 16777619u;
+    }
+    return (hash ^ question->qtype) * 16777619u;
+}
+
+static dns_cache_entry_t *dns_cache_find(const dns_question_t *question, uint32_t hash)
+{
+    dns_question_t cached;
+
+    for (uint16_t i = 0; s_entries && i < CONFIG_OPENTHREAD_DNS_CACHE_ENTRIES; i++) {
+        dns_cache_entry_t *entry = &s_entries[i];
+        if (entry->len && entry->hash == hash && entry->qtype == question->qtype &&
+            dns_question_parse(entry->message, entry->len, &cached) == ESP_OK &&
+            cached.name_len == question->name_len && !memcmp(cached.name, question->name, question->name_len)) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static bool dns_cache_expired(const dns_cache_entry_t *entry, uint32_t now_ms)
+{
+    return now_ms - entry->stored_ms >= entry->ttl_s * 1000;
+}
+
+static dns_cache_entry_t *dns_cache_allocate(uint32_t now_ms)
+{
+    dns_cache_entry_t *oldest = NULL;
+
+    for (uint16_t i = 0; i < CONFIG_OPENTHREAD_DNS_CACHE_ENTRIES; i++) {
+        dns_cache_entry_t *entry = &s_entries[i];
+        if (entry->len == 0 || dns_cache_expired(entry, now_ms)) {
+            if (entry->len) {
+                s_stats.entries--;
+            }
+            entry->len = 0;
+            return entry;
+        }
+        if (!oldest || entry->last_used < oldest->last_used) {
+            oldest = entry;
+        }
+    }
+    s_stats.evictions++;
+    s_stats.entries--;
+    oldest->len = 0;
+    return oldest;
+}
+
+/* Reduce the TTLs of all the records but the OPT pseudo-record by @param elapsed_s. */
+static void dns_records_age(uint8_t *message, uint16_t len, uint16_t offset, uint32_t elapsed_s)
+{
+    uint16_t records = read16(message + 6) + read16(message + 8) + read16(message + 10);
+    dns_record_t record;
+
+    for (uint16_t i = 0; i < records && (offset = dns_record_read(message, len, offset, &record)); i++) {
+        if (record.type != DNS_TYPE_OPT) {
+            write32(message + record.fixed + 4, record.ttl > elapsed_s ? record.ttl - elapsed_s : 0);
+        }
+    }
+}
+
+esp_err_t esp_ot_dns_cache_init(void)
+{
+    if (s_entries) {
+        return ESP_OK;
+    }
+    s_entries = (dns_cache_entry_t *)calloc(CONFIG_OPENTHREAD_DNS_CACHE_ENTRIES, sizeof(dns_cache_entry_t));
+    ESP_RETURN_ON_FALSE(s_entries, ESP_ERR_NO_MEM, OT_EXT_CLI_TAG, "Failed to allocate the DNS cache");
+    memset(&s_stats, 0, sizeof(s_stats));
+    return ESP_OK;
+}
+
+esp_ot_dns_cache_result_t esp_ot_dns_cache_lookup(const uint8_t *query, uint16_t query_len, uint8_t *response,
+                                                  uint16_t response_size, uint16_t *response_len, uint32_t now_ms)
+{
+    dns_question_t question;
+    dns_question_t cached;
+
+    if (dns_question_parse(query, query_len, &question) != ESP_OK || (read16(query + 2) & DNS_FLAG_QR) ||
+        question.qclass != DNS_CLASS_IN) {
+        s_stats.misses++;
+        return ESP_OT_DNS_CACHE_MISS;
+    }
+    dns_cache_entry_t *entry = dns_cache_find(&question, dns_question_hash(&question));
+    if (entry && dns_cache_expired(entry, now_ms)) {
+        entry->len = 0;
+        s_stats.entries--;
+        entry = NULL;
+    }
+    if (!entry || entry->len > response_size || dns_question_parse(entry->message, entry->len, &cached) != ESP_OK) {
+        s_stats.misses++;
+        return ESP_OT_DNS_CACHE_MISS;
+    }
+
+    uint32_t elapsed_ms = now_ms - entry->stored_ms;
+    memcpy(response, entry->message, entry->len);
+    memcpy(response, query, 2);
+    write16(response + 2, (read16(response + 2) & ~DNS_FLAG_RD) | (read16(query + 2) & DNS_FLAG_RD));
+    /* Echo the case of the query name, as the resolvers randomizing it expect. */
+    if (cached.end == question.end) {
+        memcpy(response + DNS_HEADER_SIZE, query + DNS_HEADER_SIZE, question.end - DNS_HEADER_SIZE);
+    }
+    dns_records_age(response, entry->len, cached.end, elapsed_ms / 1000);
+    *response_len = entry->len;
+
+    entry->last_used = ++s_tick;
+    if (entry->hits < UINT16_MAX) {
+        entry->hits++;
+    }
+    s_stats.hits++;
+    if (entry->negative) {
+        s_stats.negative_hits++;
+    }
+    if (CONFIG_OPENTHREAD_DNS_CACHE_PREFETCH_HITS && !entry->negative && !entry->prefetching &&
+        entry->hits >= CONFIG_OPENTHREAD_DNS_CACHE_PREFETCH_HITS &&
+        (uint64_t)(entry->ttl_s * 1000 - elapsed_ms) * DNS_PREFETCH_TTL_DIVISOR <= (uint64_t)entry->ttl_s * 1000) {
+        entry->prefetching = true;
+        s_stats.prefetches++;
+        return ESP_OT_DNS_CACHE_HIT_PREFETCH;
+    }
+    return ESP_OT_DNS_CACHE_HIT;
+}
+
+esp_err_t esp_ot_dns_cache_insert(const uint8_t *response, uint16_t len, uint32_t now_ms)
+{
+    dns_question_t question;
+    dns_record_t record;
+    uint32_t answer_ttl = UINT32_MAX;
+    uint32_t soa_ttl = UINT32_MAX;
+    uint32_t ttl = 0;
+
+    ESP_RETURN_ON_FALSE(s_entries, ESP_ERR_INVALID_STATE, OT_EXT_CLI_TAG, "DNS cache is not initialized");
+    if (dns_question_parse(response, len, &question) != ESP_OK || !(read16(response + 2) & DNS_FLAG_QR)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    uint16_t flags = read16(response + 2);
+    uint8_t rcode = flags & 0x000f;
+    uint16_t answers = read16(response + 6);
+    uint16_t authorities = read16(response + 8);
+    uint16_t offset = question.end;
+    for (uint16_t i = 0; i < answers + authorities; i++) {
+        offset = dns_record_read(response, len, offset, &record);
+        if (offset == 0) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        if (i < answers && record.ttl < answer_ttl) {
+            answer_ttl = record.ttl;
+        } else if (i >= answers && record.type == DNS_TYPE_SOA && record.rdlength >= DNS_SOA_MIN_RDLENGTH) {
+            /* The negative TTL is the min of the TTL and of the MINIMUM field of the SOA record (RFC 2308). */
+            uint32_t minimum = read32(response + record.rdata + record.rdlength - 4);
+            soa_ttl = record.ttl < minimum ? record.ttl : minimum;
+        }
+    }
+
+    bool negative = rcode == ESP_OT_DNS_RCODE_NXDOMAIN || (rcode == ESP_OT_DNS_RCODE_NOERROR && answers == 0);
+    if (rcode == ESP_OT_DNS_RCODE_NOERROR && answers) {
+        ttl = answer_ttl < CONFIG_OPENTHREAD_DNS_CACHE_MAX_TTL ? answer_ttl : CONFIG_OPENTHREAD_DNS_CACHE_MAX_TTL;
+    } else if (negative && soa_ttl != UINT32_MAX) {
+        ttl = soa_ttl < CONFIG_OPENTHREAD_DNS_CACHE_NEGATIVE_TTL ? soa_ttl : CONFIG_OPENTHREAD_DNS_CACHE_NEGATIVE_TTL;
+    }
+    if (ttl == 0 || (flags & DNS_FLAG_TC) || question.qclass != DNS_CLASS_IN ||
+        len > CONFIG_OPENTHREAD_DNS_CACHE_MAX_MESSAGE) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+
+    uint32_t hash = dns_question_hash(&question);
+    uint16_t hits = 0;
+    dns_cache_entry_t *entry = dns_cache_find(&question, hash);
+    if (entry) {
+        hits = entry->hits; /* a refreshed entry stays popular */
+    } else {
+        entry = dns_cache_allocate(now_ms);
+        s_stats.entries++;
+    }
+    entry->hash = hash;
+    entry->qtype = question.qtype;
+    entry->len = len;
+    entry->stored_ms = now_ms;
+    entry->ttl_s = ttl;
+    entry->last_used = ++s_tick;
+    entry->hits = hits;
+    entry->negative = negative;
+    entry->prefetching = false;
+    memcpy(entry->message, response, len);
+    s_stats.inserts++;
+    return ESP_OK;
+}
+
+uint32_t esp_ot_dns_cache_key(const uint8_t *message, uint16_t len)
+{
+    dns_question_t question;
+
+    return dns_question_parse(message, len, &question) == ESP_OK ? dns_question_hash(&question) : 0;
+}
+
+void esp_ot_dns_cache_prefetch_done(uint32_t key)
+{
+    for (uint16_t i = 0; s_entries && key && i < CONFIG_OPENTHREAD_DNS_CACHE_ENTRIES; i++) {
+        if (s_entries[i].len && s_entries[i].hash == key) {
+            s_entries[i].prefetching = false;
+        }
+    }
+}
+
+void esp_ot_dns_cache_flush(void)
+{
+    for (uint16_t i = 0; s_entries && i < CONFIG_OPENTHREAD_DNS_CACHE_ENTRIES; i++) {
+        s_entries[i].len = 0;
+    }
+    s_stats.entries = 0;
+}
+
+void esp_ot_dns_cache_record_upstream(uint32_t latency_ms, bool timeout)
+{
+    if (timeout) {
+        s_stats.upstream_timeouts++;
+        return;
+    }
+    s_stats.upstream_queries++;
+    s_latency_sum_ms += latency_ms;
+    s_stats.latency_avg_ms = (uint32_t)(s_latency_sum_ms / s_stats.upstream_queries);
+    if (latency_ms > s_stats.latency_max_ms) {
+        s_stats.latency_max_ms = latency_ms;
+    }
+}
+
+void esp_ot_dns_cache_get_stats(esp_ot_dns_cache_stats_t *stats)
+{
+    *stats = s_stats;
+}
+
+esp_err_t esp_ot_dns_message_parse(const uint8_t *message, uint16_t len, uint16_t *qtype, uint8_t *rcode)
+{
+    dns_question_t question;
+
+    ESP_RETURN_ON_ERROR(dns_question_parse(message, len, &question), OT_EXT_CLI_TAG, "Invalid DNS message");
+    *qtype = question.qtype;
+    *rcode = read16(message + 2) & 0x000f;
+    return ESP_OK;
+}
+
+int esp_ot_dns_message_count_answers(const uint8_t *message, uint16_t len, uint16_t type)
+{
+    dns_question_t question;
+    dns_record_t record;
+    int count = 0;
+
+    if (dns_question_parse(message, len, &question) != ESP_OK) {
+        return -1;
+    }
+    uint16_t offset = question.end;
+    for (uint16_t i = 0; i < read16(message + 6); i++) {
+        offset = dns_record_read(message, len, offset, &record);
+        if (offset == 0) {
+            return -1;
+        }
+        count += record.type == type;
+    }
+    return count;
+}
+
+esp_err_t esp_ot_dns_message_make_query(const uint8_t *message, uint16_t len, uint16_t qtype, uint8_t *query,
+                                        uint16_t query_size, uint16_t *query_len)
+{
+    dns_question_t question;
+
+    ESP_RETURN_ON_ERROR(dns_question_parse(message, len, &question), OT_EXT_CLI_TAG, "Invalid DNS message");
+    ESP_RETURN_ON_FALSE(question.end <= query_size, ESP_ERR_INVALID_SIZE, OT_EXT_CLI_TAG, "DNS buffer too small");
+    memcpy(query, message, question.end);
+    write16(query + 2, DNS_FLAG_RD);
+    write16(query + 6, 0);
+    write16(query + 8, 0);
+    write16(query + 10, 0);
+    write16(query + question.end - 4, qtype);
+    *query_len = question.end;
+    return ESP_OK;
+}
+
+esp_err_t esp_ot_dns_synthesize_aaaa(const uint8_t *response, uint16_t len, const uint8_t prefix[12], uint8_t *out,
+                                     uint16_t out_size, uint16_t *out_len)
+{
+    dns_question_t question;
+    dns_record_t record;
+    uint16_t a_records = 0;
+    uint16_t first_a = len; /* the names after the first A record cannot point to it, it grows */
+
+    ESP_RETURN_ON_ERROR(dns_question_parse(response, len, &question), OT_EXT_CLI_TAG, "Invalid DNS response");
+    ESP_RETURN_ON_FALSE(question.end <= out_size, ESP_ERR_INVALID_SIZE, OT_EXT_CLI_TAG, "DNS buffer too small");
+    memcpy(out, response, question.end);
+    write16(out + question.end - 4, ESP_OT_DNS_TYPE_AAAA);
+
+    uint16_t answers = read16(response + 6);
+    uint16_t offset = question.end;
+    uint16_t out_offset = question.end;
+    for (uint16_t i = 0; i < answers; i++) {
+        uint16_t start = offset;
+        offset = dns_record_read(response, len, offset, &record);
+        ESP_RETURN_ON_FALSE(offset && dns_name_read(response, len, start, first_a, NULL, NULL), ESP_ERR_INVALID_ARG,
+                            OT_EXT_CLI_TAG, "Invalid DNS record");
+        ESP_RETURN_ON_FALSE(record.type != DNS_TYPE_CNAME ||
+                                dns_name_read(response, len, record.rdata, first_a, NULL, NULL),
+                            ESP_ERR_INVALID_ARG, OT_EXT_CLI_TAG, "Invalid DNS record");
+        if (record.type == ESP_OT_DNS_TYPE_A && record.rdlength == 4) {
+            uint16_t size = record.fixed - start + 10 + 16;
+            ESP_RETURN_ON_FALSE(out_offset + size <= out_size, ESP_ERR_INVALID_SIZE, OT_EXT_CLI_TAG,
+                                "DNS buffer too small");
+            memcpy(out + out_offset, response + start, record.fixed - start + 10);
+            out_offset += record.fixed - start;
+            write16(out + out_offset, ESP_OT_DNS_TYPE_AAAA);
+            write16(out + out_offset + 8, 16);
+            memcpy(out + out_offset + 10, prefix, 12);
+            memcpy(out + out_offset + 22, response + record.rdata, 4);
+            out_offset += 10 + 16;
+            first_a = first_a < record.rdata ? first_a : record.rdata;
+            a_records++;
+        } else {
+            ESP_RETURN_ON_FALSE(out_offset + offset - start <= out_size, ESP_ERR_INVALID_SIZE, OT_EXT_CLI_TAG,
+                                "DNS buffer too small");
+            memcpy(out + out_offset, response + start, offset - start);
+            out_offset += offset - start;
+        }
+    }
+    ESP_RETURN_ON_FALSE(a_records, ESP_ERR_INVALID_ARG, OT_EXT_CLI_TAG, "No A record to synthesize");
+    write16(out + 8, 0);
+    write16(out + 10, 0);
+    *out_len = out_offset;
+    s_stats.synthesized++;
+    return ESP_OK;
+}
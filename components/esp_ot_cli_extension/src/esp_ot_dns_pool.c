@@ -0,0 +1,452 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_ot_dns_pool.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/unistd.h>
+
+#include "esp_check.h"
+#include "esp_log.h"
+#include "esp_openthread.h"
+#include "esp_openthread_dns64.h"
+#include "esp_openthread_lock.h"
+#include "esp_ot_cli_extension.h"
+#include "esp_random.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "lwip/sockets.h"
+#include "openthread/cli.h"
+
+/*
+ * Each server of the pool is probed every CONFIG_OPENTHREAD_DNS_POOL_PROBE_INTERVAL seconds by an A query of
+ * CONFIG_OPENTHREAD_DNS_POOL_PROBE_NAME through the NAT64 prefix. A NOERROR or NXDOMAIN response is a success, a
+ * timeout or another response code is a failure. The RTTs of the successes and the failures are smoothed by EWMAs,
+ * 1/8 for the RTT as the TCP SRTT and 1/4 for the failures so a dead server is demoted after a few probes.
+ *
+ * The fastest healthy server is promoted to main when the main server is unhealthy, or when it is faster than the
+ * main server by CONFIG_OPENTHREAD_DNS_POOL_HYSTERESIS percent, so two servers of similar RTTs do not flap. A main
+ * server set by hand is pinned, the servers are still probed but none is promoted until `dns64server pool auto`.
+ */
+#define DNS_POOL_TASK_STACK_SIZE 3072
+#define DNS_POOL_TASK_PRIORITY 4
+#define DNS_POOL_PROBE_TIMEOUT_MS 2000
+#define DNS_POOL_PROBE_PORT 53
+#define DNS_POOL_PROBE_MAX_SIZE 128
+#define DNS_POOL_RTT_EWMA_SHIFT 3
+#define DNS_POOL_FAILURE_EWMA_SHIFT 2
+#define DNS_POOL_UNHEALTHY_PERMILLE 500 /* the failure EWMA from which a server is unhealthy */
+#define DNS_POOL_MAX_FAILURES 3         /* the consecutive failures from which a server is unhealthy */
+
+typedef struct dns_pool_entry {
+    bool used;
+    uint32_t rtt_x8; /* the RTT EWMA in 1/8 ms */
+    uint8_t history_head;
+    esp_ot_dns_pool_server_t server;
+} dns_pool_entry_t;
+
+static dns_pool_entry_t *s_entries = NULL;
+static uint32_t s_main = ESP_OT_DNS_POOL_NO_SERVER;
+static uint32_t s_pinned = ESP_OT_DNS_POOL_NO_SERVER;
+static esp_ot_dns_pool_apply_t s_apply = NULL;
+static esp_ot_dns_pool_decision_t s_decisions[ESP_OT_DNS_POOL_DECISION_NUM];
+static uint8_t s_decision_head = 0; /* the next decision */
+static uint8_t s_decision_count = 0;
+
+static uint32_t dns_pool_now(void)
+{
+    return (uint32_t)(esp_timer_get_time() / 1000000);
+}
+
+static dns_pool_entry_t *dns_pool_find(uint32_t addr)
+{
+    for (uint8_t i = 0; s_entries && i < CONFIG_OPENTHREAD_DNS_POOL_MAX_SERVERS; i++) {
+        if (s_entries[i].used && s_entries[i].server.addr == addr) {
+            return &s_entries[i];
+        }
+    }
+    return NULL;
+}
+
+static void dns_pool_add_decision(uint32_t now, const dns_pool_entry_t *from, uint32_t to_addr,
+                                  const dns_pool_entry_t *to, esp_ot_dns_pool_reason_t reason)
+{
+    esp_ot_dns_pool_decision_t *decision = &s_decisions[s_decision_head];
+
+    decision->time = now;
+    decision->from = s_main;
+    decision->from_rtt_ms = from ? from->server.rtt_ms : 0;
+    decision->to = to_addr;
+    decision->to_rtt_ms = to ? to->server.rtt_ms : 0;
+    decision->reason = reason;
+    s_decision_head = (s_decision_head + 1) % ESP_OT_DNS_POOL_DECISION_NUM;
+    s_decision_count += s_decision_count < ESP_OT_DNS_POOL_DECISION_NUM;
+}
+
+static const char *dns_pool_addr_str(uint32_t addr)
+{
+    ip4_addr_t ip4_addr = {.addr = addr};
+    return addr == ESP_OT_DNS_POOL_NO_SERVER ? "-" : ip4addr_ntoa(&ip4_addr);
+}
+
+/* Promote the fastest healthy server if the main server was @param removed, is unhealthy or is slower by the
+   hysteresis. */
+static void dns_pool_select(uint32_t now, dns_pool_entry_t *removed)
+{
+    dns_pool_entry_t *current = removed ? removed : dns_pool_find(s_main);
+    dns_pool_entry_t *best = NULL;
+    esp_ot_dns_pool_reason_t reason = ESP_OT_DNS_POOL_REASON_FIRST;
+
+    if (s_pinned != ESP_OT_DNS_POOL_NO_SERVER) {
+        return;
+    }
+    for (uint8_t i = 0; i < CONFIG_OPENTHREAD_DNS_POOL_MAX_SERVERS; i++) {
+        dns_pool_entry_t *entry = &s_entries[i];
+        if (entry->used && entry->server.healthy && (!best || entry->server.rtt_ms < best->server.rtt_ms)) {
+            best = entry;
+        }
+    }
+    if (removed) {
+        reason = ESP_OT_DNS_POOL_REASON_REMOVED;
+    } else if (current && current->server.healthy) {
+        if (!best || best == current ||
+            (uint64_t)best->server.rtt_ms * 100 >=
+                (uint64_t)current->server.rtt_ms * (100 - CONFIG_OPENTHREAD_DNS_POOL_HYSTERESIS)) {
+            return;
+        }
+        reason = ESP_OT_DNS_POOL_REASON_FASTER;
+    } else if (current) {
+        if (!best) {
+            return; /* keep the main server until another one answers */
+        }
+        reason = ESP_OT_DNS_POOL_REASON_UNHEALTHY;
+    } else if (!best) {
+        return;
+    }
+
+    dns_pool_add_decision(now, current, best ? best->server.addr : ESP_OT_DNS_POOL_NO_SERVER, best, reason);
+    if (current) {
+        current->server.main = false;
+    }
+    s_main = best ? best->server.addr : ESP_OT_DNS_POOL_NO_SERVER;
+    if (!best) {
+        ESP_LOGW(OT_EXT_CLI_TAG, "No healthy DNS server in the pool");
+        return;
+    }
+    best->server.main = true;
+    ESP_LOGI(OT_EXT_CLI_TAG, "Promote DNS server %s to main (%s, %lu ms)", dns_pool_addr_str(best->server.addr),
+             esp_ot_dns_pool_reason_name(reason), (unsigned long)best->server.rtt_ms);
+    if (s_apply && s_apply(best->server.addr) != ESP_OK) {
+        ESP_LOGW(OT_EXT_CLI_TAG, "Failed to set the main DNS server");
+    }
+}
+
+esp_err_t esp_ot_dns_pool_add(uint32_t addr)
+{
+    dns_pool_entry_t *entry = NULL;
+
+    ESP_RETURN_ON_FALSE(s_entries, ESP_ERR_INVALID_STATE, OT_EXT_CLI_TAG, "DNS pool is not initialized");
+    if (dns_pool_find(addr)) {
+        return ESP_OK;
+    }
+    for (uint8_t i = 0; i < CONFIG_OPENTHREAD_DNS_POOL_MAX_SERVERS && !entry; i++) {
+        entry = s_entries[i].used ? NULL : &s_entries[i];
+    }
+    ESP_RETURN_ON_FALSE(entry, ESP_ERR_NO_MEM, OT_EXT_CLI_TAG, "DNS pool is full");
+    memset(entry, 0, sizeof(*entry));
+    entry->used = true;
+    entry->server.addr = addr;
+    return ESP_OK;
+}
+
+esp_err_t esp_ot_dns_pool_remove(uint32_t addr, uint32_t now)
+{
+    dns_pool_entry_t *entry = dns_pool_find(addr);
+
+    ESP_RETURN_ON_FALSE(entry, ESP_ERR_NOT_FOUND, OT_EXT_CLI_TAG, "DNS server is not in the pool");
+    entry->used = false;
+    if (addr == s_main) {
+        dns_pool_select(now, entry);
+    }
+    return ESP_OK;
+}
+
+void esp_ot_dns_pool_pin(uint32_t addr, uint32_t now)
+{
+    dns_pool_entry_t *current = dns_pool_find(s_main);
+    dns_pool_entry_t *pinned = dns_pool_find(addr);
+
+    if (s_pinned != addr) {
+        dns_pool_add_decision(now, current, addr, pinned, ESP_OT_DNS_POOL_REASON_MANUAL);
+    }
+    if (current) {
+        current->server.main = false;
+    }
+    if (pinned) {
+        pinned->server.main = true;
+    }
+    s_main = addr;
+    s_pinned = addr;
+}
+
+void esp_ot_dns_pool_unpin(uint32_t now)
+{
+    if (s_pinned == ESP_OT_DNS_POOL_NO_SERVER) {
+        return;
+    }
+    s_pinned = ESP_OT_DNS_POOL_NO_SERVER;
+    if (s_entries) {
+        dns_pool_select(now, NULL);
+    }
+}
+
+uint32_t esp_ot_dns_pool_get_pinned(void)
+{
+    return s_pinned;
+}
+
+esp_err_t esp_ot_dns_pool_record_probe(uint32_t addr, uint16_t rtt_ms, uint32_t now)
+{
+    dns_pool_entry_t *entry = dns_pool_find(addr);
+    esp_ot_dns_pool_server_t *server = NULL;
+    bool failed = rtt_ms == ESP_OT_DNS_POOL_PROBE_FAILED;
+
+    ESP_RETURN_ON_FALSE(entry, ESP_ERR_NOT_FOUND, OT_EXT_CLI_TAG, "DNS server is not in the pool");
+    server = &entry->server;
+    bool answered = server->probes > server->failures;
+    if (failed) {
+        server->failures++;
+        server->consecutive_failures++;
+    } else {
+        server->consecutive_failures = 0;
+        if (!answered) {
+            entry->rtt_x8 = (uint32_t)rtt_ms << DNS_POOL_RTT_EWMA_SHIFT;
+        } else {
+            entry->rtt_x8 = entry->rtt_x8 - (entry->rtt_x8 >> DNS_POOL_RTT_EWMA_SHIFT) + rtt_ms;
+        }
+        server->rtt_ms = (entry->rtt_x8 + (1 << (DNS_POOL_RTT_EWMA_SHIFT - 1))) >> DNS_POOL_RTT_EWMA_SHIFT;
+    }
+    if (server->probes == 0) {
+        server->failure_permille = failed ? 1000 : 0;
+    } else {
+        int32_t delta = (failed ? 1000 : 0) - (int32_t)server->failure_permille;
+        server->failure_permille += delta / (1 << DNS_POOL_FAILURE_EWMA_SHIFT);
+    }
+    server->probes++;
+    server->last_probe = now;
+    server->healthy = server->probes > server->failures && server->consecutive_failures < DNS_POOL_MAX_FAILURES &&
+                      server->failure_permille < DNS_POOL_UNHEALTHY_PERMILLE;
+
+    server->history[(entry->history_head + server->history_len) % CONFIG_OPENTHREAD_DNS_POOL_HISTORY_SIZE] = rtt_ms;
+    if (server->history_len < CONFIG_OPENTHREAD_DNS_POOL_HISTORY_SIZE) {
+        server->history_len++;
+    } else {
+        entry->history_head = (entry->history_head + 1) % CONFIG_OPENTHREAD_DNS_POOL_HISTORY_SIZE;
+    }
+    dns_pool_select(now, NULL);
+    return ESP_OK;
+}
+
+uint8_t esp_ot_dns_pool_get_servers(esp_ot_dns_pool_server_t *servers, uint8_t max)
+{
+    uint8_t count = 0;
+
+    for (uint8_t i = 0; s_entries && i < CONFIG_OPENTHREAD_DNS_POOL_MAX_SERVERS && count < max; i++) {
+        const dns_pool_entry_t *entry = &s_entries[i];
+        if (!entry->used) {
+            continue;
+        }
+        servers[count] = entry->server;
+        for (uint8_t j = 0; j < entry->server.history_len; j++) {
+            servers[count].history[j] =
+                entry->server.history[(entry->history_head + j) % CONFIG_OPENTHREAD_DNS_POOL_HISTORY_SIZE];
+        }
+        count++;
+    }
+    return count;
+}
+
+uint8_t esp_ot_dns_pool_get_decisions(esp_ot_dns_pool_decision_t *decisions, uint8_t max)
+{
+    uint8_t count = 0;
+
+    for (; count < s_decision_count && count < max; count++) {
+        decisions[count] =
+            s_decisions[(s_decision_head + ESP_OT_DNS_POOL_DECISION_NUM - 1 - count) % ESP_OT_DNS_POOL_DECISION_NUM];
+    }
+    return count;
+}
+
+const char *esp_ot_dns_pool_reason_name(esp_ot_dns_pool_reason_t reason)
+{
+    static const char *s_names[] = {"first", "faster", "unhealthy", "removed", "manual"};
+    return reason <= ESP_OT_DNS_POOL_REASON_MANUAL ? s_names[reason] : "unknown";
+}
+
+/* Send an A query of the probe name to the server, return the RTT in ms or ESP_OT_DNS_POOL_PROBE_FAILED. */
+static uint16_t dns_pool_probe(const ip6_addr_t *nat64_prefix, uint32_t addr)
+{
+    uint8_t message[DNS_POOL_PROBE_MAX_SIZE] = {0};
+    uint16_t len = 12;
+    uint16_t id = esp_random() & 0xffff;
+    uint16_t rtt_ms = ESP_OT_DNS_POOL_PROBE_FAILED;
+    const char *label = CONFIG_OPENTHREAD_DNS_POOL_PROBE_NAME;
+    struct sockaddr_in6 server = {
+        .sin6_family = AF_INET6,
+        .sin6_port = htons(DNS_POOL_PROBE_PORT),
+    };
+    struct timeval timeout = {
+        .tv_sec = DNS_POOL_PROBE_TIMEOUT_MS / 1000,
+        .tv_usec = (DNS_POOL_PROBE_TIMEOUT_MS % 1000) * 1000,
+    };
+
+    message[0] = id >> 8;
+    message[1] = id & 0xff;
+    message[2] = 0x01; /* RD */
+    message[5] = 1;    /* QDCOUNT */
+    while (*label) {
+        const char *dot = strchr(label, '.');
+        size_t label_len = dot ? (size_t)(dot - label) : strlen(label);
+        ESP_RETURN_ON_FALSE(label_len > 0 && label_len < 64 && len + 1 + label_len + 5 <= sizeof(message), rtt_ms,
+                            OT_EXT_CLI_TAG, "Invalid DNS probe name");
+        message[len++] = label_len;
+        memcpy(message + len, label, label_len);
+        len += label_len;
+        label += label_len + (dot ? 1 : 0);
+    }
+    message[len++] = 0;
+    message[len++] = 0;
+    message[len++] = 1; /* A */
+    message[len++] = 0;
+    message[len++] = 1; /* IN */
+
+    memcpy(&server.sin6_addr, nat64_prefix->addr, 12);
+    memcpy((uint8_t *)&server.sin6_addr + 12, &addr, sizeof(addr));
+    int sock = socket(AF_INET6, SOCK_DGRAM, IPPROTO_IPV6);
+    ESP_RETURN_ON_FALSE(sock >= 0, rtt_ms, OT_EXT_CLI_TAG, "Unable to create socket: errno %d", errno);
+    setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    int64_t sent_us = esp_timer_get_time();
+    if (sendto(sock, message, len, 0, (struct sockaddr *)&server, sizeof(server)) == len) {
+        int64_t elapsed_us = 0;
+        while (elapsed_us < DNS_POOL_PROBE_TIMEOUT_MS * 1000LL) {
+            int received = recv(sock, message, sizeof(message), 0);
+            elapsed_us = esp_timer_get_time() - sent_us;
+            if (received < 0) {
+                break;
+            }
+            uint8_t rcode = message[3] & 0x0f;
+            /* A response truncated by the buffer is fine, only its header is checked. */
+            if (received >= 12 && ((message[0] << 8) | message[1]) == id && (message[2] & 0x80) &&
+                (rcode == 0 || rcode == 3)) {
+                rtt_ms = elapsed_us / 1000 < ESP_OT_DNS_POOL_PROBE_FAILED ? elapsed_us / 1000 : rtt_ms;
+                break;
+            }
+        }
+    }
+    close(sock);
+    return rtt_ms;
+}
+
+static void dns_pool_probe_worker(void *ctx)
+{
+    (void)ctx;
+    uint32_t addrs[CONFIG_OPENTHREAD_DNS_POOL_MAX_SERVERS];
+    ip6_addr_t nat64_prefix;
+
+    while (true) {
+        vTaskDelay(pdMS_TO_TICKS(CONFIG_OPENTHREAD_DNS_POOL_PROBE_INTERVAL * 1000));
+        uint8_t count = 0;
+        esp_openthread_lock_acquire(portMAX_DELAY);
+        for (uint8_t i = 0; i < CONFIG_OPENTHREAD_DNS_POOL_MAX_SERVERS; i++) {
+            if (s_entries[i].used) {
+                addrs[count++] = s_entries[i].server.addr;
+            }
+        }
+        esp_err_t err = count ? esp_openthread_get_nat64_prefix(&nat64_prefix) : ESP_ERR_NOT_FOUND;
+        esp_openthread_lock_release();
+        if (err != ESP_OK) {
+            continue;
+        }
+        for (uint8_t i = 0; i < count; i++) {
+            uint16_t rtt_ms = dns_pool_probe(&nat64_prefix, addrs[i]);
+            esp_openthread_lock_acquire(portMAX_DELAY);
+            esp_ot_dns_pool_record_probe(addrs[i], rtt_ms, dns_pool_now());
+            esp_openthread_lock_release();
+        }
+    }
+}
+
+esp_err_t esp_ot_dns_pool_init(esp_ot_dns_pool_apply_t apply)
+{
+    s_entries = calloc(CONFIG_OPENTHREAD_DNS_POOL_MAX_SERVERS, sizeof(dns_pool_entry_t));
+    ESP_RETURN_ON_FALSE(s_entries, ESP_ERR_NO_MEM, OT_EXT_CLI_TAG, "Failed to allocate the DNS pool");
+    s_apply = apply;
+    s_main = ESP_OT_DNS_POOL_NO_SERVER;
+    ESP_RETURN_ON_FALSE(xTaskCreate(dns_pool_probe_worker, "ot_dns_pool", DNS_POOL_TASK_STACK_SIZE, NULL,
+                                    DNS_POOL_TASK_PRIORITY, NULL) == pdTRUE,
+                        ESP_FAIL, OT_EXT_CLI_TAG, "Failed to create DNS pool task");
+    return ESP_OK;
+}
+
+otError esp_ot_dns_pool_process(uint8_t aArgsLength, char *aArgs[])
+{
+    ip4_addr_t addr;
+
+    if (aArgsLength == 0) {
+        esp_ot_dns_pool_server_t servers[CONFIG_OPENTHREAD_DNS_POOL_MAX_SERVERS];
+        uint8_t count = esp_ot_dns_pool_get_servers(servers, CONFIG_OPENTHREAD_DNS_POOL_MAX_SERVERS);
+        if (s_pinned != ESP_OT_DNS_POOL_NO_SERVER) {
+            otCliOutputFormat("main %s pinned by hand, 'dns64server pool auto' lets the pool promote\n",
+                              dns_pool_addr_str(s_pinned));
+        }
+        for (uint8_t i = 0; i < count; i++) {
+            otCliOutputFormat("%s", dns_pool_addr_str(servers[i].addr));
+            otCliOutputFormat("%s%s: rtt %lu ms, failures %u.%u%%, %lu probes, %lu failed, history:",
+                              servers[i].main ? " main" : "", servers[i].healthy ? " healthy" : "",
+                              (unsigned long)servers[i].rtt_ms, servers[i].failure_permille / 10,
+                              servers[i].failure_permille % 10, (unsigned long)servers[i].probes,
+                              (unsigned long)servers[i].failures);
+            for (uint8_t j = 0; j < servers[i].history_len; j++) {
+                if (servers[i].history[j] == ESP_OT_DNS_POOL_PROBE_FAILED) {
+                    otCliOutputFormat(" -");
+                } else {
+                    otCliOutputFormat(" %u", servers[i].history[j]);
+                }
+            }
+            otCliOutputFormat("\n");
+        }
+    } else if (strcmp(aArgs[0], "add") == 0 || strcmp(aArgs[0], "remove") == 0) {
+        ESP_RETURN_ON_FALSE(aArgsLength == 2 && ip4addr_aton(aArgs[1], &addr) == 1 &&
+                                addr.addr != ESP_OT_DNS_POOL_NO_SERVER,
+                            OT_ERROR_INVALID_ARGS, OT_EXT_CLI_TAG, "Invalid DNS server");
+        if (strcmp(aArgs[0], "add") == 0) {
+            ESP_RETURN_ON_FALSE(esp_ot_dns_pool_add(addr.addr) == ESP_OK, OT_ERROR_NO_BUFS, OT_EXT_CLI_TAG,
+                                "Failed to add DNS server");
+        } else {
+            ESP_RETURN_ON_FALSE(esp_ot_dns_pool_remove(addr.addr, dns_pool_now()) == ESP_OK, OT_ERROR_NOT_FOUND,
+                                OT_EXT_CLI_TAG, "Failed to remove DNS server");
+        }
+    } else if (strcmp(aArgs[0], "auto") == 0) {
+        esp_ot_dns_pool_unpin(dns_pool_now());
+    } else if (strcmp(aArgs[0], "decisions") == 0) {
+        esp_ot_dns_pool_decision_t decisions[ESP_OT_DNS_POOL_DECISION_NUM];
+        uint8_t count = esp_ot_dns_pool_get_decisions(decisions, ESP_OT_DNS_POOL_DECISION_NUM);
+        for (uint8_t i = 0; i < count; i++) {
+            otCliOutputFormat("%lu s: %s", (unsigned long)decisions[i].time,
+                              esp_ot_dns_pool_reason_name(decisions[i].reason));
+            otCliOutputFormat(", %s (%lu ms)", dns_pool_addr_str(decisions[i].from),
+                              (unsigned long)decisions[i].from_rtt_ms);
+            otCliOutputFormat(" -> %s (%lu ms)\n", dns_pool_addr_str(decisions[i].to),
+                              (unsigned long)decisions[i].to_rtt_ms);
+        }
+    } else {
+        return OT_ERROR_INVALID_ARGS;
+    }
+    return OT_ERROR_NONE;
+}
@@ -0,0 +1,445 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_ot_dns_cache.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/unistd.h>
+
+#include "esp_check.h"
+#include "esp_log.h"
+#include "esp_netif.h"
+#include "esp_openthread.h"
+#include "esp_openthread_dns64.h"
+#include "esp_openthread_netif_glue.h"
+#include "esp_ot_cli_extension.h"
+#include "esp_random.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "lwip/ip6_addr.h"
+#include "lwip/sockets.h"
+#include "openthread/cli.h"
+
+/*
+ * The resolver answers the queries on CONFIG_OPENTHREAD_DNS_CACHE_PORT from the cache, and forwards the misses to
+ * the upstream server through the NAT64 prefix. A AAAA query answered without AAAA records is asked again as an A
+ * query, whose response is synthesized into AAAA records of the NAT64 prefix. A hit on a popular entry about to
+ * expire is answered from the cache and forwarded too, so the entry is refreshed before the next query. Only the
+ * queries of this node and of the Thread netif are served, so the resolver is not open to the other netifs.
+ */
+#define DNS_RESOLVER_TASK_STACK_SIZE 4096
+#define DNS_RESOLVER_TASK_PRIORITY 5
+#define DNS_RESOLVER_PENDING_NUM 16
+#ifndef DNS_RESOLVER_UPSTREAM_PORT
+#define DNS_RESOLVER_UPSTREAM_PORT 53 /* overridden by the host test */
+#endif
+#define DNS_RESOLVER_UPSTREAM_TIMEOUT_MS 3000
+#define DNS_RESOLVER_POLL_MS 500
+#define DNS_RESOLVER_MIN_MESSAGE 12 /* the header */
+#define DNS_RESOLVER_PREFIX_LEN 8    /* the Thread prefixes are /64 */
+
+typedef struct dns_pending {
+    bool used;
+    bool prefetch;   /* no client waits for the response */
+    bool synthesize; /* the A query of a AAAA query */
+    uint16_t id;     /* the ID of the upstream query */
+    uint16_t client_id;
+    uint32_t prefetch_key; /* the key of the entry prefetched, 0 if none */
+    uint32_t sent_ms;
+    struct in6_addr server; /* the upstream server queried */
+    struct sockaddr_in6 client;
+} dns_pending_t;
+
+typedef struct dns_resolver {
+    int server_sock;
+    int upstream_sock;
+    struct sockaddr_in6 upstream; /* guarded by s_mutex, changed by esp_ot_dns_resolver_start() */
+    uint8_t prefix[12];           /* guarded by s_mutex */
+    dns_pending_t pending[DNS_RESOLVER_PENDING_NUM];
+    uint8_t rx[CONFIG_OPENTHREAD_DNS_CACHE_MAX_MESSAGE];
+    uint8_t tx[CONFIG_OPENTHREAD_DNS_CACHE_MAX_MESSAGE];
+} dns_resolver_t;
+
+static dns_resolver_t *s_resolver = NULL;
+static volatile bool s_running = false;
+static SemaphoreHandle_t s_mutex = NULL; /* the lock of the cache and of the upstream server */
+static SemaphoreHandle_t s_stopped_semaphore = NULL;
+
+static uint32_t dns_resolver_now_ms(void)
+{
+    return (uint32_t)(esp_timer_get_time() / 1000);
+}
+
+static bool dns_resolver_client_allowed(const struct sockaddr_in6 *client)
+{
+    esp_ip6_addr_t addrs[CONFIG_LWIP_IPV6_NUM_ADDRESSES];
+    esp_netif_t *netif = esp_openthread_get_netif();
+    ip6_addr_t source;
+
+    inet6_addr_to_ip6addr(&source, &client->sin6_addr);
+    if (ip6_addr_isloopback(&source)) {
+        return true;
+    }
+    if (!netif) {
+        return false;
+    }
+    if (ip6_addr_islinklocal(&source)) {
+        return client->sin6_scope_id == (uint32_t)esp_netif_get_netif_impl_index(netif);
+    }
+    /* The mesh-local prefix and the OMR prefixes, from the addresses of this node on the Thread netif. */
+    int num = esp_netif_get_all_ip6(netif, addrs);
+    for (int i = 0; i < num; i++) {
+        if (memcmp(addrs[i].addr, source.addr, DNS_RESOLVER_PREFIX_LEN) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void dns_resolver_prefetch_done(uint32_t prefetch_key)
+{
+    if (prefetch_key) {
+        xSemaphoreTake(s_mutex, portMAX_DELAY);
+        esp_ot_dns_cache_prefetch_done(prefetch_key);
+        xSemaphoreGive(s_mutex);
+    }
+}
+
+static void dns_resolver_forward(uint8_t *query, uint16_t len, const struct sockaddr_in6 *client, uint16_t client_id,
+                                 bool synthesize, uint32_t prefetch_key)
+{
+    dns_pending_t *pending = NULL;
+    uint16_t id = 0;
+    bool unique = false;
+
+    for (uint8_t i = 0; i < DNS_RESOLVER_PENDING_NUM && !pending; i++) {
+        pending = s_resolver->pending[i].used ? NULL : &s_resolver->pending[i];
+    }
+    if (!pending) {
+        ESP_LOGW(OT_EXT_CLI_TAG, "Too many pending DNS queries, drop the query");
+        dns_resolver_prefetch_done(prefetch_key);
+        return;
+    }
+    /* A random ID per upstream query, so the responses cannot be easily spoofed. */
+    while (!unique) {
+        id = esp_random() & 0xffff;
+        unique = true;
+        for (uint8_t i = 0; i < DNS_RESOLVER_PENDING_NUM; i++) {
+            unique = unique && !(s_resolver->pending[i].used && s_resolver->pending[i].id == id);
+        }
+    }
+    query[0] = id >> 8;
+    query[1] = id & 0xff;
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    struct sockaddr_in6 upstream = s_resolver->upstream;
+    xSemaphoreGive(s_mutex);
+    uint32_t sent_ms = dns_resolver_now_ms();
+    if (sendto(s_resolver->upstream_sock, query, len, 0, (struct sockaddr *)&upstream, sizeof(upstream)) < 0) {
+        ESP_LOGW(OT_EXT_CLI_TAG, "Failed to send DNS query upstream: errno %d", errno);
+        dns_resolver_prefetch_done(prefetch_key);
+        return;
+    }
+    pending->used = true;
+    pending->prefetch = client == NULL;
+    pending->synthesize = synthesize;
+    pending->id = id;
+    pending->client_id = client_id;
+    pending->prefetch_key = prefetch_key;
+    pending->sent_ms = sent_ms;
+    pending->server = upstream.sin6_addr;
+    if (client) {
+        pending->client = *client;
+    }
+}
+
+static void dns_resolver_handle_query(void)
+{
+    struct sockaddr_in6 client;
+    socklen_t socklen = sizeof(client);
+    uint16_t response_len = 0;
+
+    int len = recvfrom(s_resolver->server_sock, s_resolver->rx, sizeof(s_resolver->rx), 0, (struct sockaddr *)&client,
+                       &socklen);
+    if (len < DNS_RESOLVER_MIN_MESSAGE || !dns_resolver_client_allowed(&client)) {
+        return;
+    }
+    uint16_t client_id = (s_resolver->rx[0] << 8) | s_resolver->rx[1];
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    esp_ot_dns_cache_result_t result = esp_ot_dns_cache_lookup(s_resolver->rx, len, s_resolver->tx,
+                                                               sizeof(s_resolver->tx), &response_len,
+                                                               dns_resolver_now_ms());
+    xSemaphoreGive(s_mutex);
+    if (result == ESP_OT_DNS_CACHE_MISS) {
+        dns_resolver_forward(s_resolver->rx, len, &client, client_id, false, 0);
+        return;
+    }
+    sendto(s_resolver->server_sock, s_resolver->tx, response_len, 0, (struct sockaddr *)&client, socklen);
+    if (result == ESP_OT_DNS_CACHE_HIT_PREFETCH) {
+        dns_resolver_forward(s_resolver->rx, len, NULL, client_id, false, esp_ot_dns_cache_key(s_resolver->rx, len));
+    }
+}
+
+/* Answer the client of a pending query with its response, return whether the query is forwarded again. */
+static bool dns_resolver_answer(const dns_pending_t *pending, uint16_t len)
+{
+    uint16_t qtype = 0;
+    uint8_t rcode = 0;
+    uint8_t *response = s_resolver->rx;
+    uint16_t response_len = len;
+
+    if (esp_ot_dns_message_parse(s_resolver->rx, len, &qtype, &rcode) != ESP_OK) {
+        return false;
+    }
+    uint32_t now = dns_resolver_now_ms();
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    esp_ot_dns_cache_record_upstream(now - pending->sent_ms, false);
+    xSemaphoreGive(s_mutex);
+
+    const struct sockaddr_in6 *client = pending->prefetch ? NULL : &pending->client;
+    if (!pending->synthesize && qtype == ESP_OT_DNS_TYPE_AAAA && rcode == ESP_OT_DNS_RCODE_NOERROR &&
+        esp_ot_dns_message_count_answers(s_resolver->rx, len, ESP_OT_DNS_TYPE_AAAA) == 0) {
+        if (esp_ot_dns_message_make_query(s_resolver->rx, len, ESP_OT_DNS_TYPE_A, s_resolver->tx,
+                                          sizeof(s_resolver->tx), &response_len) != ESP_OK) {
+            return false;
+        }
+        dns_resolver_forward(s_resolver->tx, response_len, client, pending->client_id, true, pending->prefetch_key);
+        return true;
+    }
+    if (pending->synthesize) {
+        uint8_t prefix[sizeof(s_resolver->prefix)];
+        xSemaphoreTake(s_mutex, portMAX_DELAY);
+        memcpy(prefix, s_resolver->prefix, sizeof(prefix));
+        xSemaphoreGive(s_mutex);
+        response = s_resolver->tx;
+        if (rcode != ESP_OT_DNS_RCODE_NOERROR ||
+            esp_ot_dns_message_count_answers(s_resolver->rx, len, ESP_OT_DNS_TYPE_A) <= 0 ||
+            esp_ot_dns_synthesize_aaaa(s_resolver->rx, len, prefix, s_resolver->tx, sizeof(s_resolver->tx),
+                                       &response_len) != ESP_OK) {
+            /* There is no IPv4 address either, answer the AAAA query with the response code of the A query. */
+            if (esp_ot_dns_message_make_query(s_resolver->rx, len, ESP_OT_DNS_TYPE_AAAA, s_resolver->tx,
+                                              sizeof(s_resolver->tx), &response_len) != ESP_OK) {
+                return false;
+            }
+            s_resolver->tx[2] = 0x81;         /* QR and RD */
+            s_resolver->tx[3] = 0x80 | rcode; /* RA */
+        }
+    }
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    esp_ot_dns_cache_insert(response, response_len, now);
+    xSemaphoreGive(s_mutex);
+    if (client) {
+        response[0] = pending->client_id >> 8;
+        response[1] = pending->client_id & 0xff;
+        sendto(s_resolver->server_sock, response, response_len, 0, (struct sockaddr *)client, sizeof(*client));
+    }
+    return false;
+}
+
+static void dns_resolver_handle_response(void)
+{
+    struct sockaddr_in6 from;
+    socklen_t socklen = sizeof(from);
+    dns_pending_t pending = {0};
+
+    int len = recvfrom(s_resolver->upstream_sock, s_resolver->rx, sizeof(s_resolver->rx), 0, (struct sockaddr *)&from,
+                       &socklen);
+    if (len < DNS_RESOLVER_MIN_MESSAGE || from.sin6_port != htons(DNS_RESOLVER_UPSTREAM_PORT)) {
+        return;
+    }
+    /* The queries pending on a former upstream server are still answered by it. */
+    uint16_t id = (s_resolver->rx[0] << 8) | s_resolver->rx[1];
+    for (uint8_t i = 0; i < DNS_RESOLVER_PENDING_NUM; i++) {
+        if (s_resolver->pending[i].used && s_resolver->pending[i].id == id &&
+            memcmp(&s_resolver->pending[i].server, &from.sin6_addr, sizeof(from.sin6_addr)) == 0) {
+            pending = s_resolver->pending[i];
+            s_resolver->pending[i].used = false;
+        }
+    }
+    /* A prefetch whose response is not cached ends here too, or its entry would never be prefetched again. */
+    if (pending.used && !dns_resolver_answer(&pending, len)) {
+        dns_resolver_prefetch_done(pending.prefetch_key);
+    }
+}
+
+static void dns_resolver_expire_pending(void)
+{
+    uint32_t now = dns_resolver_now_ms();
+
+    for (uint8_t i = 0; i < DNS_RESOLVER_PENDING_NUM; i++) {
+        if (s_resolver->pending[i].used && now - s_resolver->pending[i].sent_ms >= DNS_RESOLVER_UPSTREAM_TIMEOUT_MS) {
+            s_resolver->pending[i].used = false;
+            xSemaphoreTake(s_mutex, portMAX_DELAY);
+            esp_ot_dns_cache_record_upstream(0, true);
+            esp_ot_dns_cache_prefetch_done(s_resolver->pending[i].prefetch_key);
+            xSemaphoreGive(s_mutex);
+        }
+    }
+}
+
+static void dns_resolver_task_worker(void *ctx)
+{
+    (void)ctx;
+    int max_sock = s_resolver->server_sock > s_resolver->upstream_sock ? s_resolver->server_sock
+                                                                        : s_resolver->upstream_sock;
+
+    while (s_running) {
+        fd_set read_fds;
+        struct timeval timeout = {.tv_sec = 0, .tv_usec = DNS_RESOLVER_POLL_MS * 1000};
+        FD_ZERO(&read_fds);
+        FD_SET(s_resolver->server_sock, &read_fds);
+        FD_SET(s_resolver->upstream_sock, &read_fds);
+        int ret = select(max_sock + 1, &read_fds, NULL, NULL, &timeout);
+        if (ret > 0 && FD_ISSET(s_resolver->server_sock, &read_fds)) {
+            dns_resolver_handle_query();
+        }
+        if (ret > 0 && FD_ISSET(s_resolver->upstream_sock, &read_fds)) {
+            dns_resolver_handle_response();
+        }
+        dns_resolver_expire_pending();
+    }
+    for (uint8_t i = 0; i < DNS_RESOLVER_PENDING_NUM; i++) {
+        if (s_resolver->pending[i].used) {
+            dns_resolver_prefetch_done(s_resolver->pending[i].prefetch_key);
+        }
+    }
+    close(s_resolver->server_sock);
+    close(s_resolver->upstream_sock);
+    free(s_resolver);
+    s_resolver = NULL;
+    xSemaphoreGive(s_stopped_semaphore);
+    vTaskDelete(NULL);
+}
+
+static esp_err_t dns_resolver_get_upstream(uint32_t upstream, struct sockaddr_in6 *upstream_addr, uint8_t prefix[12])
+{
+    ip6_addr_t nat64_prefix = {};
+
+    ESP_RETURN_ON_ERROR(esp_openthread_get_nat64_prefix(&nat64_prefix), OT_EXT_CLI_TAG, "Cannot find NAT64 prefix");
+    memcpy(prefix, nat64_prefix.addr, 12);
+    memset(upstream_addr, 0, sizeof(*upstream_addr));
+    upstream_addr->sin6_family = AF_INET6;
+    upstream_addr->sin6_port = htons(DNS_RESOLVER_UPSTREAM_PORT);
+    memcpy(&upstream_addr->sin6_addr, prefix, 12);
+    memcpy((uint8_t *)&upstream_addr->sin6_addr + 12, &upstream, sizeof(upstream));
+    return ESP_OK;
+}
+
+esp_err_t esp_ot_dns_resolver_start(uint32_t upstream)
+{
+    esp_err_t ret = ESP_OK;
+    dns_resolver_t *resolver = NULL;
+    struct sockaddr_in6 listen_addr = {
+        .sin6_family = AF_INET6,
+        .sin6_port = htons(CONFIG_OPENTHREAD_DNS_CACHE_PORT),
+    };
+
+    ESP_RETURN_ON_ERROR(esp_ot_dns_cache_init(), OT_EXT_CLI_TAG, "Failed to init the DNS cache");
+    if (!s_mutex) {
+        s_mutex = xSemaphoreCreateMutex();
+        s_stopped_semaphore = xSemaphoreCreateBinary();
+        ESP_RETURN_ON_FALSE(s_mutex && s_stopped_semaphore, ESP_ERR_NO_MEM, OT_EXT_CLI_TAG,
+                            "Failed to create the DNS resolver semaphores");
+    }
+    if (s_running) {
+        /* Swap the upstream server in place, so the caller holding the OpenThread lock never waits for the task. */
+        struct sockaddr_in6 upstream_addr;
+        uint8_t prefix[sizeof(resolver->prefix)];
+        ESP_RETURN_ON_ERROR(dns_resolver_get_upstream(upstream, &upstream_addr, prefix), OT_EXT_CLI_TAG,
+                            "Invalid upstream server");
+        xSemaphoreTake(s_mutex, portMAX_DELAY);
+        s_resolver->upstream = upstream_addr;
+        memcpy(s_resolver->prefix, prefix, sizeof(prefix));
+        xSemaphoreGive(s_mutex);
+        return ESP_OK;
+    }
+
+    resolver = calloc(1, sizeof(dns_resolver_t));
+    ESP_RETURN_ON_FALSE(resolver, ESP_ERR_NO_MEM, OT_EXT_CLI_TAG, "Failed to allocate the DNS resolver");
+    resolver->server_sock = -1;
+    resolver->upstream_sock = -1;
+    ESP_GOTO_ON_ERROR(dns_resolver_get_upstream(upstream, &resolver->upstream, resolver->prefix), exit, OT_EXT_CLI_TAG,
+                      "Invalid upstream server");
+    resolver->server_sock = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+    resolver->upstream_sock = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+    ESP_GOTO_ON_FALSE(resolver->server_sock >= 0 && resolver->upstream_sock >= 0, ESP_FAIL, exit, OT_EXT_CLI_TAG,
+                      "Unable to create socket: errno %d", errno);
+    ESP_GOTO_ON_FALSE(bind(resolver->server_sock, (struct sockaddr *)&listen_addr, sizeof(listen_addr)) == 0, ESP_FAIL,
+                      exit, OT_EXT_CLI_TAG, "Socket unable to bind port %d: errno %d", CONFIG_OPENTHREAD_DNS_CACHE_PORT,
+                      errno);
+    s_resolver = resolver;
+    s_running = true;
+    ESP_GOTO_ON_FALSE(xTaskCreate(dns_resolver_task_worker, "ot_dns", DNS_RESOLVER_TASK_STACK_SIZE, NULL,
+                                  DNS_RESOLVER_TASK_PRIORITY, NULL) == pdPASS,
+                      ESP_FAIL, exit, OT_EXT_CLI_TAG, "Failed to create DNS resolver task");
+    return ESP_OK;
+
+exit:
+    s_running = false;
+    s_resolver = NULL;
+    if (resolver->server_sock >= 0) {
+        close(resolver->server_sock);
+    }
+    if (resolver->upstream_sock >= 0) {
+        close(resolver->upstream_sock);
+    }
+    free(resolver);
+    return ret;
+}
+
+void esp_ot_dns_resolver_stop(void)
+{
+    if (!s_running) {
+        return;
+    }
+    s_running = false;
+    xSemaphoreTake(s_stopped_semaphore, portMAX_DELAY);
+}
+
+bool esp_ot_dns_resolver_is_running(void)
+{
+    return s_running;
+}
+
+void esp_ot_dns_resolver_print_stats(void)
+{
+    esp_ot_dns_cache_stats_t stats;
+    uint32_t lookups = 0;
+
+    if (s_mutex) {
+        xSemaphoreTake(s_mutex, portMAX_DELAY);
+    }
+    esp_ot_dns_cache_get_stats(&stats);
+    if (s_mutex) {
+        xSemaphoreGive(s_mutex);
+    }
+    lookups = stats.hits + stats.misses;
+    otCliOutputFormat("resolver: %s, port %d\n", s_running ? "running" : "stopped", CONFIG_OPENTHREAD_DNS_CACHE_PORT);
+    otCliOutputFormat("entries: %u/%d\n", stats.entries, CONFIG_OPENTHREAD_DNS_CACHE_ENTRIES);
+    otCliOutputFormat("hits: %lu (negative %lu), misses: %lu, hit ratio: %lu%%\n", (unsigned long)stats.hits,
+                      (unsigned long)stats.negative_hits, (unsigned long)stats.misses,
+                      (unsigned long)(lookups ? (uint64_t)stats.hits * 100 / lookups : 0));
+    otCliOutputFormat("inserts: %lu, evictions: %lu, prefetches: %lu, synthesized: %lu\n", (unsigned long)stats.inserts,
+                      (unsigned long)stats.evictions, (unsigned long)stats.prefetches,
+                      (unsigned long)stats.synthesized);
+    otCliOutputFormat("upstream: %lu answered, %lu timeouts, latency avg %lu ms, max %lu ms\n",
+                      (unsigned long)stats.upstream_queries, (unsigned long)stats.upstream_timeouts,
+                      (unsigned long)stats.latency_avg_ms, (unsigned long)stats.latency_max_ms);
+}
+
+void esp_ot_dns_resolver_flush(void)
+{
+    if (s_mutex) {
+        xSemaphoreTake(s_mutex, portMAX_DELAY);
+    }
+    esp_ot_dns_cache_flush();
+    if (s_mutex) {
+        xSemaphoreGive(s_mutex);
+    }
+}
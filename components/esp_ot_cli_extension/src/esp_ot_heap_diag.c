@@ -7,13 +7,18 @@
 #include "esp_ot_heap_diag.h"
 #include "esp_check.h"
 #include "esp_heap_caps.h"
+#include "esp_idf_version.h"
 #if CONFIG_HEAP_TRACING
 #include "esp_heap_trace.h"
 #endif
 #include "esp_log.h"
 #include "esp_ot_cli_extension.h"
+#include "stdlib.h"
 #include "string.h"
 #include "openthread/cli.h"
+#if CONFIG_IDF_TARGET_LINUX
+#include <malloc.h>
+#endif
 
 #include "esp_heap_task_info.h"
 #include "freertos/FreeRTOS.h"
@@ -77,6 +82,313 @@ static void heap_trace_task_handler(void)
 }
 #endif // CONFIG_HEAP_TASK_TRACKING
 
+#if CONFIG_OPENTHREAD_HEAP_DIAG_SCOPE
+#define HEAP_SCOPE_MONITOR_SUPPORTED \
+    (!CONFIG_IDF_TARGET_LINUX && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 3, 0))
+
+typedef struct heap_scope_stats {
+    const char *name;
+    uint32_t calls;
+    uint32_t peak_calls; /* the calls whose peak was measured, the others ran alongside another scope */
+    size_t peak_max;
+    int32_t retained;
+} heap_scope_stats_t;
+
+static heap_scope_stats_t s_scope_stats[CONFIG_OPENTHREAD_HEAP_DIAG_SCOPE_MAX_NUM];
+static uint16_t s_scope_stats_num = 0;
+static bool s_scope_monitor_busy = false;
+static portMUX_TYPE s_scope_lock = portMUX_INITIALIZER_UNLOCKED;
+#endif // CONFIG_OPENTHREAD_HEAP_DIAG_SCOPE
+
+#define HEAP_SNAPSHOT_MAX_NUM 4
+#define HEAP_SNAPSHOT_NAME_MAX_LEN 16
+#define HEAP_SNAPSHOT_CALLERS_MAX_NUM 32
+
+typedef struct heap_snapshot_caller {
+    void *caller;
+    uint32_t count;
+    size_t bytes;
+} heap_snapshot_caller_t;
+
+typedef struct heap_snapshot {
+    char name[HEAP_SNAPSHOT_NAME_MAX_LEN];
+    TickType_t tick;
+    size_t used;
+#if CONFIG_HEAP_TRACING_STANDALONE
+    heap_snapshot_caller_t callers[HEAP_SNAPSHOT_CALLERS_MAX_NUM];
+    uint16_t callers_num;
+    heap_snapshot_caller_t callers_other;
+#endif
+#if CONFIG_OPENTHREAD_HEAP_DIAG_SCOPE
+    heap_scope_stats_t scopes[CONFIG_OPENTHREAD_HEAP_DIAG_SCOPE_MAX_NUM];
+    uint16_t scopes_num;
+#endif
+} heap_snapshot_t;
+
+static heap_snapshot_t *s_heap_snapshots[HEAP_SNAPSHOT_MAX_NUM];
+
+static size_t heap_get_used_size(void)
+{
+#if CONFIG_IDF_TARGET_LINUX
+    // The host build has no heap_caps accounting, use the allocator statistics of the C library instead.
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks;
+#else
+    return heap_caps_get_total_size(MALLOC_CAP_8BIT) - heap_caps_get_free_size(MALLOC_CAP_8BIT);
+#endif
+}
+
+#if CONFIG_OPENTHREAD_HEAP_DIAG_SCOPE
+static int heap_scope_stats_find(const heap_scope_stats_t *stats, uint16_t num, const char *name)
+{
+    for (uint16_t i = 0; i < num; i++) {
+        if (stats[i].name == name || strcmp(stats[i].name, name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void esp_ot_heap_scope_begin(esp_ot_heap_scope_t *scope, const char *name)
+{
+    scope->name = name;
+    scope->monitoring = false;
+    scope->free_at_begin = 0;
+#if HEAP_SCOPE_MONITOR_SUPPORTED
+    // Only one local minimum monitor can run at a time, the peak of concurrent scopes is not measured.
+    portENTER_CRITICAL(&s_scope_lock);
+    if (!s_scope_monitor_busy) {
+        s_scope_monitor_busy = true;
+        scope->monitoring = true;
+    }
+    portEXIT_CRITICAL(&s_scope_lock);
+    if (scope->monitoring && heap_caps_monitor_local_minimum_free_size_start() != ESP_OK) {
+        scope->monitoring = false;
+        portENTER_CRITICAL(&s_scope_lock);
+        s_scope_monitor_busy = false;
+        portEXIT_CRITICAL(&s_scope_lock);
+    }
+    if (scope->monitoring) {
+        // The monitor restarts the minimum free size from here, it is the baseline of the peak of this scope.
+        scope->free_at_begin = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    }
+#endif
+    scope->used_at_begin = heap_get_used_size();
+}
+
+void esp_ot_heap_scope_end(esp_ot_heap_scope_t *scope)
+{
+    size_t used_at_end = heap_get_used_size();
+    int32_t retained = (int32_t)used_at_end - (int32_t)scope->used_at_begin;
+    size_t peak = 0;
+
+#if HEAP_SCOPE_MONITOR_SUPPORTED
+    if (scope->monitoring) {
+        // Within the monitor, the minimum free size is the lowest one since the scope began.
+        size_t min_free = heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT);
+        heap_caps_monitor_local_minimum_free_size_stop();
+        peak = scope->free_at_begin > min_free ? scope->free_at_begin - min_free : 0;
+    }
+#endif
+
+    portENTER_CRITICAL(&s_scope_lock);
+    if (scope->monitoring) {
+        s_scope_monitor_busy = false;
+    }
+    int index = heap_scope_stats_find(s_scope_stats, s_scope_stats_num, scope->name);
+    heap_scope_stats_t *stats = index >= 0 ? &s_scope_stats[index] : NULL;
+    if (!stats && s_scope_stats_num < CONFIG_OPENTHREAD_HEAP_DIAG_SCOPE_MAX_NUM) {
+        stats = &s_scope_stats[s_scope_stats_num++];
+        stats->name = scope->name;
+        stats->calls = 0;
+        stats->peak_calls = 0;
+        stats->peak_max = 0;
+        stats->retained = 0;
+    }
+    if (stats) {
+        stats->calls++;
+        stats->retained += retained;
+        stats->peak_calls += scope->monitoring;
+        if (peak > stats->peak_max) {
+            stats->peak_max = peak;
+        }
+    }
+    portEXIT_CRITICAL(&s_scope_lock);
+}
+
+static void heap_scope_print_stats(const heap_scope_stats_t *stats, int32_t retained, uint32_t calls)
+{
+    if (stats->peak_calls) {
+        otCliOutputFormat("%s: +%u B peak, %+ld B retained, %lu calls\n", stats->name, (unsigned int)stats->peak_max,
+                          (long)retained, (unsigned long)calls);
+    } else {
+        otCliOutputFormat("%s: peak not measured, %+ld B retained, %lu calls\n", stats->name, (long)retained,
+                          (unsigned long)calls);
+    }
+}
+
+static void heap_scope_print(void)
+{
+    static heap_scope_stats_t s_stats[CONFIG_OPENTHREAD_HEAP_DIAG_SCOPE_MAX_NUM];
+    uint16_t num = 0;
+
+    portENTER_CRITICAL(&s_scope_lock);
+    num = s_scope_stats_num;
+    memcpy(s_stats, s_scope_stats, num * sizeof(heap_scope_stats_t));
+    portEXIT_CRITICAL(&s_scope_lock);
+
+    for (uint16_t i = 0; i < num; i++) {
+        heap_scope_print_stats(&s_stats[i], s_stats[i].retained, s_stats[i].calls);
+    }
+}
+
+static void heap_scope_reset(void)
+{
+    portENTER_CRITICAL(&s_scope_lock);
+    s_scope_stats_num = 0;
+    portEXIT_CRITICAL(&s_scope_lock);
+}
+#endif // CONFIG_OPENTHREAD_HEAP_DIAG_SCOPE
+
+#if CONFIG_HEAP_TRACING_STANDALONE
+static void heap_snapshot_collect_callers(heap_snapshot_t *snapshot)
+{
+    heap_trace_record_t record;
+    size_t count = heap_trace_get_count();
+
+    for (size_t i = 0; i < count; i++) {
+        if (heap_trace_get(i, &record) != ESP_OK || record.address == NULL) {
+            continue;
+        }
+#if CONFIG_HEAP_TRACING_STACK_DEPTH > 0
+        void *caller = record.alloced_by[0];
+#else
+        void *caller = NULL;
+#endif
+        heap_snapshot_caller_t *entry = NULL;
+        for (uint16_t j = 0; j < snapshot->callers_num; j++) {
+            if (snapshot->callers[j].caller == caller) {
+                entry = &snapshot->callers[j];
+                break;
+            }
+        }
+        if (!entry) {
+            entry = snapshot->callers_num < HEAP_SNAPSHOT_CALLERS_MAX_NUM ? &snapshot->callers[snapshot->callers_num++]
+                                                                          : &snapshot->callers_other;
+            entry->caller = entry == &snapshot->callers_other ? NULL : caller;
+        }
+        entry->count++;
+        entry->bytes += record.size;
+    }
+}
+
+static const heap_snapshot_caller_t *heap_snapshot_find_caller(const heap_snapshot_t *snapshot, void *caller)
+{
+    for (uint16_t i = 0; i < snapshot->callers_num; i++) {
+        if (snapshot->callers[i].caller == caller) {
+            return &snapshot->callers[i];
+        }
+    }
+    return NULL;
+}
+#endif // CONFIG_HEAP_TRACING_STANDALONE
+
+static heap_snapshot_t *heap_snapshot_find(const char *name)
+{
+    for (int i = 0; i < HEAP_SNAPSHOT_MAX_NUM; i++) {
+        if (s_heap_snapshots[i] && strcmp(s_heap_snapshots[i]->name, name) == 0) {
+            return s_heap_snapshots[i];
+        }
+    }
+    return NULL;
+}
+
+static otError heap_snapshot_take(const char *name)
+{
+    heap_snapshot_t *snapshot = heap_snapshot_find(name);
+
+    ESP_RETURN_ON_FALSE(strlen(name) < HEAP_SNAPSHOT_NAME_MAX_LEN, OT_ERROR_INVALID_ARGS, OT_EXT_CLI_TAG,
+                        "Snapshot name is too long");
+    if (!snapshot) {
+        int slot = 0;
+        for (int i = 0; i < HEAP_SNAPSHOT_MAX_NUM; i++) {
+            if (!s_heap_snapshots[i]) {
+                slot = i;
+                break;
+            }
+            if (s_heap_snapshots[i]->tick < s_heap_snapshots[slot]->tick) {
+                slot = i;
+            }
+        }
+        if (!s_heap_snapshots[slot]) {
+            s_heap_snapshots[slot] = (heap_snapshot_t *)malloc(sizeof(heap_snapshot_t));
+            ESP_RETURN_ON_FALSE(s_heap_snapshots[slot], OT_ERROR_NO_BUFS, OT_EXT_CLI_TAG,
+                                "Failed to allocate heap snapshot");
+        }
+        snapshot = s_heap_snapshots[slot];
+    }
+
+    memset(snapshot, 0, sizeof(heap_snapshot_t));
+    strlcpy(snapshot->name, name, sizeof(snapshot->name));
+    snapshot->tick = xTaskGetTickCount();
+#if CONFIG_HEAP_TRACING_STANDALONE
+    heap_snapshot_collect_callers(snapshot);
+#endif
+#if CONFIG_OPENTHREAD_HEAP_DIAG_SCOPE
+    portENTER_CRITICAL(&s_scope_lock);
+    snapshot->scopes_num = s_scope_stats_num;
+    memcpy(snapshot->scopes, s_scope_stats, s_scope_stats_num * sizeof(heap_scope_stats_t));
+    portEXIT_CRITICAL(&s_scope_lock);
+#endif
+    snapshot->used = heap_get_used_size();
+    otCliOutputFormat("snapshot %s: %u B in use\n", snapshot->name, (unsigned int)snapshot->used);
+    return OT_ERROR_NONE;
+}
+
+static otError heap_snapshot_diff(const char *name_a, const char *name_b)
+{
+    const heap_snapshot_t *a = heap_snapshot_find(name_a);
+    const heap_snapshot_t *b = heap_snapshot_find(name_b);
+
+    ESP_RETURN_ON_FALSE(a && b, OT_ERROR_NOT_FOUND, OT_EXT_CLI_TAG, "Heap snapshot not found");
+    otCliOutputFormat("%s -> %s: %+ld B in use, %lu ms\n", a->name, b->name, (long)b->used - (long)a->used,
+                      (unsigned long)pdTICKS_TO_MS(b->tick - a->tick));
+#if CONFIG_HEAP_TRACING_STANDALONE
+    otCliOutputFormat("---live allocations by caller---\n");
+    for (uint16_t i = 0; i < b->callers_num; i++) {
+        const heap_snapshot_caller_t *prev = heap_snapshot_find_caller(a, b->callers[i].caller);
+        long bytes = (long)b->callers[i].bytes - (prev ? (long)prev->bytes : 0);
+        long count = (long)b->callers[i].count - (prev ? (long)prev->count : 0);
+        if (bytes != 0 || count != 0) {
+            otCliOutputFormat("%p: %+ld B, %+ld blocks\n", b->callers[i].caller, bytes, count);
+        }
+    }
+    for (uint16_t i = 0; i < a->callers_num; i++) {
+        if (!heap_snapshot_find_caller(b, a->callers[i].caller)) {
+            otCliOutputFormat("%p: -%u B, -%lu blocks\n", a->callers[i].caller, (unsigned int)a->callers[i].bytes,
+                              (unsigned long)a->callers[i].count);
+        }
+    }
+    if (a->callers_other.count || b->callers_other.count) {
+        otCliOutputFormat("others: %+ld B, %+ld blocks\n",
+                          (long)b->callers_other.bytes - (long)a->callers_other.bytes,
+                          (long)b->callers_other.count - (long)a->callers_other.count);
+    }
+#endif // CONFIG_HEAP_TRACING_STANDALONE
+#if CONFIG_OPENTHREAD_HEAP_DIAG_SCOPE
+    otCliOutputFormat("---scopes---\n");
+    for (uint16_t i = 0; i < b->scopes_num; i++) {
+        int index = heap_scope_stats_find(a->scopes, a->scopes_num, b->scopes[i].name);
+        const heap_scope_stats_t *prev = index >= 0 ? &a->scopes[index] : NULL;
+        uint32_t calls = b->scopes[i].calls - (prev ? prev->calls : 0);
+        if (calls) {
+            heap_scope_print_stats(&b->scopes[i], b->scopes[i].retained - (prev ? prev->retained : 0), calls);
+        }
+    }
+#endif // CONFIG_OPENTHREAD_HEAP_DIAG_SCOPE
+    return OT_ERROR_NONE;
+}
+
 otError esp_ot_process_heap_diag(void *aContext, uint8_t aArgsLength, char *aArgs[])
 {
     (void)(aContext);
@@ -85,6 +397,12 @@ otError esp_ot_process_heap_diag(void *aContext, uint8_t aArgsLength, char *aArg
         otCliOutputFormat("print               : print current heap usage\n");
         otCliOutputFormat("daemon on <period> : start the daemon task to print heap usage per <period> ms\n");
         otCliOutputFormat("daemon off          : stop the daemon task for heap usage print\n");
+        otCliOutputFormat("snap <name>         : take a named snapshot of the live heap allocations\n");
+        otCliOutputFormat("diff <name> <name>  : print the difference between two heap snapshots\n");
+#if CONFIG_OPENTHREAD_HEAP_DIAG_SCOPE
+        otCliOutputFormat("scope               : print heap usage of each CLI command and REST handler\n");
+        otCliOutputFormat("scope reset         : reset the heap usage of scopes\n");
+#endif // CONFIG_OPENTHREAD_HEAP_DIAG_SCOPE
 #if CONFIG_HEAP_TRACING_STANDALONE
         otCliOutputFormat("tracereset          : reset the heap trace baseline\n");
         otCliOutputFormat("tracedump           : dump the last collected heap trace\n");
@@ -125,7 +443,24 @@ otError esp_ot_process_heap_diag(void *aContext, uint8_t aArgsLength, char *aArg
                     }
                 }
             }
+        } else if (strcmp(aArgs[0], "snap") == 0) {
+            ESP_RETURN_ON_FALSE(aArgsLength == 2, OT_ERROR_INVALID_ARGS, OT_EXT_CLI_TAG, "Invalid arguments");
+            return heap_snapshot_take(aArgs[1]);
+        } else if (strcmp(aArgs[0], "diff") == 0) {
+            ESP_RETURN_ON_FALSE(aArgsLength == 3, OT_ERROR_INVALID_ARGS, OT_EXT_CLI_TAG, "Invalid arguments");
+            return heap_snapshot_diff(aArgs[1], aArgs[2]);
+        }
+#if CONFIG_OPENTHREAD_HEAP_DIAG_SCOPE
+        else if (strcmp(aArgs[0], "scope") == 0) {
+            if (aArgsLength == 1) {
+                heap_scope_print();
+            } else if (aArgsLength == 2 && strcmp(aArgs[1], "reset") == 0) {
+                heap_scope_reset();
+            } else {
+                return OT_ERROR_INVALID_ARGS;
+            }
         }
+#endif // CONFIG_OPENTHREAD_HEAP_DIAG_SCOPE
 #if CONFIG_HEAP_TRACING_STANDALONE
         else if (strcmp(aArgs[0], "tracereset") == 0) {
             if (heap_trace_stop() != ESP_OK) {
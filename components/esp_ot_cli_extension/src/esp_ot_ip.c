@@ -11,6 +11,7 @@
 #include "esp_openthread_lock.h"
 #include "esp_openthread_netif_glue.h"
 #include "esp_ot_cli_extension.h"
+#include "esp_ot_ip_stats.h"
 #include "esp_ot_wifi_cmd.h"
 #include "stdlib.h"
 #include "string.h"
@@ -126,6 +127,9 @@ otError esp_ot_process_ip(void *aContext, uint8_t aArgsLength, char *aArgs[])
         otCliOutputFormat("print                    :     print all ip on each interface of lwip\n");
         otCliOutputFormat("add <ifname> <ifaddr>    :     add an address onto an interface of lwip\n");
         otCliOutputFormat("del <ifname> <ifaddr>    :     delete an address from an interface of lwip\n");
+#if CONFIG_OPENTHREAD_IP_STATS
+        otCliOutputFormat("stats [reset]            :     print or clear the forwarding statistics of lwip\n");
+#endif
     } else {
         if (strcmp(aArgs[0], "print") == 0) {
             print_ip_address();
@@ -147,6 +151,10 @@ otError esp_ot_process_ip(void *aContext, uint8_t aArgsLength, char *aArgs[])
             ip_event_add_ip6_t add_addr;
             inet6_aton(dest_addr, &add_addr.addr);
             esp_lwip_add_del_ip(&add_addr, aArgs[1], false);
+#if CONFIG_OPENTHREAD_IP_STATS
+        } else if (strcmp(aArgs[0], "stats") == 0) {
+            return esp_ot_ip_stats_process(aArgsLength - 1, &aArgs[1]);
+#endif
         } else {
             otCliOutputFormat("Invalid args\n");
             return OT_ERROR_INVALID_ARGS;
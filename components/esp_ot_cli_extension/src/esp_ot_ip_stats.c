@@ -0,0 +1,621 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_ot_ip_stats.h"
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "esp_check.h"
+#include "esp_cpu.h"
+#include "esp_event.h"
+#include "esp_log.h"
+#include "esp_netif_types.h"
+#include "esp_openthread_types.h"
+#include "esp_ot_cli_extension.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "lwip/netif.h"
+#include "lwip/prot/ethernet.h"
+#include "lwip/tcpip.h"
+#include "openthread/cli.h"
+
+/*
+ * The input, output and output_ip6 functions of each netif are replaced by wrappers counting the packets before
+ * calling the functions of the netif glue, so the counters see exactly what the glue hands to lwIP and what lwIP
+ * hands to the glue. Each core has its own copy of the counters, incremented by relaxed atomic additions, and the
+ * copies are summed when read.
+ *
+ * A packet forwarded by lwIP is matched at the egress with its ingress by a digest of its IP header without the
+ * fields changed by the forwarding, the hop limit, TTL and checksum. The ingress stamps are kept in a table indexed
+ * by the digest, each slot holding the digest, the ingress time and netif, so the match does not depend on the pbuf
+ * being kept or copied. A slot overwritten by another packet before the egress only loses a sample. The stamp of
+ * a unicast packet is consumed by its egress, the stamp of a multicast packet is kept for its other egress netifs.
+ */
+#define IP_STATS_STAMP_NUM 64
+#define IP_STATS_STAMP_NETIF_MASK 0x3   /* the ingress netif index in the low bits of the stamp time */
+#define IP_STATS_MAX_LATENCY_US 1000000 /* the stamps older than it are stale */
+#define IP_STATS_IP6_HEADER_SIZE 40
+#define IP_STATS_IP4_HEADER_SIZE 20
+#define IP_STATS_MCAST_ADDR_SIZE 16
+
+_Static_assert(ESP_OT_IP_STATS_MAX_NETIFS <= IP_STATS_STAMP_NETIF_MASK + 1, "netif index does not fit in stamp");
+
+typedef enum {
+    IP_STATS_RX_PACKETS = 0,
+    IP_STATS_RX_BYTES,
+    IP_STATS_RX_DROPS,
+    IP_STATS_TX_PACKETS,
+    IP_STATS_TX_BYTES,
+    IP_STATS_TX_DROPS,
+    IP_STATS_TX_FORWARDED,
+    IP_STATS_COUNTER_NUM,
+} ip_stats_counter_t;
+
+typedef struct ip_stats_netif {
+    struct netif *netif; /* NULL if the slot is free */
+    char name[3];
+    bool thread;
+    netif_input_fn input;
+#if LWIP_IPV4
+    netif_output_fn output;
+#endif
+    netif_output_ip6_fn output_ip6;
+    _Atomic uint32_t counters[portNUM_PROCESSORS][IP_STATS_COUNTER_NUM];
+} ip_stats_netif_t;
+
+typedef struct ip_stats_stamp {
+    _Atomic uint32_t digest; /* 0 if the slot is empty */
+    _Atomic uint32_t time;   /* the ingress time in us, the ingress netif index in the low bits */
+} ip_stats_stamp_t;
+
+typedef enum {
+    IP_STATS_MCAST_EMPTY = 0,
+    IP_STATS_MCAST_CLAIMED,
+    IP_STATS_MCAST_READY,
+} ip_stats_mcast_state_t;
+
+typedef struct ip_stats_mcast {
+    _Atomic uint32_t state;
+    uint8_t addr_len; /* 4 or 16 */
+    uint8_t addr[IP_STATS_MCAST_ADDR_SIZE];
+    _Atomic uint32_t packets[portNUM_PROCESSORS];
+    _Atomic uint32_t bytes[portNUM_PROCESSORS];
+} ip_stats_mcast_t;
+
+typedef struct ip_stats_core {
+    _Atomic uint32_t buckets[ESP_OT_IP_STATS_DIRECTIONS][ESP_OT_IP_STATS_LATENCY_BUCKETS];
+    _Atomic uint32_t max_us[ESP_OT_IP_STATS_DIRECTIONS];
+    _Atomic uint32_t mcast_other;
+} ip_stats_core_t;
+
+static const uint32_t s_bounds[ESP_OT_IP_STATS_LATENCY_BUCKETS] = {
+    100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000, ESP_OT_IP_STATS_NO_BOUND,
+};
+
+static ip_stats_netif_t s_netifs[ESP_OT_IP_STATS_MAX_NETIFS];
+static ip_stats_stamp_t s_stamps[IP_STATS_STAMP_NUM];
+static ip_stats_mcast_t s_mcast[CONFIG_OPENTHREAD_IP_STATS_MCAST_GROUPS];
+static ip_stats_core_t s_cores[portNUM_PROCESSORS];
+static _Atomic(esp_ot_ip_stats_tap_t) s_tap = NULL;
+static bool s_initialized = false;
+
+static inline void ip_stats_add(_Atomic uint32_t *counter, uint32_t value)
+{
+    atomic_fetch_add_explicit(counter, value, memory_order_relaxed);
+}
+
+static ip_stats_netif_t *ip_stats_find(const struct netif *netif)
+{
+    for (uint8_t i = 0; i < ESP_OT_IP_STATS_MAX_NETIFS; i++) {
+        if (s_netifs[i].netif == netif) {
+            return &s_netifs[i];
+        }
+    }
+    return NULL;
+}
+
+static inline uint32_t ip_stats_fnv(uint32_t hash, const uint8_t *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/*
+ * Compute the digest of the IP header at the offset of the first pbuf, 0 if it is not an IP header, e.g. an ARP
+ * frame after the Ethernet header. The multicast destination is copied into mcast_addr if it is not NULL.
+ */
+static uint32_t ip_stats_digest(const struct pbuf *p, uint16_t offset, uint8_t *mcast_addr, uint8_t *mcast_len)
+{
+    const uint8_t *hdr = (const uint8_t *)p->payload + offset;
+    uint32_t hash = 2166136261u;
+
+    if (p->len >= offset + IP_STATS_IP6_HEADER_SIZE && (hdr[0] >> 4) == 6) {
+        hash = ip_stats_fnv(hash, hdr, 7);      /* all up to the next header, the hop limit excluded */
+        hash = ip_stats_fnv(hash, hdr + 8, 32); /* the source and destination */
+        if (mcast_addr && hdr[24] == 0xff) {
+            memcpy(mcast_addr, hdr + 24, 16);
+            *mcast_len = 16;
+        }
+    } else if (p->len >= offset + IP_STATS_IP4_HEADER_SIZE && (hdr[0] >> 4) == 4) {
+        hash = ip_stats_fnv(hash, hdr, 8);      /* all up to the fragment offset, the TTL excluded */
+        hash = ip_stats_fnv(hash, hdr + 9, 1);  /* the protocol, the checksum excluded */
+        hash = ip_stats_fnv(hash, hdr + 12, 8); /* the source and destination */
+        if (mcast_addr && (hdr[16] & 0xf0) == 0xe0) {
+            memcpy(mcast_addr, hdr + 16, 4);
+            *mcast_len = 4;
+        }
+    } else {
+        return 0;
+    }
+    return hash ? hash : 1;
+}
+
+static void ip_stats_record_latency(esp_ot_ip_stats_direction_t direction, uint32_t latency_us, int core)
+{
+    uint8_t bucket = 0;
+
+    while (latency_us > s_bounds[bucket]) {
+        bucket++;
+    }
+    ip_stats_add(&s_cores[core].buckets[direction][bucket], 1);
+    uint32_t max_us = atomic_load_explicit(&s_cores[core].max_us[direction], memory_order_relaxed);
+    while (latency_us > max_us &&
+           !atomic_compare_exchange_weak_explicit(&s_cores[core].max_us[direction], &max_us, latency_us,
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+    }
+}
+
+static void ip_stats_record_mcast(const uint8_t *addr, uint8_t addr_len, uint32_t len, int core)
+{
+    for (uint8_t i = 0; i < CONFIG_OPENTHREAD_IP_STATS_MCAST_GROUPS; i++) {
+        ip_stats_mcast_t *mcast = &s_mcast[i];
+        if (atomic_load_explicit(&mcast->state, memory_order_acquire) == IP_STATS_MCAST_READY &&
+            mcast->addr_len == addr_len && memcmp(mcast->addr, addr, addr_len) == 0) {
+            ip_stats_add(&mcast->packets[core], 1);
+            ip_stats_add(&mcast->bytes[core], len);
+            return;
+        }
+    }
+    for (uint8_t i = 0; i < CONFIG_OPENTHREAD_IP_STATS_MCAST_GROUPS; i++) {
+        ip_stats_mcast_t *mcast = &s_mcast[i];
+        uint32_t state = IP_STATS_MCAST_EMPTY;
+        if (atomic_compare_exchange_strong_explicit(&mcast->state, &state, IP_STATS_MCAST_CLAIMED,
+                                                    memory_order_relaxed, memory_order_relaxed)) {
+            mcast->addr_len = addr_len;
+            memcpy(mcast->addr, addr, addr_len);
+            ip_stats_add(&mcast->packets[core], 1);
+            ip_stats_add(&mcast->bytes[core], len);
+            atomic_store_explicit(&mcast->state, IP_STATS_MCAST_READY, memory_order_release);
+            return;
+        }
+    }
+    ip_stats_add(&s_cores[core].mcast_other, 1);
+}
+
+static void ip_stats_ingress(const ip_stats_netif_t *slot, const struct pbuf *p, uint16_t l2_len, uint32_t now)
+{
+    uint32_t digest = ip_stats_digest(p, l2_len, NULL, NULL);
+
+    if (digest != 0) {
+        ip_stats_stamp_t *stamp = &s_stamps[digest % IP_STATS_STAMP_NUM];
+        uint32_t index = (uint32_t)(slot - s_netifs);
+        atomic_store_explicit(&stamp->time, (now & ~IP_STATS_STAMP_NETIF_MASK) | index, memory_order_relaxed);
+        atomic_store_explicit(&stamp->digest, digest, memory_order_release);
+    }
+}
+
+static void ip_stats_egress(ip_stats_netif_t *slot, const struct pbuf *p, int core)
+{
+    uint8_t mcast_addr[IP_STATS_MCAST_ADDR_SIZE];
+    uint8_t mcast_len = 0;
+    uint32_t digest = ip_stats_digest(p, 0, mcast_addr, &mcast_len);
+
+    if (digest == 0) {
+        return;
+    }
+    ip_stats_stamp_t *stamp = &s_stamps[digest % IP_STATS_STAMP_NUM];
+    uint32_t expected = digest;
+    if (atomic_load_explicit(&stamp->digest, memory_order_acquire) != digest) {
+        return;
+    }
+    uint32_t time = atomic_load_explicit(&stamp->time, memory_order_relaxed);
+    if (mcast_len == 0 && !atomic_compare_exchange_strong_explicit(&stamp->digest, &expected, 0,
+                                                                   memory_order_relaxed, memory_order_relaxed)) {
+        return;
+    }
+    const ip_stats_netif_t *ingress = &s_netifs[time & IP_STATS_STAMP_NETIF_MASK];
+    uint32_t latency_us = (uint32_t)esp_timer_get_time() - (time & ~IP_STATS_STAMP_NETIF_MASK);
+    if (ingress == slot || latency_us > IP_STATS_MAX_LATENCY_US) {
+        return;
+    }
+    ip_stats_add(&slot->counters[core][IP_STATS_TX_FORWARDED], 1);
+    if (ingress->thread != slot->thread) {
+        ip_stats_record_latency(ingress->thread ? ESP_OT_IP_STATS_THREAD_TO_BACKBONE
+                                                : ESP_OT_IP_STATS_BACKBONE_TO_THREAD,
+                                latency_us, core);
+    }
+    if (mcast_len != 0) {
+        ip_stats_record_mcast(mcast_addr, mcast_len, p->tot_len, core);
+    }
+}
+
+static inline void ip_stats_tap(const ip_stats_netif_t *slot, bool egress, const struct pbuf *p, uint16_t offset)
+{
+    esp_ot_ip_stats_tap_t tap = atomic_load_explicit(&s_tap, memory_order_acquire);
+
+    if (tap) {
+        tap((uint8_t)(slot - s_netifs), egress, p, offset);
+    }
+}
+
+static void ip_stats_count_tx(ip_stats_netif_t *slot, uint32_t len, err_t err, int core)
+{
+    if (err == ERR_OK) {
+        ip_stats_add(&slot->counters[core][IP_STATS_TX_PACKETS], 1);
+        ip_stats_add(&slot->counters[core][IP_STATS_TX_BYTES], len);
+    } else {
+        ip_stats_add(&slot->counters[core][IP_STATS_TX_DROPS], 1);
+    }
+}
+
+static err_t ip_stats_input(struct pbuf *p, struct netif *netif)
+{
+    ip_stats_netif_t *slot = ip_stats_find(netif);
+
+    if (slot == NULL) {
+        return ERR_IF;
+    }
+    /* The pbuf may be freed by another task once passed to lwIP, so it is only read before. */
+    uint16_t l2_len = (netif->flags & NETIF_FLAG_ETHERNET) && p->tot_len >= SIZEOF_ETH_HDR ? SIZEOF_ETH_HDR : 0;
+    uint32_t len = p->tot_len - l2_len;
+    ip_stats_ingress(slot, p, l2_len, (uint32_t)esp_timer_get_time());
+    ip_stats_tap(slot, false, p, l2_len);
+    err_t err = slot->input(p, netif);
+    int core = esp_cpu_get_core_id();
+    if (err == ERR_OK) {
+        ip_stats_add(&slot->counters[core][IP_STATS_RX_PACKETS], 1);
+        ip_stats_add(&slot->counters[core][IP_STATS_RX_BYTES], len);
+    } else {
+        ip_stats_add(&slot->counters[core][IP_STATS_RX_DROPS], 1);
+    }
+    return err;
+}
+
+#if LWIP_IPV4
+static err_t ip_stats_output(struct netif *netif, struct pbuf *p, const ip4_addr_t *ipaddr)
+{
+    ip_stats_netif_t *slot = ip_stats_find(netif);
+
+    if (slot == NULL) {
+        return ERR_IF;
+    }
+    int core = esp_cpu_get_core_id();
+    uint32_t len = p->tot_len;
+    ip_stats_egress(slot, p, core);
+    ip_stats_tap(slot, true, p, 0);
+    err_t err = slot->output(netif, p, ipaddr);
+    ip_stats_count_tx(slot, len, err, core);
+    return err;
+}
+#endif
+
+static err_t ip_stats_output_ip6(struct netif *netif, struct pbuf *p, const ip6_addr_t *ipaddr)
+{
+    ip_stats_netif_t *slot = ip_stats_find(netif);
+
+    if (slot == NULL) {
+        return ERR_IF;
+    }
+    int core = esp_cpu_get_core_id();
+    uint32_t len = p->tot_len;
+    ip_stats_egress(slot, p, core);
+    ip_stats_tap(slot, true, p, 0);
+    err_t err = slot->output_ip6(netif, p, ipaddr);
+    ip_stats_count_tx(slot, len, err, core);
+    return err;
+}
+
+static void ip_stats_clear_netif(ip_stats_netif_t *slot)
+{
+    for (uint8_t core = 0; core < portNUM_PROCESSORS; core++) {
+        for (uint8_t i = 0; i < IP_STATS_COUNTER_NUM; i++) {
+            atomic_store_explicit(&slot->counters[core][i], 0, memory_order_relaxed);
+        }
+    }
+}
+
+static bool ip_stats_netif_listed(const struct netif *target)
+{
+    struct netif *netif;
+
+    NETIF_FOREACH(netif)
+    {
+        if (netif == target) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Runs in the TCPIP context, so the netif list does not change meanwhile. */
+static void ip_stats_attach(void *ctx)
+{
+    struct netif *netif;
+
+    for (uint8_t i = 0; i < ESP_OT_IP_STATS_MAX_NETIFS; i++) {
+        if (s_netifs[i].netif && !ip_stats_netif_listed(s_netifs[i].netif)) {
+            s_netifs[i].netif = NULL;
+        }
+    }
+    NETIF_FOREACH(netif)
+    {
+        if ((netif->name[0] == 'l' && netif->name[1] == 'o') || netif->input == ip_stats_input) {
+            continue;
+        }
+        ip_stats_netif_t *slot = ip_stats_find(netif);
+        if (slot == NULL) {
+            slot = ip_stats_find(NULL);
+        }
+        if (slot == NULL) {
+            ESP_LOGW(OT_EXT_CLI_TAG, "No room to count netif %c%c", netif->name[0], netif->name[1]);
+            continue;
+        }
+        ip_stats_clear_netif(slot);
+        slot->name[0] = netif->name[0];
+        slot->name[1] = netif->name[1];
+        slot->name[2] = '\0';
+        slot->thread = netif->name[0] == 'o' && netif->name[1] == 't';
+        slot->input = netif->input;
+#if LWIP_IPV4
+        slot->output = netif->output;
+#endif
+        slot->output_ip6 = netif->output_ip6;
+        slot->netif = netif;
+        /* The wrappers may run on the other core as soon as they are installed. */
+        atomic_thread_fence(memory_order_release);
+        netif->input = ip_stats_input;
+#if LWIP_IPV4
+        if (slot->output) {
+            netif->output = ip_stats_output;
+        }
+#endif
+        if (slot->output_ip6) {
+            netif->output_ip6 = ip_stats_output_ip6;
+        }
+    }
+}
+
+static void ip_stats_event_handler(void *arg, esp_event_base_t base, int32_t event_id, void *event_data)
+{
+    if (tcpip_callback(ip_stats_attach, NULL) != ERR_OK) {
+        ESP_LOGW(OT_EXT_CLI_TAG, "Failed to count the new netifs");
+    }
+}
+
+esp_err_t esp_ot_ip_stats_init(void)
+{
+    if (s_initialized) {
+        return ESP_OK;
+    }
+    ESP_RETURN_ON_FALSE(esp_event_handler_register(IP_EVENT, ESP_EVENT_ANY_ID, ip_stats_event_handler, NULL) ==
+                                ESP_OK &&
+                            esp_event_handler_register(OPENTHREAD_EVENT, OPENTHREAD_EVENT_IF_UP,
+                                                       ip_stats_event_handler, NULL) == ESP_OK,
+                        ESP_FAIL, OT_EXT_CLI_TAG, "Failed to register the IP statistics event handlers");
+    s_initialized = true;
+    ip_stats_event_handler(NULL, IP_EVENT, 0, NULL);
+    return ESP_OK;
+}
+
+uint8_t esp_ot_ip_stats_get_netifs(esp_ot_ip_stats_netif_t *netifs, uint8_t max)
+{
+    uint8_t count = 0;
+
+    for (uint8_t i = 0; i < ESP_OT_IP_STATS_MAX_NETIFS && count < max; i++) {
+        const ip_stats_netif_t *slot = &s_netifs[i];
+        uint32_t sums[IP_STATS_COUNTER_NUM] = {0};
+        if (slot->netif == NULL) {
+            continue;
+        }
+        for (uint8_t core = 0; core < portNUM_PROCESSORS; core++) {
+            for (uint8_t j = 0; j < IP_STATS_COUNTER_NUM; j++) {
+                sums[j] += atomic_load_explicit(&slot->counters[core][j], memory_order_relaxed);
+            }
+        }
+        esp_ot_ip_stats_netif_t *netif = &netifs[count++];
+        memcpy(netif->name, slot->name, sizeof(netif->name));
+        netif->rx_packets = sums[IP_STATS_RX_PACKETS];
+        netif->rx_bytes = sums[IP_STATS_RX_BYTES];
+        netif->rx_drops = sums[IP_STATS_RX_DROPS];
+        netif->tx_packets = sums[IP_STATS_TX_PACKETS];
+        netif->tx_bytes = sums[IP_STATS_TX_BYTES];
+        netif->tx_drops = sums[IP_STATS_TX_DROPS];
+        netif->tx_forwarded = sums[IP_STATS_TX_FORWARDED];
+    }
+    return count;
+}
+
+void esp_ot_ip_stats_get_latency(esp_ot_ip_stats_direction_t direction, esp_ot_ip_stats_latency_t *latency)
+{
+    memset(latency, 0, sizeof(*latency));
+    for (uint8_t core = 0; core < portNUM_PROCESSORS; core++) {
+        for (uint8_t i = 0; i < ESP_OT_IP_STATS_LATENCY_BUCKETS; i++) {
+            uint32_t packets = atomic_load_explicit(&s_cores[core].buckets[direction][i], memory_order_relaxed);
+            latency->buckets[i] += packets;
+            latency->samples += packets;
+        }
+        uint32_t max_us = atomic_load_explicit(&s_cores[core].max_us[direction], memory_order_relaxed);
+        latency->max_us = max_us > latency->max_us ? max_us : latency->max_us;
+    }
+}
+
+uint8_t esp_ot_ip_stats_get_mcast_groups(esp_ot_ip_stats_mcast_group_t *groups, uint8_t max, uint32_t *other)
+{
+    uint8_t count = 0;
+
+    *other = 0;
+    for (uint8_t core = 0; core < portNUM_PROCESSORS; core++) {
+        *other += atomic_load_explicit(&s_cores[core].mcast_other, memory_order_relaxed);
+    }
+    for (uint8_t i = 0; i < CONFIG_OPENTHREAD_IP_STATS_MCAST_GROUPS && count < max; i++) {
+        const ip_stats_mcast_t *mcast = &s_mcast[i];
+        if (atomic_load_explicit(&mcast->state, memory_order_acquire) != IP_STATS_MCAST_READY) {
+            continue;
+        }
+        ip_addr_t addr;
+        memset(&addr, 0, sizeof(addr));
+        if (mcast->addr_len == 4) {
+            IP_SET_TYPE_VAL(addr, IPADDR_TYPE_V4);
+            memcpy(&ip_2_ip4(&addr)->addr, mcast->addr, 4);
+        } else {
+            IP_SET_TYPE_VAL(addr, IPADDR_TYPE_V6);
+            memcpy(ip_2_ip6(&addr)->addr, mcast->addr, 16);
+        }
+        /* Two cores seeing a new group at once may both claim a slot for it, their counts are merged here. */
+        esp_ot_ip_stats_mcast_group_t *group = NULL;
+        for (uint8_t j = 0; j < count; j++) {
+            if (memcmp(&groups[j].group, &addr, sizeof(addr)) == 0) {
+                group = &groups[j];
+                break;
+            }
+        }
+        if (group == NULL) {
+            group = &groups[count++];
+            memset(group, 0, sizeof(*group));
+            group->group = addr;
+        }
+        for (uint8_t core = 0; core < portNUM_PROCESSORS; core++) {
+            group->packets += atomic_load_explicit(&mcast->packets[core], memory_order_relaxed);
+            group->bytes += atomic_load_explicit(&mcast->bytes[core], memory_order_relaxed);
+        }
+    }
+    return count;
+}
+
+uint32_t esp_ot_ip_stats_bound(uint8_t bucket)
+{
+    return bucket < ESP_OT_IP_STATS_LATENCY_BUCKETS ? s_bounds[bucket] : ESP_OT_IP_STATS_NO_BOUND;
+}
+
+uint32_t esp_ot_ip_stats_percentile(const esp_ot_ip_stats_latency_t *latency, uint16_t permille)
+{
+    uint64_t target = ((uint64_t)latency->samples * permille + 999) / 1000;
+    uint64_t cumulated = 0;
+
+    if (latency->samples == 0) {
+        return 0;
+    }
+    for (uint8_t i = 0; i < ESP_OT_IP_STATS_LATENCY_BUCKETS; i++) {
+        cumulated += latency->buckets[i];
+        if (cumulated >= target) {
+            return s_bounds[i];
+        }
+    }
+    return ESP_OT_IP_STATS_NO_BOUND;
+}
+
+const char *esp_ot_ip_stats_direction_name(esp_ot_ip_stats_direction_t direction)
+{
+    switch (direction) {
+    case ESP_OT_IP_STATS_THREAD_TO_BACKBONE:
+        return "thread-to-backbone";
+    case ESP_OT_IP_STATS_BACKBONE_TO_THREAD:
+        return "backbone-to-thread";
+    default:
+        return "unknown";
+    }
+}
+
+void esp_ot_ip_stats_set_tap(esp_ot_ip_stats_tap_t tap)
+{
+    atomic_store_explicit(&s_tap, tap, memory_order_release);
+}
+
+const char *esp_ot_ip_stats_netif_name(uint8_t netif)
+{
+    return netif < ESP_OT_IP_STATS_MAX_NETIFS && s_netifs[netif].netif ? s_netifs[netif].name : NULL;
+}
+
+void esp_ot_ip_stats_reset(void)
+{
+    for (uint8_t i = 0; i < ESP_OT_IP_STATS_MAX_NETIFS; i++) {
+        ip_stats_clear_netif(&s_netifs[i]);
+    }
+    for (uint8_t core = 0; core < portNUM_PROCESSORS; core++) {
+        for (uint8_t dir = 0; dir < ESP_OT_IP_STATS_DIRECTIONS; dir++) {
+            for (uint8_t i = 0; i < ESP_OT_IP_STATS_LATENCY_BUCKETS; i++) {
+                atomic_store_explicit(&s_cores[core].buckets[dir][i], 0, memory_order_relaxed);
+            }
+            atomic_store_explicit(&s_cores[core].max_us[dir], 0, memory_order_relaxed);
+        }
+        atomic_store_explicit(&s_cores[core].mcast_other, 0, memory_order_relaxed);
+    }
+    for (uint8_t i = 0; i < CONFIG_OPENTHREAD_IP_STATS_MCAST_GROUPS; i++) {
+        for (uint8_t core = 0; core < portNUM_PROCESSORS; core++) {
+            atomic_store_explicit(&s_mcast[i].packets[core], 0, memory_order_relaxed);
+            atomic_store_explicit(&s_mcast[i].bytes[core], 0, memory_order_relaxed);
+        }
+        atomic_store_explicit(&s_mcast[i].state, IP_STATS_MCAST_EMPTY, memory_order_release);
+    }
+}
+
+static void ip_stats_print_latency(esp_ot_ip_stats_direction_t direction)
+{
+    esp_ot_ip_stats_latency_t latency;
+
+    esp_ot_ip_stats_get_latency(direction, &latency);
+    otCliOutputFormat("latency %s: %lu samples, p50 <= %lu us, p99 <= %lu us, max %lu us\n",
+                      esp_ot_ip_stats_direction_name(direction), (unsigned long)latency.samples,
+                      (unsigned long)esp_ot_ip_stats_percentile(&latency, 500),
+                      (unsigned long)esp_ot_ip_stats_percentile(&latency, 990), (unsigned long)latency.max_us);
+    for (uint8_t i = 0; i < ESP_OT_IP_STATS_LATENCY_BUCKETS && latency.samples; i++) {
+        if (s_bounds[i] == ESP_OT_IP_STATS_NO_BOUND) {
+            otCliOutputFormat("    > %lu us: %lu\n", (unsigned long)s_bounds[i - 1],
+                              (unsigned long)latency.buckets[i]);
+        } else {
+            otCliOutputFormat("    <= %lu us: %lu\n", (unsigned long)s_bounds[i], (unsigned long)latency.buckets[i]);
+        }
+    }
+}
+
+otError esp_ot_ip_stats_process(uint8_t aArgsLength, char *aArgs[])
+{
+    if (aArgsLength == 0) {
+        esp_ot_ip_stats_netif_t netifs[ESP_OT_IP_STATS_MAX_NETIFS];
+        esp_ot_ip_stats_mcast_group_t groups[CONFIG_OPENTHREAD_IP_STATS_MCAST_GROUPS];
+        uint32_t other = 0;
+        char addr[IPADDR_STRLEN_MAX];
+
+        uint8_t count = esp_ot_ip_stats_get_netifs(netifs, ESP_OT_IP_STATS_MAX_NETIFS);
+        for (uint8_t i = 0; i < count; i++) {
+            otCliOutputFormat("%s rx: %lu packets, %lu bytes, %lu drops\n", netifs[i].name,
+                              (unsigned long)netifs[i].rx_packets, (unsigned long)netifs[i].rx_bytes,
+                              (unsigned long)netifs[i].rx_drops);
+            otCliOutputFormat("%s tx: %lu packets, %lu bytes, %lu drops, %lu forwarded\n", netifs[i].name,
+                              (unsigned long)netifs[i].tx_packets, (unsigned long)netifs[i].tx_bytes,
+                              (unsigned long)netifs[i].tx_drops, (unsigned long)netifs[i].tx_forwarded);
+        }
+        for (uint8_t dir = 0; dir < ESP_OT_IP_STATS_DIRECTIONS; dir++) {
+            ip_stats_print_latency((esp_ot_ip_stats_direction_t)dir);
+        }
+        count = esp_ot_ip_stats_get_mcast_groups(groups, CONFIG_OPENTHREAD_IP_STATS_MCAST_GROUPS, &other);
+        for (uint8_t i = 0; i < count; i++) {
+            otCliOutputFormat("multicast %s: %lu packets, %lu bytes\n",
+                              ipaddr_ntoa_r(&groups[i].group, addr, sizeof(addr)), (unsigned long)groups[i].packets,
+                              (unsigned long)groups[i].bytes);
+        }
+        otCliOutputFormat("multicast other groups: %lu packets\n", (unsigned long)other);
+    } else if (strcmp(aArgs[0], "reset") == 0) {
+        esp_ot_ip_stats_reset();
+    } else {
+        return OT_ERROR_INVALID_ARGS;
+    }
+    return OT_ERROR_NONE;
+}
@@ -0,0 +1,442 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_ot_link_quality.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_check.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_openthread.h"
+#include "esp_openthread_lock.h"
+#include "esp_ot_cli_extension.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "openthread/cli.h"
+#include "openthread/thread.h"
+#include "openthread/thread_ftd.h"
+
+/*
+ * Each link keeps its last samples in a ring of bytes, a sample is the varint of the seconds since the previous
+ * sample followed by one byte of link quality in (2 bits), link quality out (2 bits) and route cost (4 bits), so
+ * 2 bytes for the samples less than 128 s apart. The older history is kept in 4-byte rollups of 1 minute,
+ * 15 minutes and 1 hour, which are updated by each sample.
+ *
+ * With the defaults a link takes 320 bytes, the 192 links of a 64-router mesh with 6 router neighbors per router
+ * take 61440 bytes.
+ */
+#define LINK_QUALITY_RAW_SIZE 48 /* bytes, at least ESP_OT_LINK_QUALITY_MAX_POINTS samples of 2 bytes */
+#define LINK_QUALITY_LEVEL_NUM 3
+#define LINK_QUALITY_NO_LINK 0xffff
+#define LINK_QUALITY_MAX_COST 15
+
+#define LINK_QUALITY_TASK_STACK_SIZE 3072
+#define LINK_QUALITY_TASK_PRIORITY 5
+
+#define LINK_QUALITY_PACK(in, out, cost) (((in) & 0x03) | (((out) & 0x03) << 2) | ((cost) << 4))
+#define LINK_QUALITY_IN(packed) ((packed) & 0x03)
+#define LINK_QUALITY_OUT(packed) (((packed) >> 2) & 0x03)
+#define LINK_QUALITY_COST(packed) ((packed) >> 4)
+
+typedef struct link_quality_level {
+    uint32_t period; /* seconds */
+    uint8_t size;    /* number of rollups */
+    uint8_t offset;  /* first rollup of the level in link_quality_series_t.rollups */
+} link_quality_level_t;
+
+static const link_quality_level_t s_levels[LINK_QUALITY_LEVEL_NUM] = {
+    {60, 15, 0},    /* ESP_OT_LINK_QUALITY_MINUTE */
+    {900, 16, 15},  /* ESP_OT_LINK_QUALITY_QUARTER */
+    {3600, 24, 31}, /* ESP_OT_LINK_QUALITY_HOUR */
+};
+#define LINK_QUALITY_ROLLUP_NUM 55
+
+typedef struct link_quality_rollup {
+    uint8_t count;  /* saturates at 255 */
+    uint8_t in_q6;  /* average link quality in multiplied by 64 */
+    uint8_t out_q6; /* average link quality out multiplied by 64 */
+    uint8_t min;    /* LINK_QUALITY_PACK(min in, min out, max cost) */
+} link_quality_rollup_t;
+
+typedef struct link_quality_accumulator {
+    uint32_t bucket; /* time / period of the open rollup */
+    uint16_t count;
+    uint16_t sum_in;
+    uint16_t sum_out;
+    uint8_t min;
+} link_quality_accumulator_t;
+
+typedef struct link_quality_series {
+    uint16_t router;    /* the lower RLOC16, LINK_QUALITY_NO_LINK for a free entry */
+    uint16_t neighbor;  /* the higher RLOC16 */
+    uint32_t head_time; /* time of the oldest raw sample */
+    uint32_t last_time; /* time of the newest raw sample */
+    uint8_t raw_head;
+    uint8_t raw_len;
+    uint8_t raw[LINK_QUALITY_RAW_SIZE];
+    link_quality_accumulator_t open[LINK_QUALITY_LEVEL_NUM];
+    link_quality_rollup_t rollups[LINK_QUALITY_ROLLUP_NUM];
+} link_quality_series_t;
+
+_Static_assert(sizeof(link_quality_series_t) == 320, "Update the memory budget in the Kconfig help and the README");
+
+static link_quality_series_t *s_series = NULL;
+static uint16_t s_series_count = 0;
+
+uint32_t esp_ot_link_quality_now(void)
+{
+    return (uint32_t)(esp_timer_get_time() / 1000000);
+}
+
+static uint8_t raw_get(const link_quality_series_t *series, uint8_t index)
+{
+    return series->raw[(series->raw_head + index) % LINK_QUALITY_RAW_SIZE];
+}
+
+/* Decode the sample at @param index of the raw ring, return the index of the next sample. */
+static uint8_t raw_decode(const link_quality_series_t *series, uint8_t index, uint32_t *delta, uint8_t *packed)
+{
+    uint8_t shift = 0;
+    uint8_t byte = 0;
+    *delta = 0;
+    do {
+        byte = raw_get(series, index++);
+        *delta |= (uint32_t)(byte & 0x7f) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+    *packed = raw_get(series, index++);
+    return index;
+}
+
+static void raw_drop_oldest(link_quality_series_t *series)
+{
+    uint32_t delta = 0;
+    uint8_t packed = 0;
+    uint8_t next = raw_decode(series, 0, &delta, &packed);
+
+    series->raw_head = (series->raw_head + next) % LINK_QUALITY_RAW_SIZE;
+    series->raw_len -= next;
+    if (series->raw_len) {
+        /* The delta of the new oldest sample gives its time. */
+        raw_decode(series, 0, &delta, &packed);
+        series->head_time += delta;
+    }
+}
+
+static void raw_append(link_quality_series_t *series, uint32_t time, uint8_t packed)
+{
+    uint8_t encoded[6];
+    uint8_t length = 0;
+    uint32_t delta = series->raw_len ? time - series->last_time : 0;
+
+    do {
+        encoded[length] = delta & 0x7f;
+        delta >>= 7;
+        encoded[length++] |= delta ? 0x80 : 0;
+    } while (delta);
+    encoded[length++] = packed;
+
+    while (series->raw_len && LINK_QUALITY_RAW_SIZE - series->raw_len < length) {
+        raw_drop_oldest(series);
+    }
+    if (series->raw_len == 0) {
+        series->head_time = time;
+    }
+    for (uint8_t i = 0; i < length; i++) {
+        series->raw[(series->raw_head + series->raw_len++) % LINK_QUALITY_RAW_SIZE] = encoded[i];
+    }
+    series->last_time = time;
+}
+
+static void rollup_add(link_quality_series_t *series, uint8_t level, uint32_t time, uint8_t packed)
+{
+    const link_quality_level_t *config = &s_levels[level];
+    link_quality_accumulator_t *open = &series->open[level];
+    link_quality_rollup_t *rollups = &series->rollups[config->offset];
+    uint32_t bucket = time / config->period;
+
+    if (open->count == 0 || bucket > open->bucket) {
+        /* Clear the rollups of the buckets without any sample since the open one. */
+        uint32_t skipped = open->count ? bucket - open->bucket : config->size;
+        for (uint32_t i = 1; i <= skipped && i <= config->size; i++) {
+            memset(&rollups[(bucket - skipped + i) % config->size], 0, sizeof(link_quality_rollup_t));
+        }
+        memset(open, 0, sizeof(link_quality_accumulator_t));
+        open->bucket = bucket;
+        open->min = LINK_QUALITY_PACK(3, 3, 0);
+    } else if (bucket < open->bucket) {
+        return;
+    }
+
+    uint8_t min_in = LINK_QUALITY_IN(open->min) < LINK_QUALITY_IN(packed) ? LINK_QUALITY_IN(open->min)
+                                                                            : LINK_QUALITY_IN(packed);
+    uint8_t min_out = LINK_QUALITY_OUT(open->min) < LINK_QUALITY_OUT(packed) ? LINK_QUALITY_OUT(open->min)
+                                                                               : LINK_QUALITY_OUT(packed);
+    uint8_t max_cost = LINK_QUALITY_COST(open->min) > LINK_QUALITY_COST(packed) ? LINK_QUALITY_COST(open->min)
+                                                                                 : LINK_QUALITY_COST(packed);
+    open->min = LINK_QUALITY_PACK(min_in, min_out, max_cost);
+    open->count++;
+    open->sum_in += LINK_QUALITY_IN(packed);
+    open->sum_out += LINK_QUALITY_OUT(packed);
+
+    link_quality_rollup_t *rollup = &rollups[bucket % config->size];
+    rollup->count = open->count > UINT8_MAX ? UINT8_MAX : open->count;
+    rollup->in_q6 = open->sum_in * 64 / open->count;
+    rollup->out_q6 = open->sum_out * 64 / open->count;
+    rollup->min = open->min;
+}
+
+static link_quality_series_t *series_find(uint16_t router, uint16_t neighbor, bool create)
+{
+    link_quality_series_t *free_entry = NULL;
+    link_quality_series_t *oldest = NULL;
+
+    for (uint16_t i = 0; i < CONFIG_OPENTHREAD_LINK_QUALITY_MAX_LINKS; i++) {
+        link_quality_series_t *series = &s_series[i];
+        if (series->router == router && series->neighbor == neighbor) {
+            return series;
+        }
+        if (series->router == LINK_QUALITY_NO_LINK) {
+            free_entry = free_entry ? free_entry : series;
+        } else if (!oldest || series->last_time < oldest->last_time) {
+            oldest = series;
+        }
+    }
+    if (!create) {
+        return NULL;
+    }
+    if (!free_entry) {
+        ESP_LOGD(OT_EXT_CLI_TAG, "Link quality of 0x%04x-0x%04x replaced", oldest->router, oldest->neighbor);
+        free_entry = oldest;
+    } else {
+        s_series_count++;
+    }
+    memset(free_entry, 0, sizeof(link_quality_series_t));
+    free_entry->router = router;
+    free_entry->neighbor = neighbor;
+    return free_entry;
+}
+
+esp_err_t esp_ot_link_quality_add_sample(uint16_t reporter, uint16_t neighbor, uint8_t link_quality_in,
+                                         uint8_t link_quality_out, uint8_t route_cost, uint32_t time)
+{
+    ESP_RETURN_ON_FALSE(s_series, ESP_ERR_INVALID_STATE, OT_EXT_CLI_TAG, "Link quality store is not initialized");
+    bool up = link_quality_in || link_quality_out;
+    /* A link is kept once, seen from its lower RLOC16. */
+    bool swap = neighbor < reporter;
+    link_quality_series_t *series = series_find(swap ? neighbor : reporter, swap ? reporter : neighbor, up);
+    if (!series) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    if (series->raw_len && time < series->last_time) {
+        time = series->last_time;
+    }
+    route_cost = route_cost > LINK_QUALITY_MAX_COST ? LINK_QUALITY_MAX_COST : route_cost;
+    uint8_t packed = swap ? LINK_QUALITY_PACK(link_quality_out, link_quality_in, route_cost)
+                          : LINK_QUALITY_PACK(link_quality_in, link_quality_out, route_cost);
+    raw_append(series, time, packed);
+    for (uint8_t level = 0; level < LINK_QUALITY_LEVEL_NUM; level++) {
+        rollup_add(series, level, time, packed);
+    }
+    return ESP_OK;
+}
+
+static uint16_t series_raw_points(const link_quality_series_t *series, uint32_t from, uint32_t to,
+                                  esp_ot_link_quality_point_t *points)
+{
+    uint16_t count = 0;
+    uint32_t time = series->head_time;
+    uint32_t delta = 0;
+    uint8_t packed = 0;
+
+    for (uint8_t index = 0; index < series->raw_len;) {
+        bool oldest = index == 0;
+        index = raw_decode(series, index, &delta, &packed);
+        /* The delta of the oldest sample is from a dropped one, its time is head_time. */
+        time += oldest ? 0 : delta;
+        if (time >= from && time <= to && count < ESP_OT_LINK_QUALITY_MAX_POINTS) {
+            esp_ot_link_quality_point_t *point = &points[count++];
+            point->time = time;
+            point->count = 1;
+            point->link_quality_in_x100 = LINK_QUALITY_IN(packed) * 100;
+            point->link_quality_out_x100 = LINK_QUALITY_OUT(packed) * 100;
+            point->min_link_quality_in = LINK_QUALITY_IN(packed);
+            point->min_link_quality_out = LINK_QUALITY_OUT(packed);
+            point->max_route_cost = LINK_QUALITY_COST(packed);
+        }
+    }
+    return count;
+}
+
+static uint16_t series_rollup_points(const link_quality_series_t *series, uint8_t level, uint32_t from, uint32_t to,
+                                     esp_ot_link_quality_point_t *points)
+{
+    const link_quality_level_t *config = &s_levels[level];
+    uint32_t last = series->open[level].bucket;
+    uint32_t first = last + 1 >= config->size ? last + 1 - config->size : 0;
+    uint16_t count = 0;
+
+    for (uint32_t bucket = first; bucket <= last; bucket++) {
+        const link_quality_rollup_t *rollup = &series->rollups[config->offset + bucket % config->size];
+        uint32_t time = bucket * config->period;
+        if (rollup->count == 0 || time + config->period <= from || time > to) {
+            continue;
+        }
+        esp_ot_link_quality_point_t *point = &points[count++];
+        point->time = time;
+        point->count = rollup->count;
+        point->link_quality_in_x100 = rollup->in_q6 * 100 / 64;
+        point->link_quality_out_x100 = rollup->out_q6 * 100 / 64;
+        point->min_link_quality_in = LINK_QUALITY_IN(rollup->min);
+        point->min_link_quality_out = LINK_QUALITY_OUT(rollup->min);
+        point->max_route_cost = LINK_QUALITY_COST(rollup->min);
+    }
+    return count;
+}
+
+void esp_ot_link_quality_query(uint32_t from, uint32_t to, uint16_t node, esp_ot_link_quality_callback_t callback,
+                               void *context)
+{
+    esp_ot_link_quality_point_t points[ESP_OT_LINK_QUALITY_MAX_POINTS];
+
+    for (uint16_t i = 0; s_series && i < CONFIG_OPENTHREAD_LINK_QUALITY_MAX_LINKS; i++) {
+        const link_quality_series_t *series = &s_series[i];
+        if (series->router == LINK_QUALITY_NO_LINK ||
+            (node != ESP_OT_LINK_QUALITY_ANY_NODE && series->router != node && series->neighbor != node)) {
+            continue;
+        }
+        /* The finest resolution which still covers the start of the range. */
+        esp_ot_link_quality_resolution_t resolution = ESP_OT_LINK_QUALITY_RAW;
+        while (resolution < ESP_OT_LINK_QUALITY_HOUR) {
+            uint32_t covered = resolution == ESP_OT_LINK_QUALITY_RAW ? series->head_time : 0;
+            if (resolution != ESP_OT_LINK_QUALITY_RAW) {
+                const link_quality_level_t *config = &s_levels[resolution - 1];
+                uint32_t last = series->open[resolution - 1].bucket;
+                covered = last + 1 >= config->size ? (last + 1 - config->size) * config->period : 0;
+            }
+            if (from >= covered) {
+                break;
+            }
+            resolution++;
+        }
+        uint16_t count = resolution == ESP_OT_LINK_QUALITY_RAW
+                             ? series_raw_points(series, from, to, points)
+                             : series_rollup_points(series, resolution - 1, from, to, points);
+        if (count) {
+            callback(series->router, series->neighbor, resolution, points, count, context);
+        }
+    }
+}
+
+void esp_ot_link_quality_get_usage(uint16_t *links, uint16_t *max_links, size_t *bytes)
+{
+    *links = s_series_count;
+    *max_links = CONFIG_OPENTHREAD_LINK_QUALITY_MAX_LINKS;
+    *bytes = s_series ? CONFIG_OPENTHREAD_LINK_QUALITY_MAX_LINKS * sizeof(link_quality_series_t) : 0;
+}
+
+static void link_quality_sample_worker(void *aContext)
+{
+    otRouterInfo router_info;
+
+    while (true) {
+        vTaskDelay(pdMS_TO_TICKS(CONFIG_OPENTHREAD_LINK_QUALITY_SAMPLE_INTERVAL * 1000));
+        esp_openthread_lock_acquire(portMAX_DELAY);
+        otInstance *instance = esp_openthread_get_instance();
+        otDeviceRole role = otThreadGetDeviceRole(instance);
+        if (role == OT_DEVICE_ROLE_ROUTER || role == OT_DEVICE_ROLE_LEADER) {
+            uint16_t self = otThreadGetRloc16(instance);
+            uint32_t now = esp_ot_link_quality_now();
+            for (uint8_t id = 0; id <= otThreadGetMaxRouterId(instance); id++) {
+                if (otThreadGetRouterInfo(instance, id, &router_info) != OT_ERROR_NONE ||
+                    router_info.mRloc16 == self) {
+                    continue;
+                }
+                esp_ot_link_quality_add_sample(self, router_info.mRloc16,
+                                               router_info.mLinkEstablished ? router_info.mLinkQualityIn : 0,
+                                               router_info.mLinkEstablished ? router_info.mLinkQualityOut : 0,
+                                               router_info.mPathCost, now);
+            }
+        }
+        esp_openthread_lock_release();
+    }
+}
+
+esp_err_t esp_ot_link_quality_init(void)
+{
+    size_t size = CONFIG_OPENTHREAD_LINK_QUALITY_MAX_LINKS * sizeof(link_quality_series_t);
+#if CONFIG_OPENTHREAD_LINK_QUALITY_IN_PSRAM
+    s_series = heap_caps_malloc(size, MALLOC_CAP_SPIRAM);
+#else
+    s_series = malloc(size);
+#endif
+    ESP_RETURN_ON_FALSE(s_series, ESP_ERR_NO_MEM, OT_EXT_CLI_TAG, "Failed to allocate the link quality store");
+    for (uint16_t i = 0; i < CONFIG_OPENTHREAD_LINK_QUALITY_MAX_LINKS; i++) {
+        s_series[i].router = LINK_QUALITY_NO_LINK;
+    }
+    s_series_count = 0;
+    if (xTaskCreate(link_quality_sample_worker, "ot_lq", LINK_QUALITY_TASK_STACK_SIZE, NULL,
+                    LINK_QUALITY_TASK_PRIORITY, NULL) != pdTRUE) {
+        ESP_LOGE(OT_EXT_CLI_TAG, "Failed to create link quality task");
+        free(s_series);
+        s_series = NULL;
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+const char *esp_ot_link_quality_resolution_to_string(esp_ot_link_quality_resolution_t resolution)
+{
+    static const char *s_names[] = {"raw", "1m", "15m", "1h"};
+    return resolution <= ESP_OT_LINK_QUALITY_HOUR ? s_names[resolution] : "unknown";
+}
+
+static void link_quality_print(uint16_t router, uint16_t neighbor, esp_ot_link_quality_resolution_t resolution,
+                               const esp_ot_link_quality_point_t *points, uint16_t count, void *context)
+{
+    (void)context;
+    otCliOutputFormat("0x%04x <-> 0x%04x (%s)\n", router, neighbor,
+                      esp_ot_link_quality_resolution_to_string(resolution));
+    for (uint16_t i = 0; i < count; i++) {
+        otCliOutputFormat("    %lu s: %u samples, in %u.%02u (min %u), out %u.%02u (min %u), cost %u\n",
+                          (unsigned long)points[i].time, points[i].count, points[i].link_quality_in_x100 / 100,
+                          points[i].link_quality_in_x100 % 100, points[i].min_link_quality_in,
+                          points[i].link_quality_out_x100 / 100, points[i].link_quality_out_x100 % 100,
+                          points[i].min_link_quality_out, points[i].max_route_cost);
+    }
+}
+
+otError esp_ot_process_link_quality(void *aContext, uint8_t aArgsLength, char *aArgs[])
+{
+    (void)aContext;
+    uint16_t links = 0;
+    uint16_t max_links = 0;
+    size_t bytes = 0;
+
+    if (aArgsLength == 0) {
+        esp_ot_link_quality_get_usage(&links, &max_links, &bytes);
+        otCliOutputFormat("links: %u/%u, memory: %u bytes, sample interval: %u s\n", links, max_links,
+                          (unsigned)bytes, CONFIG_OPENTHREAD_LINK_QUALITY_SAMPLE_INTERVAL);
+    } else if (strcmp(aArgs[0], "history") == 0) {
+        ESP_RETURN_ON_FALSE(aArgsLength >= 2 && aArgsLength <= 3, OT_ERROR_INVALID_ARGS, OT_EXT_CLI_TAG,
+                            "Invalid arguments");
+        char *end = NULL;
+        unsigned long seconds = strtoul(aArgs[1], &end, 10);
+        ESP_RETURN_ON_FALSE(*end == '\0', OT_ERROR_INVALID_ARGS, OT_EXT_CLI_TAG, "Invalid history length");
+        unsigned long node = aArgsLength == 3 ? strtoul(aArgs[2], &end, 16) : ESP_OT_LINK_QUALITY_ANY_NODE;
+        ESP_RETURN_ON_FALSE(*end == '\0' && node <= ESP_OT_LINK_QUALITY_ANY_NODE, OT_ERROR_INVALID_ARGS,
+                            OT_EXT_CLI_TAG, "Invalid RLOC16");
+        uint32_t now = esp_ot_link_quality_now();
+        esp_ot_link_quality_query(seconds < now ? now - seconds : 0, now, (uint16_t)node, link_quality_print, NULL);
+    } else {
+        return OT_ERROR_INVALID_ARGS;
+    }
+    return OT_ERROR_NONE;
+}
@@ -0,0 +1,433 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_ot_log_ringbuf.h"
+
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_check.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_ot_cli_extension.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "openthread/cli.h"
+
+#define LOG_RING_SIZE CONFIG_OPENTHREAD_LOG_RINGBUF_SIZE
+#define LOG_LINE_MAX CONFIG_OPENTHREAD_LOG_RINGBUF_LINE_MAX
+#define LOG_HISTORY_SIZE CONFIG_OPENTHREAD_LOG_RINGBUF_HISTORY_SIZE
+#define LOG_TAG_RATE_LIMIT CONFIG_OPENTHREAD_LOG_RINGBUF_TAG_RATE_LIMIT
+#define LOG_TAG_RATE_NUM 16
+#define LOG_TAG_MAX_LEN 16
+#define LOG_DRAIN_TASK_STACK_SIZE 3072
+#define LOG_DRAIN_TASK_PRIORITY 1
+#define LOG_DRAIN_PERIOD_MS 20
+#define LOG_CLI_CHUNK_SIZE 64
+
+_Static_assert((LOG_RING_SIZE & (LOG_RING_SIZE - 1)) == 0, "The log ring buffer size must be a power of two");
+
+/*
+ * Each record starts with a 32-bit header holding the payload length and the flags below, and is padded to 4 bytes.
+ * A producer reserves its record by moving the head with compare-and-swap, copies the payload and then publishes the
+ * header. The drain task consumes the committed records in order and zeroes them before moving the tail, so a
+ * reserved but unpublished header always reads as uncommitted. A record never wraps around the end of the ring, the
+ * space left at the end is filled by a skip record instead.
+ */
+#define LOG_RECORD_COMMITTED (1UL << 31)
+#define LOG_RECORD_SKIP (1UL << 30)
+#define LOG_RECORD_LEN_MASK 0x000FFFFFUL
+#define LOG_RECORD_ALIGN(len) (((len) + 3) & ~3UL)
+
+/*
+ * The per-tag rate limit is lock-free as well. A slot is owned by the FNV-1a hash of its tag, 0 being a free slot. A
+ * producer claims a free slot, or the slot whose window started the longest ago when the table is full, by swapping its
+ * hash with LOG_TAG_RATE_CLAIMING, and publishes the tag hash once the name is copied. The first producer seeing the
+ * one-second window of a slot expire moves the window with compare-and-swap and resets the count of the window. The
+ * lines of a slot being claimed are let through, and two tags of the same hash share a slot.
+ */
+#define LOG_TAG_RATE_CLAIMING UINT32_MAX
+
+typedef struct log_tag_rate {
+    _Atomic uint32_t hash;
+    _Atomic uint32_t window_start;
+    _Atomic uint32_t count;
+    _Atomic uint32_t dropped;
+    char tag[LOG_TAG_MAX_LEN];
+} log_tag_rate_t;
+
+static uint8_t *s_ring = NULL;
+static _Atomic uint32_t s_head = 0;
+static _Atomic uint32_t s_tail = 0;
+static _Atomic uint32_t s_written = 0;
+static _Atomic uint32_t s_dropped_full = 0;
+static _Atomic uint32_t s_dropped_rate = 0;
+static _Atomic uint32_t s_max_used = 0;
+static uint32_t s_drained = 0;
+#if CONFIG_OPENTHREAD_LOG_RINGBUF_BENCH
+static bool s_rate_limit_bypass = false;
+#endif
+static vprintf_like_t s_prev_vprintf = NULL;
+static TaskHandle_t s_drain_task = NULL;
+
+static log_tag_rate_t s_tag_rates[LOG_TAG_RATE_NUM];
+
+static char *s_history = NULL;
+static uint32_t s_history_pos = 0;
+static bool s_history_wrapped = false;
+static SemaphoreHandle_t s_history_mutex = NULL;
+
+static inline _Atomic uint32_t *log_record_header(uint32_t pos)
+{
+    return (_Atomic uint32_t *)&s_ring[pos & (LOG_RING_SIZE - 1)];
+}
+
+static bool log_ring_write(const char *data, uint32_t len)
+{
+    uint32_t need = sizeof(uint32_t) + LOG_RECORD_ALIGN(len);
+    uint32_t head = atomic_load_explicit(&s_head, memory_order_relaxed);
+    uint32_t pad = 0;
+    uint32_t used = 0;
+
+    do {
+        uint32_t offset = head & (LOG_RING_SIZE - 1);
+        pad = offset + need > LOG_RING_SIZE ? LOG_RING_SIZE - offset : 0;
+        used = head + pad + need - atomic_load_explicit(&s_tail, memory_order_acquire);
+        if (used > LOG_RING_SIZE) {
+            return false;
+        }
+    } while (!atomic_compare_exchange_weak_explicit(&s_head, &head, head + pad + need, memory_order_acq_rel,
+                                                    memory_order_relaxed));
+
+    if (pad) {
+        atomic_store_explicit(log_record_header(head), LOG_RECORD_COMMITTED | LOG_RECORD_SKIP | pad,
+                              memory_order_release);
+        head += pad;
+    }
+    memcpy(&s_ring[(head & (LOG_RING_SIZE - 1)) + sizeof(uint32_t)], data, len);
+    atomic_store_explicit(log_record_header(head), LOG_RECORD_COMMITTED | len, memory_order_release);
+
+    uint32_t max_used = atomic_load_explicit(&s_max_used, memory_order_relaxed);
+    while (used > max_used &&
+           !atomic_compare_exchange_weak_explicit(&s_max_used, &max_used, used, memory_order_relaxed,
+                                                  memory_order_relaxed)) {
+    }
+    return true;
+}
+
+static uint32_t log_ring_read(char *out)
+{
+    while (true) {
+        uint32_t tail = atomic_load_explicit(&s_tail, memory_order_relaxed);
+        if (tail == atomic_load_explicit(&s_head, memory_order_acquire)) {
+            return 0;
+        }
+        uint32_t header = atomic_load_explicit(log_record_header(tail), memory_order_acquire);
+        if (!(header & LOG_RECORD_COMMITTED)) {
+            // Reserved by a producer which has not finished writing yet.
+            return 0;
+        }
+        uint32_t len = header & LOG_RECORD_LEN_MASK;
+        uint32_t offset = tail & (LOG_RING_SIZE - 1);
+        uint32_t size = (header & LOG_RECORD_SKIP) ? len : sizeof(uint32_t) + LOG_RECORD_ALIGN(len);
+        if (!(header & LOG_RECORD_SKIP)) {
+            memcpy(out, &s_ring[offset + sizeof(uint32_t)], len);
+        }
+        memset(&s_ring[offset], 0, size);
+        atomic_store_explicit(&s_tail, tail + size, memory_order_release);
+        if (!(header & LOG_RECORD_SKIP)) {
+            return len;
+        }
+    }
+}
+
+static bool log_extract_tag(const char *line, char *tag)
+{
+    // The esp_log lines look like "I (1234) tag: message", optionally wrapped by color codes.
+    const char *start = strstr(line, ") ");
+    if (!start) {
+        return false;
+    }
+    start += 2;
+    const char *end = strchr(start, ':');
+    if (!end || end - start >= LOG_TAG_MAX_LEN) {
+        return false;
+    }
+    memcpy(tag, start, end - start);
+    tag[end - start] = '\0';
+    return true;
+}
+
+static uint32_t log_tag_hash(const char *tag)
+{
+    uint32_t hash = 2166136261UL;
+
+    while (*tag) {
+        hash = (hash ^ (uint8_t)*tag++) * 16777619UL;
+    }
+    return hash == 0 || hash == LOG_TAG_RATE_CLAIMING ? 1 : hash;
+}
+
+static log_tag_rate_t *log_rate_claim(const char *tag, uint32_t hash, uint32_t now)
+{
+    log_tag_rate_t *rate = NULL;
+    uint32_t rate_hash = 0;
+
+    for (int i = 0; i < LOG_TAG_RATE_NUM; i++) {
+        uint32_t slot_hash = atomic_load_explicit(&s_tag_rates[i].hash, memory_order_relaxed);
+        if (slot_hash == LOG_TAG_RATE_CLAIMING) {
+            continue;
+        }
+        if (slot_hash == 0 ||
+            !rate || now - atomic_load_explicit(&s_tag_rates[i].window_start, memory_order_relaxed) >
+                         now - atomic_load_explicit(&rate->window_start, memory_order_relaxed)) {
+            rate = &s_tag_rates[i];
+            rate_hash = slot_hash;
+        }
+        if (slot_hash == 0) {
+            break;
+        }
+    }
+    if (!rate || !atomic_compare_exchange_strong(&rate->hash, &rate_hash, LOG_TAG_RATE_CLAIMING)) {
+        return NULL;
+    }
+    strlcpy(rate->tag, tag, sizeof(rate->tag));
+    atomic_store_explicit(&rate->window_start, now, memory_order_relaxed);
+    atomic_store_explicit(&rate->count, 0, memory_order_relaxed);
+    atomic_store_explicit(&rate->dropped, 0, memory_order_relaxed);
+    atomic_store_explicit(&rate->hash, hash, memory_order_release);
+    return rate;
+}
+
+static bool log_rate_allow(const char *line)
+{
+    char tag[LOG_TAG_MAX_LEN];
+    log_tag_rate_t *rate = NULL;
+
+#if CONFIG_OPENTHREAD_LOG_RINGBUF_BENCH
+    if (s_rate_limit_bypass) {
+        return true;
+    }
+#endif
+    if (!log_extract_tag(line, tag)) {
+        return true;
+    }
+
+    uint32_t hash = log_tag_hash(tag);
+    uint32_t now = xTaskGetTickCount();
+    for (int i = 0; i < LOG_TAG_RATE_NUM && !rate; i++) {
+        if (atomic_load_explicit(&s_tag_rates[i].hash, memory_order_acquire) == hash) {
+            rate = &s_tag_rates[i];
+        }
+    }
+    if (!rate && !(rate = log_rate_claim(tag, hash, now))) {
+        return true;
+    }
+
+    uint32_t window_start = atomic_load_explicit(&rate->window_start, memory_order_relaxed);
+    if (now - window_start >= pdMS_TO_TICKS(1000) &&
+        atomic_compare_exchange_strong(&rate->window_start, &window_start, now)) {
+        atomic_store_explicit(&rate->count, 0, memory_order_relaxed);
+    }
+    if (atomic_fetch_add_explicit(&rate->count, 1, memory_order_relaxed) >= LOG_TAG_RATE_LIMIT) {
+        atomic_fetch_add_explicit(&rate->dropped, 1, memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+static int log_ringbuf_vprintf(const char *fmt, va_list args)
+{
+    char line[LOG_LINE_MAX];
+    int len = vsnprintf(line, sizeof(line), fmt, args);
+
+    if (len <= 0) {
+        return len;
+    }
+    if ((size_t)len >= sizeof(line)) {
+        len = sizeof(line) - 1;
+        line[len - 1] = '\n';
+    }
+    if (!log_rate_allow(line)) {
+        atomic_fetch_add_explicit(&s_dropped_rate, 1, memory_order_relaxed);
+    } else if (log_ring_write(line, len)) {
+        atomic_fetch_add_explicit(&s_written, 1, memory_order_relaxed);
+    } else {
+        atomic_fetch_add_explicit(&s_dropped_full, 1, memory_order_relaxed);
+    }
+    return len;
+}
+
+static int log_output(const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    int ret = s_prev_vprintf(fmt, args);
+    va_end(args);
+    return ret;
+}
+
+static void log_history_append(const char *data, uint32_t len)
+{
+    xSemaphoreTake(s_history_mutex, portMAX_DELAY);
+    for (uint32_t i = 0; i < len; i++) {
+        s_history[s_history_pos++] = data[i];
+        if (s_history_pos == LOG_HISTORY_SIZE) {
+            s_history_pos = 0;
+            s_history_wrapped = true;
+        }
+    }
+    xSemaphoreGive(s_history_mutex);
+}
+
+static void log_drain_task_worker(void *aContext)
+{
+    static char s_line[LOG_LINE_MAX + 1];
+    uint32_t reported_drops = 0;
+
+    while (true) {
+        uint32_t len = 0;
+        while ((len = log_ring_read(s_line)) > 0) {
+            s_line[len] = '\0';
+            log_output("%s", s_line);
+            log_history_append(s_line, len);
+            s_drained++;
+        }
+        uint32_t drops = atomic_load_explicit(&s_dropped_full, memory_order_relaxed);
+        if (drops != reported_drops) {
+            log_output("W (%lu) %s: %lu log lines dropped, ring buffer full\n", (unsigned long)esp_log_timestamp(),
+                       OT_EXT_CLI_TAG, (unsigned long)(drops - reported_drops));
+            reported_drops = drops;
+        }
+        vTaskDelay(pdMS_TO_TICKS(LOG_DRAIN_PERIOD_MS));
+    }
+}
+
+void esp_ot_log_ringbuf_print_history(uint32_t lines)
+{
+    char chunk[LOG_CLI_CHUNK_SIZE];
+    uint32_t total = 0;
+    uint32_t start = 0;
+
+    ESP_RETURN_ON_FALSE(s_history_mutex, , OT_EXT_CLI_TAG, "Deferred log backend is not initialized");
+    xSemaphoreTake(s_history_mutex, portMAX_DELAY);
+    total = s_history_wrapped ? LOG_HISTORY_SIZE : s_history_pos;
+    start = s_history_wrapped ? s_history_pos : 0;
+    if (lines) {
+        // Walk backwards to the beginning of the requested number of lines, the last byte ends the last line.
+        uint32_t skip = total;
+        uint32_t found = 0;
+        while (skip > 0) {
+            if (s_history[(start + skip - 1) % LOG_HISTORY_SIZE] == '\n' && skip != total && ++found == lines) {
+                break;
+            }
+            skip--;
+        }
+        start = (start + skip) % LOG_HISTORY_SIZE;
+        total -= skip;
+    }
+    while (total) {
+        uint32_t n = 0;
+        while (n < sizeof(chunk) && n < total) {
+            chunk[n++] = s_history[start];
+            start = (start + 1) % LOG_HISTORY_SIZE;
+        }
+        otCliOutputFormat("%.*s", (int)n, chunk);
+        total -= n;
+    }
+    xSemaphoreGive(s_history_mutex);
+}
+
+void esp_ot_log_ringbuf_print_stats(void)
+{
+    otCliOutputFormat("ring buffer: %lu bytes, %lu in use, %lu max\n", (unsigned long)LOG_RING_SIZE,
+                      (unsigned long)(atomic_load(&s_head) - atomic_load(&s_tail)),
+                      (unsigned long)atomic_load(&s_max_used));
+    otCliOutputFormat("written: %lu\n", (unsigned long)atomic_load(&s_written));
+    otCliOutputFormat("drained: %lu\n", (unsigned long)s_drained);
+    otCliOutputFormat("dropped (full): %lu\n", (unsigned long)atomic_load(&s_dropped_full));
+    otCliOutputFormat("dropped (rate limit): %lu\n", (unsigned long)atomic_load(&s_dropped_rate));
+    for (int i = 0; i < LOG_TAG_RATE_NUM; i++) {
+        char tag[LOG_TAG_MAX_LEN];
+        uint32_t hash = atomic_load_explicit(&s_tag_rates[i].hash, memory_order_acquire);
+        uint32_t dropped = atomic_load_explicit(&s_tag_rates[i].dropped, memory_order_relaxed);
+        strlcpy(tag, s_tag_rates[i].tag, sizeof(tag));
+        // Skip the slot if it was claimed by another tag while being read.
+        if (dropped && hash != 0 && hash != LOG_TAG_RATE_CLAIMING &&
+            atomic_load_explicit(&s_tag_rates[i].hash, memory_order_acquire) == hash) {
+            otCliOutputFormat("    %s: %lu dropped\n", tag, (unsigned long)dropped);
+        }
+    }
+}
+
+#if CONFIG_OPENTHREAD_LOG_RINGBUF_BENCH
+#define LOG_BENCH_TAG "log_bench"
+
+void esp_ot_log_ringbuf_bench(uint32_t count)
+{
+    ESP_RETURN_ON_FALSE(s_prev_vprintf && count > 0, , OT_EXT_CLI_TAG, "Invalid state or count");
+    uint32_t dropped = atomic_load(&s_dropped_full);
+
+    esp_log_set_vprintf(s_prev_vprintf);
+    int64_t start = esp_timer_get_time();
+    for (uint32_t i = 0; i < count; i++) {
+        ESP_LOGI(LOG_BENCH_TAG, "direct %lu", (unsigned long)i);
+    }
+    int64_t direct = esp_timer_get_time() - start;
+    esp_log_set_vprintf(log_ringbuf_vprintf);
+
+    s_rate_limit_bypass = true;
+    start = esp_timer_get_time();
+    for (uint32_t i = 0; i < count; i++) {
+        ESP_LOGI(LOG_BENCH_TAG, "deferred %lu", (unsigned long)i);
+    }
+    int64_t deferred = esp_timer_get_time() - start;
+    s_rate_limit_bypass = false;
+
+    otCliOutputFormat("direct: %lu us per call\n", (unsigned long)(direct / count));
+    otCliOutputFormat("deferred: %lu us per call, %lu dropped\n", (unsigned long)(deferred / count),
+                      (unsigned long)(atomic_load(&s_dropped_full) - dropped));
+}
+#endif // CONFIG_OPENTHREAD_LOG_RINGBUF_BENCH
+
+esp_err_t esp_ot_log_ringbuf_init(void)
+{
+    esp_err_t ret = ESP_OK;
+#if CONFIG_OPENTHREAD_LOG_RINGBUF_IN_PSRAM
+    uint32_t caps = MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT;
+#else
+    uint32_t caps = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+#endif
+
+    ESP_RETURN_ON_FALSE(!s_ring, ESP_ERR_INVALID_STATE, OT_EXT_CLI_TAG, "Deferred log backend is already installed");
+    s_ring = (uint8_t *)heap_caps_calloc(1, LOG_RING_SIZE, caps);
+    s_history = (char *)heap_caps_malloc(LOG_HISTORY_SIZE, caps);
+    s_history_mutex = xSemaphoreCreateMutex();
+    ESP_GOTO_ON_FALSE(s_ring && s_history && s_history_mutex, ESP_ERR_NO_MEM, exit, OT_EXT_CLI_TAG,
+                      "Failed to allocate deferred log buffers");
+    ESP_GOTO_ON_FALSE(xTaskCreate(log_drain_task_worker, "log_drain", LOG_DRAIN_TASK_STACK_SIZE, NULL,
+                                  LOG_DRAIN_TASK_PRIORITY, &s_drain_task) == pdTRUE,
+                      ESP_FAIL, exit, OT_EXT_CLI_TAG, "Failed to create log drain task");
+    s_prev_vprintf = esp_log_set_vprintf(log_ringbuf_vprintf);
+    return ESP_OK;
+
+exit:
+    free(s_ring);
+    free(s_history);
+    if (s_history_mutex) {
+        vSemaphoreDelete(s_history_mutex);
+    }
+    s_ring = NULL;
+    s_history = NULL;
+    s_history_mutex = NULL;
+    return ret;
+}
@@ -9,6 +9,9 @@
 #include "esp_err.h"
 #include "esp_log.h"
 #include "esp_ot_cli_extension.h"
+#if CONFIG_OPENTHREAD_LOG_RINGBUF
+#include "esp_ot_log_ringbuf.h"
+#endif
 #include "string.h"
 #include <stdlib.h>
 #include "openthread/cli.h"
@@ -31,10 +34,21 @@ otError esp_ot_process_logset(void *aContext, uint8_t aArgsLength, char *aArgs[]
     if (aArgsLength == 0) {
         otCliOutputFormat("---loglevel---\n");
         otCliOutputFormat("set <TAG> <level>                :       set log level of the <TAG> to <level>\n");
+#if CONFIG_OPENTHREAD_LOG_RINGBUF
+        otCliOutputFormat("dump                             :       print the history of the deferred log\n");
+        otCliOutputFormat("tail [lines]                     :       print the latest [lines] of the deferred log\n");
+        otCliOutputFormat("stats                            :       print the counters of the deferred log\n");
+#endif
+#if CONFIG_OPENTHREAD_LOG_RINGBUF_BENCH
+        otCliOutputFormat("bench [count]                    :       measure the cost of ESP_LOGI per call\n");
+#endif
         otCliOutputFormat("---example---\n");
         otCliOutputFormat("loglevel set * 3                 :       set log level of all the tags to INFO\n");
         otCliOutputFormat("loglevel set OPENTHREAD 0        :       set log level of OpenThread to None\n");
         otCliOutputFormat("loglevel set wifi 4              :       set log level of Wi-Fi to DEBUG\n");
+#if CONFIG_OPENTHREAD_LOG_RINGBUF
+        otCliOutputFormat("loglevel tail 20                 :       print the latest 20 lines of the deferred log\n");
+#endif
         otCliOutputFormat("----Note----\n");
         otCliOutputFormat(
             "Support 6 levels         :       0(NONE), 1(ERROR), 2(WARN), 3(INFO), 4(DEBUG), 5(VERBOSE)\n");
@@ -45,7 +59,27 @@ otError esp_ot_process_logset(void *aContext, uint8_t aArgsLength, char *aArgs[]
         if (strcmp(aArgs[0], "set") == 0 && aArgsLength == 3) {
             ESP_RETURN_ON_FALSE(ext_loglevel_set(aArgs[1], aArgs[2]) == ESP_OK, OT_ERROR_INVALID_ARGS, OT_EXT_CLI_TAG,
                                 "Failed to set log level");
-        } else {
+        }
+#if CONFIG_OPENTHREAD_LOG_RINGBUF
+        else if (strcmp(aArgs[0], "dump") == 0) {
+            esp_ot_log_ringbuf_print_history(0);
+        } else if (strcmp(aArgs[0], "tail") == 0) {
+            int lines = aArgsLength > 1 ? atoi(aArgs[1]) : 10;
+            ESP_RETURN_ON_FALSE(lines > 0, OT_ERROR_INVALID_ARGS, OT_EXT_CLI_TAG, "Invalid number of lines");
+            esp_ot_log_ringbuf_print_history((uint32_t)lines);
+        } else if (strcmp(aArgs[0], "stats") == 0) {
+            esp_ot_log_ringbuf_print_stats();
+        }
+#endif
+#if CONFIG_OPENTHREAD_LOG_RINGBUF_BENCH
+        else if (strcmp(aArgs[0], "bench") == 0) {
+            int count = aArgsLength > 1 ? atoi(aArgs[1]) : 100;
+            ESP_RETURN_ON_FALSE(count > 0 && count <= 1000, OT_ERROR_INVALID_ARGS, OT_EXT_CLI_TAG,
+                                "Invalid count, should be in 1-1000");
+            esp_ot_log_ringbuf_bench((uint32_t)count);
+        }
+#endif
+        else {
             return OT_ERROR_INVALID_ARGS;
         }
     }
@@ -0,0 +1,474 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_ot_mac_counters.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_check.h"
+#include "esp_log.h"
+#include "esp_openthread.h"
+#include "esp_ot_cli_extension.h"
+#include "esp_timer.h"
+#include "openthread/cli.h"
+#include "openthread/link.h"
+#include "openthread/thread.h"
+#include "openthread/thread_ftd.h"
+
+/*
+ * Each node keeps the totals of its last MAC Counters TLV and the deltas of its last
+ * CONFIG_OPENTHREAD_MAC_COUNTERS_HISTORY sweep intervals, the rates are derived from the deltas so a counter reset or
+ * a missed sweep does not skew them. The links of a router are kept as 2 bits of min link quality per router ID.
+ *
+ * The TLV counters are mapped as the MAC Counters TLV of OpenThread fills them:
+ *   IfOutErrors = CCA failures, IfOutDiscards = busy channel, IfInErrors = the frames received with an error,
+ *   IfInDiscards = the filtered and duplicated frames, IfInUnknownProtos = the other frames.
+ */
+#define MAC_COUNTERS_NO_NODE 0xffff
+#define MAC_COUNTERS_MIN_FRAMES 20          /* the nodes with less frames in the window are not ranked */
+#define MAC_COUNTERS_FRAME_AIRTIME_US 2400  /* a 60-byte frame and its ACK at 250 kbit/s */
+#define MAC_COUNTERS_LINK_BYTES ((OT_NETWORK_MAX_ROUTER_ID + 1 + 3) / 4)
+
+#define MAC_COUNTERS_ROUTER_ID(rloc16) ((rloc16) >> 10)
+#define MAC_COUNTERS_MIN(a, b) ((a) < (b) ? (a) : (b))
+
+typedef struct mac_counters_node {
+    uint16_t rloc16; /* MAC_COUNTERS_NO_NODE for a free entry */
+    uint16_t resets;
+    bool has_retries;
+    uint8_t head;  /* the oldest interval */
+    uint8_t count; /* the number of the intervals */
+    uint32_t last_time;
+    esp_ot_mac_counters_interval_t totals; /* the totals of the last update, time and duration unused */
+    uint8_t link_quality[MAC_COUNTERS_LINK_BYTES];
+    esp_ot_mac_counters_interval_t intervals[CONFIG_OPENTHREAD_MAC_COUNTERS_HISTORY];
+} mac_counters_node_t;
+
+static mac_counters_node_t *s_nodes = NULL;
+static uint16_t s_node_count = 0;
+
+static uint32_t mac_counters_now(void)
+{
+    return (uint32_t)(esp_timer_get_time() / 1000000);
+}
+
+static uint8_t link_quality_get(const mac_counters_node_t *node, uint8_t router_id)
+{
+    return (node->link_quality[router_id / 4] >> ((router_id % 4) * 2)) & 0x03;
+}
+
+static void link_quality_set(mac_counters_node_t *node, uint8_t router_id, uint8_t link_quality)
+{
+    node->link_quality[router_id / 4] &= ~(0x03 << ((router_id % 4) * 2));
+    node->link_quality[router_id / 4] |= (link_quality & 0x03) << ((router_id % 4) * 2);
+}
+
+static mac_counters_node_t *node_find(uint16_t rloc16, bool create)
+{
+    mac_counters_node_t *free_entry = NULL;
+    mac_counters_node_t *oldest = NULL;
+
+    for (uint16_t i = 0; s_nodes && i < CONFIG_OPENTHREAD_MAC_COUNTERS_MAX_NODES; i++) {
+        mac_counters_node_t *node = &s_nodes[i];
+        if (node->rloc16 == rloc16) {
+            return node;
+        }
+        if (node->rloc16 == MAC_COUNTERS_NO_NODE) {
+            free_entry = free_entry ? free_entry : node;
+        } else if (!oldest || node->last_time < oldest->last_time) {
+            oldest = node;
+        }
+    }
+    if (!create || !s_nodes) {
+        return NULL;
+    }
+    if (!free_entry) {
+        ESP_LOGD(OT_EXT_CLI_TAG, "MAC counters of 0x%04x replaced", oldest->rloc16);
+        free_entry = oldest;
+    } else {
+        s_node_count++;
+    }
+    memset(free_entry, 0, sizeof(mac_counters_node_t));
+    free_entry->rloc16 = rloc16;
+    return free_entry;
+}
+
+static esp_err_t mac_counters_add_totals(uint16_t rloc16, const esp_ot_mac_counters_interval_t *totals,
+                                         bool has_retries, uint32_t time)
+{
+    ESP_RETURN_ON_FALSE(s_nodes, ESP_ERR_INVALID_STATE, OT_EXT_CLI_TAG, "MAC counters store is not initialized");
+    mac_counters_node_t *node = node_find(rloc16, true);
+    const esp_ot_mac_counters_interval_t *last = &node->totals;
+
+    if (node->last_time && time > node->last_time) {
+        if (totals->tx_frames < last->tx_frames || totals->tx_errors < last->tx_errors ||
+            totals->tx_retries < last->tx_retries || totals->rx_frames < last->rx_frames ||
+            totals->rx_errors < last->rx_errors || totals->rx_discards < last->rx_discards) {
+            /* The node has rebooted or reset its counters, the interval is unknown. */
+            node->resets++;
+        } else {
+            uint8_t index = (node->head + node->count) % CONFIG_OPENTHREAD_MAC_COUNTERS_HISTORY;
+            if (node->count == CONFIG_OPENTHREAD_MAC_COUNTERS_HISTORY) {
+                node->head = (node->head + 1) % CONFIG_OPENTHREAD_MAC_COUNTERS_HISTORY;
+            } else {
+                node->count++;
+            }
+            esp_ot_mac_counters_interval_t *interval = &node->intervals[index];
+            interval->time = time;
+            interval->duration = time - node->last_time;
+            interval->tx_frames = totals->tx_frames - last->tx_frames;
+            interval->tx_errors = totals->tx_errors - last->tx_errors;
+            interval->tx_retries = totals->tx_retries - last->tx_retries;
+            interval->rx_frames = totals->rx_frames - last->rx_frames;
+            interval->rx_errors = totals->rx_errors - last->rx_errors;
+            interval->rx_discards = totals->rx_discards - last->rx_discards;
+        }
+    } else if (node->last_time) {
+        /* A second response in the same second only refreshes the totals. */
+        time = node->last_time;
+    }
+    node->totals = *totals;
+    node->has_retries = has_retries;
+    node->last_time = time ? time : 1;
+    return ESP_OK;
+}
+
+esp_err_t esp_ot_mac_counters_add_diag(uint16_t rloc16, const otNetworkDiagMacCounters *counters, uint32_t time)
+{
+    esp_ot_mac_counters_interval_t totals = {
+        .tx_frames = counters->mIfOutUcastPkts + counters->mIfOutBroadcastPkts,
+        .tx_errors = counters->mIfOutErrors + counters->mIfOutDiscards,
+        .rx_frames = counters->mIfInUcastPkts + counters->mIfInBroadcastPkts,
+        .rx_errors = counters->mIfInErrors,
+        .rx_discards = counters->mIfInDiscards + counters->mIfInUnknownProtos,
+    };
+    return mac_counters_add_totals(rloc16, &totals, false, time);
+}
+
+esp_err_t esp_ot_mac_counters_add_route(uint16_t rloc16, const otNetworkDiagRoute *route)
+{
+    mac_counters_node_t *node = node_find(rloc16, false);
+    ESP_RETURN_ON_FALSE(node, ESP_ERR_NOT_FOUND, OT_EXT_CLI_TAG, "MAC counters of 0x%04x not known", rloc16);
+
+    memset(node->link_quality, 0, sizeof(node->link_quality));
+    for (uint8_t i = 0; i < route->mRouteCount; i++) {
+        const otNetworkDiagRouteData *data = &route->mRouteData[i];
+        if (data->mRouterId != MAC_COUNTERS_ROUTER_ID(rloc16) && data->mRouterId <= OT_NETWORK_MAX_ROUTER_ID) {
+            link_quality_set(node, data->mRouterId, MAC_COUNTERS_MIN(data->mLinkQualityIn, data->mLinkQualityOut));
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_ot_mac_counters_sample_local(uint32_t time)
+{
+    otInstance *instance = esp_openthread_get_instance();
+    const otMacCounters *counters = otLinkGetCounters(instance);
+    uint16_t rloc16 = otThreadGetRloc16(instance);
+    otDeviceRole role = otThreadGetDeviceRole(instance);
+    otRouterInfo router_info;
+
+    esp_ot_mac_counters_interval_t totals = {
+        .tx_frames = counters->mTxUnicast + counters->mTxBroadcast,
+        .tx_errors = counters->mTxErrCca + counters->mTxErrBusyChannel,
+        .tx_retries = counters->mTxRetry,
+        .rx_frames = counters->mRxUnicast + counters->mRxBroadcast,
+        .rx_errors = counters->mRxErrNoFrame + counters->mRxErrUnknownNeighbor + counters->mRxErrInvalidSrcAddr +
+                     counters->mRxErrSec + counters->mRxErrFcs + counters->mRxErrOther,
+        .rx_discards = counters->mRxAddressFiltered + counters->mRxDestAddrFiltered + counters->mRxDuplicated +
+                       counters->mRxOther,
+    };
+    ESP_RETURN_ON_ERROR(mac_counters_add_totals(rloc16, &totals, true, time), OT_EXT_CLI_TAG,
+                        "Failed to add the MAC counters of this node");
+    if (role == OT_DEVICE_ROLE_ROUTER || role == OT_DEVICE_ROLE_LEADER) {
+        mac_counters_node_t *node = node_find(rloc16, false);
+        memset(node->link_quality, 0, sizeof(node->link_quality));
+        for (uint8_t id = 0; id <= otThreadGetMaxRouterId(instance); id++) {
+            if (otThreadGetRouterInfo(instance, id, &router_info) == OT_ERROR_NONE && router_info.mRloc16 != rloc16 &&
+                router_info.mLinkEstablished) {
+                link_quality_set(node, id, MAC_COUNTERS_MIN(router_info.mLinkQualityIn, router_info.mLinkQualityOut));
+            }
+        }
+    }
+    return ESP_OK;
+}
+
+static uint16_t permille(uint64_t part, uint64_t total)
+{
+    if (total == 0) {
+        return 0;
+    }
+    return part >= total ? 1000 : (uint16_t)(part * 1000 / total);
+}
+
+static void node_stats(const mac_counters_node_t *node, uint32_t from, esp_ot_mac_counters_node_stats_t *stats)
+{
+    esp_ot_mac_counters_interval_t *sum = &stats->sum;
+
+    memset(stats, 0, sizeof(esp_ot_mac_counters_node_stats_t));
+    stats->rloc16 = node->rloc16;
+    stats->resets = node->resets;
+    for (uint8_t i = 0; i < node->count; i++) {
+        const esp_ot_mac_counters_interval_t *interval =
+            &node->intervals[(node->head + i) % CONFIG_OPENTHREAD_MAC_COUNTERS_HISTORY];
+        if (interval->time < from) {
+            continue;
+        }
+        stats->intervals++;
+        sum->time = interval->time;
+        sum->duration += interval->duration;
+        sum->tx_frames += interval->tx_frames;
+        sum->tx_errors += interval->tx_errors;
+        sum->tx_retries += interval->tx_retries;
+        sum->rx_frames += interval->rx_frames;
+        sum->rx_errors += interval->rx_errors;
+        sum->rx_discards += interval->rx_discards;
+    }
+    uint64_t heard = (uint64_t)sum->tx_frames + sum->tx_retries + sum->rx_frames + sum->rx_errors + sum->rx_discards;
+    stats->tx_error_permille = permille(sum->tx_errors, sum->tx_frames);
+    stats->rx_error_permille = permille(sum->rx_errors, (uint64_t)sum->rx_frames + sum->rx_errors);
+    stats->retry_permille = node->has_retries ? permille(sum->tx_retries, (uint64_t)sum->tx_frames + sum->tx_retries)
+                                              : ESP_OT_MAC_COUNTERS_UNKNOWN;
+    stats->utilization_permille = permille(heard * MAC_COUNTERS_FRAME_AIRTIME_US, (uint64_t)sum->duration * 1000000);
+    stats->score_permille = stats->tx_error_permille > stats->rx_error_permille ? stats->tx_error_permille
+                                                                                : stats->rx_error_permille;
+    if (node->has_retries && stats->retry_permille > stats->score_permille) {
+        stats->score_permille = stats->retry_permille;
+    }
+}
+
+static bool node_ranked(const esp_ot_mac_counters_node_stats_t *stats)
+{
+    return stats->intervals && (uint64_t)stats->sum.tx_frames + stats->sum.rx_frames >= MAC_COUNTERS_MIN_FRAMES;
+}
+
+static uint32_t window_start(uint32_t window)
+{
+    uint32_t now = mac_counters_now();
+    return window && window < now ? now - window : 0;
+}
+
+uint16_t esp_ot_mac_counters_get_worst_nodes(uint32_t window, esp_ot_mac_counters_node_stats_t *nodes, uint16_t max)
+{
+    esp_ot_mac_counters_node_stats_t stats;
+    uint32_t from = window_start(window);
+    uint16_t count = 0;
+
+    for (uint16_t i = 0; s_nodes && max && i < CONFIG_OPENTHREAD_MAC_COUNTERS_MAX_NODES; i++) {
+        if (s_nodes[i].rloc16 == MAC_COUNTERS_NO_NODE) {
+            continue;
+        }
+        node_stats(&s_nodes[i], from, &stats);
+        if (!node_ranked(&stats) || (count == max && stats.score_permille <= nodes[count - 1].score_permille)) {
+            continue;
+        }
+        /* Insert in the order of the score, the last one is dropped when the output is full. */
+        uint16_t pos = count < max ? count++ : max - 1;
+        while (pos > 0 && nodes[pos - 1].score_permille < stats.score_permille) {
+            nodes[pos] = nodes[pos - 1];
+            pos--;
+        }
+        nodes[pos] = stats;
+    }
+    return count;
+}
+
+/* An unknown tx error rate ranks below any error seen and above routers known to be clean. */
+static uint32_t link_error_key(uint16_t node_tx_error_permille)
+{
+    return node_tx_error_permille == ESP_OT_MAC_COUNTERS_UNKNOWN ? 1 : (uint32_t)node_tx_error_permille * 2;
+}
+
+static bool link_worse(const esp_ot_mac_counters_link_stats_t *a, const esp_ot_mac_counters_link_stats_t *b)
+{
+    return a->link_quality != b->link_quality ? a->link_quality < b->link_quality
+                                              : link_error_key(a->node_tx_error_permille) >
+                                                    link_error_key(b->node_tx_error_permille);
+}
+
+uint16_t esp_ot_mac_counters_get_worst_links(uint32_t window, esp_ot_mac_counters_link_stats_t *links, uint16_t max)
+{
+    uint16_t tx_error[CONFIG_OPENTHREAD_MAC_COUNTERS_MAX_NODES];
+    esp_ot_mac_counters_node_stats_t stats;
+    uint32_t from = window_start(window);
+    uint16_t count = 0;
+
+    for (uint16_t i = 0; s_nodes && i < CONFIG_OPENTHREAD_MAC_COUNTERS_MAX_NODES; i++) {
+        tx_error[i] = ESP_OT_MAC_COUNTERS_UNKNOWN;
+        if (s_nodes[i].rloc16 != MAC_COUNTERS_NO_NODE) {
+            node_stats(&s_nodes[i], from, &stats);
+            tx_error[i] = node_ranked(&stats) ? stats.tx_error_permille : ESP_OT_MAC_COUNTERS_UNKNOWN;
+        }
+    }
+    for (uint16_t i = 0; s_nodes && max && i < CONFIG_OPENTHREAD_MAC_COUNTERS_MAX_NODES; i++) {
+        const mac_counters_node_t *node = &s_nodes[i];
+        if (node->rloc16 == MAC_COUNTERS_NO_NODE) {
+            continue;
+        }
+        for (uint8_t id = 0; id <= OT_NETWORK_MAX_ROUTER_ID; id++) {
+            uint8_t link_quality = link_quality_get(node, id);
+            if (link_quality == 0) {
+                continue;
+            }
+            uint16_t rloc16 = (uint16_t)id << 10;
+            const mac_counters_node_t *peer = node_find(rloc16, false);
+            uint8_t peer_link_quality = peer ? link_quality_get(peer, MAC_COUNTERS_ROUTER_ID(node->rloc16)) : 0;
+            /* A link reported by both routers is ranked once, from its lower RLOC16. */
+            if (peer_link_quality && rloc16 < node->rloc16) {
+                continue;
+            }
+            esp_ot_mac_counters_link_stats_t link = {
+                .router = MAC_COUNTERS_MIN(node->rloc16, rloc16),
+                .neighbor = node->rloc16 < rloc16 ? rloc16 : node->rloc16,
+                .link_quality = peer_link_quality ? MAC_COUNTERS_MIN(link_quality, peer_link_quality) : link_quality,
+            };
+            /* The MAC counters are per node, not per neighbor, so the link only gets the rates of its routers. */
+            uint16_t errors[2] = {tx_error[i], peer ? tx_error[peer - s_nodes] : ESP_OT_MAC_COUNTERS_UNKNOWN};
+            uint8_t known = (errors[0] != ESP_OT_MAC_COUNTERS_UNKNOWN) + (errors[1] != ESP_OT_MAC_COUNTERS_UNKNOWN);
+            link.node_tx_error_permille = known ? ((errors[0] != ESP_OT_MAC_COUNTERS_UNKNOWN ? errors[0] : 0) +
+                                                   (errors[1] != ESP_OT_MAC_COUNTERS_UNKNOWN ? errors[1] : 0)) /
+                                                      known
+                                                : ESP_OT_MAC_COUNTERS_UNKNOWN;
+            if (count == max && !link_worse(&link, &links[count - 1])) {
+                continue;
+            }
+            uint16_t pos = count < max ? count++ : max - 1;
+            while (pos > 0 && link_worse(&link, &links[pos - 1])) {
+                links[pos] = links[pos - 1];
+                pos--;
+            }
+            links[pos] = link;
+        }
+    }
+    return count;
+}
+
+esp_err_t esp_ot_mac_counters_get_node(uint16_t rloc16, uint32_t window, esp_ot_mac_counters_node_stats_t *stats,
+                                       esp_ot_mac_counters_interval_t *intervals, uint16_t max)
+{
+    const mac_counters_node_t *node = node_find(rloc16, false);
+    uint32_t from = window_start(window);
+    uint16_t count = 0;
+
+    ESP_RETURN_ON_FALSE(node, ESP_ERR_NOT_FOUND, OT_EXT_CLI_TAG, "MAC counters of 0x%04x not known", rloc16);
+    node_stats(node, from, stats);
+    for (uint8_t i = 0; intervals && i < node->count && count < max; i++) {
+        const esp_ot_mac_counters_interval_t *interval =
+            &node->intervals[(node->head + i) % CONFIG_OPENTHREAD_MAC_COUNTERS_HISTORY];
+        if (interval->time >= from) {
+            intervals[count++] = *interval;
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_ot_mac_counters_init(void)
+{
+    s_nodes = malloc(CONFIG_OPENTHREAD_MAC_COUNTERS_MAX_NODES * sizeof(mac_counters_node_t));
+    ESP_RETURN_ON_FALSE(s_nodes, ESP_ERR_NO_MEM, OT_EXT_CLI_TAG, "Failed to allocate the MAC counters store");
+    for (uint16_t i = 0; i < CONFIG_OPENTHREAD_MAC_COUNTERS_MAX_NODES; i++) {
+        s_nodes[i].rloc16 = MAC_COUNTERS_NO_NODE;
+    }
+    s_node_count = 0;
+    return ESP_OK;
+}
+
+static void mac_counters_print_permille(const char *name, uint16_t value)
+{
+    if (value == ESP_OT_MAC_COUNTERS_UNKNOWN) {
+        otCliOutputFormat(", %s -", name);
+    } else {
+        otCliOutputFormat(", %s %u.%u%%", name, value / 10, value % 10);
+    }
+}
+
+static void mac_counters_print_stats(const esp_ot_mac_counters_node_stats_t *stats)
+{
+    otCliOutputFormat("0x%04x: tx %lu, rx %lu", stats->rloc16, (unsigned long)stats->sum.tx_frames,
+                      (unsigned long)stats->sum.rx_frames);
+    mac_counters_print_permille("tx errors", stats->tx_error_permille);
+    mac_counters_print_permille("rx errors", stats->rx_error_permille);
+    mac_counters_print_permille("retries", stats->retry_permille);
+    mac_counters_print_permille("utilization", stats->utilization_permille);
+    otCliOutputFormat(", %u intervals, %u resets\n", stats->intervals, stats->resets);
+}
+
+static otError mac_counters_parse_u32(const char *arg, int base, uint32_t max, uint32_t *value)
+{
+    char *end = NULL;
+    unsigned long parsed = strtoul(arg, &end, base);
+    ESP_RETURN_ON_FALSE(*arg != '\0' && *end == '\0' && parsed <= max, OT_ERROR_INVALID_ARGS, OT_EXT_CLI_TAG,
+                        "Invalid argument %s", arg);
+    *value = parsed;
+    return OT_ERROR_NONE;
+}
+
+otError esp_ot_process_mac_counters(void *aContext, uint8_t aArgsLength, char *aArgs[])
+{
+    (void)aContext;
+    uint32_t window = 0;
+
+    if (aArgsLength == 0) {
+        otCliOutputFormat("nodes: %u/%u, memory: %u bytes, history: %u intervals of %u s\n", s_node_count,
+                          CONFIG_OPENTHREAD_MAC_COUNTERS_MAX_NODES,
+                          (unsigned)(s_nodes ? CONFIG_OPENTHREAD_MAC_COUNTERS_MAX_NODES * sizeof(mac_counters_node_t)
+                                             : 0),
+                          CONFIG_OPENTHREAD_MAC_COUNTERS_HISTORY, CONFIG_OPENTHREAD_MAC_COUNTERS_SWEEP_INTERVAL);
+    } else if (strcmp(aArgs[0], "worst") == 0) {
+        esp_ot_mac_counters_node_stats_t nodes[8];
+        esp_ot_mac_counters_link_stats_t links[8];
+        uint32_t max = 5;
+        ESP_RETURN_ON_FALSE(aArgsLength <= 3, OT_ERROR_INVALID_ARGS, OT_EXT_CLI_TAG, "Invalid arguments");
+        if (aArgsLength >= 2 && mac_counters_parse_u32(aArgs[1], 10, 8, &max) != OT_ERROR_NONE) {
+            return OT_ERROR_INVALID_ARGS;
+        }
+        if (aArgsLength == 3 && mac_counters_parse_u32(aArgs[2], 10, UINT32_MAX, &window) != OT_ERROR_NONE) {
+            return OT_ERROR_INVALID_ARGS;
+        }
+        uint16_t node_count = esp_ot_mac_counters_get_worst_nodes(window, nodes, max);
+        uint16_t link_count = esp_ot_mac_counters_get_worst_links(window, links, max);
+        otCliOutputFormat("nodes:\n");
+        for (uint16_t i = 0; i < node_count; i++) {
+            otCliOutputFormat("    ");
+            mac_counters_print_stats(&nodes[i]);
+        }
+        otCliOutputFormat("links:\n");
+        for (uint16_t i = 0; i < link_count; i++) {
+            otCliOutputFormat("    0x%04x <-> 0x%04x: link quality %u", links[i].router, links[i].neighbor,
+                              links[i].link_quality);
+            mac_counters_print_permille("node tx errors (estimate)", links[i].node_tx_error_permille);
+            otCliOutputFormat("\n");
+        }
+    } else if (strcmp(aArgs[0], "node") == 0) {
+        esp_ot_mac_counters_interval_t intervals[CONFIG_OPENTHREAD_MAC_COUNTERS_HISTORY];
+        esp_ot_mac_counters_node_stats_t stats;
+        uint32_t rloc16 = 0;
+        ESP_RETURN_ON_FALSE(aArgsLength >= 2 && aArgsLength <= 3, OT_ERROR_INVALID_ARGS, OT_EXT_CLI_TAG,
+                            "Invalid arguments");
+        if (mac_counters_parse_u32(aArgs[1], 16, UINT16_MAX, &rloc16) != OT_ERROR_NONE ||
+            (aArgsLength == 3 && mac_counters_parse_u32(aArgs[2], 10, UINT32_MAX, &window) != OT_ERROR_NONE)) {
+            return OT_ERROR_INVALID_ARGS;
+        }
+        if (esp_ot_mac_counters_get_node(rloc16, window, &stats, intervals, CONFIG_OPENTHREAD_MAC_COUNTERS_HISTORY) !=
+            ESP_OK) {
+            return OT_ERROR_NOT_FOUND;
+        }
+        mac_counters_print_stats(&stats);
+        for (uint16_t i = 0; i < stats.intervals; i++) {
+            otCliOutputFormat("    %lu s (%lu s): tx %lu, tx errors %lu, retries %lu, rx %lu, rx errors %lu, "
+                              "discards %lu\n",
+                              (unsigned long)intervals[i].time, (unsigned long)intervals[i].duration,
+                              (unsigned long)intervals[i].tx_frames, (unsigned long)intervals[i].tx_errors,
+                              (unsigned long)intervals[i].tx_retries, (unsigned long)intervals[i].rx_frames,
+                              (unsigned long)intervals[i].rx_errors, (unsigned long)intervals[i].rx_discards);
+        }
+    } else {
+        return OT_ERROR_INVALID_ARGS;
+    }
+    return OT_ERROR_NONE;
+}
@@ -11,6 +11,9 @@
 #include "esp_check.h"
 #include "esp_openthread_border_router.h"
 #include "esp_ot_cli_extension.h"
+#if CONFIG_OPENTHREAD_RCP_STATS
+#include "esp_ot_rcp_stats.h"
+#endif
 #if CONFIG_AUTO_UPDATE_RCP
 #include "esp_rcp_update.h"
 #endif
@@ -55,6 +58,20 @@ otError esp_openthread_process_rcp_command(void *aContext, uint8_t aArgsLength,
         otCliOutputFormat("  desc    : process updating the rcp\n");
         otCliOutputFormat("  example : otrcp update\n");
 #endif
+#if CONFIG_OPENTHREAD_RCP_STATS
+        otCliOutputFormat("stats [json]:\n");
+        otCliOutputFormat("  desc    : print the mac counters and the rcp latency, in json if specified\n");
+        otCliOutputFormat("  example : otrcp stats\n");
+        otCliOutputFormat("stats reset:\n");
+        otCliOutputFormat("  desc    : reset the rcp statistics\n");
+        otCliOutputFormat("  example : otrcp stats reset\n");
+        otCliOutputFormat("stats window <ms>:\n");
+        otCliOutputFormat("  desc    : report the statistics of the last completed window, 0 to accumulate\n");
+        otCliOutputFormat("  example : otrcp stats window 10000\n");
+        otCliOutputFormat("stats probe <interval>|off:\n");
+        otCliOutputFormat("  desc    : probe the command to response latency every <interval> ms\n");
+        otCliOutputFormat("  example : otrcp stats probe 100\n");
+#endif
 #if CONFIG_OPENTHREAD_RCP_CLI
         otCliOutputFormat("<text>:\n");
         otCliOutputFormat("  desc    : send command to be run on rcp\n");
@@ -80,7 +97,13 @@ otError esp_openthread_process_rcp_command(void *aContext, uint8_t aArgsLength,
 #else
         otCliOutputFormat("invalid commands\n");
 #endif
-    } else {
+    }
+#if CONFIG_OPENTHREAD_RCP_STATS
+    else if (strcmp(aArgs[0], "stats") == 0) {
+        return esp_ot_process_rcp_stats(aContext, aArgsLength - 1, aArgs + 1);
+    }
+#endif
+    else {
 #if CONFIG_OPENTHREAD_RCP_CLI
         char buf[256];
         ESP_RETURN_ON_ERROR(join_args(buf, sizeof(buf), 0, aArgsLength, aArgs), OT_EXT_CLI_TAG, "command too long");
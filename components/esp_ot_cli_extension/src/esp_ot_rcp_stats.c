@@ -0,0 +1,286 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_ot_rcp_stats.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_check.h"
+#include "esp_log.h"
+#include "esp_openthread.h"
+#include "esp_openthread_lock.h"
+#include "esp_ot_cli_extension.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "openthread/cli.h"
+#include "openthread/link.h"
+#include "openthread/platform/radio.h"
+
+/*
+ * The spinel frames, their bytes and the HDLC-lite CRC errors are counted inside the radio spinel driver of ESP-IDF,
+ * which exposes none of them, and the frame callback belongs to the packet capture. So nothing here is measured on
+ * the spinel link: the frames are the 802.15.4 MAC counters, and the spinel bytes and the link load are estimated
+ * upper bounds which count each frame with the largest PSDU plus the spinel header, the frame metadata and the
+ * HDLC-lite framing. The errors are the MAC retry and error counters, not spinel or HDLC errors.
+ */
+#define RCP_STATS_MAX_PSDU 127
+#define RCP_STATS_TX_FRAME_OVERHEAD 24 /* STREAM_RAW set, host to RCP */
+#define RCP_STATS_TX_DONE_BYTES 24     /* transmit done with the ACK frame, RCP to host */
+#define RCP_STATS_RX_FRAME_OVERHEAD 26 /* STREAM_RAW received frame, RCP to host */
+#if CONFIG_OPENTHREAD_RADIO_SPINEL_UART
+#define RCP_STATS_BITS_PER_BYTE 10 /* 8N1 */
+#else
+#define RCP_STATS_BITS_PER_BYTE 8
+#endif
+
+#define RCP_STATS_PROBE_TASK_STACK_SIZE 3072
+#define RCP_STATS_PROBE_TASK_PRIORITY 5
+#define RCP_STATS_HIST_BUCKETS_NUM 8
+#define RCP_STATS_ROTATE_LOCK_WAIT_MS 100
+
+/* Upper bounds in microseconds of the command to response latency buckets, the last bucket collects the rest */
+static const uint32_t s_latency_bounds_us[RCP_STATS_HIST_BUCKETS_NUM - 1] = {500,   1000,  2000, 5000,
+                                                                             10000, 20000, 50000};
+
+typedef struct rcp_stats {
+    int64_t start_us;
+    int64_t end_us;
+    uint32_t latency_buckets[RCP_STATS_HIST_BUCKETS_NUM];
+    uint32_t latency_count;
+    uint64_t latency_sum_us;
+    uint32_t latency_max_us;
+    uint32_t cmd_errors;
+    otMacCounters mac_base; /* MAC counters at the beginning of the window */
+    otMacCounters mac;      /* MAC counters accumulated in the window, valid when the window ends */
+} rcp_stats_t;
+
+/* All the statistics are updated in the OpenThread task or with the OpenThread lock held */
+static rcp_stats_t s_current;
+static rcp_stats_t s_last;
+static bool s_last_valid = false;
+static uint32_t s_window_ms = 0;
+static TaskHandle_t s_probe_task = NULL;
+static uint32_t s_probe_interval_ms = 0;
+static esp_timer_handle_t s_window_timer = NULL;
+
+static void rcp_stats_reset(void)
+{
+    memset(&s_current, 0, sizeof(s_current));
+    s_current.start_us = esp_timer_get_time();
+    memcpy(&s_current.mac_base, otLinkGetCounters(esp_openthread_get_instance()), sizeof(otMacCounters));
+}
+
+static void rcp_stats_close(rcp_stats_t *stats, int64_t now)
+{
+    const otMacCounters *mac = otLinkGetCounters(esp_openthread_get_instance());
+    const uint32_t *from = (const uint32_t *)&stats->mac_base;
+    const uint32_t *to = (const uint32_t *)mac;
+    uint32_t *delta = (uint32_t *)&stats->mac;
+
+    // otMacCounters only consists of uint32_t counters.
+    for (size_t i = 0; i < sizeof(otMacCounters) / sizeof(uint32_t); i++) {
+        delta[i] = to[i] - from[i];
+    }
+    stats->end_us = now;
+}
+
+/* Runs in the esp_timer task at the end of each window. */
+static void rcp_stats_rotate(void *aContext)
+{
+    // The esp_timer task must not block long, a window which ends while the lock is busy is merged into the next
+    // one, its length is recorded.
+    if (!esp_openthread_lock_acquire(pdMS_TO_TICKS(RCP_STATS_ROTATE_LOCK_WAIT_MS))) {
+        return;
+    }
+    int64_t now = esp_timer_get_time();
+    // A tick which waited for the lock while `otrcp stats window` restarted the window is stale.
+    if (s_window_ms && now - s_current.start_us >= (int64_t)s_window_ms * 500) {
+        rcp_stats_close(&s_current, now);
+        memcpy(&s_last, &s_current, sizeof(s_last));
+        s_last_valid = true;
+        rcp_stats_reset();
+    }
+    esp_openthread_lock_release();
+}
+
+static void rcp_stats_probe_worker(void *aContext)
+{
+    otInstance *instance = esp_openthread_get_instance();
+
+    while (true) {
+        vTaskDelay(pdMS_TO_TICKS(s_probe_interval_ms));
+        int8_t power = 0;
+        esp_openthread_lock_acquire(portMAX_DELAY);
+        // Reading the transmit power is a synchronous spinel property get, which waits for the RCP response.
+        int64_t request = esp_timer_get_time();
+        otError error = otPlatRadioGetTransmitPower(instance, &power);
+        uint32_t latency = (uint32_t)(esp_timer_get_time() - request);
+        if (error == OT_ERROR_NONE) {
+            int bucket = 0;
+            while (bucket < RCP_STATS_HIST_BUCKETS_NUM - 1 && latency >= s_latency_bounds_us[bucket]) {
+                bucket++;
+            }
+            s_current.latency_buckets[bucket]++;
+            s_current.latency_count++;
+            s_current.latency_sum_us += latency;
+            if (latency > s_current.latency_max_us) {
+                s_current.latency_max_us = latency;
+            }
+        } else {
+            s_current.cmd_errors++;
+        }
+        esp_openthread_lock_release();
+    }
+}
+
+static uint32_t rcp_stats_load_permille(const rcp_stats_t *stats, uint64_t bytes)
+{
+    uint64_t elapsed_us = stats->end_us - stats->start_us;
+    if (elapsed_us == 0) {
+        return 0;
+    }
+    // Both directions of the link have the full rate.
+    uint64_t bits_per_second = bytes * RCP_STATS_BITS_PER_BYTE * 1000000 / elapsed_us;
+    return (uint32_t)(bits_per_second * 1000 / CONFIG_OPENTHREAD_RCP_STATS_LINK_RATE);
+}
+
+static void rcp_stats_print(const rcp_stats_t *stats, bool json)
+{
+    uint32_t tx_frames = stats->mac.mTxTotal;
+    uint32_t rx_frames = stats->mac.mRxTotal;
+    uint64_t tx_bytes = (uint64_t)tx_frames * (RCP_STATS_MAX_PSDU + RCP_STATS_TX_FRAME_OVERHEAD);
+    uint64_t rx_bytes = (uint64_t)rx_frames * (RCP_STATS_MAX_PSDU + RCP_STATS_RX_FRAME_OVERHEAD) +
+                        (uint64_t)tx_frames * RCP_STATS_TX_DONE_BYTES;
+    uint32_t tx_load = rcp_stats_load_permille(stats, tx_bytes);
+    uint32_t rx_load = rcp_stats_load_permille(stats, rx_bytes);
+    unsigned long avg = stats->latency_count ? (unsigned long)(stats->latency_sum_us / stats->latency_count) : 0UL;
+    unsigned long window_ms = (unsigned long)((stats->end_us - stats->start_us) / 1000);
+
+    if (json) {
+        otCliOutputFormat("{\"window_ms\":%lu,\"link_rate\":%lu,", window_ms,
+                          (unsigned long)CONFIG_OPENTHREAD_RCP_STATS_LINK_RATE);
+        otCliOutputFormat("\"mac_tx\":{\"frames\":%lu,\"est_max_spinel_bytes\":%llu,"
+                          "\"est_max_load_permille\":%lu},",
+                          (unsigned long)tx_frames, (unsigned long long)tx_bytes, (unsigned long)tx_load);
+        otCliOutputFormat("\"mac_rx\":{\"frames\":%lu,\"est_max_spinel_bytes\":%llu,"
+                          "\"est_max_load_permille\":%lu},",
+                          (unsigned long)rx_frames, (unsigned long long)rx_bytes, (unsigned long)rx_load);
+        otCliOutputFormat("\"probe_errors\":%lu,", (unsigned long)stats->cmd_errors);
+        otCliOutputFormat("\"mac_errors\":{\"rx_fcs\":%lu,\"rx_other\":%lu,\"tx_retry\":%lu,\"tx_abort\":%lu},",
+                          (unsigned long)stats->mac.mRxErrFcs, (unsigned long)stats->mac.mRxErrOther,
+                          (unsigned long)stats->mac.mTxRetry, (unsigned long)stats->mac.mTxErrAbort);
+        otCliOutputFormat("\"latency\":{\"count\":%lu,\"avg_us\":%lu,\"max_us\":%lu,\"buckets\":[",
+                          (unsigned long)stats->latency_count, avg, (unsigned long)stats->latency_max_us);
+        for (int i = 0; i < RCP_STATS_HIST_BUCKETS_NUM; i++) {
+            otCliOutputFormat("%s{\"le_us\":%ld,\"count\":%lu}", i ? "," : "",
+                              i < RCP_STATS_HIST_BUCKETS_NUM - 1 ? (long)s_latency_bounds_us[i] : -1L,
+                              (unsigned long)stats->latency_buckets[i]);
+        }
+        otCliOutputFormat("]}}\n");
+        return;
+    }
+
+    otCliOutputFormat("window: %lu ms, link rate: %lu bps\n", window_ms,
+                      (unsigned long)CONFIG_OPENTHREAD_RCP_STATS_LINK_RATE);
+    otCliOutputFormat("mac tx frames: %lu, estimated spinel bytes <= %llu, estimated link load <= %lu.%lu %%\n",
+                      (unsigned long)tx_frames, (unsigned long long)tx_bytes, (unsigned long)tx_load / 10,
+                      (unsigned long)tx_load % 10);
+    otCliOutputFormat("mac rx frames: %lu, estimated spinel bytes <= %llu, estimated link load <= %lu.%lu %%\n",
+                      (unsigned long)rx_frames, (unsigned long long)rx_bytes, (unsigned long)rx_load / 10,
+                      (unsigned long)rx_load % 10);
+    otCliOutputFormat("probe command errors: %lu\n", (unsigned long)stats->cmd_errors);
+    otCliOutputFormat("mac rx fcs errors: %lu\n", (unsigned long)stats->mac.mRxErrFcs);
+    otCliOutputFormat("mac rx other errors: %lu\n", (unsigned long)stats->mac.mRxErrOther);
+    otCliOutputFormat("mac tx retries: %lu\n", (unsigned long)stats->mac.mTxRetry);
+    otCliOutputFormat("mac tx aborts: %lu\n", (unsigned long)stats->mac.mTxErrAbort);
+    otCliOutputFormat("probe command latency: count %lu, avg %lu us, max %lu us\n",
+                      (unsigned long)stats->latency_count, avg, (unsigned long)stats->latency_max_us);
+    for (int i = 0; i < RCP_STATS_HIST_BUCKETS_NUM; i++) {
+        if (i < RCP_STATS_HIST_BUCKETS_NUM - 1) {
+            otCliOutputFormat("    < %-6lu us : %lu\n", (unsigned long)s_latency_bounds_us[i],
+                              (unsigned long)stats->latency_buckets[i]);
+        } else {
+            otCliOutputFormat("    >= %-5lu us : %lu\n", (unsigned long)s_latency_bounds_us[i - 1],
+                              (unsigned long)stats->latency_buckets[i]);
+        }
+    }
+}
+
+static otError rcp_stats_show(bool json)
+{
+    static rcp_stats_t s_snapshot;
+
+    if (s_window_ms && s_last_valid) {
+        memcpy(&s_snapshot, &s_last, sizeof(s_snapshot));
+    } else {
+        // No completed window yet, show the one in progress.
+        memcpy(&s_snapshot, &s_current, sizeof(s_snapshot));
+        rcp_stats_close(&s_snapshot, esp_timer_get_time());
+    }
+    rcp_stats_print(&s_snapshot, json);
+    return OT_ERROR_NONE;
+}
+
+otError esp_ot_process_rcp_stats(void *aContext, uint8_t aArgsLength, char *aArgs[])
+{
+    (void)aContext;
+    if (aArgsLength == 0) {
+        return rcp_stats_show(false);
+    } else if (strcmp(aArgs[0], "json") == 0) {
+        return rcp_stats_show(true);
+    } else if (strcmp(aArgs[0], "reset") == 0) {
+        s_last_valid = false;
+        rcp_stats_reset();
+    } else if (strcmp(aArgs[0], "window") == 0) {
+        ESP_RETURN_ON_FALSE(aArgsLength == 2, OT_ERROR_INVALID_ARGS, OT_EXT_CLI_TAG, "Invalid arguments");
+        s_window_ms = (uint32_t)strtoul(aArgs[1], NULL, 10);
+        s_last_valid = false;
+        rcp_stats_reset();
+        esp_timer_stop(s_window_timer);
+        if (s_window_ms) {
+            ESP_RETURN_ON_FALSE(esp_timer_start_periodic(s_window_timer, (uint64_t)s_window_ms * 1000) == ESP_OK,
+                                OT_ERROR_FAILED, OT_EXT_CLI_TAG, "Failed to start rcp stats window timer");
+        }
+    } else if (strcmp(aArgs[0], "probe") == 0) {
+        ESP_RETURN_ON_FALSE(aArgsLength == 2, OT_ERROR_INVALID_ARGS, OT_EXT_CLI_TAG, "Invalid arguments");
+        if (strcmp(aArgs[1], "off") == 0) {
+            ESP_RETURN_ON_FALSE(s_probe_task, OT_ERROR_INVALID_STATE, OT_EXT_CLI_TAG, "Probe is not running");
+            // The CLI holds the OpenThread lock, so the probe task is not in the middle of a probe.
+            vTaskDelete(s_probe_task);
+            s_probe_task = NULL;
+        } else {
+            long interval = strtol(aArgs[1], NULL, 10);
+            ESP_RETURN_ON_FALSE(interval > 0, OT_ERROR_INVALID_ARGS, OT_EXT_CLI_TAG, "Invalid probe interval");
+            s_probe_interval_ms = (uint32_t)interval;
+            if (!s_probe_task) {
+                ESP_RETURN_ON_FALSE(xTaskCreate(rcp_stats_probe_worker, "rcp_probe", RCP_STATS_PROBE_TASK_STACK_SIZE,
+                                                NULL, RCP_STATS_PROBE_TASK_PRIORITY, &s_probe_task) == pdTRUE,
+                                    OT_ERROR_FAILED, OT_EXT_CLI_TAG, "Failed to create rcp probe task");
+            }
+        }
+    } else {
+        return OT_ERROR_INVALID_ARGS;
+    }
+    return OT_ERROR_NONE;
+}
+
+esp_err_t esp_ot_rcp_stats_init(void)
+{
+    otInstance *instance = esp_openthread_get_instance();
+    ESP_RETURN_ON_FALSE(instance, ESP_FAIL, OT_EXT_CLI_TAG, "OpenThread instance is not initialized");
+    const esp_timer_create_args_t timer_args = {
+        .callback = rcp_stats_rotate,
+        .name = "rcp_stats",
+    };
+    ESP_RETURN_ON_ERROR(esp_timer_create(&timer_args, &s_window_timer), OT_EXT_CLI_TAG,
+                        "Failed to create rcp stats window timer");
+    esp_openthread_lock_acquire(portMAX_DELAY);
+    rcp_stats_reset();
+    esp_openthread_lock_release();
+    return ESP_OK;
+}
@@ -5,6 +5,8 @@
  */
 #include "esp_ot_wifi_cmd.h"
 
+#include <inttypes.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -23,9 +25,13 @@
 #include "esp_netif_types.h"
 #include "esp_openthread_lock.h"
 #include "esp_ot_cli_extension.h"
+#include "esp_random.h"
+#include "esp_timer.h"
 #include "esp_wifi.h"
 #include "example_common_private.h"
 #include "nvs.h"
+#include "mbedtls/pkcs5.h"
+#include "mbedtls/sha256.h"
 #include "protocol_examples_common.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/event_groups.h"
@@ -85,10 +91,54 @@ const char wifi_state_string[3][20] = {"disconnected", "connected", "reconnectin
 static nvs_handle_t s_wifi_config_nvs_handle = 0;
 #define SSIDKEY "ssid"
 #define PASSWORDKEY "password"
+#define APCACHEKEY "apcache"
 #define SSIDMAXLEN 32
 #define PASSWORDMAXLEN 64
+#define PMKLEN 32
+#define WIFI_CONFIG_DIGEST_LEN 8
+#define WIFI_JOIN_POLL_MS 100
+#define WIFI_RECONNECT_LATENCY_BUCKETS 9
+#define WIFI_CONNECTED_BIT BIT0
+#define WIFI_GOT_IP_BIT BIT1
+#define WIFI_GOT_IP6_BIT BIT2
+#define WIFI_FAIL_BIT BIT3
 ESP_EVENT_DEFINE_BASE(WIFI_ADDRESS_EVENT);
 
+/* The access point of the last connection, stored in NVS to connect to it again without scanning. */
+typedef struct {
+    uint8_t digest[WIFI_CONFIG_DIGEST_LEN]; /* Of the ssid and the password the entry belongs to */
+    uint8_t bssid[6];
+    uint8_t channel;                        /* 0 if no connection succeeded with the ssid and the password */
+    uint8_t authmode;
+    bool has_pmk;
+    uint8_t pmk[PMKLEN];                    /* Derived from the password once instead of on each connection */
+} wifi_ap_cache_t;
+
+typedef struct {
+    uint32_t direct;     /* The connections by the cached BSSID and channel */
+    uint32_t scan;       /* The connections after a scan */
+    uint32_t last_ms;    /* The time of the last connection */
+    uint32_t reconnects; /* The connections after losing the previous one */
+    uint32_t max_ms;
+    uint32_t buckets[WIFI_RECONNECT_LATENCY_BUCKETS];
+} wifi_connect_stats_t;
+
+/* The upper bounds of the buckets of the reconnect latency, the last bucket has none. */
+static const uint32_t s_reconnect_bounds_ms[WIFI_RECONNECT_LATENCY_BUCKETS - 1] = {
+    100, 250, 500, 1000, 2000, 5000, 10000, 30000,
+};
+
+static char s_ssid[SSIDMAXLEN];
+static char s_password[PASSWORDMAXLEN];
+static wifi_ap_cache_t s_ap_cache;
+static wifi_connect_stats_t s_connect_stats;
+static bool s_connect_direct = false;
+static bool s_connect_is_reconnect = false;
+static uint16_t s_connect_attempts = 0;
+static int64_t s_connect_start_us = 0;
+static EventGroupHandle_t s_wifi_event_group = NULL;
+static esp_timer_handle_t s_reconnect_timer = NULL;
+
 static void handle_wifi_addr_init(void)
 {
     ESP_ERROR_CHECK(esp_event_handler_register(WIFI_ADDRESS_EVENT, WIFI_ADDRESS_EVENT_ADD_IP6,
@@ -105,54 +155,327 @@ static void handle_wifi_addr_init(void)
                                                esp_netif_get_handle_from_ifkey("WIFI_STA_DEF")));
 }
 
+static void wifi_config_digest(const char *ssid, const char *password, uint8_t digest[WIFI_CONFIG_DIGEST_LEN])
+{
+    uint8_t buf[SSIDMAXLEN + PASSWORDMAXLEN];
+    uint8_t hash[32];
+    size_t ssid_len = strlen(ssid) + 1;
+    size_t password_len = strlen(password);
+
+    memcpy(buf, ssid, ssid_len);
+    memcpy(buf + ssid_len, password, password_len);
+    mbedtls_sha256(buf, ssid_len + password_len, hash, 0);
+    memcpy(digest, hash, WIFI_CONFIG_DIGEST_LEN);
+}
+
+static bool wifi_authmode_is_psk(uint8_t authmode)
+{
+    return authmode == WIFI_AUTH_WPA_PSK || authmode == WIFI_AUTH_WPA2_PSK || authmode == WIFI_AUTH_WPA_WPA2_PSK;
+}
+
+static void wifi_ap_cache_load(void)
+{
+    uint8_t digest[WIFI_CONFIG_DIGEST_LEN];
+    size_t length = sizeof(s_ap_cache);
+    size_t password_len = strlen(s_password);
+
+    wifi_config_digest(s_ssid, s_password, digest);
+    if (memcmp(s_ap_cache.digest, digest, sizeof(digest)) == 0) {
+        return;
+    }
+    if (nvs_get_blob(s_wifi_config_nvs_handle, APCACHEKEY, &s_ap_cache, &length) == ESP_OK &&
+        length == sizeof(s_ap_cache) && memcmp(s_ap_cache.digest, digest, sizeof(digest)) == 0) {
+        return;
+    }
+    memset(&s_ap_cache, 0, sizeof(s_ap_cache));
+    memcpy(s_ap_cache.digest, digest, sizeof(digest));
+    // WPA-PSK derives the key from a passphrase of 8 to 63 characters as in IEEE 802.11i.
+    if (password_len >= 8) {
+        s_ap_cache.has_pmk = mbedtls_pkcs5_pbkdf2_hmac_ext(MBEDTLS_MD_SHA1, (const unsigned char *)s_password,
+                                                           password_len, (const unsigned char *)s_ssid, strlen(s_ssid),
+                                                           4096, PMKLEN, s_ap_cache.pmk) == 0;
+    }
+}
+
+static void wifi_ap_cache_update(const wifi_event_sta_connected_t *event)
+{
+    static const uint8_t s_cleared_digest[WIFI_CONFIG_DIGEST_LEN] = {0};
+
+    // The configurations cleared while connected are not cached again.
+    if (memcmp(s_ap_cache.digest, s_cleared_digest, sizeof(s_cleared_digest)) == 0) {
+        return;
+    }
+    if (s_ap_cache.channel == event->channel && s_ap_cache.authmode == event->authmode &&
+        memcmp(s_ap_cache.bssid, event->bssid, sizeof(s_ap_cache.bssid)) == 0) {
+        return;
+    }
+    memcpy(s_ap_cache.bssid, event->bssid, sizeof(s_ap_cache.bssid));
+    s_ap_cache.channel = event->channel;
+    s_ap_cache.authmode = event->authmode;
+    if (nvs_set_blob(s_wifi_config_nvs_handle, APCACHEKEY, &s_ap_cache, sizeof(s_ap_cache)) != ESP_OK ||
+        nvs_commit(s_wifi_config_nvs_handle) != ESP_OK) {
+        ESP_LOGW(OT_EXT_CLI_TAG, "Fail to save the access point of the connection");
+    }
+}
+
+static bool wifi_attempt_is_direct(void)
+{
+    return s_ap_cache.channel != 0 && s_connect_attempts < CONFIG_OPENTHREAD_WIFI_DIRECT_ATTEMPTS;
+}
+
+static esp_err_t wifi_sta_config_set(bool direct)
+{
+    wifi_config_t wifi_config = {
+        .sta =
+            {
+                .ssid = "",
+                .password = "",
+                .scan_method = EXAMPLE_WIFI_SCAN_METHOD,
+                .sort_method = EXAMPLE_WIFI_CONNECT_AP_SORT_METHOD,
+                .threshold.rssi = CONFIG_EXAMPLE_WIFI_SCAN_RSSI_THRESHOLD,
+                .threshold.authmode = EXAMPLE_WIFI_SCAN_AUTH_MODE_THRESHOLD,
+            },
+    };
+
+    memcpy(wifi_config.sta.ssid, s_ssid, sizeof(s_ssid));
+    memcpy(wifi_config.sta.password, s_password, sizeof(s_password));
+    if (direct) {
+        // Probe the channel of the last access point only, and hand over the key instead of the passphrase if
+        // it uses WPA-PSK. The scan falls back on the passphrase in case the access point changed its security.
+        wifi_config.sta.scan_method = WIFI_FAST_SCAN;
+        wifi_config.sta.bssid_set = true;
+        memcpy(wifi_config.sta.bssid, s_ap_cache.bssid, sizeof(wifi_config.sta.bssid));
+        wifi_config.sta.channel = s_ap_cache.channel;
+        if (s_ap_cache.has_pmk && wifi_authmode_is_psk(s_ap_cache.authmode)) {
+            for (int i = 0; i < PMKLEN; i++) {
+                static const char s_hex[] = "0123456789abcdef";
+                wifi_config.sta.password[2 * i] = s_hex[s_ap_cache.pmk[i] >> 4];
+                wifi_config.sta.password[2 * i + 1] = s_hex[s_ap_cache.pmk[i] & 0xf];
+            }
+        }
+    }
+    s_connect_direct = direct;
+    s_connect_attempts++;
+    return esp_wifi_set_config(WIFI_IF_STA, &wifi_config);
+}
+
+static uint32_t wifi_backoff_ms(uint16_t retry_nums)
+{
+    uint32_t backoff = CONFIG_OPENTHREAD_WIFI_BACKOFF_MIN_MS;
+
+    // The first retry is immediate, an access point blip is usually over by then.
+    if (retry_nums <= 1) {
+        return 0;
+    }
+    for (uint16_t i = 2; i < retry_nums && backoff < CONFIG_OPENTHREAD_WIFI_BACKOFF_MAX_MS; i++) {
+        backoff <<= 1;
+    }
+    if (backoff > CONFIG_OPENTHREAD_WIFI_BACKOFF_MAX_MS) {
+        backoff = CONFIG_OPENTHREAD_WIFI_BACKOFF_MAX_MS;
+    }
+    // Equal jitter, so that the border routers of a network losing the same access point do not retry together.
+    return backoff / 2 + esp_random() % (backoff / 2 + 1);
+}
+
+static void wifi_reconnect(void *arg)
+{
+    esp_err_t err = esp_wifi_connect();
+    if (err != ESP_OK) {
+        ESP_LOGW(OT_EXT_CLI_TAG, "Fail to reconnect wifi: %s", esp_err_to_name(err));
+    }
+}
+
+static void wifi_connect_record(void)
+{
+    uint32_t elapsed_ms = (uint32_t)((esp_timer_get_time() - s_connect_start_us) / 1000);
+    uint8_t bucket = 0;
+
+    if (s_connect_direct) {
+        s_connect_stats.direct++;
+    } else {
+        s_connect_stats.scan++;
+    }
+    s_connect_stats.last_ms = elapsed_ms;
+    if (!s_connect_is_reconnect) {
+        return;
+    }
+    while (bucket < WIFI_RECONNECT_LATENCY_BUCKETS - 1 && elapsed_ms > s_reconnect_bounds_ms[bucket]) {
+        bucket++;
+    }
+    s_connect_stats.buckets[bucket]++;
+    s_connect_stats.reconnects++;
+    if (elapsed_ms > s_connect_stats.max_ms) {
+        s_connect_stats.max_ms = elapsed_ms;
+    }
+}
+
 static void handler_on_wifi_disconnect(void *arg, esp_event_base_t event_base, int32_t event_id, void *event_data)
 {
+    wifi_event_sta_disconnected_t *disconn = (wifi_event_sta_disconnected_t *)event_data;
+
+    if (disconn->reason == WIFI_REASON_ROAMING) {
+        return;
+    }
+    xEventGroupClearBits(s_wifi_event_group, WIFI_CONNECTED_BIT | WIFI_GOT_IP_BIT | WIFI_GOT_IP6_BIT);
+    if (s_wifi_state == OT_WIFI_CONNECTED) {
+        s_connect_start_us = esp_timer_get_time();
+        s_connect_is_reconnect = true;
+        s_connect_attempts = 0;
+    }
     wifi_conn_retry_nums++;
 #if CONFIG_EXAMPLE_WIFI_CONN_MAX_RETRY >= 0
     if (wifi_conn_retry_nums > CONFIG_EXAMPLE_WIFI_CONN_MAX_RETRY) {
+        ESP_LOGI(OT_EXT_CLI_TAG, "Wi-Fi connect failed %u times, stop reconnect", wifi_conn_retry_nums);
         wifi_conn_retry_nums = 0;
         s_wifi_state = OT_WIFI_DISCONNECTED;
+        xEventGroupSetBits(s_wifi_event_group, WIFI_FAIL_BIT);
     } else
 #endif
     {
+        bool direct = wifi_attempt_is_direct();
+        uint32_t backoff_ms = wifi_backoff_ms(wifi_conn_retry_nums);
+
         s_wifi_state = OT_WIFI_RECONNECTING;
+        ESP_LOGI(OT_EXT_CLI_TAG, "Wi-Fi disconnected %d, reconnect %s in %" PRIu32 " ms", disconn->reason,
+                 direct ? "directly" : "with a scan", backoff_ms);
+        if (wifi_sta_config_set(direct) != ESP_OK) {
+            ESP_LOGW(OT_EXT_CLI_TAG, "Fail to set the wifi configuration");
+        }
+        if (backoff_ms == 0) {
+            wifi_reconnect(NULL);
+        } else {
+            esp_timer_start_once(s_reconnect_timer, (uint64_t)backoff_ms * 1000);
+        }
     }
 }
 
 static void handler_on_wifi_connect(void *arg, esp_event_base_t event_base, int32_t event_id, void *event_data)
 {
+    wifi_event_sta_connected_t *event = (wifi_event_sta_connected_t *)event_data;
+
+    wifi_connect_record();
+    wifi_ap_cache_update(event);
+#if CONFIG_EXAMPLE_CONNECT_IPV6
+    esp_netif_create_ip6_linklocal(esp_netif_get_handle_from_ifkey("WIFI_STA_DEF"));
+#endif
     wifi_conn_retry_nums = 0;
     s_wifi_state = OT_WIFI_CONNECTED;
+    xEventGroupSetBits(s_wifi_event_group, WIFI_CONNECTED_BIT);
+}
+
+#if CONFIG_EXAMPLE_CONNECT_IPV4
+static void handler_on_wifi_got_ip(void *arg, esp_event_base_t event_base, int32_t event_id, void *event_data)
+{
+    xEventGroupSetBits(s_wifi_event_group, WIFI_GOT_IP_BIT);
+}
+#endif
+
+#if CONFIG_EXAMPLE_CONNECT_IPV6
+static void handler_on_wifi_got_ip6(void *arg, esp_event_base_t event_base, int32_t event_id, void *event_data)
+{
+    ip_event_got_ip6_t *event = (ip_event_got_ip6_t *)event_data;
+
+    if (event->esp_netif == esp_netif_get_handle_from_ifkey("WIFI_STA_DEF") &&
+        esp_netif_ip6_get_addr_type(&event->ip6_info.ip) == EXAMPLE_CONNECT_PREFERRED_IPV6_TYPE) {
+        xEventGroupSetBits(s_wifi_event_group, WIFI_GOT_IP6_BIT);
+    }
+}
+#endif
+
+static void wifi_handlers_register(void)
+{
+    ESP_ERROR_CHECK(
+        esp_event_handler_register(WIFI_EVENT, WIFI_EVENT_STA_DISCONNECTED, &handler_on_wifi_disconnect, NULL));
+    ESP_ERROR_CHECK(esp_event_handler_register(WIFI_EVENT, WIFI_EVENT_STA_CONNECTED, &handler_on_wifi_connect, NULL));
+#if CONFIG_EXAMPLE_CONNECT_IPV4
+    ESP_ERROR_CHECK(esp_event_handler_register(IP_EVENT, IP_EVENT_STA_GOT_IP, &handler_on_wifi_got_ip, NULL));
+#endif
+#if CONFIG_EXAMPLE_CONNECT_IPV6
+    ESP_ERROR_CHECK(esp_event_handler_register(IP_EVENT, IP_EVENT_GOT_IP6, &handler_on_wifi_got_ip6, NULL));
+#endif
+}
+
+static void wifi_handlers_unregister(void)
+{
+    ESP_ERROR_CHECK(esp_event_handler_unregister(WIFI_EVENT, WIFI_EVENT_STA_DISCONNECTED, &handler_on_wifi_disconnect));
+    ESP_ERROR_CHECK(esp_event_handler_unregister(WIFI_EVENT, WIFI_EVENT_STA_CONNECTED, &handler_on_wifi_connect));
+#if CONFIG_EXAMPLE_CONNECT_IPV4
+    ESP_ERROR_CHECK(esp_event_handler_unregister(IP_EVENT, IP_EVENT_STA_GOT_IP, &handler_on_wifi_got_ip));
+#endif
+#if CONFIG_EXAMPLE_CONNECT_IPV6
+    ESP_ERROR_CHECK(esp_event_handler_unregister(IP_EVENT, IP_EVENT_GOT_IP6, &handler_on_wifi_got_ip6));
+#endif
 }
 
 static esp_err_t wifi_join(const char *ssid, const char *password)
 {
-    ESP_LOGI(OT_EXT_CLI_TAG, "Start example_connect");
+    EventBits_t wait_bits = WIFI_CONNECTED_BIT;
+    EventBits_t bits = 0;
 
-    wifi_config_t wifi_config = {
-        .sta =
-            {
-                .ssid = "",
-                .password = "",
-                .scan_method = EXAMPLE_WIFI_SCAN_METHOD,
-                .sort_method = EXAMPLE_WIFI_CONNECT_AP_SORT_METHOD,
-                .threshold.rssi = CONFIG_EXAMPLE_WIFI_SCAN_RSSI_THRESHOLD,
-                .threshold.authmode = EXAMPLE_WIFI_SCAN_AUTH_MODE_THRESHOLD,
-            },
-    };
+    ESP_LOGI(OT_EXT_CLI_TAG, "Start example_connect");
 
     uint8_t ssid_len = strnlen(ssid, SSIDMAXLEN);
     uint8_t password_len = strnlen(password, PASSWORDMAXLEN);
     if (ssid_len < SSIDMAXLEN && password_len < PASSWORDMAXLEN) {
-        memcpy(wifi_config.sta.ssid, (void *)ssid, ssid_len + 1);
-        memcpy(wifi_config.sta.password, (void *)password, password_len + 1);
+        memset(s_ssid, 0, sizeof(s_ssid));
+        memset(s_password, 0, sizeof(s_password));
+        memcpy(s_ssid, ssid, ssid_len + 1);
+        memcpy(s_password, password, password_len + 1);
     } else {
         ESP_LOGE(OT_EXT_CLI_TAG, "Invalid ssid or password");
         return ESP_ERR_INVALID_ARG;
     }
 
-    esp_err_t err = example_wifi_sta_do_connect(wifi_config, true);
-    return err;
+    esp_timer_stop(s_reconnect_timer);
+    wifi_ap_cache_load();
+    wifi_conn_retry_nums = 0;
+    s_connect_start_us = esp_timer_get_time();
+    s_connect_is_reconnect = false;
+    s_connect_attempts = 0;
+    xEventGroupClearBits(s_wifi_event_group, WIFI_CONNECTED_BIT | WIFI_GOT_IP_BIT | WIFI_GOT_IP6_BIT | WIFI_FAIL_BIT);
+    ESP_RETURN_ON_ERROR(wifi_sta_config_set(wifi_attempt_is_direct()), OT_EXT_CLI_TAG,
+                        "Fail to set the wifi configuration");
+    ESP_LOGI(OT_EXT_CLI_TAG, "Connecting to %s%s...", s_ssid, s_connect_direct ? " directly" : "");
+    ESP_RETURN_ON_ERROR(esp_wifi_connect(), OT_EXT_CLI_TAG, "WiFi connect failed");
+
+#if CONFIG_EXAMPLE_CONNECT_IPV4
+    wait_bits |= WIFI_GOT_IP_BIT;
+#endif
+#if CONFIG_EXAMPLE_CONNECT_IPV6
+    wait_bits |= WIFI_GOT_IP6_BIT;
+#endif
+    while ((bits & wait_bits) != wait_bits) {
+        bits = xEventGroupWaitBits(s_wifi_event_group, wait_bits, pdFALSE, pdTRUE, pdMS_TO_TICKS(WIFI_JOIN_POLL_MS));
+        if (bits & WIFI_FAIL_BIT) {
+            return ESP_FAIL;
+        }
+    }
+    return ESP_OK;
+}
+
+static void wifi_state_print(void)
+{
+    otCliOutputFormat("%s\n", wifi_state_string[s_wifi_state]);
+    if (s_ap_cache.channel != 0) {
+        otCliOutputFormat("cached ap: %02x:%02x:%02x:%02x:%02x:%02x, channel %u%s\n", s_ap_cache.bssid[0],
+                          s_ap_cache.bssid[1], s_ap_cache.bssid[2], s_ap_cache.bssid[3], s_ap_cache.bssid[4],
+                          s_ap_cache.bssid[5], s_ap_cache.channel,
+                          s_ap_cache.has_pmk && wifi_authmode_is_psk(s_ap_cache.authmode) ? ", pmk" : "");
+    }
+    otCliOutputFormat("connections: %" PRIu32 " direct, %" PRIu32 " scan, last %" PRIu32 " ms\n",
+                      s_connect_stats.direct, s_connect_stats.scan, s_connect_stats.last_ms);
+    otCliOutputFormat("reconnects: %" PRIu32 ", max %" PRIu32 " ms\n", s_connect_stats.reconnects,
+                      s_connect_stats.max_ms);
+    if (s_connect_stats.reconnects == 0) {
+        return;
+    }
+    for (uint8_t i = 0; i < WIFI_RECONNECT_LATENCY_BUCKETS - 1; i++) {
+        otCliOutputFormat("    <= %5" PRIu32 " ms: %" PRIu32 "\n", s_reconnect_bounds_ms[i],
+                          s_connect_stats.buckets[i]);
+    }
+    otCliOutputFormat("     > %5" PRIu32 " ms: %" PRIu32 "\n",
+                      s_reconnect_bounds_ms[WIFI_RECONNECT_LATENCY_BUCKETS - 2],
+                      s_connect_stats.buckets[WIFI_RECONNECT_LATENCY_BUCKETS - 1]);
 }
 
 static esp_err_t wifi_config_print(void)
@@ -192,14 +515,18 @@ esp_err_t esp_ot_wifi_connect(const char *ssid, const char *password)
 #endif
         ESP_ERROR_CHECK(esp_wifi_set_ps(WIFI_PS_MAX_MODEM));
         handle_wifi_addr_init();
+        const esp_timer_create_args_t timer_args = {
+            .callback = wifi_reconnect,
+            .name = "wifi_reconnect",
+        };
+        ESP_ERROR_CHECK(esp_timer_create(&timer_args, &s_reconnect_timer));
+        s_wifi_event_group = xEventGroupCreate();
+        ESP_RETURN_ON_FALSE(s_wifi_event_group, ESP_ERR_NO_MEM, OT_EXT_CLI_TAG, "Fail to create wifi event group");
         s_wifi_initialized = true;
     }
 
     if (!s_wifi_handler_registered) {
-        ESP_ERROR_CHECK(
-            esp_event_handler_register(WIFI_EVENT, WIFI_EVENT_STA_DISCONNECTED, &handler_on_wifi_disconnect, NULL));
-        ESP_ERROR_CHECK(
-            esp_event_handler_register(WIFI_EVENT, WIFI_EVENT_STA_CONNECTED, &handler_on_wifi_connect, NULL));
+        wifi_handlers_register();
         s_wifi_handler_registered = true;
     }
 
@@ -221,15 +548,15 @@ esp_err_t esp_ot_wifi_connect(const char *ssid, const char *password)
 
 esp_err_t esp_ot_wifi_disconnect(void)
 {
-    if (!s_wifi_initialized || s_wifi_state != OT_WIFI_CONNECTED) {
+    if (!s_wifi_initialized || s_wifi_state == OT_WIFI_DISCONNECTED) {
         return ESP_FAIL;
     }
 
-    ESP_ERROR_CHECK(esp_event_handler_unregister(WIFI_EVENT, WIFI_EVENT_STA_DISCONNECTED, &handler_on_wifi_disconnect));
-    ESP_ERROR_CHECK(esp_event_handler_unregister(WIFI_EVENT, WIFI_EVENT_STA_CONNECTED, &handler_on_wifi_connect));
+    wifi_handlers_unregister();
     s_wifi_handler_registered = false;
+    esp_timer_stop(s_reconnect_timer);
     s_wifi_state = OT_WIFI_DISCONNECTED;
-    esp_err_t err = example_wifi_sta_do_disconnect();
+    esp_err_t err = esp_wifi_disconnect();
     return err;
 }
 
@@ -245,7 +572,7 @@ otError esp_ot_process_wifi_cmd(void *aContext, uint8_t aArgsLength, char *aArgs
         otCliOutputFormat("connect -s <ssid>                        :       connect to a wifi network with an ssid\n");
         otCliOutputFormat("disconnect                               :       wifi disconnect\n");
         otCliOutputFormat(
-            "state                                    :       get wifi state, disconnect, connect or reconnecting\n");
+            "state                                    :       get wifi state and the reconnect latency histogram\n");
         otCliOutputFormat("mac <role>                               :       get mac address of wifi netif, <role> can "
                           "be 'sta' or 'ap'\n");
         otCliOutputFormat("config                                   :       get stored wifi configurations\n");
@@ -320,7 +647,7 @@ otError esp_ot_process_wifi_cmd(void *aContext, uint8_t aArgsLength, char *aArgs
             otCliOutputFormat("wifi sta connection is failed\n");
         }
     } else if (strcmp(aArgs[0], "state") == 0) {
-        otCliOutputFormat("%s\n", wifi_state_string[s_wifi_state]);
+        wifi_state_print();
     } else if (strcmp(aArgs[0], "disconnect") == 0) {
         if (s_wifi_state) {
             esp_openthread_task_switching_lock_release();
@@ -434,6 +761,7 @@ esp_err_t esp_ot_wifi_config_clear(void)
 {
     ESP_RETURN_ON_FALSE((s_wifi_config_nvs_handle != 0), ESP_FAIL, OT_EXT_CLI_TAG, "wifi_config NVS handle is invalid");
     ESP_RETURN_ON_ERROR(nvs_erase_all(s_wifi_config_nvs_handle), OT_EXT_CLI_TAG, "Fail to clear wifi configurations");
+    memset(&s_ap_cache, 0, sizeof(s_ap_cache));
     return ESP_OK;
 }
 
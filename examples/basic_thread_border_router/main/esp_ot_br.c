@@ -52,6 +52,13 @@ static esp_err_t init_spiffs(void)
     return ESP_OK;
 }
 
+static esp_err_t init_mdns(void)
+{
+    ESP_RETURN_ON_ERROR(mdns_init(), TAG, "Failed to initialize mDNS");
+    ESP_RETURN_ON_ERROR(mdns_hostname_set("esp-ot-br"), TAG, "Failed to set mDNS hostname");
+    return ESP_OK;
+}
+
 void app_main(void)
 {
     // Used eventfds:
@@ -85,7 +92,6 @@ void app_main(void)
     ESP_ERROR_CHECK(esp_vfs_eventfd_register(&eventfd_config));
 
     ESP_ERROR_CHECK(nvs_flash_init());
-    ESP_ERROR_CHECK(init_spiffs());
     ESP_ERROR_CHECK(esp_netif_init());
     ESP_ERROR_CHECK(esp_event_loop_create_default());
 
@@ -94,8 +100,9 @@ void app_main(void)
 #error Currently we do not support a manual way to connect ETH, if you want to use ETH, please enable OPENTHREAD_BR_AUTO_START.
 #endif
 
-    ESP_ERROR_CHECK(mdns_init());
-    ESP_ERROR_CHECK(mdns_hostname_set("esp-ot-br"));
+    // The storage mounts and the mDNS initialization run concurrently with the RCP bring-up
+    border_router_bringup_step_start("spiffs", init_spiffs);
+    border_router_bringup_step_start("mdns", init_mdns);
 #if CONFIG_OPENTHREAD_CLI_OTA
     esp_set_ota_server_cert((char *)server_cert_pem_start);
 #endif
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2021-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2021-2026 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: CC0-1.0
  *
@@ -11,10 +11,23 @@
 extern "C" {
 #endif
 
+#include "esp_err.h"
 #include "esp_openthread.h"
 #include "esp_openthread_border_router.h"
 #include "esp_rcp_update.h"
 
+/**
+ * @brief Run a bring-up step in its own task, concurrently with the RCP bring-up.
+ *
+ * @note The steps are started from the task calling launch_openthread_border_router, before calling it. The launcher
+ *       waits for all the steps once the RCP is up, before the RCP firmware is checked and the backbone netif is
+ *       connected, so the steps must not depend on the OpenThread stack. A step failing aborts like ESP_ERROR_CHECK.
+ *
+ * @param[in] name  The name of the step, used for its task and its boot phase, e.g. a string literal.
+ * @param[in] run   The step.
+ */
+void border_router_bringup_step_start(const char *name, esp_err_t (*run)(void));
+
 void launch_openthread_border_router(const esp_openthread_config_t *config,
                                      const esp_rcp_update_config_t *update_config);
 
@@ -12,6 +12,7 @@
 #include <string.h>
 
 #include "esp_check.h"
+#include "esp_event.h"
 #include "esp_log.h"
 #include "esp_mac.h"
 #include "esp_netif.h"
@@ -19,12 +20,15 @@
 #include "esp_openthread_border_router.h"
 #include "esp_openthread_lock.h"
 #include "esp_openthread_netif_glue.h"
+#include "esp_openthread_spinel.h"
 #include "esp_openthread_types.h"
+#include "esp_ot_boot_timeline.h"
 #include "esp_ot_cli_extension.h"
 #include "esp_ot_rcp_update.h"
 #include "esp_rcp_update.h"
 #include "esp_vfs_eventfd.h"
 #include "freertos/FreeRTOS.h"
+#include "freertos/event_groups.h"
 #include "freertos/task.h"
 #if CONFIG_OPENTHREAD_BR_SOFTAP_SETUP
 #include "esp_br_wifi_config.h"
@@ -58,6 +62,82 @@
 
 #define TAG "esp_ot_br"
 
+#define BRINGUP_STEPS_MAX 8
+#define BRINGUP_STEP_TASK_STACK 4096
+#define BRINGUP_STEP_TASK_PRIORITY 5
+
+typedef struct bringup_step {
+    const char *name;
+    esp_err_t (*run)(void);
+    EventBits_t bit;
+} bringup_step_t;
+
+static bringup_step_t s_bringup_steps[BRINGUP_STEPS_MAX];
+static uint8_t s_bringup_steps_num = 0;
+static EventGroupHandle_t s_bringup_event_group = NULL;
+
+static void bringup_step_task(void *ctx)
+{
+    bringup_step_t *step = (bringup_step_t *)ctx;
+
+    esp_ot_boot_phase_begin(step->name);
+    ESP_ERROR_CHECK(step->run());
+    esp_ot_boot_phase_end(step->name);
+    xEventGroupSetBits(s_bringup_event_group, step->bit);
+    vTaskDelete(NULL);
+}
+
+void border_router_bringup_step_start(const char *name, esp_err_t (*run)(void))
+{
+    if (!s_bringup_event_group) {
+        s_bringup_event_group = xEventGroupCreate();
+        assert(s_bringup_event_group);
+    }
+    assert(s_bringup_steps_num < BRINGUP_STEPS_MAX);
+    bringup_step_t *step = &s_bringup_steps[s_bringup_steps_num];
+    step->name = name;
+    step->run = run;
+    step->bit = 1 << s_bringup_steps_num;
+    s_bringup_steps_num++;
+
+    if (xTaskCreate(bringup_step_task, name, BRINGUP_STEP_TASK_STACK, step, BRINGUP_STEP_TASK_PRIORITY, NULL) !=
+        pdPASS) {
+        ESP_LOGW(TAG, "Failed to create the task of bring-up step %s, running it in place", name);
+        esp_ot_boot_phase_begin(name);
+        ESP_ERROR_CHECK(run());
+        esp_ot_boot_phase_end(name);
+        xEventGroupSetBits(s_bringup_event_group, step->bit);
+    }
+}
+
+static void bringup_wait(void)
+{
+    if (s_bringup_steps_num > 0) {
+        xEventGroupWaitBits(s_bringup_event_group, (1 << s_bringup_steps_num) - 1, pdFALSE, pdTRUE, portMAX_DELAY);
+    }
+}
+
+#if CONFIG_AUTO_UPDATE_RCP
+static void rcp_failure_update_handler(void)
+{
+    // The RCP firmware storage may still be mounting when the RCP fails to start
+    bringup_wait();
+    esp_ot_try_update_rcp(NULL);
+}
+#endif
+
+#if CONFIG_OPENTHREAD_BR_AUTO_START && CONFIG_OPENTHREAD_BOOT_TIMELINE
+static void thread_attached_handler(void *args, esp_event_base_t base, int32_t event_id, void *data)
+{
+    esp_openthread_role_changed_event_t *event = (esp_openthread_role_changed_event_t *)data;
+
+    if (event->current_role >= OT_DEVICE_ROLE_CHILD) {
+        esp_ot_boot_phase_end("thread-attach");
+        esp_event_handler_unregister(OPENTHREAD_EVENT, OPENTHREAD_EVENT_ROLE_CHANGED, thread_attached_handler);
+    }
+}
+#endif
+
 #if CONFIG_EXAMPLE_CONNECT_WIFI && CONFIG_OPENTHREAD_BR_AUTO_START
 /**
  * @brief Save Wi-Fi configuration to NVS and connect
@@ -106,6 +186,8 @@ static void ot_br_init(void *ctx)
     char wifi_password[64] = "";
     bool has_nvs_wifi_config = false;
 
+    esp_ot_boot_phase_begin("backbone");
+
     // Check if Wi-Fi configuration exists in NVS
     if (esp_ot_wifi_config_get_ssid(wifi_ssid) == ESP_OK) {
         esp_ot_wifi_config_get_password(wifi_password);
@@ -142,9 +224,12 @@ static void ot_br_init(void *ctx)
     }
 #elif CONFIG_EXAMPLE_CONNECT_ETHERNET
     // Ethernet connection mode
+    esp_ot_boot_phase_begin("backbone");
     ESP_ERROR_CHECK(example_ethernet_connect());
 #endif // CONFIG_EXAMPLE_CONNECT_WIFI || CONFIG_EXAMPLE_CONNECT_ETHERNET
+    esp_ot_boot_phase_end("backbone");
 
+    esp_ot_boot_phase_begin("br-init");
     esp_openthread_lock_acquire(portMAX_DELAY);
     esp_openthread_set_backbone_netif(get_example_netif());
     ESP_ERROR_CHECK(esp_openthread_border_router_init());
@@ -171,6 +256,12 @@ static void ot_br_init(void *ctx)
         otDatasetConvertToTlvs(&new_dataset, &dataset);
         ESP_LOGI(TAG, "Created new random Thread dataset");
     }
+    esp_ot_boot_phase_end("br-init");
+#if CONFIG_OPENTHREAD_BOOT_TIMELINE
+    ESP_ERROR_CHECK(esp_event_handler_register(OPENTHREAD_EVENT, OPENTHREAD_EVENT_ROLE_CHANGED,
+                                               thread_attached_handler, NULL));
+#endif
+    esp_ot_boot_phase_begin("thread-attach");
     ESP_ERROR_CHECK(esp_openthread_auto_start(&dataset));
     esp_openthread_lock_release();
 
@@ -192,11 +283,18 @@ void launch_openthread_border_router(const esp_openthread_config_t *config,
 #if CONFIG_AUTO_UPDATE_RCP
     ESP_ERROR_CHECK(esp_rcp_update_init(update_config));
     esp_ot_register_rcp_handler();
+    esp_openthread_set_compatibility_error_callback(rcp_failure_update_handler);
+    esp_openthread_set_coprocessor_reset_failure_callback(rcp_failure_update_handler);
 #else
     OT_UNUSED_VARIABLE(update_config);
 #endif
 
+    esp_ot_boot_phase_begin("rcp");
     ESP_ERROR_CHECK(esp_openthread_start(config));
+    esp_ot_boot_phase_end("rcp");
+    esp_ot_boot_phase_begin("bringup-wait");
+    bringup_wait();
+    esp_ot_boot_phase_end("bringup-wait");
 #if CONFIG_AUTO_UPDATE_RCP
     esp_ot_update_rcp_if_different();
 #endif